@@ -315,9 +315,10 @@ TArray<FCortexCommandInfo> FCortexBPCommandHandler::GetSupportedCommands() const
 		.Optional(TEXT("compile"), TEXT("boolean"), TEXT("Compile after rename")));
 	Commands.Add(FCortexCommandInfo{TEXT("recompile_dependents"), TEXT("Recompile Blueprints that depend on a target Blueprint")}
 		.Required(TEXT("asset_path"), TEXT("string"), TEXT("Blueprint asset path")));
-	Commands.Add(FCortexCommandInfo{TEXT("fixup_redirectors"), TEXT("Fix up redirectors under a content path")}
+	Commands.Add(FCortexCommandInfo{TEXT("fixup_redirectors"), TEXT("Fix up redirectors under a content path, saving each unique referencer once")}
 		.Required(TEXT("path"), TEXT("string"), TEXT("Content path to scan"))
-		.Optional(TEXT("recursive"), TEXT("boolean"), TEXT("Recurse into subfolders")));
+		.Optional(TEXT("recursive"), TEXT("boolean"), TEXT("Recurse into subfolders"))
+		.Optional(TEXT("dry_run"), TEXT("boolean"), TEXT("List redirectors and unique referencing packages without modifying anything")));
 	Commands.Add(FCortexCommandInfo{TEXT("compare_blueprints"), TEXT("Compare two Blueprints and return structural differences")}
 		.Required(TEXT("source_path"), TEXT("string"), TEXT("Source Blueprint asset path"))
 		.Required(TEXT("target_path"), TEXT("string"), TEXT("Target Blueprint asset path"))
@@ -1,4 +1,5 @@
 #include "Operations/CortexBPRedirectorOps.h"
+#include "CortexBlueprintModule.h"
 #include "CortexCommandRouter.h"
 #include "CortexEditorUtils.h"
 #include "Dom/JsonObject.h"
@@ -6,11 +7,173 @@
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
 #include "CoreGlobals.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
 #include "ObjectTools.h"
 #include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
 #include "UObject/UObjectIterator.h"
-#include "ScopedTransaction.h"
+
+namespace
+{
+	/** Log a progress line every N referencers so long fixups stay visible in the output log. */
+	constexpr int32 RedirectorFixupProgressInterval = 100;
+
+	struct FRedirectorFixupEntry
+	{
+		UObjectRedirector* Redirector = nullptr;
+		/** Indices into FRedirectorFixupPlan::Referencers. */
+		TArray<int32> ReferencerIndices;
+	};
+
+	/**
+	 * Deduplicated fixup work for a content path.
+	 * Each referencing package appears once in Referencers regardless of how many
+	 * redirectors it points at, so it is loaded and saved exactly once.
+	 */
+	struct FRedirectorFixupPlan
+	{
+		TArray<FRedirectorFixupEntry> Entries;
+		TArray<FName> Referencers;
+		TMap<FName, int32> ReferencerIndexByName;
+		TMap<FSoftObjectPath, FSoftObjectPath> SoftPathRedirects;
+	};
+
+	double MillisecondsSince(double StartSeconds)
+	{
+		return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	}
+
+	TArray<UObjectRedirector*> CollectRedirectors(IAssetRegistry& AssetRegistry, const FString& Path, bool bRecursive)
+	{
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName());
+		Filter.PackagePaths.Add(FName(*Path));
+		Filter.bRecursivePaths = bRecursive;
+
+		TArray<FAssetData> RedirectorAssets;
+		AssetRegistry.GetAssets(Filter, RedirectorAssets);
+
+		TArray<UObjectRedirector*> Redirectors;
+		TSet<UObjectRedirector*> SeenRedirectors;
+		Redirectors.Reserve(RedirectorAssets.Num());
+		for (const FAssetData& AssetData : RedirectorAssets)
+		{
+			if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(AssetData.GetAsset()))
+			{
+				if (!SeenRedirectors.Contains(Redirector))
+				{
+					SeenRedirectors.Add(Redirector);
+					Redirectors.Add(Redirector);
+				}
+			}
+		}
+
+		// In-memory redirectors created this session may not be in the registry yet.
+		const FString PathWithSlash = Path.EndsWith(TEXT("/")) ? Path : Path / TEXT("");
+		for (TObjectIterator<UObjectRedirector> It; It; ++It)
+		{
+			UObjectRedirector* Redirector = *It;
+			if (!IsValid(Redirector) || SeenRedirectors.Contains(Redirector))
+			{
+				continue;
+			}
+
+			const FString RedirectorPackageName = Redirector->GetOutermost()->GetName();
+			const bool bInPath = RedirectorPackageName == Path || RedirectorPackageName.StartsWith(PathWithSlash);
+			const bool bDirectChild = FPackageName::GetLongPackagePath(RedirectorPackageName) == Path;
+			if (bInPath && (bRecursive || bDirectChild))
+			{
+				SeenRedirectors.Add(Redirector);
+				Redirectors.Add(Redirector);
+			}
+		}
+
+		return Redirectors;
+	}
+
+	FRedirectorFixupPlan BuildFixupPlan(IAssetRegistry& AssetRegistry, const TArray<UObjectRedirector*>& Redirectors)
+	{
+		FRedirectorFixupPlan Plan;
+		Plan.Entries.Reserve(Redirectors.Num());
+
+		TSet<FName> RedirectorPackageNames;
+		RedirectorPackageNames.Reserve(Redirectors.Num());
+		for (const UObjectRedirector* Redirector : Redirectors)
+		{
+			RedirectorPackageNames.Add(Redirector->GetOutermost()->GetFName());
+		}
+
+		TArray<FName> PackageReferencers;
+		for (UObjectRedirector* Redirector : Redirectors)
+		{
+			FRedirectorFixupEntry& Entry = Plan.Entries.AddDefaulted_GetRef();
+			Entry.Redirector = Redirector;
+
+			if (Redirector->DestinationObject)
+			{
+				Plan.SoftPathRedirects.Add(FSoftObjectPath(Redirector), FSoftObjectPath(Redirector->DestinationObject));
+			}
+
+			PackageReferencers.Reset();
+			AssetRegistry.GetReferencers(Redirector->GetOutermost()->GetFName(), PackageReferencers);
+			for (const FName& ReferencerName : PackageReferencers)
+			{
+				// Redirectors pointing at redirectors are removed by this same pass.
+				if (RedirectorPackageNames.Contains(ReferencerName))
+				{
+					continue;
+				}
+
+				int32 ReferencerIndex = INDEX_NONE;
+				if (const int32* ExistingIndex = Plan.ReferencerIndexByName.Find(ReferencerName))
+				{
+					ReferencerIndex = *ExistingIndex;
+				}
+				else
+				{
+					ReferencerIndex = Plan.Referencers.Add(ReferencerName);
+					Plan.ReferencerIndexByName.Add(ReferencerName, ReferencerIndex);
+				}
+				Entry.ReferencerIndices.AddUnique(ReferencerIndex);
+			}
+		}
+
+		return Plan;
+	}
+
+	TSharedPtr<FJsonObject> SerializeFixupEntry(const FRedirectorFixupEntry& Entry, const FRedirectorFixupPlan& Plan)
+	{
+		TSharedPtr<FJsonObject> EntryJson = MakeShared<FJsonObject>();
+		EntryJson->SetStringField(TEXT("redirector"), Entry.Redirector->GetPathName());
+		EntryJson->SetStringField(
+			TEXT("destination"),
+			Entry.Redirector->DestinationObject ? Entry.Redirector->DestinationObject->GetPathName() : FString());
+
+		TArray<TSharedPtr<FJsonValue>> ReferencersJson;
+		ReferencersJson.Reserve(Entry.ReferencerIndices.Num());
+		for (const int32 ReferencerIndex : Entry.ReferencerIndices)
+		{
+			ReferencersJson.Add(MakeShared<FJsonValueString>(Plan.Referencers[ReferencerIndex].ToString()));
+		}
+		EntryJson->SetArrayField(TEXT("referencers"), ReferencersJson);
+		return EntryJson;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> NamesToJson(const TArray<FName>& Names)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Names.Num());
+		for (const FName& Name : Names)
+		{
+			Values.Add(MakeShared<FJsonValueString>(Name.ToString()));
+		}
+		return Values;
+	}
+}
 
 FCortexCommandResult FCortexBPRedirectorOps::FixupRedirectors(const TSharedPtr<FJsonObject>& Params)
 {
@@ -32,6 +195,9 @@ FCortexCommandResult FCortexBPRedirectorOps::FixupRedirectors(const TSharedPtr<F
 	bool bRecursive = true;
 	Params->TryGetBoolField(TEXT("recursive"), bRecursive);
 
+	bool bDryRun = false;
+	Params->TryGetBoolField(TEXT("dry_run"), bDryRun);
+
 	Path = FCortexEditorUtils::NormalizeMountedContentPath(Path);
 
 	FString ValidationError;
@@ -42,86 +208,177 @@ FCortexCommandResult FCortexBPRedirectorOps::FixupRedirectors(const TSharedPtr<F
 			ValidationError);
 	}
 
+	const double TotalStart = FPlatformTime::Seconds();
+
 	FAssetRegistryModule& AssetRegistryModule =
 		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName());
-	Filter.PackagePaths.Add(FName(*Path));
-	Filter.bRecursivePaths = bRecursive;
+	const TArray<UObjectRedirector*> Redirectors = CollectRedirectors(AssetRegistry, Path, bRecursive);
+	const FRedirectorFixupPlan Plan = BuildFixupPlan(AssetRegistry, Redirectors);
+	const double PlanMs = MillisecondsSince(TotalStart);
 
-	TArray<FAssetData> RedirectorAssets;
-	AssetRegistry.GetAssets(Filter, RedirectorAssets);
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("path"), Path);
+	Data->SetBoolField(TEXT("recursive"), bRecursive);
+	Data->SetNumberField(TEXT("redirectors_found"), Redirectors.Num());
+	Data->SetNumberField(TEXT("unique_referencers"), Plan.Referencers.Num());
 
-	TArray<UObjectRedirector*> Redirectors;
-	Redirectors.Reserve(RedirectorAssets.Num());
-	for (const FAssetData& AssetData : RedirectorAssets)
+	if (bDryRun)
 	{
-		if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(AssetData.GetAsset()))
+		TArray<TSharedPtr<FJsonValue>> EntriesJson;
+		EntriesJson.Reserve(Plan.Entries.Num());
+		for (const FRedirectorFixupEntry& Entry : Plan.Entries)
 		{
-			Redirectors.Add(Redirector);
+			EntriesJson.Add(MakeShared<FJsonValueObject>(SerializeFixupEntry(Entry, Plan)));
 		}
+		Data->SetArrayField(TEXT("redirectors"), EntriesJson);
+		Data->SetArrayField(TEXT("referencers"), NamesToJson(Plan.Referencers));
+		Data->SetNumberField(TEXT("plan_ms"), PlanMs);
+		Data->SetBoolField(TEXT("dry_run"), true);
+		return FCortexCommandRouter::Success(Data);
 	}
 
-	const FString PathWithSlash = Path.EndsWith(TEXT("/")) ? Path : Path / TEXT("");
-	for (TObjectIterator<UObjectRedirector> It; It; ++It)
+	// One unit per referencer load, one per referencer save, plus soft-path rename and delete.
+	FScopedSlowTask SlowTask(
+		static_cast<float>(Plan.Referencers.Num() * 2 + 2),
+		FText::FromString(FString::Printf(TEXT("Cortex: Fixing up %d redirectors in %s"), Redirectors.Num(), *Path)));
+
+	// Load every referencer exactly once. Hard references resolve through the
+	// redirector on load, so re-saving the package is what rewrites them.
+	const double LoadStart = FPlatformTime::Seconds();
+	TArray<UPackage*> ReferencerPackages;
+	ReferencerPackages.Reserve(Plan.Referencers.Num());
+	TArray<bool> ReferencerFixed;
+	ReferencerFixed.Init(false, Plan.Referencers.Num());
+	TArray<int32> PackageToReferencerIndex;
+	PackageToReferencerIndex.Reserve(Plan.Referencers.Num());
+	TArray<FName> FailedReferencers;
+
+	for (int32 ReferencerIndex = 0; ReferencerIndex < Plan.Referencers.Num(); ++ReferencerIndex)
 	{
-		UObjectRedirector* Redirector = *It;
-		if (!IsValid(Redirector))
+		const FString PackageName = Plan.Referencers[ReferencerIndex].ToString();
+		SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Loading %s"), *PackageName)));
+
+		UPackage* Package = FindPackage(nullptr, *PackageName);
+		if (Package == nullptr)
 		{
+			Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+		}
+
+		if (Package == nullptr)
+		{
+			FailedReferencers.Add(Plan.Referencers[ReferencerIndex]);
 			continue;
 		}
 
-		const FString RedirectorPackageName = Redirector->GetOutermost()->GetName();
-		if ((RedirectorPackageName == Path || RedirectorPackageName.StartsWith(PathWithSlash)) &&
-			!Redirectors.Contains(Redirector))
+		ReferencerPackages.Add(Package);
+		PackageToReferencerIndex.Add(ReferencerIndex);
+
+		if ((ReferencerIndex + 1) % RedirectorFixupProgressInterval == 0)
 		{
-			Redirectors.Add(Redirector);
+			UE_LOG(LogCortexBlueprint, Log, TEXT("FixupRedirectors: loaded %d/%d referencers"),
+				ReferencerIndex + 1, Plan.Referencers.Num());
 		}
 	}
+	const double LoadMs = MillisecondsSince(LoadStart);
 
-	int32 DirectlyDeletedRedirectors = 0;
-	TArray<UObjectRedirector*> RedirectorsWithReferencers;
-	RedirectorsWithReferencers.Reserve(Redirectors.Num());
-	TArray<UObject*> UnreferencedRedirectors;
-	for (UObjectRedirector* Redirector : Redirectors)
+	const double SaveStart = FPlatformTime::Seconds();
+	SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("Updating soft references")));
+	if (ReferencerPackages.Num() > 0 && Plan.SoftPathRedirects.Num() > 0)
 	{
-		TArray<FAssetIdentifier> Referencers;
-		AssetRegistry.GetReferencers(FAssetIdentifier(Redirector->GetOutermost()->GetFName()), Referencers);
-		if (Referencers.Num() > 0)
+		FAssetToolsModule& AssetToolsModule =
+			FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+		AssetToolsModule.Get().RenameReferencingSoftObjectPaths(ReferencerPackages, Plan.SoftPathRedirects);
+	}
+
+	for (UPackage* Package : ReferencerPackages)
+	{
+		Package->MarkPackageDirty();
+	}
+
+	SlowTask.EnterProgressFrame(
+		static_cast<float>(Plan.Referencers.Num()),
+		FText::FromString(FString::Printf(TEXT("Saving %d referencing packages"), ReferencerPackages.Num())));
+	if (ReferencerPackages.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(ReferencerPackages, false);
+	}
+
+	// A successful save clears the dirty flag; anything still dirty failed to write.
+	for (int32 PackageIndex = 0; PackageIndex < ReferencerPackages.Num(); ++PackageIndex)
+	{
+		const int32 ReferencerIndex = PackageToReferencerIndex[PackageIndex];
+		if (ReferencerPackages[PackageIndex]->IsDirty())
 		{
-			RedirectorsWithReferencers.Add(Redirector);
+			FailedReferencers.Add(Plan.Referencers[ReferencerIndex]);
 		}
 		else
 		{
-			UnreferencedRedirectors.Add(Redirector);
+			ReferencerFixed[ReferencerIndex] = true;
 		}
 	}
+	const double SaveMs = MillisecondsSince(SaveStart);
 
-	if (UnreferencedRedirectors.Num() > 0)
+	// Only delete redirectors whose every referencer was rewritten; the rest stay
+	// in place so nothing on disk is left pointing at a missing package.
+	const double DeleteStart = FPlatformTime::Seconds();
+	SlowTask.EnterProgressFrame(1.0f, FText::FromString(TEXT("Deleting redirectors")));
+	TArray<UObject*> RedirectorsToDelete;
+	TArray<TSharedPtr<FJsonValue>> SkippedRedirectors;
+	for (const FRedirectorFixupEntry& Entry : Plan.Entries)
 	{
-		DirectlyDeletedRedirectors = ObjectTools::ForceDeleteObjects(UnreferencedRedirectors, false);
+		bool bAllReferencersFixed = true;
+		for (const int32 ReferencerIndex : Entry.ReferencerIndices)
+		{
+			bAllReferencersFixed &= ReferencerFixed[ReferencerIndex];
+		}
+
+		if (bAllReferencersFixed)
+		{
+			RedirectorsToDelete.Add(Entry.Redirector);
+		}
+		else
+		{
+			SkippedRedirectors.Add(MakeShared<FJsonValueString>(Entry.Redirector->GetPathName()));
+		}
 	}
 
-	if (RedirectorsWithReferencers.Num() > 0)
+	int32 DeletedRedirectors = 0;
+	if (RedirectorsToDelete.Num() > 0)
 	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Fixup Redirectors in %s"), *Path)
-		));
-		FAssetToolsModule& AssetToolsModule =
-			FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-		AssetToolsModule.Get().FixupReferencers(
-			RedirectorsWithReferencers,
-			false,
-			ERedirectFixupMode::DeleteFixedUpRedirectors);
+		DeletedRedirectors = ObjectTools::ForceDeleteObjects(RedirectorsToDelete, false);
 	}
+	const double DeleteMs = MillisecondsSince(DeleteStart);
+	const double TotalMs = MillisecondsSince(TotalStart);
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetStringField(TEXT("path"), Path);
-	Data->SetBoolField(TEXT("recursive"), bRecursive);
-	Data->SetNumberField(TEXT("redirectors_found"), Redirectors.Num());
-	Data->SetNumberField(TEXT("redirectors_fixed"), DirectlyDeletedRedirectors + RedirectorsWithReferencers.Num());
+	UE_LOG(LogCortexBlueprint, Log,
+		TEXT("FixupRedirectors: %s — %d redirectors, %d unique referencers, %d failed, %.1f ms"),
+		*Path, Redirectors.Num(), Plan.Referencers.Num(), FailedReferencers.Num(), TotalMs);
+
+	int32 SavedReferencers = 0;
+	for (const bool bFixed : ReferencerFixed)
+	{
+		SavedReferencers += bFixed ? 1 : 0;
+	}
+	Data->SetNumberField(TEXT("redirectors_fixed"), DeletedRedirectors);
+	Data->SetNumberField(TEXT("referencers_saved"), SavedReferencers);
+	Data->SetArrayField(TEXT("failed_referencers"), NamesToJson(FailedReferencers));
+	if (SkippedRedirectors.Num() > 0)
+	{
+		Data->SetArrayField(TEXT("skipped_redirectors"), SkippedRedirectors);
+	}
+
+	TSharedPtr<FJsonObject> Timing = MakeShared<FJsonObject>();
+	Timing->SetNumberField(TEXT("plan_ms"), PlanMs);
+	Timing->SetNumberField(TEXT("load_ms"), LoadMs);
+	Timing->SetNumberField(TEXT("save_ms"), SaveMs);
+	Timing->SetNumberField(TEXT("delete_ms"), DeleteMs);
+	Timing->SetNumberField(TEXT("total_ms"), TotalMs);
+	Timing->SetNumberField(
+		TEXT("ms_per_referencer"),
+		Plan.Referencers.Num() > 0 ? (LoadMs + SaveMs) / Plan.Referencers.Num() : 0.0);
+	Data->SetObjectField(TEXT("timing"), Timing);
 
 	return FCortexCommandRouter::Success(Data);
 }
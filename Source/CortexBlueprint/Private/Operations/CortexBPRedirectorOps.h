@@ -8,7 +8,11 @@ class FCortexBPRedirectorOps
 public:
 	/**
 	 * Fix up redirectors in a given path.
-	 * Params: path (string), recursive (bool, optional, default true)
+	 * Collects every redirector under the path, resolves the deduplicated set of
+	 * referencing packages, loads each referencer once, saves them in a single
+	 * batched pass and then deletes the redirectors whose referencers all saved.
+	 * Params: path (string), recursive (bool, optional, default true),
+	 *         dry_run (bool, optional, default false)
 	 */
 	static FCortexCommandResult FixupRedirectors(const TSharedPtr<FJsonObject>& Params);
 };
@@ -6,6 +6,13 @@
 #include "Misc/PackageName.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "HAL/PlatformProcess.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
 
 namespace
 {
@@ -19,6 +26,22 @@ namespace
 			AssetRegistry.Tick(0.0f);
 		}
 	}
+
+	bool CreateRedirectorTestBlueprint(FCortexBPCommandHandler& Handler, const FString& AssetPath)
+	{
+		TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+		CreateParams->SetStringField(TEXT("name"), FPackageName::GetShortName(AssetPath));
+		CreateParams->SetStringField(TEXT("path"), FPackageName::GetLongPackagePath(AssetPath));
+		CreateParams->SetStringField(TEXT("type"), TEXT("Actor"));
+		return Handler.Execute(TEXT("create"), CreateParams).bSuccess;
+	}
+
+	bool SaveRedirectorTestBlueprint(FCortexBPCommandHandler& Handler, const FString& AssetPath)
+	{
+		TSharedPtr<FJsonObject> SaveParams = MakeShared<FJsonObject>();
+		SaveParams->SetStringField(TEXT("asset_path"), AssetPath);
+		return Handler.Execute(TEXT("save"), SaveParams).bSuccess;
+	}
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
@@ -82,3 +105,225 @@ bool FCortexBPFixupRedirectorsTest::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexBPFixupRedirectorsDryRunTest,
+	"Cortex.Blueprint.Redirectors.FixupDryRun",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexBPFixupRedirectorsDryRunTest::RunTest(const FString& Parameters)
+{
+	if (GEngine)
+	{
+		GEngine->Exec(nullptr, TEXT("log LogAssetRegistry Error"));
+	}
+	AddExpectedError(TEXT("package was marked as deleted in editor"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FCortexBPCommandHandler Handler;
+	const FString Suffix = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8);
+	const FString FolderPath = FString::Printf(TEXT("/Game/Temp/BPRedirectorDry_%s"), *Suffix);
+	const FString SourcePath = FString::Printf(TEXT("%s/BP_Source_%s"), *FolderPath, *Suffix);
+	const FString DestPath = FString::Printf(TEXT("%s/BP_Dest_%s"), *FolderPath, *Suffix);
+	const FString SourcePackagePath = FPackageName::ObjectPathToPackageName(SourcePath);
+
+	TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+	CreateParams->SetStringField(TEXT("name"), FPackageName::GetShortName(SourcePath));
+	CreateParams->SetStringField(TEXT("path"), FolderPath);
+	CreateParams->SetStringField(TEXT("type"), TEXT("Actor"));
+	TestTrue(TEXT("Create source BP succeeded"), Handler.Execute(TEXT("create"), CreateParams).bSuccess);
+
+	TSharedPtr<FJsonObject> RenameParams = MakeShared<FJsonObject>();
+	RenameParams->SetStringField(TEXT("source_path"), SourcePath);
+	RenameParams->SetStringField(TEXT("dest_path"), DestPath);
+	TestTrue(TEXT("Rename BP succeeded"), Handler.Execute(TEXT("rename"), RenameParams).bSuccess);
+
+	TSharedPtr<FJsonObject> SaveParams = MakeShared<FJsonObject>();
+	SaveParams->SetStringField(TEXT("asset_path"), DestPath);
+	TestTrue(TEXT("Save renamed BP succeeded"), Handler.Execute(TEXT("save"), SaveParams).bSuccess);
+
+	TSharedPtr<FJsonObject> DryRunParams = MakeShared<FJsonObject>();
+	DryRunParams->SetStringField(TEXT("path"), FolderPath);
+	DryRunParams->SetBoolField(TEXT("dry_run"), true);
+	const FCortexCommandResult DryRunResult = Handler.Execute(TEXT("fixup_redirectors"), DryRunParams);
+	TestTrue(TEXT("Dry-run fixup succeeded"), DryRunResult.bSuccess);
+	if (DryRunResult.bSuccess && DryRunResult.Data.IsValid())
+	{
+		bool bDryRun = false;
+		DryRunResult.Data->TryGetBoolField(TEXT("dry_run"), bDryRun);
+		TestTrue(TEXT("Response flagged as dry run"), bDryRun);
+		TestTrue(TEXT("Dry run found the redirector"),
+			DryRunResult.Data->GetNumberField(TEXT("redirectors_found")) >= 1);
+
+		const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+		TestTrue(TEXT("Dry run lists redirectors"),
+			DryRunResult.Data->TryGetArrayField(TEXT("redirectors"), Entries) && Entries && Entries->Num() >= 1);
+		TestTrue(TEXT("Dry run reports unique referencers"),
+			DryRunResult.Data->HasField(TEXT("unique_referencers")));
+		TestFalse(TEXT("Dry run does not report timing of a save pass"),
+			DryRunResult.Data->HasField(TEXT("timing")));
+	}
+	TestTrue(TEXT("Redirector package still exists after dry run"), FPackageName::DoesPackageExist(SourcePackagePath));
+
+	TSharedPtr<FJsonObject> FixupParams = MakeShared<FJsonObject>();
+	FixupParams->SetStringField(TEXT("path"), FolderPath);
+	const FCortexCommandResult FixupResult = Handler.Execute(TEXT("fixup_redirectors"), FixupParams);
+	TestTrue(TEXT("Fixup redirectors succeeded"), FixupResult.bSuccess);
+	if (FixupResult.bSuccess && FixupResult.Data.IsValid())
+	{
+		TestTrue(TEXT("Fixup reports timing"), FixupResult.Data->HasField(TEXT("timing")));
+	}
+
+	TSharedPtr<FJsonObject> DeleteDest = MakeShared<FJsonObject>();
+	DeleteDest->SetStringField(TEXT("asset_path"), DestPath);
+	Handler.Execute(TEXT("delete"), DeleteDest);
+	Handler.Execute(TEXT("fixup_redirectors"), FixupParams);
+	FlushRedirectorTestAssetRegistryEvents();
+
+	if (GEngine)
+	{
+		GEngine->Exec(nullptr, TEXT("log LogAssetRegistry Warning"));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexBPFixupRedirectorsSharedReferencersTest,
+	"Cortex.Blueprint.Redirectors.FixupSharedReferencers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexBPFixupRedirectorsSharedReferencersTest::RunTest(const FString& Parameters)
+{
+	if (GEngine)
+	{
+		GEngine->Exec(nullptr, TEXT("log LogAssetRegistry Error"));
+	}
+	AddExpectedError(TEXT("package was marked as deleted in editor"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	FCortexBPCommandHandler Handler;
+	const FString Suffix = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8);
+	const FString FolderPath = FString::Printf(TEXT("/Game/Temp/BPRedirectorShared_%s"), *Suffix);
+
+	// Two redirected Blueprints, both referenced by each of two users
+	TArray<FString> SourcePaths;
+	TArray<FString> DestPaths;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		SourcePaths.Add(FString::Printf(TEXT("%s/BP_Source%d_%s"), *FolderPath, Index, *Suffix));
+		DestPaths.Add(FString::Printf(TEXT("%s/BP_Dest%d_%s"), *FolderPath, Index, *Suffix));
+		TestTrue(TEXT("Create source BP succeeded"), CreateRedirectorTestBlueprint(Handler, SourcePaths[Index]));
+	}
+
+	TArray<FString> UserPaths;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		const FString UserPath = FString::Printf(TEXT("%s/BP_User%d_%s"), *FolderPath, Index, *Suffix);
+		UserPaths.Add(UserPath);
+		TestTrue(TEXT("Create user BP succeeded"), CreateRedirectorTestBlueprint(Handler, UserPath));
+
+		UBlueprint* UserBP = LoadObject<UBlueprint>(nullptr, *UserPath);
+		if (!TestNotNull(TEXT("User BP loaded"), UserBP))
+		{
+			return false;
+		}
+		for (int32 SourceIndex = 0; SourceIndex < SourcePaths.Num(); ++SourceIndex)
+		{
+			const UBlueprint* SourceBP = LoadObject<UBlueprint>(nullptr, *SourcePaths[SourceIndex]);
+			if (!TestNotNull(TEXT("Source BP loaded"), SourceBP))
+			{
+				return false;
+			}
+
+			FEdGraphPinType RefType;
+			RefType.PinCategory = UEdGraphSchema_K2::PC_Object;
+			RefType.PinSubCategoryObject = SourceBP->GeneratedClass;
+			FBlueprintEditorUtils::AddMemberVariable(UserBP, FName(*FString::Printf(TEXT("Source%d"), SourceIndex)), RefType);
+		}
+		FKismetEditorUtilities::CompileBlueprint(UserBP);
+		TestTrue(TEXT("Save user BP succeeded"), SaveRedirectorTestBlueprint(Handler, UserPath));
+	}
+
+	// Register the users' dependencies before the renames leave them pointing at redirectors
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FString> UserFiles;
+	for (const FString& UserPath : UserPaths)
+	{
+		UserFiles.Add(FPackageName::LongPackageNameToFilename(
+			FPackageName::ObjectPathToPackageName(UserPath), FPackageName::GetAssetPackageExtension()));
+	}
+	AssetRegistry.ScanFilesSynchronous(UserFiles, true);
+
+	for (int32 Index = 0; Index < SourcePaths.Num(); ++Index)
+	{
+		TSharedPtr<FJsonObject> RenameParams = MakeShared<FJsonObject>();
+		RenameParams->SetStringField(TEXT("source_path"), SourcePaths[Index]);
+		RenameParams->SetStringField(TEXT("dest_path"), DestPaths[Index]);
+		TestTrue(TEXT("Rename BP succeeded"), Handler.Execute(TEXT("rename"), RenameParams).bSuccess);
+		TestTrue(TEXT("Save renamed BP succeeded"), SaveRedirectorTestBlueprint(Handler, DestPaths[Index]));
+	}
+
+	TMap<FName, int32> SaveCounts;
+	const FDelegateHandle SavedHandle = UPackage::PackageSavedWithContextEvent.AddLambda(
+		[&SaveCounts](const FString& Filename, UPackage* Package, FObjectPostSaveContext SaveContext)
+		{
+			++SaveCounts.FindOrAdd(Package->GetFName());
+		});
+
+	TSharedPtr<FJsonObject> FixupParams = MakeShared<FJsonObject>();
+	FixupParams->SetStringField(TEXT("path"), FolderPath);
+	const FCortexCommandResult FixupResult = Handler.Execute(TEXT("fixup_redirectors"), FixupParams);
+	UPackage::PackageSavedWithContextEvent.Remove(SavedHandle);
+
+	TestTrue(TEXT("Fixup redirectors succeeded"), FixupResult.bSuccess);
+	if (FixupResult.bSuccess && FixupResult.Data.IsValid())
+	{
+		TestEqual(TEXT("Both redirectors found"),
+			static_cast<int32>(FixupResult.Data->GetNumberField(TEXT("redirectors_found"))), 2);
+		TestEqual(TEXT("Shared referencers are deduplicated"),
+			static_cast<int32>(FixupResult.Data->GetNumberField(TEXT("unique_referencers"))), UserPaths.Num());
+		TestEqual(TEXT("Each referencer saved"),
+			static_cast<int32>(FixupResult.Data->GetNumberField(TEXT("referencers_saved"))), UserPaths.Num());
+		TestEqual(TEXT("Both redirectors removed"),
+			static_cast<int32>(FixupResult.Data->GetNumberField(TEXT("redirectors_fixed"))), 2);
+	}
+
+	for (const FString& UserPath : UserPaths)
+	{
+		const FName UserPackageName(*FPackageName::ObjectPathToPackageName(UserPath));
+		const int32* SaveCount = SaveCounts.Find(UserPackageName);
+		TestEqual(FString::Printf(TEXT("%s saved exactly once"), *UserPackageName.ToString()),
+			SaveCount ? *SaveCount : 0, 1);
+	}
+
+	for (const FString& SourcePath : SourcePaths)
+	{
+		const FString SourcePackagePath = FPackageName::ObjectPathToPackageName(SourcePath);
+		TestFalse(TEXT("Redirector package removed"), FPackageName::DoesPackageExist(SourcePackagePath));
+		const FString RedirectorPath = FString::Printf(TEXT("%s.%s"),
+			*SourcePackagePath, *FPackageName::GetShortName(SourcePackagePath));
+		TestFalse(TEXT("Redirector object removed"),
+			IsValid(FindObject<UObjectRedirector>(nullptr, *RedirectorPath)));
+	}
+
+	TArray<FString> CleanupPaths = UserPaths;
+	CleanupPaths.Append(DestPaths);
+	for (const FString& AssetPath : CleanupPaths)
+	{
+		TSharedPtr<FJsonObject> DeleteParams = MakeShared<FJsonObject>();
+		DeleteParams->SetStringField(TEXT("asset_path"), AssetPath);
+		DeleteParams->SetBoolField(TEXT("force"), true);
+		Handler.Execute(TEXT("delete"), DeleteParams);
+	}
+	Handler.Execute(TEXT("fixup_redirectors"), FixupParams);
+	FlushRedirectorTestAssetRegistryEvents();
+
+	if (GEngine)
+	{
+		GEngine->Exec(nullptr, TEXT("log LogAssetRegistry Warning"));
+	}
+
+	return true;
+}
@@ -0,0 +1,616 @@
+#include "CortexActorSpatialIndex.h"
+
+#include "Components/SceneComponent.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "WorldPartition/WorldPartition.h"
+
+TMap<TObjectKey<UWorld>, TUniquePtr<FCortexActorSpatialIndex>> FCortexActorSpatialIndex::Indices;
+FDelegateHandle FCortexActorSpatialIndex::LevelAddedHandle;
+FDelegateHandle FCortexActorSpatialIndex::LevelRemovedHandle;
+FDelegateHandle FCortexActorSpatialIndex::WorldCleanupHandle;
+FDelegateHandle FCortexActorSpatialIndex::UndoRedoHandle;
+
+namespace
+{
+	int64 CellSpan(const FIntVector& MinCell, const FIntVector& MaxCell)
+	{
+		return static_cast<int64>(MaxCell.X - MinCell.X + 1)
+			* static_cast<int64>(MaxCell.Y - MinCell.Y + 1)
+			* static_cast<int64>(MaxCell.Z - MinCell.Z + 1);
+	}
+
+	/** Insert into a distance-sorted list capped at K entries. */
+	void InsertNearest(TArray<TPair<int32, double>>& Best, int32 K, int32 Id, double Distance)
+	{
+		if (Best.Num() >= K && Distance >= Best.Last().Value)
+		{
+			return;
+		}
+
+		int32 InsertAt = Best.Num();
+		while (InsertAt > 0 && Best[InsertAt - 1].Value > Distance)
+		{
+			--InsertAt;
+		}
+		Best.Insert(TPair<int32, double>(Id, Distance), InsertAt);
+		if (Best.Num() > K)
+		{
+			Best.Pop(EAllowShrinking::No);
+		}
+	}
+}
+
+FCortexSpatialGrid::FCortexSpatialGrid(double InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0))
+{
+}
+
+int32 FCortexSpatialGrid::Add(const FVector& Position)
+{
+	int32 Id;
+	if (FreeIds.Num() > 0)
+	{
+		Id = FreeIds.Pop(EAllowShrinking::No);
+		Used[Id] = true;
+	}
+	else
+	{
+		Id = Positions.AddUninitialized();
+		CellById.AddUninitialized();
+		SlotInCell.AddUninitialized();
+		Used.Add(true);
+	}
+
+	Positions[Id] = Position;
+	LinkToCell(Id, CellOf(Position));
+	++Count;
+	return Id;
+}
+
+void FCortexSpatialGrid::Remove(int32 Id)
+{
+	if (!IsValidId(Id))
+	{
+		return;
+	}
+
+	UnlinkFromCell(Id);
+	Used[Id] = false;
+	FreeIds.Add(Id);
+	--Count;
+}
+
+void FCortexSpatialGrid::Move(int32 Id, const FVector& Position)
+{
+	if (!IsValidId(Id))
+	{
+		return;
+	}
+
+	Positions[Id] = Position;
+	const FIntVector NewCell = CellOf(Position);
+	if (NewCell != CellById[Id])
+	{
+		UnlinkFromCell(Id);
+		LinkToCell(Id, NewCell);
+	}
+}
+
+void FCortexSpatialGrid::Reset()
+{
+	Count = 0;
+	Positions.Reset();
+	CellById.Reset();
+	SlotInCell.Reset();
+	Used.Reset();
+	FreeIds.Reset();
+	Cells.Reset();
+}
+
+void FCortexSpatialGrid::QueryBox(const FBox& Box, TArray<int32>& OutIds) const
+{
+	CollectCellRange(CellOf(Box.Min), CellOf(Box.Max), [this, &Box, &OutIds](const TArray<int32>& CellIds)
+	{
+		for (const int32 Id : CellIds)
+		{
+			if (Box.IsInsideOrOn(Positions[Id]))
+			{
+				OutIds.Add(Id);
+			}
+		}
+	});
+}
+
+void FCortexSpatialGrid::QuerySphere(const FVector& Center, double Radius, TArray<int32>& OutIds) const
+{
+	const FVector Extent(Radius);
+	const double RadiusSquared = FMath::Square(Radius);
+	CollectCellRange(CellOf(Center - Extent), CellOf(Center + Extent), [this, &Center, RadiusSquared, &OutIds](const TArray<int32>& CellIds)
+	{
+		for (const int32 Id : CellIds)
+		{
+			if (FVector::DistSquared(Positions[Id], Center) <= RadiusSquared)
+			{
+				OutIds.Add(Id);
+			}
+		}
+	});
+}
+
+void FCortexSpatialGrid::QueryNearest(
+	const FVector& Origin,
+	int32 K,
+	double MaxRadius,
+	TFunctionRef<bool(int32)> Filter,
+	TArray<TPair<int32, double>>& OutNearest) const
+{
+	OutNearest.Reset();
+	if (K <= 0 || Count == 0 || MaxRadius < 0.0)
+	{
+		return;
+	}
+
+	auto ConsiderCell = [this, &Origin, K, MaxRadius, &Filter, &OutNearest](const TArray<int32>& CellIds)
+	{
+		for (const int32 Id : CellIds)
+		{
+			const double Distance = FVector::Dist(Positions[Id], Origin);
+			if (Distance <= MaxRadius && Filter(Id))
+			{
+				InsertNearest(OutNearest, K, Id, Distance);
+			}
+		}
+	};
+
+	// Ring R holds the cells at Chebyshev distance R; none of them is closer than (R - 1) cells
+	const FIntVector OriginCell = CellOf(Origin);
+	int64 VisitedCells = 0;
+	for (int32 Ring = 0; ; ++Ring)
+	{
+		const double RingMinDistance = FMath::Max(0, Ring - 1) * CellSize;
+		if (RingMinDistance > MaxRadius || (OutNearest.Num() >= K && OutNearest.Last().Value <= RingMinDistance))
+		{
+			return;
+		}
+
+		const int64 RingCells = Ring == 0 ? 1 : CellSpan(FIntVector(-Ring), FIntVector(Ring)) - CellSpan(FIntVector(1 - Ring), FIntVector(Ring - 1));
+		if (VisitedCells + RingCells > Cells.Num())
+		{
+			// Sparse world: visiting the occupied cells directly is cheaper than the remaining rings
+			OutNearest.Reset();
+			for (const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+			{
+				ConsiderCell(Cell.Value);
+			}
+			return;
+		}
+		VisitedCells += RingCells;
+
+		for (int32 DX = -Ring; DX <= Ring; ++DX)
+		{
+			for (int32 DY = -Ring; DY <= Ring; ++DY)
+			{
+				const bool bOnXYShell = FMath::Abs(DX) == Ring || FMath::Abs(DY) == Ring;
+				const int32 StepZ = bOnXYShell || Ring == 0 ? 1 : 2 * Ring;
+				for (int32 DZ = -Ring; DZ <= Ring; DZ += StepZ)
+				{
+					if (const TArray<int32>* CellIds = Cells.Find(OriginCell + FIntVector(DX, DY, DZ)))
+					{
+						ConsiderCell(*CellIds);
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntVector FCortexSpatialGrid::CellOf(const FVector& Position) const
+{
+	auto Axis = [this](double Value)
+	{
+		return static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Value / CellSize), -1.0e9, 1.0e9));
+	};
+	return FIntVector(Axis(Position.X), Axis(Position.Y), Axis(Position.Z));
+}
+
+void FCortexSpatialGrid::LinkToCell(int32 Id, const FIntVector& Cell)
+{
+	TArray<int32>& CellIds = Cells.FindOrAdd(Cell);
+	CellById[Id] = Cell;
+	SlotInCell[Id] = CellIds.Add(Id);
+}
+
+void FCortexSpatialGrid::UnlinkFromCell(int32 Id)
+{
+	const FIntVector Cell = CellById[Id];
+	TArray<int32>* CellIds = Cells.Find(Cell);
+	if (!CellIds)
+	{
+		return;
+	}
+
+	const int32 Slot = SlotInCell[Id];
+	CellIds->RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	if (CellIds->IsValidIndex(Slot))
+	{
+		SlotInCell[(*CellIds)[Slot]] = Slot;
+	}
+	if (CellIds->Num() == 0)
+	{
+		Cells.Remove(Cell);
+	}
+}
+
+void FCortexSpatialGrid::CollectCellRange(
+	const FIntVector& MinCell,
+	const FIntVector& MaxCell,
+	TFunctionRef<void(const TArray<int32>&)> Visit) const
+{
+	if (CellSpan(MinCell, MaxCell) > Cells.Num())
+	{
+		// Query bounds cover more cells than are occupied: test occupied cells instead
+		for (const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+		{
+			const FIntVector& Key = Cell.Key;
+			if (Key.X >= MinCell.X && Key.X <= MaxCell.X
+				&& Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y
+				&& Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+			{
+				Visit(Cell.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<int32>* CellIds = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					Visit(*CellIds);
+				}
+			}
+		}
+	}
+}
+
+FCortexActorSpatialIndex& FCortexActorSpatialIndex::Get(UWorld* World)
+{
+	check(World);
+
+	if (!WorldCleanupHandle.IsValid())
+	{
+		LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddStatic(&FCortexActorSpatialIndex::HandleLevelChanged);
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddStatic(&FCortexActorSpatialIndex::HandleLevelChanged);
+		WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FCortexActorSpatialIndex::HandleWorldCleanup);
+		UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddStatic(&FCortexActorSpatialIndex::HandleUndoRedo);
+	}
+
+	TUniquePtr<FCortexActorSpatialIndex>& Index = Indices.FindOrAdd(World);
+	if (!Index.IsValid() || Index->World.Get() != World)
+	{
+		Index.Reset(new FCortexActorSpatialIndex(World));
+	}
+	if (Index->bDirty)
+	{
+		Index->Rebuild();
+	}
+	else if (Index->bStampStale)
+	{
+		// Handled events explain the change since the last stamp
+		Index->ActorCountStamp = ComputeActorCountStamp(World);
+		Index->bStampStale = false;
+	}
+	else if (Index->ActorCountStamp != ComputeActorCountStamp(World))
+	{
+		// Actor arrays changed with no event we saw: membership can no longer be trusted
+		Index->Rebuild();
+	}
+	return *Index;
+}
+
+void FCortexActorSpatialIndex::Reset()
+{
+	if (WorldCleanupHandle.IsValid())
+	{
+		FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+		FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+		FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+		FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+		LevelAddedHandle.Reset();
+		LevelRemovedHandle.Reset();
+		WorldCleanupHandle.Reset();
+		UndoRedoHandle.Reset();
+	}
+	Indices.Empty();
+}
+
+FCortexActorSpatialIndex::FCortexActorSpatialIndex(UWorld* InWorld)
+	: World(InWorld)
+{
+	ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateRaw(this, &FCortexActorSpatialIndex::HandleActorSpawned));
+	ActorDestroyedHandle = InWorld->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateRaw(this, &FCortexActorSpatialIndex::HandleActorDestroyed));
+
+	// Editor World Partition loads and unloads actors without spawning or destroying them
+	if (UWorldPartition* Partition = InWorld->GetWorldPartition())
+	{
+		WorldPartition = Partition;
+		LoaderAdapterHandle = Partition->LoaderAdapterStateChanged.AddLambda(
+			[this](const IWorldPartitionActorLoaderInterface::ILoaderAdapter*)
+			{
+				bDirty = true;
+			});
+	}
+}
+
+FCortexActorSpatialIndex::~FCortexActorSpatialIndex()
+{
+	Clear();
+	if (UWorld* WorldPtr = World.Get())
+	{
+		WorldPtr->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		WorldPtr->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	if (UWorldPartition* Partition = WorldPartition.Get())
+	{
+		Partition->LoaderAdapterStateChanged.Remove(LoaderAdapterHandle);
+	}
+}
+
+void FCortexActorSpatialIndex::QueryBox(const FBox& Box, TArray<AActor*>& OutActors)
+{
+	FlushPendingMoves();
+	TArray<int32> Ids;
+	Grid.QueryBox(Box, Ids);
+	CollectActors(Ids, OutActors);
+}
+
+void FCortexActorSpatialIndex::QuerySphere(const FVector& Center, double Radius, TArray<AActor*>& OutActors)
+{
+	FlushPendingMoves();
+	TArray<int32> Ids;
+	Grid.QuerySphere(Center, Radius, Ids);
+	CollectActors(Ids, OutActors);
+}
+
+void FCortexActorSpatialIndex::QueryNearest(
+	const FVector& Origin,
+	int32 K,
+	double MaxRadius,
+	TFunctionRef<bool(const AActor*)> Filter,
+	TArray<TPair<AActor*, double>>& OutNearest)
+{
+	FlushPendingMoves();
+	TArray<TPair<int32, double>> Nearest;
+	Grid.QueryNearest(Origin, K, MaxRadius, [this, &Filter](int32 Id)
+	{
+		const AActor* Actor = ActorById[Id].Get();
+		return IsValid(Actor) && Filter(Actor);
+	}, Nearest);
+
+	OutNearest.Reset(Nearest.Num());
+	for (const TPair<int32, double>& Entry : Nearest)
+	{
+		OutNearest.Emplace(ActorById[Entry.Key].Get(), Entry.Value);
+	}
+}
+
+void FCortexActorSpatialIndex::ForEachActor(TFunctionRef<void(AActor*)> Visit)
+{
+	for (const TPair<TObjectKey<AActor>, int32>& Pair : IdByActor)
+	{
+		AActor* Actor = ActorById[Pair.Value].Get();
+		if (IsValid(Actor))
+		{
+			Visit(Actor);
+		}
+	}
+}
+
+int32 FCortexActorSpatialIndex::Num()
+{
+	return Grid.Num();
+}
+
+int32 FCortexActorSpatialIndex::CountActors(FObjectKey FilterKey, TFunctionRef<bool(const AActor*)> Filter)
+{
+	if (CountedActors != INDEX_NONE && CountedKey == FilterKey && CountedVersion == MembershipVersion)
+	{
+		return CountedActors;
+	}
+
+	CountedActors = 0;
+	ForEachActor([this, &Filter](AActor* Actor)
+	{
+		CountedActors += Filter(Actor) ? 1 : 0;
+	});
+	CountedKey = FilterKey;
+	CountedVersion = MembershipVersion;
+	return CountedActors;
+}
+
+void FCortexActorSpatialIndex::Rebuild()
+{
+	Clear();
+	bDirty = false;
+	bStampStale = false;
+	++MembershipVersion;
+
+	if (UWorld* WorldPtr = World.Get())
+	{
+		for (TActorIterator<AActor> It(WorldPtr); It; ++It)
+		{
+			if (IsValid(*It))
+			{
+				AddActor(*It);
+			}
+		}
+		ActorCountStamp = ComputeActorCountStamp(WorldPtr);
+	}
+}
+
+void FCortexActorSpatialIndex::Clear()
+{
+	for (int32 Id = 0; Id < RootById.Num(); ++Id)
+	{
+		if (USceneComponent* Root = RootById[Id].Get())
+		{
+			Root->TransformUpdated.Remove(MoveHandleById[Id]);
+		}
+	}
+
+	Grid.Reset();
+	ActorById.Reset();
+	RootById.Reset();
+	MoveHandleById.Reset();
+	IdByActor.Reset();
+	PendingMoves.Reset();
+	PendingFlags.Reset();
+}
+
+void FCortexActorSpatialIndex::AddActor(AActor* Actor)
+{
+	if (IdByActor.Contains(Actor))
+	{
+		return;
+	}
+
+	const int32 Id = Grid.Add(Actor->GetActorLocation());
+	if (Id >= ActorById.Num())
+	{
+		ActorById.SetNum(Id + 1);
+		RootById.SetNum(Id + 1);
+		MoveHandleById.SetNum(Id + 1);
+		PendingFlags.Add(false, Id + 1 - PendingFlags.Num());
+	}
+
+	ActorById[Id] = Actor;
+	IdByActor.Add(Actor, Id);
+	if (USceneComponent* Root = Actor->GetRootComponent())
+	{
+		RootById[Id] = Root;
+		MoveHandleById[Id] = Root->TransformUpdated.AddRaw(this, &FCortexActorSpatialIndex::HandleTransformUpdated, Id);
+	}
+	++MembershipVersion;
+}
+
+void FCortexActorSpatialIndex::RemoveActor(const AActor* Actor)
+{
+	int32 Id = INDEX_NONE;
+	if (!IdByActor.RemoveAndCopyValue(Actor, Id))
+	{
+		return;
+	}
+
+	if (USceneComponent* Root = RootById[Id].Get())
+	{
+		Root->TransformUpdated.Remove(MoveHandleById[Id]);
+	}
+	ActorById[Id].Reset();
+	RootById[Id].Reset();
+	MoveHandleById[Id].Reset();
+	PendingFlags[Id] = false;
+	Grid.Remove(Id);
+	++MembershipVersion;
+}
+
+void FCortexActorSpatialIndex::FlushPendingMoves()
+{
+	for (const int32 Id : PendingMoves)
+	{
+		PendingFlags[Id] = false;
+		if (const AActor* Actor = ActorById[Id].Get())
+		{
+			Grid.Move(Id, Actor->GetActorLocation());
+		}
+	}
+	PendingMoves.Reset();
+}
+
+void FCortexActorSpatialIndex::CollectActors(const TArray<int32>& Ids, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + Ids.Num());
+	for (const int32 Id : Ids)
+	{
+		AActor* Actor = ActorById[Id].Get();
+		if (IsValid(Actor))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+uint32 FCortexActorSpatialIndex::ComputeActorCountStamp(UWorld* World)
+{
+	uint32 Stamp = World->GetLevels().Num();
+	for (const ULevel* Level : World->GetLevels())
+	{
+		Stamp = HashCombineFast(Stamp, Level ? static_cast<uint32>(Level->Actors.Num()) : 0u);
+	}
+	return Stamp;
+}
+
+void FCortexActorSpatialIndex::HandleActorSpawned(AActor* Actor)
+{
+	if (!bDirty && IsValid(Actor))
+	{
+		AddActor(Actor);
+		bStampStale = true;
+	}
+}
+
+void FCortexActorSpatialIndex::HandleActorDestroyed(AActor* Actor)
+{
+	if (!bDirty)
+	{
+		RemoveActor(Actor);
+		bStampStale = true;
+	}
+}
+
+void FCortexActorSpatialIndex::HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 Id)
+{
+	// Fires every frame for moving actors in PIE: only queue, the next query re-buckets
+	if (PendingFlags.IsValidIndex(Id) && !PendingFlags[Id])
+	{
+		PendingFlags[Id] = true;
+		PendingMoves.Add(Id);
+	}
+}
+
+void FCortexActorSpatialIndex::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (TUniquePtr<FCortexActorSpatialIndex>* Index = World ? Indices.Find(World) : nullptr)
+	{
+		if (Index->IsValid())
+		{
+			(*Index)->bDirty = true;
+		}
+	}
+}
+
+void FCortexActorSpatialIndex::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	Indices.Remove(World);
+}
+
+void FCortexActorSpatialIndex::HandleUndoRedo()
+{
+	// Undoing a spawn or delete restores or removes actors without spawn/destroy events
+	for (TPair<TObjectKey<UWorld>, TUniquePtr<FCortexActorSpatialIndex>>& Pair : Indices)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->bDirty = true;
+		}
+	}
+}
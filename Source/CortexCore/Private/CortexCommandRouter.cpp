@@ -84,6 +84,7 @@ FCortexCommandRouter::~FCortexCommandRouter()
 // FCortexBatchScope implementation
 TSet<TWeakObjectPtr<UMaterial>> FCortexBatchScope::DirtyMaterials;
 TMap<FString, FCortexBatchScope::FBatchCleanupCallback> FCortexBatchScope::CleanupActions;
+TMap<FString, FCortexBatchScope::FBatchFinalizeCallback> FCortexBatchScope::FinalizeActions;
 
 FCortexBatchScope::FCortexBatchScope()
 {
@@ -96,6 +97,10 @@ FCortexBatchScope::~FCortexBatchScope()
 
 	if (FCortexCommandRouter::BatchDepth == 0)
 	{
+		// Finalize actions a batch did not collect itself still have to run
+		TArray<TSharedPtr<FJsonObject>> UnreportedFinalize;
+		RunFinalizeActions(UnreportedFinalize);
+
 		// Invoke generic cleanup actions (MoveTemp for re-entrancy safety:
 		// callbacks like NotifyGraphChanged may trigger delegates that call AddCleanupAction)
 		TMap<FString, FBatchCleanupCallback> PendingActions = MoveTemp(CleanupActions);
@@ -143,6 +148,42 @@ void FCortexBatchScope::AddCleanupAction(const FString& Key, FBatchCleanupCallba
 	}
 }
 
+void FCortexBatchScope::AddFinalizeAction(const FString& Key, FBatchFinalizeCallback Callback)
+{
+	if (!FCortexCommandRouter::IsInBatch())
+	{
+		UE_LOG(LogCortex, Warning, TEXT("AddFinalizeAction called outside batch, executing immediately: %s"), *Key);
+		Callback();
+		return;
+	}
+	if (!FinalizeActions.Contains(Key))
+	{
+		FinalizeActions.Add(Key, MoveTemp(Callback));
+	}
+}
+
+void FCortexBatchScope::RunFinalizeActions(TArray<TSharedPtr<FJsonObject>>& OutReports)
+{
+	if (FCortexCommandRouter::BatchDepth > 1)
+	{
+		return;
+	}
+
+	// A finalize may queue further work (e.g. graph notifications); drain until none remain
+	while (FinalizeActions.Num() > 0)
+	{
+		TMap<FString, FBatchFinalizeCallback> PendingActions = MoveTemp(FinalizeActions);
+		FinalizeActions.Empty();
+		for (auto& Pair : PendingActions)
+		{
+			if (TSharedPtr<FJsonObject> Report = Pair.Value())
+			{
+				OutReports.Add(Report);
+			}
+		}
+	}
+}
+
 FCortexCommandResult FCortexCommandRouter::Execute(
 	const FString& Command,
 	const TSharedPtr<FJsonObject>& Params,
@@ -795,12 +836,31 @@ FCortexCommandResult FCortexCommandRouter::HandleBatch(const TSharedPtr<FJsonObj
 		}
 	}
 
+	// Deferred work runs inside the batch transaction, before the response is built, so its
+	// failures and final fingerprints reach the client
+	TArray<TSharedPtr<FJsonObject>> FinalizeReports;
+	FCortexBatchScope::RunFinalizeActions(FinalizeReports);
+
 	const double BatchElapsed = (FPlatformTime::Seconds() - BatchStartTime) * 1000.0;
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("results"), ResultsArray);
 	Data->SetNumberField(TEXT("count"), ResultsArray.Num());
 	Data->SetNumberField(TEXT("total_timing_ms"), BatchElapsed);
+	if (FinalizeReports.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> FinalizeArray;
+		int32 FinalizeFailed = 0;
+		for (const TSharedPtr<FJsonObject>& Report : FinalizeReports)
+		{
+			bool bReportSuccess = true;
+			Report->TryGetBoolField(TEXT("success"), bReportSuccess);
+			FinalizeFailed += bReportSuccess ? 0 : 1;
+			FinalizeArray.Add(MakeShared<FJsonValueObject>(Report));
+		}
+		Data->SetArrayField(TEXT("finalize"), FinalizeArray);
+		Data->SetNumberField(TEXT("finalize_failed"), FinalizeFailed);
+	}
 
 	return Success(Data);
 }
@@ -1,4 +1,5 @@
 #include "CortexCoreModule.h"
+#include "CortexActorSpatialIndex.h"
 #include "CortexCommandRouter.h"
 #include "CortexCoreCommandHandler.h"
 #include "CortexTcpServer.h"
@@ -47,6 +48,7 @@ void FCortexCoreModule::ShutdownModule()
     }
 
     CommandRouter.Reset();
+    FCortexActorSpatialIndex::Reset();
 }
 
 ICortexCommandRegistry& FCortexCoreModule::GetCommandRegistry()
@@ -0,0 +1,275 @@
+#include "Misc/AutomationTest.h"
+#include "CortexActorSpatialIndex.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Engine/PointLight.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	/** Clustered, mostly flat synthetic layout, like a streamed open world. */
+	TArray<FVector> BuildSyntheticPoints(int32 Count)
+	{
+		FRandomStream Random(Count);
+		TArray<FVector> Points;
+		Points.Reserve(Count);
+
+		TArray<FVector> Clusters;
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			Clusters.Add(FVector(Random.FRandRange(-400000.0, 400000.0), Random.FRandRange(-400000.0, 400000.0), 0.0));
+		}
+
+		while (Points.Num() < Count)
+		{
+			const FVector& Cluster = Clusters[Random.RandRange(0, Clusters.Num() - 1)];
+			Points.Add(Cluster + FVector(
+				Random.FRandRange(-30000.0, 30000.0),
+				Random.FRandRange(-30000.0, 30000.0),
+				Random.FRandRange(-500.0, 3000.0)));
+		}
+		return Points;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexSpatialGridBenchmarkTest,
+	"Cortex.Core.SpatialIndex.Benchmark.Points100000",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexSpatialGridBenchmarkTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	constexpr int32 PointCount = 100000;
+	constexpr int32 QueryCount = 200;
+	const TArray<FVector> Points = BuildSyntheticPoints(PointCount);
+
+	FCortexSpatialGrid Grid;
+	double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Point : Points)
+	{
+		Grid.Add(Point);
+	}
+	const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	TestEqual(TEXT("Every point indexed"), Grid.Num(), PointCount);
+
+	FRandomStream Random(7);
+	TArray<FVector> Origins;
+	for (int32 Index = 0; Index < QueryCount; ++Index)
+	{
+		Origins.Add(Points[Random.RandRange(0, PointCount - 1)]);
+	}
+
+	// Radius: grid against brute force
+	constexpr double Radius = 5000.0;
+	double GridMs = 0.0;
+	double BruteMs = 0.0;
+	bool bSphereMatches = true;
+	for (const FVector& Origin : Origins)
+	{
+		TArray<int32> GridIds;
+		StartTime = FPlatformTime::Seconds();
+		Grid.QuerySphere(Origin, Radius, GridIds);
+		GridMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TArray<int32> BruteIds;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Id = 0; Id < Points.Num(); ++Id)
+		{
+			if (FVector::DistSquared(Points[Id], Origin) <= FMath::Square(Radius))
+			{
+				BruteIds.Add(Id);
+			}
+		}
+		BruteMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		GridIds.Sort();
+		bSphereMatches &= GridIds == BruteIds;
+	}
+	TestTrue(TEXT("Sphere queries match brute force"), bSphereMatches);
+
+	// Box
+	bool bBoxMatches = true;
+	for (int32 Index = 0; Index < 20; ++Index)
+	{
+		const FBox Box = FBox::BuildAABB(Origins[Index], FVector(8000.0, 3000.0, 1000.0));
+		TArray<int32> GridIds;
+		Grid.QueryBox(Box, GridIds);
+		int32 BruteCount = 0;
+		for (const FVector& Point : Points)
+		{
+			BruteCount += Box.IsInsideOrOn(Point) ? 1 : 0;
+		}
+		bBoxMatches &= GridIds.Num() == BruteCount;
+	}
+	TestTrue(TEXT("Box queries match brute force"), bBoxMatches);
+
+	// k-nearest with a filter, as observe_state uses it
+	constexpr int32 K = 20;
+	double NearestMs = 0.0;
+	bool bNearestMatches = true;
+	for (const FVector& Origin : Origins)
+	{
+		auto IsEven = [](int32 Id) { return Id % 2 == 0; };
+		TArray<TPair<int32, double>> Nearest;
+		StartTime = FPlatformTime::Seconds();
+		Grid.QueryNearest(Origin, K, 50000.0, IsEven, Nearest);
+		NearestMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TArray<double> BruteDistances;
+		for (int32 Id = 0; Id < Points.Num(); Id += 2)
+		{
+			const double Distance = FVector::Dist(Points[Id], Origin);
+			if (Distance <= 50000.0)
+			{
+				BruteDistances.Add(Distance);
+			}
+		}
+		BruteDistances.Sort();
+		BruteDistances.SetNum(FMath::Min(K, BruteDistances.Num()));
+
+		bNearestMatches &= Nearest.Num() == BruteDistances.Num();
+		for (int32 Index = 0; bNearestMatches && Index < Nearest.Num(); ++Index)
+		{
+			bNearestMatches &= FMath::IsNearlyEqual(Nearest[Index].Value, BruteDistances[Index]);
+		}
+	}
+	TestTrue(TEXT("Nearest queries match brute force"), bNearestMatches);
+
+	// Moves re-bucket without a rebuild
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Id = 0; Id < PointCount; Id += 10)
+	{
+		Grid.Move(Id, Points[Id] + FVector(2500.0, -2500.0, 0.0));
+	}
+	const double MoveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	TArray<int32> MovedIds;
+	Grid.QuerySphere(Points[0] + FVector(2500.0, -2500.0, 0.0), 1.0, MovedIds);
+	TestTrue(TEXT("Moved point found at its new location"), MovedIds.Contains(0));
+
+	AddInfo(FString::Printf(
+		TEXT("SpatialGrid: %d points built in %.1f ms; %d radius queries %.2f ms (brute force %.1f ms); %d kNN queries %.2f ms; %d moves %.1f ms"),
+		PointCount, BuildMs, QueryCount, GridMs, BruteMs, QueryCount, NearestMs, PointCount / 10, MoveMs));
+
+	// Generous CI bound; the brute-force scan it replaces is the point of comparison
+	TestTrue(TEXT("Radius queries should be well below brute force"), GridMs < BruteMs);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexActorSpatialIndexTrackingTest,
+	"Cortex.Core.SpatialIndex.TracksActors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexActorSpatialIndexTrackingTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		AddInfo(TEXT("No editor world - skipping"));
+		return true;
+	}
+
+	const FVector Origin(910000.0, 910000.0, 0.0);
+	FCortexActorSpatialIndex& Index = FCortexActorSpatialIndex::Get(World);
+
+	// Spawned after the build: picked up from the spawn handler
+	APointLight* Actor = World->SpawnActor<APointLight>(APointLight::StaticClass(), FTransform(Origin));
+	if (!TestNotNull(TEXT("Spawned test actor"), Actor))
+	{
+		return false;
+	}
+
+	TArray<AActor*> Found;
+	Index.QuerySphere(Origin, 100.0, Found);
+	TestTrue(TEXT("Spawned actor found by radius"), Found.Contains(Actor));
+
+	// Moved with a plain SetActorLocation: the root's TransformUpdated re-buckets it
+	const FVector Moved = Origin + FVector(50000.0, 0.0, 0.0);
+	Actor->SetActorLocation(Moved);
+	Found.Reset();
+	Index.QueryBox(FBox::BuildAABB(Moved, FVector(10.0)), Found);
+	TestTrue(TEXT("Moved actor found at new location"), Found.Contains(Actor));
+	Found.Reset();
+	Index.QuerySphere(Origin, 100.0, Found);
+	TestFalse(TEXT("Moved actor gone from old location"), Found.Contains(Actor));
+
+	TArray<TPair<AActor*, double>> Nearest;
+	Index.QueryNearest(Moved + FVector(30.0, 40.0, 0.0), 1, 1000.0, [](const AActor*) { return true; }, Nearest);
+	TestTrue(TEXT("Nearest actor is the moved one"), Nearest.Num() == 1 && Nearest[0].Key == Actor);
+	if (Nearest.Num() == 1)
+	{
+		TestEqual(TEXT("Nearest distance"), Nearest[0].Value, 50.0, 0.01);
+	}
+
+	Actor->Destroy();
+	Found.Reset();
+	Index.QuerySphere(Moved, 100.0, Found);
+	TestFalse(TEXT("Destroyed actor removed"), Found.Contains(Actor));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexActorSpatialIndexMissedEventsTest,
+	"Cortex.Core.SpatialIndex.MissedEvents",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexActorSpatialIndexMissedEventsTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		AddInfo(TEXT("No editor world - skipping"));
+		return true;
+	}
+
+	const FVector Origin(-910000.0, 910000.0, 0.0);
+	auto IsNearOrigin = [&Origin](const AActor* Actor)
+	{
+		return FVector::Dist(Actor->GetActorLocation(), Origin) < 1000.0;
+	};
+	const int32 CountBefore = FCortexActorSpatialIndex::Get(World).CountActors(World, IsNearOrigin);
+
+	// Spawned inside a transaction, then undone: the actor leaves the level without a destroy event
+	GEditor->BeginTransaction(FText::FromString(TEXT("Cortex: Spatial index undo test")));
+	World->GetCurrentLevel()->Modify();
+	APointLight* Actor = World->SpawnActor<APointLight>(APointLight::StaticClass(), FTransform(Origin));
+	GEditor->EndTransaction();
+	if (!TestNotNull(TEXT("Spawned test actor"), Actor))
+	{
+		return false;
+	}
+
+	TArray<AActor*> Found;
+	FCortexActorSpatialIndex::Get(World).QuerySphere(Origin, 100.0, Found);
+	TestTrue(TEXT("Spawned actor indexed"), Found.Contains(Actor));
+	TestEqual(TEXT("Cached count follows the spawn"),
+		FCortexActorSpatialIndex::Get(World).CountActors(World, IsNearOrigin), CountBefore + 1);
+
+	GEditor->UndoTransaction();
+
+	Found.Reset();
+	FCortexActorSpatialIndex::Get(World).QuerySphere(Origin, 100.0, Found);
+	TestFalse(TEXT("Undone spawn no longer indexed"), Found.Contains(Actor));
+	TestEqual(TEXT("Cached count follows the undo"),
+		FCortexActorSpatialIndex::Get(World).CountActors(World, IsNearOrigin), CountBefore);
+
+	// Redo brings it back, again without a spawn event
+	GEditor->RedoTransaction();
+	Found.Reset();
+	FCortexActorSpatialIndex::Get(World).QuerySphere(Origin, 100.0, Found);
+	TestTrue(TEXT("Redone spawn indexed again"), Found.Num() > 0);
+
+	for (AActor* Redone : Found)
+	{
+		World->EditorDestroyActor(Redone, false);
+	}
+	return true;
+}
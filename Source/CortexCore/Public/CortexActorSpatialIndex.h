@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class ULevel;
+class USceneComponent;
+class UWorld;
+class UWorldPartition;
+enum class EUpdateTransformFlags : int32;
+enum class ETeleportType : uint8;
+
+/**
+ * Uniform hash grid over points, keyed by dense ids it hands out.
+ * Box and sphere queries visit only the cells overlapping the query bounds (or every
+ * occupied cell when that is fewer); nearest queries expand cell rings outward and stop
+ * once no farther ring can beat the current k-th distance.
+ */
+class CORTEXCORE_API FCortexSpatialGrid
+{
+public:
+	static constexpr double DefaultCellSize = 2000.0;
+
+	explicit FCortexSpatialGrid(double InCellSize = DefaultCellSize);
+
+	int32 Add(const FVector& Position);
+	void Remove(int32 Id);
+	void Move(int32 Id, const FVector& Position);
+	void Reset();
+
+	int32 Num() const { return Count; }
+	bool IsValidId(int32 Id) const { return Used.IsValidIndex(Id) && Used[Id]; }
+	const FVector& GetPosition(int32 Id) const { return Positions[Id]; }
+
+	/** Ids whose position lies inside Box (inclusive). */
+	void QueryBox(const FBox& Box, TArray<int32>& OutIds) const;
+
+	/** Ids within Radius of Center (inclusive). */
+	void QuerySphere(const FVector& Center, double Radius, TArray<int32>& OutIds) const;
+
+	/** Up to K ids within MaxRadius that pass Filter, nearest first, with their distances. */
+	void QueryNearest(
+		const FVector& Origin,
+		int32 K,
+		double MaxRadius,
+		TFunctionRef<bool(int32)> Filter,
+		TArray<TPair<int32, double>>& OutNearest) const;
+
+private:
+	FIntVector CellOf(const FVector& Position) const;
+	void LinkToCell(int32 Id, const FIntVector& Cell);
+	void UnlinkFromCell(int32 Id);
+	void CollectCellRange(const FIntVector& MinCell, const FIntVector& MaxCell, TFunctionRef<void(const TArray<int32>&)> Visit) const;
+
+	double CellSize;
+	int32 Count = 0;
+	TArray<FVector> Positions;
+	TArray<FIntVector> CellById;
+	TArray<int32> SlotInCell;
+	TBitArray<> Used;
+	TArray<int32> FreeIds;
+	TMap<FIntVector, TArray<int32>> Cells;
+};
+
+/**
+ * Per-world FCortexSpatialGrid over actor locations, shared by Level and QA queries.
+ * Built once per world, then maintained from the world's actor spawned/destroyed
+ * handlers and each root component's TransformUpdated event (editor and PIE alike);
+ * moves are queued and applied before the next query. Level add/remove, World Partition
+ * editor loading and undo/redo add or remove actors without those handlers, so they
+ * rebuild lazily; a per-level actor-count stamp checked on each Get catches anything
+ * else that changes the actor arrays between handled events. Results are re-checked
+ * against live actors. Game thread only.
+ */
+class CORTEXCORE_API FCortexActorSpatialIndex
+{
+public:
+	/** Index for a world, built on first use. */
+	static FCortexActorSpatialIndex& Get(UWorld* World);
+
+	/** Drop every world index and unbind events. */
+	static void Reset();
+
+	~FCortexActorSpatialIndex();
+
+	/** Actors whose location lies inside Box. */
+	void QueryBox(const FBox& Box, TArray<AActor*>& OutActors);
+
+	/** Actors whose location lies within Radius of Center. */
+	void QuerySphere(const FVector& Center, double Radius, TArray<AActor*>& OutActors);
+
+	/** Up to K actors within MaxRadius passing Filter, nearest first, with distances. */
+	void QueryNearest(
+		const FVector& Origin,
+		int32 K,
+		double MaxRadius,
+		TFunctionRef<bool(const AActor*)> Filter,
+		TArray<TPair<AActor*, double>>& OutNearest);
+
+	/** Visit every indexed live actor. */
+	void ForEachActor(TFunctionRef<void(AActor*)> Visit);
+
+	int32 Num();
+
+	/** Bumped whenever an actor is added or removed; lets callers cache counts. */
+	uint32 GetMembershipVersion() const { return MembershipVersion; }
+
+	/**
+	 * Number of indexed live actors passing Filter. Cached until membership changes or a
+	 * different FilterKey (whatever Filter depends on, e.g. the observing pawn) is passed.
+	 */
+	int32 CountActors(FObjectKey FilterKey, TFunctionRef<bool(const AActor*)> Filter);
+
+private:
+	explicit FCortexActorSpatialIndex(UWorld* InWorld);
+
+	void Rebuild();
+	void Clear();
+	void AddActor(AActor* Actor);
+	void RemoveActor(const AActor* Actor);
+	void FlushPendingMoves();
+	void CollectActors(const TArray<int32>& Ids, TArray<AActor*>& OutActors) const;
+
+	static uint32 ComputeActorCountStamp(UWorld* World);
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 Id);
+
+	static void HandleLevelChanged(ULevel* Level, UWorld* World);
+	static void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	static void HandleUndoRedo();
+
+	TWeakObjectPtr<UWorld> World;
+	FCortexSpatialGrid Grid;
+	TArray<TWeakObjectPtr<AActor>> ActorById;
+	TArray<TWeakObjectPtr<USceneComponent>> RootById;
+	TArray<FDelegateHandle> MoveHandleById;
+	TMap<TObjectKey<AActor>, int32> IdByActor;
+	TArray<int32> PendingMoves;
+	TBitArray<> PendingFlags;
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	TWeakObjectPtr<UWorldPartition> WorldPartition;
+	FDelegateHandle LoaderAdapterHandle;
+	uint32 MembershipVersion = 0;
+	uint32 ActorCountStamp = 0;
+	bool bStampStale = false;
+	bool bDirty = true;
+
+	FObjectKey CountedKey;
+	uint32 CountedVersion = 0;
+	int32 CountedActors = INDEX_NONE;
+
+	static TMap<TObjectKey<UWorld>, TUniquePtr<FCortexActorSpatialIndex>> Indices;
+	static FDelegateHandle LevelAddedHandle;
+	static FDelegateHandle LevelRemovedHandle;
+	static FDelegateHandle WorldCleanupHandle;
+	static FDelegateHandle UndoRedoHandle;
+};
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 
+class FJsonObject;
 class UMaterial;
 
 /**
@@ -15,6 +16,7 @@ class CORTEXCORE_API FCortexBatchScope
 {
 public:
 	using FBatchCleanupCallback = TFunction<void()>;
+	using FBatchFinalizeCallback = TFunction<TSharedPtr<FJsonObject>()>;
 
 	FCortexBatchScope();
 	~FCortexBatchScope();
@@ -33,10 +35,24 @@ public:
 	 */
 	static void AddCleanupAction(const FString& Key, FBatchCleanupCallback Callback);
 
+	/**
+	 * Register deferred work whose outcome the client must see (e.g. a deferred compile or save).
+	 * The batch runs these after its last command and before building its response, and lists
+	 * each returned report under "finalize". Same key deduplication as cleanup actions; outside
+	 * a batch the callback runs immediately and its report is dropped.
+	 */
+	static void AddFinalizeAction(const FString& Key, FBatchFinalizeCallback Callback);
+
+	/** Run pending finalize actions and collect their non-null reports. Outermost batch only. */
+	static void RunFinalizeActions(TArray<TSharedPtr<FJsonObject>>& OutReports);
+
 private:
 	/** Materials that need PostEditChange when batch ends. */
 	static TSet<TWeakObjectPtr<UMaterial>> DirtyMaterials;
 
 	/** Generic cleanup actions keyed for deduplication. */
 	static TMap<FString, FBatchCleanupCallback> CleanupActions;
+
+	/** Reporting finalize actions keyed for deduplication. */
+	static TMap<FString, FBatchFinalizeCallback> FinalizeActions;
 };
@@ -3,6 +3,7 @@
 #include "Operations/CortexGraphNodeOps.h"
 #include "Operations/CortexGraphConnectionOps.h"
 #include "Operations/CortexGraphTraceOps.h"
+#include "Operations/CortexGraphBulkOps.h"
 
 FCortexCommandResult FCortexGraphCommandHandler::Execute(
 	const FString& Command,
@@ -67,6 +68,18 @@ FCortexCommandResult FCortexGraphCommandHandler::Execute(
 	{
 		return FCortexGraphNodeOps::AutoLayout(Params);
 	}
+	if (Command == TEXT("add_nodes"))
+	{
+		return FCortexGraphBulkOps::AddNodes(Params);
+	}
+	if (Command == TEXT("connect_many"))
+	{
+		return FCortexGraphBulkOps::ConnectMany(Params);
+	}
+	if (Command == TEXT("set_pin_defaults_many"))
+	{
+		return FCortexGraphBulkOps::SetPinDefaultsMany(Params);
+	}
 
 	return FCortexCommandRouter::Error(
 		CortexErrorCodes::UnknownCommand,
@@ -90,7 +103,8 @@ TArray<FCortexCommandInfo> FCortexGraphCommandHandler::GetSupportedCommands() co
 			.Optional(TEXT("compact"), TEXT("boolean"), TEXT("Omit node_class from results (default: true)")),
 		FCortexCommandInfo{ TEXT("trace_exec"), TEXT("Trace execution flow from a starting node") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
-			.Required(TEXT("start_node_id"), TEXT("string"), TEXT("Identifier of the starting node"))
+			.Optional(TEXT("start_node_id"), TEXT("string"), TEXT("Identifier of the starting node (required unless start_node_ids is given)"))
+			.Optional(TEXT("start_node_ids"), TEXT("array"), TEXT("Several starting nodes traced in one call; returns per-root traces"))
 			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Graph containing the node"))
 			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path"))
 			.Optional(TEXT("max_depth"), TEXT("number"), TEXT("Maximum traversal depth"))
@@ -98,7 +112,8 @@ TArray<FCortexCommandInfo> FCortexGraphCommandHandler::GetSupportedCommands() co
 			.Optional(TEXT("include_edges"), TEXT("boolean"), TEXT("Include traced edge list")),
 		FCortexCommandInfo{ TEXT("trace_dataflow"), TEXT("Trace data-flow from a starting node") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
-			.Required(TEXT("start_node_id"), TEXT("string"), TEXT("Identifier of the starting node"))
+			.Optional(TEXT("start_node_id"), TEXT("string"), TEXT("Identifier of the starting node (required unless start_node_ids is given)"))
+			.Optional(TEXT("start_node_ids"), TEXT("array"), TEXT("Several starting nodes traced in one call; returns per-root traces"))
 			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Graph containing the node"))
 			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path"))
 			.Optional(TEXT("max_depth"), TEXT("number"), TEXT("Maximum traversal depth"))
@@ -154,6 +169,28 @@ TArray<FCortexCommandInfo> FCortexGraphCommandHandler::GetSupportedCommands() co
 		FCortexCommandInfo{ TEXT("auto_layout"), TEXT("Auto-arrange nodes in mutable Blueprint graphs for readability. Delegate graphs are readable but not mutable.") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
 			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Specific graph to layout"))
-			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path (e.g. 'BeginPlay.Inner')")),
+			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path (e.g. 'BeginPlay.Inner')"))
+			.Optional(TEXT("mode"), TEXT("string"), TEXT("'full' (default) or 'incremental': keep placed nodes and only position new (0,0) nodes")),
+		FCortexCommandInfo{ TEXT("add_nodes"), TEXT("Add many nodes to one mutable graph in a single transaction, optionally wiring links and pin defaults that reference nodes by local id") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
+			.Required(TEXT("nodes"), TEXT("array"), TEXT("Node specs: {id, node_class, params, position}; id is a local symbol usable in links/defaults"))
+			.Optional(TEXT("links"), TEXT("array"), TEXT("Link specs: {source_node, source_pin, target_node, target_pin}; nodes by local id or node_id"))
+			.Optional(TEXT("defaults"), TEXT("array"), TEXT("Pin default specs: {node, pin, value}; node by local id or node_id"))
+			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Target graph, defaults to EventGraph"))
+			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path (e.g. 'BeginPlay.Inner')"))
+			.Optional(TEXT("layout"), TEXT("string"), TEXT("'none' (default), 'incremental' or 'full': one layout pass over the graph after all edits"))
+			.Optional(TEXT("stop_on_error"), TEXT("boolean"), TEXT("Stop at the first failed item (default: false)")),
+		FCortexCommandInfo{ TEXT("connect_many"), TEXT("Connect many pin pairs in one mutable graph in a single transaction") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
+			.Required(TEXT("links"), TEXT("array"), TEXT("Link specs: {source_node, source_pin, target_node, target_pin}"))
+			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Graph containing the nodes"))
+			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path (e.g. 'BeginPlay.Inner')"))
+			.Optional(TEXT("stop_on_error"), TEXT("boolean"), TEXT("Stop at the first failed item (default: false)")),
+		FCortexCommandInfo{ TEXT("set_pin_defaults_many"), TEXT("Set default values on many unconnected input pins in a single transaction") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Full asset path to the Blueprint asset"))
+			.Required(TEXT("defaults"), TEXT("array"), TEXT("Pin default specs: {node, pin, value}"))
+			.Optional(TEXT("graph_name"), TEXT("string"), TEXT("Graph containing the nodes"))
+			.Optional(TEXT("subgraph_path"), TEXT("string"), TEXT("Dot-separated composite subgraph path (e.g. 'BeginPlay.Inner')"))
+			.Optional(TEXT("stop_on_error"), TEXT("boolean"), TEXT("Stop at the first failed item (default: false)")),
 	};
 }
@@ -0,0 +1,276 @@
+#include "CortexGraphLookupIndex.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+
+TMap<TObjectKey<UObject>, FCortexGraphLookupIndex::FOwnerEntry> FCortexGraphLookupIndex::OwnerEntries;
+TMap<TObjectKey<UEdGraphNode>, FCortexGraphLookupIndex::FPinEntry> FCortexGraphLookupIndex::PinEntries;
+
+namespace
+{
+	/** Entries for destroyed owners are swept once the maps grow by this many slots */
+	constexpr int32 LookupPruneInterval = 128;
+
+	bool MatchesName(const UObject* Object, const FString& Name)
+	{
+		return IsValid(Object) && Object->GetFName() == FName(*Name, FNAME_Find);
+	}
+}
+
+UEdGraphNode* FCortexGraphLookupIndex::FindNode(UEdGraph* Graph, const FString& NodeId)
+{
+	if (Graph == nullptr || NodeId.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FOwnerEntry& Entry = FindOrAddGraphEntry(Graph);
+	bool bRebuilt = false;
+	if (Entry.bDirty || Entry.CountStamp != Graph->Nodes.Num())
+	{
+		RebuildGraphEntry(Graph, Entry);
+		bRebuilt = true;
+	}
+
+	FGuid NodeGuid;
+	const bool bIsGuid = FGuid::Parse(NodeId, NodeGuid);
+
+	// Slots are re-read from Graph->Nodes, so a node removed from the graph is never a hit
+	auto Lookup = [Graph, &Entry, &NodeId, bIsGuid, &NodeGuid]() -> UEdGraphNode*
+	{
+		const int32* Slot = Entry.SlotByName.Find(NodeId);
+		UEdGraphNode* Node = (Slot && Graph->Nodes.IsValidIndex(*Slot)) ? Graph->Nodes[*Slot].Get() : nullptr;
+		if (MatchesName(Node, NodeId))
+		{
+			return Node;
+		}
+
+		Slot = bIsGuid ? Entry.SlotByGuid.Find(NodeGuid) : nullptr;
+		Node = (Slot && Graph->Nodes.IsValidIndex(*Slot)) ? Graph->Nodes[*Slot].Get() : nullptr;
+		return (IsValid(Node) && Node->NodeGuid == NodeGuid) ? Node : nullptr;
+	};
+
+	UEdGraphNode* Node = Lookup();
+	if (Node == nullptr && !bRebuilt)
+	{
+		// Stale slot or a miss against an old entry: rebuild once and retry
+		RebuildGraphEntry(Graph, Entry);
+		Node = Lookup();
+	}
+	return Node;
+}
+
+UEdGraphPin* FCortexGraphLookupIndex::FindPin(UEdGraphNode* Node, const FString& PinName)
+{
+	if (Node == nullptr)
+	{
+		return nullptr;
+	}
+
+	const FName Name(*PinName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		// Never-registered name (or literally "None"): fall back to the plain scan
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin && Pin->PinName.ToString() == PinName)
+			{
+				return Pin;
+			}
+		}
+		return nullptr;
+	}
+
+	if (!PinEntries.Contains(Node) && PinEntries.Num() >= LookupPruneInterval
+		&& PinEntries.Num() % LookupPruneInterval == 0)
+	{
+		PruneStaleEntries();
+	}
+	FPinEntry& Entry = PinEntries.FindOrAdd(Node);
+
+	auto Rebuild = [Node, &Entry]()
+	{
+		Entry.Node = Node;
+		Entry.CountStamp = Node->Pins.Num();
+		Entry.PinIndexByName.Reset();
+		for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+		{
+			if (const UEdGraphPin* Pin = Node->Pins[PinIndex])
+			{
+				Entry.PinIndexByName.FindOrAdd(Pin->PinName, PinIndex);
+			}
+		}
+	};
+
+	// Pins are recreated on reconstruction, so only the slot is cached and re-read here
+	auto FindBySlot = [Node, &Entry, Name]() -> UEdGraphPin*
+	{
+		const int32* PinIndex = Entry.PinIndexByName.Find(Name);
+		UEdGraphPin* Pin = (PinIndex && Node->Pins.IsValidIndex(*PinIndex)) ? Node->Pins[*PinIndex] : nullptr;
+		return (Pin && Pin->PinName == Name) ? Pin : nullptr;
+	};
+
+	bool bRebuilt = false;
+	if (Entry.Node.Get() != Node || Entry.CountStamp != Node->Pins.Num())
+	{
+		Rebuild();
+		bRebuilt = true;
+	}
+
+	UEdGraphPin* Pin = FindBySlot();
+	if (Pin == nullptr && !bRebuilt)
+	{
+		Rebuild();
+		Pin = FindBySlot();
+	}
+	return Pin;
+}
+
+UObject* FCortexGraphLookupIndex::FindNamedObject(
+	const UObject* Owner,
+	const FString& Name,
+	int32 Count,
+	TFunctionRef<UObject*(int32)> GetAt)
+{
+	if (Owner == nullptr || Name.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	if (!OwnerEntries.Contains(Owner) && OwnerEntries.Num() >= LookupPruneInterval
+		&& OwnerEntries.Num() % LookupPruneInterval == 0)
+	{
+		PruneStaleEntries();
+	}
+	FOwnerEntry& Entry = OwnerEntries.FindOrAdd(Owner);
+
+	auto Rebuild = [Owner, Count, &Entry, &GetAt]()
+	{
+		Entry.Owner = Owner;
+		Entry.CountStamp = Count;
+		Entry.bDirty = false;
+		Entry.SlotByName.Reset();
+		Entry.SlotByName.Reserve(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			if (const UObject* Object = GetAt(Index))
+			{
+				Entry.SlotByName.FindOrAdd(Object->GetName(), Index);
+			}
+		}
+	};
+
+	// The slot is read back through GetAt, so only objects still in the collection are hits
+	auto FindByName = [Count, &Entry, &Name, &GetAt]() -> UObject*
+	{
+		const int32* Slot = Entry.SlotByName.Find(Name);
+		UObject* Object = (Slot && *Slot < Count) ? GetAt(*Slot) : nullptr;
+		return MatchesName(Object, Name) ? Object : nullptr;
+	};
+
+	bool bRebuilt = false;
+	if (Entry.bDirty || Entry.Owner.Get() != Owner || Entry.CountStamp != Count)
+	{
+		Rebuild();
+		bRebuilt = true;
+	}
+
+	UObject* Object = FindByName();
+	if (Object == nullptr && !bRebuilt)
+	{
+		Rebuild();
+		Object = FindByName();
+	}
+	return Object;
+}
+
+void FCortexGraphLookupIndex::Invalidate(const UObject* Owner)
+{
+	if (FOwnerEntry* Entry = OwnerEntries.Find(Owner))
+	{
+		Entry->bDirty = true;
+	}
+}
+
+void FCortexGraphLookupIndex::Reset()
+{
+	for (TPair<TObjectKey<UObject>, FOwnerEntry>& Pair : OwnerEntries)
+	{
+		if (!Pair.Value.GraphChangedHandle.IsValid())
+		{
+			continue;
+		}
+		if (UEdGraph* Graph = const_cast<UEdGraph*>(Cast<UEdGraph>(Pair.Value.Owner.Get())))
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+		}
+	}
+
+	OwnerEntries.Empty();
+	PinEntries.Empty();
+}
+
+FCortexGraphLookupIndex::FOwnerEntry& FCortexGraphLookupIndex::FindOrAddGraphEntry(UEdGraph* Graph)
+{
+	const TObjectKey<UObject> Key(Graph);
+	if (FOwnerEntry* Existing = OwnerEntries.Find(Key))
+	{
+		return *Existing;
+	}
+
+	if (OwnerEntries.Num() >= LookupPruneInterval && OwnerEntries.Num() % LookupPruneInterval == 0)
+	{
+		PruneStaleEntries();
+	}
+
+	FOwnerEntry& Entry = OwnerEntries.Add(Key);
+	Entry.Owner = Graph;
+	Entry.GraphChangedHandle = Graph->AddOnGraphChangedHandler(
+		FOnGraphChanged::FDelegate::CreateLambda([Key](const FEdGraphEditAction&)
+		{
+			if (FOwnerEntry* Changed = OwnerEntries.Find(Key))
+			{
+				Changed->bDirty = true;
+			}
+		}));
+	return Entry;
+}
+
+void FCortexGraphLookupIndex::RebuildGraphEntry(UEdGraph* Graph, FOwnerEntry& Entry)
+{
+	Entry.CountStamp = Graph->Nodes.Num();
+	Entry.bDirty = false;
+	Entry.SlotByName.Reset();
+	Entry.SlotByGuid.Reset();
+	Entry.SlotByName.Reserve(Graph->Nodes.Num());
+	Entry.SlotByGuid.Reserve(Graph->Nodes.Num());
+
+	// First occurrence wins, matching the linear scans this index replaces
+	for (int32 Index = 0; Index < Graph->Nodes.Num(); ++Index)
+	{
+		if (const UEdGraphNode* Node = Graph->Nodes[Index])
+		{
+			Entry.SlotByName.FindOrAdd(Node->GetName(), Index);
+			Entry.SlotByGuid.FindOrAdd(Node->NodeGuid, Index);
+		}
+	}
+}
+
+void FCortexGraphLookupIndex::PruneStaleEntries()
+{
+	for (auto It = OwnerEntries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Owner.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = PinEntries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Node.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
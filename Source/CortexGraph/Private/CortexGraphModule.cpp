@@ -2,6 +2,8 @@
 #include "CortexCoreModule.h"
 #include "ICortexCommandRegistry.h"
 #include "CortexGraphCommandHandler.h"
+#include "CortexGraphLookupIndex.h"
+#include "CortexGraphTopology.h"
 
 DEFINE_LOG_CATEGORY(LogCortexGraph);
 
@@ -26,6 +28,8 @@ void FCortexGraphModule::StartupModule()
 void FCortexGraphModule::ShutdownModule()
 {
 	UE_LOG(LogCortexGraph, Log, TEXT("CortexGraph module shutting down"));
+	FCortexGraphLookupIndex::Reset();
+	FCortexGraphTopology::Reset();
 }
 
 IMPLEMENT_MODULE(FCortexGraphModule, CortexGraph)
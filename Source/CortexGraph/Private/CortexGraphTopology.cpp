@@ -0,0 +1,302 @@
+#include "CortexGraphTopology.h"
+#include "Operations/CortexGraphNodeOps.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Composite.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_Event.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/UObjectGlobals.h"
+
+TMap<TObjectKey<UBlueprint>, FCortexGraphTopology::FCacheEntry> FCortexGraphTopology::Cache;
+FDelegateHandle FCortexGraphTopology::ObjectModifiedHandle;
+FDelegateHandle FCortexGraphTopology::ObjectTransactedHandle;
+
+TSharedRef<const FCortexGraphTopology> FCortexGraphTopology::Get(UBlueprint* Blueprint)
+{
+	check(Blueprint);
+	BindDelegates();
+
+	// Sweep entries for unloaded Blueprints before adding a new one
+	if (!Cache.Contains(Blueprint))
+	{
+		for (auto It = Cache.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().Blueprint.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FCacheEntry& Entry = Cache.FindOrAdd(Blueprint);
+	const int32 NodeCountStamp = ComputeNodeCountStamp(Blueprint);
+	if (!Entry.Topology.IsValid()
+		|| Entry.Blueprint.Get() != Blueprint
+		|| Entry.BuiltChangeCount != Entry.ChangeCount
+		|| Entry.NodeCountStamp != NodeCountStamp)
+	{
+		TSharedRef<FCortexGraphTopology> Topology = MakeShared<FCortexGraphTopology>();
+		Topology->Build(Blueprint);
+		Entry.Blueprint = Blueprint;
+		Entry.Topology = Topology;
+		Entry.BuiltChangeCount = Entry.ChangeCount;
+		Entry.NodeCountStamp = NodeCountStamp;
+	}
+
+	return Entry.Topology.ToSharedRef();
+}
+
+void FCortexGraphTopology::Invalidate(const UBlueprint* Blueprint)
+{
+	if (FCacheEntry* Entry = Cache.Find(Blueprint))
+	{
+		Entry->Topology.Reset();
+	}
+}
+
+void FCortexGraphTopology::Reset()
+{
+	if (ObjectModifiedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+		ObjectModifiedHandle.Reset();
+	}
+	if (ObjectTransactedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+		ObjectTransactedHandle.Reset();
+	}
+	Cache.Empty();
+}
+
+TSharedRef<const FCortexGraphTopology> FCortexGraphTopology::BuildUncached(UBlueprint* Blueprint, TConstArrayView<UEdGraph*> ExtraGraphs)
+{
+	check(Blueprint);
+	TSharedRef<FCortexGraphTopology> Topology = MakeShared<FCortexGraphTopology>();
+	Topology->Build(Blueprint, ExtraGraphs);
+	return Topology;
+}
+
+int32 FCortexGraphTopology::FindNodeIndex(const UEdGraphNode* Node) const
+{
+	const int32* Found = NodeIndexByPtr.Find(Node);
+	return Found ? *Found : INDEX_NONE;
+}
+
+TConstArrayView<FCortexGraphTopology::FEdge> FCortexGraphTopology::GetExecEdges(int32 NodeIndex) const
+{
+	return TConstArrayView<FEdge>(ExecEdges.GetData() + ExecOffsets[NodeIndex],
+		ExecOffsets[NodeIndex + 1] - ExecOffsets[NodeIndex]);
+}
+
+TConstArrayView<FCortexGraphTopology::FEdge> FCortexGraphTopology::GetDataEdges(int32 NodeIndex) const
+{
+	return TConstArrayView<FEdge>(DataEdges.GetData() + DataOffsets[NodeIndex],
+		DataOffsets[NodeIndex + 1] - DataOffsets[NodeIndex]);
+}
+
+UEdGraphPin* FCortexGraphTopology::ResolvePin(const UEdGraphNode* Node, int32 PinIndex)
+{
+	return (Node && Node->Pins.IsValidIndex(PinIndex)) ? Node->Pins[PinIndex] : nullptr;
+}
+
+bool FCortexGraphTopology::IsEventHandlerNode(const UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return false;
+	}
+
+	if (Node->IsA<UK2Node_Event>() || Node->IsA<UK2Node_CustomEvent>())
+	{
+		return true;
+	}
+
+	const FString ClassName = Node->GetClass()->GetName();
+	return ClassName == TEXT("UK2Node_ActorBoundEvent") || ClassName == TEXT("UK2Node_ComponentBoundEvent");
+}
+
+void FCortexGraphTopology::Build(UBlueprint* Blueprint, TConstArrayView<UEdGraph*> ExtraGraphs)
+{
+	TArray<FCortexGraphEntry> Entries;
+	FCortexGraphNodeOps::EnumerateUserGraphs(Blueprint, Entries);
+	for (const FCortexGraphEntry& Entry : Entries)
+	{
+		CollectGraph(Entry.Graph, TEXT(""), 0);
+	}
+	for (UEdGraph* Graph : ExtraGraphs)
+	{
+		// Already-collected nodes are skipped, so only the unreached part adds records
+		CollectGraph(Graph, TEXT(""), 0);
+	}
+
+	// Pin slots, so edges can record the target pin without scanning the target node
+	TMap<const UEdGraphPin*, int32> PinSlots;
+	for (const FNodeRecord& Record : Nodes)
+	{
+		const UEdGraphNode* Node = Record.Node.Get();
+		for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+		{
+			PinSlots.Add(Node->Pins[PinIndex], PinIndex);
+		}
+	}
+
+	ExecOffsets.SetNumUninitialized(Nodes.Num() + 1);
+	DataOffsets.SetNumUninitialized(Nodes.Num() + 1);
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		ExecOffsets[NodeIndex] = ExecEdges.Num();
+		DataOffsets[NodeIndex] = DataEdges.Num();
+
+		const UEdGraphNode* Node = Nodes[NodeIndex].Node.Get();
+		for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+		{
+			const UEdGraphPin* Pin = Node->Pins[PinIndex];
+			if (!Pin || Pin->Direction != EGPD_Output)
+			{
+				continue;
+			}
+
+			TArray<FEdge>& Edges = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec ? ExecEdges : DataEdges;
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const int32* TargetIndex = LinkedPin ? NodeIndexByPtr.Find(LinkedPin->GetOwningNode()) : nullptr;
+				const int32* TargetPin = LinkedPin ? PinSlots.Find(LinkedPin) : nullptr;
+				if (TargetIndex && TargetPin)
+				{
+					Edges.Add(FEdge{*TargetIndex, PinIndex, *TargetPin});
+				}
+			}
+		}
+
+		if (IsEventHandlerNode(Node))
+		{
+			EventHandlers.Add(NodeIndex);
+		}
+		else if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			FCallRecord& Call = FunctionCalls.AddDefaulted_GetRef();
+			Call.NodeIndex = NodeIndex;
+			const UFunction* TargetFunction = CallNode->GetTargetFunction();
+			Call.FunctionName = TargetFunction
+				? TargetFunction->GetName()
+				: CallNode->FunctionReference.GetMemberName().ToString();
+		}
+	}
+	ExecOffsets[Nodes.Num()] = ExecEdges.Num();
+	DataOffsets[Nodes.Num()] = DataEdges.Num();
+}
+
+void FCortexGraphTopology::CollectGraph(UEdGraph* Graph, const FString& SubgraphPath, int32 Depth)
+{
+	if (!Graph || Depth > MaxSubgraphDepth)
+	{
+		return;
+	}
+
+	const int32 GraphIndex = Graphs.Num();
+	FGraphRecord& GraphRecord = Graphs.AddDefaulted_GetRef();
+	GraphRecord.Graph = Graph;
+	GraphRecord.SubgraphPath = SubgraphPath;
+	GraphRecord.FirstNode = Nodes.Num();
+
+	TArray<const UK2Node_Composite*> Composites;
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		// A node listed twice keeps its first index, matching the name lookups
+		if (!Node || NodeIndexByPtr.Contains(Node))
+		{
+			continue;
+		}
+
+		NodeIndexByPtr.Add(Node, Nodes.Num());
+		FNodeRecord& Record = Nodes.AddDefaulted_GetRef();
+		Record.Node = Node;
+		Record.Name = Node->GetFName();
+		Record.GraphIndex = GraphIndex;
+
+		const UK2Node_Composite* CompositeNode = Cast<UK2Node_Composite>(Node);
+		if (CompositeNode && CompositeNode->BoundGraph)
+		{
+			Composites.Add(CompositeNode);
+		}
+	}
+	Graphs[GraphIndex].NumNodes = Nodes.Num() - Graphs[GraphIndex].FirstNode;
+
+	// Subgraphs follow their parent, in the same order the trace commands have always searched;
+	// other nested graphs (non-composite owners) come after the composites
+	TArray<UEdGraph*, TInlineAllocator<8>> ChildGraphs;
+	for (const UK2Node_Composite* CompositeNode : Composites)
+	{
+		ChildGraphs.AddUnique(CompositeNode->BoundGraph);
+	}
+	for (UEdGraph* SubGraph : Graph->SubGraphs)
+	{
+		if (SubGraph)
+		{
+			ChildGraphs.AddUnique(SubGraph);
+		}
+	}
+
+	for (UEdGraph* ChildGraph : ChildGraphs)
+	{
+		const FString ChildPath = SubgraphPath.IsEmpty()
+			? ChildGraph->GetName()
+			: FString::Printf(TEXT("%s.%s"), *SubgraphPath, *ChildGraph->GetName());
+		CollectGraph(ChildGraph, ChildPath, Depth + 1);
+	}
+}
+
+void FCortexGraphTopology::BindDelegates()
+{
+	if (!ObjectModifiedHandle.IsValid())
+	{
+		ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddStatic(&FCortexGraphTopology::HandleObjectModified);
+	}
+	if (!ObjectTransactedHandle.IsValid())
+	{
+		ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddStatic(&FCortexGraphTopology::HandleObjectTransacted);
+	}
+}
+
+void FCortexGraphTopology::HandleObjectModified(UObject* Object)
+{
+	// Pin link changes Modify() their owning nodes; node add/remove Modify() the graph
+	if (Cache.Num() == 0 || !Object || !(Object->IsA<UEdGraphNode>() || Object->IsA<UEdGraph>()))
+	{
+		return;
+	}
+
+	if (UBlueprint* Blueprint = Object->GetTypedOuter<UBlueprint>())
+	{
+		if (FCacheEntry* Entry = Cache.Find(Blueprint))
+		{
+			++Entry->ChangeCount;
+		}
+	}
+}
+
+void FCortexGraphTopology::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	(void)Event;
+	HandleObjectModified(Object);
+}
+
+int32 FCortexGraphTopology::ComputeNodeCountStamp(UBlueprint* Blueprint)
+{
+	// Cheap safety net for edits that bypass Modify(): top-level graph and node counts
+	TArray<FCortexGraphEntry> Entries;
+	FCortexGraphNodeOps::EnumerateUserGraphs(Blueprint, Entries);
+
+	uint32 Stamp = Entries.Num();
+	for (const FCortexGraphEntry& Entry : Entries)
+	{
+		Stamp = HashCombineFast(Stamp, Entry.Graph->Nodes.Num());
+	}
+	return static_cast<int32>(Stamp);
+}
@@ -0,0 +1,429 @@
+#include "Operations/CortexGraphBulkOps.h"
+#include "Operations/CortexGraphNodeOps.h"
+#include "Operations/CortexGraphConnectionOps.h"
+#include "CortexGraphModule.h"
+#include "CortexGraphLayoutOps.h"
+#include "CortexGraphLookupIndex.h"
+#include "CortexBatchScope.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
+
+namespace
+{
+FString GetFirstStringField(const TSharedPtr<FJsonObject>& Object, std::initializer_list<const TCHAR*> FieldNames)
+{
+	FString Value;
+	for (const TCHAR* FieldName : FieldNames)
+	{
+		if (Object->TryGetStringField(FieldName, Value) && !Value.IsEmpty())
+		{
+			return Value;
+		}
+	}
+	return FString();
+}
+
+TSharedPtr<FJsonObject> MakeBulkErrorEntry(int32 Index, const FCortexCommandResult& Error)
+{
+	TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+	Entry->SetNumberField(TEXT("index"), Index);
+	Entry->SetStringField(TEXT("error"), Error.ErrorCode);
+	Entry->SetStringField(TEXT("message"), Error.ErrorMessage);
+	return Entry;
+}
+}
+
+FCortexCommandResult FCortexGraphBulkOps::AddNodes(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+	if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("nodes"), Nodes) || Nodes->Num() == 0)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required param: nodes (non-empty array)")
+		);
+	}
+
+	return ApplyBulkEdit(Params, TEXT("Cortex: Add nodes"));
+}
+
+FCortexCommandResult FCortexGraphBulkOps::ConnectMany(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Links = nullptr;
+	if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("links"), Links) || Links->Num() == 0)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required param: links (non-empty array)")
+		);
+	}
+
+	return ApplyBulkEdit(Params, TEXT("Cortex: Connect pins"));
+}
+
+FCortexCommandResult FCortexGraphBulkOps::SetPinDefaultsMany(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Defaults = nullptr;
+	if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("defaults"), Defaults) || Defaults->Num() == 0)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required param: defaults (non-empty array)")
+		);
+	}
+
+	return ApplyBulkEdit(Params, TEXT("Cortex: Set pin values"));
+}
+
+FCortexCommandResult FCortexGraphBulkOps::ApplyBulkEdit(
+	const TSharedPtr<FJsonObject>& Params,
+	const FString& TransactionLabel)
+{
+	FString AssetPath;
+	if (!Params->TryGetStringField(TEXT("asset_path"), AssetPath))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required param: asset_path")
+		);
+	}
+
+	static const TArray<TSharedPtr<FJsonValue>> EmptyArray;
+	const TArray<TSharedPtr<FJsonValue>>* NodeSpecs = &EmptyArray;
+	const TArray<TSharedPtr<FJsonValue>>* LinkSpecs = &EmptyArray;
+	const TArray<TSharedPtr<FJsonValue>>* DefaultSpecs = &EmptyArray;
+	Params->TryGetArrayField(TEXT("nodes"), NodeSpecs);
+	Params->TryGetArrayField(TEXT("links"), LinkSpecs);
+	Params->TryGetArrayField(TEXT("defaults"), DefaultSpecs);
+
+	const int32 TotalItems = NodeSpecs->Num() + LinkSpecs->Num() + DefaultSpecs->Num();
+	if (TotalItems > MaxBulkItems)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			FString::Printf(TEXT("Too many items: %d (max %d per request)"), TotalItems, MaxBulkItems)
+		);
+	}
+
+	FString LayoutModeStr;
+	Params->TryGetStringField(TEXT("layout"), LayoutModeStr);
+	if (!LayoutModeStr.IsEmpty() && LayoutModeStr != TEXT("none")
+		&& LayoutModeStr != TEXT("incremental") && LayoutModeStr != TEXT("full"))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			FString::Printf(TEXT("Invalid layout: %s (expected none, incremental or full)"), *LayoutModeStr)
+		);
+	}
+
+	bool bStopOnError = false;
+	Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+
+	FCortexCommandResult LoadError;
+	UBlueprint* Blueprint = nullptr;
+	UEdGraph* Graph = nullptr;
+	if (!FCortexGraphNodeOps::ResolveMutableTargetGraph(Params, AssetPath, Blueprint, Graph, LoadError))
+	{
+		return LoadError;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TUniquePtr<FScopedTransaction> Transaction;
+	if (!FCortexCommandRouter::IsInBatch())
+	{
+		Transaction = MakeUnique<FScopedTransaction>(FText::FromString(TransactionLabel));
+	}
+	Graph->Modify();
+
+	TMap<FString, UEdGraphNode*> Symbols;
+	TSharedPtr<FJsonObject> SymbolMap = MakeShared<FJsonObject>();
+	int32 AddedCount = 0;
+	int32 ConnectedCount = 0;
+	int32 DefaultsSetCount = 0;
+	int32 ErrorCount = 0;
+	bool bStopped = false;
+
+	// Symbolic ids from this request win over node names already in the graph
+	auto ResolveNodeRef = [&Symbols, Graph](const FString& Ref, FCortexCommandResult& OutError) -> UEdGraphNode*
+	{
+		if (UEdGraphNode* const* Found = Symbols.Find(Ref))
+		{
+			return *Found;
+		}
+		return FCortexGraphNodeOps::FindNode(Graph, Ref, OutError);
+	};
+
+	auto RecordError = [&ErrorCount, &bStopped, bStopOnError](
+		TArray<TSharedPtr<FJsonValue>>& OutResults, int32 Index, const FCortexCommandResult& Error)
+	{
+		OutResults.Add(MakeShared<FJsonValueObject>(MakeBulkErrorEntry(Index, Error)));
+		++ErrorCount;
+		bStopped = bStopOnError;
+	};
+
+	TArray<TSharedPtr<FJsonValue>> NodeResults;
+	for (int32 Index = 0; Index < NodeSpecs->Num() && !bStopped; ++Index)
+	{
+		const TSharedPtr<FJsonObject>* SpecPtr = nullptr;
+		if (!(*NodeSpecs)[Index].IsValid() || !(*NodeSpecs)[Index]->TryGetObject(SpecPtr))
+		{
+			RecordError(NodeResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, TEXT("Node spec must be an object")));
+			continue;
+		}
+		const TSharedPtr<FJsonObject>& Spec = *SpecPtr;
+
+		FString Symbol;
+		Spec->TryGetStringField(TEXT("id"), Symbol);
+		if (!Symbol.IsEmpty() && Symbols.Contains(Symbol))
+		{
+			RecordError(NodeResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, FString::Printf(TEXT("Duplicate node id: %s"), *Symbol)));
+			continue;
+		}
+
+		FString NodeClassName;
+		if (!Spec->TryGetStringField(TEXT("node_class"), NodeClassName))
+		{
+			RecordError(NodeResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, TEXT("Missing required field: node_class")));
+			continue;
+		}
+
+		FCortexCommandResult ItemError;
+		UClass* NodeClass = FCortexGraphNodeOps::ResolveNodeClass(NodeClassName, Spec, ItemError);
+		UEdGraphNode* NewNode = NodeClass
+			? FCortexGraphNodeOps::CreateNode(Blueprint, Graph, NodeClass, Spec, ItemError)
+			: nullptr;
+		if (NewNode == nullptr)
+		{
+			RecordError(NodeResults, Index, ItemError);
+			continue;
+		}
+
+		if (!Symbol.IsEmpty())
+		{
+			Symbols.Add(Symbol, NewNode);
+			SymbolMap->SetStringField(Symbol, NewNode->GetName());
+		}
+
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("index"), Index);
+		if (!Symbol.IsEmpty())
+		{
+			Entry->SetStringField(TEXT("id"), Symbol);
+		}
+		Entry->SetStringField(TEXT("node_id"), NewNode->GetName());
+		Entry->SetStringField(TEXT("node_class"), NewNode->GetClass()->GetName());
+		NodeResults.Add(MakeShared<FJsonValueObject>(Entry));
+		++AddedCount;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> LinkResults;
+	for (int32 Index = 0; Index < LinkSpecs->Num() && !bStopped; ++Index)
+	{
+		const TSharedPtr<FJsonObject>* SpecPtr = nullptr;
+		if (!(*LinkSpecs)[Index].IsValid() || !(*LinkSpecs)[Index]->TryGetObject(SpecPtr))
+		{
+			RecordError(LinkResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, TEXT("Link spec must be an object")));
+			continue;
+		}
+
+		// Same aliases as connect
+		const FString SourceRef = GetFirstStringField(*SpecPtr, {TEXT("source_node"), TEXT("from_node"), TEXT("source_node_id")});
+		const FString SourcePinName = GetFirstStringField(*SpecPtr, {TEXT("source_pin"), TEXT("from_pin")});
+		const FString TargetRef = GetFirstStringField(*SpecPtr, {TEXT("target_node"), TEXT("to_node"), TEXT("target_node_id")});
+		const FString TargetPinName = GetFirstStringField(*SpecPtr, {TEXT("target_pin"), TEXT("to_pin")});
+		if (SourceRef.IsEmpty() || SourcePinName.IsEmpty() || TargetRef.IsEmpty() || TargetPinName.IsEmpty())
+		{
+			RecordError(LinkResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField,
+				TEXT("Link requires source_node, source_pin, target_node and target_pin")));
+			continue;
+		}
+
+		FCortexCommandResult ItemError;
+		UEdGraphNode* SourceNode = ResolveNodeRef(SourceRef, ItemError);
+		UEdGraphNode* TargetNode = SourceNode ? ResolveNodeRef(TargetRef, ItemError) : nullptr;
+		if (SourceNode == nullptr || TargetNode == nullptr)
+		{
+			RecordError(LinkResults, Index, ItemError);
+			continue;
+		}
+
+		UEdGraphPin* SourcePin = FCortexGraphLookupIndex::FindPin(SourceNode, SourcePinName);
+		UEdGraphPin* TargetPin = FCortexGraphLookupIndex::FindPin(TargetNode, TargetPinName);
+		if (SourcePin == nullptr || TargetPin == nullptr)
+		{
+			RecordError(LinkResults, Index, FCortexCommandRouter::Error(CortexErrorCodes::PinNotFound,
+				SourcePin == nullptr
+					? FString::Printf(TEXT("Source pin '%s' not found on node '%s'"), *SourcePinName, *SourceRef)
+					: FString::Printf(TEXT("Target pin '%s' not found on node '%s'"), *TargetPinName, *TargetRef)));
+			continue;
+		}
+
+		if (!FCortexGraphConnectionOps::CanConnectPins(Graph, SourcePin, TargetPin, ItemError))
+		{
+			RecordError(LinkResults, Index, ItemError);
+			continue;
+		}
+
+		FCortexGraphConnectionOps::ConnectPins(Graph, SourcePin, TargetPin);
+
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("index"), Index);
+		Entry->SetBoolField(TEXT("connected"), true);
+		Entry->SetStringField(TEXT("source"), FString::Printf(TEXT("%s.%s"), *SourceNode->GetName(), *SourcePinName));
+		Entry->SetStringField(TEXT("target"), FString::Printf(TEXT("%s.%s"), *TargetNode->GetName(), *TargetPinName));
+		LinkResults.Add(MakeShared<FJsonValueObject>(Entry));
+		++ConnectedCount;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> DefaultResults;
+	for (int32 Index = 0; Index < DefaultSpecs->Num() && !bStopped; ++Index)
+	{
+		const TSharedPtr<FJsonObject>* SpecPtr = nullptr;
+		if (!(*DefaultSpecs)[Index].IsValid() || !(*DefaultSpecs)[Index]->TryGetObject(SpecPtr))
+		{
+			RecordError(DefaultResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, TEXT("Default spec must be an object")));
+			continue;
+		}
+
+		const FString NodeRef = GetFirstStringField(*SpecPtr, {TEXT("node"), TEXT("node_id")});
+		const FString PinName = GetFirstStringField(*SpecPtr, {TEXT("pin"), TEXT("pin_name")});
+		FString Value;
+		if (NodeRef.IsEmpty() || PinName.IsEmpty() || !(*SpecPtr)->TryGetStringField(TEXT("value"), Value))
+		{
+			RecordError(DefaultResults, Index, FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField, TEXT("Default requires node, pin and value")));
+			continue;
+		}
+
+		FCortexCommandResult ItemError;
+		UEdGraphNode* Node = ResolveNodeRef(NodeRef, ItemError);
+		UEdGraphPin* Pin = Node ? FCortexGraphNodeOps::FindPin(Node, PinName, ItemError) : nullptr;
+		if (Pin == nullptr || !FCortexGraphNodeOps::ApplyPinDefault(Node, Pin, Value, ItemError))
+		{
+			RecordError(DefaultResults, Index, ItemError);
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("index"), Index);
+		Entry->SetStringField(TEXT("node_id"), Node->GetName());
+		Entry->SetStringField(TEXT("pin_name"), PinName);
+		Entry->SetStringField(TEXT("value"), Value);
+		DefaultResults.Add(MakeShared<FJsonValueObject>(Entry));
+		++DefaultsSetCount;
+	}
+
+	const bool bChanged = AddedCount > 0 || ConnectedCount > 0 || DefaultsSetCount > 0;
+
+	// Single layout pass over the edited graph; incremental keeps existing nodes pinned
+	int32 LayoutMovedCount = 0;
+	double LayoutSeconds = 0.0;
+	const bool bRunLayout = bChanged && !LayoutModeStr.IsEmpty() && LayoutModeStr != TEXT("none");
+	if (bRunLayout)
+	{
+		FCortexLayoutConfig Config;
+		Config.Direction = ECortexLayoutDirection::LeftToRight;
+		Config.Mode = LayoutModeStr == TEXT("incremental") ? ECortexLayoutMode::Incremental : ECortexLayoutMode::Full;
+		int32 LayoutNodeCount = 0;
+		LayoutMovedCount = FCortexGraphNodeOps::LayoutGraph(Graph, Config, LayoutNodeCount, LayoutSeconds);
+	}
+
+	if (!bChanged)
+	{
+		// Nothing applied: leave no empty undo entry and keep the Blueprint clean
+		if (Transaction.IsValid())
+		{
+			Transaction->Cancel();
+		}
+	}
+	else if (FCortexCommandRouter::IsInBatch())
+	{
+		FString GraphKey = FString::Printf(TEXT("graph.notify.%s"), *Graph->GetPathName());
+		FCortexBatchScope::AddCleanupAction(GraphKey,
+			[WeakGraph = TWeakObjectPtr<UEdGraph>(Graph)]()
+			{
+				if (UEdGraph* G = WeakGraph.Get()) G->NotifyGraphChanged();
+			});
+
+		const bool bStructural = AddedCount > 0;
+		FString BPKey = FString::Printf(TEXT("blueprint.%s.%s"),
+			bStructural ? TEXT("structural") : TEXT("modified"), *Blueprint->GetPathName());
+		FCortexBatchScope::AddCleanupAction(BPKey,
+			[WeakBP = TWeakObjectPtr<UBlueprint>(Blueprint), bStructural]()
+			{
+				if (UBlueprint* BP = WeakBP.Get())
+				{
+					if (bStructural)
+					{
+						FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(BP);
+					}
+					else
+					{
+						FBlueprintEditorUtils::MarkBlueprintAsModified(BP);
+					}
+				}
+			});
+	}
+	else
+	{
+		Graph->NotifyGraphChanged();
+		if (AddedCount > 0)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
+		else
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		}
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	Data->SetStringField(TEXT("graph_name"), Graph->GetName());
+	if (NodeSpecs->Num() > 0)
+	{
+		Data->SetObjectField(TEXT("node_ids"), SymbolMap);
+		Data->SetArrayField(TEXT("nodes"), NodeResults);
+	}
+	if (LinkSpecs->Num() > 0)
+	{
+		Data->SetArrayField(TEXT("links"), LinkResults);
+	}
+	if (DefaultSpecs->Num() > 0)
+	{
+		Data->SetArrayField(TEXT("defaults"), DefaultResults);
+	}
+	Data->SetNumberField(TEXT("added_count"), AddedCount);
+	Data->SetNumberField(TEXT("connected_count"), ConnectedCount);
+	Data->SetNumberField(TEXT("defaults_set_count"), DefaultsSetCount);
+	Data->SetNumberField(TEXT("error_count"), ErrorCount);
+	if (bStopped)
+	{
+		Data->SetBoolField(TEXT("stopped"), true);
+	}
+	if (bRunLayout)
+	{
+		Data->SetStringField(TEXT("layout"), LayoutModeStr);
+		Data->SetNumberField(TEXT("moved_count"), LayoutMovedCount);
+		Data->SetNumberField(TEXT("layout_ms"), LayoutSeconds * 1000.0);
+	}
+	Data->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	UE_LOG(LogCortexGraph, Log, TEXT("Bulk edit %s: %d nodes, %d links, %d defaults, %d errors"),
+		*AssetPath, AddedCount, ConnectedCount, DefaultsSetCount, ErrorCount);
+
+	return FCortexCommandRouter::Success(Data);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CortexCommandRouter.h"
+
+/**
+ * Bulk graph editing: add_nodes, connect_many and set_pin_defaults_many.
+ * Each command edits one graph inside a single transaction; graph refresh and
+ * Blueprint modification are deferred until every item has been applied.
+ * Node specs may carry a local symbolic "id" that later links/defaults in the
+ * same request use instead of the generated node name.
+ */
+class FCortexGraphBulkOps
+{
+public:
+	static FCortexCommandResult AddNodes(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult ConnectMany(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult SetPinDefaultsMany(const TSharedPtr<FJsonObject>& Params);
+
+private:
+	static constexpr int32 MaxBulkItems = 2000;
+
+	/** Shared driver: applies nodes, then links, then defaults from whichever arrays are present. */
+	static FCortexCommandResult ApplyBulkEdit(const TSharedPtr<FJsonObject>& Params, const FString& TransactionLabel);
+};
@@ -169,51 +169,95 @@ FCortexCommandResult FCortexGraphConnectionOps::Connect(const TSharedPtr<FJsonOb
 			FString::Printf(TEXT("Target pin '%s' not found on node '%s'"), *TargetPinName, *TargetNodeId));
 	}
 
+	// Validate connection via schema BEFORE creating transaction
+	if (!CanConnectPins(Graph, SourcePin, TargetPin, LoadError))
+	{
+		return LoadError;
+	}
+
+	// Create transaction only after validation passes
+	FScopedTransaction Transaction(FText::FromString(TEXT("Cortex:Connect Pins")));
+	Graph->Modify();
+
+	ConnectPins(Graph, SourcePin, TargetPin);
+
+	Graph->NotifyGraphChanged();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetBoolField(TEXT("connected"), true);
+	Data->SetStringField(TEXT("source"), FString::Printf(TEXT("%s.%s"), *SourceNodeId, *SourcePinName));
+	Data->SetStringField(TEXT("target"), FString::Printf(TEXT("%s.%s"), *TargetNodeId, *TargetPinName));
+
+	UE_LOG(LogCortexGraph, Log, TEXT("Connected %s.%s -> %s.%s"),
+		*SourceNodeId, *SourcePinName, *TargetNodeId, *TargetPinName);
+
+	return FCortexCommandRouter::Success(Data);
+}
+
+bool FCortexGraphConnectionOps::CanConnectPins(
+	UEdGraph* Graph,
+	UEdGraphPin* SourcePin,
+	UEdGraphPin* TargetPin,
+	FCortexCommandResult& OutError)
+{
 	// Check if already connected
 	if (SourcePin->LinkedTo.Contains(TargetPin))
 	{
-		return FCortexCommandRouter::Error(CortexErrorCodes::ConnectionExists,
+		OutError = FCortexCommandRouter::Error(CortexErrorCodes::ConnectionExists,
 			TEXT("Pins are already connected"));
+		return false;
 	}
 
-	// Validate connection via schema BEFORE creating transaction
 	const UEdGraphSchema* Schema = Graph->GetSchema();
 	if (Schema != nullptr)
 	{
 		FPinConnectionResponse Response = Schema->CanCreateConnection(SourcePin, TargetPin);
 		if (Response.Response == CONNECT_RESPONSE_DISALLOW)
 		{
-			return FCortexCommandRouter::Error(CortexErrorCodes::PinTypeMismatch,
+			OutError = FCortexCommandRouter::Error(CortexErrorCodes::PinTypeMismatch,
 				FString::Printf(TEXT("Cannot connect: %s"), *Response.Message.ToString()));
+			return false;
 		}
 	}
 
-	// Create transaction only after validation passes
-	FScopedTransaction Transaction(FText::FromString(TEXT("Cortex:Connect Pins")));
-	Graph->Modify();
+	return true;
+}
 
-	// Make the connection (schema handles breaking existing connections if needed)
-	if (Schema != nullptr)
+void FCortexGraphConnectionOps::ConnectPins(UEdGraph* Graph, UEdGraphPin* SourcePin, UEdGraphPin* TargetPin)
+{
+	const UEdGraphSchema* Schema = Graph->GetSchema();
+	const ECanCreateConnectionResponse Response = Schema != nullptr
+		? ECanCreateConnectionResponse(Schema->CanCreateConnection(SourcePin, TargetPin).Response)
+		: CONNECT_RESPONSE_MAKE;
+
+	if (Response == CONNECT_RESPONSE_DISALLOW)
 	{
-		Schema->TryCreateConnection(SourcePin, TargetPin);
+		return;
 	}
-	else
+
+	// Conversion and promotion spawn helper nodes, which only the schema knows how to build
+	if (Response == CONNECT_RESPONSE_MAKE_WITH_CONVERSION_NODE || Response == CONNECT_RESPONSE_MAKE_WITH_PROMOTION)
 	{
-		SourcePin->MakeLinkTo(TargetPin);
+		Schema->TryCreateConnection(SourcePin, TargetPin);
+		return;
 	}
 
-	Graph->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetBoolField(TEXT("connected"), true);
-	Data->SetStringField(TEXT("source"), FString::Printf(TEXT("%s.%s"), *SourceNodeId, *SourcePinName));
-	Data->SetStringField(TEXT("target"), FString::Printf(TEXT("%s.%s"), *TargetNodeId, *TargetPinName));
-
-	UE_LOG(LogCortexGraph, Log, TEXT("Connected %s.%s -> %s.%s"),
-		*SourceNodeId, *SourcePinName, *TargetNodeId, *TargetPinName);
+	// Same as the schema's direct cases, minus the K2 schema's MarkBlueprintAsModified per link
+	SourcePin->Modify();
+	TargetPin->Modify();
+	if (Response == CONNECT_RESPONSE_BREAK_OTHERS_A || Response == CONNECT_RESPONSE_BREAK_OTHERS_AB)
+	{
+		SourcePin->BreakAllPinLinks(true);
+	}
+	if (Response == CONNECT_RESPONSE_BREAK_OTHERS_B || Response == CONNECT_RESPONSE_BREAK_OTHERS_AB)
+	{
+		TargetPin->BreakAllPinLinks(true);
+	}
+	SourcePin->MakeLinkTo(TargetPin);
 
-	return FCortexCommandRouter::Success(Data);
+	SourcePin->GetOwningNode()->PinConnectionListChanged(SourcePin);
+	TargetPin->GetOwningNode()->PinConnectionListChanged(TargetPin);
 }
 
 FCortexCommandResult FCortexGraphConnectionOps::Disconnect(const TSharedPtr<FJsonObject>& Params)
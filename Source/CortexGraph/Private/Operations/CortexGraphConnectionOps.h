@@ -3,9 +3,22 @@
 #include "CoreMinimal.h"
 #include "CortexCommandRouter.h"
 
+class UEdGraph;
+class UEdGraphPin;
+
 class FCortexGraphConnectionOps
 {
 public:
 	static FCortexCommandResult Connect(const TSharedPtr<FJsonObject>& Params);
 	static FCortexCommandResult Disconnect(const TSharedPtr<FJsonObject>& Params);
+
+	/** Reject links that already exist or that the graph schema disallows. */
+	static bool CanConnectPins(UEdGraph* Graph, UEdGraphPin* SourcePin, UEdGraphPin* TargetPin, FCortexCommandResult& OutError);
+
+	/**
+	 * Link two validated pins without notifying the graph or marking the Blueprint modified;
+	 * only links that need a conversion or promotion node go through the schema (which does both).
+	 * Caller owns the transaction and notifies once.
+	 */
+	static void ConnectPins(UEdGraph* Graph, UEdGraphPin* SourcePin, UEdGraphPin* TargetPin);
 };
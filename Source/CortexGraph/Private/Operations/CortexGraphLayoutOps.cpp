@@ -1,6 +1,242 @@
 #include "CortexGraphLayoutOps.h"
 #include "CortexGraphModule.h"
 
+namespace
+{
+	constexpr int32 DefaultLayoutNodeWidth = 150;
+	constexpr int32 DefaultLayoutNodeHeight = 100;
+
+	/** Consecutive non-improving sweeps tolerated before crossing reduction stops */
+	constexpr int32 OrderingStallLimit = 2;
+
+	FIntPoint SnapToGrid(const FIntPoint& Position)
+	{
+		return FIntPoint(
+			FMath::RoundToInt(Position.X / static_cast<float>(CortexGraphLayout::GridSnapSize)) * CortexGraphLayout::GridSnapSize,
+			FMath::RoundToInt(Position.Y / static_cast<float>(CortexGraphLayout::GridSnapSize)) * CortexGraphLayout::GridSnapSize);
+	}
+
+	/** Uniform grid over occupied node rectangles, used to keep incremental placements clear of placed nodes */
+	struct FLayoutOccupancyGrid
+	{
+		TArray<FIntRect> Rects;
+		TMap<FIntPoint, TArray<int32>> Cells;
+		int32 MaxY = MIN_int32;
+
+		static int32 CellOf(int32 Coordinate)
+		{
+			return FMath::FloorToInt(Coordinate / static_cast<float>(CortexGraphLayout::OccupancyCellSize));
+		}
+
+		void Add(const FIntRect& Rect)
+		{
+			const int32 RectIndex = Rects.Add(Rect);
+			MaxY = FMath::Max(MaxY, Rect.Max.Y);
+			for (int32 CellY = CellOf(Rect.Min.Y); CellY <= CellOf(Rect.Max.Y); ++CellY)
+			{
+				for (int32 CellX = CellOf(Rect.Min.X); CellX <= CellOf(Rect.Max.X); ++CellX)
+				{
+					Cells.FindOrAdd(FIntPoint(CellX, CellY)).Add(RectIndex);
+				}
+			}
+		}
+
+		/** Greatest bottom edge among rects intersecting Query (grown by Margin), or MIN_int32 if clear */
+		int32 FindOverlapBottom(const FIntRect& Query, int32 Margin) const
+		{
+			const FIntRect Grown(Query.Min - FIntPoint(Margin, Margin), Query.Max + FIntPoint(Margin, Margin));
+			int32 Bottom = MIN_int32;
+			for (int32 CellY = CellOf(Grown.Min.Y); CellY <= CellOf(Grown.Max.Y); ++CellY)
+			{
+				for (int32 CellX = CellOf(Grown.Min.X); CellX <= CellOf(Grown.Max.X); ++CellX)
+				{
+					const TArray<int32>* CellRects = Cells.Find(FIntPoint(CellX, CellY));
+					if (!CellRects)
+					{
+						continue;
+					}
+					for (const int32 RectIndex : *CellRects)
+					{
+						const FIntRect& Rect = Rects[RectIndex];
+						if (Rect.Min.X < Grown.Max.X && Grown.Min.X < Rect.Max.X &&
+							Rect.Min.Y < Grown.Max.Y && Grown.Min.Y < Rect.Max.Y)
+						{
+							Bottom = FMath::Max(Bottom, Rect.Max.Y);
+						}
+					}
+				}
+			}
+			return Bottom;
+		}
+	};
+}
+
+/** Compressed sparse row adjacency: row I spans Targets[Offsets[I] .. Offsets[I + 1]) */
+struct FCortexLayoutCsr
+{
+	TArray<int32> Offsets;
+	TArray<int32> Targets;
+
+	int32 Count(int32 Index) const
+	{
+		return Offsets[Index + 1] - Offsets[Index];
+	}
+
+	TConstArrayView<int32> Row(int32 Index) const
+	{
+		return MakeArrayView(Targets.GetData() + Offsets[Index], Count(Index));
+	}
+
+	/**
+	 * Build from (row, target) pairs. Pair order is preserved within each row so
+	 * traversal order matches the order edges were discovered. With bUnique, only
+	 * the first occurrence of each target per row is kept.
+	 */
+	void Build(int32 NumRows, const TArray<TPair<int32, int32>>& Pairs, bool bUnique)
+	{
+		Offsets.Init(0, NumRows + 1);
+		for (const TPair<int32, int32>& Pair : Pairs)
+		{
+			++Offsets[Pair.Key + 1];
+		}
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			Offsets[Row + 1] += Offsets[Row];
+		}
+
+		Targets.SetNumUninitialized(Pairs.Num());
+		TArray<int32> Cursor(Offsets.GetData(), NumRows);
+		for (const TPair<int32, int32>& Pair : Pairs)
+		{
+			Targets[Cursor[Pair.Key]++] = Pair.Value;
+		}
+
+		if (!bUnique)
+		{
+			return;
+		}
+
+		TArray<int32> SeenInRow;
+		SeenInRow.Init(INDEX_NONE, NumRows);
+		int32 Write = 0;
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			const int32 Begin = Offsets[Row];
+			const int32 End = Offsets[Row + 1];
+			Offsets[Row] = Write;
+			for (int32 Read = Begin; Read < End; ++Read)
+			{
+				const int32 Target = Targets[Read];
+				if (SeenInRow[Target] != Row)
+				{
+					SeenInRow[Target] = Row;
+					Targets[Write++] = Target;
+				}
+			}
+		}
+		Offsets[NumRows] = Write;
+		Targets.SetNum(Write);
+	}
+};
+
+struct FCortexGraphLayoutOps::FIndexedGraph
+{
+	enum ENodeFlags : uint8
+	{
+		EntryPoint = 1 << 0,
+		ExecNode = 1 << 1,
+		// Referenced by an edge but not part of this graph's node list. Phantoms keep
+		// default dimensions and have no outgoing edges.
+		Phantom = 1 << 2,
+		Pinned = 1 << 3,
+	};
+
+	/** Index of the node in the id-owning graph built from the caller's nodes */
+	TArray<int32> SourceIndex;
+	/** Lexical rank of the node id, replacing string compares for deterministic tie-breaks */
+	TArray<int32> IdRank;
+	TArray<int32> Width;
+	TArray<int32> Height;
+	TArray<uint8> Flags;
+
+	FCortexLayoutCsr ExecOut;     // duplicates preserved
+	FCortexLayoutCsr DataOut;     // duplicates preserved
+	FCortexLayoutCsr AllIn;       // unique sources over exec + data edges
+	FCortexLayoutCsr DataIn;      // unique sources over data edges
+	FCortexLayoutCsr Undirected;  // unique neighbours in first-seen order
+	TArray<int32> IncomingCount;  // exec + data in-edges, duplicates included
+
+	int32 Num() const { return Flags.Num(); }
+	bool IsEntryPoint(int32 Index) const { return (Flags[Index] & EntryPoint) != 0; }
+	bool IsExecNode(int32 Index) const { return (Flags[Index] & ExecNode) != 0; }
+	bool IsPhantom(int32 Index) const { return (Flags[Index] & Phantom) != 0; }
+	bool IsPinned(int32 Index) const { return (Flags[Index] & Pinned) != 0; }
+	int32 OutgoingCount(int32 Index) const { return ExecOut.Count(Index) + DataOut.Count(Index); }
+
+	int32 AddNode(int32 InSourceIndex, int32 InIdRank, int32 InWidth, int32 InHeight, uint8 InFlags)
+	{
+		SourceIndex.Add(InSourceIndex);
+		IdRank.Add(InIdRank);
+		Width.Add(InWidth);
+		Height.Add(InHeight);
+		return Flags.Add(InFlags);
+	}
+
+	/** Build every derived edge list from the forward exec/data edges */
+	void Finalize(const TArray<TPair<int32, int32>>& ExecEdges, const TArray<TPair<int32, int32>>& DataEdges)
+	{
+		const int32 NumNodes = Num();
+		ExecOut.Build(NumNodes, ExecEdges, false);
+		DataOut.Build(NumNodes, DataEdges, false);
+
+		TArray<TPair<int32, int32>> AllInPairs;
+		TArray<TPair<int32, int32>> DataInPairs;
+		TArray<TPair<int32, int32>> UndirectedPairs;
+		AllInPairs.Reserve(ExecEdges.Num() + DataEdges.Num());
+		DataInPairs.Reserve(DataEdges.Num());
+		UndirectedPairs.Reserve((ExecEdges.Num() + DataEdges.Num()) * 2);
+		IncomingCount.Init(0, NumNodes);
+
+		for (int32 Node = 0; Node < NumNodes; ++Node)
+		{
+			for (const int32 Target : ExecOut.Row(Node))
+			{
+				AllInPairs.Emplace(Target, Node);
+				UndirectedPairs.Emplace(Node, Target);
+				UndirectedPairs.Emplace(Target, Node);
+				++IncomingCount[Target];
+			}
+			for (const int32 Target : DataOut.Row(Node))
+			{
+				AllInPairs.Emplace(Target, Node);
+				DataInPairs.Emplace(Target, Node);
+				UndirectedPairs.Emplace(Node, Target);
+				UndirectedPairs.Emplace(Target, Node);
+				++IncomingCount[Target];
+			}
+		}
+
+		AllIn.Build(NumNodes, AllInPairs, true);
+		DataIn.Build(NumNodes, DataInPairs, true);
+		Undirected.Build(NumNodes, UndirectedPairs, true);
+	}
+};
+
+struct FCortexGraphLayoutOps::FNodeGroup
+{
+	int32 ExecNode = INDEX_NONE;
+	TArray<int32> DataNodes;      // claim order
+
+	// Inner chain structure, shared by proxy sizing and group expansion
+	TArray<int32> TopoOrder;      // data nodes in inner topological order (cycles appended)
+	TArray<int32> TopoLane;       // lane of each TopoOrder entry
+	int32 LaneCount = 0;
+	int32 ChainCount = 1;
+	int32 LongestChain = 1;
+	int32 MaxDataWidth = 0;
+	int32 MaxDataHeight = 0;
+};
+
 FCortexLayoutResult FCortexGraphLayoutOps::CalculateLayout(
 	const TArray<FCortexLayoutNode>& Nodes,
 	const FCortexLayoutConfig& Config,
@@ -11,72 +247,91 @@ FCortexLayoutResult FCortexGraphLayoutOps::CalculateLayout(
 		return FCortexLayoutResult();
 	}
 
-	// Build lookup map
-	TMap<FString, const FCortexLayoutNode*> NodeMap;
-	for (const FCortexLayoutNode& Node : Nodes)
+	// Boundary: string IDs -> dense indices
+	FIndexedGraph Graph;
+	TArray<FString> Ids;
+	BuildIndexedGraph(Nodes, Graph, Ids);
+
+	if (Config.Mode == ECortexLayoutMode::Incremental)
 	{
-		NodeMap.Add(Node.Id, &Node);
+		return CalculateIncrementalLayout(Graph, Ids, Config, ExistingPositions);
 	}
 
+	return CalculateFullLayout(Graph, Ids, Config);
+}
+
+FCortexLayoutResult FCortexGraphLayoutOps::CalculateFullLayout(
+	const FIndexedGraph& Graph,
+	const TArray<FString>& Ids,
+	const FCortexLayoutConfig& Config)
+{
 	// Pre-pass: discover parameter groups for mixed exec/data graphs
-	TMap<FString, int32> NodeToGroupIndex;
-	TArray<FCortexNodeGroup> Groups = DiscoverGroups(Nodes, NodeMap, NodeToGroupIndex);
+	TArray<FNodeGroup> Groups;
+	TArray<int32> NodeToGroup;
+	DiscoverGroups(Graph, Groups, NodeToGroup);
 
 	// Replace grouped nodes with group proxies for top-level layout
-	TArray<FCortexLayoutNode> EffectiveNodes = BuildGroupProxyNodes(
-		Nodes, Groups, NodeToGroupIndex, NodeMap, Config);
-
-	TMap<FString, const FCortexLayoutNode*> EffectiveNodeMap;
-	for (const FCortexLayoutNode& Node : EffectiveNodes)
-	{
-		EffectiveNodeMap.Add(Node.Id, &Node);
-	}
+	FIndexedGraph ProxyGraph;
+	BuildGroupProxyGraph(Graph, Groups, NodeToGroup, Config, ProxyGraph);
 
 	// Step 1: Find subgraphs
-	TArray<TArray<FString>> Subgraphs = FindSubgraphs(EffectiveNodes);
+	const TArray<TArray<int32>> Subgraphs = FindSubgraphs(ProxyGraph);
+
+	// Step 2: Layout each subgraph independently. Results are keyed by source index.
+	const int32 NumIds = Ids.Num();
+	TArray<FIntPoint> Positions;
+	Positions.Init(FIntPoint::ZeroValue, NumIds);
+	TArray<bool> Positioned;
+	Positioned.Init(false, NumIds);
+	TArray<int32> Layers;
+	Layers.Init(INDEX_NONE, NumIds);
 
-	// Step 2: Layout each subgraph independently
 	FCortexLayoutResult FinalResult;
+	TArray<int32> ScratchParentToLocal;
+	ScratchParentToLocal.Init(INDEX_NONE, ProxyGraph.Num());
 	int32 SubgraphOffsetY = 0;
 
-	for (const TArray<FString>& SubgraphIds : Subgraphs)
+	for (const TArray<int32>& Members : Subgraphs)
 	{
-		// Filter nodes for this subgraph
-		TArray<FCortexLayoutNode> SubNodes;
-		for (const FString& Id : SubgraphIds)
-		{
-			if (const FCortexLayoutNode* const* Found = EffectiveNodeMap.Find(Id))
-			{
-				SubNodes.Add(**Found);
-			}
-		}
+		FIndexedGraph Subgraph;
+		BuildSubgraph(ProxyGraph, Members, ScratchParentToLocal, Subgraph);
 
 		// Assign layers
-		TMap<FString, int32> LayerAssignment = AssignLayers(SubNodes, Config.Direction);
-		for (const auto& LayerPair : LayerAssignment)
+		TArray<int32> SubLayers;
+		AssignLayers(Subgraph, Config.Direction, SubLayers);
+		for (int32 Local = 0; Local < Subgraph.Num(); ++Local)
 		{
-			FinalResult.LayerAssignment.Add(LayerPair.Key, LayerPair.Value);
+			if (SubLayers[Local] != INDEX_NONE)
+			{
+				Layers[Subgraph.SourceIndex[Local]] = SubLayers[Local];
+			}
 		}
 
 		// Order within layers
-		TMap<int32, TArray<FString>> OrderedLayers = OrderNodesInLayers(LayerAssignment, SubNodes);
+		int32 Sweeps = 0;
+		int64 Crossings = 0;
+		const TArray<TArray<int32>> OrderedLayers = OrderNodesInLayers(Subgraph, SubLayers, Sweeps, Crossings);
+		FinalResult.OrderingSweeps += Sweeps;
+		FinalResult.EdgeCrossings += Crossings;
 
 		// Calculate positions
-		FCortexLayoutResult SubResult = CalculatePositions(OrderedLayers, SubNodes, Config);
+		TArray<FIntPoint> SubPositions;
+		CalculatePositions(Subgraph, OrderedLayers, Config, SubPositions);
 
 		// Offset subgraph vertically
 		int32 MaxY = 0;
-		for (auto& Pair : SubResult.Positions)
+		for (const TArray<int32>& LayerNodes : OrderedLayers)
 		{
-			Pair.Value.Y += SubgraphOffsetY;
-			FinalResult.Positions.Add(Pair.Key, Pair.Value);
-
-			// Track max Y for next subgraph offset
-			const FCortexLayoutNode* const* NodePtr = EffectiveNodeMap.Find(Pair.Key);
-			int32 NodeBottom = Pair.Value.Y + (NodePtr ? (*NodePtr)->Height : 100);
-			if (NodeBottom > MaxY)
+			for (const int32 Local : LayerNodes)
 			{
-				MaxY = NodeBottom;
+				const int32 Source = Subgraph.SourceIndex[Local];
+				FIntPoint Position = SubPositions[Local];
+				Position.Y += SubgraphOffsetY;
+				Positions[Source] = Position;
+				Positioned[Source] = true;
+
+				// Track max Y for next subgraph offset
+				MaxY = FMath::Max(MaxY, Position.Y + Subgraph.Height[Local]);
 			}
 		}
 
@@ -85,1174 +340,1265 @@ FCortexLayoutResult FCortexGraphLayoutOps::CalculateLayout(
 	}
 
 	// Expand proxy coordinates back into individual grouped node positions
-	ExpandGroupPositions(Groups, NodeToGroupIndex, NodeMap, Config, FinalResult);
+	ExpandGroupPositions(Graph, Groups, Config, Positions, Positioned);
 
-	TMap<FString, int32> PreRefineExecY;
-	for (const FCortexNodeGroup& Group : Groups)
+	TArray<int32> PreRefineExecY;
+	PreRefineExecY.Init(0, Groups.Num());
+	for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
 	{
-		if (const FIntPoint* GroupPos = FinalResult.Positions.Find(Group.ExecNodeId))
-		{
-			PreRefineExecY.Add(Group.ExecNodeId, GroupPos->Y);
-		}
+		PreRefineExecY[GroupIndex] = Positions[Groups[GroupIndex].ExecNode].Y;
 	}
 
 	// Y-refinement: iterative median centering to reduce wire zigzag
-	RefineYPositions(EffectiveNodes, NodeToGroupIndex, Subgraphs, Config, FinalResult);
+	RefineYPositions(ProxyGraph, Subgraphs, Layers, Config, Positions, Positioned);
 
-	for (const FCortexNodeGroup& Group : Groups)
+	for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
 	{
-		const int32* OriginalY = PreRefineExecY.Find(Group.ExecNodeId);
-		const FIntPoint* NewExecPos = FinalResult.Positions.Find(Group.ExecNodeId);
-		if (!OriginalY || !NewExecPos)
+		const FNodeGroup& Group = Groups[GroupIndex];
+		if (!Positioned[Group.ExecNode])
 		{
 			continue;
 		}
 
-		const int32 DeltaY = NewExecPos->Y - *OriginalY;
+		const int32 DeltaY = Positions[Group.ExecNode].Y - PreRefineExecY[GroupIndex];
 		if (DeltaY == 0)
 		{
 			continue;
 		}
 
-		for (const FString& DataNodeId : Group.DataNodeIds)
+		for (const int32 DataNode : Group.DataNodes)
 		{
-			if (FIntPoint* DataPos = FinalResult.Positions.Find(DataNodeId))
+			if (Positioned[DataNode])
 			{
-				DataPos->Y += DeltaY;
+				Positions[DataNode].Y += DeltaY;
 			}
 		}
 	}
 
-	// Snap all final positions to a stable grid.
-	for (auto& Pair : FinalResult.Positions)
+	// Boundary: dense indices -> string IDs. Snap all final positions to a stable grid.
+	FinalResult.Positions.Reserve(NumIds);
+	FinalResult.LayerAssignment.Reserve(NumIds);
+	for (int32 Index = 0; Index < NumIds; ++Index)
 	{
-		Pair.Value.X = FMath::RoundToInt(
-			Pair.Value.X / static_cast<float>(CortexGraphLayout::GridSnapSize)) * CortexGraphLayout::GridSnapSize;
-		Pair.Value.Y = FMath::RoundToInt(
-			Pair.Value.Y / static_cast<float>(CortexGraphLayout::GridSnapSize)) * CortexGraphLayout::GridSnapSize;
+		if (Positioned[Index])
+		{
+			FinalResult.Positions.Add(Ids[Index], SnapToGrid(Positions[Index]));
+		}
+		if (Layers[Index] != INDEX_NONE)
+		{
+			FinalResult.LayerAssignment.Add(Ids[Index], Layers[Index]);
+		}
 	}
 
-	// Incremental mode: only keep positions for nodes that had default (0,0) position
-	if (Config.Mode == ECortexLayoutMode::Incremental)
+	return FinalResult;
+}
+
+FCortexLayoutResult FCortexGraphLayoutOps::CalculateIncrementalLayout(
+	const FIndexedGraph& Graph,
+	const TArray<FString>& Ids,
+	const FCortexLayoutConfig& Config,
+	const TMap<FString, FIntPoint>& ExistingPositions)
+{
+	// Placed nodes are pinned; everything else (including default (0,0) nodes) is new
+	TArray<bool> Pinned;
+	Pinned.Init(false, Graph.Num());
+	TArray<FIntPoint> Positions;
+	Positions.Init(FIntPoint::ZeroValue, Graph.Num());
+	FLayoutOccupancyGrid Occupancy;
+	FIntRect PinnedBounds(MAX_int32, MAX_int32, MIN_int32, MIN_int32);
+	int32 NewCount = 0;
+
+	for (int32 Node = 0; Node < Graph.Num(); ++Node)
 	{
-		FCortexLayoutResult FilteredResult;
-		for (const auto& Pair : FinalResult.Positions)
+		if (Graph.IsPhantom(Node))
+		{
+			continue;
+		}
+
+		const FIntPoint* Existing = ExistingPositions.Find(Ids[Node]);
+		const bool bPlaced = Existing && (Existing->X != 0 || Existing->Y != 0);
+		if (!bPlaced && !Graph.IsPinned(Node))
+		{
+			++NewCount;
+			continue;
+		}
+
+		Pinned[Node] = true;
+		Positions[Node] = Existing ? *Existing : FIntPoint::ZeroValue;
+		const FIntRect Rect(Positions[Node], Positions[Node] + FIntPoint(Graph.Width[Node], Graph.Height[Node]));
+		Occupancy.Add(Rect);
+		PinnedBounds.Min = PinnedBounds.Min.ComponentMin(Rect.Min);
+		PinnedBounds.Max = PinnedBounds.Max.ComponentMax(Rect.Max);
+	}
+
+	if (NewCount == 0)
+	{
+		return FCortexLayoutResult();
+	}
+	if (Occupancy.Rects.Num() == 0)
+	{
+		// Nothing placed yet: an incremental layout is a full layout
+		return CalculateFullLayout(Graph, Ids, Config);
+	}
+
+	FCortexLayoutResult Result;
+	Result.Positions.Reserve(NewCount);
+	Result.LayerAssignment.Reserve(NewCount);
+
+	TArray<bool> Visited;
+	Visited.Init(false, Graph.Num());
+	TArray<int32> ScratchParentToLocal;
+	ScratchParentToLocal.Init(INDEX_NONE, Graph.Num());
+	TArray<int32> AnchorCentersY;
+	int32 StackY = PinnedBounds.Max.Y + Config.VerticalSpacing * 3;
+
+	// AssignLayers only inverts exec-flow graphs, so only those put upstream nodes on the right
+	const bool bMirrored = Config.Direction == ECortexLayoutDirection::RightToLeft && Graph.ExecOut.Targets.Num() > 0;
+
+	for (int32 Start = 0; Start < Graph.Num(); ++Start)
+	{
+		if (Visited[Start] || Pinned[Start] || Graph.IsPhantom(Start))
+		{
+			continue;
+		}
+
+		// Connected component of new nodes; edges into pinned nodes become anchors
+		TArray<int32> Members;
+		Members.Add(Start);
+		Visited[Start] = true;
+		for (int32 QueueIndex = 0; QueueIndex < Members.Num(); ++QueueIndex)
 		{
-			const FIntPoint* Existing = ExistingPositions.Find(Pair.Key);
-			if (!Existing || (Existing->X == 0 && Existing->Y == 0))
+			for (const int32 Neighbor : Graph.Undirected.Row(Members[QueueIndex]))
 			{
-				FilteredResult.Positions.Add(Pair.Key, Pair.Value);
-				if (const int32* Layer = FinalResult.LayerAssignment.Find(Pair.Key))
+				if (!Visited[Neighbor] && !Pinned[Neighbor] && !Graph.IsPhantom(Neighbor))
 				{
-					FilteredResult.LayerAssignment.Add(Pair.Key, *Layer);
+					Visited[Neighbor] = true;
+					Members.Add(Neighbor);
 				}
 			}
 		}
-		return FilteredResult;
+
+		FIndexedGraph Subgraph;
+		BuildSubgraph(Graph, Members, ScratchParentToLocal, Subgraph);
+
+		TArray<int32> SubLayers;
+		AssignLayers(Subgraph, Config.Direction, SubLayers);
+		int32 Sweeps = 0;
+		int64 Crossings = 0;
+		const TArray<TArray<int32>> OrderedLayers = OrderNodesInLayers(Subgraph, SubLayers, Sweeps, Crossings);
+		Result.OrderingSweeps += Sweeps;
+		Result.EdgeCrossings += Crossings;
+
+		TArray<FIntPoint> LocalPositions;
+		CalculatePositions(Subgraph, OrderedLayers, Config, LocalPositions);
+
+		// Anchor beside placed neighbours: downstream of upstream nodes, else upstream of downstream
+		// ones. Upstream is left, except in mirrored (RightToLeft exec) layouts where it is right.
+		// Each bound is the tightest one: furthest from the placed neighbours it must clear.
+		TOptional<int32> UpstreamX;
+		TOptional<int32> DownstreamX;
+		auto RightOf = [](TOptional<int32>& Bound, int32 X) { Bound = Bound.IsSet() ? FMath::Max(Bound.GetValue(), X) : X; };
+		auto LeftOf = [](TOptional<int32>& Bound, int32 X) { Bound = Bound.IsSet() ? FMath::Min(Bound.GetValue(), X) : X; };
+		FIntPoint LocalMin(MAX_int32, MAX_int32);
+		AnchorCentersY.Reset();
+		for (int32 Local = 0; Local < Members.Num(); ++Local)
+		{
+			const int32 Node = Members[Local];
+			const FIntPoint LocalPos = LocalPositions[Local];
+			const int32 LocalCenterY = LocalPos.Y + Graph.Height[Node] / 2;
+			LocalMin = LocalMin.ComponentMin(LocalPos);
+
+			for (const int32 Source : Graph.AllIn.Row(Node))
+			{
+				if (Pinned[Source])
+				{
+					if (bMirrored)
+					{
+						LeftOf(UpstreamX, Positions[Source].X - Config.HorizontalSpacing - Graph.Width[Node] - LocalPos.X);
+					}
+					else
+					{
+						RightOf(UpstreamX, Positions[Source].X + Graph.Width[Source] + Config.HorizontalSpacing - LocalPos.X);
+					}
+					AnchorCentersY.Add(Positions[Source].Y + Graph.Height[Source] / 2 - LocalCenterY);
+				}
+			}
+			for (const FCortexLayoutCsr* Csr : {&Graph.ExecOut, &Graph.DataOut})
+			{
+				for (const int32 Target : Csr->Row(Node))
+				{
+					if (Pinned[Target])
+					{
+						if (bMirrored)
+						{
+							RightOf(DownstreamX, Positions[Target].X + Graph.Width[Target] + Config.HorizontalSpacing - LocalPos.X);
+						}
+						else
+						{
+							LeftOf(DownstreamX, Positions[Target].X - Config.HorizontalSpacing - Graph.Width[Node] - LocalPos.X);
+						}
+						AnchorCentersY.Add(Positions[Target].Y + Graph.Height[Target] / 2 - LocalCenterY);
+					}
+				}
+			}
+		}
+
+		FIntPoint Offset;
+		if (AnchorCentersY.Num() > 0)
+		{
+			AnchorCentersY.Sort();
+			Offset.X = UpstreamX.IsSet() ? UpstreamX.GetValue() : DownstreamX.GetValue();
+			Offset.Y = AnchorCentersY[AnchorCentersY.Num() / 2];
+		}
+		else
+		{
+			// Unconnected to anything placed: stack below the existing graph
+			Offset = FIntPoint(PinnedBounds.Min.X - LocalMin.X, StackY - LocalMin.Y);
+		}
+		Offset = SnapToGrid(Offset);
+
+		// Greatest bottom edge the component must clear at Offset, MIN_int32 when clear.
+		// OutOverlapping counts member nodes that overlap something.
+		auto FindRequiredOffsetY = [&](const FIntPoint& AtOffset, int32* OutOverlapping)
+		{
+			int32 RequiredOffsetY = MIN_int32;
+			for (int32 Local = 0; Local < Members.Num(); ++Local)
+			{
+				const FIntPoint Placed = LocalPositions[Local] + AtOffset;
+				const FIntRect Rect(Placed, Placed + FIntPoint(Graph.Width[Members[Local]], Graph.Height[Members[Local]]));
+				const int32 Bottom = Occupancy.FindOverlapBottom(Rect, Config.VerticalSpacing / 2);
+				if (Bottom != MIN_int32)
+				{
+					RequiredOffsetY = FMath::Max(RequiredOffsetY, Bottom + Config.VerticalSpacing - LocalPositions[Local].Y);
+					if (OutOverlapping)
+					{
+						++*OutOverlapping;
+					}
+				}
+			}
+			return RequiredOffsetY;
+		};
+
+		// Bounded compaction: push the component down until no node overlaps a placed rect
+		int32 CompactionSteps = 0;
+		for (; CompactionSteps < CortexGraphLayout::MaxCompactionSteps; ++CompactionSteps)
+		{
+			const int32 RequiredOffsetY = FindRequiredOffsetY(Offset, nullptr);
+			if (RequiredOffsetY == MIN_int32)
+			{
+				break;
+			}
+
+			Offset.Y = FMath::CeilToInt(RequiredOffsetY / static_cast<float>(CortexGraphLayout::GridSnapSize)) * CortexGraphLayout::GridSnapSize;
+		}
+
+		bool bBelowGraph = AnchorCentersY.Num() == 0;
+		if (CompactionSteps == CortexGraphLayout::MaxCompactionSteps && FindRequiredOffsetY(Offset, nullptr) != MIN_int32)
+		{
+			// Compaction gave up: keep the anchored column but drop below everything placed so far,
+			// which no existing rect can overlap
+			Offset.Y = Occupancy.MaxY + Config.VerticalSpacing * 3 - LocalMin.Y;
+			Offset = SnapToGrid(Offset);
+			bBelowGraph = true;
+			++Result.CompactionFallbacks;
+
+			int32 Overlapping = 0;
+			FindRequiredOffsetY(Offset, &Overlapping);
+			Result.OverlappingNodes += Overlapping;
+			UE_LOG(LogCortexGraph, Verbose, TEXT("[IncrementalLayout] Compaction limit reached for component of %d nodes; placed below the graph"),
+				Members.Num());
+		}
+
+		for (int32 Local = 0; Local < Members.Num(); ++Local)
+		{
+			const int32 Node = Members[Local];
+			const FIntPoint Placed = SnapToGrid(LocalPositions[Local] + Offset);
+			Occupancy.Add(FIntRect(Placed, Placed + FIntPoint(Graph.Width[Node], Graph.Height[Node])));
+			Result.Positions.Add(Ids[Node], Placed);
+			if (SubLayers[Local] != INDEX_NONE)
+			{
+				Result.LayerAssignment.Add(Ids[Node], SubLayers[Local]);
+			}
+
+			if (bBelowGraph)
+			{
+				StackY = FMath::Max(StackY, Placed.Y + Graph.Height[Node] + Config.VerticalSpacing * 3);
+			}
+		}
 	}
 
-	return FinalResult;
+	return Result;
 }
 
-TMap<FString, int32> FCortexGraphLayoutOps::AssignLayers(
+void FCortexGraphLayoutOps::BuildIndexedGraph(
 	const TArray<FCortexLayoutNode>& Nodes,
-	ECortexLayoutDirection Direction)
+	FIndexedGraph& OutGraph,
+	TArray<FString>& OutIds)
 {
-	TMap<FString, int32> LayerAssignment;
-	TMap<FString, const FCortexLayoutNode*> NodeMap;
+	OutIds.Reset(Nodes.Num());
+	TMap<FString, int32> IdToIndex;
+	IdToIndex.Reserve(Nodes.Num());
+
 	for (const FCortexLayoutNode& Node : Nodes)
 	{
-		NodeMap.Add(Node.Id, &Node);
+		const int32 Index = OutIds.Add(Node.Id);
+		IdToIndex.FindOrAdd(Node.Id, Index);
+
+		uint8 Flags = 0;
+		Flags |= Node.bIsEntryPoint ? FIndexedGraph::EntryPoint : 0;
+		Flags |= Node.bIsExecNode ? FIndexedGraph::ExecNode : 0;
+		Flags |= Node.bIsPinned ? FIndexedGraph::Pinned : 0;
+		OutGraph.AddNode(Index, 0, Node.Width, Node.Height, Flags);
 	}
 
-	// Build reverse adjacency: for each node, who connects TO it
-	TMap<FString, TArray<FString>> IncomingExec;
-	TMap<FString, TArray<FString>> IncomingData;
-	for (const FCortexLayoutNode& Node : Nodes)
+	auto ResolveTarget = [&OutGraph, &OutIds, &IdToIndex](const FString& TargetId) -> int32
 	{
-		for (const FString& TargetId : Node.ExecOutputs)
+		if (const int32* Found = IdToIndex.Find(TargetId))
 		{
-			IncomingExec.FindOrAdd(TargetId).AddUnique(Node.Id);
+			return *Found;
 		}
-		for (const FString& TargetId : Node.DataOutputs)
+
+		const int32 Index = OutIds.Add(TargetId);
+		IdToIndex.Add(TargetId, Index);
+		OutGraph.AddNode(Index, 0, DefaultLayoutNodeWidth, DefaultLayoutNodeHeight, FIndexedGraph::Phantom);
+		return Index;
+	};
+
+	TArray<TPair<int32, int32>> ExecEdges;
+	TArray<TPair<int32, int32>> DataEdges;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		for (const FString& TargetId : Nodes[Index].ExecOutputs)
 		{
-			IncomingData.FindOrAdd(TargetId).AddUnique(Node.Id);
+			ExecEdges.Emplace(Index, ResolveTarget(TargetId));
 		}
+		for (const FString& TargetId : Nodes[Index].DataOutputs)
+		{
+			DataEdges.Emplace(Index, ResolveTarget(TargetId));
+		}
+	}
+
+	// Rank ids once so every later tie-break is an integer compare.
+	// Equal ids (FString compares case-insensitively) share a rank.
+	TArray<int32> SortedIndices;
+	SortedIndices.SetNumUninitialized(OutIds.Num());
+	for (int32 Index = 0; Index < OutIds.Num(); ++Index)
+	{
+		SortedIndices[Index] = Index;
+	}
+	SortedIndices.Sort([&OutIds](int32 A, int32 B)
+	{
+		return OutIds[A] < OutIds[B];
+	});
+	for (int32 Position = 0; Position < SortedIndices.Num(); ++Position)
+	{
+		const bool bSameAsPrevious = Position > 0 &&
+			!(OutIds[SortedIndices[Position - 1]] < OutIds[SortedIndices[Position]]);
+		OutGraph.IdRank[SortedIndices[Position]] = bSameAsPrevious
+			? OutGraph.IdRank[SortedIndices[Position - 1]]
+			: Position;
 	}
 
+	OutGraph.Finalize(ExecEdges, DataEdges);
+}
+
+void FCortexGraphLayoutOps::AssignLayers(
+	const FIndexedGraph& Graph,
+	ECortexLayoutDirection Direction,
+	TArray<int32>& OutLayers)
+{
+	const int32 NumNodes = Graph.Num();
+	OutLayers.Init(INDEX_NONE, NumNodes);
+
+	// Raise a target to at least NewLayer (unassigned counts as layer 0)
+	auto PushLayer = [&OutLayers](int32 Target, int32 NewLayer)
+	{
+		OutLayers[Target] = FMath::Max(OutLayers[Target] == INDEX_NONE ? 0 : OutLayers[Target], NewLayer);
+	};
+
 	// --- Topological sort + forward longest-path pass ---
 	// Compute in-degrees for exec edges
-	TMap<FString, int32> InDegree;
-	for (const FCortexLayoutNode& Node : Nodes)
+	TArray<int32> InDegree;
+	InDegree.Init(0, NumNodes);
+	TArray<bool> HasIncomingExec;
+	HasIncomingExec.Init(false, NumNodes);
+	const int32 TotalExecEdges = Graph.ExecOut.Targets.Num();
+	for (const int32 Target : Graph.ExecOut.Targets)
 	{
-		InDegree.FindOrAdd(Node.Id); // Ensure all nodes present
-		for (const FString& TargetId : Node.ExecOutputs)
-		{
-			InDegree.FindOrAdd(TargetId)++;
-		}
+		++InDegree[Target];
+		HasIncomingExec[Target] = true;
 	}
 
+	auto HasExecEdge = [&Graph, &HasIncomingExec](int32 Node)
+	{
+		return Graph.ExecOut.Count(Node) > 0 || HasIncomingExec[Node];
+	};
+
 	// Initialize — entry points and zero in-degree exec-connected nodes
-	TArray<FString> TopoQueue;
-	for (const FCortexLayoutNode& Node : Nodes)
+	TArray<int32> TopoQueue;
+	TopoQueue.Reserve(NumNodes);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
 	{
-		bool bHasExecEdge = (Node.ExecOutputs.Num() > 0) || IncomingExec.Contains(Node.Id);
-		if (Node.bIsEntryPoint || (bHasExecEdge && InDegree.FindRef(Node.Id) == 0))
+		if (Graph.IsPhantom(Node))
+		{
+			continue;
+		}
+		if (Graph.IsEntryPoint(Node) || (HasExecEdge(Node) && InDegree[Node] == 0))
 		{
-			TopoQueue.Add(Node.Id);
-			LayerAssignment.Add(Node.Id, 0);
+			TopoQueue.Add(Node);
+			OutLayers[Node] = 0;
 		}
 	}
 
 	// Fallback: if no roots found (all cycles), pick first exec-connected node
 	if (TopoQueue.Num() == 0)
 	{
-		for (const FCortexLayoutNode& Node : Nodes)
+		for (int32 Node = 0; Node < NumNodes; ++Node)
 		{
-			if (Node.ExecOutputs.Num() > 0 || IncomingExec.Contains(Node.Id))
+			if (!Graph.IsPhantom(Node) && HasExecEdge(Node))
 			{
-				TopoQueue.Add(Node.Id);
-				LayerAssignment.Add(Node.Id, 0);
+				TopoQueue.Add(Node);
+				OutLayers[Node] = 0;
 				break;
 			}
 		}
 	}
 
 	// Kahn's algorithm — process nodes in topological order
-	int32 QueueIndex = 0;
-	while (QueueIndex < TopoQueue.Num())
+	for (int32 QueueIndex = 0; QueueIndex < TopoQueue.Num(); ++QueueIndex)
 	{
-		FString CurrentId = TopoQueue[QueueIndex++];
-		int32 CurrentLayer = LayerAssignment.FindRef(CurrentId);
-		const FCortexLayoutNode* const* CurrentPtr = NodeMap.Find(CurrentId);
-		if (!CurrentPtr)
-		{
-			continue;
-		}
-
-		for (const FString& TargetId : (*CurrentPtr)->ExecOutputs)
+		const int32 Current = TopoQueue[QueueIndex];
+		const int32 CurrentLayer = FMath::Max(OutLayers[Current], 0);
+		for (const int32 Target : Graph.ExecOut.Row(Current))
 		{
 			// Propagate longest path
-			int32 NewLayer = CurrentLayer + 1;
-			int32& TargetLayer = LayerAssignment.FindOrAdd(TargetId);
-			if (NewLayer > TargetLayer)
-			{
-				TargetLayer = NewLayer;
-			}
+			PushLayer(Target, CurrentLayer + 1);
 
 			// Decrement in-degree; enqueue when all predecessors processed
-			int32& Deg = InDegree.FindOrAdd(TargetId);
-			Deg--;
-			if (Deg == 0)
+			if (--InDegree[Target] == 0)
 			{
-				TopoQueue.Add(TargetId);
+				TopoQueue.Add(Target);
 			}
 		}
 	}
 
 	// --- Data-flow fallback for pure data-flow graphs (e.g., Materials) ---
-	int32 ExecAssignedCount = LayerAssignment.Num();
+	int32 ExecAssignedCount = 0;
+	for (const int32 Layer : OutLayers)
+	{
+		ExecAssignedCount += (Layer != INDEX_NONE) ? 1 : 0;
+	}
+
 	bool bHasUnassignedDataNodes = false;
-	for (const FCortexLayoutNode& Node : Nodes)
+	for (int32 Node = 0; Node < NumNodes; ++Node)
 	{
-		if (!LayerAssignment.Contains(Node.Id) && Node.DataOutputs.Num() > 0)
+		if (!Graph.IsPhantom(Node) && OutLayers[Node] == INDEX_NONE && Graph.DataOut.Count(Node) > 0)
 		{
 			bHasUnassignedDataNodes = true;
 			break;
 		}
 	}
 
-	if (bHasUnassignedDataNodes || ExecAssignedCount <= 1)
+	// Pure data-flow graph: run Kahn's on data edges
+	if ((bHasUnassignedDataNodes || ExecAssignedCount <= 1) && TotalExecEdges == 0)
 	{
-		// Count total exec edges — if zero, this is a pure data-flow graph
-		int32 TotalExecEdges = 0;
-		for (const FCortexLayoutNode& Node : Nodes)
+		TArray<int32> DataInDegree;
+		DataInDegree.Init(0, NumNodes);
+		for (const int32 Target : Graph.DataOut.Targets)
 		{
-			TotalExecEdges += Node.ExecOutputs.Num();
+			++DataInDegree[Target];
 		}
 
-		if (TotalExecEdges == 0)
+		// Capture sources before Kahn's modifies DataInDegree in-place.
+		// Needed for source pushback after the main pass.
+		TArray<int32> OriginalSources;
+		TArray<int32> DataQueue;
+		DataQueue.Reserve(NumNodes);
+		for (int32 Node = 0; Node < NumNodes; ++Node)
 		{
-			// Pure data-flow graph: run Kahn's on DataOutputs
-			TMap<FString, int32> DataInDegree;
-			for (const FCortexLayoutNode& Node : Nodes)
+			if (Graph.IsPhantom(Node) || DataInDegree[Node] != 0)
 			{
-				DataInDegree.FindOrAdd(Node.Id);
-				for (const FString& TargetId : Node.DataOutputs)
-				{
-					DataInDegree.FindOrAdd(TargetId)++;
-				}
+				continue;
 			}
-
-			// Capture sources before Kahn's modifies DataInDegree in-place.
-			// Needed for source pushback after the main pass.
-			TArray<FString> OriginalSources;
-			for (const FCortexLayoutNode& Node : Nodes)
+			if (Graph.DataOut.Count(Node) > 0)
 			{
-				if (DataInDegree.FindRef(Node.Id) == 0 && Node.DataOutputs.Num() > 0)
-				{
-					OriginalSources.Add(Node.Id);
-				}
+				OriginalSources.Add(Node);
 			}
+			DataQueue.Add(Node);
+			OutLayers[Node] = 0;
+		}
 
-			TArray<FString> DataQueue;
-			for (const FCortexLayoutNode& Node : Nodes)
+		for (int32 QueueIndex = 0; QueueIndex < DataQueue.Num(); ++QueueIndex)
+		{
+			const int32 Current = DataQueue[QueueIndex];
+			const int32 CurrentLayer = FMath::Max(OutLayers[Current], 0);
+			for (const int32 Target : Graph.DataOut.Row(Current))
 			{
-				if (DataInDegree.FindRef(Node.Id) == 0)
+				PushLayer(Target, CurrentLayer + 1);
+				if (--DataInDegree[Target] == 0)
 				{
-					DataQueue.Add(Node.Id);
-					LayerAssignment.FindOrAdd(Node.Id) = 0;
+					DataQueue.Add(Target);
 				}
 			}
+		}
 
-			int32 DataQueueIdx = 0;
-			while (DataQueueIdx < DataQueue.Num())
+		// Source pushback: move source nodes closer to their consumers.
+		// Kahn's pins all sources at layer 0 regardless of how deep their consumers are,
+		// causing them to pile up in one tall column. Instead, place each source at
+		// MinConsumerLayer-1 (just before its earliest consumer in the chain).
+		for (const int32 Source : OriginalSources)
+		{
+			int32 MinConsumerLayer = MAX_int32;
+			for (const int32 Target : Graph.DataOut.Row(Source))
 			{
-				FString CurId = DataQueue[DataQueueIdx++];
-				int32 CurLayer = LayerAssignment.FindRef(CurId);
-				const FCortexLayoutNode* const* CurPtr = NodeMap.Find(CurId);
-				if (!CurPtr)
+				if (OutLayers[Target] != INDEX_NONE)
 				{
-					continue;
-				}
-
-				for (const FString& TgtId : (*CurPtr)->DataOutputs)
-				{
-					int32 NewLayer = CurLayer + 1;
-					int32& TgtLayer = LayerAssignment.FindOrAdd(TgtId);
-					if (NewLayer > TgtLayer)
-					{
-						TgtLayer = NewLayer;
-					}
-
-					int32& DDeg = DataInDegree.FindOrAdd(TgtId);
-					DDeg--;
-					if (DDeg == 0)
-					{
-						DataQueue.Add(TgtId);
-					}
+					MinConsumerLayer = FMath::Min(MinConsumerLayer, OutLayers[Target]);
 				}
 			}
 
-			// Source pushback: move source nodes closer to their consumers.
-			// Kahn's pins all sources at layer 0 regardless of how deep their consumers are,
-			// causing them to pile up in one tall column. Instead, place each source at
-			// MinConsumerLayer-1 (just before its earliest consumer in the chain).
-			for (const FString& SourceId : OriginalSources)
+			if (MinConsumerLayer != MAX_int32 && MinConsumerLayer > 1)
 			{
-				const FCortexLayoutNode* const* NodePtr = NodeMap.Find(SourceId);
-				if (!NodePtr) continue;
-
-				int32 MinConsumerLayer = INT_MAX;
-				for (const FString& TargetId : (*NodePtr)->DataOutputs)
-				{
-					const int32* TargetLayer = LayerAssignment.Find(TargetId);
-					if (TargetLayer && *TargetLayer < MinConsumerLayer)
-					{
-						MinConsumerLayer = *TargetLayer;
-					}
-				}
-
-				if (MinConsumerLayer > 1)
-				{
-					LayerAssignment[SourceId] = MinConsumerLayer - 1;
-				}
+				OutLayers[Source] = MinConsumerLayer - 1;
 			}
 		}
 	}
 
 	// Handle exec-connected nodes still not assigned (cycles)
-	for (const FCortexLayoutNode& Node : Nodes)
+	for (int32 Node = 0; Node < NumNodes; ++Node)
 	{
-		if (!LayerAssignment.Contains(Node.Id))
+		if (!Graph.IsPhantom(Node) && OutLayers[Node] == INDEX_NONE && HasExecEdge(Node))
 		{
-			bool bHasExecEdge = (Node.ExecOutputs.Num() > 0) || IncomingExec.Contains(Node.Id);
-			if (bHasExecEdge)
-			{
-				LayerAssignment.Add(Node.Id, 0);
-			}
+			OutLayers[Node] = 0;
 		}
 	}
 
 	// Place data-only nodes: in the column before their rightmost consumer (MaxConsumerLayer)
-	for (const FCortexLayoutNode& Node : Nodes)
+	for (int32 Node = 0; Node < NumNodes; ++Node)
 	{
-		if (LayerAssignment.Contains(Node.Id))
+		if (Graph.IsPhantom(Node) || OutLayers[Node] != INDEX_NONE)
 		{
 			continue;
 		}
 
 		int32 MaxConsumerLayer = -1;
-		for (const FString& TargetId : Node.DataOutputs)
+		for (const int32 Target : Graph.DataOut.Row(Node))
 		{
-			const int32* TargetLayer = LayerAssignment.Find(TargetId);
-			if (TargetLayer && *TargetLayer > MaxConsumerLayer)
-			{
-				MaxConsumerLayer = *TargetLayer;
-			}
+			MaxConsumerLayer = FMath::Max(MaxConsumerLayer, OutLayers[Target]);
 		}
 
-		if (MaxConsumerLayer >= 0)
-		{
-			LayerAssignment.Add(Node.Id, FMath::Max(0, MaxConsumerLayer - 1));
-		}
-		else
-		{
-			LayerAssignment.Add(Node.Id, 0);
-		}
+		OutLayers[Node] = FMath::Max(0, MaxConsumerLayer - 1);
 	}
 
 	// For RightToLeft direction, invert layers so entry points move rightmost.
 	// Only apply to exec-flow graphs — pure data-flow Kahn's already produces
 	// sources-left / sinks-right ordering naturally.
-	if (Direction == ECortexLayoutDirection::RightToLeft)
+	if (Direction == ECortexLayoutDirection::RightToLeft && TotalExecEdges > 0)
 	{
-		int32 TotalExecEdgesForInversion = 0;
-		for (const FCortexLayoutNode& Node : Nodes)
+		int32 MaxLayer = 0;
+		for (const int32 Layer : OutLayers)
 		{
-			TotalExecEdgesForInversion += Node.ExecOutputs.Num();
+			MaxLayer = FMath::Max(MaxLayer, Layer);
 		}
-
-		if (TotalExecEdgesForInversion > 0)
+		for (int32& Layer : OutLayers)
 		{
-			int32 MaxLayer = 0;
-			for (const auto& Pair : LayerAssignment)
-			{
-				if (Pair.Value > MaxLayer)
-				{
-					MaxLayer = Pair.Value;
-				}
-			}
-			for (auto& Pair : LayerAssignment)
+			if (Layer != INDEX_NONE)
 			{
-				Pair.Value = MaxLayer - Pair.Value;
+				Layer = MaxLayer - Layer;
 			}
 		}
 	}
-
-	return LayerAssignment;
 }
 
-TMap<int32, TArray<FString>> FCortexGraphLayoutOps::OrderNodesInLayers(
-	const TMap<FString, int32>& LayerAssignment,
-	const TArray<FCortexLayoutNode>& Nodes)
+TArray<TArray<int32>> FCortexGraphLayoutOps::OrderNodesInLayers(
+	const FIndexedGraph& Graph,
+	const TArray<int32>& Layers,
+	int32& OutSweeps,
+	int64& OutCrossings)
 {
-	// Group nodes by layer
-	TMap<int32, TArray<FString>> Layers;
-	for (const auto& Pair : LayerAssignment)
-	{
-		Layers.FindOrAdd(Pair.Value).Add(Pair.Key);
-	}
+	OutSweeps = 0;
+	OutCrossings = 0;
 
-	// Build adjacency for barycenter calculation
-	TMap<FString, TArray<FString>> AllConnections;
-	for (const FCortexLayoutNode& Node : Nodes)
+	// Group nodes by layer
+	int32 MaxLayer = INDEX_NONE;
+	for (const int32 Layer : Layers)
 	{
-		TArray<FString>& Conns = AllConnections.FindOrAdd(Node.Id);
-		Conns.Append(Node.ExecOutputs);
-		Conns.Append(Node.DataOutputs);
+		MaxLayer = FMath::Max(MaxLayer, Layer);
 	}
 
-	// Also build reverse connections
-	TMap<FString, TArray<FString>> ReverseConnections;
-	for (const FCortexLayoutNode& Node : Nodes)
+	TArray<TArray<int32>> OrderedLayers;
+	OrderedLayers.SetNum(MaxLayer + 1);
+	for (int32 Node = 0; Node < Graph.Num(); ++Node)
 	{
-		for (const FString& TargetId : Node.ExecOutputs)
-		{
-			ReverseConnections.FindOrAdd(TargetId).AddUnique(Node.Id);
-		}
-		for (const FString& TargetId : Node.DataOutputs)
+		if (Layers[Node] != INDEX_NONE)
 		{
-			ReverseConnections.FindOrAdd(TargetId).AddUnique(Node.Id);
+			OrderedLayers[Layers[Node]].Add(Node);
 		}
 	}
 
-	// Pre-build entry point lookup
-	TMap<FString, bool> EntryPointMap;
-	for (const FCortexLayoutNode& N : Nodes)
+	// Track Y-order indices for barycenter. Entry points first, then by id.
+	TArray<float> YOrder;
+	YOrder.Init(0.0f, Graph.Num());
+	for (TArray<int32>& LayerNodes : OrderedLayers)
 	{
-		EntryPointMap.Add(N.Id, N.bIsEntryPoint);
-	}
-
-	// Track Y-order indices for barycenter
-	TMap<FString, float> NodeYOrder;
-	for (auto& LayerPair : Layers)
-	{
-		TArray<FString>& LayerNodes = LayerPair.Value;
-		LayerNodes.Sort([&EntryPointMap](const FString& A, const FString& B)
+		LayerNodes.Sort([&Graph](int32 A, int32 B)
 		{
-			bool AEntry = EntryPointMap.FindRef(A);
-			bool BEntry = EntryPointMap.FindRef(B);
+			const bool AEntry = Graph.IsEntryPoint(A);
+			const bool BEntry = Graph.IsEntryPoint(B);
 			if (AEntry != BEntry)
 			{
 				return AEntry;
 			}
-			return A < B;
+			return Graph.IdRank[A] < Graph.IdRank[B];
 		});
 
 		for (int32 i = 0; i < LayerNodes.Num(); ++i)
 		{
-			NodeYOrder.Add(LayerNodes[i], static_cast<float>(i));
+			YOrder[LayerNodes[i]] = static_cast<float>(i);
 		}
 	}
 
-	// Barycenter iterations (4 passes: forward/backward alternating)
-	for (int32 Pass = 0; Pass < 4; ++Pass)
+	auto AccumulateOrder = [&Layers, &YOrder](TConstArrayView<int32> Connected, float& Sum, int32& Count)
 	{
-		TArray<int32> LayerKeys;
-		Layers.GetKeys(LayerKeys);
-		LayerKeys.Sort();
-
-		bool bForward = (Pass % 2 == 0);
-		if (!bForward)
-		{
-			Algo::Reverse(LayerKeys);
-		}
-
-		for (int32 LayerIdx : LayerKeys)
+		for (const int32 Other : Connected)
 		{
-			TArray<FString>& LayerNodes = Layers[LayerIdx];
-
-			for (const FString& NodeId : LayerNodes)
+			if (Layers[Other] != INDEX_NONE)
 			{
-				float Sum = 0.0f;
-				int32 Count = 0;
-
-				const TArray<FString>* RevConns = ReverseConnections.Find(NodeId);
-				if (RevConns)
-				{
-					for (const FString& ConnId : *RevConns)
-					{
-						const float* Order = NodeYOrder.Find(ConnId);
-						if (Order)
-						{
-							Sum += *Order;
-							++Count;
-						}
-					}
-				}
-
-				const TArray<FString>* FwdConns = AllConnections.Find(NodeId);
-				if (FwdConns)
-				{
-					for (const FString& ConnId : *FwdConns)
-					{
-						const float* Order = NodeYOrder.Find(ConnId);
-						if (Order)
-						{
-							Sum += *Order;
-							++Count;
-						}
-					}
-				}
-
-				if (Count > 0)
-				{
-					NodeYOrder[NodeId] = Sum / static_cast<float>(Count);
-				}
-			}
-
-			LayerNodes.Sort([&NodeYOrder](const FString& A, const FString& B)
-			{
-				return NodeYOrder.FindRef(A) < NodeYOrder.FindRef(B);
-			});
-
-			for (int32 i = 0; i < LayerNodes.Num(); ++i)
-			{
-				NodeYOrder[LayerNodes[i]] = static_cast<float>(i);
+				Sum += YOrder[Other];
+				++Count;
 			}
 		}
-	}
-
-	return Layers;
-}
-
-FCortexLayoutResult FCortexGraphLayoutOps::CalculatePositions(
-	const TMap<int32, TArray<FString>>& OrderedLayers,
-	const TArray<FCortexLayoutNode>& Nodes,
-	const FCortexLayoutConfig& Config)
-{
-	TMap<FString, const FCortexLayoutNode*> NodeMap;
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		NodeMap.Add(Node.Id, &Node);
-	}
+	};
 
-	FCortexLayoutResult Result;
-
-	TArray<int32> LayerKeys;
-	OrderedLayers.GetKeys(LayerKeys);
-	LayerKeys.Sort();
-
-	int32 CurrentX = 0;
-	TMap<int32, int32> LayerX;
-	TMap<int32, int32> LayerMaxWidth;
-
-	for (int32 LayerIdx : LayerKeys)
+	auto SweepLayer = [&Graph, &YOrder, &AccumulateOrder](TArray<int32>& LayerNodes)
 	{
-		int32 MaxWidth = 0;
-		const TArray<FString>& LayerNodes = OrderedLayers[LayerIdx];
-		for (const FString& NodeId : LayerNodes)
+		for (const int32 Node : LayerNodes)
 		{
-			const FCortexLayoutNode* const* NodePtr = NodeMap.Find(NodeId);
-			int32 W = NodePtr ? (*NodePtr)->Width : 150;
-			if (W > MaxWidth)
-			{
-				MaxWidth = W;
-			}
-		}
-
-		LayerX.Add(LayerIdx, CurrentX);
-		LayerMaxWidth.Add(LayerIdx, MaxWidth);
-		CurrentX += MaxWidth + Config.HorizontalSpacing;
-	}
+			float Sum = 0.0f;
+			int32 Count = 0;
+			AccumulateOrder(Graph.AllIn.Row(Node), Sum, Count);
+			AccumulateOrder(Graph.ExecOut.Row(Node), Sum, Count);
+			AccumulateOrder(Graph.DataOut.Row(Node), Sum, Count);
 
-	for (int32 LayerIdx : LayerKeys)
-	{
-		const TArray<FString>& LayerNodes = OrderedLayers[LayerIdx];
-		int32 X = LayerX[LayerIdx];
-
-		int32 TotalHeight = 0;
-		for (int32 i = 0; i < LayerNodes.Num(); ++i)
-		{
-			const FCortexLayoutNode* const* NodePtr = NodeMap.Find(LayerNodes[i]);
-			int32 H = NodePtr ? (*NodePtr)->Height : 100;
-			TotalHeight += H;
-			if (i < LayerNodes.Num() - 1)
+			if (Count > 0)
 			{
-				TotalHeight += Config.VerticalSpacing;
+				YOrder[Node] = Sum / static_cast<float>(Count);
 			}
 		}
 
-		int32 StartY = -TotalHeight / 2;
-		int32 CurrentY = StartY;
-
-		for (const FString& NodeId : LayerNodes)
-		{
-			const FCortexLayoutNode* const* NodePtr = NodeMap.Find(NodeId);
-			int32 H = NodePtr ? (*NodePtr)->Height : 100;
-
-			Result.Positions.Add(NodeId, FIntPoint(X, CurrentY));
-			CurrentY += H + Config.VerticalSpacing;
-		}
-	}
-
-	return Result;
-}
-
-TArray<TArray<FString>> FCortexGraphLayoutOps::FindSubgraphs(const TArray<FCortexLayoutNode>& Nodes)
-{
-	TMap<FString, TSet<FString>> Adjacency;
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		TSet<FString>& Adj = Adjacency.FindOrAdd(Node.Id);
-		for (const FString& TargetId : Node.ExecOutputs)
+		LayerNodes.Sort([&YOrder](int32 A, int32 B)
 		{
-			Adj.Add(TargetId);
-			Adjacency.FindOrAdd(TargetId).Add(Node.Id);
-		}
-		for (const FString& TargetId : Node.DataOutputs)
-		{
-			Adj.Add(TargetId);
-			Adjacency.FindOrAdd(TargetId).Add(Node.Id);
-		}
-	}
-
-	TArray<TArray<FString>> Subgraphs;
-	TSet<FString> GlobalVisited;
+			return YOrder[A] < YOrder[B];
+		});
 
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		if (GlobalVisited.Contains(Node.Id))
+		for (int32 i = 0; i < LayerNodes.Num(); ++i)
 		{
-			continue;
+			YOrder[LayerNodes[i]] = static_cast<float>(i);
 		}
+	};
 
-		TArray<FString> Component;
-		TArray<FString> Queue;
-		Queue.Add(Node.Id);
-		GlobalVisited.Add(Node.Id);
+	// Barycenter sweeps alternate forward/backward. Keep the best ordering seen
+	// (ties favour the later sweep) and stop once crossings stop improving.
+	int64 BestCrossings = CountCrossings(Graph, OrderedLayers, Layers);
+	TArray<TArray<int32>> BestLayers = OrderedLayers;
+	int32 SweepsWithoutImprovement = 0;
 
-		int32 QueueIndex = 0;
-		while (QueueIndex < Queue.Num())
+	for (int32 Sweep = 0; Sweep < CortexGraphLayout::MaxOrderingSweeps; ++Sweep)
+	{
+		const bool bForward = (Sweep % 2 == 0);
+		for (int32 Step = 0; Step < OrderedLayers.Num(); ++Step)
 		{
-			FString CurrentId = Queue[QueueIndex++];
-			Component.Add(CurrentId);
-
-			const TSet<FString>* Neighbors = Adjacency.Find(CurrentId);
-			if (Neighbors)
+			const int32 LayerIdx = bForward ? Step : OrderedLayers.Num() - 1 - Step;
+			if (OrderedLayers[LayerIdx].Num() > 0)
 			{
-				for (const FString& NeighborId : *Neighbors)
-				{
-					if (!GlobalVisited.Contains(NeighborId))
-					{
-						GlobalVisited.Add(NeighborId);
-						Queue.Add(NeighborId);
-					}
-				}
+				SweepLayer(OrderedLayers[LayerIdx]);
 			}
 		}
+		++OutSweeps;
 
-		Subgraphs.Add(MoveTemp(Component));
-	}
-
-	return Subgraphs;
-}
-
-TArray<FCortexGraphLayoutOps::FCortexNodeGroup> FCortexGraphLayoutOps::DiscoverGroups(
-	const TArray<FCortexLayoutNode>& Nodes,
-	const TMap<FString, const FCortexLayoutNode*>& NodeMap,
-	TMap<FString, int32>& OutNodeToGroupIndex)
-{
-	TArray<FCortexNodeGroup> Groups;
-	OutNodeToGroupIndex.Empty();
-
-	// Build reverse data adjacency: for each DataOutput A->B, record B->A
-	TMap<FString, TArray<FString>> ReverseDataAdj;
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		for (const FString& TargetId : Node.DataOutputs)
+		const int64 Crossings = CountCrossings(Graph, OrderedLayers, Layers);
+		if (Crossings < BestCrossings)
 		{
-			ReverseDataAdj.FindOrAdd(TargetId).AddUnique(Node.Id);
+			BestCrossings = Crossings;
+			SweepsWithoutImprovement = 0;
+		}
+		else
+		{
+			++SweepsWithoutImprovement;
 		}
-	}
 
-	// Debug: log all nodes with their properties
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		UE_LOG(LogCortexGraph, Verbose, TEXT("[DiscoverGroups] Node=%s IsExec=%d DataOutputs=%d"),
-			*Node.Id, (int32)Node.bIsExecNode, Node.DataOutputs.Num());
-		for (const FString& DataOut : Node.DataOutputs)
+		if (Crossings <= BestCrossings)
 		{
-			UE_LOG(LogCortexGraph, Verbose, TEXT("  -> DataOutput: %s"), *DataOut);
+			BestLayers = OrderedLayers;
 		}
-	}
 
-	// Skip grouping when there are no exec nodes.
-	bool bHasAnyExecNode = false;
-	for (const FCortexLayoutNode& Node : Nodes)
-	{
-		if (Node.bIsExecNode)
+		if (OutSweeps >= CortexGraphLayout::MinOrderingSweeps &&
+			(BestCrossings == 0 || SweepsWithoutImprovement >= OrderingStallLimit))
 		{
-			bHasAnyExecNode = true;
 			break;
 		}
 	}
 
-	UE_LOG(LogCortexGraph, Log, TEXT("[DiscoverGroups] %d nodes, bHasAnyExecNode=%d, ReverseDataAdj entries=%d"),
-		Nodes.Num(), (int32)bHasAnyExecNode, ReverseDataAdj.Num());
+	OutCrossings = BestCrossings;
+	return BestLayers;
+}
 
-	if (!bHasAnyExecNode)
+int64 FCortexGraphLayoutOps::CountCrossings(
+	const FIndexedGraph& Graph,
+	const TArray<TArray<int32>>& OrderedLayers,
+	const TArray<int32>& Layers)
+{
+	TArray<int32> PositionInLayer;
+	PositionInLayer.Init(INDEX_NONE, Graph.Num());
+	for (const TArray<int32>& LayerNodes : OrderedLayers)
 	{
-		return Groups;
+		for (int32 i = 0; i < LayerNodes.Num(); ++i)
+		{
+			PositionInLayer[LayerNodes[i]] = i;
+		}
 	}
 
-	// Exec nodes claim pure-data ancestors in deterministic input order.
-	TSet<FString> Claimed;
-	for (const FCortexLayoutNode& Node : Nodes)
+	int64 Total = 0;
+	TArray<TPair<int32, int32>> Edges;
+	TArray<int32> FenwickTree;
+	int32 UpperLayer = INDEX_NONE;
+
+	for (int32 LowerLayer = 0; LowerLayer < OrderedLayers.Num(); ++LowerLayer)
 	{
-		if (!Node.bIsExecNode)
+		if (OrderedLayers[LowerLayer].Num() == 0)
 		{
 			continue;
 		}
+		if (UpperLayer == INDEX_NONE)
+		{
+			UpperLayer = LowerLayer;
+			continue;
+		}
 
-		FCortexNodeGroup Group;
-		Group.ExecNodeId = Node.Id;
-
-		TArray<FString> BfsQueue;
-		if (const TArray<FString>* ReverseNeighbors = ReverseDataAdj.Find(Node.Id))
+		// Edges between the two adjacent layers as (upper position, lower position)
+		Edges.Reset();
+		auto CollectEdges = [&Graph, &Layers, &PositionInLayer, &Edges](
+			const TArray<int32>& FromLayer, int32 ToLayer, bool bFromIsUpper)
 		{
-			for (const FString& NeighborId : *ReverseNeighbors)
+			for (const int32 Node : FromLayer)
 			{
-				const FCortexLayoutNode* const* NeighborPtr = NodeMap.Find(NeighborId);
-				if (NeighborPtr && !(*NeighborPtr)->bIsExecNode && !Claimed.Contains(NeighborId))
+				for (const FCortexLayoutCsr* Csr : {&Graph.ExecOut, &Graph.DataOut})
 				{
-					Claimed.Add(NeighborId);
-					Group.DataNodeIds.Add(NeighborId);
-					BfsQueue.Add(NeighborId);
+					for (const int32 Target : Csr->Row(Node))
+					{
+						if (Layers[Target] == ToLayer)
+						{
+							Edges.Add(bFromIsUpper
+								? TPair<int32, int32>(PositionInLayer[Node], PositionInLayer[Target])
+								: TPair<int32, int32>(PositionInLayer[Target], PositionInLayer[Node]));
+						}
+					}
 				}
 			}
-		}
+		};
+		CollectEdges(OrderedLayers[UpperLayer], LowerLayer, true);
+		CollectEdges(OrderedLayers[LowerLayer], UpperLayer, false);
 
-		for (int32 QueueIdx = 0; QueueIdx < BfsQueue.Num(); ++QueueIdx)
+		Edges.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
 		{
-			const FString& CurrentId = BfsQueue[QueueIdx];
-			const TArray<FString>* RevNeighbors = ReverseDataAdj.Find(CurrentId);
-			if (!RevNeighbors)
-			{
-				continue;
-			}
+			return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value);
+		});
 
-			for (const FString& NeighborId : *RevNeighbors)
+		// Inversions in lower positions = crossings (Fenwick tree over lower layer slots)
+		FenwickTree.Init(0, OrderedLayers[LowerLayer].Num() + 1);
+		int32 Inserted = 0;
+		for (const TPair<int32, int32>& Edge : Edges)
+		{
+			int32 NotGreater = 0;
+			for (int32 i = Edge.Value + 1; i > 0; i -= i & -i)
 			{
-				const FCortexLayoutNode* const* NeighborPtr = NodeMap.Find(NeighborId);
-				if (NeighborPtr && !(*NeighborPtr)->bIsExecNode && !Claimed.Contains(NeighborId))
-				{
-					Claimed.Add(NeighborId);
-					Group.DataNodeIds.Add(NeighborId);
-					BfsQueue.Add(NeighborId);
-				}
+				NotGreater += FenwickTree[i];
 			}
-		}
+			Total += Inserted - NotGreater;
 
-		if (Group.DataNodeIds.Num() > 0)
-		{
-			UE_LOG(LogCortexGraph, Log, TEXT("[DiscoverGroups] Group formed: ExecNode=%s DataNodes=%d"),
-				*Group.ExecNodeId, Group.DataNodeIds.Num());
-			const int32 GroupIndex = Groups.Num();
-			OutNodeToGroupIndex.Add(Group.ExecNodeId, GroupIndex);
-			for (const FString& DataId : Group.DataNodeIds)
+			for (int32 i = Edge.Value + 1; i < FenwickTree.Num(); i += i & -i)
 			{
-				OutNodeToGroupIndex.Add(DataId, GroupIndex);
+				++FenwickTree[i];
 			}
-			Groups.Add(MoveTemp(Group));
-		}
-		else
-		{
-			UE_LOG(LogCortexGraph, Verbose, TEXT("[DiscoverGroups] ExecNode=%s: no data ancestors found"),
-				*Node.Id);
+			++Inserted;
 		}
+
+		UpperLayer = LowerLayer;
 	}
 
-	UE_LOG(LogCortexGraph, Log, TEXT("[DiscoverGroups] Total groups formed: %d"), Groups.Num());
-	return Groups;
+	return Total;
 }
 
-TArray<FCortexLayoutNode> FCortexGraphLayoutOps::BuildGroupProxyNodes(
-	const TArray<FCortexLayoutNode>& OriginalNodes,
-	const TArray<FCortexNodeGroup>& Groups,
-	const TMap<FString, int32>& NodeToGroupIndex,
-	const TMap<FString, const FCortexLayoutNode*>& NodeMap,
-	const FCortexLayoutConfig& Config)
+void FCortexGraphLayoutOps::CalculatePositions(
+	const FIndexedGraph& Graph,
+	const TArray<TArray<int32>>& OrderedLayers,
+	const FCortexLayoutConfig& Config,
+	TArray<FIntPoint>& OutPositions)
 {
-	if (Groups.Num() == 0)
-	{
-		return OriginalNodes;
-	}
-
-	const int32 InnerHSpacing = FMath::RoundToInt(
-		Config.HorizontalSpacing * CortexGraphLayout::InnerGroupHorizontalSpacingRatio);
-	const int32 InnerVSpacing = FMath::RoundToInt(
-		Config.VerticalSpacing * CortexGraphLayout::InnerGroupVerticalSpacingRatio);
+	OutPositions.Init(FIntPoint::ZeroValue, Graph.Num());
 
-	TArray<FCortexLayoutNode> ProxyNodes;
-	ProxyNodes.Reserve(OriginalNodes.Num());
-
-	for (const FCortexNodeGroup& Group : Groups)
+	int32 CurrentX = 0;
+	for (const TArray<int32>& LayerNodes : OrderedLayers)
 	{
-		const FCortexLayoutNode* const* ExecPtr = NodeMap.Find(Group.ExecNodeId);
-		if (!ExecPtr)
+		if (LayerNodes.Num() == 0)
 		{
 			continue;
 		}
 
-		FCortexLayoutNode Proxy = **ExecPtr;
-
-		int32 MaxDataWidth = 0;
-		int32 MaxDataHeight = 0;
-		for (const FString& DataId : Group.DataNodeIds)
+		int32 MaxWidth = 0;
+		int32 TotalHeight = 0;
+		for (int32 i = 0; i < LayerNodes.Num(); ++i)
 		{
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			if (DataPtr)
+			MaxWidth = FMath::Max(MaxWidth, Graph.Width[LayerNodes[i]]);
+			TotalHeight += Graph.Height[LayerNodes[i]];
+			if (i < LayerNodes.Num() - 1)
 			{
-				MaxDataWidth = FMath::Max(MaxDataWidth, (*DataPtr)->Width);
-				MaxDataHeight = FMath::Max(MaxDataHeight, (*DataPtr)->Height);
+				TotalHeight += Config.VerticalSpacing;
 			}
 		}
 
-		// Compute chain structure for accurate proxy dimensions
-		TSet<FString> GroupDataSet(Group.DataNodeIds);
-		TMap<FString, TArray<FString>> InnerForward;
-		TMap<FString, int32> InnerInDegree;
-		for (const FString& DataId : Group.DataNodeIds)
+		int32 CurrentY = -TotalHeight / 2;
+		for (const int32 Node : LayerNodes)
 		{
-			InnerInDegree.FindOrAdd(DataId);
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			if (!DataPtr)
-			{
-				continue;
-			}
-			for (const FString& TargetId : (*DataPtr)->DataOutputs)
-			{
-				if (GroupDataSet.Contains(TargetId))
-				{
-					InnerForward.FindOrAdd(DataId).Add(TargetId);
-					InnerInDegree.FindOrAdd(TargetId)++;
-				}
-			}
+			OutPositions[Node] = FIntPoint(CurrentX, CurrentY);
+			CurrentY += Graph.Height[Node] + Config.VerticalSpacing;
 		}
 
-		int32 ChainCount = 0;
-		TMap<FString, int32> ChainDepth;
-		TArray<FString> ChainQueue;
-		for (const FString& DataId : Group.DataNodeIds)
+		CurrentX += MaxWidth + Config.HorizontalSpacing;
+	}
+}
+
+TArray<TArray<int32>> FCortexGraphLayoutOps::FindSubgraphs(const FIndexedGraph& Graph)
+{
+	TArray<TArray<int32>> Subgraphs;
+	TArray<bool> Visited;
+	Visited.Init(false, Graph.Num());
+
+	for (int32 Start = 0; Start < Graph.Num(); ++Start)
+	{
+		if (Visited[Start] || Graph.IsPhantom(Start))
 		{
-			if (InnerInDegree.FindRef(DataId) == 0)
-			{
-				ChainCount++;
-				ChainQueue.Add(DataId);
-				ChainDepth.Add(DataId, 1);
-			}
+			continue;
 		}
-		ChainCount = FMath::Max(1, ChainCount);
 
-		int32 LongestChainLength = 1;
-		for (int32 Idx = 0; Idx < ChainQueue.Num(); ++Idx)
+		// BFS; the component list doubles as the queue
+		TArray<int32>& Component = Subgraphs.AddDefaulted_GetRef();
+		Component.Add(Start);
+		Visited[Start] = true;
+
+		for (int32 QueueIndex = 0; QueueIndex < Component.Num(); ++QueueIndex)
 		{
-			const FString& CurId = ChainQueue[Idx];
-			const int32 CurDepth = ChainDepth.FindRef(CurId);
-			LongestChainLength = FMath::Max(LongestChainLength, CurDepth);
-			const TArray<FString>* Forward = InnerForward.Find(CurId);
-			if (Forward)
+			for (const int32 Neighbor : Graph.Undirected.Row(Component[QueueIndex]))
 			{
-				for (const FString& NextId : *Forward)
+				if (!Visited[Neighbor])
 				{
-					int32& NextDepth = ChainDepth.FindOrAdd(NextId);
-					NextDepth = FMath::Max(NextDepth, CurDepth + 1);
-					LongestChainLength = FMath::Max(LongestChainLength, NextDepth);
-					int32& Deg = InnerInDegree.FindOrAdd(NextId);
-					Deg--;
-					if (Deg == 0)
-					{
-						ChainQueue.Add(NextId);
-					}
+					Visited[Neighbor] = true;
+					Component.Add(Neighbor);
 				}
 			}
 		}
+	}
+
+	return Subgraphs;
+}
 
-		Proxy.Width = LongestChainLength * (MaxDataWidth + InnerHSpacing) + (*ExecPtr)->Width;
-		Proxy.Height = FMath::Max(ChainCount * (MaxDataHeight + InnerVSpacing), (*ExecPtr)->Height);
+void FCortexGraphLayoutOps::BuildSubgraph(
+	const FIndexedGraph& Graph,
+	const TArray<int32>& Members,
+	TArray<int32>& ScratchParentToLocal,
+	FIndexedGraph& OutSubgraph)
+{
+	for (const int32 Member : Members)
+	{
+		const int32 Local = OutSubgraph.AddNode(
+			Graph.SourceIndex[Member], Graph.IdRank[Member],
+			Graph.Width[Member], Graph.Height[Member], Graph.Flags[Member]);
+		ScratchParentToLocal[Member] = Local;
+	}
 
-		TArray<FString> FilteredDataOutputs;
-		for (const FString& TargetId : Proxy.DataOutputs)
+	TArray<TPair<int32, int32>> ExecEdges;
+	TArray<TPair<int32, int32>> DataEdges;
+	for (int32 Local = 0; Local < Members.Num(); ++Local)
+	{
+		for (const int32 Target : Graph.ExecOut.Row(Members[Local]))
 		{
-			const int32* TargetGroup = NodeToGroupIndex.Find(TargetId);
-			const int32* ProxyGroup = NodeToGroupIndex.Find(Proxy.Id);
-			if (!TargetGroup || !ProxyGroup || *TargetGroup != *ProxyGroup)
+			if (ScratchParentToLocal[Target] != INDEX_NONE)
 			{
-				FilteredDataOutputs.Add(TargetId);
+				ExecEdges.Emplace(Local, ScratchParentToLocal[Target]);
+			}
+		}
+		for (const int32 Target : Graph.DataOut.Row(Members[Local]))
+		{
+			if (ScratchParentToLocal[Target] != INDEX_NONE)
+			{
+				DataEdges.Emplace(Local, ScratchParentToLocal[Target]);
 			}
 		}
-		Proxy.DataOutputs = MoveTemp(FilteredDataOutputs);
-
-		ProxyNodes.Add(MoveTemp(Proxy));
 	}
 
-	for (const FCortexLayoutNode& Node : OriginalNodes)
+	// Reset only the touched entries so the scratch stays O(members) per subgraph
+	for (const int32 Member : Members)
 	{
-		if (!NodeToGroupIndex.Contains(Node.Id))
-		{
-			ProxyNodes.Add(Node);
-		}
+		ScratchParentToLocal[Member] = INDEX_NONE;
 	}
 
-	return ProxyNodes;
+	OutSubgraph.Finalize(ExecEdges, DataEdges);
 }
 
-void FCortexGraphLayoutOps::ExpandGroupPositions(
-	const TArray<FCortexNodeGroup>& Groups,
-	const TMap<FString, int32>& NodeToGroupIndex,
-	const TMap<FString, const FCortexLayoutNode*>& NodeMap,
-	const FCortexLayoutConfig& Config,
-	FCortexLayoutResult& InOutResult)
+void FCortexGraphLayoutOps::DiscoverGroups(
+	const FIndexedGraph& Graph,
+	TArray<FNodeGroup>& OutGroups,
+	TArray<int32>& OutNodeToGroup)
 {
-	if (Groups.Num() == 0)
+	OutGroups.Reset();
+	OutNodeToGroup.Init(INDEX_NONE, Graph.Num());
+
+	// Skip grouping when there are no exec nodes.
+	bool bHasAnyExecNode = false;
+	int32 NodesWithDataInputs = 0;
+	for (int32 Node = 0; Node < Graph.Num(); ++Node)
+	{
+		bHasAnyExecNode |= !Graph.IsPhantom(Node) && Graph.IsExecNode(Node);
+		NodesWithDataInputs += Graph.DataIn.Count(Node) > 0 ? 1 : 0;
+	}
+
+	UE_LOG(LogCortexGraph, Log, TEXT("[DiscoverGroups] %d nodes, bHasAnyExecNode=%d, ReverseDataAdj entries=%d"),
+		Graph.Num(), (int32)bHasAnyExecNode, NodesWithDataInputs);
+
+	if (!bHasAnyExecNode)
 	{
 		return;
 	}
 
-	const int32 InnerHSpacing = FMath::RoundToInt(
-		Config.HorizontalSpacing * CortexGraphLayout::InnerGroupHorizontalSpacingRatio);
-	const int32 InnerVSpacing = FMath::RoundToInt(
-		Config.VerticalSpacing * CortexGraphLayout::InnerGroupVerticalSpacingRatio);
+	auto IsClaimable = [&Graph, &OutNodeToGroup](int32 Node)
+	{
+		return !Graph.IsPhantom(Node) && !Graph.IsExecNode(Node) && OutNodeToGroup[Node] == INDEX_NONE;
+	};
 
-	for (const FCortexNodeGroup& Group : Groups)
+	// Exec nodes claim pure-data ancestors in deterministic input order.
+	TArray<int32> LocalIndex;
+	LocalIndex.Init(INDEX_NONE, Graph.Num());
+	for (int32 Node = 0; Node < Graph.Num(); ++Node)
 	{
-		const FIntPoint* GroupPosPtr = InOutResult.Positions.Find(Group.ExecNodeId);
-		if (!GroupPosPtr || Group.DataNodeIds.Num() == 0)
+		if (Graph.IsPhantom(Node) || !Graph.IsExecNode(Node))
 		{
 			continue;
 		}
-		const FIntPoint GroupPos = *GroupPosPtr;
 
-		const FCortexLayoutNode* const* ExecPtr = NodeMap.Find(Group.ExecNodeId);
-		if (!ExecPtr)
-		{
-			continue;
-		}
+		const int32 GroupIndex = OutGroups.Num();
+		FNodeGroup Group;
+		Group.ExecNode = Node;
 
-		int32 MaxDataWidth = 0;
-		for (const FString& DataId : Group.DataNodeIds)
+		// BFS backward along data edges; DataNodes doubles as the queue
+		for (const int32 Source : Graph.DataIn.Row(Node))
 		{
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			if (DataPtr)
+			if (IsClaimable(Source))
 			{
-				MaxDataWidth = FMath::Max(MaxDataWidth, (*DataPtr)->Width);
+				OutNodeToGroup[Source] = GroupIndex;
+				Group.DataNodes.Add(Source);
 			}
 		}
-
-		// Compute longest chain length via inner forward adjacency for accurate exec offset
-		TSet<FString> GroupDataSetForExec(Group.DataNodeIds);
-		TMap<FString, TArray<FString>> ExecInnerForward;
-		TMap<FString, int32> ExecInnerInDegree;
-		for (const FString& DataId : Group.DataNodeIds)
+		for (int32 QueueIdx = 0; QueueIdx < Group.DataNodes.Num(); ++QueueIdx)
 		{
-			ExecInnerInDegree.FindOrAdd(DataId);
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			if (!DataPtr)
-			{
-				continue;
-			}
-			for (const FString& TargetId : (*DataPtr)->DataOutputs)
+			for (const int32 Source : Graph.DataIn.Row(Group.DataNodes[QueueIdx]))
 			{
-				if (GroupDataSetForExec.Contains(TargetId))
+				if (IsClaimable(Source))
 				{
-					ExecInnerForward.FindOrAdd(DataId).Add(TargetId);
-					ExecInnerInDegree.FindOrAdd(TargetId)++;
+					OutNodeToGroup[Source] = GroupIndex;
+					Group.DataNodes.Add(Source);
 				}
 			}
 		}
 
-		TMap<FString, int32> Depth;
-		TArray<FString> DepthQueue;
-		for (const FString& DataId : Group.DataNodeIds)
-		{
-			if (ExecInnerInDegree.FindRef(DataId) == 0)
-			{
-				DepthQueue.Add(DataId);
-				Depth.Add(DataId, 1);
-			}
-		}
-		int32 LongestChain = FMath::Max(1, DepthQueue.Num() > 0 ? 1 : 0);
-		for (int32 Idx = 0; Idx < DepthQueue.Num(); ++Idx)
+		if (Group.DataNodes.Num() == 0)
 		{
-			const FString& CurId = DepthQueue[Idx];
-			const int32 CurDepth = Depth.FindRef(CurId);
-			LongestChain = FMath::Max(LongestChain, CurDepth);
-			const TArray<FString>* Forward = ExecInnerForward.Find(CurId);
-			if (Forward)
-			{
-				for (const FString& NextId : *Forward)
-				{
-					int32& NextDepth = Depth.FindOrAdd(NextId);
-					NextDepth = FMath::Max(NextDepth, CurDepth + 1);
-					LongestChain = FMath::Max(LongestChain, NextDepth);
-					int32& Deg = ExecInnerInDegree.FindOrAdd(NextId);
-					Deg--;
-					if (Deg == 0)
-					{
-						DepthQueue.Add(NextId);
-					}
-				}
-			}
+			continue;
 		}
 
-		const int32 DataRegionWidth = LongestChain * (MaxDataWidth + InnerHSpacing);
+		OutNodeToGroup[Node] = GroupIndex;
 
-		FIntPoint ExecPos = GroupPos;
-		ExecPos.X += DataRegionWidth;
-		InOutResult.Positions[Group.ExecNodeId] = ExecPos;
-
-		TSet<FString> GroupDataSet(Group.DataNodeIds);
-		TMap<FString, TArray<FString>> InnerForward;
-		TMap<FString, int32> InnerInDegree;
-		int32 MaxDataHeight = 0;
-		for (const FString& DataId : Group.DataNodeIds)
+		// Inner chain structure: data edges that stay inside the group's data set
+		for (int32 i = 0; i < Group.DataNodes.Num(); ++i)
 		{
-			InnerInDegree.FindOrAdd(DataId, 0);
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			if (!DataPtr)
-			{
-				continue;
-			}
+			LocalIndex[Group.DataNodes[i]] = i;
+			Group.MaxDataWidth = FMath::Max(Group.MaxDataWidth, Graph.Width[Group.DataNodes[i]]);
+			Group.MaxDataHeight = FMath::Max(Group.MaxDataHeight, Graph.Height[Group.DataNodes[i]]);
+		}
 
-			for (const FString& TargetId : (*DataPtr)->DataOutputs)
+		auto ForEachInner = [&Graph, &Group, &LocalIndex](int32 DataNode, auto&& Fn)
+		{
+			for (const int32 Target : Graph.DataOut.Row(DataNode))
 			{
-				if (GroupDataSet.Contains(TargetId))
+				if (LocalIndex[Target] != INDEX_NONE && Target != Group.ExecNode)
 				{
-					InnerForward.FindOrAdd(DataId).Add(TargetId);
-					InnerInDegree.FindOrAdd(TargetId)++;
+					Fn(LocalIndex[Target]);
 				}
 			}
-			MaxDataHeight = FMath::Max(MaxDataHeight, (*DataPtr)->Height);
+		};
+
+		TArray<int32> InnerInDegree;
+		InnerInDegree.Init(0, Group.DataNodes.Num());
+		for (const int32 DataNode : Group.DataNodes)
+		{
+			ForEachInner(DataNode, [&InnerInDegree](int32 TargetLocal) { ++InnerInDegree[TargetLocal]; });
 		}
 
-		TArray<FString> TopoOrder;
-		TArray<FString> Queue;
-		for (const FString& DataId : Group.DataNodeIds)
+		TArray<int32> Queue;
+		TArray<int32> Depth;
+		Depth.Init(0, Group.DataNodes.Num());
+		for (int32 i = 0; i < Group.DataNodes.Num(); ++i)
 		{
-			if (InnerInDegree.FindRef(DataId) == 0)
+			if (InnerInDegree[i] == 0)
 			{
-				Queue.Add(DataId);
+				Queue.Add(i);
+				Depth[i] = 1;
 			}
 		}
-		const TArray<FString> RootNodes = Queue;
+		const TArray<int32> Roots = Queue;
+		Group.ChainCount = FMath::Max(1, Roots.Num());
 
 		for (int32 QueueIdx = 0; QueueIdx < Queue.Num(); ++QueueIdx)
 		{
-			const FString& CurId = Queue[QueueIdx];
-			TopoOrder.Add(CurId);
-
-			const TArray<FString>* Forward = InnerForward.Find(CurId);
-			if (!Forward)
-			{
-				continue;
-			}
-
-			for (const FString& NextId : *Forward)
+			const int32 Current = Queue[QueueIdx];
+			Group.LongestChain = FMath::Max(Group.LongestChain, Depth[Current]);
+			ForEachInner(Group.DataNodes[Current], [&](int32 Next)
 			{
-				int32& Deg = InnerInDegree.FindOrAdd(NextId);
-				Deg--;
-				if (Deg == 0)
+				Depth[Next] = FMath::Max(Depth[Next], Depth[Current] + 1);
+				Group.LongestChain = FMath::Max(Group.LongestChain, Depth[Next]);
+				if (--InnerInDegree[Next] == 0)
 				{
-					Queue.Add(NextId);
+					Queue.Add(Next);
 				}
-			}
+			});
 		}
 
-		for (const FString& DataId : Group.DataNodeIds)
+		// Topological order, with nodes stuck in inner cycles appended in claim order
+		TArray<bool> InTopoOrder;
+		InTopoOrder.Init(false, Group.DataNodes.Num());
+		for (const int32 Local : Queue)
+		{
+			InTopoOrder[Local] = true;
+		}
+		TArray<int32> TopoLocal = Queue;
+		for (int32 i = 0; i < Group.DataNodes.Num(); ++i)
 		{
-			if (!TopoOrder.Contains(DataId))
+			if (!InTopoOrder[i])
 			{
-				TopoOrder.Add(DataId);
+				TopoLocal.Add(i);
 			}
 		}
 
-		TMap<FString, int32> NodeLaneIndex;
-		int32 NextLane = 0;
-		for (const FString& RootId : RootNodes)
+		// Lanes: each root claims its forward reach; unreachable nodes fall into lane 0
+		TArray<int32> Lane;
+		Lane.Init(INDEX_NONE, Group.DataNodes.Num());
+		for (const int32 Root : Roots)
 		{
-			if (NodeLaneIndex.Contains(RootId))
+			if (Lane[Root] != INDEX_NONE)
 			{
 				continue;
 			}
 
-			const int32 Lane = NextLane++;
-			TArray<FString> LaneQueue;
-			LaneQueue.Add(RootId);
-			NodeLaneIndex.Add(RootId, Lane);
-
+			const int32 CurrentLane = Group.LaneCount++;
+			TArray<int32> LaneQueue;
+			LaneQueue.Add(Root);
+			Lane[Root] = CurrentLane;
 			for (int32 LaneQueueIdx = 0; LaneQueueIdx < LaneQueue.Num(); ++LaneQueueIdx)
 			{
-				const FString& CurId = LaneQueue[LaneQueueIdx];
-				const TArray<FString>* Forward = InnerForward.Find(CurId);
-				if (!Forward)
+				ForEachInner(Group.DataNodes[LaneQueue[LaneQueueIdx]], [&](int32 Next)
 				{
-					continue;
-				}
-
-				for (const FString& NextId : *Forward)
-				{
-					if (!NodeLaneIndex.Contains(NextId))
+					if (Lane[Next] == INDEX_NONE)
 					{
-						NodeLaneIndex.Add(NextId, Lane);
-						LaneQueue.Add(NextId);
+						Lane[Next] = CurrentLane;
+						LaneQueue.Add(Next);
 					}
-				}
+				});
 			}
 		}
 
-		const int32 LaneHeight = FMath::Max(1, MaxDataHeight + InnerVSpacing);
-
-		// Center data lanes vertically at the exec node's midpoint.
-		// NextLane = number of parallel data chains; each occupies LaneHeight pixels.
-		const int32 ExecCenterY = ExecPos.Y + (*ExecPtr)->Height / 2;
-		const int32 TotalDataHeight = NextLane > 0
-			? (NextLane - 1) * LaneHeight + MaxDataHeight
-			: 0;
-		const int32 DataBaseY = ExecCenterY - TotalDataHeight / 2;
-
-		// Per-lane X cursors so each chain starts independently from GroupPos.X
-		TMap<int32, int32> LaneXCursor;
-		for (int32 Lane = 0; Lane < NextLane; ++Lane)
+		Group.TopoOrder.Reserve(TopoLocal.Num());
+		Group.TopoLane.Reserve(TopoLocal.Num());
+		for (const int32 Local : TopoLocal)
 		{
-			LaneXCursor.Add(Lane, GroupPos.X);
+			Group.TopoOrder.Add(Group.DataNodes[Local]);
+			Group.TopoLane.Add(FMath::Max(0, Lane[Local]));
 		}
 
-		for (const FString& DataId : TopoOrder)
+		for (const int32 DataNode : Group.DataNodes)
 		{
-			const FCortexLayoutNode* const* DataPtr = NodeMap.Find(DataId);
-			const int32 Width = DataPtr ? (*DataPtr)->Width : 150;
-			const int32 Lane = NodeLaneIndex.FindRef(DataId);
-			const int32 DataY = DataBaseY + Lane * LaneHeight;
-			int32& LaneX = LaneXCursor.FindOrAdd(Lane);
-			InOutResult.Positions.Add(DataId, FIntPoint(LaneX, DataY));
-			LaneX += Width + InnerHSpacing;
+			LocalIndex[DataNode] = INDEX_NONE;
 		}
+
+		UE_LOG(LogCortexGraph, Verbose, TEXT("[DiscoverGroups] Group formed: ExecNode=%d DataNodes=%d"),
+			Node, Group.DataNodes.Num());
+		OutGroups.Add(MoveTemp(Group));
 	}
+
+	UE_LOG(LogCortexGraph, Log, TEXT("[DiscoverGroups] Total groups formed: %d"), OutGroups.Num());
 }
 
-void FCortexGraphLayoutOps::RefineYPositions(
-	const TArray<FCortexLayoutNode>& Nodes,
-	const TMap<FString, int32>& NodeToGroupIndex,
-	const TArray<TArray<FString>>& Subgraphs,
+void FCortexGraphLayoutOps::BuildGroupProxyGraph(
+	const FIndexedGraph& Graph,
+	const TArray<FNodeGroup>& Groups,
+	const TArray<int32>& NodeToGroup,
 	const FCortexLayoutConfig& Config,
-	FCortexLayoutResult& InOutResult)
+	FIndexedGraph& OutProxyGraph)
 {
-	TMap<FString, const FCortexLayoutNode*> NodeMap;
-	for (const FCortexLayoutNode& Node : Nodes)
+	const int32 InnerHSpacing = FMath::RoundToInt(
+		Config.HorizontalSpacing * CortexGraphLayout::InnerGroupHorizontalSpacingRatio);
+	const int32 InnerVSpacing = FMath::RoundToInt(
+		Config.VerticalSpacing * CortexGraphLayout::InnerGroupVerticalSpacingRatio);
+
+	TArray<int32> GraphToProxy;
+	GraphToProxy.Init(INDEX_NONE, Graph.Num());
+
+	// One proxy per group, sized to hold the group's data lanes plus the exec node
+	for (const FNodeGroup& Group : Groups)
 	{
-		NodeMap.Add(Node.Id, &Node);
+		const int32 Exec = Group.ExecNode;
+		const int32 ProxyWidth = Group.LongestChain * (Group.MaxDataWidth + InnerHSpacing) + Graph.Width[Exec];
+		const int32 ProxyHeight = FMath::Max(
+			Group.ChainCount * (Group.MaxDataHeight + InnerVSpacing), Graph.Height[Exec]);
+		GraphToProxy[Exec] = OutProxyGraph.AddNode(
+			Graph.SourceIndex[Exec], Graph.IdRank[Exec], ProxyWidth, ProxyHeight, Graph.Flags[Exec]);
 	}
 
-	TMap<FString, TArray<FString>> Neighbors;
-	TMap<FString, int32> IncomingCount;
-	TMap<FString, int32> OutgoingCount;
-	for (const FCortexLayoutNode& Node : Nodes)
+	for (int32 Node = 0; Node < Graph.Num(); ++Node)
 	{
-		TArray<FString>& NodeNeighbors = Neighbors.FindOrAdd(Node.Id);
-		OutgoingCount.FindOrAdd(Node.Id) += Node.ExecOutputs.Num() + Node.DataOutputs.Num();
-		for (const FString& Target : Node.ExecOutputs)
-		{
-			NodeNeighbors.AddUnique(Target);
-			Neighbors.FindOrAdd(Target).AddUnique(Node.Id);
-			IncomingCount.FindOrAdd(Target)++;
-		}
-
-		for (const FString& Target : Node.DataOutputs)
+		if (!Graph.IsPhantom(Node) && NodeToGroup[Node] == INDEX_NONE)
 		{
-			NodeNeighbors.AddUnique(Target);
-			Neighbors.FindOrAdd(Target).AddUnique(Node.Id);
-			IncomingCount.FindOrAdd(Target)++;
+			GraphToProxy[Node] = OutProxyGraph.AddNode(
+				Graph.SourceIndex[Node], Graph.IdRank[Node], Graph.Width[Node], Graph.Height[Node], Graph.Flags[Node]);
 		}
 	}
 
-	TSet<FString> SkipSet;
-	for (const auto& Pair : NodeToGroupIndex)
+	// Edges into grouped data nodes (or unknown ids) point at phantoms
+	auto ResolveTarget = [&Graph, &GraphToProxy, &OutProxyGraph](int32 Target) -> int32
 	{
-		if (!InOutResult.LayerAssignment.Contains(Pair.Key))
+		if (GraphToProxy[Target] == INDEX_NONE)
 		{
-			SkipSet.Add(Pair.Key);
+			GraphToProxy[Target] = OutProxyGraph.AddNode(
+				Graph.SourceIndex[Target], Graph.IdRank[Target],
+				DefaultLayoutNodeWidth, DefaultLayoutNodeHeight, FIndexedGraph::Phantom);
 		}
-	}
+		return GraphToProxy[Target];
+	};
 
-	TMap<FString, int32> NodeToSubgraph;
-	for (int32 SubgraphIndex = 0; SubgraphIndex < Subgraphs.Num(); ++SubgraphIndex)
+	TArray<TPair<int32, int32>> ExecEdges;
+	TArray<TPair<int32, int32>> DataEdges;
+	const int32 RealNodeCount = OutProxyGraph.Num();
+	for (int32 Proxy = 0; Proxy < RealNodeCount; ++Proxy)
 	{
-		for (const FString& Id : Subgraphs[SubgraphIndex])
+		const int32 Node = OutProxyGraph.SourceIndex[Proxy];
+		const int32 OwnGroup = NodeToGroup[Node];
+		for (const int32 Target : Graph.ExecOut.Row(Node))
 		{
-			NodeToSubgraph.Add(Id, SubgraphIndex);
+			ExecEdges.Emplace(Proxy, ResolveTarget(Target));
+		}
+		for (const int32 Target : Graph.DataOut.Row(Node))
+		{
+			// Data edges inside a group are laid out by ExpandGroupPositions
+			if (OwnGroup != INDEX_NONE && NodeToGroup[Target] == OwnGroup)
+			{
+				continue;
+			}
+			DataEdges.Emplace(Proxy, ResolveTarget(Target));
 		}
 	}
 
-	TMap<int32, TMap<int32, TArray<FString>>> SubgraphLayers;
-	int32 RefinableCount = 0;
-	for (const auto& Pair : InOutResult.LayerAssignment)
+	OutProxyGraph.Finalize(ExecEdges, DataEdges);
+}
+
+void FCortexGraphLayoutOps::ExpandGroupPositions(
+	const FIndexedGraph& Graph,
+	const TArray<FNodeGroup>& Groups,
+	const FCortexLayoutConfig& Config,
+	TArray<FIntPoint>& InOutPositions,
+	TArray<bool>& InOutPositioned)
+{
+	const int32 InnerHSpacing = FMath::RoundToInt(
+		Config.HorizontalSpacing * CortexGraphLayout::InnerGroupHorizontalSpacingRatio);
+	const int32 InnerVSpacing = FMath::RoundToInt(
+		Config.VerticalSpacing * CortexGraphLayout::InnerGroupVerticalSpacingRatio);
+
+	TArray<int32> LaneXCursor;
+	for (const FNodeGroup& Group : Groups)
 	{
-		if (SkipSet.Contains(Pair.Key))
+		if (!InOutPositioned[Group.ExecNode] || Group.DataNodes.Num() == 0)
 		{
 			continue;
 		}
+		const FIntPoint GroupPos = InOutPositions[Group.ExecNode];
+
+		const int32 DataRegionWidth = Group.LongestChain * (Group.MaxDataWidth + InnerHSpacing);
+
+		FIntPoint ExecPos = GroupPos;
+		ExecPos.X += DataRegionWidth;
+		InOutPositions[Group.ExecNode] = ExecPos;
 
-		if (!InOutResult.Positions.Contains(Pair.Key))
+		const int32 LaneHeight = FMath::Max(1, Group.MaxDataHeight + InnerVSpacing);
+
+		// Center data lanes vertically at the exec node's midpoint.
+		// LaneCount = number of parallel data chains; each occupies LaneHeight pixels.
+		const int32 ExecCenterY = ExecPos.Y + Graph.Height[Group.ExecNode] / 2;
+		const int32 TotalDataHeight = Group.LaneCount > 0
+			? (Group.LaneCount - 1) * LaneHeight + Group.MaxDataHeight
+			: 0;
+		const int32 DataBaseY = ExecCenterY - TotalDataHeight / 2;
+
+		// Per-lane X cursors so each chain starts independently from GroupPos.X
+		LaneXCursor.Init(GroupPos.X, FMath::Max(1, Group.LaneCount));
+
+		for (int32 i = 0; i < Group.TopoOrder.Num(); ++i)
 		{
-			continue;
+			const int32 DataNode = Group.TopoOrder[i];
+			const int32 Lane = Group.TopoLane[i];
+			int32& LaneX = LaneXCursor[Lane];
+			InOutPositions[DataNode] = FIntPoint(LaneX, DataBaseY + Lane * LaneHeight);
+			InOutPositioned[DataNode] = true;
+			LaneX += Graph.Width[DataNode] + InnerHSpacing;
 		}
+	}
+}
+
+void FCortexGraphLayoutOps::RefineYPositions(
+	const FIndexedGraph& ProxyGraph,
+	const TArray<TArray<int32>>& Subgraphs,
+	const TArray<int32>& Layers,
+	const FCortexLayoutConfig& Config,
+	TArray<FIntPoint>& InOutPositions,
+	const TArray<bool>& Positioned)
+{
+	auto LayerOf = [&ProxyGraph, &Layers](int32 Node)
+	{
+		return Layers[ProxyGraph.SourceIndex[Node]];
+	};
+	auto PositionOf = [&ProxyGraph, &InOutPositions](int32 Node) -> FIntPoint&
+	{
+		return InOutPositions[ProxyGraph.SourceIndex[Node]];
+	};
+
+	// Per-subgraph layer buckets of refinable (layered + positioned) nodes
+	TArray<TArray<TArray<int32>>> SubgraphLayers;
+	SubgraphLayers.SetNum(Subgraphs.Num());
+	int32 RefinableCount = 0;
+	for (int32 SubgraphIndex = 0; SubgraphIndex < Subgraphs.Num(); ++SubgraphIndex)
+	{
+		TArray<TArray<int32>>& LayerBuckets = SubgraphLayers[SubgraphIndex];
+		for (const int32 Node : Subgraphs[SubgraphIndex])
+		{
+			const int32 Layer = LayerOf(Node);
+			if (Layer == INDEX_NONE || !Positioned[ProxyGraph.SourceIndex[Node]])
+			{
+				continue;
+			}
 
-		const int32* SubgraphIndex = NodeToSubgraph.Find(Pair.Key);
-		const int32 ResolvedSubgraph = SubgraphIndex ? *SubgraphIndex : 0;
-		SubgraphLayers.FindOrAdd(ResolvedSubgraph).FindOrAdd(Pair.Value).Add(Pair.Key);
-		++RefinableCount;
+			if (LayerBuckets.Num() <= Layer)
+			{
+				LayerBuckets.SetNum(Layer + 1);
+			}
+			LayerBuckets[Layer].Add(Node);
+			++RefinableCount;
+		}
 	}
 
 	if (RefinableCount == 0)
@@ -1260,17 +1606,16 @@ void FCortexGraphLayoutOps::RefineYPositions(
 		return;
 	}
 
-	for (auto& SubgraphPair : SubgraphLayers)
+	for (TArray<TArray<int32>>& LayerBuckets : SubgraphLayers)
 	{
-		for (auto& LayerPair : SubgraphPair.Value)
+		for (TArray<int32>& LayerNodes : LayerBuckets)
 		{
-			TArray<FString>& LayerNodes = LayerPair.Value;
-			LayerNodes.Sort([&IncomingCount, &OutgoingCount](const FString& A, const FString& B)
+			LayerNodes.Sort([&ProxyGraph](int32 A, int32 B)
 			{
-				const int32 AIncoming = IncomingCount.FindRef(A);
-				const int32 AOutgoing = OutgoingCount.FindRef(A);
-				const int32 BIncoming = IncomingCount.FindRef(B);
-				const int32 BOutgoing = OutgoingCount.FindRef(B);
+				const int32 AIncoming = ProxyGraph.IncomingCount[A];
+				const int32 AOutgoing = ProxyGraph.OutgoingCount(A);
+				const int32 BIncoming = ProxyGraph.IncomingCount[B];
+				const int32 BOutgoing = ProxyGraph.OutgoingCount(B);
 				const bool ATransit = (AIncoming > 0 && AOutgoing > 0);
 				const bool BTransit = (BIncoming > 0 && BOutgoing > 0);
 				if (ATransit != BTransit)
@@ -1285,7 +1630,7 @@ void FCortexGraphLayoutOps::RefineYPositions(
 					return !ASource;
 				}
 
-				return A < B;
+				return ProxyGraph.IdRank[A] < ProxyGraph.IdRank[B];
 			});
 		}
 	}
@@ -1294,25 +1639,20 @@ void FCortexGraphLayoutOps::RefineYPositions(
 		/ CortexGraphLayout::GridSnapSize) * CortexGraphLayout::GridSnapSize;
 	const int32 PassCount = (RefinableCount > 300) ? 4 : 8;
 
+	TArray<TPair<int32, int32>> Targets;
+	TArray<int32> PrimaryCenters;
+	TArray<int32> SecondaryCenters;
+
 	for (int32 Pass = 0; Pass < PassCount; ++Pass)
 	{
 		const bool bForward = (Pass % 2 == 0);
 
-		for (auto& SubgraphPair : SubgraphLayers)
+		for (TArray<TArray<int32>>& LayerBuckets : SubgraphLayers)
 		{
-			TMap<int32, TArray<FString>>& LayerMap = SubgraphPair.Value;
-
-			TArray<int32> LayerKeys;
-			LayerMap.GetKeys(LayerKeys);
-			LayerKeys.Sort();
-			if (!bForward)
-			{
-				Algo::Reverse(LayerKeys);
-			}
-
-			for (int32 LayerIndex : LayerKeys)
+			for (int32 Step = 0; Step < LayerBuckets.Num(); ++Step)
 			{
-				TArray<FString>& LayerNodes = LayerMap[LayerIndex];
+				const int32 LayerIndex = bForward ? Step : LayerBuckets.Num() - 1 - Step;
+				const TArray<int32>& LayerNodes = LayerBuckets[LayerIndex];
 				if (LayerNodes.Num() == 0)
 				{
 					continue;
@@ -1320,79 +1660,63 @@ void FCortexGraphLayoutOps::RefineYPositions(
 
 				int32 OriginalTop = MAX_int32;
 				int32 OriginalBottom = MIN_int32;
-				for (const FString& Id : LayerNodes)
+				for (const int32 Node : LayerNodes)
 				{
-					const int32 NodeY = InOutResult.Positions[Id].Y;
-					const FCortexLayoutNode* const* NodePtr = NodeMap.Find(Id);
-					const int32 NodeHeight = NodePtr ? (*NodePtr)->Height : 100;
+					const int32 NodeY = PositionOf(Node).Y;
 					OriginalTop = FMath::Min(OriginalTop, NodeY);
-					OriginalBottom = FMath::Max(OriginalBottom, NodeY + NodeHeight);
+					OriginalBottom = FMath::Max(OriginalBottom, NodeY + ProxyGraph.Height[Node]);
 				}
 				const int32 OriginalCenter = (OriginalTop + OriginalBottom) / 2;
 
-				TArray<TPair<int32, FString>> Targets;
-				for (const FString& NodeId : LayerNodes)
+				Targets.Reset();
+				for (const int32 Node : LayerNodes)
 				{
-					const FCortexLayoutNode* const* NodePtr = NodeMap.Find(NodeId);
-					const int32 Height = NodePtr ? (*NodePtr)->Height : 100;
-
-					TArray<FString> PrimaryNeighbors;
-					TArray<FString> SecondaryNeighbors;
-					const TArray<FString>* ConnectedNodes = Neighbors.Find(NodeId);
-					if (ConnectedNodes)
+					// Primary neighbours sit on the side the sweep is coming from
+					PrimaryCenters.Reset();
+					SecondaryCenters.Reset();
+					for (const int32 Neighbor : ProxyGraph.Undirected.Row(Node))
 					{
-						for (const FString& NeighborId : *ConnectedNodes)
+						const int32 NeighborLayer = LayerOf(Neighbor);
+						const bool bIsPrimary = NeighborLayer != INDEX_NONE &&
+							((bForward && NeighborLayer < LayerIndex) || (!bForward && NeighborLayer > LayerIndex));
+						if (!Positioned[ProxyGraph.SourceIndex[Neighbor]])
 						{
-							const int32* NeighborLayer = InOutResult.LayerAssignment.Find(NeighborId);
-							const bool bIsPrimary = NeighborLayer &&
-								((bForward && *NeighborLayer < LayerIndex) || (!bForward && *NeighborLayer > LayerIndex));
+							// Still decides whether the primary side is populated
 							if (bIsPrimary)
 							{
-								PrimaryNeighbors.Add(NeighborId);
+								PrimaryCenters.Add(MIN_int32);
 							}
 							else
 							{
-								SecondaryNeighbors.Add(NeighborId);
+								SecondaryCenters.Add(MIN_int32);
 							}
+							continue;
 						}
-					}
-
-					const TArray<FString>& SelectedNeighbors =
-						PrimaryNeighbors.Num() > 0 ? PrimaryNeighbors : SecondaryNeighbors;
-
-					TArray<int32> NeighborCenters;
-					for (const FString& NeighborId : SelectedNeighbors)
-					{
-							const FIntPoint* NeighborPos = InOutResult.Positions.Find(NeighborId);
-							if (!NeighborPos)
-							{
-								continue;
-							}
 
-						const FCortexLayoutNode* const* NeighborNode = NodeMap.Find(NeighborId);
-						const int32 NeighborHeight = NeighborNode ? (*NeighborNode)->Height : 100;
-						NeighborCenters.Add(NeighborPos->Y + NeighborHeight / 2);
+						const int32 Center = PositionOf(Neighbor).Y + ProxyGraph.Height[Neighbor] / 2;
+						(bIsPrimary ? PrimaryCenters : SecondaryCenters).Add(Center);
 					}
 
-					int32 TargetY = InOutResult.Positions[NodeId].Y;
-					if (NeighborCenters.Num() > 0)
+					TArray<int32>& SelectedCenters = PrimaryCenters.Num() > 0 ? PrimaryCenters : SecondaryCenters;
+					SelectedCenters.RemoveAllSwap([](int32 Center) { return Center == MIN_int32; }, EAllowShrinking::No);
+
+					int32 TargetY = PositionOf(Node).Y;
+					if (SelectedCenters.Num() > 0)
 					{
-						NeighborCenters.Sort();
-						const int32 Mid = NeighborCenters.Num() / 2;
-						const int32 MedianCenter = (NeighborCenters.Num() % 2 == 1)
-							? NeighborCenters[Mid]
-							: (NeighborCenters[Mid - 1] + NeighborCenters[Mid]) / 2;
-						TargetY = MedianCenter - Height / 2;
+						SelectedCenters.Sort();
+						const int32 Mid = SelectedCenters.Num() / 2;
+						const int32 MedianCenter = (SelectedCenters.Num() % 2 == 1)
+							? SelectedCenters[Mid]
+							: (SelectedCenters[Mid - 1] + SelectedCenters[Mid]) / 2;
+						TargetY = MedianCenter - ProxyGraph.Height[Node] / 2;
 					}
 
-					Targets.Add(TPair<int32, FString>(TargetY, NodeId));
+					Targets.Add(TPair<int32, int32>(TargetY, Node));
 				}
 
 				for (int32 Index = 1; Index < Targets.Num(); ++Index)
 				{
-					const FCortexLayoutNode* const* PrevNodePtr = NodeMap.Find(Targets[Index - 1].Value);
-					const int32 PrevHeight = PrevNodePtr ? (*PrevNodePtr)->Height : 100;
-					const int32 PrevBottom = Targets[Index - 1].Key + PrevHeight;
+					const int32 PrevBottom = Targets[Index - 1].Key + ProxyGraph.Height[Targets[Index - 1].Value];
 					const int32 MinY = PrevBottom + SnapCeil;
 					if (Targets[Index].Key < MinY)
 					{
@@ -1400,16 +1724,14 @@ void FCortexGraphLayoutOps::RefineYPositions(
 					}
 				}
 
-				const FCortexLayoutNode* const* LastNodePtr = NodeMap.Find(Targets.Last().Value);
-				const int32 LastHeight = LastNodePtr ? (*LastNodePtr)->Height : 100;
 				const int32 NewTop = Targets[0].Key;
-				const int32 NewBottom = Targets.Last().Key + LastHeight;
+				const int32 NewBottom = Targets.Last().Key + ProxyGraph.Height[Targets.Last().Value];
 				const int32 NewCenter = (NewTop + NewBottom) / 2;
 				const int32 Shift = (OriginalCenter - NewCenter) / 2;
 
-				for (auto& Target : Targets)
+				for (const TPair<int32, int32>& Target : Targets)
 				{
-					InOutResult.Positions[Target.Value].Y = Target.Key + Shift;
+					PositionOf(Target.Value).Y = Target.Key + Shift;
 				}
 			}
 		}
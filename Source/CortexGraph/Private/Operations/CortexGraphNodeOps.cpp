@@ -3,6 +3,7 @@
 #include "CortexSerializer.h"
 #include "CortexEditorUtils.h"
 #include "CortexGraphLayoutOps.h"
+#include "CortexGraphLookupIndex.h"
 #include "CortexBatchScope.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
@@ -372,12 +373,9 @@ UEdGraph* FCortexGraphNodeOps::FindGraph(UBlueprint* Blueprint, const FString& G
 
 UEdGraphNode* FCortexGraphNodeOps::FindNode(UEdGraph* Graph, const FString& NodeId, FCortexCommandResult& OutError)
 {
-	for (UEdGraphNode* Node : Graph->Nodes)
+	if (UEdGraphNode* Node = FCortexGraphLookupIndex::FindNode(Graph, NodeId))
 	{
-		if (Node && Node->GetName() == NodeId)
-		{
-			return Node;
-		}
+		return Node;
 	}
 
 	OutError = FCortexCommandRouter::Error(
@@ -389,12 +387,9 @@ UEdGraphNode* FCortexGraphNodeOps::FindNode(UEdGraph* Graph, const FString& Node
 
 UEdGraphPin* FCortexGraphNodeOps::FindPin(UEdGraphNode* Node, const FString& PinName, FCortexCommandResult& OutError)
 {
-	for (UEdGraphPin* Pin : Node->Pins)
+	if (UEdGraphPin* Pin = FCortexGraphLookupIndex::FindPin(Node, PinName))
 	{
-		if (Pin && Pin->PinName.ToString() == PinName)
-		{
-			return Pin;
-		}
+		return Pin;
 	}
 
 	OutError = FCortexCommandRouter::Error(
@@ -867,34 +862,82 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 		);
 	}
 
-	FString GraphName;
-	Params->TryGetStringField(TEXT("graph_name"), GraphName);
+	FCortexCommandResult LoadError;
+	UBlueprint* Blueprint = nullptr;
+	UEdGraph* Graph = nullptr;
+	if (!ResolveMutableTargetGraph(Params, AssetPath, Blueprint, Graph, LoadError))
+	{
+		return LoadError;
+	}
 
-	int32 PosX = 0;
-	int32 PosY = 0;
-	const TSharedPtr<FJsonObject>* PosObj = nullptr;
-	if (Params->TryGetObjectField(TEXT("position"), PosObj) && PosObj)
+	UClass* NodeClass = ResolveNodeClass(NodeClassName, Params, LoadError);
+	if (NodeClass == nullptr)
 	{
-		(*PosObj)->TryGetNumberField(TEXT("x"), PosX);
-		(*PosObj)->TryGetNumberField(TEXT("y"), PosY);
+		return LoadError;
 	}
 
-	FCortexCommandResult LoadError;
-	if (!ValidateWritableGraphNodeBlueprintAssetPath(AssetPath, LoadError))
+	FScopedTransaction Transaction(FText::FromString(
+		FString::Printf(TEXT("Cortex: Add node %s"), *NodeClassName)
+	));
+
+	Graph->Modify();
+
+	UEdGraphNode* NewNode = CreateNode(Blueprint, Graph, NodeClass, Params, LoadError);
+	if (NewNode == nullptr)
 	{
 		return LoadError;
 	}
 
-	UBlueprint* Blueprint = LoadBlueprint(AssetPath, LoadError);
+	Graph->NotifyGraphChanged();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+	// Build response
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("node_id"), NewNode->GetName());
+	const FString AddedNodeClass = NewNode->GetClass()->GetName();
+	Data->SetStringField(TEXT("class"), AddedNodeClass);
+	Data->SetStringField(TEXT("node_class"), AddedNodeClass);
+	Data->SetStringField(TEXT("display_name"), NewNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+
+	TArray<TSharedPtr<FJsonValue>> PinsArray;
+	for (UEdGraphPin* Pin : NewNode->Pins)
+	{
+		if (Pin == nullptr)
+		{
+			continue;
+		}
+		PinsArray.Add(MakeShared<FJsonValueObject>(SerializePin(Pin, false)));
+	}
+	Data->SetArrayField(TEXT("pins"), PinsArray);
+
+	return FCortexCommandRouter::Success(Data);
+}
+
+bool FCortexGraphNodeOps::ResolveMutableTargetGraph(
+	const TSharedPtr<FJsonObject>& Params,
+	const FString& AssetPath,
+	UBlueprint*& OutBlueprint,
+	UEdGraph*& OutGraph,
+	FCortexCommandResult& OutError)
+{
+	if (!ValidateWritableGraphNodeBlueprintAssetPath(AssetPath, OutError))
+	{
+		return false;
+	}
+
+	UBlueprint* Blueprint = LoadBlueprint(AssetPath, OutError);
 	if (Blueprint == nullptr)
 	{
-		return LoadError;
+		return false;
 	}
 
+	FString GraphName;
+	Params->TryGetStringField(TEXT("graph_name"), GraphName);
+
 	UEdGraph* Graph = nullptr;
-	if (!ResolveMutableNodeGraph(Blueprint, GraphName, Graph, LoadError))
+	if (!ResolveMutableNodeGraph(Blueprint, GraphName, Graph, OutError))
 	{
-		return LoadError;
+		return false;
 	}
 
 	// Resolve subgraph path if provided
@@ -902,13 +945,23 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 	Params->TryGetStringField(TEXT("subgraph_path"), SubgraphPath);
 	if (!SubgraphPath.IsEmpty())
 	{
-		Graph = ResolveSubgraph(Graph, SubgraphPath, LoadError);
+		Graph = ResolveSubgraph(Graph, SubgraphPath, OutError);
 		if (Graph == nullptr)
 		{
-			return LoadError;
+			return false;
 		}
 	}
 
+	OutBlueprint = Blueprint;
+	OutGraph = Graph;
+	return true;
+}
+
+UClass* FCortexGraphNodeOps::ResolveNodeClass(
+	const FString& NodeClassName,
+	const TSharedPtr<FJsonObject>& Spec,
+	FCortexCommandResult& OutError)
+{
 	// Resolve node class
 	// For well-known classes, use StaticClass (faster, no dynamic loading)
 	// Other classes use dynamic loading from /Script/BlueprintGraph or /Script/Engine
@@ -959,14 +1012,15 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 		// Adding without one produces a compile error.
 		const TSharedPtr<FJsonObject>* NodeParams = nullptr;
 		FString TimelineName;
-		if (!Params->TryGetObjectField(TEXT("params"), NodeParams) ||
+		if (!Spec->TryGetObjectField(TEXT("params"), NodeParams) ||
 			!(*NodeParams)->TryGetStringField(TEXT("timeline_name"), TimelineName) ||
 			TimelineName.IsEmpty())
 		{
-			return FCortexCommandRouter::Error(
+			OutError = FCortexCommandRouter::Error(
 				CortexErrorCodes::InvalidField,
 				TEXT("TimelineNameRequired: timeline_name param is required for Timeline nodes")
 			);
+			return nullptr;
 		}
 		NodeClass = UK2Node_Timeline::StaticClass();
 	}
@@ -983,14 +1037,15 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 		// MacroInstance requires SetMacroGraph(); adding without macro_path produces a node with no pins.
 		const TSharedPtr<FJsonObject>* NodeParams = nullptr;
 		FString MacroPath;
-		if (!Params->TryGetObjectField(TEXT("params"), NodeParams) ||
+		if (!Spec->TryGetObjectField(TEXT("params"), NodeParams) ||
 			!(*NodeParams)->TryGetStringField(TEXT("macro_path"), MacroPath) ||
 			MacroPath.IsEmpty())
 		{
-			return FCortexCommandRouter::Error(
+			OutError = FCortexCommandRouter::Error(
 				CortexErrorCodes::InvalidField,
 				TEXT("MacroPathRequired: macro_path param is required for MacroInstance nodes")
 			);
+			return nullptr;
 		}
 		NodeClass = UK2Node_MacroInstance::StaticClass();
 	}
@@ -1010,14 +1065,15 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 	{
 		const TSharedPtr<FJsonObject>* NodeParams = nullptr;
 		FString DelegateName;
-		if (!Params->TryGetObjectField(TEXT("params"), NodeParams) ||
+		if (!Spec->TryGetObjectField(TEXT("params"), NodeParams) ||
 			!(*NodeParams)->TryGetStringField(TEXT("delegate_name"), DelegateName) ||
 			DelegateName.IsEmpty())
 		{
-			return FCortexCommandRouter::Error(
+			OutError = FCortexCommandRouter::Error(
 				CortexErrorCodes::InvalidField,
 				TEXT("DelegateNameRequired: delegate_name param is required for AddDelegate nodes")
 			);
+			return nullptr;
 		}
 		NodeClass = UK2Node_AddDelegate::StaticClass();
 	}
@@ -1025,14 +1081,15 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 	{
 		const TSharedPtr<FJsonObject>* NodeParams = nullptr;
 		FString DelegateName;
-		if (!Params->TryGetObjectField(TEXT("params"), NodeParams) ||
+		if (!Spec->TryGetObjectField(TEXT("params"), NodeParams) ||
 			!(*NodeParams)->TryGetStringField(TEXT("delegate_name"), DelegateName) ||
 			DelegateName.IsEmpty())
 		{
-			return FCortexCommandRouter::Error(
+			OutError = FCortexCommandRouter::Error(
 				CortexErrorCodes::InvalidField,
 				TEXT("DelegateNameRequired: delegate_name param is required for RemoveDelegate nodes")
 			);
+			return nullptr;
 		}
 		NodeClass = UK2Node_RemoveDelegate::StaticClass();
 	}
@@ -1040,14 +1097,15 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 	{
 		const TSharedPtr<FJsonObject>* NodeParams = nullptr;
 		FString DelegateName;
-		if (!Params->TryGetObjectField(TEXT("params"), NodeParams) ||
+		if (!Spec->TryGetObjectField(TEXT("params"), NodeParams) ||
 			!(*NodeParams)->TryGetStringField(TEXT("delegate_name"), DelegateName) ||
 			DelegateName.IsEmpty())
 		{
-			return FCortexCommandRouter::Error(
+			OutError = FCortexCommandRouter::Error(
 				CortexErrorCodes::InvalidField,
 				TEXT("DelegateNameRequired: delegate_name param is required for ClearDelegate nodes")
 			);
+			return nullptr;
 		}
 		NodeClass = UK2Node_ClearDelegate::StaticClass();
 	}
@@ -1062,28 +1120,40 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 
 	if (NodeClass == nullptr)
 	{
-		return FCortexCommandRouter::Error(
+		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::InvalidField,
 			FString::Printf(TEXT("Node class not found: %s"), *NodeClassName)
 		);
 	}
+	return NodeClass;
+}
 
-	FScopedTransaction Transaction(FText::FromString(
-		FString::Printf(TEXT("Cortex: Add node %s"), *NodeClassName)
-	));
-
-	Graph->Modify();
-
+UEdGraphNode* FCortexGraphNodeOps::CreateNode(
+	UBlueprint* Blueprint,
+	UEdGraph* Graph,
+	UClass* NodeClass,
+	const TSharedPtr<FJsonObject>& Spec,
+	FCortexCommandResult& OutError)
+{
 	UEdGraphNode* NewNode = NewObject<UEdGraphNode>(Graph, NodeClass);
 	NewNode->CreateNewGuid();
-	NewNode->NodePosX = PosX;
-	NewNode->NodePosY = PosY;
-	Graph->AddNode(NewNode, true, false);
+	const TSharedPtr<FJsonObject>* PosObj = nullptr;
+	if (Spec->TryGetObjectField(TEXT("position"), PosObj) && PosObj)
+	{
+		int32 PosX = 0;
+		int32 PosY = 0;
+		(*PosObj)->TryGetNumberField(TEXT("x"), PosX);
+		(*PosObj)->TryGetNumberField(TEXT("y"), PosY);
+		NewNode->NodePosX = PosX;
+		NewNode->NodePosY = PosY;
+	}
+	// Insert without AddNode: it broadcasts NotifyGraphChanged per node, and callers notify once
+	Graph->Nodes.Add(NewNode);
 
 	// Handle type-specific setup
-	// NodeParams = node-specific parameters (nested object), distinct from outer Params
+	// NodeParams = node-specific parameters (nested object), distinct from the spec itself
 	const TSharedPtr<FJsonObject>* NodeParams = nullptr;
-	if (Params->TryGetObjectField(TEXT("params"), NodeParams) && NodeParams)
+	if (Spec->TryGetObjectField(TEXT("params"), NodeParams) && NodeParams)
 	{
 		UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(NewNode);
 		if (CallNode)
@@ -1099,21 +1169,23 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 					UClass* FuncClass = FindFirstObject<UClass>(*ClassName);
 					if (FuncClass == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Function owner class not found: %s"), *ClassName)
 						);
+						return nullptr;
 					}
 
 					UFunction* Func = FuncClass->FindFunctionByName(FName(*FuncName));
 					if (Func == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Function not found: %s on class %s"), *FuncName, *ClassName)
 						);
+						return nullptr;
 					}
 
 					CallNode->SetFromFunction(Func);
@@ -1134,21 +1206,23 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 					UClass* VarClass = FindFirstObject<UClass>(*VariableClass);
 					if (VarClass == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Variable owner class not found: %s"), *VariableClass)
 						);
+						return nullptr;
 					}
 
 					FProperty* Prop = VarClass->FindPropertyByName(FName(*VariableName));
 					if (Prop == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Property not found: %s on class %s"), *VariableName, *VariableClass)
 						);
+						return nullptr;
 					}
 
 					VarNode->SetFromProperty(Prop, false, VarClass);
@@ -1164,11 +1238,12 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 						FProperty* SelfProp = SelfClass->FindPropertyByName(FName(*VariableName));
 						if (SelfProp == nullptr)
 						{
-							Graph->RemoveNode(NewNode);
-							return FCortexCommandRouter::Error(
+							Graph->Nodes.Remove(NewNode);
+							OutError = FCortexCommandRouter::Error(
 								CortexErrorCodes::InvalidField,
 								FString::Printf(TEXT("Self property not found: %s"), *VariableName)
 							);
+							return nullptr;
 						}
 					}
 					VarNode->VariableReference.SetSelfMember(FName(*VariableName));
@@ -1188,11 +1263,12 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 				UClass* TargetClass = ResolveGraphNodeClassIdentifier(TargetClassIdentifier);
 				if (TargetClass == nullptr)
 				{
-					Graph->RemoveNode(NewNode);
-					return FCortexCommandRouter::Error(
+					Graph->Nodes.Remove(NewNode);
+					OutError = FCortexCommandRouter::Error(
 						CortexErrorCodes::InvalidField,
 						FString::Printf(TEXT("Cast target class not found: %s"), *TargetClassIdentifier)
 					);
+					return nullptr;
 				}
 
 				CastNode->TargetType = TargetClass;
@@ -1213,21 +1289,23 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 					UClass* FuncClass = FindFirstObject<UClass>(*ClassName);
 					if (FuncClass == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Event owner class not found: %s"), *ClassName)
 						);
+						return nullptr;
 					}
 
 					UFunction* Func = FuncClass->FindFunctionByName(FName(*FuncName));
 					if (Func == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Event function not found: %s on class %s"), *FuncName, *ClassName)
 						);
+						return nullptr;
 					}
 
 					EventNode->EventReference.SetExternalMember(FName(*FuncName), FuncClass);
@@ -1249,23 +1327,25 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 					UClass* OwnerClass = FindFirstObject<UClass>(*DelegateClass);
 					if (OwnerClass == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Delegate owner class not found: %s"), *DelegateClass)
 						);
+						return nullptr;
 					}
 
 					FMulticastDelegateProperty* DelegateProp = CastField<FMulticastDelegateProperty>(
 						OwnerClass->FindPropertyByName(FName(*DelegateName)));
 					if (DelegateProp == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Multicast delegate property not found: %s on class %s"),
 								*DelegateName, *DelegateClass)
 						);
+						return nullptr;
 					}
 
 					DelegateNode->SetFromProperty(DelegateProp, false, OwnerClass);
@@ -1278,22 +1358,24 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 						: Blueprint->GeneratedClass;
 					if (SelfClass == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							TEXT("Blueprint has no generated class for self-context delegate lookup")
 						);
+						return nullptr;
 					}
 
 					FMulticastDelegateProperty* DelegateProp = CastField<FMulticastDelegateProperty>(
 						SelfClass->FindPropertyByName(FName(*DelegateName)));
 					if (DelegateProp == nullptr)
 					{
-						Graph->RemoveNode(NewNode);
-						return FCortexCommandRouter::Error(
+						Graph->Nodes.Remove(NewNode);
+						OutError = FCortexCommandRouter::Error(
 							CortexErrorCodes::InvalidField,
 							FString::Printf(TEXT("Self delegate property not found: %s"), *DelegateName)
 						);
+						return nullptr;
 					}
 
 					DelegateNode->SetFromProperty(DelegateProp, true, SelfClass);
@@ -1325,9 +1407,6 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 		CompositeNewNode->AllocateDefaultPins();
 	}
 
-	Graph->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-
 	// Force GUID resolution for CreateDelegate nodes — SetFunction alone leaves
 	// SelectedFunctionGuid invalid, which is only resolved lazily via
 	// PinConnectionListChanged/NodeConnectionListChanged in the editor.
@@ -1340,26 +1419,7 @@ FCortexCommandResult FCortexGraphNodeOps::AddNode(const TSharedPtr<FJsonObject>&
 		CreateDelegatePost->HandleAnyChange(true);
 	}
 
-	// Build response
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetStringField(TEXT("node_id"), NewNode->GetName());
-	const FString AddedNodeClass = NewNode->GetClass()->GetName();
-	Data->SetStringField(TEXT("class"), AddedNodeClass);
-	Data->SetStringField(TEXT("node_class"), AddedNodeClass);
-	Data->SetStringField(TEXT("display_name"), NewNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-
-	TArray<TSharedPtr<FJsonValue>> PinsArray;
-	for (UEdGraphPin* Pin : NewNode->Pins)
-	{
-		if (Pin == nullptr)
-		{
-			continue;
-		}
-		PinsArray.Add(MakeShared<FJsonValueObject>(SerializePin(Pin, false)));
-	}
-	Data->SetArrayField(TEXT("pins"), PinsArray);
-
-	return FCortexCommandRouter::Success(Data);
+	return NewNode;
 }
 
 bool FCortexGraphNodeOps::ShouldSkipPinCompact(const UEdGraphPin* Pin)
@@ -1646,29 +1706,60 @@ FCortexCommandResult FCortexGraphNodeOps::SetPinValue(const TSharedPtr<FJsonObje
 		return LoadError;
 	}
 
+	FScopedTransaction Transaction(FText::FromString(
+		FString::Printf(TEXT("Cortex: Set pin value %s.%s"), *NodeId, *PinName)
+	));
+
+	Graph->Modify();
+
+	if (!ApplyPinDefault(Node, Pin, Value, LoadError))
+	{
+		Transaction.Cancel();
+		return LoadError;
+	}
+
+	Graph->NotifyGraphChanged();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("node_id"), NodeId);
+	Data->SetStringField(TEXT("pin_name"), PinName);
+	Data->SetStringField(TEXT("value"), Value);
+	Data->SetBoolField(TEXT("success"), true);
+
+	UE_LOG(LogCortexGraph, Log, TEXT("Set pin value %s.%s = %s"), *NodeId, *PinName, *Value);
+
+	return FCortexCommandRouter::Success(Data);
+}
+
+bool FCortexGraphNodeOps::ApplyPinDefault(
+	UEdGraphNode* Node,
+	UEdGraphPin* Pin,
+	const FString& Value,
+	FCortexCommandResult& OutError)
+{
+	const FString PinName = Pin->PinName.ToString();
+
 	// Verify this is an input pin (output pins don't have default values)
 	if (Pin->Direction != EGPD_Input)
 	{
-		return FCortexCommandRouter::Error(
+		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::InvalidOperation,
 			FString::Printf(TEXT("Cannot set value on output pin: %s"), *PinName)
 		);
+		return false;
 	}
 
 	// Verify pin is not connected (connected pins ignore default values)
 	if (Pin->LinkedTo.Num() > 0)
 	{
-		return FCortexCommandRouter::Error(
+		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::InvalidOperation,
 			FString::Printf(TEXT("Cannot set value on connected pin: %s"), *PinName)
 		);
+		return false;
 	}
 
-	FScopedTransaction Transaction(FText::FromString(
-		FString::Printf(TEXT("Cortex: Set pin value %s.%s"), *NodeId, *PinName)
-	));
-
-	Graph->Modify();
 	Node->Modify();
 
 	// Set the default value
@@ -1694,18 +1785,112 @@ FCortexCommandResult FCortexGraphNodeOps::SetPinValue(const TSharedPtr<FJsonObje
 		Pin->DefaultValue = Value;
 	}
 
-	Graph->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	return true;
+}
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetStringField(TEXT("node_id"), NodeId);
-	Data->SetStringField(TEXT("pin_name"), PinName);
-	Data->SetStringField(TEXT("value"), Value);
-	Data->SetBoolField(TEXT("success"), true);
+int32 FCortexGraphNodeOps::LayoutGraph(
+	UEdGraph* Graph,
+	const FCortexLayoutConfig& Config,
+	int32& OutNodesProcessed,
+	double& OutLayoutSeconds)
+{
+	TArray<FCortexLayoutNode> LayoutNodes;
+	TMap<FString, UEdGraphNode*> IdToNode;
 
-	UE_LOG(LogCortexGraph, Log, TEXT("Set pin value %s.%s = %s"), *NodeId, *PinName, *Value);
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
 
-	return FCortexCommandRouter::Success(Data);
+		// Skip comment nodes (class name contains "Comment")
+		if (Node->GetClass()->GetName() == TEXT("EdGraphNode_Comment"))
+		{
+			continue;
+		}
+
+		FCortexLayoutNode LN;
+		LN.Id = Node->GetName();
+		IdToNode.Add(LN.Id, Node);
+
+		bool bHasExecInput = false;
+		bool bHasExecOutput = false;
+		int32 InputPinCount = 0;
+		int32 OutputPinCount = 0;
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin) continue;
+			bool bIsExec = (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
+			if (Pin->Direction == EGPD_Input)
+			{
+				InputPinCount++;
+				if (bIsExec) bHasExecInput = true;
+			}
+			else
+			{
+				OutputPinCount++;
+				if (bIsExec) bHasExecOutput = true;
+			}
+		}
+
+		LN.bIsEntryPoint = (!bHasExecInput && bHasExecOutput);
+		LN.bIsExecNode = (bHasExecInput || bHasExecOutput);
+		int32 PinRows = FMath::Max(InputPinCount, OutputPinCount);
+		LN.Width = 200;
+		LN.Height = FMath::Max(100, PinRows * 28 + 40);
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output) continue;
+			bool bIsExec = (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+				FString TargetId = LinkedPin->GetOwningNode()->GetName();
+				if (bIsExec)
+				{
+					LN.ExecOutputs.AddUnique(TargetId);
+				}
+				else
+				{
+					LN.DataOutputs.AddUnique(TargetId);
+				}
+			}
+		}
+		LayoutNodes.Add(LN);
+	}
+
+	// Collect existing positions for incremental mode
+	TMap<FString, FIntPoint> ExistingPositions;
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node && !Node->GetClass()->GetName().Contains(TEXT("Comment")))
+		{
+			ExistingPositions.Add(Node->GetName(), FIntPoint(Node->NodePosX, Node->NodePosY));
+		}
+	}
+
+	const double LayoutStart = FPlatformTime::Seconds();
+	FCortexLayoutResult LayoutResult = FCortexGraphLayoutOps::CalculateLayout(
+		LayoutNodes, Config, ExistingPositions);
+	OutLayoutSeconds += FPlatformTime::Seconds() - LayoutStart;
+
+	// Only nodes whose position actually changes are recorded in the transaction
+	int32 NodesMoved = 0;
+	for (const auto& Pair : LayoutResult.Positions)
+	{
+		UEdGraphNode** NodePtr = IdToNode.Find(Pair.Key);
+		if (NodePtr && *NodePtr
+			&& ((*NodePtr)->NodePosX != Pair.Value.X || (*NodePtr)->NodePosY != Pair.Value.Y))
+		{
+			(*NodePtr)->Modify();
+			(*NodePtr)->NodePosX = Pair.Value.X;
+			(*NodePtr)->NodePosY = Pair.Value.Y;
+			++NodesMoved;
+		}
+	}
+
+	OutNodesProcessed = LayoutResult.Positions.Num();
+	return NodesMoved;
 }
 
 FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObject>& Params)
@@ -1726,6 +1911,8 @@ FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObjec
 	UBlueprint* Blueprint = LoadBlueprint(AssetPath, LoadError);
 	if (!Blueprint) return LoadError;
 
+	const double StartTime = FPlatformTime::Seconds();
+
 	FString ModeStr;
 	Params->TryGetStringField(TEXT("mode"), ModeStr);
 	ECortexLayoutMode Mode = (ModeStr == TEXT("incremental"))
@@ -1787,6 +1974,8 @@ FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObjec
 	}
 
 	int32 TotalNodesProcessed = 0;
+	int32 TotalNodesMoved = 0;
+	double LayoutSeconds = 0.0;
 
 	TUniquePtr<FScopedTransaction> Transaction;
 	if (!FCortexCommandRouter::IsInBatch())
@@ -1797,93 +1986,14 @@ FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObjec
 
 	for (UEdGraph* Graph : Graphs)
 	{
-		TArray<FCortexLayoutNode> LayoutNodes;
-		TMap<FString, UEdGraphNode*> IdToNode;
+		int32 GraphNodesProcessed = 0;
+		const int32 GraphNodesMoved = LayoutGraph(Graph, Config, GraphNodesProcessed, LayoutSeconds);
 
-		for (UEdGraphNode* Node : Graph->Nodes)
+		TotalNodesProcessed += GraphNodesProcessed;
+		TotalNodesMoved += GraphNodesMoved;
+		if (GraphNodesMoved == 0)
 		{
-			if (!Node) continue;
-
-			// Skip comment nodes (class name contains "Comment")
-			if (Node->GetClass()->GetName() == TEXT("EdGraphNode_Comment"))
-			{
-				continue;
-			}
-
-			FCortexLayoutNode LN;
-			LN.Id = Node->GetName();
-			IdToNode.Add(LN.Id, Node);
-
-			bool bHasExecInput = false;
-			bool bHasExecOutput = false;
-			int32 InputPinCount = 0;
-			int32 OutputPinCount = 0;
-
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin) continue;
-				bool bIsExec = (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
-				if (Pin->Direction == EGPD_Input)
-				{
-					InputPinCount++;
-					if (bIsExec) bHasExecInput = true;
-				}
-				else
-				{
-					OutputPinCount++;
-					if (bIsExec) bHasExecOutput = true;
-				}
-			}
-
-			LN.bIsEntryPoint = (!bHasExecInput && bHasExecOutput);
-			LN.bIsExecNode = (bHasExecInput || bHasExecOutput);
-			int32 PinRows = FMath::Max(InputPinCount, OutputPinCount);
-			LN.Width = 200;
-			LN.Height = FMath::Max(100, PinRows * 28 + 40);
-
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin || Pin->Direction != EGPD_Output) continue;
-				bool bIsExec = (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-				{
-					if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
-					FString TargetId = LinkedPin->GetOwningNode()->GetName();
-					if (bIsExec)
-					{
-						LN.ExecOutputs.AddUnique(TargetId);
-					}
-					else
-					{
-						LN.DataOutputs.AddUnique(TargetId);
-					}
-				}
-			}
-			LayoutNodes.Add(LN);
-		}
-
-		// Collect existing positions for incremental mode
-		TMap<FString, FIntPoint> ExistingPositions;
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (Node && !Node->GetClass()->GetName().Contains(TEXT("Comment")))
-			{
-				ExistingPositions.Add(Node->GetName(), FIntPoint(Node->NodePosX, Node->NodePosY));
-			}
-		}
-
-		FCortexLayoutResult LayoutResult = FCortexGraphLayoutOps::CalculateLayout(
-			LayoutNodes, Config, ExistingPositions);
-
-		for (const auto& Pair : LayoutResult.Positions)
-		{
-			UEdGraphNode** NodePtr = IdToNode.Find(Pair.Key);
-			if (NodePtr && *NodePtr)
-			{
-				(*NodePtr)->Modify();
-				(*NodePtr)->NodePosX = Pair.Value.X;
-				(*NodePtr)->NodePosY = Pair.Value.Y;
-			}
+			continue;
 		}
 
 		if (FCortexCommandRouter::IsInBatch())
@@ -1899,11 +2009,17 @@ FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObjec
 		{
 			Graph->NotifyGraphChanged();
 		}
-
-		TotalNodesProcessed += LayoutResult.Positions.Num();
 	}
 
-	if (FCortexCommandRouter::IsInBatch())
+	if (TotalNodesMoved == 0)
+	{
+		// Nothing moved: leave no empty undo entry and keep the Blueprint clean
+		if (Transaction.IsValid())
+		{
+			Transaction->Cancel();
+		}
+	}
+	else if (FCortexCommandRouter::IsInBatch())
 	{
 		FString BPKey = FString::Printf(TEXT("blueprint.modified.%s"), *Blueprint->GetPathName());
 		FCortexBatchScope::AddCleanupAction(BPKey,
@@ -1919,15 +2035,22 @@ FCortexCommandResult FCortexGraphNodeOps::AutoLayout(const TSharedPtr<FJsonObjec
 	{
 		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 	}
-	Blueprint->MarkPackageDirty();
+	if (TotalNodesMoved > 0)
+	{
+		Blueprint->MarkPackageDirty();
+	}
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	Data->SetStringField(TEXT("mode"), Mode == ECortexLayoutMode::Incremental ? TEXT("incremental") : TEXT("full"));
 	Data->SetNumberField(TEXT("node_count"), TotalNodesProcessed);
+	Data->SetNumberField(TEXT("moved_count"), TotalNodesMoved);
 	Data->SetNumberField(TEXT("graphs_processed"), Graphs.Num());
+	Data->SetNumberField(TEXT("layout_ms"), LayoutSeconds * 1000.0);
+	Data->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 
-	UE_LOG(LogCortexGraph, Log, TEXT("Auto-layout completed: %d nodes across %d graphs in %s"),
-		TotalNodesProcessed, Graphs.Num(), *AssetPath);
+	UE_LOG(LogCortexGraph, Log, TEXT("Auto-layout completed: %d nodes (%d moved) across %d graphs in %s"),
+		TotalNodesProcessed, TotalNodesMoved, Graphs.Num(), *AssetPath);
 
 	return FCortexCommandRouter::Success(Data);
 }
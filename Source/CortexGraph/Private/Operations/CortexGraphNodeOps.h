@@ -7,6 +7,7 @@ class UBlueprint;
 class UEdGraph;
 class UEdGraphNode;
 class UEdGraphPin;
+struct FCortexLayoutConfig;
 
 enum class ECortexGraphKind : uint8
 {
@@ -45,6 +46,47 @@ public:
 	static UEdGraph* FindGraph(UBlueprint* Blueprint, const FString& GraphName, FCortexCommandResult& OutError);
 	static UEdGraphNode* FindNode(UEdGraph* Graph, const FString& NodeId, FCortexCommandResult& OutError);
 	static UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, FCortexCommandResult& OutError);
+
+	/**
+	 * Validate asset_path, load the Blueprint and resolve graph_name/subgraph_path to a mutable graph.
+	 * Shared by single-node and bulk editing commands.
+	 */
+	static bool ResolveMutableTargetGraph(
+		const TSharedPtr<FJsonObject>& Params,
+		const FString& AssetPath,
+		UBlueprint*& OutBlueprint,
+		UEdGraph*& OutGraph,
+		FCortexCommandResult& OutError);
+
+	/**
+	 * Resolve a node_class name for add_node. Spec is the node spec object; classes that need
+	 * creation params (Timeline, MacroInstance, delegates) validate its "params" here.
+	 */
+	static UClass* ResolveNodeClass(const FString& NodeClassName, const TSharedPtr<FJsonObject>& Spec, FCortexCommandResult& OutError);
+
+	/**
+	 * Create, configure and add a node from a spec ({position, params}).
+	 * Does not open a transaction, notify the graph or mark the Blueprint modified; callers do that once.
+	 */
+	static UEdGraphNode* CreateNode(
+		UBlueprint* Blueprint,
+		UEdGraph* Graph,
+		UClass* NodeClass,
+		const TSharedPtr<FJsonObject>& Spec,
+		FCortexCommandResult& OutError);
+
+	/** Set an unconnected input pin's default value. Caller owns transaction and notifications. */
+	static bool ApplyPinDefault(UEdGraphNode* Node, UEdGraphPin* Pin, const FString& Value, FCortexCommandResult& OutError);
+
+	/**
+	 * Lay out one graph and move the nodes whose position changed (Modify() on moved nodes only).
+	 * Returns the number of nodes moved. Caller owns transaction and notifications.
+	 */
+	static int32 LayoutGraph(
+		UEdGraph* Graph,
+		const FCortexLayoutConfig& Config,
+		int32& OutNodesProcessed,
+		double& OutLayoutSeconds);
 	/**
 	 * Serialize pin to JSON.
 	 * bDetailed: if true, includes is_connected and default_value fields.
@@ -1,6 +1,8 @@
 #include "Operations/CortexGraphTraceOps.h"
 
 #include "Operations/CortexGraphNodeOps.h"
+#include "CortexGraphLookupIndex.h"
+#include "CortexGraphTopology.h"
 #include "CortexCommandRouter.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
@@ -9,10 +11,6 @@
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraphSchema_K2.h"
 #include "Engine/Blueprint.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_Composite.h"
-#include "K2Node_CustomEvent.h"
-#include "K2Node_Event.h"
 
 namespace
 {
@@ -33,46 +31,6 @@ struct FCortexTraceOptions
 	bool bExecOnly = true;
 };
 
-void CollectGraphsRecursive(
-	UEdGraph* Graph,
-	const FString& CurrentSubgraphPath,
-	TArray<TPair<UEdGraph*, FString>>& OutGraphs,
-	int32 Depth)
-{
-	if (!Graph || Depth > 5)
-	{
-		return;
-	}
-
-	OutGraphs.Emplace(Graph, CurrentSubgraphPath);
-
-	for (UEdGraphNode* Node : Graph->Nodes)
-	{
-		const UK2Node_Composite* CompositeNode = Cast<UK2Node_Composite>(Node);
-		if (!CompositeNode || !CompositeNode->BoundGraph)
-		{
-			continue;
-		}
-
-		const FString ChildPath = CurrentSubgraphPath.IsEmpty()
-			? CompositeNode->BoundGraph->GetName()
-			: FString::Printf(TEXT("%s.%s"), *CurrentSubgraphPath, *CompositeNode->BoundGraph->GetName());
-		CollectGraphsRecursive(CompositeNode->BoundGraph, ChildPath, OutGraphs, Depth + 1);
-	}
-}
-
-void GetAllCandidateGraphs(
-	UBlueprint* Blueprint,
-	TArray<TPair<UEdGraph*, FString>>& OutGraphs)
-{
-	TArray<FCortexGraphEntry> Entries;
-	FCortexGraphNodeOps::EnumerateUserGraphs(Blueprint, Entries);
-	for (const FCortexGraphEntry& Entry : Entries)
-	{
-		CollectGraphsRecursive(Entry.Graph, TEXT(""), OutGraphs, 0);
-	}
-}
-
 bool TryResolveTraceOptions(const TSharedPtr<FJsonObject>& Params, FCortexTraceOptions& OutOptions)
 {
 	if (!Params.IsValid())
@@ -89,6 +47,7 @@ bool TryResolveTraceOptions(const TSharedPtr<FJsonObject>& Params, FCortexTraceO
 
 FCortexCommandResult ResolveGraphNode(
 	UBlueprint* Blueprint,
+	const FCortexGraphTopology& Topology,
 	const TSharedPtr<FJsonObject>& Params,
 	const FString& NodeId,
 	FCortexResolvedGraphNode& OutResolved)
@@ -131,22 +90,17 @@ FCortexCommandResult ResolveGraphNode(
 		return FCortexCommandRouter::Success(MakeShared<FJsonObject>());
 	}
 
-	TArray<TPair<UEdGraph*, FString>> CandidateGraphs;
-	GetAllCandidateGraphs(Blueprint, CandidateGraphs);
-
-	for (const TPair<UEdGraph*, FString>& Entry : CandidateGraphs)
+	// Topology graphs are user graphs followed by their composite subgraphs, depth-first
+	for (const FCortexGraphTopology::FGraphRecord& Record : Topology.GetGraphs())
 	{
-		UEdGraph* Graph = Entry.Key;
-		for (UEdGraphNode* Node : Graph->Nodes)
+		UEdGraph* Graph = Record.Graph.Get();
+		if (UEdGraphNode* Node = FCortexGraphLookupIndex::FindNode(Graph, NodeId))
 		{
-			if (Node && Node->GetName() == NodeId)
-			{
-				OutResolved.Graph = Graph;
-				OutResolved.Node = Node;
-				OutResolved.GraphName = Graph->GetName();
-				OutResolved.SubgraphPath = Entry.Value;
-				return FCortexCommandRouter::Success(MakeShared<FJsonObject>());
-			}
+			OutResolved.Graph = Graph;
+			OutResolved.Node = Node;
+			OutResolved.GraphName = Graph->GetName();
+			OutResolved.SubgraphPath = Record.SubgraphPath;
+			return FCortexCommandRouter::Success(MakeShared<FJsonObject>());
 		}
 	}
 
@@ -166,37 +120,141 @@ TSharedRef<FJsonObject> MakeEdgeJson(const UEdGraphNode* SourceNode, const UEdGr
 	return EdgeJson;
 }
 
-bool ShouldFollowPin(const UEdGraphPin* Pin, bool bExecOnly)
+void AddTraceResponseMetadata(TSharedRef<FJsonObject> NodeJson, const FString& GraphName, const FString& SubgraphPath)
 {
-	if (!Pin || Pin->Direction != EGPD_Output)
+	NodeJson->SetStringField(TEXT("graph_name"), GraphName);
+	if (!SubgraphPath.IsEmpty())
+	{
+		NodeJson->SetStringField(TEXT("subgraph_path"), SubgraphPath);
+	}
+}
+
+/** Append edge JSON for a cached edge; false when the pins no longer exist (node reconstructed). */
+bool AppendEdgeJson(
+	const UEdGraphNode* SourceNode,
+	const FCortexGraphTopology& Topology,
+	const FCortexGraphTopology::FEdge& Edge,
+	TArray<TSharedPtr<FJsonValue>>& OutEdges)
+{
+	const UEdGraphPin* SourcePin = FCortexGraphTopology::ResolvePin(SourceNode, Edge.SourcePin);
+	const UEdGraphPin* TargetPin = FCortexGraphTopology::ResolvePin(Topology.GetNode(Edge.Target), Edge.TargetPin);
+	if (!SourcePin || !TargetPin)
 	{
 		return false;
 	}
 
-	const bool bIsExecPin = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
-	return bExecOnly ? bIsExecPin : !bIsExecPin;
+	OutEdges.Add(MakeShared<FJsonValueObject>(MakeEdgeJson(SourceNode, SourcePin, TargetPin)));
+	return true;
 }
 
-void AddTraceResponseMetadata(TSharedRef<FJsonObject> NodeJson, const FString& GraphName, const FString& SubgraphPath)
+struct FCortexTraceOutput
 {
-	NodeJson->SetStringField(TEXT("graph_name"), GraphName);
-	if (!SubgraphPath.IsEmpty())
+	TArray<int32> NodeOrder;
+	TArray<TSharedPtr<FJsonValue>> Edges;
+	TArray<TSharedPtr<FJsonValue>> Cycles;
+};
+
+/** Breadth-first trace over the cached exec or data edges; Visited is sized to the topology. */
+void TraceFromRoot(
+	const FCortexGraphTopology& Topology,
+	int32 RootIndex,
+	const FCortexTraceOptions& Options,
+	TBitArray<>& Visited,
+	FCortexTraceOutput& Out)
+{
+	Visited.Init(false, Topology.NumNodes());
+
+	TArray<TPair<int32, int32>> Pending;
+	int32 PendingHead = 0;
+	Pending.Emplace(RootIndex, 0);
+	Visited[RootIndex] = true;
+
+	while (PendingHead < Pending.Num())
 	{
-		NodeJson->SetStringField(TEXT("subgraph_path"), SubgraphPath);
+		const int32 CurrentIndex = Pending[PendingHead].Key;
+		const int32 CurrentDepth = Pending[PendingHead].Value;
+		++PendingHead;
+
+		const UEdGraphNode* CurrentNode = Topology.GetNode(CurrentIndex);
+		if (!CurrentNode)
+		{
+			continue;
+		}
+		Out.NodeOrder.Add(CurrentIndex);
+
+		if (CurrentDepth >= Options.MaxDepth)
+		{
+			continue;
+		}
+
+		const TConstArrayView<FCortexGraphTopology::FEdge> Edges = Options.bExecOnly
+			? Topology.GetExecEdges(CurrentIndex)
+			: Topology.GetDataEdges(CurrentIndex);
+		for (const FCortexGraphTopology::FEdge& Edge : Edges)
+		{
+			if (Options.bIncludeEdges)
+			{
+				AppendEdgeJson(CurrentNode, Topology, Edge, Out.Edges);
+			}
+
+			if (Visited[Edge.Target])
+			{
+				const UEdGraphNode* TargetNode = Topology.GetNode(Edge.Target);
+				TSharedRef<FJsonObject> CycleJson = MakeShared<FJsonObject>();
+				CycleJson->SetStringField(TEXT("node_id"), CurrentNode->GetName());
+				CycleJson->SetStringField(TEXT("back_edge_to"), TargetNode ? TargetNode->GetName() : FString());
+				Out.Cycles.Add(MakeShared<FJsonValueObject>(CycleJson));
+				continue;
+			}
+
+			Visited[Edge.Target] = true;
+			Pending.Emplace(Edge.Target, CurrentDepth + 1);
+		}
 	}
 }
 
+TSharedPtr<FJsonValue> SerializeTraceNode(const FCortexGraphTopology& Topology, int32 NodeIndex)
+{
+	const UEdGraphNode* Node = Topology.GetNode(NodeIndex);
+	TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Node, true, true);
+	AddTraceResponseMetadata(NodeJson, Node->GetGraph()->GetName(), TEXT(""));
+	return MakeShared<FJsonValueObject>(NodeJson);
+}
+
 FCortexCommandResult RunTrace(const TSharedPtr<FJsonObject>& Params, bool bExecOnly)
 {
 	FString AssetPath;
-	FString StartNodeId;
 	if (!Params.IsValid() || !Params->TryGetStringField(TEXT("asset_path"), AssetPath))
 	{
 		return FCortexCommandRouter::Error(CortexErrorCodes::InvalidField, TEXT("Missing required param: asset_path"));
 	}
-	if (!Params->TryGetStringField(TEXT("start_node_id"), StartNodeId))
+
+	// start_node_ids traces several roots in one call; start_node_id keeps the single-root response
+	TArray<FString> StartNodeIds;
+	const TArray<TSharedPtr<FJsonValue>>* StartNodeIdArray = nullptr;
+	const bool bMultiRoot = Params->TryGetArrayField(TEXT("start_node_ids"), StartNodeIdArray);
+	if (bMultiRoot)
 	{
-		return FCortexCommandRouter::Error(CortexErrorCodes::InvalidField, TEXT("Missing required param: start_node_id"));
+		for (const TSharedPtr<FJsonValue>& Value : *StartNodeIdArray)
+		{
+			FString NodeId;
+			if (Value.IsValid() && Value->TryGetString(NodeId) && !NodeId.IsEmpty())
+			{
+				StartNodeIds.AddUnique(NodeId);
+			}
+		}
+	}
+	else
+	{
+		FString StartNodeId;
+		if (Params->TryGetStringField(TEXT("start_node_id"), StartNodeId))
+		{
+			StartNodeIds.Add(StartNodeId);
+		}
+	}
+	if (StartNodeIds.Num() == 0)
+	{
+		return FCortexCommandRouter::Error(CortexErrorCodes::InvalidField, TEXT("Missing required param: start_node_id or start_node_ids"));
 	}
 
 	FCortexTraceOptions Options;
@@ -210,86 +268,135 @@ FCortexCommandResult RunTrace(const TSharedPtr<FJsonObject>& Params, bool bExecO
 		return LoadError;
 	}
 
-	FCortexResolvedGraphNode Start;
-	FCortexCommandResult ResolveResult = ResolveGraphNode(Blueprint, Params, StartNodeId, Start);
-	if (!ResolveResult.bSuccess)
+	TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(Blueprint);
+
+	TArray<const UEdGraphNode*> StartNodes;
+	TArray<UEdGraph*> StartGraphs;
+	for (const FString& StartNodeId : StartNodeIds)
 	{
-		return ResolveResult;
+		FCortexResolvedGraphNode Start;
+		FCortexCommandResult ResolveResult = ResolveGraphNode(Blueprint, *Topology, Params, StartNodeId, Start);
+		if (!ResolveResult.bSuccess)
+		{
+			return ResolveResult;
+		}
+		StartNodes.Add(Start.Node);
+		StartGraphs.AddUnique(Start.Graph);
 	}
 
-	TArray<TSharedPtr<FJsonValue>> NodesArray;
-	TArray<TSharedPtr<FJsonValue>> EdgesArray;
-	TArray<TSharedPtr<FJsonValue>> CyclesArray;
-	TSet<FString> VisitedNodeIds;
-	TQueue<TPair<UEdGraphNode*, int32>> Pending;
-
-	Pending.Enqueue(TPair<UEdGraphNode*, int32>(Start.Node, 0));
-	VisitedNodeIds.Add(Start.Node->GetName());
-
-	while (!Pending.IsEmpty())
+	TArray<int32> RootIndices;
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
 	{
-		TPair<UEdGraphNode*, int32> Current;
-		Pending.Dequeue(Current);
-		UEdGraphNode* CurrentNode = Current.Key;
-		const int32 CurrentDepth = Current.Value;
-
-		TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(CurrentNode, true, true);
-		AddTraceResponseMetadata(NodeJson, CurrentNode->GetGraph()->GetName(), TEXT(""));
-		NodesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
-
-		if (CurrentDepth >= Options.MaxDepth)
+		RootIndices.Reset();
+		for (const UEdGraphNode* StartNode : StartNodes)
 		{
-			continue;
+			RootIndices.Add(Topology->FindNodeIndex(StartNode));
+		}
+		if (!RootIndices.Contains(INDEX_NONE) || Attempt > 0)
+		{
+			break;
 		}
 
-		for (UEdGraphPin* Pin : CurrentNode->Pins)
+		// Edited without a change notification: rebuild once
+		FCortexGraphTopology::Invalidate(Blueprint);
+		Topology = FCortexGraphTopology::Get(Blueprint);
+	}
+
+	if (RootIndices.Contains(INDEX_NONE))
+	{
+		// Start node lives in a graph the cached view does not cover: walk an uncached topology
+		// that adds the start graphs, rather than refusing the trace
+		Topology = FCortexGraphTopology::BuildUncached(Blueprint, StartGraphs);
+		for (int32 RootSlot = 0; RootSlot < StartNodes.Num(); ++RootSlot)
 		{
-			if (!ShouldFollowPin(Pin, bExecOnly))
+			RootIndices[RootSlot] = Topology->FindNodeIndex(StartNodes[RootSlot]);
+			if (RootIndices[RootSlot] == INDEX_NONE)
 			{
-				continue;
+				return FCortexCommandRouter::Error(
+					CortexErrorCodes::NodeNotFound,
+					FString::Printf(TEXT("Node is not in a traceable graph: %s"), *StartNodeIds[RootSlot])
+				);
 			}
+		}
+	}
 
-			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-			{
-				UEdGraphNode* NextNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
-				if (!NextNode)
-				{
-					continue;
-				}
+	TBitArray<> Visited;
+	if (!bMultiRoot)
+	{
+		FCortexTraceOutput Trace;
+		TraceFromRoot(*Topology, RootIndices[0], Options, Visited, Trace);
 
-				if (Options.bIncludeEdges)
-				{
-					EdgesArray.Add(MakeShared<FJsonValueObject>(MakeEdgeJson(CurrentNode, Pin, LinkedPin)));
-				}
+		TArray<TSharedPtr<FJsonValue>> NodesArray;
+		NodesArray.Reserve(Trace.NodeOrder.Num());
+		for (const int32 NodeIndex : Trace.NodeOrder)
+		{
+			NodesArray.Add(SerializeTraceNode(*Topology, NodeIndex));
+		}
 
-				if (VisitedNodeIds.Contains(NextNode->GetName()))
-				{
-					TSharedRef<FJsonObject> CycleJson = MakeShared<FJsonObject>();
-					CycleJson->SetStringField(TEXT("node_id"), CurrentNode->GetName());
-					CycleJson->SetStringField(TEXT("back_edge_to"), NextNode->GetName());
-					CyclesArray.Add(MakeShared<FJsonValueObject>(CycleJson));
-					continue;
-				}
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("asset_path"), AssetPath);
+		Data->SetStringField(TEXT("start_node_id"), StartNodeIds[0]);
+		Data->SetArrayField(TEXT("nodes"), NodesArray);
+		Data->SetNumberField(TEXT("node_count"), NodesArray.Num());
+		if (Options.bIncludeEdges)
+		{
+			Data->SetArrayField(TEXT("edges"), Trace.Edges);
+		}
+		if (Trace.Cycles.Num() > 0)
+		{
+			Data->SetArrayField(TEXT("cycles"), Trace.Cycles);
+		}
+		return FCortexCommandRouter::Success(Data);
+	}
+
+	// Multi-root: every reached node is serialized once; each trace lists node ids in visit order
+	TBitArray<> Serialized(false, Topology->NumNodes());
+	TArray<TSharedPtr<FJsonValue>> NodesArray;
+	TArray<TSharedPtr<FJsonValue>> TracesArray;
+	for (int32 RootSlot = 0; RootSlot < RootIndices.Num(); ++RootSlot)
+	{
+		FCortexTraceOutput Trace;
+		TraceFromRoot(*Topology, RootIndices[RootSlot], Options, Visited, Trace);
 
-				VisitedNodeIds.Add(NextNode->GetName());
-				Pending.Enqueue(TPair<UEdGraphNode*, int32>(NextNode, CurrentDepth + 1));
+		TArray<TSharedPtr<FJsonValue>> NodeIdsArray;
+		NodeIdsArray.Reserve(Trace.NodeOrder.Num());
+		for (const int32 NodeIndex : Trace.NodeOrder)
+		{
+			NodeIdsArray.Add(MakeShared<FJsonValueString>(Topology->GetNodes()[NodeIndex].Name.ToString()));
+			if (!Serialized[NodeIndex])
+			{
+				Serialized[NodeIndex] = true;
+				NodesArray.Add(SerializeTraceNode(*Topology, NodeIndex));
 			}
 		}
+
+		TSharedPtr<FJsonObject> TraceJson = MakeShared<FJsonObject>();
+		TraceJson->SetStringField(TEXT("start_node_id"), StartNodeIds[RootSlot]);
+		TraceJson->SetArrayField(TEXT("node_ids"), NodeIdsArray);
+		TraceJson->SetNumberField(TEXT("node_count"), NodeIdsArray.Num());
+		if (Options.bIncludeEdges)
+		{
+			TraceJson->SetArrayField(TEXT("edges"), Trace.Edges);
+		}
+		if (Trace.Cycles.Num() > 0)
+		{
+			TraceJson->SetArrayField(TEXT("cycles"), Trace.Cycles);
+		}
+		TracesArray.Add(MakeShared<FJsonValueObject>(TraceJson));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> StartIdsArray;
+	for (const FString& StartNodeId : StartNodeIds)
+	{
+		StartIdsArray.Add(MakeShared<FJsonValueString>(StartNodeId));
 	}
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
-	Data->SetStringField(TEXT("start_node_id"), StartNodeId);
+	Data->SetArrayField(TEXT("start_node_ids"), StartIdsArray);
 	Data->SetArrayField(TEXT("nodes"), NodesArray);
 	Data->SetNumberField(TEXT("node_count"), NodesArray.Num());
-	if (Options.bIncludeEdges)
-	{
-		Data->SetArrayField(TEXT("edges"), EdgesArray);
-	}
-	if (CyclesArray.Num() > 0)
-	{
-		Data->SetArrayField(TEXT("cycles"), CyclesArray);
-	}
+	Data->SetArrayField(TEXT("traces"), TracesArray);
 	return FCortexCommandRouter::Success(Data);
 }
 
@@ -302,20 +409,15 @@ bool DoesEventNameMatch(const UEdGraphNode* Node, const FString& EventName)
 		|| Node->GetName().Contains(EventName, ESearchCase::IgnoreCase);
 }
 
-bool IsSupportedEventHandlerNode(const UEdGraphNode* Node)
+/** Serialize an event/call node with the graph_name/subgraph_path of the graph it was indexed under. */
+TSharedRef<FJsonObject> SerializeIndexedNode(const FCortexGraphTopology& Topology, int32 NodeIndex)
 {
-	if (!Node)
-	{
-		return false;
-	}
-
-	if (Node->IsA<UK2Node_Event>() || Node->IsA<UK2Node_CustomEvent>())
-	{
-		return true;
-	}
-
-	const FString ClassName = Node->GetClass()->GetName();
-	return ClassName == TEXT("UK2Node_ActorBoundEvent") || ClassName == TEXT("UK2Node_ComponentBoundEvent");
+	const FCortexGraphTopology::FNodeRecord& Record = Topology.GetNodes()[NodeIndex];
+	const FCortexGraphTopology::FGraphRecord& GraphRecord = Topology.GetGraphs()[Record.GraphIndex];
+	TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Record.Node.Get(), true, true);
+	const UEdGraph* Graph = GraphRecord.Graph.Get();
+	AddTraceResponseMetadata(NodeJson, Graph ? Graph->GetName() : FString(), GraphRecord.SubgraphPath);
+	return NodeJson;
 }
 }
 
@@ -388,24 +490,53 @@ FCortexCommandResult FCortexGraphTraceOps::GetSubgraph(const TSharedPtr<FJsonObj
 		RequestedNodeIds.Add(SingleNodeId);
 	}
 
+	TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(Blueprint);
+	auto FindGraphRecord = [&Topology, Graph]() -> const FCortexGraphTopology::FGraphRecord*
+	{
+		return Topology->GetGraphs().FindByPredicate([Graph](const FCortexGraphTopology::FGraphRecord& Record)
+		{
+			return Record.Graph.Get() == Graph;
+		});
+	};
+	const FCortexGraphTopology::FGraphRecord* GraphRecord = FindGraphRecord();
+	if (!GraphRecord)
+	{
+		FCortexGraphTopology::Invalidate(Blueprint);
+		Topology = FCortexGraphTopology::Get(Blueprint);
+		GraphRecord = FindGraphRecord();
+	}
+	if (!GraphRecord)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::GraphNotFound,
+			FString::Printf(TEXT("Graph is not reachable from the Blueprint's user graphs: %s"), *Graph->GetName())
+		);
+	}
+
 	TArray<TSharedPtr<FJsonValue>> NodesArray;
 	TArray<TSharedPtr<FJsonValue>> EdgesArray;
-	TSet<FString> IncludedNodeIds;
+	TBitArray<> Included(false, Topology->NumNodes());
+	int32 IncludedCount = 0;
 
-	for (UEdGraphNode* Node : Graph->Nodes)
+	const int32 FirstNode = GraphRecord->FirstNode;
+	const int32 EndNode = FirstNode + GraphRecord->NumNodes;
+	for (int32 NodeIndex = FirstNode; NodeIndex < EndNode; ++NodeIndex)
 	{
-		if (!Node || (RequestedNodeIds.Num() > 0 && !RequestedNodeIds.Contains(Node->GetName())))
+		const FCortexGraphTopology::FNodeRecord& Record = Topology->GetNodes()[NodeIndex];
+		UEdGraphNode* Node = Record.Node.Get();
+		if (!Node || (RequestedNodeIds.Num() > 0 && !RequestedNodeIds.Contains(Record.Name.ToString())))
 		{
 			continue;
 		}
 
-		IncludedNodeIds.Add(Node->GetName());
+		Included[NodeIndex] = true;
+		++IncludedCount;
 		TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Node, true, bCompact);
 		AddTraceResponseMetadata(NodeJson, Graph->GetName(), SubgraphPath);
 		NodesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
 	}
 
-	if (RequestedNodeIds.Num() > 0 && IncludedNodeIds.Num() != RequestedNodeIds.Num())
+	if (RequestedNodeIds.Num() > 0 && IncludedCount != RequestedNodeIds.Num())
 	{
 		return FCortexCommandRouter::Error(
 			CortexErrorCodes::NodeNotFound,
@@ -424,35 +555,31 @@ FCortexCommandResult FCortexGraphTraceOps::GetSubgraph(const TSharedPtr<FJsonObj
 
 	if (bIncludeEdges)
 	{
-		for (UEdGraphNode* Node : Graph->Nodes)
+		for (int32 NodeIndex = FirstNode; NodeIndex < EndNode; ++NodeIndex)
 		{
-			if (!Node || !IncludedNodeIds.Contains(Node->GetName()))
+			if (!Included[NodeIndex])
 			{
 				continue;
 			}
 
-			for (UEdGraphPin* Pin : Node->Pins)
+			// Merge exec and data edges back into pin order
+			const UEdGraphNode* Node = Topology->GetNode(NodeIndex);
+			const TConstArrayView<FCortexGraphTopology::FEdge> ExecEdges = Topology->GetExecEdges(NodeIndex);
+			const TConstArrayView<FCortexGraphTopology::FEdge> DataEdges = Topology->GetDataEdges(NodeIndex);
+			int32 ExecCursor = 0;
+			int32 DataCursor = 0;
+			while (ExecCursor < ExecEdges.Num() || DataCursor < DataEdges.Num())
 			{
-				if (!Pin || Pin->Direction != EGPD_Output)
-				{
-					continue;
-				}
-
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				const bool bTakeExec = DataCursor >= DataEdges.Num()
+					|| (ExecCursor < ExecEdges.Num() && ExecEdges[ExecCursor].SourcePin < DataEdges[DataCursor].SourcePin);
+				const FCortexGraphTopology::FEdge& Edge = bTakeExec ? ExecEdges[ExecCursor++] : DataEdges[DataCursor++];
+				if (Included[Edge.Target])
 				{
-					if (!LinkedPin || !LinkedPin->GetOwningNode())
-					{
-						continue;
-					}
-					if (IncludedNodeIds.Contains(LinkedPin->GetOwningNode()->GetName()))
-					{
-						EdgesArray.Add(MakeShared<FJsonValueObject>(MakeEdgeJson(Node, Pin, LinkedPin)));
-					}
+					AppendEdgeJson(Node, *Topology, Edge, EdgesArray);
 				}
 			}
 		}
 	}
-
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
 	Data->SetStringField(TEXT("graph_name"), Graph->GetName());
@@ -484,22 +611,14 @@ FCortexCommandResult FCortexGraphTraceOps::ListEventHandlers(const TSharedPtr<FJ
 		return LoadError;
 	}
 
-	TArray<TPair<UEdGraph*, FString>> CandidateGraphs;
-	GetAllCandidateGraphs(Blueprint, CandidateGraphs);
+	const TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(Blueprint);
 
 	TArray<TSharedPtr<FJsonValue>> MatchesArray;
-	for (const TPair<UEdGraph*, FString>& Entry : CandidateGraphs)
+	for (const int32 NodeIndex : Topology->GetEventHandlers())
 	{
-		for (UEdGraphNode* Node : Entry.Key->Nodes)
+		if (Topology->GetNode(NodeIndex))
 		{
-			if (!IsSupportedEventHandlerNode(Node))
-			{
-				continue;
-			}
-
-			TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Node, true, true);
-			AddTraceResponseMetadata(NodeJson, Entry.Key->GetName(), Entry.Value);
-			MatchesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
+			MatchesArray.Add(MakeShared<FJsonValueObject>(SerializeIndexedNode(*Topology, NodeIndex)));
 		}
 	}
 
@@ -530,22 +649,15 @@ FCortexCommandResult FCortexGraphTraceOps::FindEventHandler(const TSharedPtr<FJs
 		return LoadError;
 	}
 
-	TArray<TPair<UEdGraph*, FString>> CandidateGraphs;
-	GetAllCandidateGraphs(Blueprint, CandidateGraphs);
+	const TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(Blueprint);
 
 	TArray<TSharedPtr<FJsonValue>> MatchesArray;
-	for (const TPair<UEdGraph*, FString>& Entry : CandidateGraphs)
+	for (const int32 NodeIndex : Topology->GetEventHandlers())
 	{
-		for (UEdGraphNode* Node : Entry.Key->Nodes)
+		const UEdGraphNode* Node = Topology->GetNode(NodeIndex);
+		if (Node && DoesEventNameMatch(Node, EventName))
 		{
-			if (!IsSupportedEventHandlerNode(Node) || !DoesEventNameMatch(Node, EventName))
-			{
-				continue;
-			}
-
-			TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Node, true, true);
-			AddTraceResponseMetadata(NodeJson, Entry.Key->GetName(), Entry.Value);
-			MatchesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
+			MatchesArray.Add(MakeShared<FJsonValueObject>(SerializeIndexedNode(*Topology, NodeIndex)));
 		}
 	}
 
@@ -577,40 +689,19 @@ FCortexCommandResult FCortexGraphTraceOps::FindFunctionCalls(const TSharedPtr<FJ
 		return LoadError;
 	}
 
-	TArray<TPair<UEdGraph*, FString>> CandidateGraphs;
-	GetAllCandidateGraphs(Blueprint, CandidateGraphs);
+	const TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(Blueprint);
 
 	TArray<TSharedPtr<FJsonValue>> MatchesArray;
-	for (const TPair<UEdGraph*, FString>& Entry : CandidateGraphs)
+	for (const FCortexGraphTopology::FCallRecord& Call : Topology->GetFunctionCalls())
 	{
-		for (UEdGraphNode* Node : Entry.Key->Nodes)
+		if (!Topology->GetNode(Call.NodeIndex) || !Call.FunctionName.Contains(FunctionName, ESearchCase::IgnoreCase))
 		{
-			const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
-			if (!CallNode)
-			{
-				continue;
-			}
-
-			FString CandidateName;
-			if (const UFunction* TargetFunction = CallNode->GetTargetFunction())
-			{
-				CandidateName = TargetFunction->GetName();
-			}
-			else
-			{
-				CandidateName = CallNode->FunctionReference.GetMemberName().ToString();
-			}
-
-			if (!CandidateName.Contains(FunctionName, ESearchCase::IgnoreCase))
-			{
-				continue;
-			}
-
-			TSharedRef<FJsonObject> NodeJson = FCortexGraphNodeOps::SerializeNode(Node, true, true);
-			NodeJson->SetStringField(TEXT("function_name"), CandidateName);
-			AddTraceResponseMetadata(NodeJson, Entry.Key->GetName(), Entry.Value);
-			MatchesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
+			continue;
 		}
+
+		TSharedRef<FJsonObject> NodeJson = SerializeIndexedNode(*Topology, Call.NodeIndex);
+		NodeJson->SetStringField(TEXT("function_name"), Call.FunctionName);
+		MatchesArray.Add(MakeShared<FJsonValueObject>(NodeJson));
 	}
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
@@ -0,0 +1,184 @@
+#include "Misc/AutomationTest.h"
+#include "CortexCommandRouter.h"
+#include "CortexGraphCommandHandler.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "GameFramework/Actor.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexGraphBulkOpsTest,
+	"Cortex.Graph.BulkOps",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexGraphBulkOpsTest::RunTest(const FString& Parameters)
+{
+	UPackage* TestPackage = CreatePackage(TEXT("/Game/Temp/CortexGraphBulkOpsTest"));
+	TestPackage->SetPackageFlags(PKG_PlayInEditor);
+	UBlueprint* TestBP = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(), TestPackage, TEXT("BP_GraphBulkOpsTest"),
+		BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass()
+	);
+	TestNotNull(TEXT("Blueprint created"), TestBP);
+	if (!TestBP) return false;
+
+	const FString AssetPath = TestBP->GetPathName();
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(TestBP);
+	if (!TestNotNull(TEXT("Event graph exists"), Graph)) return false;
+	const int32 InitialNodeCount = Graph->Nodes.Num();
+
+	FCortexCommandRouter Router;
+	Router.RegisterDomain(TEXT("graph"), TEXT("Cortex Graph"), TEXT("1.0.1"),
+		MakeShared<FCortexGraphCommandHandler>());
+
+	auto MakeCallSpec = [](const TCHAR* Id, const TCHAR* FunctionName)
+	{
+		TSharedPtr<FJsonObject> Spec = MakeShared<FJsonObject>();
+		Spec->SetStringField(TEXT("id"), Id);
+		Spec->SetStringField(TEXT("node_class"), TEXT("UK2Node_CallFunction"));
+		TSharedPtr<FJsonObject> NodeParams = MakeShared<FJsonObject>();
+		NodeParams->SetStringField(TEXT("function_name"), FunctionName);
+		Spec->SetObjectField(TEXT("params"), NodeParams);
+		return MakeShared<FJsonValueObject>(Spec);
+	};
+
+	auto MakeLink = [](const TCHAR* SourceNode, const TCHAR* SourcePin, const TCHAR* TargetNode, const TCHAR* TargetPin)
+	{
+		TSharedPtr<FJsonObject> Link = MakeShared<FJsonObject>();
+		Link->SetStringField(TEXT("source_node"), SourceNode);
+		Link->SetStringField(TEXT("source_pin"), SourcePin);
+		Link->SetStringField(TEXT("target_node"), TargetNode);
+		Link->SetStringField(TEXT("target_pin"), TargetPin);
+		return MakeShared<FJsonValueObject>(Link);
+	};
+
+	auto MakeDefault = [](const TCHAR* Node, const TCHAR* Pin, const TCHAR* Value)
+	{
+		TSharedPtr<FJsonObject> Default = MakeShared<FJsonObject>();
+		Default->SetStringField(TEXT("node"), Node);
+		Default->SetStringField(TEXT("pin"), Pin);
+		Default->SetStringField(TEXT("value"), Value);
+		return MakeShared<FJsonValueObject>(Default);
+	};
+
+	// Build Print -> Delay -> Print with defaults, referencing nodes by local id
+	TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+	Params->SetArrayField(TEXT("nodes"), {
+		MakeCallSpec(TEXT("first"), TEXT("KismetSystemLibrary.PrintString")),
+		MakeCallSpec(TEXT("wait"), TEXT("KismetSystemLibrary.Delay")),
+		MakeCallSpec(TEXT("second"), TEXT("KismetSystemLibrary.PrintString")),
+		MakeCallSpec(TEXT("broken"), TEXT("KismetSystemLibrary.NoSuchFunction")),
+	});
+	Params->SetArrayField(TEXT("links"), {
+		MakeLink(TEXT("first"), TEXT("then"), TEXT("wait"), TEXT("execute")),
+		MakeLink(TEXT("wait"), TEXT("then"), TEXT("second"), TEXT("execute")),
+		MakeLink(TEXT("broken"), TEXT("then"), TEXT("second"), TEXT("execute")),
+	});
+	Params->SetArrayField(TEXT("defaults"), {
+		MakeDefault(TEXT("first"), TEXT("InString"), TEXT("Hello")),
+		MakeDefault(TEXT("wait"), TEXT("Duration"), TEXT("2.5")),
+	});
+	Params->SetStringField(TEXT("layout"), TEXT("incremental"));
+
+	// Per-node AddNode and per-link schema calls would each broadcast; the request should notify once
+	int32 GraphNotifications = 0;
+	const FDelegateHandle NotifyHandle = Graph->AddOnGraphChangedHandler(
+		FOnGraphChanged::FDelegate::CreateLambda([&GraphNotifications](const FEdGraphEditAction&)
+		{
+			++GraphNotifications;
+		}));
+	FCortexCommandResult Result = Router.Execute(TEXT("graph.add_nodes"), Params);
+	Graph->RemoveOnGraphChangedHandler(NotifyHandle);
+	TestTrue(TEXT("add_nodes should succeed"), Result.bSuccess);
+	TestEqual(TEXT("Graph notified once for the whole request"), GraphNotifications, 1);
+	if (!Result.bSuccess || !Result.Data.IsValid()) return false;
+
+	TestEqual(TEXT("Three nodes added"), static_cast<int32>(Result.Data->GetNumberField(TEXT("added_count"))), 3);
+	TestEqual(TEXT("Two links connected"), static_cast<int32>(Result.Data->GetNumberField(TEXT("connected_count"))), 2);
+	TestEqual(TEXT("Two defaults set"), static_cast<int32>(Result.Data->GetNumberField(TEXT("defaults_set_count"))), 2);
+	TestEqual(TEXT("Bad node and its link reported"), static_cast<int32>(Result.Data->GetNumberField(TEXT("error_count"))), 2);
+	TestEqual(TEXT("Graph gained exactly three nodes"), Graph->Nodes.Num(), InitialNodeCount + 3);
+
+	const TSharedPtr<FJsonObject>* NodeIds = nullptr;
+	if (!TestTrue(TEXT("node_ids map returned"), Result.Data->TryGetObjectField(TEXT("node_ids"), NodeIds))) return false;
+	TestFalse(TEXT("Failed node has no id mapping"), (*NodeIds)->HasField(TEXT("broken")));
+
+	auto FindAdded = [Graph, NodeIds](const TCHAR* Symbol) -> UEdGraphNode*
+	{
+		FString NodeName;
+		(*NodeIds)->TryGetStringField(Symbol, NodeName);
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && Node->GetName() == NodeName) return Node;
+		}
+		return nullptr;
+	};
+
+	UEdGraphNode* First = FindAdded(TEXT("first"));
+	UEdGraphNode* Wait = FindAdded(TEXT("wait"));
+	UEdGraphNode* Second = FindAdded(TEXT("second"));
+	if (!TestNotNull(TEXT("first resolved"), First) || !TestNotNull(TEXT("wait resolved"), Wait)
+		|| !TestNotNull(TEXT("second resolved"), Second))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("first.then -> wait.execute"),
+		First->FindPin(TEXT("then"))->LinkedTo.Contains(Wait->FindPin(TEXT("execute"))));
+	TestTrue(TEXT("wait.then -> second.execute"),
+		Wait->FindPin(TEXT("then"))->LinkedTo.Contains(Second->FindPin(TEXT("execute"))));
+	TestEqual(TEXT("InString default"), First->FindPin(TEXT("InString"))->DefaultValue, FString(TEXT("Hello")));
+	TestEqual(TEXT("Duration default"), Wait->FindPin(TEXT("Duration"))->DefaultValue, FString(TEXT("2.5")));
+	TestTrue(TEXT("Layout placed the new nodes"),
+		First->NodePosX != 0 || First->NodePosY != 0 || Wait->NodePosX != 0 || Second->NodePosX != 0);
+
+	// connect_many against real node ids; the duplicate link fails without undoing the rest
+	{
+		TSharedPtr<FJsonObject> ConnectParams = MakeShared<FJsonObject>();
+		ConnectParams->SetStringField(TEXT("asset_path"), AssetPath);
+		ConnectParams->SetArrayField(TEXT("links"), {
+			MakeLink(*First->GetName(), TEXT("then"), *Wait->GetName(), TEXT("execute")),
+			MakeLink(*Second->GetName(), TEXT("then"), *First->GetName(), TEXT("execute")),
+		});
+
+		FCortexCommandResult ConnectResult = Router.Execute(TEXT("graph.connect_many"), ConnectParams);
+		TestTrue(TEXT("connect_many should succeed"), ConnectResult.bSuccess);
+		if (ConnectResult.bSuccess && ConnectResult.Data.IsValid())
+		{
+			TestEqual(TEXT("One new link"),
+				static_cast<int32>(ConnectResult.Data->GetNumberField(TEXT("connected_count"))), 1);
+			TestEqual(TEXT("Existing link reported"),
+				static_cast<int32>(ConnectResult.Data->GetNumberField(TEXT("error_count"))), 1);
+		}
+	}
+
+	// set_pin_defaults_many rejects connected pins per item
+	{
+		TSharedPtr<FJsonObject> DefaultsParams = MakeShared<FJsonObject>();
+		DefaultsParams->SetStringField(TEXT("asset_path"), AssetPath);
+		DefaultsParams->SetArrayField(TEXT("defaults"), {
+			MakeDefault(*Second->GetName(), TEXT("InString"), TEXT("Done")),
+			MakeDefault(*Wait->GetName(), TEXT("execute"), TEXT("x")),
+		});
+		DefaultsParams->SetBoolField(TEXT("stop_on_error"), true);
+
+		FCortexCommandResult DefaultsResult = Router.Execute(TEXT("graph.set_pin_defaults_many"), DefaultsParams);
+		TestTrue(TEXT("set_pin_defaults_many should succeed"), DefaultsResult.bSuccess);
+		if (DefaultsResult.bSuccess && DefaultsResult.Data.IsValid())
+		{
+			TestEqual(TEXT("One default set"),
+				static_cast<int32>(DefaultsResult.Data->GetNumberField(TEXT("defaults_set_count"))), 1);
+			TestTrue(TEXT("Stopped on the connected pin"), DefaultsResult.Data->GetBoolField(TEXT("stopped")));
+		}
+		TestEqual(TEXT("InString updated"), Second->FindPin(TEXT("InString"))->DefaultValue, FString(TEXT("Done")));
+	}
+
+	return true;
+}
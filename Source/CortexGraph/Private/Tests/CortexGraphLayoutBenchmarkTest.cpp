@@ -0,0 +1,115 @@
+#include "Misc/AutomationTest.h"
+#include "CortexGraphLayoutOps.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	/**
+	 * Build a deterministic Blueprint-shaped graph: several event chains with
+	 * branches that rejoin, each exec node fed by a short chain of pure data nodes.
+	 */
+	TArray<FCortexLayoutNode> BuildSyntheticLayoutGraph(int32 NodeCount)
+	{
+		FRandomStream Random(NodeCount);
+		TArray<FCortexLayoutNode> Nodes;
+		Nodes.Reserve(NodeCount);
+
+		TArray<int32> ChainTails;
+		while (Nodes.Num() < NodeCount)
+		{
+			const int32 Index = Nodes.Num();
+			FCortexLayoutNode& Node = Nodes.AddDefaulted_GetRef();
+			Node.Id = FString::Printf(TEXT("N%d"), Index);
+			Node.Width = 150 + Random.RandRange(0, 4) * 32;
+			Node.Height = 60 + Random.RandRange(0, 3) * 24;
+
+			const int32 Kind = Random.RandRange(0, 9);
+			if (ChainTails.Num() == 0 || Kind == 0)
+			{
+				// New event entry point
+				Node.bIsEntryPoint = true;
+				Node.bIsExecNode = true;
+				ChainTails.Add(Index);
+			}
+			else if (Kind <= 5)
+			{
+				// Exec node continuing a chain; occasionally rejoin a second chain
+				Node.bIsExecNode = true;
+				const int32 TailSlot = Random.RandRange(0, ChainTails.Num() - 1);
+				Nodes[ChainTails[TailSlot]].ExecOutputs.Add(Node.Id);
+				if (Kind == 5 && ChainTails.Num() > 1)
+				{
+					const int32 OtherSlot = (TailSlot + 1) % ChainTails.Num();
+					Nodes[ChainTails[OtherSlot]].ExecOutputs.Add(Node.Id);
+				}
+				ChainTails[TailSlot] = Index;
+			}
+			else
+			{
+				// Pure data node feeding an earlier node, so every referenced id exists
+				const int32 Consumer = FMath::Max(0, Index - Random.RandRange(1, 6));
+				Node.DataOutputs.Add(FString::Printf(TEXT("N%d"), Consumer));
+			}
+		}
+
+		return Nodes;
+	}
+
+	void RunLayoutBenchmark(FAutomationTestBase& Test, int32 NodeCount, double ThresholdMs)
+	{
+		const TArray<FCortexLayoutNode> Nodes = BuildSyntheticLayoutGraph(NodeCount);
+
+		FCortexLayoutConfig Config;
+		Config.Direction = ECortexLayoutDirection::LeftToRight;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const FCortexLayoutResult Result = FCortexGraphLayoutOps::CalculateLayout(Nodes, Config);
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Test.AddInfo(FString::Printf(
+			TEXT("Layout: %d nodes in %.1f ms (%d ordering sweeps, %lld crossings)"),
+			NodeCount, ElapsedMs, Result.OrderingSweeps, Result.EdgeCrossings));
+
+		Test.TestEqual(TEXT("Every node should be positioned"), Result.Positions.Num(), NodeCount);
+		Test.TestTrue(TEXT("Ordering should run at least the minimum sweeps"),
+			Result.OrderingSweeps >= CortexGraphLayout::MinOrderingSweeps);
+
+		// Generous threshold for CI; the string-keyed implementation was quadratic here
+		Test.TestTrue(FString::Printf(TEXT("Layout of %d nodes should finish under %.0f ms"), NodeCount, ThresholdMs),
+			ElapsedMs < ThresholdMs);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCortexGraphLayoutBenchmarkSmallTest,
+	"Cortex.Graph.Layout.Benchmark.Nodes500",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCortexGraphLayoutBenchmarkSmallTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	RunLayoutBenchmark(*this, 500, 1000.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCortexGraphLayoutBenchmarkMediumTest,
+	"Cortex.Graph.Layout.Benchmark.Nodes5000",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCortexGraphLayoutBenchmarkMediumTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	RunLayoutBenchmark(*this, 5000, 5000.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCortexGraphLayoutBenchmarkLargeTest,
+	"Cortex.Graph.Layout.Benchmark.Nodes20000",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCortexGraphLayoutBenchmarkLargeTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+	RunLayoutBenchmark(*this, 20000, 20000.0);
+	return true;
+}
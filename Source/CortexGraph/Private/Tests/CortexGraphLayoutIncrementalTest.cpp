@@ -0,0 +1,132 @@
+#include "Misc/AutomationTest.h"
+#include "CortexGraphLayoutOps.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexGraphLayoutIncrementalTest,
+	"Cortex.Graph.Layout.Incremental",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexGraphLayoutIncrementalTest::RunTest(const FString& Parameters)
+{
+	// Placed chain A -> B -> C with a new node N inserted after A, plus an isolated new node X
+	TArray<FCortexLayoutNode> Nodes;
+
+	auto AddNode = [&Nodes](const TCHAR* Id, TArray<FString> ExecOutputs, bool bEntry = false)
+	{
+		FCortexLayoutNode Node;
+		Node.Id = Id;
+		Node.Width = 150; Node.Height = 100;
+		Node.bIsEntryPoint = bEntry;
+		Node.bIsExecNode = true;
+		Node.ExecOutputs = MoveTemp(ExecOutputs);
+		Nodes.Add(Node);
+	};
+
+	AddNode(TEXT("A"), {TEXT("B"), TEXT("N")}, true);
+	AddNode(TEXT("B"), {TEXT("C")});
+	AddNode(TEXT("C"), {});
+	AddNode(TEXT("N"), {});
+	AddNode(TEXT("X"), {});
+
+	TMap<FString, FIntPoint> ExistingPositions;
+	ExistingPositions.Add(TEXT("A"), FIntPoint(0, 32));
+	ExistingPositions.Add(TEXT("B"), FIntPoint(240, 32));
+	ExistingPositions.Add(TEXT("C"), FIntPoint(480, 32));
+	ExistingPositions.Add(TEXT("N"), FIntPoint(0, 0));
+
+	FCortexLayoutConfig Config;
+	Config.Direction = ECortexLayoutDirection::LeftToRight;
+	Config.Mode = ECortexLayoutMode::Incremental;
+
+	FCortexLayoutResult Result = FCortexGraphLayoutOps::CalculateLayout(Nodes, Config, ExistingPositions);
+
+	// Only the new nodes are returned; placed nodes are pinned
+	TestEqual(TEXT("Only new nodes should be positioned"), Result.Positions.Num(), 2);
+	TestFalse(TEXT("A should stay pinned"), Result.Positions.Contains(TEXT("A")));
+	TestFalse(TEXT("B should stay pinned"), Result.Positions.Contains(TEXT("B")));
+	TestFalse(TEXT("C should stay pinned"), Result.Positions.Contains(TEXT("C")));
+	if (!TestTrue(TEXT("N should be positioned"), Result.Positions.Contains(TEXT("N")))
+		|| !TestTrue(TEXT("X should be positioned"), Result.Positions.Contains(TEXT("X"))))
+	{
+		return false;
+	}
+
+	// N is anchored right of its upstream neighbour A
+	const FIntPoint N = Result.Positions[TEXT("N")];
+	TestTrue(TEXT("N should be right of A"), N.X >= 0 + 150);
+
+	// Compaction keeps N clear of every pinned node
+	for (const auto& Pair : ExistingPositions)
+	{
+		if (Pair.Key == TEXT("N"))
+		{
+			continue;
+		}
+		const FIntRect Pinned(Pair.Value, Pair.Value + FIntPoint(150, 100));
+		const FIntRect Placed(N, N + FIntPoint(150, 100));
+		const bool bOverlaps = Pinned.Min.X < Placed.Max.X && Placed.Min.X < Pinned.Max.X
+			&& Pinned.Min.Y < Placed.Max.Y && Placed.Min.Y < Pinned.Max.Y;
+		TestFalse(FString::Printf(TEXT("N should not overlap %s"), *Pair.Key), bOverlaps);
+	}
+
+	// X has no placed neighbours and is stacked below the existing graph
+	TestTrue(TEXT("X should be below the pinned nodes"), Result.Positions[TEXT("X")].Y >= 32 + 100);
+
+	// Nothing new: nothing to move
+	ExistingPositions.Add(TEXT("N"), N);
+	ExistingPositions.Add(TEXT("X"), Result.Positions[TEXT("X")]);
+	FCortexLayoutResult NoopResult = FCortexGraphLayoutOps::CalculateLayout(Nodes, Config, ExistingPositions);
+	TestEqual(TEXT("No nodes should move when everything is placed"), NoopResult.Positions.Num(), 0);
+
+	// RightToLeft exec layouts put upstream nodes on the right, so N is anchored left of A
+	ExistingPositions.Reset();
+	ExistingPositions.Add(TEXT("A"), FIntPoint(480, 32));
+	ExistingPositions.Add(TEXT("B"), FIntPoint(240, 32));
+	ExistingPositions.Add(TEXT("C"), FIntPoint(0, 32));
+	ExistingPositions.Add(TEXT("X"), FIntPoint(0, 400));
+	Config.Direction = ECortexLayoutDirection::RightToLeft;
+	FCortexLayoutResult MirroredResult = FCortexGraphLayoutOps::CalculateLayout(Nodes, Config, ExistingPositions);
+	if (TestTrue(TEXT("N should be positioned in the mirrored layout"), MirroredResult.Positions.Contains(TEXT("N"))))
+	{
+		TestTrue(TEXT("N should be left of A when mirrored"), MirroredResult.Positions[TEXT("N")].X + 150 <= 480);
+	}
+
+	// A placed column taller than the compaction budget: N falls back below the graph instead of overlapping
+	TArray<FCortexLayoutNode> ColumnNodes;
+	TMap<FString, FIntPoint> ColumnPositions;
+	{
+		FCortexLayoutNode Root;
+		Root.Id = TEXT("Root");
+		Root.bIsEntryPoint = true;
+		Root.bIsExecNode = true;
+		Root.ExecOutputs.Add(TEXT("N"));
+		ColumnNodes.Add(Root);
+		ColumnPositions.Add(TEXT("Root"), FIntPoint(0, 16));
+
+		FCortexLayoutNode New;
+		New.Id = TEXT("N");
+		New.bIsExecNode = true;
+		ColumnNodes.Add(New);
+	}
+	const int32 ColumnCount = CortexGraphLayout::MaxCompactionSteps + 16;
+	for (int32 Index = 0; Index < ColumnCount; ++Index)
+	{
+		FCortexLayoutNode Blocker;
+		Blocker.Id = FString::Printf(TEXT("Blocker%d"), Index);
+		ColumnNodes.Add(Blocker);
+		ColumnPositions.Add(Blocker.Id, FIntPoint(240, 16 + Index * 128));
+	}
+
+	Config.Direction = ECortexLayoutDirection::LeftToRight;
+	FCortexLayoutResult ColumnResult = FCortexGraphLayoutOps::CalculateLayout(ColumnNodes, Config, ColumnPositions);
+	TestEqual(TEXT("Compaction should fall back once"), ColumnResult.CompactionFallbacks, 1);
+	TestEqual(TEXT("No overlap should remain"), ColumnResult.OverlappingNodes, 0);
+	if (TestTrue(TEXT("N should be positioned next to the column"), ColumnResult.Positions.Contains(TEXT("N"))))
+	{
+		TestTrue(TEXT("N should be below the column"),
+			ColumnResult.Positions[TEXT("N")].Y >= 16 + (ColumnCount - 1) * 128 + 100);
+	}
+
+	return true;
+}
@@ -0,0 +1,89 @@
+#include "Misc/AutomationTest.h"
+#include "CortexGraphLookupIndex.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexGraphLookupIndexTest,
+	"Cortex.Graph.LookupIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexGraphLookupIndexTest::RunTest(const FString& Parameters)
+{
+	UPackage* TestPackage = CreatePackage(TEXT("/Game/Temp/CortexGraphLookupIndexTest"));
+	TestPackage->SetPackageFlags(PKG_PlayInEditor);
+	UBlueprint* TestBP = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(), TestPackage, TEXT("BP_GraphLookupIndexTest"),
+		BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass()
+	);
+	TestNotNull(TEXT("Blueprint created"), TestBP);
+	if (!TestBP) return false;
+
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(TestBP);
+	TestNotNull(TEXT("Event graph exists"), Graph);
+	if (!Graph) return false;
+
+	auto AddPrintNode = [Graph]()
+	{
+		UK2Node_CallFunction* Node = NewObject<UK2Node_CallFunction>(Graph);
+		Node->FunctionReference.SetExternalMember(
+			GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString), UKismetSystemLibrary::StaticClass());
+		Graph->AddNode(Node, false, false);
+		Node->CreateNewGuid();
+		Node->AllocateDefaultPins();
+		return Node;
+	};
+
+	// Warm the index, then add a node: the graph change must be visible to the next lookup
+	UK2Node_CallFunction* First = AddPrintNode();
+	TestTrue(TEXT("Finds first node by name"),
+		FCortexGraphLookupIndex::FindNode(Graph, First->GetName()) == First);
+
+	UK2Node_CallFunction* Second = AddPrintNode();
+	TestTrue(TEXT("Finds node added after the index was built"),
+		FCortexGraphLookupIndex::FindNode(Graph, Second->GetName()) == Second);
+	TestTrue(TEXT("Finds node by GUID"),
+		FCortexGraphLookupIndex::FindNode(Graph, Second->NodeGuid.ToString()) == Second);
+	TestNull(TEXT("Unknown node is not found"),
+		FCortexGraphLookupIndex::FindNode(Graph, TEXT("K2Node_DoesNotExist")));
+
+	// Pins resolve by name, case-insensitively like FName
+	UEdGraphPin* ExecPin = FCortexGraphLookupIndex::FindPin(First, UEdGraphSchema_K2::PN_Execute.ToString());
+	TestNotNull(TEXT("Finds exec pin"), ExecPin);
+	TestTrue(TEXT("Pin lookup ignores case"),
+		FCortexGraphLookupIndex::FindPin(First, TEXT("INSTRING")) == First->FindPin(TEXT("InString")));
+	TestNull(TEXT("Unknown pin is not found"), FCortexGraphLookupIndex::FindPin(First, TEXT("NoSuchPin")));
+
+	// Pins recreated on reconstruction must not return the old pin objects
+	First->ReconstructNode();
+	TestTrue(TEXT("Pin lookup follows reconstruction"),
+		FCortexGraphLookupIndex::FindPin(First, TEXT("InString")) == First->FindPin(TEXT("InString")));
+
+	// Removed nodes drop out of the index
+	const FString SecondName = Second->GetName();
+	Graph->RemoveNode(Second);
+	TestNull(TEXT("Removed node is not found"), FCortexGraphLookupIndex::FindNode(Graph, SecondName));
+
+	// A node swapped out without any graph notification keeps the count stamp and stays alive
+	// until GC; the cached slot must still reject it
+	UK2Node_CallFunction* Third = AddPrintNode();
+	const FString ThirdName = Third->GetName();
+	TestTrue(TEXT("Finds third node"), FCortexGraphLookupIndex::FindNode(Graph, ThirdName) == Third);
+	UK2Node_CallFunction* Replacement = NewObject<UK2Node_CallFunction>(Graph);
+	Graph->Nodes[Graph->Nodes.IndexOfByKey(Third)] = Replacement;
+	TestTrue(TEXT("Detached node is still alive"), IsValid(Third));
+	TestNull(TEXT("Detached node is not found"), FCortexGraphLookupIndex::FindNode(Graph, ThirdName));
+	TestNull(TEXT("Detached node is not found by GUID"),
+		FCortexGraphLookupIndex::FindNode(Graph, Third->NodeGuid.ToString()));
+	TestTrue(TEXT("Replacement is found"),
+		FCortexGraphLookupIndex::FindNode(Graph, Replacement->GetName()) == Replacement);
+
+	return true;
+}
@@ -0,0 +1,161 @@
+#include "Misc/AutomationTest.h"
+#include "CortexCommandRouter.h"
+#include "CortexGraphCommandHandler.h"
+#include "CortexGraphTopology.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "GameFramework/Actor.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexGraphTopologyTest,
+	"Cortex.Graph.Topology",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexGraphTopologyTest::RunTest(const FString& Parameters)
+{
+	UPackage* TestPackage = CreatePackage(TEXT("/Game/Temp/CortexGraphTopologyTest"));
+	TestPackage->SetPackageFlags(PKG_PlayInEditor);
+	UBlueprint* TestBP = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(), TestPackage, TEXT("BP_GraphTopologyTest"),
+		BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass()
+	);
+	TestNotNull(TEXT("Blueprint created"), TestBP);
+	if (!TestBP) return false;
+
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(TestBP);
+	if (!TestNotNull(TEXT("Event graph exists"), Graph)) return false;
+
+	auto AddPrint = [Graph](int32 X)
+	{
+		UK2Node_CallFunction* Node = NewObject<UK2Node_CallFunction>(Graph);
+		Node->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(TEXT("PrintString")));
+		Node->CreateNewGuid();
+		Node->NodePosX = X;
+		Graph->AddNode(Node, false, false);
+		Node->AllocateDefaultPins();
+		return Node;
+	};
+
+	UK2Node_CallFunction* First = AddPrint(0);
+	UK2Node_CallFunction* Second = AddPrint(300);
+	UK2Node_CallFunction* Third = AddPrint(600);
+
+	// Unchanged Blueprint reuses the cached topology
+	TSharedRef<const FCortexGraphTopology> Topology = FCortexGraphTopology::Get(TestBP);
+	TestTrue(TEXT("Cached topology reused"), &FCortexGraphTopology::Get(TestBP).Get() == &Topology.Get());
+	TestTrue(TEXT("All event graph nodes indexed"), Topology->NumNodes() >= Graph->Nodes.Num());
+	TestTrue(TEXT("Default event nodes collected as handlers"), Topology->GetEventHandlers().Num() > 0);
+	TestEqual(TEXT("Call nodes collected"), Topology->GetFunctionCalls().Num(), 3);
+
+	const int32 FirstIndex = Topology->FindNodeIndex(First);
+	if (!TestNotEqual(TEXT("First node indexed"), FirstIndex, static_cast<int32>(INDEX_NONE))) return false;
+	TestEqual(TEXT("No exec edges before linking"), Topology->GetExecEdges(FirstIndex).Num(), 0);
+
+	// Linking Modify()s both nodes, so the next Get rebuilds
+	First->FindPin(TEXT("then"))->MakeLinkTo(Second->FindPin(TEXT("execute")));
+	First->FindPin(TEXT("then"))->MakeLinkTo(Third->FindPin(TEXT("execute")));
+	TSharedRef<const FCortexGraphTopology> Rebuilt = FCortexGraphTopology::Get(TestBP);
+	TestTrue(TEXT("Topology rebuilt after link change"), &Rebuilt.Get() != &Topology.Get());
+
+	const int32 RebuiltFirst = Rebuilt->FindNodeIndex(First);
+	const TConstArrayView<FCortexGraphTopology::FEdge> ExecEdges = Rebuilt->GetExecEdges(RebuiltFirst);
+	TestEqual(TEXT("Two exec edges out of first"), ExecEdges.Num(), 2);
+	if (ExecEdges.Num() == 2)
+	{
+		TestTrue(TEXT("Edge targets second"), Rebuilt->GetNode(ExecEdges[0].Target) == Second);
+		TestTrue(TEXT("Edge targets third"), Rebuilt->GetNode(ExecEdges[1].Target) == Third);
+		TestTrue(TEXT("Edge pins resolve"),
+			FCortexGraphTopology::ResolvePin(Third, ExecEdges[1].TargetPin) == Third->FindPin(TEXT("execute")));
+	}
+	TestEqual(TEXT("Data edges kept separate"), Rebuilt->GetDataEdges(RebuiltFirst).Num(), 0);
+
+	// Multi-root trace: shared nodes are serialized once, each root keeps its own node list
+	FCortexCommandRouter Router;
+	Router.RegisterDomain(TEXT("graph"), TEXT("Cortex Graph"), TEXT("1.0.1"),
+		MakeShared<FCortexGraphCommandHandler>());
+
+	TSharedPtr<FJsonObject> TraceParams = MakeShared<FJsonObject>();
+	TraceParams->SetStringField(TEXT("asset_path"), TestBP->GetPathName());
+	TraceParams->SetArrayField(TEXT("start_node_ids"), {
+		MakeShared<FJsonValueString>(First->GetName()),
+		MakeShared<FJsonValueString>(Second->GetName()),
+	});
+
+	const FCortexCommandResult TraceResult = Router.Execute(TEXT("graph.trace_exec"), TraceParams);
+	TestTrue(TEXT("Multi-root trace_exec succeeds"), TraceResult.bSuccess);
+	if (TraceResult.bSuccess && TraceResult.Data.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Traces = nullptr;
+		if (TestTrue(TEXT("traces returned"), TraceResult.Data->TryGetArrayField(TEXT("traces"), Traces)))
+		{
+			TestEqual(TEXT("One trace per root"), Traces->Num(), 2);
+			if (Traces->Num() == 2)
+			{
+				TestEqual(TEXT("First root reaches three nodes"),
+					static_cast<int32>((*Traces)[0]->AsObject()->GetNumberField(TEXT("node_count"))), 3);
+				TestEqual(TEXT("Second root reaches itself"),
+					static_cast<int32>((*Traces)[1]->AsObject()->GetNumberField(TEXT("node_count"))), 1);
+			}
+		}
+		TestEqual(TEXT("Union serializes each node once"),
+			static_cast<int32>(TraceResult.Data->GetNumberField(TEXT("node_count"))), 3);
+	}
+
+	// Nodes in a nested graph that is not a collapsed composite are still traceable
+	UEdGraph* Nested = FBlueprintEditorUtils::CreateNewGraph(
+		TestBP, TEXT("NestedTraceGraph"), UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	Graph->SubGraphs.Add(Nested);
+	auto AddNestedPrint = [Nested](int32 X)
+	{
+		UK2Node_CallFunction* Node = NewObject<UK2Node_CallFunction>(Nested);
+		Node->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(TEXT("PrintString")));
+		Node->CreateNewGuid();
+		Node->NodePosX = X;
+		Nested->AddNode(Node, false, false);
+		Node->AllocateDefaultPins();
+		return Node;
+	};
+	UK2Node_CallFunction* NestedFirst = AddNestedPrint(0);
+	UK2Node_CallFunction* NestedSecond = AddNestedPrint(300);
+	NestedFirst->FindPin(TEXT("then"))->MakeLinkTo(NestedSecond->FindPin(TEXT("execute")));
+
+	TestNotEqual(TEXT("Nested graph nodes indexed"),
+		FCortexGraphTopology::Get(TestBP)->FindNodeIndex(NestedFirst), static_cast<int32>(INDEX_NONE));
+
+	TSharedPtr<FJsonObject> NestedParams = MakeShared<FJsonObject>();
+	NestedParams->SetStringField(TEXT("asset_path"), TestBP->GetPathName());
+	NestedParams->SetStringField(TEXT("start_node_id"), NestedFirst->GetName());
+	const FCortexCommandResult NestedResult = Router.Execute(TEXT("graph.trace_exec"), NestedParams);
+	TestTrue(TEXT("trace_exec from a nested graph succeeds"), NestedResult.bSuccess);
+	if (NestedResult.bSuccess && NestedResult.Data.IsValid())
+	{
+		TestEqual(TEXT("Nested trace follows the link"),
+			static_cast<int32>(NestedResult.Data->GetNumberField(TEXT("node_count"))), 2);
+	}
+
+	// A graph no user graph reaches is only covered by the uncached topology
+	Graph->SubGraphs.Remove(Nested);
+	FCortexGraphTopology::Invalidate(TestBP);
+	TSharedRef<const FCortexGraphTopology> Cached = FCortexGraphTopology::Get(TestBP);
+	TestEqual(TEXT("Detached graph not in the cached view"),
+		Cached->FindNodeIndex(NestedFirst), static_cast<int32>(INDEX_NONE));
+	TSharedRef<const FCortexGraphTopology> Uncached = FCortexGraphTopology::BuildUncached(TestBP, TArray<UEdGraph*>{ Nested });
+	const int32 DetachedIndex = Uncached->FindNodeIndex(NestedFirst);
+	if (TestNotEqual(TEXT("Uncached topology indexes the detached graph"), DetachedIndex, static_cast<int32>(INDEX_NONE)))
+	{
+		TestEqual(TEXT("Detached graph edges built"), Uncached->GetExecEdges(DetachedIndex).Num(), 1);
+	}
+	TestTrue(TEXT("Uncached topology is not cached"), &FCortexGraphTopology::Get(TestBP).Get() == &Cached.Get());
+
+	TestBP->MarkAsGarbage();
+	return true;
+}
@@ -13,7 +13,7 @@ enum class ECortexLayoutDirection : uint8
 enum class ECortexLayoutMode : uint8
 {
 	Full,          // Reposition all nodes
-	Incremental    // Only position new nodes (NodePosX==0 && NodePosY==0)
+	Incremental    // Pin placed nodes; lay out only new nodes (NodePosX==0 && NodePosY==0) beside their neighbours
 };
 
 /** Abstract node for layout calculation — domain-agnostic */
@@ -26,6 +26,7 @@ struct FCortexLayoutNode
 	TArray<FString> DataOutputs;   // IDs of nodes connected via data pins
 	bool bIsEntryPoint = false;    // Event nodes, MaterialResult inputs, etc.
 	bool bIsExecNode = false;      // Participates in execution flow (has exec pins)
+	bool bIsPinned = false;        // Incremental: keep at ExistingPositions even when that is (0,0)
 };
 
 /** Layout configuration */
@@ -42,6 +43,10 @@ struct FCortexLayoutResult
 {
 	TMap<FString, FIntPoint> Positions;  // NodeId -> (X, Y)
 	TMap<FString, int32> LayerAssignment;  // NodeId -> layer index
+	int32 OrderingSweeps = 0;  // Barycenter sweeps run across all subgraphs
+	int64 EdgeCrossings = 0;   // Remaining crossings between adjacent layers after ordering
+	int32 CompactionFallbacks = 0;  // Incremental: components moved below the graph after compaction gave up
+	int32 OverlappingNodes = 0;     // Incremental: new nodes still overlapping another node
 };
 
 namespace CortexGraphLayout
@@ -49,9 +54,17 @@ namespace CortexGraphLayout
 	constexpr float InnerGroupHorizontalSpacingRatio = 0.3f;
 	constexpr float InnerGroupVerticalSpacingRatio = 0.5f;
 	constexpr int32 GridSnapSize = 16;
+	constexpr int32 MinOrderingSweeps = 2;
+	constexpr int32 MaxOrderingSweeps = 24;
+	constexpr int32 MaxCompactionSteps = 64;
+	constexpr int32 OccupancyCellSize = 512;
 }
 
-/** Shared layout engine — domain modules convert their nodes to/from this format */
+/**
+ * Shared layout engine — domain modules convert their nodes to/from this format.
+ * String IDs are only used at the CalculateLayout boundary; every internal pass
+ * works on dense node indices with CSR adjacency.
+ */
 class CORTEXGRAPH_API FCortexGraphLayoutOps
 {
 public:
@@ -59,8 +72,8 @@ public:
 	 * Calculate positions for all nodes in the graph.
 	 * @param Nodes - Abstract node representations with connectivity
 	 * @param Config - Layout configuration (spacing, direction, mode)
-	 * @param ExistingPositions - Current positions (used by Incremental mode to skip placed nodes)
-	 * @return Map of NodeId -> (X, Y) positions
+	 * @param ExistingPositions - Current positions (used by Incremental mode to pin placed nodes)
+	 * @return Map of NodeId -> (X, Y) positions. Incremental mode only returns the new nodes.
 	 */
 	static FCortexLayoutResult CalculateLayout(
 		const TArray<FCortexLayoutNode>& Nodes,
@@ -69,66 +82,116 @@ public:
 	);
 
 private:
-	/** Assign each node to a layer (column) based on connectivity */
-	static TMap<FString, int32> AssignLayers(
-		const TArray<FCortexLayoutNode>& Nodes,
-		ECortexLayoutDirection Direction
+	/** Dense index view of a layout graph with CSR edge lists (defined in the .cpp) */
+	struct FIndexedGraph;
+
+	/** Parameter group: an exec node plus the pure data tree it claims (defined in the .cpp) */
+	struct FNodeGroup;
+
+	/** Full Sugiyama pipeline over every node */
+	static FCortexLayoutResult CalculateFullLayout(
+		const FIndexedGraph& Graph,
+		const TArray<FString>& Ids,
+		const FCortexLayoutConfig& Config
 	);
 
-	/** Order nodes within each layer to minimize edge crossings (barycenter heuristic) */
-	static TMap<int32, TArray<FString>> OrderNodesInLayers(
-		const TMap<FString, int32>& LayerAssignment,
-		const TArray<FCortexLayoutNode>& Nodes
+	/**
+	 * Lay out only unplaced nodes. Each connected component of new nodes is layered on
+	 * its own, anchored beside its placed neighbours (mirrored when RightToLeft inverts
+	 * exec layers), then pushed down past any overlap with a bounded number of compaction
+	 * steps. A component that still overlaps is moved below everything placed so far.
+	 * Placed nodes never move.
+	 */
+	static FCortexLayoutResult CalculateIncrementalLayout(
+		const FIndexedGraph& Graph,
+		const TArray<FString>& Ids,
+		const FCortexLayoutConfig& Config,
+		const TMap<FString, FIntPoint>& ExistingPositions
 	);
 
-	/** Calculate final X,Y positions using node dimensions and spacing */
-	static FCortexLayoutResult CalculatePositions(
-		const TMap<int32, TArray<FString>>& OrderedLayers,
+	/** Build the index view of the caller's nodes; unknown edge targets become phantom nodes */
+	static void BuildIndexedGraph(
 		const TArray<FCortexLayoutNode>& Nodes,
-		const FCortexLayoutConfig& Config
+		FIndexedGraph& OutGraph,
+		TArray<FString>& OutIds
 	);
 
-	/** Find connected subgraphs for independent layout */
-	static TArray<TArray<FString>> FindSubgraphs(const TArray<FCortexLayoutNode>& Nodes);
+	/** Assign each node to a layer (column) based on connectivity. INDEX_NONE = unassigned */
+	static void AssignLayers(
+		const FIndexedGraph& Graph,
+		ECortexLayoutDirection Direction,
+		TArray<int32>& OutLayers
+	);
+
+	/**
+	 * Order nodes within each layer to minimize edge crossings (barycenter heuristic).
+	 * Sweeps alternate direction and stop once crossings stop improving.
+	 */
+	static TArray<TArray<int32>> OrderNodesInLayers(
+		const FIndexedGraph& Graph,
+		const TArray<int32>& Layers,
+		int32& OutSweeps,
+		int64& OutCrossings
+	);
+
+	/** Count edge crossings between adjacent layers for the given ordering */
+	static int64 CountCrossings(
+		const FIndexedGraph& Graph,
+		const TArray<TArray<int32>>& OrderedLayers,
+		const TArray<int32>& Layers
+	);
 
-	/** Internal group representation for parameter group collapsing */
-	struct FCortexNodeGroup
-	{
-		FString ExecNodeId;
-		TArray<FString> DataNodeIds;
-	};
+	/** Calculate X,Y positions for layered nodes using node dimensions and spacing */
+	static void CalculatePositions(
+		const FIndexedGraph& Graph,
+		const TArray<TArray<int32>>& OrderedLayers,
+		const FCortexLayoutConfig& Config,
+		TArray<FIntPoint>& OutPositions
+	);
+
+	/** Find connected subgraphs for independent layout */
+	static TArray<TArray<int32>> FindSubgraphs(const FIndexedGraph& Graph);
 
 	/** Discover parameter groups: BFS backward from exec nodes to claim pure data trees */
-	static TArray<FCortexNodeGroup> DiscoverGroups(
-		const TArray<FCortexLayoutNode>& Nodes,
-		const TMap<FString, const FCortexLayoutNode*>& NodeMap,
-		TMap<FString, int32>& OutNodeToGroupIndex
+	static void DiscoverGroups(
+		const FIndexedGraph& Graph,
+		TArray<FNodeGroup>& OutGroups,
+		TArray<int32>& OutNodeToGroup
 	);
 
-	/** Build proxy nodes for top-level Sugiyama (one proxy per group + ungrouped nodes) */
-	static TArray<FCortexLayoutNode> BuildGroupProxyNodes(
-		const TArray<FCortexLayoutNode>& OriginalNodes,
-		const TArray<FCortexNodeGroup>& Groups,
-		const TMap<FString, int32>& NodeToGroupIndex,
-		const TMap<FString, const FCortexLayoutNode*>& NodeMap,
-		const FCortexLayoutConfig& Config
+	/** Build the top-level graph for Sugiyama (one proxy per group + ungrouped nodes) */
+	static void BuildGroupProxyGraph(
+		const FIndexedGraph& Graph,
+		const TArray<FNodeGroup>& Groups,
+		const TArray<int32>& NodeToGroup,
+		const FCortexLayoutConfig& Config,
+		FIndexedGraph& OutProxyGraph
+	);
+
+	/** Extract one connected subgraph of the proxy graph as its own index space */
+	static void BuildSubgraph(
+		const FIndexedGraph& Graph,
+		const TArray<int32>& Members,
+		TArray<int32>& ScratchParentToLocal,
+		FIndexedGraph& OutSubgraph
 	);
 
 	/** Expand group proxy positions into individual node positions */
 	static void ExpandGroupPositions(
-		const TArray<FCortexNodeGroup>& Groups,
-		const TMap<FString, int32>& NodeToGroupIndex,
-		const TMap<FString, const FCortexLayoutNode*>& NodeMap,
+		const FIndexedGraph& Graph,
+		const TArray<FNodeGroup>& Groups,
 		const FCortexLayoutConfig& Config,
-		FCortexLayoutResult& InOutResult
+		TArray<FIntPoint>& InOutPositions,
+		TArray<bool>& InOutPositioned
 	);
 
 	/** Refine Y positions using iterative median centering to minimize wire length */
 	static void RefineYPositions(
-		const TArray<FCortexLayoutNode>& Nodes,
-		const TMap<FString, int32>& NodeToGroupIndex,
-		const TArray<TArray<FString>>& Subgraphs,
+		const FIndexedGraph& ProxyGraph,
+		const TArray<TArray<int32>>& Subgraphs,
+		const TArray<int32>& Layers,
 		const FCortexLayoutConfig& Config,
-		FCortexLayoutResult& InOutResult
+		TArray<FIntPoint>& InOutPositions,
+		const TArray<bool>& Positioned
 	);
 };
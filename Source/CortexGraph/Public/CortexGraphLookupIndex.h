@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+
+/**
+ * Lazily built name lookup shared by editor-node operations.
+ * One entry per owner (UEdGraph, UMaterial, ...) maps node name and GUID to the node's
+ * slot in the owner's collection; per-node entries map pin name to pin slot. Graph entries
+ * are invalidated by OnGraphChanged; every entry also rebuilds when its node/pin count
+ * changes or a cached slot no longer holds a live object with that name, so removed
+ * (but not yet collected) objects are never returned.
+ * Game thread only.
+ */
+class CORTEXGRAPH_API FCortexGraphLookupIndex
+{
+public:
+	/** Find a graph node by object name, falling back to its NodeGuid string. */
+	static UEdGraphNode* FindNode(UEdGraph* Graph, const FString& NodeId);
+
+	/** Find a pin by name (case-insensitive, like FName). */
+	static UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName);
+
+	/**
+	 * Find a named object in a collection that is not a UEdGraph (e.g. material expressions).
+	 * Count is the collection size, used as a cheap modification stamp; GetAt reads the
+	 * collection by index, both to rebuild the entry and to confirm a cached slot.
+	 */
+	static UObject* FindNamedObject(
+		const UObject* Owner,
+		const FString& Name,
+		int32 Count,
+		TFunctionRef<UObject*(int32)> GetAt);
+
+	/** Drop the cached entry for an owner after edits the count stamp cannot see. */
+	static void Invalidate(const UObject* Owner);
+
+	/** Drop every cached entry and unbind graph handlers. */
+	static void Reset();
+
+private:
+	struct FOwnerEntry
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		FDelegateHandle GraphChangedHandle;
+		int32 CountStamp = INDEX_NONE;
+		bool bDirty = true;
+		TMap<FString, int32> SlotByName;
+		TMap<FGuid, int32> SlotByGuid;
+	};
+
+	struct FPinEntry
+	{
+		TWeakObjectPtr<UEdGraphNode> Node;
+		int32 CountStamp = INDEX_NONE;
+		TMap<FName, int32> PinIndexByName;
+	};
+
+	static FOwnerEntry& FindOrAddGraphEntry(UEdGraph* Graph);
+	static void RebuildGraphEntry(UEdGraph* Graph, FOwnerEntry& Entry);
+	static void PruneStaleEntries();
+
+	static TMap<TObjectKey<UObject>, FOwnerEntry> OwnerEntries;
+	static TMap<TObjectKey<UEdGraphNode>, FPinEntry> PinEntries;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+class FTransactionObjectEvent;
+
+/**
+ * Compiled, read-only view of a Blueprint's graph topology for trace/query operations.
+ * Nodes of every user graph and its nested subgraphs (collapsed composites first) get a dense index; output links are
+ * stored as separate exec and data CSR edge lists, and event handlers and call-function
+ * nodes are pre-collected. Built lazily per Blueprint and reused until a node or graph
+ * of that Blueprint is modified, transacted (undo/redo) or the top-level node count changes.
+ * Game thread only.
+ */
+class CORTEXGRAPH_API FCortexGraphTopology
+{
+public:
+	struct FGraphRecord
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		FString SubgraphPath;
+		int32 FirstNode = 0;
+		int32 NumNodes = 0;
+	};
+
+	struct FNodeRecord
+	{
+		TWeakObjectPtr<UEdGraphNode> Node;
+		FName Name;
+		int32 GraphIndex = INDEX_NONE;
+	};
+
+	/** Output link; pin indices are slots in the owning node's Pins array at build time. */
+	struct FEdge
+	{
+		int32 Target = INDEX_NONE;
+		int32 SourcePin = INDEX_NONE;
+		int32 TargetPin = INDEX_NONE;
+	};
+
+	struct FCallRecord
+	{
+		int32 NodeIndex = INDEX_NONE;
+		FString FunctionName;
+	};
+
+	/** Cached topology for a Blueprint, rebuilt first if the Blueprint changed since the last build. */
+	static TSharedRef<const FCortexGraphTopology> Get(UBlueprint* Blueprint);
+
+	/** Force the next Get() for this Blueprint to rebuild. */
+	static void Invalidate(const UBlueprint* Blueprint);
+
+	/** Drop every cached topology and unbind change delegates. */
+	static void Reset();
+
+	/**
+	 * One-off topology over the Blueprint's user graphs plus ExtraGraphs, for nodes the cached
+	 * view does not reach (graphs outside the user graph lists or nested past the depth limit).
+	 * Not cached; callers should prefer Get().
+	 */
+	static TSharedRef<const FCortexGraphTopology> BuildUncached(UBlueprint* Blueprint, TConstArrayView<UEdGraph*> ExtraGraphs);
+
+	int32 NumNodes() const { return Nodes.Num(); }
+	int32 FindNodeIndex(const UEdGraphNode* Node) const;
+	UEdGraphNode* GetNode(int32 NodeIndex) const { return Nodes[NodeIndex].Node.Get(); }
+
+	TConstArrayView<FEdge> GetExecEdges(int32 NodeIndex) const;
+	TConstArrayView<FEdge> GetDataEdges(int32 NodeIndex) const;
+
+	/** Resolve an edge's pins, or nullptr when the node was reconstructed since the build. */
+	static UEdGraphPin* ResolvePin(const UEdGraphNode* Node, int32 PinIndex);
+
+	const TArray<FGraphRecord>& GetGraphs() const { return Graphs; }
+	const TArray<FNodeRecord>& GetNodes() const { return Nodes; }
+	const TArray<int32>& GetEventHandlers() const { return EventHandlers; }
+	const TArray<FCallRecord>& GetFunctionCalls() const { return FunctionCalls; }
+
+	/** True for event entry nodes (Event, CustomEvent, actor/component bound events). */
+	static bool IsEventHandlerNode(const UEdGraphNode* Node);
+
+private:
+	void Build(UBlueprint* Blueprint, TConstArrayView<UEdGraph*> ExtraGraphs = {});
+	void CollectGraph(UEdGraph* Graph, const FString& SubgraphPath, int32 Depth);
+
+	TArray<FGraphRecord> Graphs;
+	TArray<FNodeRecord> Nodes;
+	TMap<const UEdGraphNode*, int32> NodeIndexByPtr;
+	TArray<int32> ExecOffsets;
+	TArray<FEdge> ExecEdges;
+	TArray<int32> DataOffsets;
+	TArray<FEdge> DataEdges;
+	TArray<int32> EventHandlers;
+	TArray<FCallRecord> FunctionCalls;
+
+	struct FCacheEntry
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		TSharedPtr<const FCortexGraphTopology> Topology;
+		uint32 ChangeCount = 0;
+		uint32 BuiltChangeCount = 0;
+		int32 NodeCountStamp = INDEX_NONE;
+	};
+
+	static void BindDelegates();
+	static void HandleObjectModified(UObject* Object);
+	static void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+	static int32 ComputeNodeCountStamp(UBlueprint* Blueprint);
+
+	static constexpr int32 MaxSubgraphDepth = 5;
+
+	static TMap<TObjectKey<UBlueprint>, FCacheEntry> Cache;
+	static FDelegateHandle ObjectModifiedHandle;
+	static FDelegateHandle ObjectTransactedHandle;
+};
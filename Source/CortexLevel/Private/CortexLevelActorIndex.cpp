@@ -0,0 +1,455 @@
+#include "CortexLevelActorIndex.h"
+
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+TMap<TObjectKey<UWorld>, TSharedPtr<FCortexLevelActorIndex::FWorldIndex>> FCortexLevelActorIndex::Indices;
+bool FCortexLevelActorIndex::bDelegatesBound = false;
+FDelegateHandle FCortexLevelActorIndex::ActorAddedHandle;
+FDelegateHandle FCortexLevelActorIndex::ActorDeletedHandle;
+FDelegateHandle FCortexLevelActorIndex::ActorOuterChangedHandle;
+FDelegateHandle FCortexLevelActorIndex::ActorListChangedHandle;
+FDelegateHandle FCortexLevelActorIndex::ActorLabelChangedHandle;
+FDelegateHandle FCortexLevelActorIndex::ObjectRenamedHandle;
+FDelegateHandle FCortexLevelActorIndex::LevelAddedHandle;
+FDelegateHandle FCortexLevelActorIndex::LevelRemovedHandle;
+FDelegateHandle FCortexLevelActorIndex::WorldCleanupHandle;
+
+namespace
+{
+    /** Fuzzy suggestions must share at least this fraction of the query's trigrams */
+    constexpr float MinTrigramOverlap = 0.5f;
+
+    void RemoveSlotFromBucket(TArray<int32>* Bucket, int32 SlotIndex)
+    {
+        if (Bucket)
+        {
+            Bucket->Remove(SlotIndex);
+        }
+    }
+}
+
+FCortexLevelActorIndex::FLookupResult FCortexLevelActorIndex::Find(UWorld* World, const FString& Identifier)
+{
+    FLookupResult Result;
+    if (!World || Identifier.IsEmpty())
+    {
+        return Result;
+    }
+
+    FWorldIndex& Index = GetIndex(World);
+    const bool bFresh = TryFind(Index, Identifier, Result);
+    const bool bFound = Result.LabelMatches.Num() > 0 || Result.NameMatch || Result.PathMatch;
+    if (bFresh && (bFound || Index.ActorCountStamp == ComputeActorCountStamp(World)))
+    {
+        return Result;
+    }
+
+    // Stale hit, or a miss after actor arrays changed without an event: rebuild once and retry
+    Rebuild(Index);
+    Result = FLookupResult();
+    TryFind(Index, Identifier, Result);
+    return Result;
+}
+
+void FCortexLevelActorIndex::CollectSuggestions(UWorld* World, const FString& Query, int32 MaxSuggestions, TArray<FString>& OutSuggestions)
+{
+    if (!World || Query.IsEmpty() || MaxSuggestions <= 0)
+    {
+        return;
+    }
+
+    FWorldIndex& Index = GetIndex(World);
+    const FString QueryLower = Query.ToLower();
+
+    auto AddSubstringMatch = [&OutSuggestions, &QueryLower](const FSlot& Slot)
+    {
+        if (Slot.LabelLower.Contains(QueryLower))
+        {
+            OutSuggestions.Add(FString::Printf(TEXT("%s (label)"), *Slot.Label));
+        }
+        else if (Slot.NameLower.Contains(QueryLower))
+        {
+            OutSuggestions.Add(FString::Printf(TEXT("%s (name)"), *Slot.Name.ToString()));
+        }
+    };
+
+    TArray<uint32> QueryTrigrams;
+    AppendTrigrams(QueryLower, QueryTrigrams);
+    if (QueryTrigrams.Num() == 0)
+    {
+        // Too short for trigrams: scan the cached lowercase strings
+        for (const FSlot& Slot : Index.Slots)
+        {
+            if (Slot.Actor.IsValid())
+            {
+                AddSubstringMatch(Slot);
+                if (OutSuggestions.Num() >= MaxSuggestions)
+                {
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    TArray<uint16> Hits;
+    Hits.SetNumZeroed(Index.Slots.Num());
+    TArray<int32> Touched;
+    for (const uint32 Trigram : QueryTrigrams)
+    {
+        if (const TArray<int32>* Bucket = Index.ByTrigram.Find(Trigram))
+        {
+            for (const int32 SlotIndex : *Bucket)
+            {
+                if (Hits[SlotIndex]++ == 0)
+                {
+                    Touched.Add(SlotIndex);
+                }
+            }
+        }
+    }
+    Touched.Sort();
+
+    // Every query trigram present is necessary for a substring match; Contains confirms it
+    TBitArray<> Suggested(false, Index.Slots.Num());
+    for (const int32 SlotIndex : Touched)
+    {
+        const FSlot& Slot = Index.Slots[SlotIndex];
+        if (Hits[SlotIndex] != QueryTrigrams.Num() || !Slot.Actor.IsValid())
+        {
+            continue;
+        }
+
+        const int32 Before = OutSuggestions.Num();
+        AddSubstringMatch(Slot);
+        Suggested[SlotIndex] = OutSuggestions.Num() > Before;
+        if (OutSuggestions.Num() >= MaxSuggestions)
+        {
+            return;
+        }
+    }
+
+    // Typos and transpositions: rank the rest by shared trigrams
+    const int32 MinHits = FMath::Max(1, FMath::CeilToInt(QueryTrigrams.Num() * MinTrigramOverlap));
+    TArray<int32> Fuzzy;
+    for (const int32 SlotIndex : Touched)
+    {
+        if (!Suggested[SlotIndex] && Hits[SlotIndex] >= MinHits && Index.Slots[SlotIndex].Actor.IsValid())
+        {
+            Fuzzy.Add(SlotIndex);
+        }
+    }
+    Fuzzy.StableSort([&Hits](int32 A, int32 B) { return Hits[A] > Hits[B]; });
+
+    for (const int32 SlotIndex : Fuzzy)
+    {
+        const FSlot& Slot = Index.Slots[SlotIndex];
+        OutSuggestions.Add(Slot.Label.IsEmpty()
+            ? FString::Printf(TEXT("%s (name)"), *Slot.Name.ToString())
+            : FString::Printf(TEXT("%s (label)"), *Slot.Label));
+        if (OutSuggestions.Num() >= MaxSuggestions)
+        {
+            return;
+        }
+    }
+}
+
+void FCortexLevelActorIndex::Reset()
+{
+    if (bDelegatesBound)
+    {
+        if (GEngine)
+        {
+            GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+            GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+            GEngine->OnLevelActorOuterChanged().Remove(ActorOuterChangedHandle);
+            GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+        }
+        FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+        FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+        FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+        FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+        bDelegatesBound = false;
+    }
+    Indices.Empty();
+}
+
+FCortexLevelActorIndex::FWorldIndex& FCortexLevelActorIndex::GetIndex(UWorld* World)
+{
+    BindDelegates();
+
+    TSharedPtr<FWorldIndex>& Index = Indices.FindOrAdd(World);
+    if (!Index.IsValid() || Index->World.Get() != World)
+    {
+        Index = MakeShared<FWorldIndex>();
+        Index->World = World;
+    }
+    if (Index->bDirty)
+    {
+        Rebuild(*Index);
+    }
+    return *Index;
+}
+
+void FCortexLevelActorIndex::Rebuild(FWorldIndex& Index)
+{
+    Index.Slots.Reset();
+    Index.FreeSlots.Reset();
+    Index.SlotByActor.Reset();
+    Index.ByLabel.Reset();
+    Index.ByName.Reset();
+    Index.ByPath.Reset();
+    Index.ByTrigram.Reset();
+    Index.bDirty = false;
+
+    UWorld* World = Index.World.Get();
+    if (!World)
+    {
+        return;
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        if (IsValid(*It))
+        {
+            AddActor(Index, *It);
+        }
+    }
+    Index.ActorCountStamp = ComputeActorCountStamp(World);
+}
+
+void FCortexLevelActorIndex::AddActor(FWorldIndex& Index, AActor* Actor)
+{
+    if (Index.SlotByActor.Contains(Actor))
+    {
+        return;
+    }
+
+    const int32 SlotIndex = Index.FreeSlots.Num() > 0 ? Index.FreeSlots.Pop(EAllowShrinking::No) : Index.Slots.AddDefaulted();
+    FSlot& Slot = Index.Slots[SlotIndex];
+    Slot.Actor = Actor;
+    Slot.Label = Actor->GetActorLabel();
+    Slot.Name = Actor->GetFName();
+    Slot.Path = Actor->GetPathName();
+    Slot.LabelLower = Slot.Label.ToLower();
+    Slot.NameLower = Slot.Name.ToString().ToLower();
+    Slot.Trigrams.Reset();
+    AppendTrigrams(Slot.LabelLower, Slot.Trigrams);
+    AppendTrigrams(Slot.NameLower, Slot.Trigrams);
+
+    Index.SlotByActor.Add(Actor, SlotIndex);
+    Index.ByLabel.FindOrAdd(Slot.Label).Add(SlotIndex);
+    Index.ByName.FindOrAdd(Slot.Name).Add(SlotIndex);
+    Index.ByPath.Add(Slot.Path, SlotIndex);
+    for (const uint32 Trigram : Slot.Trigrams)
+    {
+        Index.ByTrigram.FindOrAdd(Trigram).Add(SlotIndex);
+    }
+}
+
+void FCortexLevelActorIndex::RemoveActor(FWorldIndex& Index, const AActor* Actor)
+{
+    int32 SlotIndex = INDEX_NONE;
+    if (!Index.SlotByActor.RemoveAndCopyValue(Actor, SlotIndex))
+    {
+        return;
+    }
+
+    FSlot& Slot = Index.Slots[SlotIndex];
+    RemoveSlotFromBucket(Index.ByLabel.Find(Slot.Label), SlotIndex);
+    RemoveSlotFromBucket(Index.ByName.Find(Slot.Name), SlotIndex);
+    if (const int32* PathSlot = Index.ByPath.Find(Slot.Path); PathSlot && *PathSlot == SlotIndex)
+    {
+        Index.ByPath.Remove(Slot.Path);
+    }
+    for (const uint32 Trigram : Slot.Trigrams)
+    {
+        if (TArray<int32>* Bucket = Index.ByTrigram.Find(Trigram))
+        {
+            Bucket->RemoveSingleSwap(SlotIndex, EAllowShrinking::No);
+        }
+    }
+
+    Slot = FSlot();
+    Index.FreeSlots.Add(SlotIndex);
+}
+
+void FCortexLevelActorIndex::RefreshActor(AActor* Actor)
+{
+    UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+    TSharedPtr<FWorldIndex>* Index = World ? Indices.Find(World) : nullptr;
+    if (!Index || !Index->IsValid() || (*Index)->bDirty)
+    {
+        return;
+    }
+
+    RemoveActor(**Index, Actor);
+    if (IsValid(Actor))
+    {
+        AddActor(**Index, Actor);
+    }
+    (*Index)->ActorCountStamp = ComputeActorCountStamp(World);
+}
+
+bool FCortexLevelActorIndex::TryFind(FWorldIndex& Index, const FString& Identifier, FLookupResult& OutResult)
+{
+    bool bFresh = true;
+
+    if (const TArray<int32>* LabelSlots = Index.ByLabel.Find(Identifier))
+    {
+        for (const int32 SlotIndex : *LabelSlots)
+        {
+            AActor* Actor = Index.Slots[SlotIndex].Actor.Get();
+            if (IsValid(Actor) && Actor->GetActorLabel() == Identifier)
+            {
+                OutResult.LabelMatches.Add(Actor);
+            }
+            else
+            {
+                bFresh = false;
+            }
+        }
+    }
+
+    const FName Name(*Identifier, FNAME_Find);
+    const TArray<int32>* NameSlots = Name.IsNone() ? nullptr : Index.ByName.Find(Name);
+    if (NameSlots)
+    {
+        for (const int32 SlotIndex : *NameSlots)
+        {
+            AActor* Actor = Index.Slots[SlotIndex].Actor.Get();
+            if (IsValid(Actor) && Actor->GetFName() == Name)
+            {
+                OutResult.NameMatch = Actor;
+                break;
+            }
+            bFresh = false;
+        }
+    }
+
+    if (const int32* PathSlot = Index.ByPath.Find(Identifier))
+    {
+        AActor* Actor = Index.Slots[*PathSlot].Actor.Get();
+        if (IsValid(Actor) && Actor->GetPathName() == Identifier)
+        {
+            OutResult.PathMatch = Actor;
+        }
+        else
+        {
+            bFresh = false;
+        }
+    }
+
+    return bFresh;
+}
+
+uint32 FCortexLevelActorIndex::ComputeActorCountStamp(UWorld* World)
+{
+    uint32 Stamp = World->GetLevels().Num();
+    for (const ULevel* Level : World->GetLevels())
+    {
+        Stamp = HashCombineFast(Stamp, Level ? static_cast<uint32>(Level->Actors.Num()) : 0u);
+    }
+    return Stamp;
+}
+
+void FCortexLevelActorIndex::AppendTrigrams(const FString& Lower, TArray<uint32>& OutTrigrams)
+{
+    for (int32 Offset = 0; Offset + 3 <= Lower.Len(); ++Offset)
+    {
+        // Packing collisions only widen the candidate set; matches are confirmed on the strings
+        const uint32 Trigram = ((static_cast<uint32>(Lower[Offset]) & 0x3FF) << 20)
+            | ((static_cast<uint32>(Lower[Offset + 1]) & 0x3FF) << 10)
+            | (static_cast<uint32>(Lower[Offset + 2]) & 0x3FF);
+        OutTrigrams.AddUnique(Trigram);
+    }
+}
+
+void FCortexLevelActorIndex::BindDelegates()
+{
+    if (bDelegatesBound || !GEngine)
+    {
+        return;
+    }
+
+    ActorAddedHandle = GEngine->OnLevelActorAdded().AddStatic(&FCortexLevelActorIndex::HandleActorAdded);
+    ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddStatic(&FCortexLevelActorIndex::HandleActorDeleted);
+    ActorOuterChangedHandle = GEngine->OnLevelActorOuterChanged().AddStatic(&FCortexLevelActorIndex::HandleActorOuterChanged);
+    ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddStatic(&FCortexLevelActorIndex::HandleActorListChanged);
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddStatic(&FCortexLevelActorIndex::HandleActorLabelChanged);
+    ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddStatic(&FCortexLevelActorIndex::HandleObjectRenamed);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddStatic(&FCortexLevelActorIndex::HandleLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddStatic(&FCortexLevelActorIndex::HandleLevelChanged);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FCortexLevelActorIndex::HandleWorldCleanup);
+    bDelegatesBound = true;
+}
+
+void FCortexLevelActorIndex::HandleActorAdded(AActor* Actor)
+{
+    RefreshActor(Actor);
+}
+
+void FCortexLevelActorIndex::HandleActorDeleted(AActor* Actor)
+{
+    UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+    if (TSharedPtr<FWorldIndex>* Index = World ? Indices.Find(World) : nullptr)
+    {
+        if (Index->IsValid() && !(*Index)->bDirty)
+        {
+            RemoveActor(**Index, Actor);
+        }
+    }
+}
+
+void FCortexLevelActorIndex::HandleActorLabelChanged(AActor* Actor)
+{
+    RefreshActor(Actor);
+}
+
+void FCortexLevelActorIndex::HandleObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        RefreshActor(Actor);
+    }
+}
+
+void FCortexLevelActorIndex::HandleActorOuterChanged(AActor* Actor, UObject* OldOuter)
+{
+    RefreshActor(Actor);
+}
+
+void FCortexLevelActorIndex::HandleActorListChanged()
+{
+    // Bulk changes (level load, undo of many actors) carry no actor list; rebuild lazily
+    for (TPair<TObjectKey<UWorld>, TSharedPtr<FWorldIndex>>& Pair : Indices)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->bDirty = true;
+        }
+    }
+}
+
+void FCortexLevelActorIndex::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+    if (TSharedPtr<FWorldIndex>* Index = World ? Indices.Find(World) : nullptr)
+    {
+        if (Index->IsValid())
+        {
+            (*Index)->bDirty = true;
+        }
+    }
+}
+
+void FCortexLevelActorIndex::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    Indices.Remove(World);
+}
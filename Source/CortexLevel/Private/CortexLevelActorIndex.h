@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/**
+ * Per-world actor lookup by label, FName and path, plus a trigram index over lowercased
+ * labels and names for ACTOR_NOT_FOUND suggestions. Built once per world with the same
+ * TActorIterator scan the lookups used to run, then kept current from editor actor
+ * add/delete, label-change, rename and level add/remove events. Hits are re-checked
+ * against the live actor and a cheap per-level actor-count stamp catches missed events,
+ * so a stale entry costs one rebuild rather than a wrong answer. Game thread only.
+ */
+class FCortexLevelActorIndex
+{
+public:
+    struct FLookupResult
+    {
+        TArray<AActor*> LabelMatches;
+        AActor* NameMatch = nullptr;
+        AActor* PathMatch = nullptr;
+    };
+
+    /** Resolve an identifier the way FindActorByLabelOrPath always has: all label matches, first name and path match. */
+    static FLookupResult Find(UWorld* World, const FString& Identifier);
+
+    /**
+     * Substring matches on label (then name) first, in index order; remaining slots are
+     * filled with the closest trigram matches. Entries are formatted "<label> (label)".
+     */
+    static void CollectSuggestions(UWorld* World, const FString& Query, int32 MaxSuggestions, TArray<FString>& OutSuggestions);
+
+    /** Drop every world index and unbind editor events. */
+    static void Reset();
+
+private:
+    struct FSlot
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FString Label;
+        FName Name;
+        FString Path;
+        FString LabelLower;
+        FString NameLower;
+        TArray<uint32> Trigrams;
+    };
+
+    struct FWorldIndex
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<FSlot> Slots;
+        TArray<int32> FreeSlots;
+        TMap<TObjectKey<AActor>, int32> SlotByActor;
+        TMap<FString, TArray<int32>> ByLabel;
+        TMap<FName, TArray<int32>> ByName;
+        TMap<FString, int32> ByPath;
+        TMap<uint32, TArray<int32>> ByTrigram;
+        uint32 ActorCountStamp = 0;
+        bool bDirty = true;
+    };
+
+    static FWorldIndex& GetIndex(UWorld* World);
+    static void Rebuild(FWorldIndex& Index);
+    static void AddActor(FWorldIndex& Index, AActor* Actor);
+    static void RemoveActor(FWorldIndex& Index, const AActor* Actor);
+    static void RefreshActor(AActor* Actor);
+    static bool TryFind(FWorldIndex& Index, const FString& Identifier, FLookupResult& OutResult);
+    static uint32 ComputeActorCountStamp(UWorld* World);
+    static void AppendTrigrams(const FString& Lower, TArray<uint32>& OutTrigrams);
+
+    static void BindDelegates();
+    static void HandleActorAdded(AActor* Actor);
+    static void HandleActorDeleted(AActor* Actor);
+    static void HandleActorLabelChanged(AActor* Actor);
+    static void HandleObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+    static void HandleActorOuterChanged(AActor* Actor, UObject* OldOuter);
+    static void HandleActorListChanged();
+    static void HandleLevelChanged(ULevel* Level, UWorld* World);
+    static void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    static TMap<TObjectKey<UWorld>, TSharedPtr<FWorldIndex>> Indices;
+    static bool bDelegatesBound;
+    static FDelegateHandle ActorAddedHandle;
+    static FDelegateHandle ActorDeletedHandle;
+    static FDelegateHandle ActorOuterChangedHandle;
+    static FDelegateHandle ActorListChangedHandle;
+    static FDelegateHandle ActorLabelChangedHandle;
+    static FDelegateHandle ObjectRenamedHandle;
+    static FDelegateHandle LevelAddedHandle;
+    static FDelegateHandle LevelRemovedHandle;
+    static FDelegateHandle WorldCleanupHandle;
+};
@@ -1,6 +1,8 @@
 #include "CortexLevelCommandHandler.h"
 #include "CortexCommandRouter.h"
+#include "CortexLevelPartition.h"
 #include "CortexTypes.h"
+#include "Misc/ScopeExit.h"
 #include "Operations/CortexLevelActorOps.h"
 #include "Operations/CortexLevelComponentOps.h"
 #include "Operations/CortexLevelDiscoveryOps.h"
@@ -17,10 +19,20 @@ FCortexCommandResult FCortexLevelCommandHandler::Execute(
 {
     (void)DeferredCallback;
 
+    // Actors a lookup loaded from World Partition descriptors stay pinned only for this command or batch
+    ON_SCOPE_EXIT
+    {
+        FCortexLevelPartition::ReleasePins();
+    };
+
     if (Command == TEXT("spawn_actor"))
     {
         return FCortexLevelActorOps::SpawnActor(Params);
     }
+    if (Command == TEXT("spawn_actors"))
+    {
+        return FCortexLevelActorOps::SpawnActors(Params);
+    }
     if (Command == TEXT("delete_actor"))
     {
         return FCortexLevelActorOps::DeleteActor(Params);
@@ -41,6 +53,10 @@ FCortexCommandResult FCortexLevelCommandHandler::Execute(
     {
         return FCortexLevelTransformOps::SetTransform(Params);
     }
+    if (Command == TEXT("set_transforms"))
+    {
+        return FCortexLevelTransformOps::SetTransforms(Params);
+    }
     if (Command == TEXT("set_actor_property"))
     {
         return FCortexLevelTransformOps::SetActorProperty(Params);
@@ -204,6 +220,15 @@ TArray<FCortexCommandInfo> FCortexLevelCommandHandler::GetSupportedCommands() co
             .Optional(TEXT("folder"), TEXT("string"), TEXT("World outliner folder"))
             .Optional(TEXT("mesh"), TEXT("string"), TEXT("Optional mesh asset"))
             .Optional(TEXT("material"), TEXT("string"), TEXT("Optional material override")),
+        FCortexCommandInfo{ TEXT("spawn_actors"), TEXT("Spawn many actors in one transaction with deferred construction") }
+            .Required(TEXT("actors"), TEXT("array"), TEXT("Entries with class_name, transform ([x,y,z] +[p,y,r] +[sx,sy,sz]) or location/rotation/scale, label, folder, mesh, material, properties"))
+            .Optional(TEXT("class_name"), TEXT("string"), TEXT("Default class for entries without one"))
+            .Optional(TEXT("folder"), TEXT("string"), TEXT("Default outliner folder"))
+            .Optional(TEXT("mesh"), TEXT("string"), TEXT("Default mesh asset"))
+            .Optional(TEXT("material"), TEXT("string"), TEXT("Default material override"))
+            .Optional(TEXT("level"), TEXT("string"), TEXT("Sublevel to spawn into"))
+            .Optional(TEXT("instance_static_meshes"), TEXT("boolean"), TEXT("Collapse unlabelled StaticMeshActor entries sharing mesh/material/folder into instanced static mesh actors"))
+            .Optional(TEXT("min_instances"), TEXT("number"), TEXT("Smallest group converted to instances (default 2)")),
         FCortexCommandInfo{ TEXT("delete_actor"), TEXT("Delete actor by name/label") }
             .OptionalBatchItems(TEXT("Batch items with target, confirm_class, expected_fingerprint"))
             .OptionalExpectedFingerprint()
@@ -226,6 +251,8 @@ TArray<FCortexCommandInfo> FCortexLevelCommandHandler::GetSupportedCommands() co
             .Optional(TEXT("location"), TEXT("array"), TEXT("World location"))
             .Optional(TEXT("rotation"), TEXT("array"), TEXT("World rotation"))
             .Optional(TEXT("scale"), TEXT("array"), TEXT("World scale")),
+        FCortexCommandInfo{ TEXT("set_transforms"), TEXT("Set many actor transforms in one transaction") }
+            .Required(TEXT("transforms"), TEXT("array"), TEXT("Entries with actor plus transform ([x,y,z] +[p,y,r] +[sx,sy,sz]) or location/rotation/scale")),
         FCortexCommandInfo{ TEXT("set_actor_property"), TEXT("Set actor UPROPERTY value") }
             .Required(TEXT("actor"), TEXT("string"), TEXT("Actor identifier"))
             .Required(TEXT("property"), TEXT("string"), TEXT("Property path"))
@@ -264,16 +291,21 @@ TArray<FCortexCommandInfo> FCortexLevelCommandHandler::GetSupportedCommands() co
             .Optional(TEXT("tags"), TEXT("array"), TEXT("Required actor tags"))
             .Optional(TEXT("folder"), TEXT("string"), TEXT("World outliner folder"))
             .Optional(TEXT("region"), TEXT("object"), TEXT("World-space region filter"))
+            .Optional(TEXT("loaded_only"), TEXT("boolean"), TEXT("World Partition: skip unloaded actors answered from actor descriptors"))
+            .Optional(TEXT("sort"), TEXT("string"), TEXT("Sort key: label (default), name, class or folder"))
             .Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum actors to return"))
-            .Optional(TEXT("offset"), TEXT("number"), TEXT("Pagination offset")),
+            .Optional(TEXT("offset"), TEXT("number"), TEXT("Pagination offset (defaults to the cursor's next page)"))
+            .Optional(TEXT("cursor"), TEXT("string"), TEXT("Cursor from a previous page; reuses its filtered, sorted snapshot")),
         FCortexCommandInfo{ TEXT("find_actors"), TEXT("Find actors by pattern (auto-wildcards plain keywords)") }
             .Required(TEXT("pattern"), TEXT("string"), TEXT("Search pattern — plain keywords auto-wrapped as *keyword*"))
-            .Optional(TEXT("include_components"), TEXT("boolean"), TEXT("Include component list per match")),
+            .Optional(TEXT("include_components"), TEXT("boolean"), TEXT("Include component list per match"))
+            .Optional(TEXT("loaded_only"), TEXT("boolean"), TEXT("World Partition: skip unloaded actors answered from actor descriptors")),
         FCortexCommandInfo{ TEXT("get_bounds"), TEXT("Compute bounds for filtered actors") }
             .Optional(TEXT("class"), TEXT("string"), TEXT("Actor class filter"))
             .Optional(TEXT("tags"), TEXT("array"), TEXT("Required actor tags"))
             .Optional(TEXT("folder"), TEXT("string"), TEXT("World outliner folder"))
-            .Optional(TEXT("region"), TEXT("object"), TEXT("World-space region filter")),
+            .Optional(TEXT("region"), TEXT("object"), TEXT("World-space region filter"))
+            .Optional(TEXT("loaded_only"), TEXT("boolean"), TEXT("World Partition: skip unloaded actors answered from actor descriptors")),
         FCortexCommandInfo{ TEXT("select_actors"), TEXT("Select actors in editor") }
             .Required(TEXT("actors"), TEXT("array"), TEXT("Actors to select"))
             .Optional(TEXT("add"), TEXT("boolean"), TEXT("Add to current selection")),
@@ -315,8 +347,12 @@ TArray<FCortexCommandInfo> FCortexLevelCommandHandler::GetSupportedCommands() co
         FCortexCommandInfo{ TEXT("set_data_layer"), TEXT("Assign actor to data layer") }
             .Required(TEXT("actors"), TEXT("array"), TEXT("Actors to assign"))
             .Required(TEXT("data_layer"), TEXT("string"), TEXT("Target data layer")),
-        FCortexCommandInfo{ TEXT("save_level"), TEXT("Save current level without prompt") },
-        FCortexCommandInfo{ TEXT("save_all"), TEXT("Save all dirty map/content packages without prompt") },
+        FCortexCommandInfo{ TEXT("save_level"), TEXT("Save current level and its dirty external actor packages without prompt") }
+            .Optional(TEXT("dry_run"), TEXT("boolean"), TEXT("List packages that would be saved without writing"))
+            .Optional(TEXT("concurrent"), TEXT("boolean"), TEXT("Overlap file writes with package serialization (default true)")),
+        FCortexCommandInfo{ TEXT("save_all"), TEXT("Save all dirty map, external actor and content packages in one batch without prompt") }
+            .Optional(TEXT("dry_run"), TEXT("boolean"), TEXT("List packages that would be saved without writing"))
+            .Optional(TEXT("concurrent"), TEXT("boolean"), TEXT("Overlap file writes with package serialization (default true)")),
         FCortexCommandInfo{ TEXT("list_templates"), TEXT("List available level templates") },
         FCortexCommandInfo{ TEXT("create_level"), TEXT("Create a new level asset") }
             .Required(TEXT("path"), TEXT("string"), TEXT("Content path for the new level"))
@@ -2,6 +2,8 @@
 #include "CortexCoreModule.h"
 #include "ICortexCommandRegistry.h"
 #include "CortexLevelCommandHandler.h"
+#include "CortexLevelActorIndex.h"
+#include "CortexLevelPartition.h"
 
 DEFINE_LOG_CATEGORY(LogCortexLevel);
 
@@ -26,6 +28,8 @@ void FCortexLevelModule::StartupModule()
 void FCortexLevelModule::ShutdownModule()
 {
     UE_LOG(LogCortexLevel, Log, TEXT("CortexLevel module shutting down"));
+    FCortexLevelActorIndex::Reset();
+    FCortexLevelPartition::Reset();
 }
 
 IMPLEMENT_MODULE(FCortexLevelModule, CortexLevel)
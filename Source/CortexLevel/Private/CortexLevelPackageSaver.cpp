@@ -0,0 +1,251 @@
+#include "CortexLevelPackageSaver.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "ISourceControlModule.h"
+#include "Misc/PackageName.h"
+#include "Misc/PackagePath.h"
+#include "SourceControlHelpers.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+    FString GetPackageKind(const UPackage* Package)
+    {
+        if (Package->ContainsMap())
+        {
+            return TEXT("map");
+        }
+        if (Package->GetName().Contains(FPackagePath::GetExternalActorsFolderName()))
+        {
+            return TEXT("external_actor");
+        }
+        return TEXT("content");
+    }
+
+    bool IsExternalPackage(const UPackage* Package)
+    {
+        const FString Name = Package->GetName();
+        return Name.Contains(FPackagePath::GetExternalActorsFolderName())
+            || Name.Contains(FPackagePath::GetExternalObjectsFolderName());
+    }
+
+    /** An external package whose actor or object was deleted: the editor removes its file on save */
+    bool IsDeletedExternalPackage(UPackage* Package)
+    {
+        return IsExternalPackage(Package) && UPackage::IsEmptyPackage(Package);
+    }
+
+    bool TryGetPackageFilename(const UPackage* Package, FString& OutFilename)
+    {
+        const FString& Extension = Package->ContainsMap()
+            ? FPackageName::GetMapPackageExtension()
+            : FPackageName::GetAssetPackageExtension();
+        return FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), OutFilename, Extension);
+    }
+}
+
+void FCortexLevelPackageSaver::Add(UPackage* Package)
+{
+    if (Package && Package != GetTransientPackage())
+    {
+        Packages.AddUnique(Package);
+    }
+}
+
+void FCortexLevelPackageSaver::AddDirtyPackages(bool bIncludeContent)
+{
+    TArray<UPackage*> Dirty;
+    FEditorFileUtils::GetDirtyWorldPackages(Dirty);
+    if (bIncludeContent)
+    {
+        FEditorFileUtils::GetDirtyContentPackages(Dirty);
+    }
+
+    Packages.Reserve(Packages.Num() + Dirty.Num());
+    for (UPackage* Package : Dirty)
+    {
+        Add(Package);
+    }
+    AddDeletedExternalPackages();
+}
+
+void FCortexLevelPackageSaver::AddDeletedExternalPackages(const FString& PathPrefix)
+{
+    for (TObjectIterator<UPackage> It; It; ++It)
+    {
+        UPackage* Package = *It;
+        if (Package->IsDirty()
+            && (PathPrefix.IsEmpty() || Package->GetName().StartsWith(PathPrefix))
+            && IsDeletedExternalPackage(Package))
+        {
+            Add(Package);
+        }
+    }
+}
+
+bool FCortexLevelPackageSaver::Save(const FOptions& Options, TSharedPtr<FJsonObject>& OutData)
+{
+    struct FPendingSave
+    {
+        UPackage* Package = nullptr;
+        FString Filename;
+        FString Kind;
+        FString Error;
+        double Ms = 0.0;
+        int64 Bytes = 0;
+        bool bDelete = false;
+    };
+
+    TArray<FPendingSave> Pending;
+    Pending.Reserve(Packages.Num());
+    TArray<UPackage*> ReadOnly;
+    for (UPackage* Package : Packages)
+    {
+        FPendingSave& Entry = Pending.Emplace_GetRef();
+        Entry.Package = Package;
+        Entry.Kind = GetPackageKind(Package);
+        Entry.bDelete = IsDeletedExternalPackage(Package);
+        if (FPackageName::IsTempPackage(Package->GetName()) || !TryGetPackageFilename(Package, Entry.Filename))
+        {
+            Entry.Error = TEXT("Package has never been saved to a content path");
+        }
+        else if (!Entry.bDelete && IFileManager::Get().IsReadOnly(*Entry.Filename))
+        {
+            ReadOnly.Add(Package);
+        }
+    }
+
+    // One source control round trip for every read-only file instead of one per package
+    if (!Options.bDryRun && ReadOnly.Num() > 0 && ISourceControlModule::Get().IsEnabled())
+    {
+        FEditorFileUtils::CheckoutPackages(ReadOnly, nullptr, false);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    if (!Options.bDryRun)
+    {
+        // Deleted actors: mark their files for delete in one source control call, then remove what is left
+        TArray<FString> DeleteFiles;
+        for (const FPendingSave& Entry : Pending)
+        {
+            if (Entry.bDelete && Entry.Error.IsEmpty() && IFileManager::Get().FileExists(*Entry.Filename))
+            {
+                DeleteFiles.Add(Entry.Filename);
+            }
+        }
+        if (DeleteFiles.Num() > 0 && ISourceControlModule::Get().IsEnabled())
+        {
+            USourceControlHelpers::MarkFilesForDelete(DeleteFiles, /*bSilent*/true);
+        }
+
+        for (FPendingSave& Entry : Pending)
+        {
+            if (!Entry.Error.IsEmpty())
+            {
+                continue;
+            }
+            if (Entry.bDelete)
+            {
+                const double PackageStart = FPlatformTime::Seconds();
+                if (IFileManager::Get().FileExists(*Entry.Filename)
+                    && !IFileManager::Get().Delete(*Entry.Filename, false, true, true))
+                {
+                    Entry.Error = TEXT("Failed to delete the file of a deleted actor");
+                }
+                else
+                {
+                    Entry.Package->SetDirtyFlag(false);
+                }
+                Entry.Ms = (FPlatformTime::Seconds() - PackageStart) * 1000.0;
+                continue;
+            }
+            if (IFileManager::Get().IsReadOnly(*Entry.Filename))
+            {
+                Entry.Error = TEXT("File is read-only and could not be checked out");
+                continue;
+            }
+
+            // Same split as the editor's own save: worlds save from the UWorld, everything else by standalone objects
+            UWorld* World = Entry.Package->ContainsMap() ? UWorld::FindWorldInPackage(Entry.Package) : nullptr;
+
+            FSavePackageArgs SaveArgs;
+            SaveArgs.TopLevelFlags = World ? RF_NoFlags : RF_Standalone;
+            SaveArgs.SaveFlags = SAVE_NoError | (Options.bConcurrent ? SAVE_Async : SAVE_None);
+            SaveArgs.Error = GWarn;
+
+            const double PackageStart = FPlatformTime::Seconds();
+            const FSavePackageResultStruct Result = GEditor->Save(Entry.Package, World, *Entry.Filename, SaveArgs);
+            Entry.Ms = (FPlatformTime::Seconds() - PackageStart) * 1000.0;
+            if (Result.IsSuccessful())
+            {
+                Entry.Bytes = Result.TotalFileSize;
+            }
+            else
+            {
+                Entry.Error = TEXT("Save failed");
+            }
+        }
+    }
+
+    const double SerializeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    if (!Options.bDryRun && Options.bConcurrent)
+    {
+        UPackage::WaitForAsyncFileWrites();
+    }
+    const double FlushMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 - SerializeMs;
+
+    bool bAllSaved = true;
+    int64 TotalBytes = 0;
+    TArray<TSharedPtr<FJsonValue>> PackageJson;
+    PackageJson.Reserve(Pending.Num());
+    for (const FPendingSave& Entry : Pending)
+    {
+        TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("package"), Entry.Package->GetName());
+        Json->SetStringField(TEXT("filename"), Entry.Filename);
+        Json->SetStringField(TEXT("kind"), Entry.Kind);
+        Json->SetStringField(TEXT("action"), Entry.bDelete ? TEXT("delete") : TEXT("save"));
+        if (!Entry.Error.IsEmpty())
+        {
+            Json->SetBoolField(TEXT("saved"), false);
+            Json->SetStringField(TEXT("error"), Entry.Error);
+            bAllSaved = false;
+        }
+        else if (!Options.bDryRun && Entry.bDelete)
+        {
+            Json->SetBoolField(TEXT("saved"), true);
+            Json->SetBoolField(TEXT("deleted"), true);
+            Json->SetNumberField(TEXT("ms"), Entry.Ms);
+        }
+        else if (!Options.bDryRun)
+        {
+            Json->SetBoolField(TEXT("saved"), true);
+            Json->SetNumberField(TEXT("ms"), Entry.Ms);
+            Json->SetNumberField(TEXT("bytes"), static_cast<double>(Entry.Bytes));
+            TotalBytes += Entry.Bytes;
+        }
+        PackageJson.Add(MakeShared<FJsonValueObject>(Json));
+    }
+
+    OutData = MakeShared<FJsonObject>();
+    OutData->SetArrayField(TEXT("packages"), PackageJson);
+    OutData->SetNumberField(TEXT("package_count"), Pending.Num());
+    OutData->SetBoolField(TEXT("dry_run"), Options.bDryRun);
+    if (!Options.bDryRun)
+    {
+        OutData->SetBoolField(TEXT("saved"), bAllSaved);
+        OutData->SetNumberField(TEXT("total_bytes"), static_cast<double>(TotalBytes));
+        OutData->SetNumberField(TEXT("serialize_ms"), SerializeMs);
+        OutData->SetNumberField(TEXT("flush_ms"), FlushMs);
+        OutData->SetBoolField(TEXT("concurrent"), Options.bConcurrent);
+    }
+    return bAllSaved;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UPackage;
+
+/**
+ * Saves a set of level, external-actor and content packages in one pass. Read-only files
+ * are checked out in a single source control call, each package is serialized on the game
+ * thread with SAVE_Async so file writes overlap the next package, and all writes are
+ * flushed once at the end. Empty external packages (actors deleted from a One File Per
+ * Actor level) are deleted instead of saved, marked for delete in source control when it
+ * is enabled, as the editor's own save does. Reports per-package serialize time and bytes
+ * written.
+ */
+class FCortexLevelPackageSaver
+{
+public:
+    struct FOptions
+    {
+        /** List what would be saved without writing anything. */
+        bool bDryRun = false;
+
+        /** Overlap file writes with serialization of the next package. */
+        bool bConcurrent = true;
+    };
+
+    /** Queue a package; duplicates and null packages are ignored. */
+    void Add(UPackage* Package);
+
+    /** Queue the dirty world packages (maps and external actors) and optionally dirty content packages. */
+    void AddDirtyPackages(bool bIncludeContent);
+
+    /**
+     * Queue dirty, now-empty external packages under PathPrefix (all external packages when empty).
+     * Levels no longer list the package of a deleted actor, so they are found by package instead.
+     */
+    void AddDeletedExternalPackages(const FString& PathPrefix = FString());
+
+    int32 Num() const { return Packages.Num(); }
+
+    /** Save the queued packages; returns true when every package saved. Fills OutData with the report. */
+    bool Save(const FOptions& Options, TSharedPtr<FJsonObject>& OutData);
+
+private:
+    TArray<UPackage*> Packages;
+};
@@ -0,0 +1,374 @@
+#include "CortexLevelPartition.h"
+
+#include "CortexBatchScope.h"
+#include "CortexCommandRouter.h"
+#include "CortexLevelUtils.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+
+FCortexLevelPartition::FDescriptorIndex FCortexLevelPartition::Index;
+TWeakObjectPtr<UWorld> FCortexLevelPartition::PinnedWorld;
+TSet<FGuid> FCortexLevelPartition::PinnedGuids;
+int32 FCortexLevelPartition::IndexBuildCount = 0;
+bool FCortexLevelPartition::bDelegatesBound = false;
+FDelegateHandle FCortexLevelPartition::PackageSavedHandle;
+FDelegateHandle FCortexLevelPartition::PackageDeletedHandle;
+FDelegateHandle FCortexLevelPartition::WorldCleanupHandle;
+
+namespace
+{
+    void FillUnloadedActor(const FWorldPartitionActorDescInstance& Instance, FCortexUnloadedActor& Out)
+    {
+        Out.Guid = Instance.GetGuid();
+        Out.Name = Instance.GetActorName().ToString();
+        Out.Label = Instance.GetActorLabel().ToString();
+        if (Out.Label.IsEmpty())
+        {
+            Out.Label = Out.Name;
+        }
+
+        const FTopLevelAssetPath BaseClass = Instance.GetBaseClass();
+        if (BaseClass.IsValid())
+        {
+            Out.ClassName = BaseClass.GetAssetName().ToString();
+        }
+        else if (const UClass* NativeClass = Instance.GetActorNativeClass())
+        {
+            Out.ClassName = NativeClass->GetName();
+        }
+
+        Out.Path = Instance.GetActorSoftPath().ToString();
+        Out.Bounds = Instance.GetEditorBounds();
+        Out.RuntimeGrid = Instance.GetRuntimeGrid();
+        if (const FWorldPartitionActorDesc* Desc = Instance.GetActorDesc())
+        {
+            Out.Folder = Desc->GetFolderPath();
+        }
+        Out.DataLayers = Instance.GetDataLayerInstanceNames().ToArray();
+    }
+}
+
+bool FCortexLevelPartition::IsPartitioned(const UWorld* World)
+{
+    return World && World->IsPartitionedWorld() && World->GetWorldPartition() && World->GetWorldPartition()->IsInitialized();
+}
+
+void FCortexLevelPartition::ForEachUnloadedActor(UWorld* World, UClass* FilterClass, TFunctionRef<void(const FCortexUnloadedActor&)> Visit)
+{
+    if (!IsPartitioned(World))
+    {
+        return;
+    }
+
+    FCortexUnloadedActor Record;
+    FWorldPartitionHelpers::ForEachActorDescInstance(
+        World->GetWorldPartition(),
+        FilterClass ? FilterClass : AActor::StaticClass(),
+        [&Record, &Visit](const FWorldPartitionActorDescInstance* Instance)
+        {
+            if (Instance && !Instance->IsLoaded())
+            {
+                Record = FCortexUnloadedActor();
+                FillUnloadedActor(*Instance, Record);
+                Visit(Record);
+            }
+            return true;
+        });
+}
+
+TSharedPtr<FJsonObject> FCortexLevelPartition::SerializeSummary(const FCortexUnloadedActor& Actor)
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("name"), Actor.Name);
+    Json->SetStringField(TEXT("label"), Actor.Label);
+    Json->SetStringField(TEXT("class"), Actor.ClassName);
+    FCortexLevelUtils::SetVectorArray(Json, TEXT("location"), Actor.GetLocation());
+    Json->SetStringField(TEXT("folder"), Actor.Folder.IsNone() ? FString() : Actor.Folder.ToString());
+    Json->SetBoolField(TEXT("loaded"), false);
+    Json->SetStringField(TEXT("guid"), Actor.Guid.ToString(EGuidFormats::Digits));
+    Json->SetStringField(TEXT("path"), Actor.Path);
+
+    if (Actor.Bounds.IsValid)
+    {
+        TSharedPtr<FJsonObject> Bounds = MakeShared<FJsonObject>();
+        FCortexLevelUtils::SetVectorArray(Bounds, TEXT("min"), Actor.Bounds.Min);
+        FCortexLevelUtils::SetVectorArray(Bounds, TEXT("max"), Actor.Bounds.Max);
+        Json->SetObjectField(TEXT("bounds"), Bounds);
+    }
+
+    if (!Actor.RuntimeGrid.IsNone())
+    {
+        Json->SetStringField(TEXT("runtime_grid"), Actor.RuntimeGrid.ToString());
+    }
+
+    TArray<TSharedPtr<FJsonValue>> DataLayers;
+    for (const FName& DataLayer : Actor.DataLayers)
+    {
+        DataLayers.Add(MakeShared<FJsonValueString>(DataLayer.ToString()));
+    }
+    Json->SetArrayField(TEXT("data_layers"), DataLayers);
+    return Json;
+}
+
+AActor* FCortexLevelPartition::LoadByIdentifier(UWorld* World, const FString& Identifier)
+{
+    if (!IsPartitioned(World) || Identifier.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    FDescriptorIndex& WorldIndex = GetIndex(World);
+    bool bStale = false;
+    FGuid Guid = Resolve(WorldIndex, World, Identifier, bStale);
+    if (bStale)
+    {
+        // A hit no longer matches its descriptor: an event was missed, rebuild once and retry
+        Rebuild(WorldIndex);
+        Guid = Resolve(WorldIndex, World, Identifier, bStale);
+    }
+    if (!Guid.IsValid())
+    {
+        return nullptr;
+    }
+
+    UWorldPartition* WorldPartition = World->GetWorldPartition();
+    WorldPartition->PinActors({ Guid });
+    if (PinnedWorld.Get() != World)
+    {
+        PinnedGuids.Reset();
+        PinnedWorld = World;
+    }
+    PinnedGuids.Add(Guid);
+
+    const FWorldPartitionActorDescInstance* Instance = WorldPartition->GetActorDescInstance(Guid);
+    return Instance ? Instance->GetActor() : nullptr;
+}
+
+void FCortexLevelPartition::ReleasePins()
+{
+    if (PinnedGuids.Num() == 0)
+    {
+        return;
+    }
+
+    if (FCortexCommandRouter::IsInBatch())
+    {
+        FCortexBatchScope::AddCleanupAction(TEXT("level.partition.release_pins"), []()
+        {
+            ReleasePinsNow();
+        });
+        return;
+    }
+    ReleasePinsNow();
+}
+
+void FCortexLevelPartition::Reset()
+{
+    ReleasePinsNow();
+    PinnedGuids.Reset();
+    PinnedWorld.Reset();
+    Index = FDescriptorIndex();
+
+    if (bDelegatesBound)
+    {
+        UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+        FEditorDelegates::OnPackageDeleted.Remove(PackageDeletedHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+        bDelegatesBound = false;
+    }
+}
+
+FCortexLevelPartition::FDescriptorIndex& FCortexLevelPartition::GetIndex(UWorld* World)
+{
+    BindDelegates();
+
+    if (Index.World.Get() != World)
+    {
+        Index = FDescriptorIndex();
+        Index.World = World;
+    }
+    if (Index.bDirty)
+    {
+        Rebuild(Index);
+    }
+    return Index;
+}
+
+void FCortexLevelPartition::Rebuild(FDescriptorIndex& WorldIndex)
+{
+    WorldIndex.ByLabel.Reset();
+    WorldIndex.ByName.Reset();
+    WorldIndex.ByPath.Reset();
+    WorldIndex.bDirty = false;
+    ++IndexBuildCount;
+
+    UWorld* World = WorldIndex.World.Get();
+    if (!IsPartitioned(World))
+    {
+        return;
+    }
+
+    // Loaded actors too: the loaded state is checked per lookup, so loading never invalidates
+    FCortexUnloadedActor Record;
+    FWorldPartitionHelpers::ForEachActorDescInstance(
+        World->GetWorldPartition(),
+        AActor::StaticClass(),
+        [&Record, &WorldIndex](const FWorldPartitionActorDescInstance* Instance)
+        {
+            if (Instance)
+            {
+                Record = FCortexUnloadedActor();
+                FillUnloadedActor(*Instance, Record);
+                WorldIndex.ByLabel.FindOrAdd(Record.Label.ToLower()).Add(Record.Guid);
+                WorldIndex.ByName.FindOrAdd(Record.Name.ToLower(), Record.Guid);
+                WorldIndex.ByPath.FindOrAdd(Record.Path.ToLower(), Record.Guid);
+            }
+            return true;
+        });
+}
+
+FGuid FCortexLevelPartition::Resolve(const FDescriptorIndex& WorldIndex, UWorld* World, const FString& Identifier, bool& bOutStale)
+{
+    bOutStale = false;
+    UWorldPartition* WorldPartition = World->GetWorldPartition();
+    const FString Key = Identifier.ToLower();
+
+    // Unloaded descriptor still matching Identifier through Field; anything else means the index is stale
+    auto Check = [WorldPartition, &Identifier, &bOutStale](const FGuid& Guid, FString FCortexUnloadedActor::* Field, bool& bOutUnloaded)
+    {
+        bOutUnloaded = false;
+        const FWorldPartitionActorDescInstance* Instance = WorldPartition->GetActorDescInstance(Guid);
+        if (!Instance)
+        {
+            bOutStale = true;
+            return;
+        }
+
+        FCortexUnloadedActor Record;
+        FillUnloadedActor(*Instance, Record);
+        if (!(Record.*Field).Equals(Identifier, ESearchCase::IgnoreCase))
+        {
+            bOutStale = true;
+            return;
+        }
+        bOutUnloaded = !Instance->IsLoaded();
+    };
+
+    // Same precedence as FindActorByLabelOrPath: a unique label, then name, then path
+    TArray<FGuid> LabelMatches;
+    if (const TArray<FGuid>* Guids = WorldIndex.ByLabel.Find(Key))
+    {
+        for (const FGuid& Guid : *Guids)
+        {
+            bool bUnloaded = false;
+            Check(Guid, &FCortexUnloadedActor::Label, bUnloaded);
+            if (bUnloaded)
+            {
+                LabelMatches.Add(Guid);
+            }
+        }
+    }
+    if (LabelMatches.Num() > 1)
+    {
+        return FGuid();
+    }
+    if (LabelMatches.Num() == 1)
+    {
+        return LabelMatches[0];
+    }
+
+    if (const FGuid* Guid = WorldIndex.ByName.Find(Key))
+    {
+        bool bUnloaded = false;
+        Check(*Guid, &FCortexUnloadedActor::Name, bUnloaded);
+        if (bUnloaded)
+        {
+            return *Guid;
+        }
+    }
+
+    if (const FGuid* Guid = WorldIndex.ByPath.Find(Key))
+    {
+        bool bUnloaded = false;
+        Check(*Guid, &FCortexUnloadedActor::Path, bUnloaded);
+        if (bUnloaded)
+        {
+            return *Guid;
+        }
+    }
+    return FGuid();
+}
+
+void FCortexLevelPartition::ReleasePinsNow()
+{
+    UWorld* World = PinnedWorld.Get();
+    if (!IsPartitioned(World))
+    {
+        PinnedGuids.Reset();
+        return;
+    }
+
+    UWorldPartition* WorldPartition = World->GetWorldPartition();
+    TArray<FGuid> ToUnpin;
+    for (auto It = PinnedGuids.CreateIterator(); It; ++It)
+    {
+        const FWorldPartitionActorDescInstance* Instance = WorldPartition->GetActorDescInstance(*It);
+        const AActor* Actor = Instance ? Instance->GetActor() : nullptr;
+        if (Actor && Actor->GetPackage()->IsDirty())
+        {
+            continue;
+        }
+        ToUnpin.Add(*It);
+        It.RemoveCurrent();
+    }
+
+    if (ToUnpin.Num() > 0)
+    {
+        WorldPartition->UnpinActors(ToUnpin);
+    }
+}
+
+void FCortexLevelPartition::BindDelegates()
+{
+    if (bDelegatesBound)
+    {
+        return;
+    }
+
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddStatic(&FCortexLevelPartition::HandlePackageSaved);
+    PackageDeletedHandle = FEditorDelegates::OnPackageDeleted.AddStatic(&FCortexLevelPartition::HandlePackageDeleted);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FCortexLevelPartition::HandleWorldCleanup);
+    bDelegatesBound = true;
+}
+
+void FCortexLevelPartition::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    // Saving an actor package is when its descriptor is added or refreshed (new label, class, bounds)
+    Index.bDirty = true;
+}
+
+void FCortexLevelPartition::HandlePackageDeleted(UPackage* Package)
+{
+    Index.bDirty = true;
+}
+
+void FCortexLevelPartition::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (Index.World.Get() == World)
+    {
+        Index = FDescriptorIndex();
+    }
+    if (PinnedWorld.Get() == World)
+    {
+        PinnedGuids.Reset();
+        PinnedWorld.Reset();
+    }
+}
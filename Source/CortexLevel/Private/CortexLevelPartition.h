@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectSaveContext.h"
+
+class AActor;
+class FJsonObject;
+class UWorld;
+
+/** Descriptor-only view of a World Partition actor that is not loaded in the editor. */
+struct FCortexUnloadedActor
+{
+    FGuid Guid;
+    FString Name;
+    FString Label;
+    FString ClassName;
+    FString Path;
+    FName Folder;
+    FBox Bounds = FBox(ForceInit);
+    FName RuntimeGrid;
+    TArray<FName> DataLayers;
+
+    /** Stand-in for the actor location: the center of its editor bounds. */
+    FVector GetLocation() const { return Bounds.IsValid ? Bounds.GetCenter() : FVector::ZeroVector; }
+};
+
+/**
+ * Answers Level queries for unloaded World Partition actors straight from the actor
+ * descriptor containers, so listing a partitioned map never loads cells. Actors are only
+ * loaded (pinned, as the outliner's Pin does) when a command resolves one by identifier
+ * and needs the real object; ReleasePins drops those pins once the command or batch is
+ * done. Identifier lookups go through a label/name/path index built once per world and
+ * marked dirty when actor packages are saved or deleted, which is when descriptors change.
+ * Hits are re-checked against the live descriptor. Game thread only.
+ */
+class FCortexLevelPartition
+{
+public:
+    static bool IsPartitioned(const UWorld* World);
+
+    /** Visit descriptors of unloaded actors deriving from FilterClass (any actor when null). */
+    static void ForEachUnloadedActor(UWorld* World, UClass* FilterClass, TFunctionRef<void(const FCortexUnloadedActor&)> Visit);
+
+    /** Summary in the shape of FCortexLevelUtils::SerializeActorSummary, flagged "loaded": false. */
+    static TSharedPtr<FJsonObject> SerializeSummary(const FCortexUnloadedActor& Actor);
+
+    /**
+     * Load the single unloaded actor whose label, name or path equals Identifier.
+     * Returns null when nothing matches or a label is ambiguous.
+     */
+    static AActor* LoadByIdentifier(UWorld* World, const FString& Identifier);
+
+    /**
+     * Unpin actors LoadByIdentifier loaded. Inside a batch this waits for the batch to end.
+     * Actors with unsaved edits stay pinned, so unloading never drops them; a later release
+     * after the save unpins them.
+     */
+    static void ReleasePins();
+
+    /** Descriptor index builds since startup, so tests can tell lookups from rescans. */
+    static int32 GetIndexBuildCount() { return IndexBuildCount; }
+
+    /** Unpin everything, drop the index and unbind editor events. */
+    static void Reset();
+
+private:
+    struct FDescriptorIndex
+    {
+        TWeakObjectPtr<UWorld> World;
+        TMap<FString, TArray<FGuid>> ByLabel;
+        TMap<FString, FGuid> ByName;
+        TMap<FString, FGuid> ByPath;
+        bool bDirty = true;
+    };
+
+    static FDescriptorIndex& GetIndex(UWorld* World);
+    static void Rebuild(FDescriptorIndex& Index);
+    static FGuid Resolve(const FDescriptorIndex& Index, UWorld* World, const FString& Identifier, bool& bOutStale);
+    static void ReleasePinsNow();
+
+    static void BindDelegates();
+    static void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+    static void HandlePackageDeleted(UPackage* Package);
+    static void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    static FDescriptorIndex Index;
+    static TWeakObjectPtr<UWorld> PinnedWorld;
+    static TSet<FGuid> PinnedGuids;
+    static int32 IndexBuildCount;
+    static bool bDelegatesBound;
+    static FDelegateHandle PackageSavedHandle;
+    static FDelegateHandle PackageDeletedHandle;
+    static FDelegateHandle WorldCleanupHandle;
+};
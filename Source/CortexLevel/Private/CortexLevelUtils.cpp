@@ -1,12 +1,13 @@
 #include "CortexLevelUtils.h"
 
 #include "Components/ActorComponent.h"
+#include "CortexLevelActorIndex.h"
+#include "CortexLevelPartition.h"
 #include "CortexTypes.h"
 #include "Dom/JsonObject.h"
 #include "Engine/Blueprint.h"
 #include "Engine/Engine.h"
 #include "Engine/LevelStreaming.h"
-#include "EngineUtils.h"
 #include "GameFramework/Actor.h"
 #include "Misc/PackageName.h"
 #include "UObject/UObjectIterator.h"
@@ -55,33 +56,10 @@ AActor* FCortexLevelUtils::FindActorByLabelOrPath(UWorld* World, const FString&
         return nullptr;
     }
 
-    TArray<AActor*> LabelMatches;
-    AActor* NameMatch = nullptr;
-    AActor* PathMatch = nullptr;
-
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (!IsValid(Actor))
-        {
-            continue;
-        }
-
-        if (Actor->GetActorLabel() == ActorIdentifier)
-        {
-            LabelMatches.Add(Actor);
-        }
-
-        if (!NameMatch && Actor->GetFName().ToString() == ActorIdentifier)
-        {
-            NameMatch = Actor;
-        }
-
-        if (!PathMatch && Actor->GetPathName() == ActorIdentifier)
-        {
-            PathMatch = Actor;
-        }
-    }
+    FCortexLevelActorIndex::FLookupResult Lookup = FCortexLevelActorIndex::Find(World, ActorIdentifier);
+    const TArray<AActor*>& LabelMatches = Lookup.LabelMatches;
+    AActor* NameMatch = Lookup.NameMatch;
+    AActor* PathMatch = Lookup.PathMatch;
 
     if (LabelMatches.Num() > 1)
     {
@@ -116,6 +94,12 @@ AActor* FCortexLevelUtils::FindActorByLabelOrPath(UWorld* World, const FString&
         return PathMatch;
     }
 
+    // Partitioned maps: load an unloaded actor on demand when a command needs the object itself
+    if (AActor* Loaded = FCortexLevelPartition::LoadByIdentifier(World, ActorIdentifier))
+    {
+        return Loaded;
+    }
+
     TSharedPtr<FJsonObject> SuggestionDetails = CollectActorSuggestions(World, ActorIdentifier);
     OutError = FCortexCommandRouter::Error(
         CortexErrorCodes::ActorNotFound,
@@ -252,34 +236,11 @@ TSharedPtr<FJsonObject> FCortexLevelUtils::CollectActorSuggestions(UWorld* World
         return Details;
     }
 
-    const FString QueryLower = Query.ToLower();
-
-    for (TActorIterator<AActor> It(World); It; ++It)
+    TArray<FString> Matches;
+    FCortexLevelActorIndex::CollectSuggestions(World, Query, MaxSuggestions, Matches);
+    for (const FString& Match : Matches)
     {
-        AActor* Actor = *It;
-        if (!IsValid(Actor))
-        {
-            continue;
-        }
-
-        const FString Label = Actor->GetActorLabel();
-        const FString Name = Actor->GetName();
-
-        if (Label.ToLower().Contains(QueryLower))
-        {
-            Suggestions.Add(MakeShared<FJsonValueString>(
-                FString::Printf(TEXT("%s (label)"), *Label)));
-        }
-        else if (Name.ToLower().Contains(QueryLower))
-        {
-            Suggestions.Add(MakeShared<FJsonValueString>(
-                FString::Printf(TEXT("%s (name)"), *Name)));
-        }
-
-        if (Suggestions.Num() >= MaxSuggestions)
-        {
-            break;
-        }
+        Suggestions.Add(MakeShared<FJsonValueString>(Match));
     }
 
     Details->SetArrayField(TEXT("suggestions"), Suggestions);
@@ -358,6 +319,44 @@ bool FCortexLevelUtils::ParseVectorField(const TSharedPtr<FJsonObject>& Params,
     return true;
 }
 
+bool FCortexLevelUtils::TryParseTransform(const TSharedPtr<FJsonObject>& Json, FTransform& InOutTransform)
+{
+    if (!Json.IsValid())
+    {
+        return true;
+    }
+
+    FVector Location = InOutTransform.GetLocation();
+    const FRotator CurrentRotation = InOutTransform.Rotator();
+    FVector Rotation(CurrentRotation.Pitch, CurrentRotation.Yaw, CurrentRotation.Roll);
+    FVector Scale = InOutTransform.GetScale3D();
+
+    const TArray<TSharedPtr<FJsonValue>>* Compact = nullptr;
+    if (Json->TryGetArrayField(TEXT("transform"), Compact))
+    {
+        const int32 Count = Compact->Num();
+        if (Count != 3 && Count != 6 && Count != 9)
+        {
+            return false;
+        }
+
+        FVector* Parts[] = { &Location, &Rotation, &Scale };
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            (*Parts[Index / 3])[Index % 3] = (*Compact)[Index]->AsNumber();
+        }
+    }
+    else if (!TryParseVector(Json, TEXT("location"), Location, Location)
+        || !TryParseVector(Json, TEXT("rotation"), Rotation, Rotation)
+        || !TryParseVector(Json, TEXT("scale"), Scale, Scale))
+    {
+        return false;
+    }
+
+    InOutTransform = FTransform(FRotator(Rotation.X, Rotation.Y, Rotation.Z), Location, Scale);
+    return true;
+}
+
 void FCortexLevelUtils::SetVectorArray(TSharedPtr<FJsonObject> Json, const TCHAR* FieldName, const FVector& Vector)
 {
     TArray<TSharedPtr<FJsonValue>> Values;
@@ -21,7 +21,7 @@ public:
     /** Append a lightweight components array (name + class) to an actor JSON object. */
     static void AppendComponentSummary(AActor* Actor, TSharedPtr<FJsonObject> Json);
 
-    /** Collect up to MaxSuggestions actor labels/names that substring-match the query. */
+    /** Collect up to MaxSuggestions actor labels/names that substring-match the query, then the closest trigram matches. */
     static TSharedPtr<FJsonObject> CollectActorSuggestions(UWorld* World, const FString& Query, int32 MaxSuggestions = 5);
 
     /** Collect component names as suggestions for COMPONENT_NOT_FOUND errors. */
@@ -33,6 +33,13 @@ public:
     /** Parse a required [X,Y,Z] JSON array field. Returns false if field is missing or invalid. */
     static bool ParseVectorField(const TSharedPtr<FJsonObject>& Params, const TCHAR* FieldName, FVector& OutVector);
 
+    /**
+     * Overlay a compact "transform" array ([x,y,z], +[pitch,yaw,roll], +[sx,sy,sz]) or the
+     * location/rotation/scale fields onto InOutTransform; absent parts keep their value.
+     * Returns false only if a field is malformed.
+     */
+    static bool TryParseTransform(const TSharedPtr<FJsonObject>& Json, FTransform& InOutTransform);
+
     /** Serialize a vector as a [X,Y,Z] JSON array field. */
     static void SetVectorArray(TSharedPtr<FJsonObject> Json, const TCHAR* FieldName, const FVector& Vector);
 };
@@ -5,10 +5,14 @@
 #include "CortexLevelModule.h"
 #include "CortexLevelUtils.h"
 #include "CortexTypes.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "CortexPropertyUtils.h"
+#include "CortexSerializer.h"
 #include "Dom/JsonValue.h"
 #include "Editor.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Materials/MaterialInterface.h"
@@ -162,6 +166,193 @@ namespace
         ItemParams->SetStringField(TEXT("actor"), Item.Target);
         return FCortexLevelActorOps::RenameActor(ItemParams);
     }
+
+    /** One resolved spawn_actors entry; everything is loaded and validated before the first spawn. */
+    struct FBulkSpawnEntry
+    {
+        UClass* Class = nullptr;
+        FTransform Transform;
+        FString Label;
+        FName Folder;
+        UStaticMesh* Mesh = nullptr;
+        UMaterialInterface* Material = nullptr;
+        TSharedPtr<FJsonObject> Properties;
+    };
+
+    /** Per-call asset caches so thousands of entries naming the same class or mesh load it once. */
+    struct FBulkSpawnAssets
+    {
+        TMap<FString, UClass*> Classes;
+        TMap<FString, UStaticMesh*> Meshes;
+        TMap<FString, UMaterialInterface*> Materials;
+    };
+
+    FString GetBulkSpawnString(const TSharedPtr<FJsonObject>& Entry, const TSharedPtr<FJsonObject>& Defaults, const TCHAR* FieldName)
+    {
+        FString Value;
+        if (!Entry->TryGetStringField(FieldName, Value) || Value.IsEmpty())
+        {
+            Defaults->TryGetStringField(FieldName, Value);
+        }
+        return Value;
+    }
+
+    template <typename AssetType>
+    AssetType* LoadBulkSpawnAsset(TMap<FString, AssetType*>& Cache, const FString& Path)
+    {
+        if (AssetType** Cached = Cache.Find(Path))
+        {
+            return *Cached;
+        }
+        AssetType* Asset = LoadObject<AssetType>(nullptr, *Path);
+        Cache.Add(Path, Asset);
+        return Asset;
+    }
+
+    bool ParseBulkSpawnEntry(
+        const TSharedPtr<FJsonObject>& Entry,
+        const TSharedPtr<FJsonObject>& Defaults,
+        int32 Index,
+        FBulkSpawnAssets& Assets,
+        FBulkSpawnEntry& Out,
+        FCortexCommandResult& OutError)
+    {
+        const FString ClassIdentifier = GetBulkSpawnString(Entry, Defaults, TEXT("class_name"));
+        if (ClassIdentifier.IsEmpty())
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::ClassNotFound,
+                FString::Printf(TEXT("actors[%d]: missing class_name"), Index));
+            return false;
+        }
+
+        if (UClass** Cached = Assets.Classes.Find(ClassIdentifier))
+        {
+            Out.Class = *Cached;
+        }
+        else
+        {
+            Out.Class = FCortexLevelUtils::ResolveActorClass(ClassIdentifier, OutError);
+            if (!Out.Class)
+            {
+                OutError.ErrorMessage = FString::Printf(TEXT("actors[%d]: %s"), Index, *OutError.ErrorMessage);
+                return false;
+            }
+            Assets.Classes.Add(ClassIdentifier, Out.Class);
+        }
+
+        if (!FCortexLevelUtils::TryParseTransform(Entry, Out.Transform))
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                FString::Printf(TEXT("actors[%d]: transform must be 3, 6 or 9 numbers; location/rotation/scale must be [x,y,z]"), Index));
+            return false;
+        }
+
+        Entry->TryGetStringField(TEXT("label"), Out.Label);
+
+        const FString Folder = GetBulkSpawnString(Entry, Defaults, TEXT("folder"));
+        Out.Folder = Folder.IsEmpty() ? NAME_None : FName(*Folder);
+
+        const FString MeshPath = GetBulkSpawnString(Entry, Defaults, TEXT("mesh"));
+        if (!MeshPath.IsEmpty())
+        {
+            Out.Mesh = LoadBulkSpawnAsset(Assets.Meshes, MeshPath);
+            if (!Out.Mesh)
+            {
+                OutError = FCortexCommandRouter::Error(
+                    CortexErrorCodes::AssetNotFound,
+                    FString::Printf(TEXT("actors[%d]: could not load mesh: %s"), Index, *MeshPath));
+                return false;
+            }
+        }
+
+        const FString MaterialPath = GetBulkSpawnString(Entry, Defaults, TEXT("material"));
+        if (!MaterialPath.IsEmpty())
+        {
+            Out.Material = LoadBulkSpawnAsset(Assets.Materials, MaterialPath);
+            if (!Out.Material)
+            {
+                OutError = FCortexCommandRouter::Error(
+                    CortexErrorCodes::AssetNotFound,
+                    FString::Printf(TEXT("actors[%d]: could not load material: %s"), Index, *MaterialPath));
+                return false;
+            }
+        }
+
+        const TSharedPtr<FJsonObject>* Properties = nullptr;
+        if (Entry->TryGetObjectField(TEXT("properties"), Properties) && Properties && (*Properties)->Values.Num() > 0)
+        {
+            Out.Properties = *Properties;
+        }
+        return true;
+    }
+
+    /** Plain, unlabelled StaticMeshActor spawns can collapse into one instanced component per mesh/material/folder. */
+    bool CanInstanceBulkSpawn(const FBulkSpawnEntry& Entry)
+    {
+        return Entry.Class == AStaticMeshActor::StaticClass()
+            && Entry.Mesh
+            && Entry.Label.IsEmpty()
+            && !Entry.Properties.IsValid();
+    }
+
+    /** Plain actor fields are safe before FinishSpawning; anything reaching through an object reference is not. */
+    bool IsActorLevelPropertyPath(const AActor* Actor, const FString& Path)
+    {
+        int32 SplitIndex = INDEX_NONE;
+        for (int32 CharIndex = 0; CharIndex < Path.Len(); ++CharIndex)
+        {
+            if (Path[CharIndex] == TEXT('.') || Path[CharIndex] == TEXT('['))
+            {
+                SplitIndex = CharIndex;
+                break;
+            }
+        }
+
+        const FString RootName = SplitIndex == INDEX_NONE ? Path : Path.Left(SplitIndex);
+        const FProperty* RootProperty = Actor->GetClass()->FindPropertyByName(FName(*RootName));
+        return RootProperty && !RootProperty->IsA<FObjectPropertyBase>();
+    }
+
+    /**
+     * Applies entry properties in two passes around FinishSpawning. The first pass sets only actor-level
+     * fields so the construction script sees them; component paths (including Blueprint SCS components,
+     * which do not exist until construction) and unresolved names wait for the second pass.
+     */
+    void ApplyBulkSpawnProperties(AActor* Actor, const FBulkSpawnEntry& Entry, int32 Index, bool bConstructed, TArray<FString>& OutWarnings)
+    {
+        if (!Entry.Properties.IsValid())
+        {
+            return;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Entry.Properties->Values)
+        {
+            if (IsActorLevelPropertyPath(Actor, Pair.Key) == bConstructed)
+            {
+                continue;
+            }
+
+            FProperty* Property = nullptr;
+            void* ValuePtr = nullptr;
+            if (!FCortexPropertyUtils::ResolvePropertyPath(Actor, Pair.Key, Property, ValuePtr))
+            {
+                OutWarnings.Add(FString::Printf(TEXT("actors[%d]: property path not found: %s"), Index, *Pair.Key));
+                continue;
+            }
+
+            TArray<FString> PropertyWarnings;
+            if (!FCortexSerializer::JsonToProperty(Pair.Value, Property, ValuePtr, Actor, PropertyWarnings))
+            {
+                OutWarnings.Add(FString::Printf(TEXT("actors[%d]: failed to set property: %s"), Index, *Pair.Key));
+            }
+            for (const FString& Warning : PropertyWarnings)
+            {
+                OutWarnings.Add(FString::Printf(TEXT("actors[%d]: %s"), Index, *Warning));
+            }
+        }
+    }
 }
 
 FCortexCommandResult FCortexLevelActorOps::SpawnActor(const TSharedPtr<FJsonObject>& Params)
@@ -303,6 +494,221 @@ FCortexCommandResult FCortexLevelActorOps::SpawnActor(const TSharedPtr<FJsonObje
     return Result;
 }
 
+FCortexCommandResult FCortexLevelActorOps::SpawnActors(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidValue, TEXT("Missing params"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* EntryValues = nullptr;
+    if (!Params->TryGetArrayField(TEXT("actors"), EntryValues) || EntryValues->Num() == 0)
+    {
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidValue, TEXT("Missing required parameter: actors (non-empty array)"));
+    }
+
+    FCortexCommandResult Error;
+    UWorld* World = FCortexLevelUtils::GetEditorWorld(Error);
+    if (!World)
+    {
+        return Error;
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.ObjectFlags |= RF_Transactional;
+    SpawnParameters.bDeferConstruction = true;
+
+    FString LevelName;
+    if (Params->TryGetStringField(TEXT("level"), LevelName) && !LevelName.IsEmpty())
+    {
+        ULevel* TargetLevel = FCortexLevelUtils::ResolveSublevel(World, LevelName, Error);
+        if (!TargetLevel)
+        {
+            return Error;
+        }
+        SpawnParameters.OverrideLevel = TargetLevel;
+    }
+
+    bool bInstanceStaticMeshes = false;
+    Params->TryGetBoolField(TEXT("instance_static_meshes"), bInstanceStaticMeshes);
+    int32 MinInstances = 2;
+    Params->TryGetNumberField(TEXT("min_instances"), MinInstances);
+    MinInstances = FMath::Max(1, MinInstances);
+
+    // Resolve every entry before touching the level so a bad row leaves nothing half-spawned
+    FBulkSpawnAssets Assets;
+    TArray<FBulkSpawnEntry> Entries;
+    Entries.SetNum(EntryValues->Num());
+    for (int32 Index = 0; Index < EntryValues->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        if (!(*EntryValues)[Index]->TryGetObject(Entry) || !Entry)
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                FString::Printf(TEXT("actors[%d] must be an object"), Index));
+        }
+        if (!ParseBulkSpawnEntry(*Entry, Params, Index, Assets, Entries[Index], Error))
+        {
+            return Error;
+        }
+    }
+
+    // Group instanceable entries by mesh, material and folder; small groups spawn as actors
+    TMap<TTuple<UStaticMesh*, UMaterialInterface*, FName>, TArray<int32>> InstanceGroups;
+    if (bInstanceStaticMeshes)
+    {
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            const FBulkSpawnEntry& Entry = Entries[Index];
+            if (CanInstanceBulkSpawn(Entry))
+            {
+                InstanceGroups.FindOrAdd(MakeTuple(Entry.Mesh, Entry.Material, Entry.Folder)).Add(Index);
+            }
+        }
+        for (auto It = InstanceGroups.CreateIterator(); It; ++It)
+        {
+            if (It.Value().Num() < MinInstances)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    TBitArray<> Instanced(false, Entries.Num());
+    for (const TPair<TTuple<UStaticMesh*, UMaterialInterface*, FName>, TArray<int32>>& Group : InstanceGroups)
+    {
+        for (int32 Index : Group.Value)
+        {
+            Instanced[Index] = true;
+        }
+    }
+
+    FScopedTransaction Transaction(FText::FromString(TEXT("Cortex: Spawn Actors")));
+    TArray<FString> Warnings;
+
+    // Deferred construction: label, folder and actor-level properties land before the construction
+    // script runs, so each actor constructs exactly once. Mesh, material and component properties
+    // wait for FinishSpawning, since Blueprint SCS components only exist after construction.
+    TArray<TSharedPtr<FJsonValue>> SpawnedJson;
+    SpawnedJson.Reserve(Entries.Num());
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        if (Instanced[Index])
+        {
+            continue;
+        }
+
+        const FBulkSpawnEntry& Entry = Entries[Index];
+        AActor* Actor = World->SpawnActor(Entry.Class, &Entry.Transform, SpawnParameters);
+        if (!Actor)
+        {
+            Warnings.Add(FString::Printf(TEXT("actors[%d]: failed to spawn %s"), Index, *Entry.Class->GetName()));
+            continue;
+        }
+
+        if (!Entry.Label.IsEmpty())
+        {
+            Actor->SetActorLabel(Entry.Label);
+        }
+        if (!Entry.Folder.IsNone())
+        {
+            Actor->SetFolderPath(Entry.Folder);
+        }
+
+        ApplyBulkSpawnProperties(Actor, Entry, Index, false, Warnings);
+        Actor->FinishSpawning(Entry.Transform);
+
+        UStaticMeshComponent* MeshComponent = (Entry.Mesh || Entry.Material) ? Actor->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+        if (MeshComponent)
+        {
+            if (Entry.Mesh)
+            {
+                MeshComponent->SetStaticMesh(Entry.Mesh);
+            }
+            if (Entry.Material)
+            {
+                MeshComponent->SetMaterial(0, Entry.Material);
+            }
+        }
+        else if (Entry.Mesh || Entry.Material)
+        {
+            Warnings.Add(FString::Printf(TEXT("actors[%d]: actor has no StaticMeshComponent; mesh/material ignored"), Index));
+        }
+
+        ApplyBulkSpawnProperties(Actor, Entry, Index, true, Warnings);
+
+        TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
+        ActorJson->SetNumberField(TEXT("index"), Index);
+        ActorJson->SetStringField(TEXT("name"), Actor->GetName());
+        ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
+        ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+        SpawnedJson.Add(MakeShared<FJsonValueObject>(ActorJson));
+    }
+
+    // One host actor per group; its component builds render and physics state once for all instances
+    TArray<TSharedPtr<FJsonValue>> InstancedJson;
+    int32 InstanceCount = 0;
+    SpawnParameters.bDeferConstruction = false;
+    for (const TPair<TTuple<UStaticMesh*, UMaterialInterface*, FName>, TArray<int32>>& Group : InstanceGroups)
+    {
+        UStaticMesh* Mesh = Group.Key.Get<0>();
+        UMaterialInterface* Material = Group.Key.Get<1>();
+        const FName Folder = Group.Key.Get<2>();
+
+        AActor* Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+        if (!Host)
+        {
+            Warnings.Add(FString::Printf(TEXT("Failed to spawn instance host for mesh: %s"), *Mesh->GetPathName()));
+            continue;
+        }
+
+        UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(Host, TEXT("InstancedStaticMesh"), RF_Transactional);
+        Component->SetMobility(EComponentMobility::Static);
+        Component->SetStaticMesh(Mesh);
+        if (Material)
+        {
+            Component->SetMaterial(0, Material);
+        }
+        Host->SetRootComponent(Component);
+        Host->AddInstanceComponent(Component);
+        Component->RegisterComponent();
+
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(Group.Value.Num());
+        for (int32 Index : Group.Value)
+        {
+            Transforms.Add(Entries[Index].Transform);
+        }
+        Component->AddInstances(Transforms, false, true);
+        InstanceCount += Transforms.Num();
+
+        Host->SetActorLabel(FString::Printf(TEXT("%s_Instances"), *Mesh->GetName()));
+        if (!Folder.IsNone())
+        {
+            Host->SetFolderPath(Folder);
+        }
+
+        TSharedPtr<FJsonObject> HostJson = MakeShared<FJsonObject>();
+        HostJson->SetStringField(TEXT("name"), Host->GetName());
+        HostJson->SetStringField(TEXT("label"), Host->GetActorLabel());
+        HostJson->SetStringField(TEXT("mesh"), Mesh->GetPathName());
+        HostJson->SetNumberField(TEXT("instance_count"), Transforms.Num());
+        InstancedJson.Add(MakeShared<FJsonValueObject>(HostJson));
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetArrayField(TEXT("spawned"), SpawnedJson);
+    Data->SetNumberField(TEXT("spawned_count"), SpawnedJson.Num());
+    Data->SetArrayField(TEXT("instanced"), InstancedJson);
+    Data->SetNumberField(TEXT("instance_count"), InstanceCount);
+    Data->SetNumberField(TEXT("requested_count"), Entries.Num());
+
+    FCortexCommandResult Result = FCortexCommandRouter::Success(Data);
+    Result.Warnings = MoveTemp(Warnings);
+    return Result;
+}
+
 FCortexCommandResult FCortexLevelActorOps::DeleteActor(const TSharedPtr<FJsonObject>& Params)
 {
     if (Params.IsValid() && Params->HasField(TEXT("items")))
@@ -7,6 +7,7 @@ class FCortexLevelActorOps
 {
 public:
     static FCortexCommandResult SpawnActor(const TSharedPtr<FJsonObject>& Params);
+    static FCortexCommandResult SpawnActors(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult DeleteActor(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult DuplicateActor(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult RenameActor(const TSharedPtr<FJsonObject>& Params);
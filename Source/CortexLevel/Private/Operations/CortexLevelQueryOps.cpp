@@ -1,5 +1,7 @@
 #include "Operations/CortexLevelQueryOps.h"
 
+#include "CortexActorSpatialIndex.h"
+#include "CortexLevelPartition.h"
 #include "CortexLevelUtils.h"
 #include "CortexTypes.h"
 #include "Dom/JsonValue.h"
@@ -7,6 +9,7 @@
 #include "Engine/Selection.h"
 #include "EngineUtils.h"
 #include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
 
 namespace
 {
@@ -81,14 +84,13 @@ namespace
         return true;
     }
 
-    bool PassesRegionFilter(AActor* Actor, const FRegionFilter& Region)
+    bool IsInsideRegion(const FVector& Location, const FRegionFilter& Region)
     {
         if (!Region.bEnabled)
         {
             return true;
         }
 
-        const FVector Location = Actor->GetActorLocation();
         if (Region.bSphere)
         {
             return FVector::DistSquared(Location, Region.Center) <= FMath::Square(Region.Radius);
@@ -100,8 +102,135 @@ namespace
             FMath::Abs(Delta.Z) <= Region.Extent.Z;
     }
 
-    TArray<AActor*> CollectFilteredActors(UWorld* World, const TSharedPtr<FJsonObject>& Params, FCortexCommandResult& OutError)
+    bool PassesRegionFilter(AActor* Actor, const FRegionFilter& Region)
+    {
+        return !Region.bEnabled || IsInsideRegion(Actor->GetActorLocation(), Region);
+    }
+
+    /** A query hit: a loaded actor, or the descriptor of an unloaded World Partition actor. */
+    struct FActorQueryEntry
+    {
+        AActor* Actor = nullptr;
+        TSharedPtr<const FCortexUnloadedActor> Unloaded;
+
+        const FString& GetLabel() const { return Unloaded.IsValid() ? Unloaded->Label : Actor->GetActorLabel(); }
+        FVector GetLocation() const { return Unloaded.IsValid() ? Unloaded->GetLocation() : Actor->GetActorLocation(); }
+    };
+
+    struct FActorQueryResult
+    {
+        TArray<FActorQueryEntry> Entries;
+        int32 UnloadedCount = 0;
+        bool bPartitioned = false;
+    };
+
+    enum class EActorSort : uint8
+    {
+        None,
+        Label,
+        Name,
+        Class,
+        Folder,
+    };
+
+    bool ParseActorSort(const TSharedPtr<FJsonObject>& Params, EActorSort& OutSort)
+    {
+        FString SortBy;
+        if (!Params->TryGetStringField(TEXT("sort"), SortBy) || SortBy.IsEmpty() || SortBy == TEXT("label"))
+        {
+            OutSort = EActorSort::Label;
+        }
+        else if (SortBy == TEXT("name"))
+        {
+            OutSort = EActorSort::Name;
+        }
+        else if (SortBy == TEXT("class"))
+        {
+            OutSort = EActorSort::Class;
+        }
+        else if (SortBy == TEXT("folder"))
+        {
+            OutSort = EActorSort::Folder;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /** Sort by precomputed keys (primary, then label) instead of re-reading actors inside the comparator. */
+    void SortActors(TArray<FActorQueryEntry>& Entries, EActorSort Sort)
     {
+        if (Sort == EActorSort::None)
+        {
+            return;
+        }
+
+        struct FSortKey
+        {
+            FString Primary;
+            const FString* Label;
+            int32 Index;
+        };
+
+        TArray<FSortKey> Keys;
+        Keys.Reserve(Entries.Num());
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            const FActorQueryEntry& Entry = Entries[Index];
+            FSortKey& Key = Keys.Emplace_GetRef();
+            Key.Label = &Entry.GetLabel();
+            Key.Index = Index;
+
+            const FCortexUnloadedActor* Unloaded = Entry.Unloaded.Get();
+            switch (Sort)
+            {
+            case EActorSort::Name:
+                Key.Primary = Unloaded ? Unloaded->Name : Entry.Actor->GetName();
+                break;
+            case EActorSort::Class:
+                Key.Primary = Unloaded ? Unloaded->ClassName : Entry.Actor->GetClass()->GetName();
+                break;
+            case EActorSort::Folder:
+                Key.Primary = (Unloaded ? Unloaded->Folder : Entry.Actor->GetFolderPath()).ToString();
+                break;
+            default:
+                break;
+            }
+        }
+
+        Keys.Sort([](const FSortKey& A, const FSortKey& B)
+        {
+            const int32 Primary = A.Primary.Compare(B.Primary, ESearchCase::IgnoreCase);
+            return Primary != 0 ? Primary < 0 : *A.Label < *B.Label;
+        });
+
+        TArray<FActorQueryEntry> Sorted;
+        Sorted.Reserve(Entries.Num());
+        for (const FSortKey& Key : Keys)
+        {
+            Sorted.Add(MoveTemp(Entries[Key.Index]));
+        }
+        Entries = MoveTemp(Sorted);
+    }
+
+    /**
+     * Loaded actors passing the class/tags/folder/region filters, followed on partitioned maps
+     * (unless loaded_only) by unloaded actors matched from their descriptors. Descriptors carry
+     * no actor tags, so a tags filter only ever matches loaded actors.
+     */
+    FActorQueryResult CollectFilteredActors(UWorld* World, const TSharedPtr<FJsonObject>& Params, FCortexCommandResult& OutError, bool bSorted = true)
+    {
+        EActorSort Sort = EActorSort::None;
+        if (bSorted && !ParseActorSort(Params, Sort))
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                TEXT("Invalid sort; expected label, name, class or folder"));
+            return {};
+        }
+
         FString ClassFilter;
         Params->TryGetStringField(TEXT("class"), ClassFilter);
 
@@ -127,6 +256,7 @@ namespace
 
         FString FolderFilter;
         Params->TryGetStringField(TEXT("folder"), FolderFilter);
+        const FName FolderName(*FolderFilter, FNAME_Find);
 
         FRegionFilter Region;
         if (!ParseRegionFilter(Params, Region))
@@ -135,53 +265,140 @@ namespace
             return {};
         }
 
-        TArray<AActor*> Actors;
-        int32 ScannedCount = 0;
-        constexpr int32 MaxScanCount = 10000;
-
-        for (TActorIterator<AActor> It(World, FilterClass ? FilterClass : AActor::StaticClass()); It; ++It)
+        auto PassesFilters = [FilterClass, &RequiredTags, &FolderFilter, FolderName, &Region](AActor* Actor)
         {
-            if (++ScannedCount > MaxScanCount)
+            if (!IsValid(Actor) || (FilterClass && !Actor->IsA(FilterClass)))
             {
-                break;
+                return false;
             }
 
-            AActor* Actor = *It;
-            if (!IsValid(Actor))
+            if (!RequiredTags.IsEmpty() && !PassesTagsFilter(Actor, RequiredTags))
             {
-                continue;
+                return false;
             }
 
-            if (!RequiredTags.IsEmpty() && !PassesTagsFilter(Actor, RequiredTags))
+            if (!FolderFilter.IsEmpty() && (FolderName.IsNone() || Actor->GetFolderPath() != FolderName))
             {
-                continue;
+                return false;
             }
 
-            if (!FolderFilter.IsEmpty() && Actor->GetFolderPath().ToString() != FolderFilter)
+            return PassesRegionFilter(Actor, Region);
+        };
+
+        FActorQueryResult Result;
+        TArray<FActorQueryEntry>& Entries = Result.Entries;
+        if (Region.bEnabled)
+        {
+            // Region queries only visit the spatial index cells overlapping the region
+            TArray<AActor*> Candidates;
+            FCortexActorSpatialIndex& SpatialIndex = FCortexActorSpatialIndex::Get(World);
+            if (Region.bSphere)
             {
-                continue;
+                SpatialIndex.QuerySphere(Region.Center, Region.Radius, Candidates);
             }
-
-            if (!PassesRegionFilter(Actor, Region))
+            else
             {
-                continue;
+                SpatialIndex.QueryBox(FBox(Region.Center - Region.Extent, Region.Center + Region.Extent), Candidates);
             }
 
-            Actors.Add(Actor);
+            for (AActor* Actor : Candidates)
+            {
+                if (PassesFilters(Actor))
+                {
+                    Entries.Add({ Actor });
+                }
+            }
+        }
+        else
+        {
+            for (TActorIterator<AActor> It(World, FilterClass ? FilterClass : AActor::StaticClass()); It; ++It)
+            {
+                if (PassesFilters(*It))
+                {
+                    Entries.Add({ *It });
+                }
+            }
         }
 
-        Actors.Sort([](const AActor& A, const AActor& B)
+        bool bLoadedOnly = false;
+        Params->TryGetBoolField(TEXT("loaded_only"), bLoadedOnly);
+        Result.bPartitioned = FCortexLevelPartition::IsPartitioned(World);
+        if (Result.bPartitioned && !bLoadedOnly && RequiredTags.IsEmpty())
         {
-            return A.GetActorLabel() < B.GetActorLabel();
-        });
+            FCortexLevelPartition::ForEachUnloadedActor(World, FilterClass, [&](const FCortexUnloadedActor& Unloaded)
+            {
+                if ((FolderFilter.IsEmpty() || (!FolderName.IsNone() && Unloaded.Folder == FolderName))
+                    && IsInsideRegion(Unloaded.GetLocation(), Region))
+                {
+                    Entries.Add({ nullptr, MakeShared<const FCortexUnloadedActor>(Unloaded) });
+                    ++Result.UnloadedCount;
+                }
+            });
+        }
 
-        return Actors;
+        SortActors(Entries, Sort);
+        return Result;
     }
 
     TSharedPtr<FJsonObject> ToSummary(AActor* Actor)
     {
         return FCortexLevelUtils::SerializeActorSummary(Actor);
     }
+
+    /** Filtered, sorted list_actors result kept server-side so later pages skip the scan and sort. */
+    struct FActorListSnapshotEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        TSharedPtr<const FCortexUnloadedActor> Unloaded;
+    };
+
+    struct FActorListSnapshot
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<FActorListSnapshotEntry> Entries;
+        int32 UnloadedCount = 0;
+        bool bPartitioned = false;
+        int32 NextOffset = 0;
+        double LastAccessTime = 0.0;
+    };
+
+    /** Idle snapshots expire after this long; the oldest is evicted past MaxActorListSnapshots. */
+    constexpr double ActorListSnapshotTtlSeconds = 300.0;
+    constexpr int32 MaxActorListSnapshots = 8;
+
+    TMap<FString, FActorListSnapshot>& GetActorListSnapshots()
+    {
+        static TMap<FString, FActorListSnapshot> Snapshots;
+        return Snapshots;
+    }
+
+    void PruneActorListSnapshots(const UWorld* CurrentWorld, double Now)
+    {
+        TMap<FString, FActorListSnapshot>& Snapshots = GetActorListSnapshots();
+        for (auto It = Snapshots.CreateIterator(); It; ++It)
+        {
+            const FActorListSnapshot& Snapshot = It.Value();
+            if (Snapshot.World.Get() != CurrentWorld || Now - Snapshot.LastAccessTime > ActorListSnapshotTtlSeconds)
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        while (Snapshots.Num() >= MaxActorListSnapshots)
+        {
+            const FString* OldestCursor = nullptr;
+            double OldestTime = TNumericLimits<double>::Max();
+            for (const TPair<FString, FActorListSnapshot>& Pair : Snapshots)
+            {
+                if (Pair.Value.LastAccessTime < OldestTime)
+                {
+                    OldestCursor = &Pair.Key;
+                    OldestTime = Pair.Value.LastAccessTime;
+                }
+            }
+            Snapshots.Remove(FString(*OldestCursor));
+        }
+    }
 }
 
 FCortexCommandResult FCortexLevelQueryOps::ListActors(const TSharedPtr<FJsonObject>& Params)
@@ -198,27 +415,71 @@ FCortexCommandResult FCortexLevelQueryOps::ListActors(const TSharedPtr<FJsonObje
         return Error;
     }
 
-    TArray<AActor*> Actors = CollectFilteredActors(World, Params, Error);
-    if (!Error.ErrorCode.IsEmpty())
-    {
-        return Error;
-    }
-
     int32 Offset = 0;
     int32 Limit = 100;
-    Params->TryGetNumberField(TEXT("offset"), Offset);
+    const bool bHasOffset = Params->TryGetNumberField(TEXT("offset"), Offset);
     Params->TryGetNumberField(TEXT("limit"), Limit);
-
-    Offset = FMath::Max(0, Offset);
     Limit = FMath::Clamp(Limit, 1, 1000);
 
-    const int32 Total = Actors.Num();
+    const double Now = FPlatformTime::Seconds();
+    PruneActorListSnapshots(World, Now);
+    TMap<FString, FActorListSnapshot>& Snapshots = GetActorListSnapshots();
+
+    // A cursor pages through the snapshot taken by the first call; filters are not re-read
+    FString Cursor;
+    Params->TryGetStringField(TEXT("cursor"), Cursor);
+    FActorListSnapshot* Snapshot = nullptr;
+    if (!Cursor.IsEmpty())
+    {
+        Snapshot = Snapshots.Find(Cursor);
+        if (!Snapshot)
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                FString::Printf(TEXT("Cursor expired or unknown: %s. Re-run list_actors without a cursor."), *Cursor));
+        }
+        if (!bHasOffset)
+        {
+            Offset = Snapshot->NextOffset;
+        }
+    }
+    else
+    {
+        FActorQueryResult Query = CollectFilteredActors(World, Params, Error);
+        if (!Error.ErrorCode.IsEmpty())
+        {
+            return Error;
+        }
+
+        Cursor = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+        Snapshot = &Snapshots.Add(Cursor);
+        Snapshot->World = World;
+        Snapshot->UnloadedCount = Query.UnloadedCount;
+        Snapshot->bPartitioned = Query.bPartitioned;
+        Snapshot->Entries.Reserve(Query.Entries.Num());
+        for (FActorQueryEntry& Entry : Query.Entries)
+        {
+            Snapshot->Entries.Add({ Entry.Actor, MoveTemp(Entry.Unloaded) });
+        }
+    }
+
+    Offset = FMath::Max(0, Offset);
+    const int32 Total = Snapshot->Entries.Num();
     const int32 End = FMath::Min(Total, Offset + Limit);
 
+    // Actors deleted since the snapshot are skipped, so a page may come back short
     TArray<TSharedPtr<FJsonValue>> Results;
     for (int32 Index = Offset; Index < End; ++Index)
     {
-        Results.Add(MakeShared<FJsonValueObject>(ToSummary(Actors[Index])));
+        const FActorListSnapshotEntry& Entry = Snapshot->Entries[Index];
+        if (Entry.Unloaded.IsValid())
+        {
+            Results.Add(MakeShared<FJsonValueObject>(FCortexLevelPartition::SerializeSummary(*Entry.Unloaded)));
+        }
+        else if (AActor* Actor = Entry.Actor.Get(); IsValid(Actor))
+        {
+            Results.Add(MakeShared<FJsonValueObject>(ToSummary(Actor)));
+        }
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
@@ -227,6 +488,25 @@ FCortexCommandResult FCortexLevelQueryOps::ListActors(const TSharedPtr<FJsonObje
     Data->SetNumberField(TEXT("total"), Total);
     Data->SetNumberField(TEXT("offset"), Offset);
     Data->SetNumberField(TEXT("limit"), Limit);
+    if (Snapshot->bPartitioned)
+    {
+        Data->SetNumberField(TEXT("unloaded_count"), Snapshot->UnloadedCount);
+    }
+
+    const bool bHasMore = End < Total;
+    Data->SetBoolField(TEXT("has_more"), bHasMore);
+    if (bHasMore)
+    {
+        Snapshot->NextOffset = End;
+        Snapshot->LastAccessTime = Now;
+        Data->SetStringField(TEXT("cursor"), Cursor);
+        Data->SetNumberField(TEXT("next_offset"), End);
+        Data->SetNumberField(TEXT("cursor_ttl_seconds"), ActorListSnapshotTtlSeconds);
+    }
+    else
+    {
+        Snapshots.Remove(Cursor);
+    }
     return FCortexCommandRouter::Success(Data);
 }
 
@@ -250,6 +530,8 @@ FCortexCommandResult FCortexLevelQueryOps::FindActors(const TSharedPtr<FJsonObje
 
     bool bIncludeComponents = false;
     Params->TryGetBoolField(TEXT("include_components"), bIncludeComponents);
+    bool bLoadedOnly = false;
+    Params->TryGetBoolField(TEXT("loaded_only"), bLoadedOnly);
 
     FCortexCommandResult Error;
     UWorld* World = FCortexLevelUtils::GetEditorWorld(Error);
@@ -280,10 +562,29 @@ FCortexCommandResult FCortexLevelQueryOps::FindActors(const TSharedPtr<FJsonObje
         }
     }
 
+    // Partitioned maps: match unloaded actors by descriptor label and name without loading them
+    const bool bPartitioned = FCortexLevelPartition::IsPartitioned(World);
+    int32 UnloadedCount = 0;
+    if (bPartitioned && !bLoadedOnly)
+    {
+        FCortexLevelPartition::ForEachUnloadedActor(World, nullptr, [&](const FCortexUnloadedActor& Unloaded)
+        {
+            if (Unloaded.Label.MatchesWildcard(Pattern) || Unloaded.Name.MatchesWildcard(Pattern))
+            {
+                Matches.Add(MakeShared<FJsonValueObject>(FCortexLevelPartition::SerializeSummary(Unloaded)));
+                ++UnloadedCount;
+            }
+        });
+    }
+
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
     Data->SetArrayField(TEXT("matches"), Matches);
     Data->SetNumberField(TEXT("count"), Matches.Num());
     Data->SetStringField(TEXT("pattern"), Pattern);
+    if (bPartitioned)
+    {
+        Data->SetNumberField(TEXT("unloaded_count"), UnloadedCount);
+    }
     return FCortexCommandRouter::Success(Data);
 }
 
@@ -296,13 +597,13 @@ FCortexCommandResult FCortexLevelQueryOps::GetBounds(const TSharedPtr<FJsonObjec
         return Error;
     }
 
-    TArray<AActor*> Actors = CollectFilteredActors(World, Params ? Params : MakeShared<FJsonObject>(), Error);
+    const FActorQueryResult Query = CollectFilteredActors(World, Params ? Params : MakeShared<FJsonObject>(), Error, false);
     if (!Error.ErrorCode.IsEmpty())
     {
         return Error;
     }
 
-    if (Actors.Num() == 0)
+    if (Query.Entries.Num() == 0)
     {
         return FCortexCommandRouter::Error(CortexErrorCodes::ActorNotFound, TEXT("No actors matched filters"));
     }
@@ -310,9 +611,9 @@ FCortexCommandResult FCortexLevelQueryOps::GetBounds(const TSharedPtr<FJsonObjec
     FVector Min = FVector(FLT_MAX);
     FVector Max = FVector(-FLT_MAX);
 
-    for (AActor* Actor : Actors)
+    for (const FActorQueryEntry& Entry : Query.Entries)
     {
-        const FVector Location = Actor->GetActorLocation();
+        const FVector Location = Entry.GetLocation();
         Min.X = FMath::Min(Min.X, Location.X);
         Min.Y = FMath::Min(Min.Y, Location.Y);
         Min.Z = FMath::Min(Min.Z, Location.Z);
@@ -330,7 +631,11 @@ FCortexCommandResult FCortexLevelQueryOps::GetBounds(const TSharedPtr<FJsonObjec
     FCortexLevelUtils::SetVectorArray(Data, TEXT("max"), Max);
     FCortexLevelUtils::SetVectorArray(Data, TEXT("center"), Center);
     FCortexLevelUtils::SetVectorArray(Data, TEXT("extent"), Extent);
-    Data->SetNumberField(TEXT("actor_count"), Actors.Num());
+    Data->SetNumberField(TEXT("actor_count"), Query.Entries.Num());
+    if (Query.bPartitioned)
+    {
+        Data->SetNumberField(TEXT("unloaded_count"), Query.UnloadedCount);
+    }
     return FCortexCommandRouter::Success(Data);
 }
 
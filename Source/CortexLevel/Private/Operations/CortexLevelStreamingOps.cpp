@@ -1,10 +1,12 @@
 #include "Operations/CortexLevelStreamingOps.h"
 
 #include "EngineUtils.h"
+#include "CortexLevelPackageSaver.h"
 #include "CortexLevelUtils.h"
 #include "CortexTypes.h"
 #include "DataLayer/DataLayerEditorSubsystem.h"
 #include "Dom/JsonValue.h"
+#include "Engine/Level.h"
 #include "Engine/LevelStreaming.h"
 #include "FileHelpers.h"
 #include "GameFramework/Actor.h"
@@ -14,6 +16,17 @@
 
 namespace
 {
+    FCortexLevelPackageSaver::FOptions ParseSaveOptions(const TSharedPtr<FJsonObject>& Params)
+    {
+        FCortexLevelPackageSaver::FOptions Options;
+        if (Params.IsValid())
+        {
+            Params->TryGetBoolField(TEXT("dry_run"), Options.bDryRun);
+            Params->TryGetBoolField(TEXT("concurrent"), Options.bConcurrent);
+        }
+        return Options;
+    }
+
     FString WorldTypeToString(EWorldType::Type Type)
     {
         switch (Type)
@@ -348,8 +361,6 @@ FCortexCommandResult FCortexLevelStreamingOps::SetDataLayer(const TSharedPtr<FJs
 
 FCortexCommandResult FCortexLevelStreamingOps::SaveLevel(const TSharedPtr<FJsonObject>& Params)
 {
-    (void)Params;
-
     FCortexCommandResult Error;
     UWorld* World = FCortexLevelUtils::GetEditorWorld(Error);
     if (!World)
@@ -363,30 +374,38 @@ FCortexCommandResult FCortexLevelStreamingOps::SaveLevel(const TSharedPtr<FJsonO
         return FCortexCommandRouter::Error(CortexErrorCodes::InvalidOperation, TEXT("Persistent level unavailable"));
     }
 
-    const bool bSaved = FEditorFileUtils::SaveLevel(PersistentLevel);
-    if (!bSaved)
+    // The map package always saves, like FEditorFileUtils::SaveLevel; its external actor packages only when dirty
+    FCortexLevelPackageSaver Saver;
+    Saver.Add(PersistentLevel->GetOutermost());
+    for (UPackage* Package : PersistentLevel->GetLoadedExternalObjectPackages())
     {
-        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidOperation, TEXT("Failed to save current level"));
+        if (Package && Package->IsDirty())
+        {
+            Saver.Add(Package);
+        }
+    }
+    if (PersistentLevel->IsUsingExternalActors())
+    {
+        Saver.AddDeletedExternalPackages(ULevel::GetExternalActorsPath(PersistentLevel->GetOutermost()->GetName()));
     }
 
-    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    TSharedPtr<FJsonObject> Data;
+    const bool bSaved = Saver.Save(ParseSaveOptions(Params), Data);
     Data->SetStringField(TEXT("level"), World->GetMapName());
-    Data->SetBoolField(TEXT("saved"), true);
+    if (!bSaved)
+    {
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidOperation, TEXT("Failed to save current level"), Data);
+    }
     return FCortexCommandRouter::Success(Data);
 }
 
 FCortexCommandResult FCortexLevelStreamingOps::SaveAll(const TSharedPtr<FJsonObject>& Params)
 {
-    (void)Params;
+    FCortexLevelPackageSaver Saver;
+    Saver.AddDirtyPackages(/*bIncludeContent*/true);
 
-    const bool bSaved = FEditorFileUtils::SaveDirtyPackages(
-        /*bPromptUserToSave*/false,
-        /*bSaveMapPackages*/true,
-        /*bSaveContentPackages*/true,
-        /*bFastSave*/true
-    );
-
-    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("saved"), bSaved);
+    // Partial failures are reported per package; the command itself succeeds as before
+    TSharedPtr<FJsonObject> Data;
+    Saver.Save(ParseSaveOptions(Params), Data);
     return FCortexCommandRouter::Success(Data);
 }
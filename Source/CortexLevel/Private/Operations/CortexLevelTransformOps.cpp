@@ -158,6 +158,81 @@ FCortexCommandResult FCortexLevelTransformOps::SetTransform(const TSharedPtr<FJs
     return FCortexCommandRouter::Success(SerializeActorDetails(Actor));
 }
 
+FCortexCommandResult FCortexLevelTransformOps::SetTransforms(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidValue, TEXT("Missing params"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* EntryValues = nullptr;
+    if (!Params->TryGetArrayField(TEXT("transforms"), EntryValues) || EntryValues->Num() == 0)
+    {
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidValue, TEXT("Missing required parameter: transforms (non-empty array)"));
+    }
+
+    FCortexCommandResult Error;
+    UWorld* World = FCortexLevelUtils::GetEditorWorld(Error);
+    if (!World)
+    {
+        return Error;
+    }
+
+    // Resolve and parse everything first so a bad entry leaves every actor untouched
+    TArray<TPair<AActor*, FTransform>> Updates;
+    Updates.Reserve(EntryValues->Num());
+    for (int32 Index = 0; Index < EntryValues->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        FString ActorIdentifier;
+        if (!(*EntryValues)[Index]->TryGetObject(Entry) || !Entry
+            || !(*Entry)->TryGetStringField(TEXT("actor"), ActorIdentifier) || ActorIdentifier.IsEmpty())
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                FString::Printf(TEXT("transforms[%d] must be an object with an actor identifier"), Index));
+        }
+
+        AActor* Actor = FCortexLevelUtils::FindActorByLabelOrPath(World, ActorIdentifier, Error);
+        if (!Actor)
+        {
+            Error.ErrorMessage = FString::Printf(TEXT("transforms[%d]: %s"), Index, *Error.ErrorMessage);
+            return Error;
+        }
+
+        FTransform Transform = Actor->GetActorTransform();
+        if (!FCortexLevelUtils::TryParseTransform(*Entry, Transform))
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidValue,
+                FString::Printf(TEXT("transforms[%d]: transform must be 3, 6 or 9 numbers; location/rotation/scale must be [x,y,z]"), Index));
+        }
+        Updates.Emplace(Actor, Transform);
+    }
+
+    FScopedTransaction Transaction(FText::FromString(TEXT("Cortex: Set Actor Transforms")));
+
+    // One SetActorTransform per actor: a single component transform update instead of three
+    TArray<TSharedPtr<FJsonValue>> Updated;
+    Updated.Reserve(Updates.Num());
+    for (const TPair<AActor*, FTransform>& Update : Updates)
+    {
+        AActor* Actor = Update.Key;
+        Actor->Modify();
+        Actor->SetActorTransform(Update.Value);
+
+        TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
+        ActorJson->SetStringField(TEXT("name"), Actor->GetName());
+        ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
+        Updated.Add(MakeShared<FJsonValueObject>(ActorJson));
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetArrayField(TEXT("updated"), Updated);
+    Data->SetNumberField(TEXT("count"), Updated.Num());
+    return FCortexCommandRouter::Success(Data);
+}
+
 FCortexCommandResult FCortexLevelTransformOps::SetActorProperty(const TSharedPtr<FJsonObject>& Params)
 {
     if (!Params.IsValid())
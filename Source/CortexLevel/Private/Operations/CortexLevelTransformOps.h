@@ -8,6 +8,7 @@ class FCortexLevelTransformOps
 public:
     static FCortexCommandResult GetActor(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult SetTransform(const TSharedPtr<FJsonObject>& Params);
+    static FCortexCommandResult SetTransforms(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult SetActorProperty(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult GetActorProperty(const TSharedPtr<FJsonObject>& Params);
 };
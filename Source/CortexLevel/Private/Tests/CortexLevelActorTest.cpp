@@ -1,9 +1,20 @@
 #include "Misc/AutomationTest.h"
 #include "CortexCommandRouter.h"
 #include "CortexLevelCommandHandler.h"
+#include "Components/StaticMeshComponent.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/Guid.h"
 
 namespace
 {
@@ -227,3 +238,223 @@ bool FCortexLevelRenameActorTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelSpawnActorsBulkTest,
+    "Cortex.Level.Actor.SpawnActorsBulk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelSpawnActorsBulkTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouter();
+
+    auto MakeNumbers = [](std::initializer_list<double> Values)
+    {
+        TArray<TSharedPtr<FJsonValue>> Out;
+        for (double Value : Values)
+        {
+            Out.Add(MakeShared<FJsonValueNumber>(Value));
+        }
+        return Out;
+    };
+
+    // Three labelled lights stay actors; four identical cubes collapse into one instanced host
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("class_name"), TEXT("PointLight"));
+        Entry->SetStringField(TEXT("label"), FString::Printf(TEXT("BulkLight%d"), Index));
+        Entry->SetArrayField(TEXT("transform"), MakeNumbers({ 100.0 * Index, 0.0, 50.0 }));
+        Entries.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("class_name"), TEXT("StaticMeshActor"));
+        Entry->SetArrayField(TEXT("transform"), MakeNumbers({ 100.0 * Index, 500.0, 0.0, 0.0, 45.0, 0.0, 2.0, 2.0, 2.0 }));
+        Entries.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetArrayField(TEXT("actors"), Entries);
+    Params->SetStringField(TEXT("mesh"), TEXT("/Engine/BasicShapes/Cube.Cube"));
+    Params->SetStringField(TEXT("folder"), TEXT("CortexBulkTest"));
+    Params->SetBoolField(TEXT("instance_static_meshes"), true);
+
+    FCortexCommandResult Result = Router.Execute(TEXT("level.spawn_actors"), Params);
+    TestTrue(TEXT("spawn_actors should succeed"), Result.bSuccess);
+    if (!Result.bSuccess || !Result.Data.IsValid())
+    {
+        return true;
+    }
+
+    TestEqual(TEXT("Lights spawned as actors"), static_cast<int32>(Result.Data->GetNumberField(TEXT("spawned_count"))), 3);
+    TestEqual(TEXT("Cubes became instances"), static_cast<int32>(Result.Data->GetNumberField(TEXT("instance_count"))), 4);
+
+    TArray<FString> Created;
+    for (const TSharedPtr<FJsonValue>& Value : Result.Data->GetArrayField(TEXT("spawned")))
+    {
+        Created.Add(Value->AsObject()->GetStringField(TEXT("name")));
+    }
+    const TArray<TSharedPtr<FJsonValue>>& Hosts = Result.Data->GetArrayField(TEXT("instanced"));
+    TestEqual(TEXT("One instanced host"), Hosts.Num(), 1);
+    for (const TSharedPtr<FJsonValue>& Value : Hosts)
+    {
+        Created.Add(Value->AsObject()->GetStringField(TEXT("name")));
+    }
+
+    // A bad entry rejects the whole batch before anything spawns
+    TSharedPtr<FJsonObject> BadEntry = MakeShared<FJsonObject>();
+    BadEntry->SetStringField(TEXT("class_name"), TEXT("PointLight"));
+    BadEntry->SetArrayField(TEXT("transform"), MakeNumbers({ 1.0, 2.0 }));
+    TSharedPtr<FJsonObject> BadParams = MakeShared<FJsonObject>();
+    BadParams->SetArrayField(TEXT("actors"), { MakeShared<FJsonValueObject>(BadEntry) });
+    TestFalse(TEXT("Malformed transform should be rejected"), Router.Execute(TEXT("level.spawn_actors"), BadParams).bSuccess);
+
+    // Move all three lights in one call, touching only location
+    TArray<TSharedPtr<FJsonValue>> Moves;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        TSharedPtr<FJsonObject> Move = MakeShared<FJsonObject>();
+        Move->SetStringField(TEXT("actor"), FString::Printf(TEXT("BulkLight%d"), Index));
+        Move->SetArrayField(TEXT("location"), MakeNumbers({ 0.0, 1000.0 + Index, 0.0 }));
+        Moves.Add(MakeShared<FJsonValueObject>(Move));
+    }
+    TSharedPtr<FJsonObject> MoveParams = MakeShared<FJsonObject>();
+    MoveParams->SetArrayField(TEXT("transforms"), Moves);
+    FCortexCommandResult MoveResult = Router.Execute(TEXT("level.set_transforms"), MoveParams);
+    TestTrue(TEXT("set_transforms should succeed"), MoveResult.bSuccess);
+    if (MoveResult.bSuccess && MoveResult.Data.IsValid())
+    {
+        TestEqual(TEXT("All lights moved"), static_cast<int32>(MoveResult.Data->GetNumberField(TEXT("count"))), 3);
+    }
+
+    TSharedPtr<FJsonObject> GetParams = MakeShared<FJsonObject>();
+    GetParams->SetStringField(TEXT("actor"), TEXT("BulkLight2"));
+    FCortexCommandResult GetResult = Router.Execute(TEXT("level.get_actor"), GetParams);
+    if (TestTrue(TEXT("get_actor should succeed"), GetResult.bSuccess) && GetResult.Data.IsValid())
+    {
+        const TArray<TSharedPtr<FJsonValue>>& Location = GetResult.Data->GetArrayField(TEXT("location"));
+        TestEqual(TEXT("Moved Y"), Location[1]->AsNumber(), 1002.0, 0.01);
+    }
+
+    // An unknown actor fails the whole set_transforms call
+    TSharedPtr<FJsonObject> MissingMove = MakeShared<FJsonObject>();
+    MissingMove->SetStringField(TEXT("actor"), TEXT("NoSuchBulkActor"));
+    MissingMove->SetArrayField(TEXT("location"), MakeNumbers({ 0.0, 0.0, 0.0 }));
+    TSharedPtr<FJsonObject> MissingParams = MakeShared<FJsonObject>();
+    MissingParams->SetArrayField(TEXT("transforms"), { Moves[0], MakeShared<FJsonValueObject>(MissingMove) });
+    TestFalse(TEXT("Unknown actor should be rejected"), Router.Execute(TEXT("level.set_transforms"), MissingParams).bSuccess);
+
+    for (const FString& Name : Created)
+    {
+        TSharedPtr<FJsonObject> DelParams = MakeShared<FJsonObject>();
+        DelParams->SetStringField(TEXT("actor"), Name);
+        Router.Execute(TEXT("level.delete_actor"), DelParams);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelSpawnActorsBlueprintComponentsTest,
+    "Cortex.Level.Actor.SpawnActorsBlueprintComponents",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelSpawnActorsBlueprintComponentsTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    // The mesh component only exists once the SCS runs during FinishSpawning
+    const FString PackagePath = FString::Printf(
+        TEXT("/Game/Temp/BP_CortexBulkSpawnTest_%s"),
+        *FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8));
+    UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+        AActor::StaticClass(),
+        CreatePackage(*PackagePath),
+        FName(TEXT("BP_CortexBulkSpawnTest")),
+        BPTYPE_Normal,
+        UBlueprint::StaticClass(),
+        UBlueprintGeneratedClass::StaticClass());
+    if (!TestNotNull(TEXT("Test Blueprint created"), Blueprint))
+    {
+        return false;
+    }
+
+    USCS_Node* MeshNode = Blueprint->SimpleConstructionScript->CreateNode(UStaticMeshComponent::StaticClass(), TEXT("BulkMesh"));
+    Blueprint->SimpleConstructionScript->AddNode(MeshNode);
+    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    if (!TestNotNull(TEXT("Blueprint class generated"), Blueprint->GeneratedClass.Get()))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+    Properties->SetBoolField(TEXT("BulkMesh.bCastDynamicShadow"), false);
+
+    TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("class_name"), Blueprint->GeneratedClass->GetPathName());
+    Entry->SetStringField(TEXT("label"), TEXT("BulkBlueprintMesh"));
+    Entry->SetStringField(TEXT("mesh"), TEXT("/Engine/BasicShapes/Cube.Cube"));
+    Entry->SetObjectField(TEXT("properties"), Properties);
+
+    TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetArrayField(TEXT("actors"), { MakeShared<FJsonValueObject>(Entry) });
+
+    FCortexCommandRouter Router = CreateLevelRouter();
+    FCortexCommandResult Result = Router.Execute(TEXT("level.spawn_actors"), Params);
+    TestTrue(TEXT("spawn_actors should succeed"), Result.bSuccess);
+    for (const FString& Warning : Result.Warnings)
+    {
+        AddError(FString::Printf(TEXT("Unexpected warning: %s"), *Warning));
+    }
+    if (!Result.bSuccess || !Result.Data.IsValid())
+    {
+        return true;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>& Spawned = Result.Data->GetArrayField(TEXT("spawned"));
+    TestEqual(TEXT("One actor spawned"), Spawned.Num(), 1);
+    if (Spawned.Num() != 1)
+    {
+        return true;
+    }
+
+    const FString ActorName = Spawned[0]->AsObject()->GetStringField(TEXT("name"));
+    AActor* Actor = nullptr;
+    for (TActorIterator<AActor> It(GEditor->GetEditorWorldContext().World()); It; ++It)
+    {
+        if (It->GetName() == ActorName)
+        {
+            Actor = *It;
+            break;
+        }
+    }
+
+    UStaticMeshComponent* MeshComponent = Actor ? Actor->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+    if (TestNotNull(TEXT("SCS mesh component constructed"), MeshComponent))
+    {
+        TestTrue(TEXT("Mesh applied to the SCS component"),
+            MeshComponent->GetStaticMesh() && MeshComponent->GetStaticMesh()->GetName() == TEXT("Cube"));
+        TestFalse(TEXT("Component property applied after construction"), MeshComponent->bCastDynamicShadow);
+    }
+
+    TSharedPtr<FJsonObject> DelParams = MakeShared<FJsonObject>();
+    DelParams->SetStringField(TEXT("actor"), ActorName);
+    Router.Execute(TEXT("level.delete_actor"), DelParams);
+
+    return true;
+}
@@ -0,0 +1,148 @@
+#include "Misc/AutomationTest.h"
+#include "CortexCommandRouter.h"
+#include "CortexLevelCommandHandler.h"
+#include "CortexLevelPartition.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    const TCHAR* PartitionTestLevelPath = TEXT("/Game/Maps/_CortexTest/PartitionLookup");
+    const TCHAR* PartitionTestLabel = TEXT("PartitionLookupTarget");
+
+    FCortexCommandRouter CreateLevelRouterPartition()
+    {
+        FCortexCommandRouter Router;
+        Router.RegisterDomain(TEXT("level"), TEXT("Cortex Level"), TEXT("1.0.1"),
+            MakeShared<FCortexLevelCommandHandler>());
+        return Router;
+    }
+
+    UWorld* GetEditorWorldForPartition()
+    {
+        return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    }
+
+    bool IsUnloadedDescriptor(UWorld* World, const FString& Label)
+    {
+        bool bFound = false;
+        FCortexLevelPartition::ForEachUnloadedActor(World, nullptr, [&bFound, &Label](const FCortexUnloadedActor& Actor)
+        {
+            bFound |= Actor.Label == Label;
+        });
+        return bFound;
+    }
+
+    FCortexCommandResult ExecuteWithActor(FCortexCommandRouter& Router, const TCHAR* Command, const FString& Actor)
+    {
+        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("actor"), Actor);
+        return Router.Execute(Command, Params);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelPartitionLookupTest,
+    "Cortex.Level.Partition.DescriptorLookup",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelPartitionLookupTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouterPartition();
+
+    UWorld* WorldBefore = GetEditorWorldForPartition();
+    const FString OriginalLevelPath = WorldBefore ? WorldBefore->GetOutermost()->GetName() : TEXT("");
+    const FString OriginalLevelFile = OriginalLevelPath.IsEmpty() ? TEXT("") :
+        FPackageName::LongPackageNameToFilename(OriginalLevelPath, FPackageName::GetMapPackageExtension());
+
+    // A partitioned map with one spatially loaded actor far from the origin, saved to disk
+    TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+    CreateParams->SetStringField(TEXT("path"), PartitionTestLevelPath);
+    CreateParams->SetStringField(TEXT("template"), TEXT("OpenWorld"));
+    CreateParams->SetBoolField(TEXT("open"), true);
+    const FCortexCommandResult CreateResult = Router.Execute(TEXT("level.create_level"), CreateParams);
+
+    UWorld* World = GetEditorWorldForPartition();
+    if (CreateResult.bSuccess && FCortexLevelPartition::IsPartitioned(World))
+    {
+        TSharedPtr<FJsonObject> SpawnParams = MakeShared<FJsonObject>();
+        SpawnParams->SetStringField(TEXT("class_name"), TEXT("PointLight"));
+        SpawnParams->SetStringField(TEXT("label"), PartitionTestLabel);
+        TArray<TSharedPtr<FJsonValue>> Location;
+        Location.Add(MakeShared<FJsonValueNumber>(1000000.0));
+        Location.Add(MakeShared<FJsonValueNumber>(1000000.0));
+        Location.Add(MakeShared<FJsonValueNumber>(0.0));
+        SpawnParams->SetArrayField(TEXT("location"), Location);
+        TestTrue(TEXT("spawn_actor should succeed"), Router.Execute(TEXT("level.spawn_actor"), SpawnParams).bSuccess);
+        TestTrue(TEXT("save_level should succeed"), Router.Execute(TEXT("level.save_level"), MakeShared<FJsonObject>()).bSuccess);
+
+        // Reopen so the actor is only a descriptor
+        TSharedPtr<FJsonObject> OpenParams = MakeShared<FJsonObject>();
+        OpenParams->SetStringField(TEXT("path"), PartitionTestLevelPath);
+        OpenParams->SetBoolField(TEXT("force"), true);
+        Router.Execute(TEXT("level.open_level"), OpenParams);
+        World = GetEditorWorldForPartition();
+    }
+
+    if (!FCortexLevelPartition::IsPartitioned(World) || !IsUnloadedDescriptor(World, PartitionTestLabel))
+    {
+        AddInfo(TEXT("Could not set up a partitioned map with an unloaded actor - skipping"));
+    }
+    else
+    {
+        // Misses are answered by the descriptor index without rescanning
+        TestFalse(TEXT("unknown actor is not found"), ExecuteWithActor(Router, TEXT("level.get_actor"), TEXT("PartitionLookupMissing")).bSuccess);
+        const int32 BuildsAfterFirstMiss = FCortexLevelPartition::GetIndexBuildCount();
+        TestFalse(TEXT("unknown actor is still not found"), ExecuteWithActor(Router, TEXT("level.get_actor"), TEXT("PartitionLookupMissing")).bSuccess);
+        TestEqual(TEXT("a repeated miss does not rescan descriptors"), FCortexLevelPartition::GetIndexBuildCount(), BuildsAfterFirstMiss);
+
+        // A read loads the actor for the command only
+        TestTrue(TEXT("get_actor loads the unloaded actor"), ExecuteWithActor(Router, TEXT("level.get_actor"), PartitionTestLabel).bSuccess);
+        TestEqual(TEXT("the lookup used the existing index"), FCortexLevelPartition::GetIndexBuildCount(), BuildsAfterFirstMiss);
+        TestTrue(TEXT("actor is unpinned after the command"), IsUnloadedDescriptor(World, PartitionTestLabel));
+
+        // An edit keeps it loaded until saved, then the next command releases it
+        TSharedPtr<FJsonObject> MoveParams = MakeShared<FJsonObject>();
+        MoveParams->SetStringField(TEXT("actor"), PartitionTestLabel);
+        TArray<TSharedPtr<FJsonValue>> Moved;
+        Moved.Add(MakeShared<FJsonValueNumber>(1000000.0));
+        Moved.Add(MakeShared<FJsonValueNumber>(1000000.0));
+        Moved.Add(MakeShared<FJsonValueNumber>(500.0));
+        MoveParams->SetArrayField(TEXT("location"), Moved);
+        TestTrue(TEXT("set_transform should succeed"), Router.Execute(TEXT("level.set_transform"), MoveParams).bSuccess);
+        TestFalse(TEXT("edited actor stays loaded"), IsUnloadedDescriptor(World, PartitionTestLabel));
+
+        TestTrue(TEXT("save_level should succeed"), Router.Execute(TEXT("level.save_level"), MakeShared<FJsonObject>()).bSuccess);
+        TestTrue(TEXT("saved actor is released"), IsUnloadedDescriptor(World, PartitionTestLabel));
+    }
+
+    // Cleanup: drop the test map and restore the original level for subsequent tests
+    if (!OriginalLevelFile.IsEmpty() && IFileManager::Get().FileExists(*OriginalLevelFile))
+    {
+        UEditorLoadingAndSavingUtils::LoadMap(OriginalLevelFile);
+    }
+    if (UPackage* Package = FindPackage(nullptr, PartitionTestLevelPath))
+    {
+        Package->MarkAsGarbage();
+    }
+    const FString TestDir = FPackageName::LongPackageNameToFilename(TEXT("/Game/Maps/_CortexTest/"));
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    const FString ExternalActorsDir = FPackageName::LongPackageNameToFilename(TEXT("/Game/__ExternalActors__/Maps/_CortexTest/"));
+    IFileManager::Get().DeleteDirectory(*ExternalActorsDir, false, true);
+    const FString ExternalObjectsDir = FPackageName::LongPackageNameToFilename(TEXT("/Game/__ExternalObjects__/Maps/_CortexTest/"));
+    IFileManager::Get().DeleteDirectory(*ExternalObjectsDir, false, true);
+
+    return true;
+}
@@ -227,6 +227,165 @@ bool FCortexLevelListActorsPaginationTest::RunTest(const FString& Parameters)
     return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelListActorsCursorTest,
+    "Cortex.Level.Query.ListActorsCursor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelListActorsCursorTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouterQuery();
+    TArray<FString> Spawned = {
+        SpawnPointLightQuery(Router, TEXT("CursorLightC"), FVector(0, 0, 0)),
+        SpawnPointLightQuery(Router, TEXT("CursorLightA"), FVector(100, 0, 0)),
+        SpawnPointLightQuery(Router, TEXT("CursorLightB"), FVector(200, 0, 0))
+    };
+
+    // Isolate the spawned lights in their own folder so the listing is deterministic
+    for (const FString& Name : Spawned)
+    {
+        TSharedPtr<FJsonObject> FolderParams = MakeShared<FJsonObject>();
+        FolderParams->SetStringField(TEXT("actor"), Name);
+        FolderParams->SetStringField(TEXT("folder"), TEXT("CortexCursorTest"));
+        Router.Execute(TEXT("level.set_folder"), FolderParams);
+    }
+
+    TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetStringField(TEXT("folder"), TEXT("CortexCursorTest"));
+    Params->SetNumberField(TEXT("limit"), 1);
+
+    TArray<FString> Labels;
+    FString Cursor;
+    for (int32 Page = 0; Page < 5; ++Page)
+    {
+        FCortexCommandResult Result = Router.Execute(TEXT("level.list_actors"), Params);
+        if (!TestTrue(TEXT("list_actors page should succeed"), Result.bSuccess) || !Result.Data.IsValid())
+        {
+            break;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Actors = nullptr;
+        if (Result.Data->TryGetArrayField(TEXT("actors"), Actors))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *Actors)
+            {
+                Labels.Add(Value->AsObject()->GetStringField(TEXT("label")));
+            }
+        }
+
+        bool bHasMore = false;
+        Result.Data->TryGetBoolField(TEXT("has_more"), bHasMore);
+        if (!bHasMore)
+        {
+            TestFalse(TEXT("Last page should not return a cursor"), Result.Data->HasField(TEXT("cursor")));
+            break;
+        }
+
+        TestTrue(TEXT("Page with more results should return a cursor"), Result.Data->TryGetStringField(TEXT("cursor"), Cursor));
+        Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("cursor"), Cursor);
+        Params->SetNumberField(TEXT("limit"), 1);
+    }
+
+    TestEqual(TEXT("Cursor should walk every page"), Labels.Num(), 3);
+    if (Labels.Num() == 3)
+    {
+        TestEqual(TEXT("First page sorted by label"), Labels[0], FString(TEXT("CursorLightA")));
+        TestEqual(TEXT("Second page sorted by label"), Labels[1], FString(TEXT("CursorLightB")));
+        TestEqual(TEXT("Third page sorted by label"), Labels[2], FString(TEXT("CursorLightC")));
+    }
+
+    // The snapshot is released once the last page is served
+    TSharedPtr<FJsonObject> StaleParams = MakeShared<FJsonObject>();
+    StaleParams->SetStringField(TEXT("cursor"), Cursor);
+    FCortexCommandResult Stale = Router.Execute(TEXT("level.list_actors"), StaleParams);
+    TestFalse(TEXT("Exhausted cursor should be rejected"), Stale.bSuccess);
+    TestEqual(TEXT("Exhausted cursor error code"), Stale.ErrorCode, CortexErrorCodes::InvalidValue);
+
+    TSharedPtr<FJsonObject> BadSortParams = MakeShared<FJsonObject>();
+    BadSortParams->SetStringField(TEXT("sort"), TEXT("size"));
+    FCortexCommandResult BadSort = Router.Execute(TEXT("level.list_actors"), BadSortParams);
+    TestFalse(TEXT("Unknown sort key should be rejected"), BadSort.bSuccess);
+
+    DeleteActorsQuery(Router, Spawned);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelListActorsLoadedOnlyTest,
+    "Cortex.Level.Query.ListActorsLoadedOnly",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelListActorsLoadedOnlyTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouterQuery();
+    TArray<FString> Spawned = {
+        SpawnPointLightQuery(Router, TEXT("LoadedOnlyLight"), FVector(0, 0, 0))
+    };
+
+    TSharedPtr<FJsonObject> AllParams = MakeShared<FJsonObject>();
+    AllParams->SetNumberField(TEXT("limit"), 1000);
+    FCortexCommandResult All = Router.Execute(TEXT("level.list_actors"), AllParams);
+
+    TSharedPtr<FJsonObject> LoadedParams = MakeShared<FJsonObject>();
+    LoadedParams->SetNumberField(TEXT("limit"), 1000);
+    LoadedParams->SetBoolField(TEXT("loaded_only"), true);
+    FCortexCommandResult Loaded = Router.Execute(TEXT("level.list_actors"), LoadedParams);
+
+    TestTrue(TEXT("list_actors should succeed"), All.bSuccess);
+    TestTrue(TEXT("list_actors loaded_only should succeed"), Loaded.bSuccess);
+    if (All.bSuccess && Loaded.bSuccess)
+    {
+        const int32 AllTotal = static_cast<int32>(All.Data->GetNumberField(TEXT("total")));
+        const int32 LoadedTotal = static_cast<int32>(Loaded.Data->GetNumberField(TEXT("total")));
+
+        // Unloaded descriptors only ever add to the loaded set
+        int32 Unloaded = 0;
+        All.Data->TryGetNumberField(TEXT("unloaded_count"), Unloaded);
+        TestEqual(TEXT("Total is loaded plus unloaded"), AllTotal, LoadedTotal + Unloaded);
+
+        for (const TSharedPtr<FJsonValue>& Value : Loaded.Data->GetArrayField(TEXT("actors")))
+        {
+            bool bLoaded = true;
+            Value->AsObject()->TryGetBoolField(TEXT("loaded"), bLoaded);
+            TestTrue(TEXT("loaded_only returns no descriptor entries"), bLoaded);
+        }
+
+        for (const TSharedPtr<FJsonValue>& Value : All.Data->GetArrayField(TEXT("actors")))
+        {
+            const TSharedPtr<FJsonObject> Actor = Value->AsObject();
+            bool bLoaded = true;
+            if (Actor->TryGetBoolField(TEXT("loaded"), bLoaded) && !bLoaded)
+            {
+                TestTrue(TEXT("Descriptor entry carries a guid"), Actor->HasField(TEXT("guid")));
+                TestTrue(TEXT("Descriptor entry carries a location"), Actor->HasField(TEXT("location")));
+            }
+        }
+    }
+
+    TSharedPtr<FJsonObject> BoundsParams = MakeShared<FJsonObject>();
+    BoundsParams->SetStringField(TEXT("class"), TEXT("PointLight"));
+    BoundsParams->SetBoolField(TEXT("loaded_only"), true);
+    TestTrue(TEXT("get_bounds loaded_only should succeed"), Router.Execute(TEXT("level.get_bounds"), BoundsParams).bSuccess);
+
+    DeleteActorsQuery(Router, Spawned);
+    return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FCortexLevelFindActorsTest,
     "Cortex.Level.Query.FindActors",
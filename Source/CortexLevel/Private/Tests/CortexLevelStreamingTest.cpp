@@ -1,8 +1,15 @@
 #include "Misc/AutomationTest.h"
 #include "CortexCommandRouter.h"
 #include "CortexLevelCommandHandler.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "FileHelpers.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/PackageName.h"
+#include "UObject/Package.h"
 
 namespace
 {
@@ -115,6 +122,58 @@ bool FCortexLevelSaveLevelTest::RunTest(const FString& Parameters)
     return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelSaveLevelDryRunTest,
+    "Cortex.Level.Streaming.SaveLevelDryRun",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelSaveLevelDryRunTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World || !World->PersistentLevel)
+    {
+        AddInfo(TEXT("No editor world - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouterStreaming();
+    UPackage* MapPackage = World->PersistentLevel->GetOutermost();
+    const bool bWasDirty = MapPackage->IsDirty();
+    MapPackage->SetDirtyFlag(true);
+
+    TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetBoolField(TEXT("dry_run"), true);
+    FCortexCommandResult Result = Router.Execute(TEXT("level.save_level"), Params);
+
+    // Untitled maps have no file to save to; the dry run reports that as an error
+    if (!FPackageName::IsTempPackage(MapPackage->GetName()))
+    {
+        TestTrue(TEXT("save_level dry_run should succeed"), Result.bSuccess);
+    }
+
+    if (Result.Data.IsValid())
+    {
+        bool bDryRun = false;
+        Result.Data->TryGetBoolField(TEXT("dry_run"), bDryRun);
+        TestTrue(TEXT("dry_run echoed"), bDryRun);
+        TestFalse(TEXT("dry run reports no bytes"), Result.Data->HasField(TEXT("total_bytes")));
+
+        bool bListsMap = false;
+        for (const TSharedPtr<FJsonValue>& Value : Result.Data->GetArrayField(TEXT("packages")))
+        {
+            const TSharedPtr<FJsonObject> Package = Value->AsObject();
+            bListsMap |= Package->GetStringField(TEXT("package")) == MapPackage->GetName()
+                && Package->GetStringField(TEXT("kind")) == TEXT("map");
+        }
+        TestTrue(TEXT("Map package listed"), bListsMap);
+    }
+
+    TestTrue(TEXT("Dry run leaves the package dirty"), MapPackage->IsDirty());
+    MapPackage->SetDirtyFlag(bWasDirty);
+    return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FCortexLevelSaveAllTest,
     "Cortex.Level.Streaming.SaveAll",
@@ -142,3 +201,103 @@ bool FCortexLevelSaveAllTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelSaveLevelDeletedActorTest,
+    "Cortex.Level.Streaming.SaveLevelDeletedActor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelSaveLevelDeletedActorTest::RunTest(const FString& Parameters)
+{
+    if (!GEditor)
+    {
+        AddInfo(TEXT("No editor - skipping"));
+        return true;
+    }
+
+    FCortexCommandRouter Router = CreateLevelRouterStreaming();
+    const TCHAR* TestLevelPath = TEXT("/Game/Maps/_CortexTest/SaveDeletedActor");
+    const TCHAR* ActorLabel = TEXT("SaveDeletedActorTarget");
+
+    UWorld* WorldBefore = GEditor->GetEditorWorldContext().World();
+    const FString OriginalLevelPath = WorldBefore ? WorldBefore->GetOutermost()->GetName() : TEXT("");
+    const FString OriginalLevelFile = OriginalLevelPath.IsEmpty() ? TEXT("") :
+        FPackageName::LongPackageNameToFilename(OriginalLevelPath, FPackageName::GetMapPackageExtension());
+
+    // One File Per Actor map, so the actor lives in its own external package
+    TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+    CreateParams->SetStringField(TEXT("path"), TestLevelPath);
+    CreateParams->SetStringField(TEXT("template"), TEXT("OpenWorld"));
+    CreateParams->SetBoolField(TEXT("open"), true);
+    const FCortexCommandResult CreateResult = Router.Execute(TEXT("level.create_level"), CreateParams);
+
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!CreateResult.bSuccess || !World || !World->PersistentLevel || !World->PersistentLevel->IsUsingExternalActors())
+    {
+        AddInfo(TEXT("Could not create a One File Per Actor map - skipping"));
+    }
+    else
+    {
+        TSharedPtr<FJsonObject> SpawnParams = MakeShared<FJsonObject>();
+        SpawnParams->SetStringField(TEXT("class_name"), TEXT("PointLight"));
+        SpawnParams->SetStringField(TEXT("label"), ActorLabel);
+        TestTrue(TEXT("spawn_actor should succeed"), Router.Execute(TEXT("level.spawn_actor"), SpawnParams).bSuccess);
+
+        FString ActorPackageName;
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            if (It->GetActorLabel() == ActorLabel && It->GetExternalPackage())
+            {
+                ActorPackageName = It->GetExternalPackage()->GetName();
+                break;
+            }
+        }
+        TestFalse(TEXT("actor has an external package"), ActorPackageName.IsEmpty());
+
+        const FString ActorFilename = FPackageName::LongPackageNameToFilename(ActorPackageName, FPackageName::GetAssetPackageExtension());
+        TestTrue(TEXT("first save_level should succeed"), Router.Execute(TEXT("level.save_level"), MakeShared<FJsonObject>()).bSuccess);
+        TestTrue(TEXT("actor package written"), IFileManager::Get().FileExists(*ActorFilename));
+
+        TSharedPtr<FJsonObject> DeleteParams = MakeShared<FJsonObject>();
+        DeleteParams->SetStringField(TEXT("actor"), ActorLabel);
+        TestTrue(TEXT("delete_actor should succeed"), Router.Execute(TEXT("level.delete_actor"), DeleteParams).bSuccess);
+
+        const FCortexCommandResult SaveResult = Router.Execute(TEXT("level.save_level"), MakeShared<FJsonObject>());
+        TestTrue(TEXT("save after delete should succeed"), SaveResult.bSuccess);
+
+        bool bReportedDelete = false;
+        if (SaveResult.Data.IsValid())
+        {
+            for (const TSharedPtr<FJsonValue>& Value : SaveResult.Data->GetArrayField(TEXT("packages")))
+            {
+                const TSharedPtr<FJsonObject> Package = Value->AsObject();
+                if (Package->GetStringField(TEXT("package")) == ActorPackageName)
+                {
+                    bool bDeleted = false;
+                    Package->TryGetBoolField(TEXT("deleted"), bDeleted);
+                    bReportedDelete = Package->GetStringField(TEXT("action")) == TEXT("delete") && bDeleted;
+                }
+            }
+        }
+        TestTrue(TEXT("deleted actor package reported as a delete"), bReportedDelete);
+        TestFalse(TEXT("deleted actor file removed, not saved empty"), IFileManager::Get().FileExists(*ActorFilename));
+
+        const UPackage* ActorPackage = FindPackage(nullptr, *ActorPackageName);
+        TestTrue(TEXT("deleted actor package no longer dirty"), !ActorPackage || !ActorPackage->IsDirty());
+    }
+
+    // Cleanup: restore the original level, then remove the test map and its external actors
+    if (!OriginalLevelFile.IsEmpty() && IFileManager::Get().FileExists(*OriginalLevelFile))
+    {
+        UEditorLoadingAndSavingUtils::LoadMap(OriginalLevelFile);
+    }
+    if (UPackage* Package = FindPackage(nullptr, TestLevelPath))
+    {
+        Package->MarkAsGarbage();
+    }
+    IFileManager::Get().DeleteDirectory(*FPackageName::LongPackageNameToFilename(TEXT("/Game/Maps/_CortexTest/")), false, true);
+    IFileManager::Get().DeleteDirectory(*FPackageName::LongPackageNameToFilename(TEXT("/Game/__ExternalActors__/Maps/_CortexTest/")), false, true);
+    IFileManager::Get().DeleteDirectory(*FPackageName::LongPackageNameToFilename(TEXT("/Game/__ExternalObjects__/Maps/_CortexTest/")), false, true);
+    return true;
+}
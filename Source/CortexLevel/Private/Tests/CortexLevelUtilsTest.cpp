@@ -2,6 +2,8 @@
 #include "CortexLevelUtils.h"
 #include "CortexCommandRouter.h"
 #include "CortexTypes.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
@@ -85,3 +87,66 @@ bool FCortexLevelResolveClassTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexLevelActorIndexTest,
+    "Cortex.Level.Utils.ActorIndexTracksEdits",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexLevelActorIndexTest::RunTest(const FString& Parameters)
+{
+    FCortexCommandResult Error;
+    UWorld* World = FCortexLevelUtils::GetEditorWorld(Error);
+    if (!World)
+    {
+        AddInfo(TEXT("No editor world - skipping"));
+        return true;
+    }
+
+    // Prime the index before the edits so lookups below go through the event updates
+    FCortexCommandResult PrimeError;
+    FCortexLevelUtils::FindActorByLabelOrPath(World, TEXT("CortexIndexTest_Prime"), PrimeError);
+
+    FActorSpawnParameters SpawnParams;
+    AActor* TestActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    TestNotNull(TEXT("Should spawn test actor"), TestActor);
+    if (!TestActor)
+    {
+        return true;
+    }
+
+    TestActor->SetActorLabel(TEXT("CortexIndexTest_Before"));
+
+    FCortexCommandResult FindError;
+    TestEqual(TEXT("Spawned actor found by new label"),
+        FCortexLevelUtils::FindActorByLabelOrPath(World, TEXT("CortexIndexTest_Before"), FindError), TestActor);
+    TestEqual(TEXT("Spawned actor found by path"),
+        FCortexLevelUtils::FindActorByLabelOrPath(World, TestActor->GetPathName(), FindError), TestActor);
+
+    TestActor->SetActorLabel(TEXT("CortexIndexTest_After"));
+    TestNull(TEXT("Old label no longer resolves"),
+        FCortexLevelUtils::FindActorByLabelOrPath(World, TEXT("CortexIndexTest_Before"), FindError));
+    TestEqual(TEXT("Relabelled actor found"),
+        FCortexLevelUtils::FindActorByLabelOrPath(World, TEXT("CortexIndexTest_After"), FindError), TestActor);
+
+    // A typo shares most trigrams with the label and is suggested even without a substring match
+    TSharedPtr<FJsonObject> Details = FCortexLevelUtils::CollectActorSuggestions(World, TEXT("CortexIndexTset_After"));
+    const TArray<TSharedPtr<FJsonValue>>* Suggestions = nullptr;
+    bool bSuggested = false;
+    if (Details.IsValid() && Details->TryGetArrayField(TEXT("suggestions"), Suggestions))
+    {
+        for (const TSharedPtr<FJsonValue>& Suggestion : *Suggestions)
+        {
+            bSuggested |= Suggestion->AsString().Contains(TEXT("CortexIndexTest_After"));
+        }
+    }
+    TestTrue(TEXT("Trigram suggestion includes the relabelled actor"), bSuggested);
+
+    TestActor->Destroy();
+    TestNull(TEXT("Destroyed actor no longer resolves"),
+        FCortexLevelUtils::FindActorByLabelOrPath(World, TEXT("CortexIndexTest_After"), FindError));
+    TestEqual(TEXT("Miss reports ACTOR_NOT_FOUND"), FindError.ErrorCode, CortexErrorCodes::ActorNotFound);
+
+    return true;
+}
@@ -5,6 +5,7 @@
 #include "Operations/CortexMaterialGraphOps.h"
 #include "Operations/CortexMaterialCollectionOps.h"
 #include "Operations/CortexMaterialDynamicOps.h"
+#include "Operations/CortexMaterialSessionOps.h"
 
 FCortexCommandResult FCortexMaterialCommandHandler::Execute(
 	const FString& Command,
@@ -38,10 +39,14 @@ FCortexCommandResult FCortexMaterialCommandHandler::Execute(
 		return FCortexMaterialParamOps::ListParameters(Params);
 	if (Command == TEXT("get_parameter"))
 		return FCortexMaterialParamOps::GetParameter(Params);
+	if (Command == TEXT("get_parameters"))
+		return FCortexMaterialParamOps::GetParameters(Params);
 	if (Command == TEXT("set_parameter"))
 		return FCortexMaterialParamOps::SetParameter(Params);
 	if (Command == TEXT("set_parameters"))
 		return FCortexMaterialParamOps::SetParameters(Params);
+	if (Command == TEXT("set_parameters_bulk"))
+		return FCortexMaterialParamOps::SetParametersBulk(Params);
 	if (Command == TEXT("reset_parameter"))
 		return FCortexMaterialParamOps::ResetParameter(Params);
 
@@ -66,6 +71,12 @@ FCortexCommandResult FCortexMaterialCommandHandler::Execute(
 		return FCortexMaterialGraphOps::SetNodeProperty(Params);
 	if (Command == TEXT("get_node_pins"))
 		return FCortexMaterialGraphOps::GetNodePins(Params);
+	if (Command == TEXT("begin_edit_session"))
+		return FCortexMaterialSessionOps::BeginEditSession(Params);
+	if (Command == TEXT("commit_edit_session"))
+		return FCortexMaterialSessionOps::CommitEditSession(Params);
+	if (Command == TEXT("abort_edit_session"))
+		return FCortexMaterialSessionOps::AbortEditSession(Params);
 
 	// Collection operations
 	if (Command == TEXT("list_collections"))
@@ -128,7 +139,9 @@ TArray<FCortexCommandInfo> FCortexMaterialCommandHandler::GetSupportedCommands()
 			.Required(TEXT("value"), TEXT("object"), TEXT("Property value")),
 		FCortexCommandInfo{ TEXT("list_instances"), TEXT("List material instances") }
 			.Optional(TEXT("path"), TEXT("string"), TEXT("Content path to search"))
-			.Optional(TEXT("parent_material"), TEXT("string"), TEXT("Optional parent material filter")),
+			.Optional(TEXT("parent_material"), TEXT("string"), TEXT("Optional parent material filter"))
+			.Optional(TEXT("recursive"), TEXT("boolean"), TEXT("With parent_material, include every descendant instance with its depth"))
+			.Optional(TEXT("overrides_parameter"), TEXT("string"), TEXT("Only instances that override this parameter")),
 		FCortexCommandInfo{ TEXT("get_instance"), TEXT("Get instance details with overrides") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material instance asset path")),
 		FCortexCommandInfo{ TEXT("create_instance"), TEXT("Create a UMaterialInstanceConstant") }
@@ -142,6 +155,9 @@ TArray<FCortexCommandInfo> FCortexMaterialCommandHandler::GetSupportedCommands()
 		FCortexCommandInfo{ TEXT("get_parameter"), TEXT("Get parameter value and metadata") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material instance asset path"))
 			.Required(TEXT("parameter_name"), TEXT("string"), TEXT("Parameter name")),
+		FCortexCommandInfo{ TEXT("get_parameters"), TEXT("Get many parameter values and metadata from one cached enumeration") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material or instance asset path"))
+			.Optional(TEXT("parameter_names"), TEXT("array"), TEXT("Parameter names (default: every parameter)")),
 		FCortexCommandInfo{ TEXT("set_parameter"), TEXT("Set parameter value on an instance") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material instance asset path"))
 			.Required(TEXT("parameter_name"), TEXT("string"), TEXT("Parameter name (alias: name)"))
@@ -150,6 +166,10 @@ TArray<FCortexCommandInfo> FCortexMaterialCommandHandler::GetSupportedCommands()
 		FCortexCommandInfo{ TEXT("set_parameters"), TEXT("Batch set multiple parameters") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material instance asset path"))
 			.Required(TEXT("parameters"), TEXT("array"), TEXT("Parameter updates")),
+		FCortexCommandInfo{ TEXT("set_parameters_bulk"), TEXT("Set parameters on many instances with one update per instance, parents first") }
+			.Required(TEXT("instances"), TEXT("array"), TEXT("Instance asset paths, or a wildcard string such as /Game/Env/MI_Rock*"))
+			.Required(TEXT("parameters"), TEXT("array"), TEXT("Parameter updates applied to every instance"))
+			.Optional(TEXT("parallel_load"), TEXT("boolean"), TEXT("Queue unloaded instances for async loading together (default: true)")),
 		FCortexCommandInfo{ TEXT("reset_parameter"), TEXT("Reset instance override to parent value") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material instance asset path"))
 			.Required(TEXT("parameter_name"), TEXT("string"), TEXT("Parameter name")),
@@ -178,7 +198,8 @@ TArray<FCortexCommandInfo> FCortexMaterialCommandHandler::GetSupportedCommands()
 			.Required(TEXT("target_node"), TEXT("string"), TEXT("Target node identifier"))
 			.Required(TEXT("target_input"), TEXT("string"), TEXT("Target input pin name (e.g. 'BaseColor', 'A', 'Input')")),
 		FCortexCommandInfo{ TEXT("auto_layout"), TEXT("Auto-layout material graph nodes by connection topology") }
-			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material asset path")),
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material asset path"))
+			.Optional(TEXT("mode"), TEXT("string"), TEXT("'full' (default) or 'incremental': keep placed nodes and only position new (0,0) nodes")),
 		FCortexCommandInfo{ TEXT("set_node_property"), TEXT("Set property value on material expression node") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material asset path"))
 			.Required(TEXT("node_id"), TEXT("string"), TEXT("Node identifier"))
@@ -187,6 +208,10 @@ TArray<FCortexCommandInfo> FCortexMaterialCommandHandler::GetSupportedCommands()
 		FCortexCommandInfo{ TEXT("get_node_pins"), TEXT("Get input and output pin names for a material expression node") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Material asset path"))
 			.Required(TEXT("node_id"), TEXT("string"), TEXT("Node identifier")),
+		FCortexCommandInfo{ TEXT("begin_edit_session"), TEXT("Defer material graph and property updates until commit_edit_session") }
+			.Optional(TEXT("timeout_seconds"), TEXT("number"), TEXT("Commit automatically after this long without edits (default: 300)")),
+		FCortexCommandInfo{ TEXT("commit_edit_session"), TEXT("Validate touched materials in parallel, then update each once; reports errors per material") },
+		FCortexCommandInfo{ TEXT("abort_edit_session"), TEXT("Close the edit session without validating; touched materials are updated once, edits are kept") },
 		FCortexCommandInfo{ TEXT("list_collections"), TEXT("List material parameter collections") }
 			.Optional(TEXT("path"), TEXT("string"), TEXT("Content path to search"))
 			.Optional(TEXT("recursive"), TEXT("boolean"), TEXT("Search subdirectories recursively")),
@@ -0,0 +1,426 @@
+#include "CortexMaterialEditSession.h"
+#include "CortexMaterialCompat.h"
+#include "CortexMaterialModule.h"
+#include "CortexBatchScope.h"
+#include "CortexCommandRouter.h"
+#include "Algo/Count.h"
+#include "Async/ParallelFor.h"
+#include "MaterialGraph/MaterialGraph.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "MaterialShared.h"
+#include "RHI.h"
+#include "ScopedTransaction.h"
+
+bool FCortexMaterialEditSession::bActive = false;
+double FCortexMaterialEditSession::LastActivitySeconds = 0.0;
+double FCortexMaterialEditSession::IdleTimeoutSeconds = FCortexMaterialEditSession::DefaultTimeoutSeconds;
+FTSTicker::FDelegateHandle FCortexMaterialEditSession::TimeoutTickerHandle;
+TArray<TWeakObjectPtr<UMaterial>> FCortexMaterialEditSession::DirtyMaterials;
+
+namespace
+{
+/**
+ * Plain-data copy of a material graph. Taken on the game thread; validation then reads
+ * only this, so it can run on worker threads.
+ */
+struct FMaterialGraphSnapshot
+{
+	struct FNode
+	{
+		FString Name;
+		FName ParameterName;
+		const UClass* Class = nullptr;
+		/** Indices of the expressions feeding this one */
+		TArray<int32> Inputs;
+		/** No outputs (custom outputs and the like), so it is a graph root itself */
+		bool bIsRoot = false;
+	};
+
+	TArray<FNode> Nodes;
+	/** Expressions wired into material output pins */
+	TArray<int32> OutputNodes;
+	TArray<FString> DanglingInputs;
+};
+
+void TakeSnapshot(UMaterial* Material, FMaterialGraphSnapshot& OutSnapshot)
+{
+	const UMaterialEditorOnlyData* EditorOnlyData = Material->GetEditorOnlyData();
+	if (!EditorOnlyData)
+	{
+		return;
+	}
+
+	const TArray<TObjectPtr<UMaterialExpression>>& Expressions = EditorOnlyData->ExpressionCollection.Expressions;
+	TMap<const UMaterialExpression*, int32> IndexByExpression;
+	IndexByExpression.Reserve(Expressions.Num());
+	for (const UMaterialExpression* Expression : Expressions)
+	{
+		if (Expression)
+		{
+			IndexByExpression.Add(Expression, IndexByExpression.Num());
+		}
+	}
+
+	OutSnapshot.Nodes.Reserve(IndexByExpression.Num());
+	for (UMaterialExpression* Expression : Expressions)
+	{
+		if (!Expression)
+		{
+			continue;
+		}
+
+		FMaterialGraphSnapshot::FNode& Node = OutSnapshot.Nodes.AddDefaulted_GetRef();
+		Node.Name = Expression->GetName();
+		Node.Class = Expression->GetClass();
+		Node.bIsRoot = Expression->Outputs.Num() == 0;
+		if (Expression->HasAParameterName())
+		{
+			Node.ParameterName = Expression->GetParameterName();
+		}
+
+		for (FExpressionInputIterator It(Expression); It; ++It)
+		{
+			if (!It.Input || !It.Input->Expression)
+			{
+				continue;
+			}
+			if (const int32* InputIndex = IndexByExpression.Find(It.Input->Expression))
+			{
+				Node.Inputs.Add(*InputIndex);
+			}
+			else
+			{
+				OutSnapshot.DanglingInputs.Add(FString::Printf(TEXT("%s.%s"),
+					*Node.Name, *Expression->GetInputName(It.Index).ToString()));
+			}
+		}
+	}
+
+	for (int32 Prop = 0; Prop < MP_MAX; ++Prop)
+	{
+		const FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(Prop));
+		if (!Input || !Input->Expression)
+		{
+			continue;
+		}
+		if (const int32* InputIndex = IndexByExpression.Find(Input->Expression))
+		{
+			OutSnapshot.OutputNodes.Add(*InputIndex);
+		}
+		else
+		{
+			OutSnapshot.DanglingInputs.Add(FString::Printf(TEXT("MaterialOutput.%s"),
+				*StaticEnum<EMaterialProperty>()->GetNameStringByValue(Prop)));
+		}
+	}
+}
+
+/** Thread-safe: reads only the snapshot and immutable class data. */
+void ValidateSnapshot(const FMaterialGraphSnapshot& Snapshot, TArray<FString>& OutErrors, TArray<FString>& OutWarnings)
+{
+	for (const FString& Dangling : Snapshot.DanglingInputs)
+	{
+		OutErrors.Add(FString::Printf(TEXT("Input %s references an expression that is not in the material"), *Dangling));
+	}
+
+	// Iterative DFS over input edges; reaching a node still on the stack closes a cycle
+	const int32 NumNodes = Snapshot.Nodes.Num();
+	TArray<uint8> State;
+	State.SetNumZeroed(NumNodes);
+	TArray<TPair<int32, int32>> Stack;
+	for (int32 Start = 0; Start < NumNodes; ++Start)
+	{
+		if (State[Start] != 0)
+		{
+			continue;
+		}
+		State[Start] = 1;
+		Stack.Emplace(Start, 0);
+		while (Stack.Num() > 0)
+		{
+			TPair<int32, int32>& Top = Stack.Last();
+			const TArray<int32>& Inputs = Snapshot.Nodes[Top.Key].Inputs;
+			if (Top.Value >= Inputs.Num())
+			{
+				State[Top.Key] = 2;
+				Stack.Pop(EAllowShrinking::No);
+				continue;
+			}
+
+			const int32 Next = Inputs[Top.Value++];
+			if (State[Next] == 1)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Cycle through %s"), *Snapshot.Nodes[Next].Name));
+			}
+			else if (State[Next] == 0)
+			{
+				State[Next] = 1;
+				Stack.Emplace(Next, 0);
+			}
+		}
+	}
+
+	// One name may back several expressions only when they are the same kind of parameter
+	TMap<FName, int32> FirstByParameter;
+	for (int32 Index = 0; Index < NumNodes; ++Index)
+	{
+		const FMaterialGraphSnapshot::FNode& Node = Snapshot.Nodes[Index];
+		if (Node.ParameterName.IsNone())
+		{
+			continue;
+		}
+		if (const int32* First = FirstByParameter.Find(Node.ParameterName))
+		{
+			const FMaterialGraphSnapshot::FNode& FirstNode = Snapshot.Nodes[*First];
+			if (!Node.Class->IsChildOf(FirstNode.Class) && !FirstNode.Class->IsChildOf(Node.Class))
+			{
+				OutErrors.Add(FString::Printf(TEXT("Parameter %s is both %s (%s) and %s (%s)"),
+					*Node.ParameterName.ToString(),
+					*FirstNode.Class->GetName(), *FirstNode.Name,
+					*Node.Class->GetName(), *Node.Name));
+			}
+		}
+		else
+		{
+			FirstByParameter.Add(Node.ParameterName, Index);
+		}
+	}
+
+	TArray<bool> Reached;
+	Reached.SetNumZeroed(NumNodes);
+	TArray<int32> Frontier = Snapshot.OutputNodes;
+	for (int32 Index = 0; Index < NumNodes; ++Index)
+	{
+		if (Snapshot.Nodes[Index].bIsRoot)
+		{
+			Frontier.Add(Index);
+		}
+	}
+	while (Frontier.Num() > 0)
+	{
+		const int32 Index = Frontier.Pop(EAllowShrinking::No);
+		if (!Reached[Index])
+		{
+			Reached[Index] = true;
+			Frontier.Append(Snapshot.Nodes[Index].Inputs);
+		}
+	}
+	const int32 Unreached = Algo::Count(Reached, false);
+	if (Unreached > 0)
+	{
+		OutWarnings.Add(FString::Printf(TEXT("%d expression(s) not connected to any material output"), Unreached));
+	}
+}
+}
+
+bool FCortexMaterialEditSession::Begin(double TimeoutSeconds)
+{
+	if (bActive)
+	{
+		return false;
+	}
+	bActive = true;
+	DirtyMaterials.Reset();
+	LastActivitySeconds = FPlatformTime::Seconds();
+	IdleTimeoutSeconds = TimeoutSeconds > 0.0 ? TimeoutSeconds : DefaultTimeoutSeconds;
+	TimeoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateStatic(&FCortexMaterialEditSession::TickTimeout), 1.0f);
+	return true;
+}
+
+bool FCortexMaterialEditSession::Commit(TArray<FCortexMaterialCommitReport>& OutReports, double& OutValidateMs, double& OutUpdateMs)
+{
+	if (!bActive)
+	{
+		return false;
+	}
+
+	// Closed first, so anything PostEditChange touches updates immediately
+	Close();
+	TArray<UMaterial*> Materials;
+	for (const TWeakObjectPtr<UMaterial>& WeakMaterial : DirtyMaterials)
+	{
+		if (UMaterial* Material = WeakMaterial.Get())
+		{
+			Materials.Add(Material);
+		}
+	}
+	DirtyMaterials.Reset();
+
+	const double ValidateStart = FPlatformTime::Seconds();
+	TArray<FMaterialGraphSnapshot> Snapshots;
+	Snapshots.SetNum(Materials.Num());
+	OutReports.SetNum(Materials.Num());
+	for (int32 Index = 0; Index < Materials.Num(); ++Index)
+	{
+		TakeSnapshot(Materials[Index], Snapshots[Index]);
+		OutReports[Index].AssetPath = Materials[Index]->GetPathName();
+		OutReports[Index].ExpressionCount = Snapshots[Index].Nodes.Num();
+	}
+	ParallelFor(Snapshots.Num(), [&Snapshots, &OutReports](int32 Index)
+	{
+		ValidateSnapshot(Snapshots[Index], OutReports[Index].ValidationErrors, OutReports[Index].Warnings);
+	});
+	OutValidateMs = (FPlatformTime::Seconds() - ValidateStart) * 1000.0;
+
+	// Translation itself reads UObjects and stays on the game thread: once per material
+	const double UpdateStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Materials.Num(); ++Index)
+	{
+		UMaterial* Material = Materials[Index];
+		UpdateMaterial(Material);
+
+		if (const FMaterialResource* Resource = Material->GetMaterialResource(GMaxRHIFeatureLevel))
+		{
+			OutReports[Index].TranslationErrors = Resource->GetCompileErrors();
+		}
+	}
+	OutUpdateMs = (FPlatformTime::Seconds() - UpdateStart) * 1000.0;
+
+	UE_LOG(LogCortexMaterial, Log, TEXT("Material edit session committed: %d materials (validate %.1f ms, update %.1f ms)"),
+		Materials.Num(), OutValidateMs, OutUpdateMs);
+	return true;
+}
+
+bool FCortexMaterialEditSession::Abort(TArray<FString>& OutAssetPaths)
+{
+	if (!bActive)
+	{
+		return false;
+	}
+
+	Close();
+	TArray<TWeakObjectPtr<UMaterial>> Touched = MoveTemp(DirtyMaterials);
+	DirtyMaterials.Reset();
+	for (const TWeakObjectPtr<UMaterial>& WeakMaterial : Touched)
+	{
+		if (UMaterial* Material = WeakMaterial.Get())
+		{
+			UpdateMaterial(Material);
+			OutAssetPaths.Add(Material->GetPathName());
+		}
+	}
+
+	UE_LOG(LogCortexMaterial, Log, TEXT("Material edit session aborted: %d materials updated without validation"),
+		OutAssetPaths.Num());
+	return true;
+}
+
+bool FCortexMaterialEditSession::CommitIfIdle(double NowSeconds)
+{
+	if (!bActive || NowSeconds - LastActivitySeconds < IdleTimeoutSeconds)
+	{
+		return false;
+	}
+
+	TArray<FCortexMaterialCommitReport> Reports;
+	double ValidateMs = 0.0;
+	double UpdateMs = 0.0;
+	Commit(Reports, ValidateMs, UpdateMs);
+	UE_LOG(LogCortexMaterial, Warning,
+		TEXT("Material edit session idle for more than %.0f s; committed %d materials automatically"),
+		IdleTimeoutSeconds, Reports.Num());
+	return true;
+}
+
+void FCortexMaterialEditSession::Reset()
+{
+	Close();
+	DirtyMaterials.Reset();
+}
+
+void FCortexMaterialEditSession::Close()
+{
+	bActive = false;
+	if (TimeoutTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+		TimeoutTickerHandle.Reset();
+	}
+}
+
+void FCortexMaterialEditSession::UpdateMaterial(UMaterial* Material)
+{
+	Material->PostEditChange();
+	if (UMaterialGraph* MaterialGraph = Material->MaterialGraph)
+	{
+		MaterialGraph->RebuildGraph();
+	}
+	Material->MarkPackageDirty();
+}
+
+bool FCortexMaterialEditSession::TickTimeout(float DeltaTime)
+{
+	CommitIfIdle(FPlatformTime::Seconds());
+	return true;
+}
+
+bool FCortexMaterialEditSession::IsDeferring()
+{
+	return bActive || FCortexCommandRouter::IsInBatch();
+}
+
+void FCortexMaterialEditSession::MarkMaterialDirty(UMaterial* Material)
+{
+	if (Material == nullptr)
+	{
+		return;
+	}
+	if (bActive)
+	{
+		DirtyMaterials.AddUnique(Material);
+		LastActivitySeconds = FPlatformTime::Seconds();
+	}
+	else
+	{
+		FCortexBatchScope::MarkMaterialDirty(Material);
+	}
+}
+
+void FCortexMaterialEditSession::ValidateGraph(UMaterial* Material, TArray<FString>& OutErrors, TArray<FString>& OutWarnings)
+{
+	if (Material)
+	{
+		FMaterialGraphSnapshot Snapshot;
+		TakeSnapshot(Material, Snapshot);
+		ValidateSnapshot(Snapshot, OutErrors, OutWarnings);
+	}
+}
+
+FCortexMaterialEditScope::FCortexMaterialEditScope(UMaterial* InMaterial, const FText& Description, FProperty* InProperty)
+	: Material(InMaterial)
+	, Property(InProperty)
+	, bDeferred(FCortexMaterialEditSession::IsDeferring())
+{
+	if (!FCortexCommandRouter::IsInBatch())
+	{
+		Transaction = MakeUnique<FScopedTransaction>(Description);
+	}
+
+	Material->Modify();
+	if (UMaterialEditorOnlyData* EditorOnlyData = Material->GetEditorOnlyData())
+	{
+		EditorOnlyData->Modify();
+	}
+	if (!bDeferred)
+	{
+		Material->PreEditChange(Property);
+	}
+}
+
+FCortexMaterialEditScope::~FCortexMaterialEditScope() = default;
+
+void FCortexMaterialEditScope::Finish()
+{
+	if (!bDeferred)
+	{
+		FPropertyChangedEvent PropertyChangedEvent(Property);
+		Material->PostEditChangeProperty(PropertyChangedEvent);
+	}
+	else
+	{
+		FCortexMaterialEditSession::MarkMaterialDirty(Material);
+	}
+	Material->MarkPackageDirty();
+}
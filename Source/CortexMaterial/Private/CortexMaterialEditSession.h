@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FProperty;
+class FScopedTransaction;
+class UMaterial;
+
+/** Outcome for one material touched by an edit session. */
+struct FCortexMaterialCommitReport
+{
+	FString AssetPath;
+	int32 ExpressionCount = 0;
+	/** Structural graph problems found before translation */
+	TArray<FString> ValidationErrors;
+	TArray<FString> Warnings;
+	/** Errors the engine's HLSL translation reported for the material */
+	TArray<FString> TranslationErrors;
+};
+
+/**
+ * Explicit material edit session spanning any number of commands and materials. While it
+ * is open, graph and property edits skip their per-edit PostEditChange and register the
+ * material here instead. Commit validates every touched graph in parallel, from snapshots
+ * taken on the game thread, then runs a single PostEditChange (one translation) per
+ * material. Inside a batch with no open session, edits defer to the batch as before.
+ * Only the update is deferred: each edit still records undo through FCortexMaterialEditScope.
+ * A session left idle past its timeout (a client that went away mid-session) is committed
+ * automatically, so deferred updates never stay pending indefinitely. Game thread only.
+ */
+class FCortexMaterialEditSession
+{
+public:
+	static bool IsActive() { return bActive; }
+
+	static constexpr double DefaultTimeoutSeconds = 300.0;
+
+	/** Open a session that auto-commits after TimeoutSeconds without edits; false when one is already open. */
+	static bool Begin(double TimeoutSeconds = DefaultTimeoutSeconds);
+
+	/** Validate and update every touched material and close the session; false when none is open. */
+	static bool Commit(TArray<FCortexMaterialCommitReport>& OutReports, double& OutValidateMs, double& OutUpdateMs);
+
+	/**
+	 * Close without validating; false when none is open. Touched materials still get their
+	 * deferred update so none is left out of sync with its graph. The edits themselves stay
+	 * and undo like any other.
+	 */
+	static bool Abort(TArray<FString>& OutAssetPaths);
+
+	/** Commit the open session when it has been idle past its timeout as of NowSeconds. */
+	static bool CommitIfIdle(double NowSeconds);
+
+	/** Close without updating (module shutdown). */
+	static void Reset();
+
+	/** True when material updates should wait, for an open session or an enclosing batch. */
+	static bool IsDeferring();
+
+	/** Defer a material's update to the session commit, or to the enclosing batch. */
+	static void MarkMaterialDirty(UMaterial* Material);
+
+	static int32 NumDirty() { return DirtyMaterials.Num(); }
+
+	/** Dangling inputs, cycles, parameter type conflicts and unreachable expressions, as commit reports them. */
+	static void ValidateGraph(UMaterial* Material, TArray<FString>& OutErrors, TArray<FString>& OutWarnings);
+
+private:
+	static void Close();
+	static void UpdateMaterial(UMaterial* Material);
+	static bool TickTimeout(float DeltaTime);
+
+	static bool bActive;
+	static double LastActivitySeconds;
+	static double IdleTimeoutSeconds;
+	static FTSTicker::FDelegateHandle TimeoutTickerHandle;
+	/** In first-touched order, so reports are stable */
+	static TArray<TWeakObjectPtr<UMaterial>> DirtyMaterials;
+};
+
+/**
+ * Undo and update bracket for one material edit. Opens a transaction unless a batch already
+ * holds one and records the material and its editor-only data, so the edit undoes whether or
+ * not its update is deferred. PreEditChange runs only when the update is not deferred.
+ */
+class FCortexMaterialEditScope
+{
+public:
+	FCortexMaterialEditScope(UMaterial* InMaterial, const FText& Description, FProperty* InProperty = nullptr);
+	~FCortexMaterialEditScope();
+
+	/** Update the material now, or defer it to the session or batch; marks the package dirty. */
+	void Finish();
+
+private:
+	UMaterial* Material;
+	FProperty* Property;
+	bool bDeferred;
+	TUniquePtr<FScopedTransaction> Transaction;
+};
@@ -0,0 +1,416 @@
+#include "CortexMaterialInstanceIndex.h"
+#include "CortexMaterialModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Materials/MaterialInstance.h"
+#include "Misc/PackageName.h"
+#include "UObject/AssetRegistryTagsContext.h"
+#include "UObject/UObjectGlobals.h"
+
+const FName FCortexMaterialInstanceIndex::OverriddenParametersTag(TEXT("CortexOverriddenParameters"));
+
+FDelegateHandle FCortexMaterialInstanceIndex::ExtraTagsHandle;
+TUniquePtr<FCortexMaterialInstanceIndex> FCortexMaterialInstanceIndex::Instance;
+
+namespace
+{
+const FName ParentTag(TEXT("Parent"));
+
+/** Every parameter the instance itself overrides, static switches included. */
+void GatherOverriddenParameters(const UMaterialInstance* MaterialInstance, TArray<FName>& OutNames)
+{
+	for (const FScalarParameterValue& Param : MaterialInstance->ScalarParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	for (const FVectorParameterValue& Param : MaterialInstance->VectorParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	for (const FDoubleVectorParameterValue& Param : MaterialInstance->DoubleVectorParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	for (const FTextureParameterValue& Param : MaterialInstance->TextureParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	for (const FRuntimeVirtualTextureParameterValue& Param : MaterialInstance->RuntimeVirtualTextureParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	for (const FFontParameterValue& Param : MaterialInstance->FontParameterValues)
+	{
+		OutNames.AddUnique(Param.ParameterInfo.Name);
+	}
+	const FStaticParameterSet StaticParameters = MaterialInstance->GetStaticParameters();
+	for (const FStaticSwitchParameter& Param : StaticParameters.StaticSwitchParameters)
+	{
+		if (Param.bOverride)
+		{
+			OutNames.AddUnique(Param.ParameterInfo.Name);
+		}
+	}
+}
+
+/** Parent from hard package dependencies, for instances saved without a Parent tag; None when ambiguous. */
+FName FindParentFromDependencies(IAssetRegistry& AssetRegistry, FName PackageName)
+{
+	TArray<FAssetIdentifier> Dependencies;
+	AssetRegistry.GetDependencies(
+		FAssetIdentifier(PackageName),
+		Dependencies,
+		UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::EDependencyQuery::Hard);
+
+	FName Parent;
+	for (const FAssetIdentifier& Dependency : Dependencies)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(Dependency.PackageName, Assets, true);
+		for (const FAssetData& Asset : Assets)
+		{
+			if (Asset.IsInstanceOf(UMaterialInterface::StaticClass()))
+			{
+				if (!Parent.IsNone())
+				{
+					return NAME_None;
+				}
+				Parent = FName(*Asset.GetObjectPathString());
+			}
+		}
+	}
+	return Parent;
+}
+}
+
+FCortexMaterialInstanceIndex& FCortexMaterialInstanceIndex::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FCortexMaterialInstanceIndex>();
+		Instance->BindDelegates();
+		Instance->Build();
+	}
+	return *Instance;
+}
+
+void FCortexMaterialInstanceIndex::Reset()
+{
+	Instance.Reset();
+}
+
+void FCortexMaterialInstanceIndex::RegisterTags()
+{
+	if (!ExtraTagsHandle.IsValid())
+	{
+		ExtraTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(
+			&FCortexMaterialInstanceIndex::HandleGetExtraObjectTags);
+	}
+}
+
+void FCortexMaterialInstanceIndex::UnregisterTags()
+{
+	if (ExtraTagsHandle.IsValid())
+	{
+		UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraTagsHandle);
+		ExtraTagsHandle.Reset();
+	}
+}
+
+FName FCortexMaterialInstanceIndex::NormalizePath(const FString& Path)
+{
+	if (Path.IsEmpty())
+	{
+		return NAME_None;
+	}
+	if (Path.Contains(TEXT(".")))
+	{
+		return FName(*Path);
+	}
+	return FName(*FString::Printf(TEXT("%s.%s"), *Path, *FPackageName::GetShortName(Path)));
+}
+
+FCortexMaterialInstanceIndex::~FCortexMaterialInstanceIndex()
+{
+	UnbindDelegates();
+}
+
+void FCortexMaterialInstanceIndex::GetChildren(FName ParentPath, TArray<FName>& OutChildren, bool bRecursive) const
+{
+	const int32 FirstChild = OutChildren.Num();
+	TSet<FName> Visited;
+	Visited.Add(ParentPath);
+
+	// Breadth-first, so every instance follows its parent
+	TArray<FName> Frontier;
+	Frontier.Add(ParentPath);
+	while (Frontier.Num() > 0)
+	{
+		TArray<FName> NextFrontier;
+		for (const FName Parent : Frontier)
+		{
+			const TArray<FName>* Children = ChildrenByParent.Find(Parent);
+			if (!Children)
+			{
+				continue;
+			}
+
+			TArray<FName> Sorted = *Children;
+			Sorted.Sort(FNameLexicalLess());
+			for (const FName Child : Sorted)
+			{
+				bool bAlreadyVisited = false;
+				Visited.Add(Child, &bAlreadyVisited);
+				if (!bAlreadyVisited)
+				{
+					OutChildren.Add(Child);
+					NextFrontier.Add(Child);
+				}
+			}
+		}
+
+		if (!bRecursive)
+		{
+			break;
+		}
+		Frontier = MoveTemp(NextFrontier);
+	}
+}
+
+FName FCortexMaterialInstanceIndex::GetParent(FName InstancePath) const
+{
+	const FNode* Node = Nodes.Find(InstancePath);
+	return Node ? Node->Parent : NAME_None;
+}
+
+void FCortexMaterialInstanceIndex::FindOverriding(FName ParameterName, TArray<FName>& OutInstances, int32& OutUntaggedCount) const
+{
+	if (const TArray<FName>* Overriding = ByOverriddenParameter.Find(ParameterName))
+	{
+		OutInstances.Append(*Overriding);
+	}
+	OutUntaggedCount = UntaggedCount;
+}
+
+void FCortexMaterialInstanceIndex::UpdateAsset(const FAssetData& AssetData)
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	FNode Node;
+	FString ParentValue;
+	if (AssetData.GetTagValue(ParentTag, ParentValue) && !ParentValue.IsEmpty() && ParentValue != TEXT("None"))
+	{
+		Node.Parent = FName(*FPackageName::ExportTextPathToObjectPath(ParentValue));
+	}
+	else
+	{
+		Node.Parent = FindParentFromDependencies(*AssetRegistry, AssetData.PackageName);
+	}
+
+	FString Overrides;
+	if (AssetData.GetTagValue(OverriddenParametersTag, Overrides))
+	{
+		Node.bHasOverrideTag = true;
+		TArray<FString> Names;
+		Overrides.ParseIntoArrayLines(Names);
+		for (const FString& Name : Names)
+		{
+			Node.OverriddenParameters.Add(FName(*Name));
+		}
+	}
+
+	SetNode(FName(*AssetData.GetObjectPathString()), MoveTemp(Node));
+}
+
+void FCortexMaterialInstanceIndex::UpdateInstance(const UMaterialInstance* MaterialInstance)
+{
+	if (!MaterialInstance)
+	{
+		return;
+	}
+
+	FNode Node;
+	Node.bHasOverrideTag = true;
+	if (MaterialInstance->Parent)
+	{
+		Node.Parent = FName(*MaterialInstance->Parent->GetPathName());
+	}
+	GatherOverriddenParameters(MaterialInstance, Node.OverriddenParameters);
+	SetNode(FName(*MaterialInstance->GetPathName()), MoveTemp(Node));
+}
+
+void FCortexMaterialInstanceIndex::RemoveAsset(FName InstancePath)
+{
+	FNode* Node = Nodes.Find(InstancePath);
+	if (!Node)
+	{
+		return;
+	}
+
+	if (TArray<FName>* Siblings = ChildrenByParent.Find(Node->Parent))
+	{
+		Siblings->RemoveSingleSwap(InstancePath, EAllowShrinking::No);
+		if (Siblings->Num() == 0)
+		{
+			ChildrenByParent.Remove(Node->Parent);
+		}
+	}
+	for (const FName Parameter : Node->OverriddenParameters)
+	{
+		if (TArray<FName>* Overriding = ByOverriddenParameter.Find(Parameter))
+		{
+			Overriding->RemoveSingleSwap(InstancePath, EAllowShrinking::No);
+			if (Overriding->Num() == 0)
+			{
+				ByOverriddenParameter.Remove(Parameter);
+			}
+		}
+	}
+	if (!Node->bHasOverrideTag)
+	{
+		--UntaggedCount;
+	}
+	Nodes.Remove(InstancePath);
+}
+
+void FCortexMaterialInstanceIndex::Build()
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UMaterialInstance::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry->GetAssets(Filter, Assets);
+	for (const FAssetData& AssetData : Assets)
+	{
+		UpdateAsset(AssetData);
+	}
+
+	UE_LOG(LogCortexMaterial, Log, TEXT("Material instance index: %d instances in %.1f ms"),
+		Nodes.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FCortexMaterialInstanceIndex::SetNode(FName InstancePath, FNode&& Node)
+{
+	RemoveAsset(InstancePath);
+
+	if (!Node.Parent.IsNone())
+	{
+		ChildrenByParent.FindOrAdd(Node.Parent).Add(InstancePath);
+	}
+	for (const FName Parameter : Node.OverriddenParameters)
+	{
+		ByOverriddenParameter.FindOrAdd(Parameter).Add(InstancePath);
+	}
+	if (!Node.bHasOverrideTag)
+	{
+		++UntaggedCount;
+	}
+	Nodes.Add(InstancePath, MoveTemp(Node));
+}
+
+void FCortexMaterialInstanceIndex::BindDelegates()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetAddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FCortexMaterialInstanceIndex::HandleAssetAdded);
+		AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FCortexMaterialInstanceIndex::HandleAssetRemoved);
+		AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FCortexMaterialInstanceIndex::HandleAssetRenamed);
+		AssetUpdatedHandle = AssetRegistry->OnAssetUpdated().AddRaw(this, &FCortexMaterialInstanceIndex::HandleAssetAdded);
+	}
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(
+		this, &FCortexMaterialInstanceIndex::HandleObjectPropertyChanged);
+}
+
+void FCortexMaterialInstanceIndex::UnbindDelegates()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+}
+
+void FCortexMaterialInstanceIndex::HandleAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.IsInstanceOf(UMaterialInstance::StaticClass()))
+	{
+		UpdateAsset(AssetData);
+	}
+}
+
+void FCortexMaterialInstanceIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	if (AssetData.IsInstanceOf(UMaterialInstance::StaticClass()))
+	{
+		RemoveAsset(FName(*AssetData.GetObjectPathString()));
+	}
+}
+
+void FCortexMaterialInstanceIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (!AssetData.IsInstanceOf(UMaterialInstance::StaticClass()))
+	{
+		return;
+	}
+
+	const FName OldPath(*OldObjectPath);
+	const FName NewPath(*AssetData.GetObjectPathString());
+	RemoveAsset(OldPath);
+	UpdateAsset(AssetData);
+
+	// Children follow the rename (the engine fixes their Parent references the same way)
+	TArray<FName> Children;
+	if (ChildrenByParent.RemoveAndCopyValue(OldPath, Children))
+	{
+		for (const FName Child : Children)
+		{
+			Nodes.FindChecked(Child).Parent = NewPath;
+		}
+		ChildrenByParent.FindOrAdd(NewPath).Append(Children);
+	}
+}
+
+void FCortexMaterialInstanceIndex::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Object);
+	if (MaterialInstance && MaterialInstance->IsAsset())
+	{
+		UpdateInstance(MaterialInstance);
+	}
+}
+
+void FCortexMaterialInstanceIndex::HandleGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Context.GetObject());
+	if (!MaterialInstance)
+	{
+		return;
+	}
+
+	TArray<FName> Names;
+	GatherOverriddenParameters(MaterialInstance, Names);
+
+	FString Value;
+	for (const FName Name : Names)
+	{
+		Value += Name.ToString();
+		Value += TEXT("\n");
+	}
+	Context.AddTag(UObject::FAssetRegistryTag(OverriddenParametersTag, Value, UObject::FAssetRegistryTag::TT_Hidden));
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class FAssetRegistryTagsContext;
+class UMaterialInstance;
+
+/**
+ * Material-instance parent tree and parameter overrides, answered from asset-registry
+ * data so hierarchy queries never load an instance. Parents come from the instance's
+ * searchable Parent tag (package dependencies when it is missing); overridden parameter
+ * names come from a hidden tag this module writes whenever an instance's tags are
+ * gathered. Built once from the registry, then kept current from registry add, remove,
+ * rename and update events and from edits to loaded instances. Game thread only.
+ */
+class FCortexMaterialInstanceIndex
+{
+public:
+	static const FName OverriddenParametersTag;
+
+	/** Shared index, built from the asset registry on first use. */
+	static FCortexMaterialInstanceIndex& Get();
+
+	/** Drop the shared index and unbind events. */
+	static void Reset();
+
+	/** Start writing the overridden-parameters tag for instances. */
+	static void RegisterTags();
+	static void UnregisterTags();
+
+	/** Object path form of a material or instance path ("/Game/M" -> "/Game/M.M"). */
+	static FName NormalizePath(const FString& Path);
+
+	FCortexMaterialInstanceIndex() = default;
+	~FCortexMaterialInstanceIndex();
+
+	/** Direct children of Parent, or every descendant (parents before children) when bRecursive. */
+	void GetChildren(FName ParentPath, TArray<FName>& OutChildren, bool bRecursive) const;
+
+	/** Parent of an indexed instance, or None. */
+	FName GetParent(FName InstancePath) const;
+
+	/** Indexed instances that override ParameterName; untagged instances are counted, not guessed. */
+	void FindOverriding(FName ParameterName, TArray<FName>& OutInstances, int32& OutUntaggedCount) const;
+
+	void GetAll(TArray<FName>& OutInstances) const { Nodes.GetKeys(OutInstances); }
+
+	bool Contains(FName InstancePath) const { return Nodes.Contains(InstancePath); }
+	int32 Num() const { return Nodes.Num(); }
+
+	/** Add or refresh one instance from its registry data. */
+	void UpdateAsset(const FAssetData& AssetData);
+
+	/** Refresh one instance from the loaded object (unsaved edits). */
+	void UpdateInstance(const UMaterialInstance* Instance);
+
+	void RemoveAsset(FName InstancePath);
+
+private:
+	struct FNode
+	{
+		FName Parent;
+		TArray<FName> OverriddenParameters;
+		bool bHasOverrideTag = false;
+	};
+
+	void Build();
+	void SetNode(FName InstancePath, FNode&& Node);
+	void BindDelegates();
+	void UnbindDelegates();
+
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+	static void HandleGetExtraObjectTags(FAssetRegistryTagsContext Context);
+
+	TMap<FName, FNode> Nodes;
+	TMap<FName, TArray<FName>> ChildrenByParent;
+	TMap<FName, TArray<FName>> ByOverriddenParameter;
+	int32 UntaggedCount = 0;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PropertyChangedHandle;
+
+	static FDelegateHandle ExtraTagsHandle;
+	static TUniquePtr<FCortexMaterialInstanceIndex> Instance;
+};
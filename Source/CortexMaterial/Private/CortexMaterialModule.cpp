@@ -2,6 +2,9 @@
 #include "CortexCoreModule.h"
 #include "ICortexCommandRegistry.h"
 #include "CortexMaterialCommandHandler.h"
+#include "CortexMaterialEditSession.h"
+#include "CortexMaterialInstanceIndex.h"
+#include "CortexMaterialParameterCache.h"
 
 DEFINE_LOG_CATEGORY(LogCortexMaterial);
 
@@ -20,12 +23,19 @@ void FCortexMaterialModule::StartupModule()
 		MakeShared<FCortexMaterialCommandHandler>()
 	);
 
+	FCortexMaterialInstanceIndex::RegisterTags();
+
 	UE_LOG(LogCortexMaterial, Log, TEXT("CortexMaterial registered with CortexCore"));
 }
 
 void FCortexMaterialModule::ShutdownModule()
 {
 	UE_LOG(LogCortexMaterial, Log, TEXT("CortexMaterial module shutting down"));
+
+	FCortexMaterialEditSession::Reset();
+	FCortexMaterialInstanceIndex::Reset();
+	FCortexMaterialParameterCache::Reset();
+	FCortexMaterialInstanceIndex::UnregisterTags();
 }
 
 IMPLEMENT_MODULE(FCortexMaterialModule, CortexMaterial)
@@ -0,0 +1,244 @@
+#include "CortexMaterialParameterCache.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+#include "UObject/UObjectGlobals.h"
+
+TUniquePtr<FCortexMaterialParameterCache> FCortexMaterialParameterCache::Instance;
+
+namespace
+{
+struct FParameterTypeName
+{
+	EMaterialParameterType Type;
+	const TCHAR* Name;
+};
+
+// Order matches the sections list_parameters returns
+const FParameterTypeName ParameterTypes[] = {
+	{ EMaterialParameterType::Scalar, TEXT("scalar") },
+	{ EMaterialParameterType::Vector, TEXT("vector") },
+	{ EMaterialParameterType::Texture, TEXT("texture") },
+	{ EMaterialParameterType::StaticSwitch, TEXT("static_switch") },
+};
+
+template <typename ValueType>
+bool ContainsParameter(const TArray<ValueType>& Values, const FMaterialParameterInfo& Info)
+{
+	return Values.ContainsByPredicate([&Info](const ValueType& Value)
+	{
+		return Value.ParameterInfo == Info;
+	});
+}
+
+bool InstanceOverrides(const UMaterialInstance* MaterialInstance, EMaterialParameterType Type, const FMaterialParameterInfo& Info)
+{
+	switch (Type)
+	{
+	case EMaterialParameterType::Scalar:
+		return ContainsParameter(MaterialInstance->ScalarParameterValues, Info);
+	case EMaterialParameterType::Vector:
+		return ContainsParameter(MaterialInstance->VectorParameterValues, Info);
+	case EMaterialParameterType::Texture:
+		return ContainsParameter(MaterialInstance->TextureParameterValues, Info);
+	case EMaterialParameterType::StaticSwitch:
+		return MaterialInstance->GetStaticParameters().StaticSwitchParameters.ContainsByPredicate(
+			[&Info](const FStaticSwitchParameter& Param)
+			{
+				return Param.bOverride && Param.ParameterInfo == Info;
+			});
+	default:
+		return false;
+	}
+}
+
+/**
+ * Hash of what an instance chain contributes to a table: each link and every override it
+ * holds. Cheap next to a rebuild, and catches values set without a property-change event.
+ */
+uint32 HashInstanceState(const TArray<const UMaterialInterface*>& Chain)
+{
+	uint32 Hash = 0;
+	for (const UMaterialInterface* Link : Chain)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Link));
+		const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Link);
+		if (!MaterialInstance)
+		{
+			continue;
+		}
+
+		for (const FScalarParameterValue& Value : MaterialInstance->ScalarParameterValues)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Value.ParameterInfo), GetTypeHash(Value.ParameterValue)));
+		}
+		for (const FVectorParameterValue& Value : MaterialInstance->VectorParameterValues)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Value.ParameterInfo), GetTypeHash(Value.ParameterValue)));
+		}
+		for (const FTextureParameterValue& Value : MaterialInstance->TextureParameterValues)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Value.ParameterInfo), GetTypeHash(Value.ParameterValue.Get())));
+		}
+		for (const FStaticSwitchParameter& Param : MaterialInstance->GetStaticParameters().StaticSwitchParameters)
+		{
+			if (Param.bOverride)
+			{
+				Hash = HashCombine(Hash, HashCombine(GetTypeHash(Param.ParameterInfo), GetTypeHash(Param.Value)));
+			}
+		}
+	}
+	return Hash;
+}
+
+/** Parent chain from Material up to its base material; bounded against invalid cycles. */
+void GetParentChain(const UMaterialInterface* Material, TArray<const UMaterialInterface*>& OutChain)
+{
+	for (const UMaterialInterface* Current = Material; Current && OutChain.Num() < 64; )
+	{
+		OutChain.Add(Current);
+		const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Current);
+		Current = MaterialInstance ? MaterialInstance->Parent.Get() : nullptr;
+	}
+}
+}
+
+FCortexMaterialParameterCache& FCortexMaterialParameterCache::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FCortexMaterialParameterCache>();
+	}
+	return *Instance;
+}
+
+void FCortexMaterialParameterCache::Reset()
+{
+	Instance.Reset();
+}
+
+FCortexMaterialParameterCache::FCortexMaterialParameterCache()
+{
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(
+		this, &FCortexMaterialParameterCache::HandleObjectPropertyChanged);
+	CompilationFinishedHandle = UMaterial::OnMaterialCompilationFinished().AddRaw(
+		this, &FCortexMaterialParameterCache::HandleMaterialCompiled);
+}
+
+FCortexMaterialParameterCache::~FCortexMaterialParameterCache()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	UMaterial::OnMaterialCompilationFinished().Remove(CompilationFinishedHandle);
+}
+
+TSharedRef<const FCortexMaterialParameterTable> FCortexMaterialParameterCache::GetTable(UMaterialInterface* Material)
+{
+	check(Material);
+
+	const UMaterial* BaseMaterial = Material->GetMaterial();
+	const FGuid StateId = BaseMaterial ? BaseMaterial->StateId : FGuid();
+
+	TArray<const UMaterialInterface*> Chain;
+	GetParentChain(Material, Chain);
+	const uint32 InstanceStateHash = HashInstanceState(Chain);
+
+	const FObjectKey Key(Material);
+	if (const FCachedTable* Cached = Tables.Find(Key))
+	{
+		if (Cached->StateId == StateId && Cached->InstanceStateHash == InstanceStateHash)
+		{
+			return Cached->Table;
+		}
+	}
+
+	// Sweep tables of collected materials before adding a new one
+	for (auto It = Tables.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FCachedTable Entry{ Build(Material, Chain), StateId, InstanceStateHash };
+	for (const UMaterialInterface* Link : Chain)
+	{
+		Entry.Chain.Add(FObjectKey(Link));
+	}
+	++BuildCount;
+	return Tables.Add(Key, MoveTemp(Entry)).Table;
+}
+
+void FCortexMaterialParameterCache::Invalidate(const UObject* Material)
+{
+	const FObjectKey Key(Material);
+	for (auto It = Tables.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Chain.Contains(Key))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TSharedRef<const FCortexMaterialParameterTable> FCortexMaterialParameterCache::Build(
+	UMaterialInterface* Material, const TArray<const UMaterialInterface*>& Chain)
+{
+	TSharedRef<FCortexMaterialParameterTable> Table = MakeShared<FCortexMaterialParameterTable>();
+
+	for (const FParameterTypeName& ParameterType : ParameterTypes)
+	{
+		TMap<FMaterialParameterInfo, FMaterialParameterMetadata> Parameters;
+		Material->GetAllParametersOfType(ParameterType.Type, Parameters);
+
+		for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& Parameter : Parameters)
+		{
+			FCortexMaterialParameterEntry& Entry = Table->Entries.AddDefaulted_GetRef();
+			Entry.Info = Parameter.Key;
+			Entry.Type = ParameterType.Name;
+			Entry.Group = Parameter.Value.Group;
+			Entry.SortPriority = Parameter.Value.SortPriority;
+			Entry.ExpressionGuid = Parameter.Value.ExpressionGuid;
+			Entry.CurrentValue = Parameter.Value.Value;
+
+			FMaterialParameterMetadata DefaultMetadata;
+			if (Material->GetParameterDefaultValue(ParameterType.Type, Parameter.Key, DefaultMetadata))
+			{
+				Entry.DefaultValue = DefaultMetadata.Value;
+			}
+			else
+			{
+				Entry.DefaultValue = Entry.CurrentValue;
+			}
+
+			for (const UMaterialInterface* Link : Chain)
+			{
+				const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Link);
+				if (MaterialInstance && InstanceOverrides(MaterialInstance, ParameterType.Type, Parameter.Key))
+				{
+					Entry.OverrideSource = MaterialInstance->GetPathName();
+					break;
+				}
+			}
+
+			if (Parameter.Key.Association == GlobalParameter)
+			{
+				Table->IndexByName.FindOrAdd(Parameter.Key.Name, Table->Entries.Num() - 1);
+			}
+		}
+	}
+
+	return Table;
+}
+
+void FCortexMaterialParameterCache::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (Object && Object->IsA<UMaterialInterface>())
+	{
+		Invalidate(Object);
+	}
+}
+
+void FCortexMaterialParameterCache::HandleMaterialCompiled(UMaterialInterface* Material)
+{
+	Invalidate(Material);
+}
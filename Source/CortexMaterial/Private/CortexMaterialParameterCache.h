@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UMaterialInterface;
+struct FPropertyChangedEvent;
+
+/** One parameter of a material or instance, as list_parameters and get_parameter report it. */
+struct FCortexMaterialParameterEntry
+{
+	FMaterialParameterInfo Info;
+	/** scalar, vector, texture or static_switch */
+	FString Type;
+	/** Group from the parameter expression */
+	FName Group;
+	int32 SortPriority = 0;
+	FGuid ExpressionGuid;
+	FMaterialParameterValue DefaultValue;
+	FMaterialParameterValue CurrentValue;
+	/** Instance in the parent chain that sets the value; empty when the base material default applies */
+	FString OverrideSource;
+};
+
+/** Every parameter of one material or instance, built from one enumeration per parameter type. */
+struct FCortexMaterialParameterTable
+{
+	TArray<FCortexMaterialParameterEntry> Entries;
+	/** Global-association parameters by name; layer parameters are listed but not keyed */
+	TMap<FName, int32> IndexByName;
+
+	const FCortexMaterialParameterEntry* Find(FName Name) const
+	{
+		const int32* Index = IndexByName.Find(Name);
+		return Index ? &Entries[*Index] : nullptr;
+	}
+};
+
+/**
+ * Parameter tables cached per material or instance. An entry is valid while its base
+ * material's StateId and the parents and override values of every instance in its chain
+ * are unchanged, so edits that skip PostEditChange are still seen; it is also dropped when
+ * the object or anything in its parent chain posts an edit or finishes compiling. Entries
+ * of collected objects are swept whenever a table is rebuilt. Game thread only.
+ */
+class FCortexMaterialParameterCache
+{
+public:
+	static FCortexMaterialParameterCache& Get();
+	static void Reset();
+
+	FCortexMaterialParameterCache();
+	~FCortexMaterialParameterCache();
+
+	/** Cached table, rebuilt first when stale. */
+	TSharedRef<const FCortexMaterialParameterTable> GetTable(UMaterialInterface* Material);
+
+	/** Drop the tables of Material and of every instance beneath it. */
+	void Invalidate(const UObject* Material);
+
+	/** Tables built since startup, so tests can tell a hit from a rebuild. */
+	int32 GetBuildCount() const { return BuildCount; }
+
+	/** Tables currently held, including ones not yet swept. */
+	int32 GetNumTables() const { return Tables.Num(); }
+
+private:
+	struct FCachedTable
+	{
+		TSharedRef<const FCortexMaterialParameterTable> Table;
+		FGuid StateId;
+		/** Parents and override values of the chain's instances when the table was built */
+		uint32 InstanceStateHash = 0;
+		/** The object itself and its parents, up to the base material */
+		TArray<FObjectKey> Chain;
+	};
+
+	static TSharedRef<const FCortexMaterialParameterTable> Build(
+		UMaterialInterface* Material, const TArray<const UMaterialInterface*>& Chain);
+
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void HandleMaterialCompiled(UMaterialInterface* Material);
+
+	TMap<FObjectKey, FCachedTable> Tables;
+	int32 BuildCount = 0;
+
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle CompilationFinishedHandle;
+
+	static TUniquePtr<FCortexMaterialParameterCache> Instance;
+};
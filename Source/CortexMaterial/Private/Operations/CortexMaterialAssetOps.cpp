@@ -1,5 +1,6 @@
 #include "Operations/CortexMaterialAssetOps.h"
 #include "CortexMaterialModule.h"
+#include "CortexMaterialInstanceIndex.h"
 #include "CortexEditorUtils.h"
 #include "Materials/Material.h"
 #include "MaterialDomain.h"
@@ -18,7 +19,7 @@
 #include "UObject/SavePackage.h"
 #include "ObjectTools.h"
 #include "CortexSerializer.h"
-#include "CortexBatchScope.h"
+#include "CortexMaterialEditSession.h"
 
 namespace
 {
@@ -404,60 +405,98 @@ FCortexCommandResult FCortexMaterialAssetOps::ListInstances(const TSharedPtr<FJs
 {
 	FString Path = TEXT("/Game/");
 	FString ParentMaterialPath;
+	FString OverridesParameter;
+	bool bRecursive = false;
 	if (Params.IsValid())
 	{
 		Params->TryGetStringField(TEXT("path"), Path);
 		Params->TryGetStringField(TEXT("parent_material"), ParentMaterialPath);
+		Params->TryGetStringField(TEXT("overrides_parameter"), OverridesParameter);
+		Params->TryGetBoolField(TEXT("recursive"), bRecursive);
 	}
 
-	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
-	if (AssetRegistry == nullptr)
+	if (IAssetRegistry::Get() == nullptr)
 	{
 		return FCortexCommandRouter::Error(
 			CortexErrorCodes::EditorNotReady, TEXT("Asset Registry not available"));
 	}
 
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-	if (!Path.IsEmpty())
+	// Answered from registry tags; no instance is loaded
+	const FCortexMaterialInstanceIndex& Index = FCortexMaterialInstanceIndex::Get();
+
+	TArray<FName> Candidates;
+	TMap<FName, int32> DepthByInstance;
+	if (!ParentMaterialPath.IsEmpty())
 	{
-		Filter.PackagePaths.Add(FName(*Path));
-		Filter.bRecursivePaths = true;
+		const FName ParentPath = FCortexMaterialInstanceIndex::NormalizePath(ParentMaterialPath);
+		Index.GetChildren(ParentPath, Candidates, bRecursive);
+
+		// Children always follow their parent, so one pass settles every depth
+		for (const FName Candidate : Candidates)
+		{
+			const int32* ParentDepth = DepthByInstance.Find(Index.GetParent(Candidate));
+			DepthByInstance.Add(Candidate, ParentDepth ? *ParentDepth + 1 : 1);
+		}
+	}
+	else if (OverridesParameter.IsEmpty())
+	{
+		Index.GetAll(Candidates);
+		Candidates.Sort(FNameLexicalLess());
 	}
 
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry->GetAssets(Filter, AssetDataList);
+	TSet<FName> Overriding;
+	int32 UntaggedCount = 0;
+	if (!OverridesParameter.IsEmpty())
+	{
+		TArray<FName> OverridingList;
+		Index.FindOverriding(FName(*OverridesParameter), OverridingList, UntaggedCount);
+		Overriding.Append(OverridingList);
+		if (ParentMaterialPath.IsEmpty())
+		{
+			Candidates = MoveTemp(OverridingList);
+			Candidates.Sort(FNameLexicalLess());
+		}
+	}
+
+	FString PathPrefix = Path;
+	if (!PathPrefix.IsEmpty() && !PathPrefix.EndsWith(TEXT("/")))
+	{
+		PathPrefix += TEXT("/");
+	}
 
 	TArray<TSharedPtr<FJsonValue>> InstancesArray;
-	for (const FAssetData& AssetData : AssetDataList)
+	for (const FName Candidate : Candidates)
 	{
-		// Optional parent filter
-		if (!ParentMaterialPath.IsEmpty())
+		const FString AssetPath = Candidate.ToString();
+		if (!PathPrefix.IsEmpty() && !AssetPath.StartsWith(PathPrefix))
 		{
-			UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(AssetData.GetAsset());
-			if (Instance && Instance->Parent)
-			{
-				if (Instance->Parent->GetPathName() != ParentMaterialPath)
-				{
-					continue;
-				}
-			}
-			else
-			{
-				continue;
-			}
+			continue;
+		}
+		if (!OverridesParameter.IsEmpty() && !Overriding.Contains(Candidate))
+		{
+			continue;
 		}
 
 		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-		Entry->SetStringField(TEXT("asset_path"), AssetData.GetObjectPathString());
+		Entry->SetStringField(TEXT("name"), FPackageName::ObjectPathToObjectName(AssetPath));
+		Entry->SetStringField(TEXT("asset_path"), AssetPath);
+		const FName Parent = Index.GetParent(Candidate);
+		Entry->SetStringField(TEXT("parent_material"), Parent.IsNone() ? FString() : Parent.ToString());
+		if (bRecursive && !ParentMaterialPath.IsEmpty())
+		{
+			Entry->SetNumberField(TEXT("depth"), DepthByInstance.FindRef(Candidate));
+		}
 		InstancesArray.Add(MakeShared<FJsonValueObject>(Entry));
 	}
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("instances"), InstancesArray);
 	Data->SetNumberField(TEXT("count"), InstancesArray.Num());
+	if (!OverridesParameter.IsEmpty())
+	{
+		// Instances saved before the override tag existed cannot be answered without loading
+		Data->SetNumberField(TEXT("untagged_count"), UntaggedCount);
+	}
 
 	return FCortexCommandRouter::Success(Data);
 }
@@ -710,14 +749,8 @@ FCortexCommandResult FCortexMaterialAssetOps::SetMaterialProperty(const TSharedP
 
 	void* PropertyAddress = Property->ContainerPtrToValuePtr<void>(Material);
 
-	TUniquePtr<FScopedTransaction> Transaction;
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Transaction = MakeUnique<FScopedTransaction>(FText::FromString(
-			FString::Printf(TEXT("Cortex: Set Material Property %s"), *PropertyName)));
-		Material->Modify();
-		Material->PreEditChange(Property);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(
+		FString::Printf(TEXT("Cortex: Set Material Property %s"), *PropertyName)), Property);
 
 	TArray<FString> Warnings;
 	if (!FCortexSerializer::JsonToProperty(Value, Property, PropertyAddress, Material, Warnings))
@@ -730,16 +763,7 @@ FCortexCommandResult FCortexMaterialAssetOps::SetMaterialProperty(const TSharedP
 			FString::Printf(TEXT("Failed to set property '%s': %s"), *PropertyName, *WarningStr));
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FPropertyChangedEvent PropertyChangedEvent(Property);
-		Material->PostEditChangeProperty(PropertyChangedEvent);
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
@@ -1,45 +1,19 @@
 #include "Operations/CortexMaterialGraphOps.h"
 #include "Operations/CortexMaterialAssetOps.h"
 #include "CortexMaterialModule.h"
-#include "Misc/EngineVersionComparison.h"
+#include "CortexMaterialCompat.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialExpression.h"
 #include "MaterialDomain.h"
-
-// UE 5.4 compatibility: FExpressionInputIterator was added in UE 5.5
-#if UE_VERSION_OLDER_THAN(5, 5, 0)
-struct FExpressionInputIterator
-{
-	FExpressionInputIterator(UMaterialExpression* InExpr)
-		: Inputs(InExpr ? InExpr->GetInputs() : TArray<FExpressionInput*>())
-		, Index(0)
-	{
-		Input = Inputs.IsValidIndex(0) ? Inputs[0] : nullptr;
-	}
-
-	explicit operator bool() const { return Inputs.IsValidIndex(Index); }
-
-	FExpressionInputIterator& operator++()
-	{
-		++Index;
-		Input = Inputs.IsValidIndex(Index) ? Inputs[Index] : nullptr;
-		return *this;
-	}
-
-	TArray<FExpressionInput*> Inputs;
-	FExpressionInput* Input = nullptr;
-	int32 Index = 0;
-};
-#endif
 #include "Materials/MaterialExpressionCollectionParameter.h"
 #include "Materials/MaterialParameterCollection.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
-#include "ScopedTransaction.h"
-#include "CortexBatchScope.h"
+#include "CortexMaterialEditSession.h"
 #include "CortexCommandRouter.h"
 #include "CortexSerializer.h"
 #include "CortexGraphLayoutOps.h"
+#include "CortexGraphLookupIndex.h"
 #include "UObject/UnrealType.h"
 
 namespace
@@ -106,15 +80,13 @@ UMaterialExpression* FCortexMaterialGraphOps::FindExpression(UMaterial* Material
 		return nullptr;
 	}
 
-	for (UMaterialExpression* Expression : Material->GetEditorOnlyData()->ExpressionCollection.Expressions)
-	{
-		if (Expression && Expression->GetName() == NodeId)
+	const auto& Expressions = Material->GetEditorOnlyData()->ExpressionCollection.Expressions;
+	return Cast<UMaterialExpression>(FCortexGraphLookupIndex::FindNamedObject(
+		Material, NodeId, Expressions.Num(),
+		[&Expressions](int32 Index) -> UObject*
 		{
-			return Expression;
-		}
-	}
-
-	return nullptr;
+			return Expressions[Index];
+		}));
 }
 
 FCortexCommandResult FCortexMaterialGraphOps::ListNodes(const TSharedPtr<FJsonObject>& Params)
@@ -294,15 +266,9 @@ FCortexCommandResult FCortexMaterialGraphOps::AddNode(const TSharedPtr<FJsonObje
 			FString::Printf(TEXT("Invalid expression class: %s"), *ExpressionClass));
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Add Material Expression Node"))
-		));
-		Material->PreEditChange(nullptr);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(TEXT("Cortex: Add Material Expression Node")));
 
-	UMaterialExpression* NewExpression = NewObject<UMaterialExpression>(Material, ExpClass);
+	UMaterialExpression* NewExpression = NewObject<UMaterialExpression>(Material, ExpClass, NAME_None, RF_Transactional);
 	NewExpression->bCollapsed = false;
 
 	// Set position if provided
@@ -317,16 +283,9 @@ FCortexCommandResult FCortexMaterialGraphOps::AddNode(const TSharedPtr<FJsonObje
 	}
 
 	Material->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(NewExpression);
+	FCortexGraphLookupIndex::Invalidate(Material);
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("node_id"), NewExpression->GetName());
@@ -371,25 +330,13 @@ FCortexCommandResult FCortexMaterialGraphOps::RemoveNode(const TSharedPtr<FJsonO
 		);
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Remove Material Expression Node %s"), *NodeId)
-		));
-		Material->PreEditChange(nullptr);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(
+		FString::Printf(TEXT("Cortex: Remove Material Expression Node %s"), *NodeId)));
 
 	Material->GetEditorOnlyData()->ExpressionCollection.Expressions.Remove(Expression);
+	FCortexGraphLookupIndex::Invalidate(Material);
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("node_id"), NodeId);
@@ -561,13 +508,7 @@ FCortexCommandResult FCortexMaterialGraphOps::Connect(const TSharedPtr<FJsonObje
 		SourceOutputIndex = static_cast<int32>(SourceOutputDouble);
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Connect Material Nodes"))
-		));
-		Material->PreEditChange(nullptr);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(TEXT("Cortex: Connect Material Nodes")));
 
 	// Connect to MaterialResult or expression — accept "Material" as alias
 	if (TargetNode == TEXT("MaterialResult") || TargetNode == TEXT("Material"))
@@ -633,19 +574,12 @@ FCortexCommandResult FCortexMaterialGraphOps::Connect(const TSharedPtr<FJsonObje
 			);
 		}
 
+		TargetExpr->Modify();
 		TargetInputPtr->Expression = SourceExpr;
 		TargetInputPtr->OutputIndex = SourceOutputIndex;
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("source_node"), SourceNode);
@@ -685,13 +619,7 @@ FCortexCommandResult FCortexMaterialGraphOps::Disconnect(const TSharedPtr<FJsonO
 			TEXT("Material has no editor data"));
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Disconnect Material Nodes"))
-		));
-		Material->PreEditChange(nullptr);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(TEXT("Cortex: Disconnect Material Nodes")));
 
 	// Disconnect from MaterialResult
 	if (TargetNode == TEXT("MaterialResult"))
@@ -725,15 +653,7 @@ FCortexCommandResult FCortexMaterialGraphOps::Disconnect(const TSharedPtr<FJsonO
 		);
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("target_node"), TargetNode);
@@ -752,6 +672,8 @@ FCortexCommandResult FCortexMaterialGraphOps::AutoLayout(const TSharedPtr<FJsonO
 			CortexErrorCodes::InvalidField, TEXT("Missing required param: asset_path"));
 	}
 
+	const double StartTime = FPlatformTime::Seconds();
+
 	FCortexCommandResult LoadError;
 	UMaterial* Material = FCortexMaterialAssetOps::LoadMaterial(AssetPath, LoadError);
 	if (Material == nullptr) return LoadError;
@@ -762,6 +684,10 @@ FCortexCommandResult FCortexMaterialGraphOps::AutoLayout(const TSharedPtr<FJsonO
 			CortexErrorCodes::SerializationError, TEXT("Material has no editor data"));
 	}
 
+	FString ModeStr;
+	Params->TryGetStringField(TEXT("mode"), ModeStr);
+	const bool bIncremental = (ModeStr == TEXT("incremental"));
+
 	const TArray<UMaterialExpression*>& Expressions = Material->GetEditorOnlyData()->ExpressionCollection.Expressions;
 
 	if (Expressions.Num() == 0)
@@ -872,6 +798,8 @@ FCortexCommandResult FCortexMaterialGraphOps::AutoLayout(const TSharedPtr<FJsonO
 			+ FMath::Max(1, VisiblePinCount) * CortexMaterialLayout::PinRowHeight;
 		MaterialResultNode.bIsEntryPoint = false;
 		MaterialResultNode.bIsExecNode = false;
+		// Incremental layout anchors new expressions to the real root node, which usually sits at (0,0)
+		MaterialResultNode.bIsPinned = bIncremental;
 		LayoutNodes.Add(MaterialResultNode);
 	}
 
@@ -886,10 +814,29 @@ FCortexCommandResult FCortexMaterialGraphOps::AutoLayout(const TSharedPtr<FJsonO
 	if (Params->TryGetNumberField(TEXT("vertical_spacing"), VSpacingVal) && VSpacingVal > 0)
 		Config.VerticalSpacing = static_cast<int32>(VSpacingVal);
 
-	FCortexLayoutResult LayoutResult = FCortexGraphLayoutOps::CalculateLayout(LayoutNodes, Config);
+	TMap<FString, FIntPoint> ExistingPositions;
+	if (bIncremental)
+	{
+		Config.Mode = ECortexLayoutMode::Incremental;
+		ExistingPositions.Reserve(Expressions.Num() + 1);
+		for (UMaterialExpression* Expr : Expressions)
+		{
+			if (Expr)
+			{
+				ExistingPositions.Add(ExprToId[Expr],
+					FIntPoint(Expr->MaterialExpressionEditorX, Expr->MaterialExpressionEditorY));
+			}
+		}
+		ExistingPositions.Add(MaterialResultId, FIntPoint(Material->EditorX, Material->EditorY));
+	}
+
+	const double LayoutStart = FPlatformTime::Seconds();
+	FCortexLayoutResult LayoutResult = FCortexGraphLayoutOps::CalculateLayout(LayoutNodes, Config, ExistingPositions);
+	const double LayoutMs = (FPlatformTime::Seconds() - LayoutStart) * 1000.0;
 
 	// Translate positions so MaterialResult lands at x=0.
 	// UE material editor convention: MaterialResult is at ~x=0; expressions are at negative x (to the left).
+	// Incremental results are already in editor space around the pinned root.
 	if (const FIntPoint* MRPos = LayoutResult.Positions.Find(MaterialResultId))
 	{
 		const int32 OffsetX = MRPos->X;
@@ -900,44 +847,47 @@ FCortexCommandResult FCortexMaterialGraphOps::AutoLayout(const TSharedPtr<FJsonO
 		LayoutResult.Positions.Remove(MaterialResultId);
 	}
 
-	// Apply positions back to Material expressions
-	TUniquePtr<FScopedTransaction> Transaction;
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Transaction = MakeUnique<FScopedTransaction>(
-			FText::FromString(TEXT("Cortex: Auto-Layout Material Graph")));
-		Material->PreEditChange(nullptr);
-	}
-
 	TMap<FString, UMaterialExpression*> IdToExpr;
-	for (UMaterialExpression* Expr : Expressions)
+	for (const auto& Pair : ExprToId)
 	{
-		if (Expr) IdToExpr.Add(Expr->GetPathName(), Expr);
+		IdToExpr.Add(Pair.Value, Pair.Key);
 	}
 
+	// Only expressions whose position actually changes are touched
+	TArray<TPair<UMaterialExpression*, FIntPoint>> Moves;
+	Moves.Reserve(LayoutResult.Positions.Num());
 	for (const auto& Pair : LayoutResult.Positions)
 	{
-		UMaterialExpression** ExprPtr = IdToExpr.Find(Pair.Key);
-		if (ExprPtr && *ExprPtr)
+		UMaterialExpression* const* ExprPtr = IdToExpr.Find(Pair.Key);
+		if (ExprPtr && *ExprPtr
+			&& ((*ExprPtr)->MaterialExpressionEditorX != Pair.Value.X || (*ExprPtr)->MaterialExpressionEditorY != Pair.Value.Y))
 		{
-			(*ExprPtr)->MaterialExpressionEditorX = Pair.Value.X;
-			(*ExprPtr)->MaterialExpressionEditorY = Pair.Value.Y;
+			Moves.Emplace(*ExprPtr, Pair.Value);
 		}
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
+	if (Moves.Num() > 0)
 	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
+		// Apply positions back to Material expressions
+		FCortexMaterialEditScope EditScope(Material, FText::FromString(TEXT("Cortex: Auto-Layout Material Graph")));
+
+		for (const TPair<UMaterialExpression*, FIntPoint>& Move : Moves)
+		{
+			Move.Key->Modify();
+			Move.Key->MaterialExpressionEditorX = Move.Value.X;
+			Move.Key->MaterialExpressionEditorY = Move.Value.Y;
+		}
+
+		EditScope.Finish();
 	}
-	Material->MarkPackageDirty();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	Data->SetStringField(TEXT("mode"), bIncremental ? TEXT("incremental") : TEXT("full"));
 	Data->SetNumberField(TEXT("node_count"), Expressions.Num());
+	Data->SetNumberField(TEXT("moved_count"), Moves.Num());
+	Data->SetNumberField(TEXT("layout_ms"), LayoutMs);
+	Data->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	return FCortexCommandRouter::Success(Data);
 }
 
@@ -1005,13 +955,9 @@ FCortexCommandResult FCortexMaterialGraphOps::SetNodeProperty(const TSharedPtr<F
 			TEXT("Missing required param: value"));
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		FScopedTransaction Transaction(FText::FromString(
-			FString::Printf(TEXT("Cortex: Set Node Property %s"), *PropertyName)
-		));
-		Material->PreEditChange(nullptr);
-	}
+	FCortexMaterialEditScope EditScope(Material, FText::FromString(
+		FString::Printf(TEXT("Cortex: Set Node Property %s"), *PropertyName)));
+	Expression->Modify();
 
 	void* PropertyAddress = Property->ContainerPtrToValuePtr<void>(Expression);
 
@@ -1026,15 +972,7 @@ FCortexCommandResult FCortexMaterialGraphOps::SetNodeProperty(const TSharedPtr<F
 			FString::Printf(TEXT("Failed to set property '%s': %s"), *PropertyName, *WarningStr));
 	}
 
-	if (!FCortexCommandRouter::IsInBatch())
-	{
-		Material->PostEditChange();
-	}
-	else
-	{
-		FCortexBatchScope::MarkMaterialDirty(Material);
-	}
-	Material->MarkPackageDirty();
+	EditScope.Finish();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("node_id"), NodeId);
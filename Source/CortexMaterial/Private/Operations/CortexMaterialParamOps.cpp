@@ -5,203 +5,409 @@
 #include "Materials/MaterialInterface.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "CortexMaterialInstanceIndex.h"
+#include "CortexMaterialParameterCache.h"
+#include "Misc/PackageName.h"
+#include "ScopedTransaction.h"
 
-FCortexCommandResult FCortexMaterialParamOps::ListParameters(const TSharedPtr<FJsonObject>& Params)
+namespace
 {
-	FString AssetPath;
-	if (!Params.IsValid() || !Params->TryGetStringField(TEXT("asset_path"), AssetPath))
+/** A material first, then an instance, as list_parameters and get_parameter accept either. */
+UMaterialInterface* LoadMaterialOrInstance(const FString& AssetPath, FCortexCommandResult& OutError)
+{
+	if (UMaterial* Material = FCortexMaterialAssetOps::LoadMaterial(AssetPath, OutError))
 	{
-		return FCortexCommandRouter::Error(
-			CortexErrorCodes::InvalidField, TEXT("Missing required param: asset_path"));
+		return Material;
 	}
+	return FCortexMaterialAssetOps::LoadInstance(AssetPath, OutError);
+}
 
-	// Try loading as material first, then as instance
-	UMaterialInterface* MaterialInterface = nullptr;
-	FCortexCommandResult LoadError;
+TSharedPtr<FJsonValue> MaterialValueToJson(const FMaterialParameterValue& Value, const FString& Type)
+{
+	if (Type == TEXT("scalar"))
+	{
+		return MakeShared<FJsonValueNumber>(Value.AsScalar());
+	}
+	if (Type == TEXT("vector"))
+	{
+		const FLinearColor Color = Value.AsLinearColor();
+		TArray<TSharedPtr<FJsonValue>> ColorArray;
+		ColorArray.Add(MakeShared<FJsonValueNumber>(Color.R));
+		ColorArray.Add(MakeShared<FJsonValueNumber>(Color.G));
+		ColorArray.Add(MakeShared<FJsonValueNumber>(Color.B));
+		ColorArray.Add(MakeShared<FJsonValueNumber>(Color.A));
+		return MakeShared<FJsonValueArray>(ColorArray);
+	}
+	if (Type == TEXT("static_switch"))
+	{
+		return MakeShared<FJsonValueBoolean>(Value.AsStaticSwitch());
+	}
+	const UTexture* Texture = Value.Texture;
+	return MakeShared<FJsonValueString>(Texture ? Texture->GetPathName() : FString());
+}
 
-	UMaterial* Material = FCortexMaterialAssetOps::LoadMaterial(AssetPath, LoadError);
-	if (Material)
+/** list_parameters entry */
+TSharedRef<FJsonObject> ParameterEntryToJson(const FCortexMaterialParameterEntry& Entry, bool bIsInstance)
+{
+	TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("name"), Entry.Info.Name.ToString());
+	Json->SetField(TEXT("default_value"), MaterialValueToJson(Entry.DefaultValue, Entry.Type));
+	Json->SetStringField(TEXT("group"), StaticEnum<EMaterialParameterAssociation>()->GetNameStringByValue((int64)Entry.Info.Association.GetValue()));
+	Json->SetStringField(TEXT("parameter_group"), Entry.Group.ToString());
+	Json->SetNumberField(TEXT("sort_priority"), Entry.SortPriority);
+	Json->SetStringField(TEXT("expression_guid"), Entry.ExpressionGuid.ToString());
+
+	if (bIsInstance)
 	{
-		MaterialInterface = Material;
+		const bool bOverridden = !Entry.OverrideSource.IsEmpty();
+		Json->SetBoolField(TEXT("is_overridden"), bOverridden);
+		if (bOverridden)
+		{
+			Json->SetField(TEXT("current_value"), MaterialValueToJson(Entry.CurrentValue, Entry.Type));
+			Json->SetStringField(TEXT("override_source"), Entry.OverrideSource);
+		}
 	}
-	else
+	return Json;
+}
+
+/** get_parameter / get_parameters entry */
+TSharedPtr<FJsonObject> ParameterValueToJson(const FCortexMaterialParameterEntry& Entry)
+{
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("name"), Entry.Info.Name.ToString());
+	Json->SetStringField(TEXT("type"), Entry.Type);
+	Json->SetField(TEXT("value"), MaterialValueToJson(Entry.CurrentValue, Entry.Type));
+	Json->SetField(TEXT("default_value"), MaterialValueToJson(Entry.DefaultValue, Entry.Type));
+	Json->SetStringField(TEXT("parameter_group"), Entry.Group.ToString());
+	Json->SetNumberField(TEXT("sort_priority"), Entry.SortPriority);
+	Json->SetStringField(TEXT("expression_guid"), Entry.ExpressionGuid.ToString());
+	Json->SetStringField(TEXT("override_source"), Entry.OverrideSource);
+	return Json;
+}
+
+/** A typed parameter value, parsed from the request's "value" field. */
+struct FParameterValue
+{
+	float Scalar = 0.0f;
+	FLinearColor Vector = FLinearColor::Transparent;
+	UTexture* Texture = nullptr;
+};
+
+/**
+ * Type of ParamName as the instance's parent exposes it. An explicit RequestedType is
+ * taken as is unless bMustExist, in which case the parameter has to exist on the parent
+ * with that type.
+ */
+bool ResolveParameterType(
+	const UMaterialInstance* Instance,
+	const FName ParamName,
+	const FString& RequestedType,
+	const bool bMustExist,
+	FString& OutType,
+	FString& OutError)
+{
+	FString ParentType;
+	if (const UMaterialInterface* Parent = Instance->Parent)
 	{
-		UMaterialInstanceConstant* Instance = FCortexMaterialAssetOps::LoadInstance(AssetPath, LoadError);
-		if (Instance)
+		float ScalarValue;
+		FLinearColor VectorValue;
+		UTexture* TextureValue = nullptr;
+		if (Parent->GetScalarParameterValue(ParamName, ScalarValue))
 		{
-			MaterialInterface = Instance;
+			ParentType = TEXT("scalar");
 		}
-		else
+		else if (Parent->GetVectorParameterValue(ParamName, VectorValue))
 		{
-			return LoadError;
+			ParentType = TEXT("vector");
+		}
+		else if (Parent->GetTextureParameterValue(ParamName, TextureValue))
+		{
+			ParentType = TEXT("texture");
 		}
 	}
 
-	// Get all parameter info
-	TArray<FMaterialParameterInfo> ScalarInfos;
-	TArray<FGuid> ScalarGuids;
-	MaterialInterface->GetAllScalarParameterInfo(ScalarInfos, ScalarGuids);
-
-	TArray<FMaterialParameterInfo> VectorInfos;
-	TArray<FGuid> VectorGuids;
-	MaterialInterface->GetAllVectorParameterInfo(VectorInfos, VectorGuids);
-
-	TArray<FMaterialParameterInfo> TextureInfos;
-	TArray<FGuid> TextureGuids;
-	MaterialInterface->GetAllTextureParameterInfo(TextureInfos, TextureGuids);
-
-	UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(MaterialInterface);
-	bool bIsInstance = (Instance != nullptr);
-
-	// Build scalar array with full metadata
-	TArray<TSharedPtr<FJsonValue>> ScalarArray;
-	for (int32 i = 0; i < ScalarInfos.Num(); ++i)
+	if (!RequestedType.IsEmpty() && !bMustExist)
 	{
-		const FMaterialParameterInfo& Info = ScalarInfos[i];
-		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), Info.Name.ToString());
-
-		float DefaultValue = 0.0f;
-		MaterialInterface->GetScalarParameterDefaultValue(Info, DefaultValue);
-		Entry->SetNumberField(TEXT("default_value"), DefaultValue);
+		OutType = RequestedType;
+		return true;
+	}
+	if (ParentType.IsEmpty())
+	{
+		OutError = bMustExist
+			? FString::Printf(TEXT("Parameter not found on parent: %s"), *ParamName.ToString())
+			: FString(TEXT("Missing required param: parameter_type (could not auto-detect)"));
+		return false;
+	}
+	if (!RequestedType.IsEmpty() && RequestedType != ParentType)
+	{
+		OutError = FString::Printf(TEXT("Parameter %s is %s, not %s"), *ParamName.ToString(), *ParentType, *RequestedType);
+		return false;
+	}
+	OutType = ParentType;
+	return true;
+}
 
-		Entry->SetStringField(TEXT("group"), StaticEnum<EMaterialParameterAssociation>()->GetNameStringByValue((int64)Info.Association.GetValue()));
-		Entry->SetNumberField(TEXT("sort_priority"), Info.Index);
+/** Parse Value as a Type parameter value; set_parameter and set_parameters_bulk share it. */
+bool ParseParameterValue(
+	const FString& Type,
+	const TSharedPtr<FJsonValue>& Value,
+	FParameterValue& OutValue,
+	FString& OutErrorCode,
+	FString& OutError)
+{
+	OutErrorCode = CortexErrorCodes::InvalidParameter;
+	if (Type == TEXT("scalar"))
+	{
+		double Number = 0.0;
+		if (!Value.IsValid() || !Value->TryGetNumber(Number))
+		{
+			OutError = TEXT("Missing or invalid scalar value");
+			return false;
+		}
+		OutValue.Scalar = static_cast<float>(Number);
+		return true;
+	}
 
-		if (bIsInstance)
+	if (Type == TEXT("vector"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ColorArray = nullptr;
+		const TSharedPtr<FJsonObject>* ColorObject = nullptr;
+		if (Value.IsValid() && Value->TryGetArray(ColorArray) && ColorArray->Num() == 4)
 		{
-			float CurrentValue = 0.0f;
-			bool bOverridden = Instance->GetScalarParameterValue(Info, CurrentValue);
-			Entry->SetBoolField(TEXT("is_overridden"), bOverridden);
-			if (bOverridden)
+			double Channels[4];
+			bool bNumbers = true;
+			for (int32 Channel = 0; Channel < 4; ++Channel)
+			{
+				bNumbers &= (*ColorArray)[Channel].IsValid() && (*ColorArray)[Channel]->TryGetNumber(Channels[Channel]);
+			}
+			if (bNumbers)
 			{
-				Entry->SetNumberField(TEXT("current_value"), CurrentValue);
+				OutValue.Vector = FLinearColor(Channels[0], Channels[1], Channels[2], Channels[3]);
+				return true;
 			}
 		}
-
-		ScalarArray.Add(MakeShared<FJsonValueObject>(Entry));
+		else if (Value.IsValid()
+			&& Value->TryGetObject(ColorObject)
+			&& (*ColorObject).IsValid()
+			&& (*ColorObject)->TryGetNumberField(TEXT("R"), OutValue.Vector.R)
+			&& (*ColorObject)->TryGetNumberField(TEXT("G"), OutValue.Vector.G)
+			&& (*ColorObject)->TryGetNumberField(TEXT("B"), OutValue.Vector.B)
+			&& (*ColorObject)->TryGetNumberField(TEXT("A"), OutValue.Vector.A))
+		{
+			return true;
+		}
+		OutError = TEXT("Missing or invalid vector value (expects [R, G, B, A] or {R,G,B,A})");
+		return false;
 	}
 
-	// Build vector array with full metadata
-	TArray<TSharedPtr<FJsonValue>> VectorArray;
-	for (int32 i = 0; i < VectorInfos.Num(); ++i)
+	if (Type == TEXT("texture"))
 	{
-		const FMaterialParameterInfo& Info = VectorInfos[i];
-		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), Info.Name.ToString());
-
-		FLinearColor DefaultValue;
-		MaterialInterface->GetVectorParameterDefaultValue(Info, DefaultValue);
-		TArray<TSharedPtr<FJsonValue>> DefaultArray;
-		DefaultArray.Add(MakeShared<FJsonValueNumber>(DefaultValue.R));
-		DefaultArray.Add(MakeShared<FJsonValueNumber>(DefaultValue.G));
-		DefaultArray.Add(MakeShared<FJsonValueNumber>(DefaultValue.B));
-		DefaultArray.Add(MakeShared<FJsonValueNumber>(DefaultValue.A));
-		Entry->SetArrayField(TEXT("default_value"), DefaultArray);
-
-		Entry->SetStringField(TEXT("group"), StaticEnum<EMaterialParameterAssociation>()->GetNameStringByValue((int64)Info.Association.GetValue()));
-		Entry->SetNumberField(TEXT("sort_priority"), Info.Index);
+		FString TexturePath;
+		if (!Value.IsValid() || !Value->TryGetString(TexturePath))
+		{
+			OutError = TEXT("Missing texture path");
+			return false;
+		}
 
-		if (bIsInstance)
+		OutValue.Texture = nullptr;
+		if (!TexturePath.IsEmpty())
 		{
-			FLinearColor CurrentValue;
-			bool bOverridden = Instance->GetVectorParameterValue(Info, CurrentValue);
-			Entry->SetBoolField(TEXT("is_overridden"), bOverridden);
-			if (bOverridden)
+			// Guard LoadObject to prevent SkipPackage warnings
+			const FString PkgName = FPackageName::ObjectPathToPackageName(TexturePath);
+			if (FindPackage(nullptr, *PkgName) || FPackageName::DoesPackageExist(PkgName))
+			{
+				OutValue.Texture = LoadObject<UTexture>(nullptr, *TexturePath);
+			}
+			if (!OutValue.Texture)
 			{
-				TArray<TSharedPtr<FJsonValue>> CurrentArray;
-				CurrentArray.Add(MakeShared<FJsonValueNumber>(CurrentValue.R));
-				CurrentArray.Add(MakeShared<FJsonValueNumber>(CurrentValue.G));
-				CurrentArray.Add(MakeShared<FJsonValueNumber>(CurrentValue.B));
-				CurrentArray.Add(MakeShared<FJsonValueNumber>(CurrentValue.A));
-				Entry->SetArrayField(TEXT("current_value"), CurrentArray);
+				OutErrorCode = CortexErrorCodes::AssetNotFound;
+				OutError = FString::Printf(TEXT("Texture not found: %s"), *TexturePath);
+				return false;
 			}
 		}
+		return true;
+	}
 
-		VectorArray.Add(MakeShared<FJsonValueObject>(Entry));
+	OutError = FString::Printf(TEXT("Unknown parameter type: %s"), *Type);
+	return false;
+}
+
+/** One parameter edit of a bulk call. The type is resolved per instance against its parent. */
+struct FBulkParameterEdit
+{
+	FName Name;
+	/** parameter_type as requested, empty to take the parent's */
+	FString RequestedType;
+	TSharedPtr<FJsonValue> Value;
+	/** Parsed once per resolved type, as instances may have different parents */
+	TMap<FString, FParameterValue> Parsed;
+	TMap<FString, FString> ParseErrors;
+};
+
+bool ParseBulkParameterEdit(const TSharedPtr<FJsonObject>& EditObj, FBulkParameterEdit& OutEdit, FString& OutError)
+{
+	FString ParameterName;
+	if (!EditObj->TryGetStringField(TEXT("parameter_name"), ParameterName)
+		&& !EditObj->TryGetStringField(TEXT("name"), ParameterName))
+	{
+		OutError = TEXT("Missing parameter_name (or name)");
+		return false;
 	}
+	OutEdit.Name = FName(*ParameterName);
 
-	// Build texture array with full metadata
-	TArray<TSharedPtr<FJsonValue>> TextureArray;
-	for (int32 i = 0; i < TextureInfos.Num(); ++i)
+	OutEdit.Value = EditObj->TryGetField(TEXT("value"));
+	if (!OutEdit.Value.IsValid())
 	{
-		const FMaterialParameterInfo& Info = TextureInfos[i];
-		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), Info.Name.ToString());
+		OutError = FString::Printf(TEXT("%s: missing value"), *ParameterName);
+		return false;
+	}
 
-		UTexture* DefaultTexture = nullptr;
-		MaterialInterface->GetTextureParameterDefaultValue(Info, DefaultTexture);
-		if (DefaultTexture)
-		{
-			Entry->SetStringField(TEXT("default_value"), DefaultTexture->GetPathName());
-		}
-		else
+	// An explicit type can be checked before anything is touched
+	if (EditObj->TryGetStringField(TEXT("parameter_type"), OutEdit.RequestedType))
+	{
+		FParameterValue Parsed;
+		FString ErrorCode;
+		FString ParseError;
+		if (!ParseParameterValue(OutEdit.RequestedType, OutEdit.Value, Parsed, ErrorCode, ParseError))
 		{
-			Entry->SetStringField(TEXT("default_value"), TEXT(""));
+			OutError = FString::Printf(TEXT("%s: %s"), *ParameterName, *ParseError);
+			return false;
 		}
+		OutEdit.Parsed.Add(OutEdit.RequestedType, Parsed);
+	}
+	return true;
+}
 
-		Entry->SetStringField(TEXT("group"), StaticEnum<EMaterialParameterAssociation>()->GetNameStringByValue((int64)Info.Association.GetValue()));
-		Entry->SetNumberField(TEXT("sort_priority"), Info.Index);
+/** The edit's type and value for one instance; false with OutError when it does not apply there. */
+bool ResolveBulkEdit(
+	const UMaterialInstance* Instance,
+	FBulkParameterEdit& Edit,
+	FString& OutType,
+	FParameterValue& OutValue,
+	FString& OutError)
+{
+	if (!ResolveParameterType(Instance, Edit.Name, Edit.RequestedType, true, OutType, OutError))
+	{
+		return false;
+	}
+	if (const FParameterValue* Parsed = Edit.Parsed.Find(OutType))
+	{
+		OutValue = *Parsed;
+		return true;
+	}
+	if (const FString* ParseError = Edit.ParseErrors.Find(OutType))
+	{
+		OutError = *ParseError;
+		return false;
+	}
 
-		if (bIsInstance)
+	FString ErrorCode;
+	if (!ParseParameterValue(OutType, Edit.Value, OutValue, ErrorCode, OutError))
+	{
+		Edit.ParseErrors.Add(OutType, OutError);
+		return false;
+	}
+	Edit.Parsed.Add(OutType, OutValue);
+	return true;
+}
+
+/** Instance paths from an explicit list, or every indexed instance matching a wildcard. */
+void ResolveBulkInstances(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutPaths)
+{
+	const TArray<TSharedPtr<FJsonValue>>* InstancesArray = nullptr;
+	if (Params->TryGetArrayField(TEXT("instances"), InstancesArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *InstancesArray)
 		{
-			UTexture* CurrentTexture = nullptr;
-			bool bOverridden = Instance->GetTextureParameterValue(Info, CurrentTexture);
-			Entry->SetBoolField(TEXT("is_overridden"), bOverridden);
-			if (bOverridden && CurrentTexture)
+			FString Path;
+			if (Value->TryGetString(Path) && !Path.IsEmpty())
 			{
-				Entry->SetStringField(TEXT("current_value"), CurrentTexture->GetPathName());
+				OutPaths.AddUnique(FCortexMaterialInstanceIndex::NormalizePath(Path).ToString());
 			}
 		}
-
-		TextureArray.Add(MakeShared<FJsonValueObject>(Entry));
+		return;
 	}
 
-	// Build static switch array
-	TArray<FMaterialParameterInfo> StaticSwitchInfos;
-	TArray<FGuid> StaticSwitchGuids;
-	MaterialInterface->GetAllStaticSwitchParameterInfo(StaticSwitchInfos, StaticSwitchGuids);
-
-	TArray<TSharedPtr<FJsonValue>> StaticSwitchArray;
-	for (int32 i = 0; i < StaticSwitchInfos.Num(); ++i)
+	FString Pattern;
+	if (!Params->TryGetStringField(TEXT("instances"), Pattern) || Pattern.IsEmpty())
 	{
-		const FMaterialParameterInfo& Info = StaticSwitchInfos[i];
-		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), Info.Name.ToString());
-
-		bool DefaultValue = false;
-		FGuid OutGuid;
-		MaterialInterface->GetStaticSwitchParameterDefaultValue(Info, DefaultValue, OutGuid);
-		Entry->SetBoolField(TEXT("default_value"), DefaultValue);
+		return;
+	}
 
-		Entry->SetStringField(TEXT("group"), StaticEnum<EMaterialParameterAssociation>()->GetNameStringByValue((int64)Info.Association.GetValue()));
-		Entry->SetNumberField(TEXT("sort_priority"), Info.Index);
+	TArray<FName> AllInstances;
+	FCortexMaterialInstanceIndex::Get().GetAll(AllInstances);
+	for (const FName Instance : AllInstances)
+	{
+		const FString ObjectPath = Instance.ToString();
+		if (ObjectPath.MatchesWildcard(Pattern)
+			|| FPackageName::ObjectPathToPackageName(ObjectPath).MatchesWildcard(Pattern))
+		{
+			OutPaths.Add(ObjectPath);
+		}
+	}
+	OutPaths.Sort();
+}
 
-		if (bIsInstance)
+int32 GetInstanceDepth(const UMaterialInstance* Instance, const UMaterialInterface*& OutRoot)
+{
+	int32 Depth = 0;
+	const UMaterialInterface* Current = Instance;
+	// Bounded: a parent cycle is invalid but must not hang the editor
+	while (const UMaterialInstance* CurrentInstance = Cast<UMaterialInstance>(Current))
+	{
+		if (!CurrentInstance->Parent || Depth > 64)
 		{
-			bool CurrentValue = false;
-			bool bOverridden = Instance->GetStaticSwitchParameterValue(Info, CurrentValue, OutGuid);
-			Entry->SetBoolField(TEXT("is_overridden"), bOverridden);
-			if (bOverridden)
-			{
-				Entry->SetBoolField(TEXT("current_value"), CurrentValue);
-			}
+			break;
 		}
+		Current = CurrentInstance->Parent;
+		++Depth;
+	}
+	OutRoot = Current;
+	return Depth;
+}
+}
 
-		StaticSwitchArray.Add(MakeShared<FJsonValueObject>(Entry));
+FCortexCommandResult FCortexMaterialParamOps::ListParameters(const TSharedPtr<FJsonObject>& Params)
+{
+	FString AssetPath;
+	if (!Params.IsValid() || !Params->TryGetStringField(TEXT("asset_path"), AssetPath))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField, TEXT("Missing required param: asset_path"));
 	}
 
+	FCortexCommandResult LoadError;
+	UMaterialInterface* MaterialInterface = LoadMaterialOrInstance(AssetPath, LoadError);
+	if (MaterialInterface == nullptr)
+	{
+		return LoadError;
+	}
+
+	const bool bIsInstance = MaterialInterface->IsA<UMaterialInstance>();
+	const TSharedRef<const FCortexMaterialParameterTable> Table =
+		FCortexMaterialParameterCache::Get().GetTable(MaterialInterface);
+
 	// Build response structure matching design doc
+	TMap<FString, TArray<TSharedPtr<FJsonValue>>> ArraysByType;
+	for (const TCHAR* Type : { TEXT("scalar"), TEXT("vector"), TEXT("texture"), TEXT("static_switch") })
+	{
+		ArraysByType.Add(Type);
+	}
+	for (const FCortexMaterialParameterEntry& Entry : Table->Entries)
+	{
+		ArraysByType.FindOrAdd(Entry.Type).Add(MakeShared<FJsonValueObject>(ParameterEntryToJson(Entry, bIsInstance)));
+	}
+
 	TSharedPtr<FJsonObject> ParametersObj = MakeShared<FJsonObject>();
-	ParametersObj->SetArrayField(TEXT("scalar"), ScalarArray);
-	ParametersObj->SetArrayField(TEXT("vector"), VectorArray);
-	ParametersObj->SetArrayField(TEXT("texture"), TextureArray);
-	ParametersObj->SetArrayField(TEXT("static_switch"), StaticSwitchArray);
+	for (TPair<FString, TArray<TSharedPtr<FJsonValue>>>& Pair : ArraysByType)
+	{
+		ParametersObj->SetArrayField(Pair.Key, Pair.Value);
+	}
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("asset_path"), AssetPath);
 	Data->SetObjectField(TEXT("parameters"), ParametersObj);
-	Data->SetNumberField(TEXT("count"), ScalarArray.Num() + VectorArray.Num() + TextureArray.Num() + StaticSwitchArray.Num());
+	Data->SetNumberField(TEXT("count"), Table->Entries.Num());
 
 	return FCortexCommandRouter::Success(Data);
 }
@@ -219,79 +425,82 @@ FCortexCommandResult FCortexMaterialParamOps::GetParameter(const TSharedPtr<FJso
 			TEXT("Missing required params: asset_path and parameter_name"));
 	}
 
-	// Try loading as material first, then as instance
-	UMaterialInterface* MaterialInterface = nullptr;
 	FCortexCommandResult LoadError;
-
-	UMaterial* Material = FCortexMaterialAssetOps::LoadMaterial(AssetPath, LoadError);
-	if (Material)
+	UMaterialInterface* MaterialInterface = LoadMaterialOrInstance(AssetPath, LoadError);
+	if (MaterialInterface == nullptr)
 	{
-		MaterialInterface = Material;
+		return LoadError;
 	}
-	else
+
+	const TSharedRef<const FCortexMaterialParameterTable> Table =
+		FCortexMaterialParameterCache::Get().GetTable(MaterialInterface);
+	const FCortexMaterialParameterEntry* Entry = Table->Find(FName(*ParameterName));
+	if (Entry == nullptr)
 	{
-		UMaterialInstanceConstant* Instance = FCortexMaterialAssetOps::LoadInstance(AssetPath, LoadError);
-		if (Instance)
-		{
-			MaterialInterface = Instance;
-		}
-		else
-		{
-			return LoadError;
-		}
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::ParameterNotFound,
+			FString::Printf(TEXT("Parameter not found: %s"), *ParameterName));
 	}
 
-	FName ParamName(*ParameterName);
+	return FCortexCommandRouter::Success(ParameterValueToJson(*Entry));
+}
 
-	// Try scalar
-	float ScalarValue;
-	if (MaterialInterface->GetScalarParameterValue(ParamName, ScalarValue))
+FCortexCommandResult FCortexMaterialParamOps::GetParameters(const TSharedPtr<FJsonObject>& Params)
+{
+	FString AssetPath;
+	if (!Params.IsValid() || !Params->TryGetStringField(TEXT("asset_path"), AssetPath))
 	{
-		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		Data->SetStringField(TEXT("name"), ParameterName);
-		Data->SetStringField(TEXT("type"), TEXT("scalar"));
-		Data->SetNumberField(TEXT("value"), ScalarValue);
-		return FCortexCommandRouter::Success(Data);
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField, TEXT("Missing required param: asset_path"));
 	}
 
-	// Try vector
-	FLinearColor VectorValue;
-	if (MaterialInterface->GetVectorParameterValue(ParamName, VectorValue))
+	FCortexCommandResult LoadError;
+	UMaterialInterface* MaterialInterface = LoadMaterialOrInstance(AssetPath, LoadError);
+	if (MaterialInterface == nullptr)
 	{
-		TArray<TSharedPtr<FJsonValue>> ColorArray;
-		ColorArray.Add(MakeShared<FJsonValueNumber>(VectorValue.R));
-		ColorArray.Add(MakeShared<FJsonValueNumber>(VectorValue.G));
-		ColorArray.Add(MakeShared<FJsonValueNumber>(VectorValue.B));
-		ColorArray.Add(MakeShared<FJsonValueNumber>(VectorValue.A));
-
-		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		Data->SetStringField(TEXT("name"), ParameterName);
-		Data->SetStringField(TEXT("type"), TEXT("vector"));
-		Data->SetArrayField(TEXT("value"), ColorArray);
-		return FCortexCommandRouter::Success(Data);
+		return LoadError;
 	}
 
-	// Try texture
-	UTexture* TextureValue = nullptr;
-	if (MaterialInterface->GetTextureParameterValue(ParamName, TextureValue))
+	// One table serves every requested name
+	const TSharedRef<const FCortexMaterialParameterTable> Table =
+		FCortexMaterialParameterCache::Get().GetTable(MaterialInterface);
+
+	TArray<TSharedPtr<FJsonValue>> ParametersArray;
+	TArray<TSharedPtr<FJsonValue>> MissingArray;
+	const TArray<TSharedPtr<FJsonValue>>* NamesArray = nullptr;
+	if (Params->TryGetArrayField(TEXT("parameter_names"), NamesArray))
 	{
-		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		Data->SetStringField(TEXT("name"), ParameterName);
-		Data->SetStringField(TEXT("type"), TEXT("texture"));
-		if (TextureValue)
+		for (const TSharedPtr<FJsonValue>& NameValue : *NamesArray)
 		{
-			Data->SetStringField(TEXT("value"), TextureValue->GetPathName());
+			const FString Name = NameValue->AsString();
+			if (const FCortexMaterialParameterEntry* Entry = Table->Find(FName(*Name)))
+			{
+				ParametersArray.Add(MakeShared<FJsonValueObject>(ParameterValueToJson(*Entry)));
+			}
+			else
+			{
+				MissingArray.Add(MakeShared<FJsonValueString>(Name));
+			}
 		}
-		else
+	}
+	else
+	{
+		for (const TPair<FName, int32>& Pair : Table->IndexByName)
 		{
-			Data->SetStringField(TEXT("value"), TEXT(""));
+			ParametersArray.Add(MakeShared<FJsonValueObject>(ParameterValueToJson(Table->Entries[Pair.Value])));
 		}
-		return FCortexCommandRouter::Success(Data);
 	}
 
-	return FCortexCommandRouter::Error(
-		CortexErrorCodes::ParameterNotFound,
-		FString::Printf(TEXT("Parameter not found: %s"), *ParameterName));
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	Data->SetArrayField(TEXT("parameters"), ParametersArray);
+	Data->SetNumberField(TEXT("count"), ParametersArray.Num());
+	if (MissingArray.Num() > 0)
+	{
+		Data->SetArrayField(TEXT("missing"), MissingArray);
+	}
+
+	return FCortexCommandRouter::Success(Data);
 }
 
 FCortexCommandResult FCortexMaterialParamOps::SetParameter(const TSharedPtr<FJsonObject>& Params)
@@ -328,130 +537,36 @@ FCortexCommandResult FCortexMaterialParamOps::SetParameter(const TSharedPtr<FJso
 	FName ParamName(*ParameterName);
 
 	// Auto-detect parameter_type from parent material when not provided
-	if (!Params->TryGetStringField(TEXT("parameter_type"), ParameterType))
+	FString RequestedType;
+	FString ResolveError;
+	Params->TryGetStringField(TEXT("parameter_type"), RequestedType);
+	if (!ResolveParameterType(Instance, ParamName, RequestedType, false, ParameterType, ResolveError))
 	{
-		UMaterialInterface* Parent = Instance->Parent;
-		if (Parent)
-		{
-			float ScalarValue;
-			FLinearColor VectorValue;
-			UTexture* TextureValue = nullptr;
-			if (Parent->GetScalarParameterValue(ParamName, ScalarValue))
-			{
-				ParameterType = TEXT("scalar");
-			}
-			else if (Parent->GetVectorParameterValue(ParamName, VectorValue))
-			{
-				ParameterType = TEXT("vector");
-			}
-			else if (Parent->GetTextureParameterValue(ParamName, TextureValue))
-			{
-				ParameterType = TEXT("texture");
-			}
-		}
-		if (ParameterType.IsEmpty())
-		{
-			return FCortexCommandRouter::Error(
-				CortexErrorCodes::InvalidField,
-				TEXT("Missing required param: parameter_type (could not auto-detect)"));
-		}
+		return FCortexCommandRouter::Error(CortexErrorCodes::InvalidField, ResolveError);
 	}
 
-	if (ParameterType == TEXT("scalar"))
+	FParameterValue Value;
+	FString ErrorCode;
+	FString ParseError;
+	if (!ParseParameterValue(ParameterType, Params->TryGetField(TEXT("value")), Value, ErrorCode, ParseError))
 	{
-		double Value = 0.0;
-		if (!Params->TryGetNumberField(TEXT("value"), Value))
-		{
-			return FCortexCommandRouter::Error(
-				CortexErrorCodes::InvalidParameter, TEXT("Missing or invalid scalar value"));
-		}
-
-		Instance->SetScalarParameterValueEditorOnly(ParamName, static_cast<float>(Value));
-		Instance->PostEditChange();
-		Instance->MarkPackageDirty();
+		return FCortexCommandRouter::Error(ErrorCode, ParseError);
 	}
-	else if (ParameterType == TEXT("vector"))
-	{
-		FLinearColor Color = FLinearColor::Transparent;
-		bool bParsedColor = false;
-
-		const TArray<TSharedPtr<FJsonValue>>* ColorArray = nullptr;
-		if (Params->TryGetArrayField(TEXT("value"), ColorArray) && ColorArray->Num() == 4)
-		{
-			Color = FLinearColor(
-				(*ColorArray)[0]->AsNumber(),
-				(*ColorArray)[1]->AsNumber(),
-				(*ColorArray)[2]->AsNumber(),
-				(*ColorArray)[3]->AsNumber()
-			);
-			bParsedColor = true;
-		}
-		else
-		{
-			const TSharedPtr<FJsonObject>* ColorObject = nullptr;
-			if (Params->TryGetObjectField(TEXT("value"), ColorObject)
-				&& ColorObject != nullptr
-				&& (*ColorObject).IsValid()
-				&& (*ColorObject)->TryGetNumberField(TEXT("R"), Color.R)
-				&& (*ColorObject)->TryGetNumberField(TEXT("G"), Color.G)
-				&& (*ColorObject)->TryGetNumberField(TEXT("B"), Color.B)
-				&& (*ColorObject)->TryGetNumberField(TEXT("A"), Color.A))
-			{
-				bParsedColor = true;
-			}
-		}
-
-		if (!bParsedColor)
-		{
-			return FCortexCommandRouter::Error(
-				CortexErrorCodes::InvalidParameter,
-				TEXT("Missing or invalid vector value (expects [R, G, B, A] or {R,G,B,A})"));
-		}
 
-		Instance->SetVectorParameterValueEditorOnly(ParamName, Color);
-		Instance->PostEditChange();
-		Instance->MarkPackageDirty();
+	if (ParameterType == TEXT("scalar"))
+	{
+		Instance->SetScalarParameterValueEditorOnly(ParamName, Value.Scalar);
 	}
-	else if (ParameterType == TEXT("texture"))
+	else if (ParameterType == TEXT("vector"))
 	{
-		FString TexturePath;
-		if (!Params->TryGetStringField(TEXT("value"), TexturePath))
-		{
-			return FCortexCommandRouter::Error(
-				CortexErrorCodes::InvalidParameter, TEXT("Missing texture path"));
-		}
-
-		UTexture* Texture = nullptr;
-		if (!TexturePath.IsEmpty())
-		{
-			// Guard LoadObject to prevent SkipPackage warnings
-			FString PkgName = FPackageName::ObjectPathToPackageName(TexturePath);
-			if (!FindPackage(nullptr, *PkgName) && !FPackageName::DoesPackageExist(PkgName))
-			{
-				return FCortexCommandRouter::Error(
-					CortexErrorCodes::AssetNotFound,
-					FString::Printf(TEXT("Texture not found: %s"), *TexturePath));
-			}
-
-			Texture = LoadObject<UTexture>(nullptr, *TexturePath);
-			if (!Texture)
-			{
-				return FCortexCommandRouter::Error(
-					CortexErrorCodes::AssetNotFound,
-					FString::Printf(TEXT("Texture not found: %s"), *TexturePath));
-			}
-		}
-
-		Instance->SetTextureParameterValueEditorOnly(ParamName, Texture);
-		Instance->PostEditChange();
-		Instance->MarkPackageDirty();
+		Instance->SetVectorParameterValueEditorOnly(ParamName, Value.Vector);
 	}
 	else
 	{
-		return FCortexCommandRouter::Error(
-			CortexErrorCodes::InvalidParameter,
-			FString::Printf(TEXT("Unknown parameter type: %s"), *ParameterType));
+		Instance->SetTextureParameterValueEditorOnly(ParamName, Value.Texture);
 	}
+	Instance->PostEditChange();
+	Instance->MarkPackageDirty();
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("parameter_name"), ParameterName);
@@ -533,6 +648,214 @@ FCortexCommandResult FCortexMaterialParamOps::SetParameters(const TSharedPtr<FJs
 	return FCortexCommandRouter::Success(Data);
 }
 
+FCortexCommandResult FCortexMaterialParamOps::SetParametersBulk(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* ParametersArray = nullptr;
+	if (!Params.IsValid()
+		|| !Params->HasField(TEXT("instances"))
+		|| !Params->TryGetArrayField(TEXT("parameters"), ParametersArray))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required params: instances (list or wildcard) and parameters array"));
+	}
+
+	bool bParallelLoad = true;
+	Params->TryGetBoolField(TEXT("parallel_load"), bParallelLoad);
+
+	// Parse every edit up front so a malformed or mistyped value fails before anything is touched
+	TArray<FBulkParameterEdit> Edits;
+	for (const TSharedPtr<FJsonValue>& EditValue : *ParametersArray)
+	{
+		const TSharedPtr<FJsonObject>* EditObj = nullptr;
+		FString ParseError = TEXT("Invalid parameter object in array");
+		if (!EditValue->TryGetObject(EditObj)
+			|| !ParseBulkParameterEdit(*EditObj, Edits.AddDefaulted_GetRef(), ParseError))
+		{
+			return FCortexCommandRouter::Error(CortexErrorCodes::InvalidParameter, ParseError);
+		}
+	}
+
+	TArray<FString> InstancePaths;
+	ResolveBulkInstances(Params, InstancePaths);
+	if (InstancePaths.Num() == 0)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InstanceNotFound, TEXT("No material instances matched"));
+	}
+
+	// Queue every unloaded package so the loader can overlap their IO and serialization
+	const double LoadStart = FPlatformTime::Seconds();
+	if (bParallelLoad)
+	{
+		bool bQueued = false;
+		for (const FString& InstancePath : InstancePaths)
+		{
+			const FString PkgName = FPackageName::ObjectPathToPackageName(InstancePath);
+			if (!FindPackage(nullptr, *PkgName) && FPackageName::DoesPackageExist(PkgName))
+			{
+				LoadPackageAsync(PkgName);
+				bQueued = true;
+			}
+		}
+		if (bQueued)
+		{
+			FlushAsyncLoading();
+		}
+	}
+
+	struct FBulkTarget
+	{
+		UMaterialInstanceConstant* Instance = nullptr;
+		FString Path;
+		FString RootPath;
+		int32 Depth = 0;
+	};
+	TArray<FBulkTarget> Targets;
+	TArray<TSharedPtr<FJsonValue>> ErrorsArray;
+	for (const FString& InstancePath : InstancePaths)
+	{
+		FCortexCommandResult LoadError;
+		UMaterialInstanceConstant* Instance = FCortexMaterialAssetOps::LoadInstance(InstancePath, LoadError);
+		if (Instance == nullptr)
+		{
+			TSharedRef<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+			ErrorObj->SetStringField(TEXT("asset_path"), InstancePath);
+			ErrorObj->SetStringField(TEXT("error"), LoadError.ErrorMessage);
+			ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+			continue;
+		}
+
+		const UMaterialInterface* Root = nullptr;
+		FBulkTarget& Target = Targets.AddDefaulted_GetRef();
+		Target.Instance = Instance;
+		Target.Path = InstancePath;
+		Target.Depth = GetInstanceDepth(Instance, Root);
+		Target.RootPath = Root ? Root->GetPathName() : FString();
+	}
+	const double LoadMs = (FPlatformTime::Seconds() - LoadStart) * 1000.0;
+
+	// Grouped by root material, parents before children, so each update sees final parent values
+	Targets.Sort([](const FBulkTarget& A, const FBulkTarget& B)
+	{
+		if (A.RootPath != B.RootPath)
+		{
+			return A.RootPath < B.RootPath;
+		}
+		if (A.Depth != B.Depth)
+		{
+			return A.Depth < B.Depth;
+		}
+		return A.Path < B.Path;
+	});
+
+	TSet<FString> Roots;
+	for (const FBulkTarget& Target : Targets)
+	{
+		Roots.Add(Target.RootPath);
+	}
+
+	// Each edit is checked against each instance's own parent; one that does not exist there
+	// or has another type is reported for that instance and skipped
+	struct FResolvedEdit
+	{
+		FName Name;
+		FString Type;
+		FParameterValue Value;
+	};
+	TArray<TArray<FResolvedEdit>> ResolvedEdits;
+	ResolvedEdits.SetNum(Targets.Num());
+	int32 ParameterErrorCount = 0;
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		for (FBulkParameterEdit& Edit : Edits)
+		{
+			FResolvedEdit Resolved;
+			FString ResolveError;
+			Resolved.Name = Edit.Name;
+			if (!ResolveBulkEdit(Targets[TargetIndex].Instance, Edit, Resolved.Type, Resolved.Value, ResolveError))
+			{
+				TSharedRef<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+				ErrorObj->SetStringField(TEXT("asset_path"), Targets[TargetIndex].Path);
+				ErrorObj->SetStringField(TEXT("parameter_name"), Edit.Name.ToString());
+				ErrorObj->SetStringField(TEXT("error"), ResolveError);
+				ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+				++ParameterErrorCount;
+				continue;
+			}
+			ResolvedEdits[TargetIndex].Add(Resolved);
+		}
+	}
+
+	TUniquePtr<FScopedTransaction> Transaction;
+	if (!FCortexCommandRouter::IsInBatch())
+	{
+		Transaction = MakeUnique<FScopedTransaction>(FText::FromString(
+			FString::Printf(TEXT("Cortex: Bulk Set Parameters on %d Instances"), Targets.Num())));
+	}
+
+	// Raw values first: no update cascades until every instance holds its new overrides
+	const double ApplyStart = FPlatformTime::Seconds();
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		if (ResolvedEdits[TargetIndex].Num() == 0)
+		{
+			continue;
+		}
+		UMaterialInstanceConstant* Instance = Targets[TargetIndex].Instance;
+		Instance->Modify();
+		for (const FResolvedEdit& Edit : ResolvedEdits[TargetIndex])
+		{
+			if (Edit.Type == TEXT("scalar"))
+			{
+				Instance->SetScalarParameterValueEditorOnly(Edit.Name, Edit.Value.Scalar);
+			}
+			else if (Edit.Type == TEXT("vector"))
+			{
+				Instance->SetVectorParameterValueEditorOnly(Edit.Name, Edit.Value.Vector);
+			}
+			else
+			{
+				Instance->SetTextureParameterValueEditorOnly(Edit.Name, Edit.Value.Texture);
+			}
+		}
+	}
+	const double ApplyMs = (FPlatformTime::Seconds() - ApplyStart) * 1000.0;
+
+	// One update per instance, in the parent-to-child order above
+	const double UpdateStart = FPlatformTime::Seconds();
+	TArray<TSharedPtr<FJsonValue>> UpdatedArray;
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		if (ResolvedEdits[TargetIndex].Num() == 0)
+		{
+			continue;
+		}
+		const FBulkTarget& Target = Targets[TargetIndex];
+		Target.Instance->PostEditChange();
+		Target.Instance->MarkPackageDirty();
+		UpdatedArray.Add(MakeShared<FJsonValueString>(Target.Path));
+	}
+	const double UpdateMs = (FPlatformTime::Seconds() - UpdateStart) * 1000.0;
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("updated"), UpdatedArray);
+	Data->SetNumberField(TEXT("updated_count"), UpdatedArray.Num());
+	Data->SetNumberField(TEXT("matched_count"), InstancePaths.Num());
+	Data->SetNumberField(TEXT("group_count"), Roots.Num());
+	Data->SetNumberField(TEXT("parameter_count"), Edits.Num());
+	Data->SetNumberField(TEXT("parameter_error_count"), ParameterErrorCount);
+	Data->SetNumberField(TEXT("load_ms"), LoadMs);
+	Data->SetNumberField(TEXT("apply_ms"), ApplyMs);
+	Data->SetNumberField(TEXT("update_ms"), UpdateMs);
+	if (ErrorsArray.Num() > 0)
+	{
+		Data->SetArrayField(TEXT("errors"), ErrorsArray);
+	}
+
+	return FCortexCommandRouter::Success(Data);
+}
+
 FCortexCommandResult FCortexMaterialParamOps::ResetParameter(const TSharedPtr<FJsonObject>& Params)
 {
 	FString AssetPath;
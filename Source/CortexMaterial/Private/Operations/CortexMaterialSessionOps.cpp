@@ -0,0 +1,99 @@
+#include "Operations/CortexMaterialSessionOps.h"
+#include "CortexMaterialEditSession.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+TArray<TSharedPtr<FJsonValue>> ToJsonStrings(const TArray<FString>& Strings)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Strings.Num());
+	for (const FString& String : Strings)
+	{
+		Values.Add(MakeShared<FJsonValueString>(String));
+	}
+	return Values;
+}
+}
+
+FCortexCommandResult FCortexMaterialSessionOps::BeginEditSession(const TSharedPtr<FJsonObject>& Params)
+{
+	double TimeoutSeconds = FCortexMaterialEditSession::DefaultTimeoutSeconds;
+	if (Params.IsValid())
+	{
+		Params->TryGetNumberField(TEXT("timeout_seconds"), TimeoutSeconds);
+	}
+
+	// An abandoned session that the ticker has not reached yet must not block a new one
+	FCortexMaterialEditSession::CommitIfIdle(FPlatformTime::Seconds());
+	if (!FCortexMaterialEditSession::Begin(TimeoutSeconds))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidOperation,
+			TEXT("A material edit session is already open; commit or abort it first"));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetBoolField(TEXT("session_active"), true);
+	Data->SetNumberField(TEXT("timeout_seconds"), TimeoutSeconds);
+	return FCortexCommandRouter::Success(Data);
+}
+
+FCortexCommandResult FCortexMaterialSessionOps::AbortEditSession(const TSharedPtr<FJsonObject>& Params)
+{
+	TArray<FString> AssetPaths;
+	if (!FCortexMaterialEditSession::Abort(AssetPaths))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidOperation,
+			TEXT("No material edit session is open"));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("materials"), ToJsonStrings(AssetPaths));
+	Data->SetNumberField(TEXT("material_count"), AssetPaths.Num());
+	return FCortexCommandRouter::Success(Data);
+}
+
+FCortexCommandResult FCortexMaterialSessionOps::CommitEditSession(const TSharedPtr<FJsonObject>& Params)
+{
+	TArray<FCortexMaterialCommitReport> Reports;
+	double ValidateMs = 0.0;
+	double UpdateMs = 0.0;
+	if (!FCortexMaterialEditSession::Commit(Reports, ValidateMs, UpdateMs))
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidOperation,
+			TEXT("No material edit session is open"));
+	}
+
+	int32 FailedCount = 0;
+	TArray<TSharedPtr<FJsonValue>> MaterialsArray;
+	for (const FCortexMaterialCommitReport& Report : Reports)
+	{
+		const bool bValid = Report.ValidationErrors.Num() == 0 && Report.TranslationErrors.Num() == 0;
+		if (!bValid)
+		{
+			++FailedCount;
+		}
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("asset_path"), Report.AssetPath);
+		Entry->SetNumberField(TEXT("expression_count"), Report.ExpressionCount);
+		Entry->SetBoolField(TEXT("valid"), bValid);
+		Entry->SetArrayField(TEXT("validation_errors"), ToJsonStrings(Report.ValidationErrors));
+		Entry->SetArrayField(TEXT("translation_errors"), ToJsonStrings(Report.TranslationErrors));
+		Entry->SetArrayField(TEXT("warnings"), ToJsonStrings(Report.Warnings));
+		MaterialsArray.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("materials"), MaterialsArray);
+	Data->SetNumberField(TEXT("material_count"), Reports.Num());
+	Data->SetNumberField(TEXT("failed_count"), FailedCount);
+	Data->SetNumberField(TEXT("validate_ms"), ValidateMs);
+	Data->SetNumberField(TEXT("update_ms"), UpdateMs);
+	return FCortexCommandRouter::Success(Data);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CortexCommandRouter.h"
+
+/** Commands that open, commit and abort an FCortexMaterialEditSession. */
+class FCortexMaterialSessionOps
+{
+public:
+	static FCortexCommandResult BeginEditSession(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult CommitEditSession(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult AbortEditSession(const TSharedPtr<FJsonObject>& Params);
+};
@@ -0,0 +1,241 @@
+#include "Misc/AutomationTest.h"
+#include "CortexMaterialCommandHandler.h"
+#include "CortexMaterialEditSession.h"
+#include "CortexTypes.h"
+#include "Editor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialEditSessionValidateTest,
+	"Cortex.Material.EditSession.Validate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialEditSessionValidateTest::RunTest(const FString& Parameters)
+{
+	UMaterial* Material = NewObject<UMaterial>(GetTransientPackage());
+	TArray<TObjectPtr<UMaterialExpression>>& Expressions = Material->GetEditorOnlyData()->ExpressionCollection.Expressions;
+
+	UMaterialExpressionScalarParameter* Scalar = NewObject<UMaterialExpressionScalarParameter>(Material);
+	Scalar->ParameterName = TEXT("Shared");
+	UMaterialExpressionVectorParameter* Vector = NewObject<UMaterialExpressionVectorParameter>(Material);
+	Vector->ParameterName = TEXT("Shared");
+	Expressions.Add(Scalar);
+	Expressions.Add(Vector);
+
+	TArray<FString> Errors;
+	TArray<FString> Warnings;
+	FCortexMaterialEditSession::ValidateGraph(Material, Errors, Warnings);
+	TestEqual(TEXT("Parameter type conflict reported"), Errors.Num(), 1);
+	TestEqual(TEXT("Unconnected expressions reported as one warning"), Warnings.Num(), 1);
+
+	Vector->ParameterName = TEXT("Tint");
+	UMaterialExpressionAdd* AddA = NewObject<UMaterialExpressionAdd>(Material);
+	UMaterialExpressionAdd* AddB = NewObject<UMaterialExpressionAdd>(Material);
+	AddA->A.Expression = AddB;
+	AddB->A.Expression = AddA;
+	AddB->B.Expression = Scalar;
+	Expressions.Add(AddA);
+	Expressions.Add(AddB);
+
+	Errors.Reset();
+	Warnings.Reset();
+	FCortexMaterialEditSession::ValidateGraph(Material, Errors, Warnings);
+	TestEqual(TEXT("Cycle reported once"), Errors.Num(), 1);
+	if (Errors.Num() == 1)
+	{
+		TestTrue(TEXT("Error names the cycle"), Errors[0].StartsWith(TEXT("Cycle through")));
+	}
+
+	Material->MarkAsGarbage();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialEditSessionCommitTest,
+	"Cortex.Material.EditSession.Commit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialEditSessionCommitTest::RunTest(const FString& Parameters)
+{
+	const FString Suffix = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8);
+	const FString Dir = FString::Printf(TEXT("/Game/Temp/CortexMatTest_Session_%s"), *Suffix);
+
+	FCortexMaterialCommandHandler Handler;
+	TArray<FString> MaterialPaths;
+	for (const TCHAR* MatName : { TEXT("M_SessionA"), TEXT("M_SessionB") })
+	{
+		TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+		CreateParams->SetStringField(TEXT("asset_path"), Dir);
+		CreateParams->SetStringField(TEXT("name"), MatName);
+		Handler.Execute(TEXT("create_material"), CreateParams);
+		MaterialPaths.Add(FString::Printf(TEXT("%s/%s"), *Dir, MatName));
+	}
+
+	FCortexCommandResult Result = Handler.Execute(TEXT("begin_edit_session"), MakeShared<FJsonObject>());
+	TestTrue(TEXT("begin_edit_session should succeed"), Result.bSuccess);
+	Result = Handler.Execute(TEXT("begin_edit_session"), MakeShared<FJsonObject>());
+	TestFalse(TEXT("A second session is rejected"), Result.bSuccess);
+	TestEqual(TEXT("Error code should be INVALID_OPERATION"), Result.ErrorCode, CortexErrorCodes::InvalidOperation);
+
+	// Several edits across two materials; each material is only registered once
+	for (const FString& MaterialPath : MaterialPaths)
+	{
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			TSharedPtr<FJsonObject> AddParams = MakeShared<FJsonObject>();
+			AddParams->SetStringField(TEXT("asset_path"), MaterialPath);
+			AddParams->SetStringField(TEXT("expression_class"), TEXT("Constant"));
+			Result = Handler.Execute(TEXT("add_node"), AddParams);
+			TestTrue(TEXT("add_node inside the session should succeed"), Result.bSuccess);
+		}
+	}
+	TestEqual(TEXT("Both materials deferred to the session"), FCortexMaterialEditSession::NumDirty(), 2);
+
+	Result = Handler.Execute(TEXT("commit_edit_session"), MakeShared<FJsonObject>());
+	TestTrue(TEXT("commit_edit_session should succeed"), Result.bSuccess);
+	TestFalse(TEXT("Session closed"), FCortexMaterialEditSession::IsActive());
+	if (Result.Data.IsValid())
+	{
+		int32 MaterialCount = 0;
+		Result.Data->TryGetNumberField(TEXT("material_count"), MaterialCount);
+		TestEqual(TEXT("One report per touched material"), MaterialCount, 2);
+
+		const TArray<TSharedPtr<FJsonValue>>* Materials = nullptr;
+		if (Result.Data->TryGetArrayField(TEXT("materials"), Materials) && Materials->Num() == 2)
+		{
+			const TSharedPtr<FJsonObject> First = (*Materials)[0]->AsObject();
+			TestEqual(TEXT("Reports follow first-touched order"),
+				First->GetStringField(TEXT("asset_path")), MaterialPaths[0] + TEXT(".M_SessionA"));
+			TestEqual(TEXT("Expressions counted"), static_cast<int32>(First->GetNumberField(TEXT("expression_count"))), 3);
+			TestEqual(TEXT("Unconnected constants are a warning, not an error"),
+				First->GetArrayField(TEXT("validation_errors")).Num(), 0);
+		}
+	}
+
+	Result = Handler.Execute(TEXT("commit_edit_session"), MakeShared<FJsonObject>());
+	TestFalse(TEXT("Commit without a session fails"), Result.bSuccess);
+
+	for (const FString& MaterialPath : MaterialPaths)
+	{
+		if (UObject* MatAsset = LoadObject<UMaterial>(nullptr, *MaterialPath))
+		{
+			MatAsset->MarkAsGarbage();
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialEditSessionAbandonedTest,
+	"Cortex.Material.EditSession.Abandoned",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialEditSessionAbandonedTest::RunTest(const FString& Parameters)
+{
+	FCortexMaterialCommandHandler Handler;
+	UMaterial* Material = NewObject<UMaterial>(GetTransientPackage());
+
+	// A client that opens a session and goes away: the idle timeout commits it
+	TSharedPtr<FJsonObject> BeginParams = MakeShared<FJsonObject>();
+	BeginParams->SetNumberField(TEXT("timeout_seconds"), 5.0);
+	FCortexCommandResult Result = Handler.Execute(TEXT("begin_edit_session"), BeginParams);
+	TestTrue(TEXT("begin_edit_session should succeed"), Result.bSuccess);
+	FCortexMaterialEditSession::MarkMaterialDirty(Material);
+	TestEqual(TEXT("Edit deferred to the session"), FCortexMaterialEditSession::NumDirty(), 1);
+
+	const double Now = FPlatformTime::Seconds();
+	TestFalse(TEXT("A recently edited session stays open"), FCortexMaterialEditSession::CommitIfIdle(Now));
+	TestTrue(TEXT("An idle session is committed"), FCortexMaterialEditSession::CommitIfIdle(Now + 10.0));
+	TestFalse(TEXT("Session closed"), FCortexMaterialEditSession::IsActive());
+	TestEqual(TEXT("Nothing left pending"), FCortexMaterialEditSession::NumDirty(), 0);
+	TestFalse(TEXT("Updates apply immediately again"), FCortexMaterialEditSession::IsDeferring());
+
+	// Abort closes without validating and still updates what was touched
+	Result = Handler.Execute(TEXT("begin_edit_session"), MakeShared<FJsonObject>());
+	TestTrue(TEXT("A new session can open after the timeout"), Result.bSuccess);
+	FCortexMaterialEditSession::MarkMaterialDirty(Material);
+	Result = Handler.Execute(TEXT("abort_edit_session"), MakeShared<FJsonObject>());
+	TestTrue(TEXT("abort_edit_session should succeed"), Result.bSuccess);
+	TestFalse(TEXT("Aborted session closed"), FCortexMaterialEditSession::IsActive());
+	TestEqual(TEXT("Nothing left pending after abort"), FCortexMaterialEditSession::NumDirty(), 0);
+	if (Result.Data.IsValid())
+	{
+		TestEqual(TEXT("Abort lists the touched material"),
+			static_cast<int32>(Result.Data->GetNumberField(TEXT("material_count"))), 1);
+	}
+
+	Result = Handler.Execute(TEXT("abort_edit_session"), MakeShared<FJsonObject>());
+	TestFalse(TEXT("Abort without a session fails"), Result.bSuccess);
+
+	Material->MarkAsGarbage();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialEditSessionUndoTest,
+	"Cortex.Material.EditSession.Undo",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialEditSessionUndoTest::RunTest(const FString& Parameters)
+{
+	if (!GEditor)
+	{
+		AddInfo(TEXT("No editor - skipping"));
+		return true;
+	}
+
+	const FString Suffix = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8);
+	const FString Dir = FString::Printf(TEXT("/Game/Temp/CortexMatTest_SessionUndo_%s"), *Suffix);
+	const FString MaterialPath = FString::Printf(TEXT("%s/M_SessionUndo"), *Dir);
+
+	FCortexMaterialCommandHandler Handler;
+	TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+	CreateParams->SetStringField(TEXT("asset_path"), Dir);
+	CreateParams->SetStringField(TEXT("name"), TEXT("M_SessionUndo"));
+	TestTrue(TEXT("create_material should succeed"), Handler.Execute(TEXT("create_material"), CreateParams).bSuccess);
+
+	UMaterial* Material = LoadObject<UMaterial>(nullptr, *MaterialPath);
+	if (!TestNotNull(TEXT("Material loaded"), Material))
+	{
+		return false;
+	}
+	const TArray<TObjectPtr<UMaterialExpression>>& Expressions = Material->GetEditorOnlyData()->ExpressionCollection.Expressions;
+	const int32 ExpressionsBefore = Expressions.Num();
+
+	TestTrue(TEXT("begin_edit_session should succeed"),
+		Handler.Execute(TEXT("begin_edit_session"), MakeShared<FJsonObject>()).bSuccess);
+	TSharedPtr<FJsonObject> AddParams = MakeShared<FJsonObject>();
+	AddParams->SetStringField(TEXT("asset_path"), MaterialPath);
+	AddParams->SetStringField(TEXT("expression_class"), TEXT("Constant"));
+	FCortexCommandResult Result = Handler.Execute(TEXT("add_node"), AddParams);
+	TestTrue(TEXT("add_node inside the session should succeed"), Result.bSuccess);
+	FString NodeId;
+	if (Result.Data.IsValid())
+	{
+		Result.Data->TryGetStringField(TEXT("node_id"), NodeId);
+	}
+	TestTrue(TEXT("commit_edit_session should succeed"),
+		Handler.Execute(TEXT("commit_edit_session"), MakeShared<FJsonObject>()).bSuccess);
+	TestEqual(TEXT("Expression added"), Expressions.Num(), ExpressionsBefore + 1);
+
+	// The session deferred only the update; the edit itself is an undo step
+	TestTrue(TEXT("Undo should succeed"), GEditor->UndoTransaction());
+	TestEqual(TEXT("Expression gone after undo"), Expressions.Num(), ExpressionsBefore);
+	TestFalse(TEXT("Undone node no longer listed"), Expressions.ContainsByPredicate(
+		[&NodeId](const UMaterialExpression* Expression)
+		{
+			return Expression && Expression->GetName() == NodeId;
+		}));
+
+	Material->MarkAsGarbage();
+	return true;
+}
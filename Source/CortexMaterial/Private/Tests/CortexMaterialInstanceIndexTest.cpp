@@ -0,0 +1,79 @@
+#include "Misc/AutomationTest.h"
+#include "CortexMaterialInstanceIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/Guid.h"
+
+namespace
+{
+UMaterialInstanceConstant* CreateTestInstance(const FString& Dir, const TCHAR* Name, UMaterialInterface* Parent)
+{
+	UPackage* Package = CreatePackage(*FString::Printf(TEXT("%s/%s"), *Dir, Name));
+	UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(Package, Name, RF_Public | RF_Standalone);
+	Instance->SetParentEditorOnly(Parent);
+	return Instance;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialInstanceIndexHierarchyTest,
+	"Cortex.Material.InstanceIndex.Hierarchy",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialInstanceIndexHierarchyTest::RunTest(const FString& Parameters)
+{
+	const FString Dir = FString::Printf(
+		TEXT("/Game/Temp/CortexMatIndexTest_%s"),
+		*FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8));
+
+	UMaterial* Material = NewObject<UMaterial>(
+		CreatePackage(*(Dir + TEXT("/M_IndexBase"))), TEXT("M_IndexBase"), RF_Public | RF_Standalone);
+	UMaterialInstanceConstant* Child = CreateTestInstance(Dir, TEXT("MI_IndexChild"), Material);
+	UMaterialInstanceConstant* GrandChild = CreateTestInstance(Dir, TEXT("MI_IndexGrandChild"), Child);
+	GrandChild->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Roughness")), 0.25f);
+
+	// FAssetData gathers the same tags a save writes, including the override tag
+	FCortexMaterialInstanceIndex Index;
+	Index.UpdateAsset(FAssetData(Child));
+	Index.UpdateAsset(FAssetData(GrandChild));
+
+	const FName MaterialPath = FCortexMaterialInstanceIndex::NormalizePath(Dir + TEXT("/M_IndexBase"));
+	const FName ChildPath(*Child->GetPathName());
+	const FName GrandChildPath(*GrandChild->GetPathName());
+	TestTrue(TEXT("NormalizePath yields the object path"), MaterialPath == FName(*Material->GetPathName()));
+	TestTrue(TEXT("Parent read from the Parent tag"), Index.GetParent(GrandChildPath) == ChildPath);
+
+	TArray<FName> Direct;
+	Index.GetChildren(MaterialPath, Direct, false);
+	TestTrue(TEXT("Only the direct child"), Direct == TArray<FName>{ ChildPath });
+
+	TArray<FName> Descendants;
+	Index.GetChildren(MaterialPath, Descendants, true);
+	TestTrue(TEXT("Descendants listed parent first"), Descendants == TArray<FName>{ ChildPath, GrandChildPath });
+
+	TArray<FName> Overriding;
+	int32 UntaggedCount = INDEX_NONE;
+	Index.FindOverriding(TEXT("Roughness"), Overriding, UntaggedCount);
+	TestTrue(TEXT("Override found from the tag"), Overriding == TArray<FName>{ GrandChildPath });
+	TestEqual(TEXT("Both instances carry the override tag"), UntaggedCount, 0);
+
+	// A live edit re-parents without a save
+	GrandChild->SetParentEditorOnly(Material);
+	Index.UpdateInstance(GrandChild);
+	Direct.Reset();
+	Index.GetChildren(MaterialPath, Direct, false);
+	TestEqual(TEXT("Re-parented instance is a direct child"), Direct.Num(), 2);
+
+	Index.RemoveAsset(GrandChildPath);
+	Overriding.Reset();
+	Index.FindOverriding(TEXT("Roughness"), Overriding, UntaggedCount);
+	TestEqual(TEXT("Removed instance no longer overrides"), Overriding.Num(), 0);
+	TestEqual(TEXT("One instance left"), Index.Num(), 1);
+
+	GrandChild->MarkAsGarbage();
+	Child->MarkAsGarbage();
+	Material->MarkAsGarbage();
+	return true;
+}
@@ -3,6 +3,8 @@
 #include "CortexTypes.h"
 #include "Misc/Guid.h"
 #include "Materials/Material.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
 #include "Materials/MaterialInstanceConstant.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
@@ -297,3 +299,177 @@ bool FCortexMaterialSetParamsVectorObjectTest::RunTest(const FString& Parameters
 
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialSetParametersBulkTest,
+	"Cortex.Material.Param.SetParametersBulk",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialSetParametersBulkTest::RunTest(const FString& Parameters)
+{
+	// Only touches parameter arrays and render-resource updates, so it also runs under -nullrhi
+	const FString Suffix = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8);
+	const FString Dir = FString::Printf(TEXT("/Game/Temp/CortexMatTest_Bulk_%s"), *Suffix);
+	const FString MatPath = FString::Printf(TEXT("%s/M_Bulk"), *Dir);
+	const FString ParentPath = FString::Printf(TEXT("%s/MI_BulkParent"), *Dir);
+	const FString ChildPath = FString::Printf(TEXT("%s/MI_BulkChild"), *Dir);
+
+	FCortexMaterialCommandHandler Handler;
+
+	TSharedPtr<FJsonObject> CreateParams = MakeShared<FJsonObject>();
+	CreateParams->SetStringField(TEXT("asset_path"), Dir);
+	CreateParams->SetStringField(TEXT("name"), TEXT("M_Bulk"));
+	Handler.Execute(TEXT("create_material"), CreateParams);
+
+	// The parameters the edits below target
+	UMaterial* Material = LoadObject<UMaterial>(nullptr, *MatPath);
+	if (!TestNotNull(TEXT("Material created"), Material))
+	{
+		return false;
+	}
+	UMaterialExpressionScalarParameter* RoughnessParam = NewObject<UMaterialExpressionScalarParameter>(Material);
+	RoughnessParam->ParameterName = TEXT("Roughness");
+	UMaterialExpressionVectorParameter* TintParam = NewObject<UMaterialExpressionVectorParameter>(Material);
+	TintParam->ParameterName = TEXT("Tint");
+	Material->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(RoughnessParam);
+	Material->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TintParam);
+	Material->GetEditorOnlyData()->Roughness.Expression = RoughnessParam;
+	Material->GetEditorOnlyData()->BaseColor.Expression = TintParam;
+	Material->PostEditChange();
+
+	for (const TCHAR* InstanceName : { TEXT("MI_BulkParent"), TEXT("MI_BulkChild") })
+	{
+		TSharedPtr<FJsonObject> InstanceParams = MakeShared<FJsonObject>();
+		InstanceParams->SetStringField(TEXT("asset_path"), Dir);
+		InstanceParams->SetStringField(TEXT("name"), InstanceName);
+		InstanceParams->SetStringField(TEXT("parent_material"), MatPath);
+		Handler.Execute(TEXT("create_instance"), InstanceParams);
+	}
+
+	UMaterialInstanceConstant* ParentInstance = LoadObject<UMaterialInstanceConstant>(nullptr, *ParentPath);
+	UMaterialInstanceConstant* ChildInstance = LoadObject<UMaterialInstanceConstant>(nullptr, *ChildPath);
+	if (!TestNotNull(TEXT("Parent instance created"), ParentInstance)
+		|| !TestNotNull(TEXT("Child instance created"), ChildInstance))
+	{
+		return false;
+	}
+	ChildInstance->SetParentEditorOnly(ParentInstance);
+
+	// Child listed first: the command must still update the parent before it
+	TSharedPtr<FJsonObject> BulkParams = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Instances;
+	Instances.Add(MakeShared<FJsonValueString>(ChildPath));
+	Instances.Add(MakeShared<FJsonValueString>(ParentPath));
+	BulkParams->SetArrayField(TEXT("instances"), Instances);
+
+	TArray<TSharedPtr<FJsonValue>> Edits;
+	TSharedPtr<FJsonObject> ScalarEdit = MakeShared<FJsonObject>();
+	ScalarEdit->SetStringField(TEXT("name"), TEXT("Roughness"));
+	ScalarEdit->SetNumberField(TEXT("value"), 0.25);
+	Edits.Add(MakeShared<FJsonValueObject>(ScalarEdit));
+	TSharedPtr<FJsonObject> VectorEdit = MakeShared<FJsonObject>();
+	VectorEdit->SetStringField(TEXT("name"), TEXT("Tint"));
+	TArray<TSharedPtr<FJsonValue>> Color;
+	for (const double Channel : { 1.0, 0.5, 0.0, 1.0 })
+	{
+		Color.Add(MakeShared<FJsonValueNumber>(Channel));
+	}
+	VectorEdit->SetArrayField(TEXT("value"), Color);
+	Edits.Add(MakeShared<FJsonValueObject>(VectorEdit));
+	BulkParams->SetArrayField(TEXT("parameters"), Edits);
+
+	FCortexCommandResult Result = Handler.Execute(TEXT("set_parameters_bulk"), BulkParams);
+	TestTrue(TEXT("set_parameters_bulk should succeed"), Result.bSuccess);
+
+	if (Result.Data.IsValid())
+	{
+		int32 UpdatedCount = 0;
+		int32 GroupCount = 0;
+		Result.Data->TryGetNumberField(TEXT("updated_count"), UpdatedCount);
+		Result.Data->TryGetNumberField(TEXT("group_count"), GroupCount);
+		TestEqual(TEXT("Both instances updated"), UpdatedCount, 2);
+		TestEqual(TEXT("One parent chain"), GroupCount, 1);
+
+		const TArray<TSharedPtr<FJsonValue>>* Updated = nullptr;
+		if (Result.Data->TryGetArrayField(TEXT("updated"), Updated) && Updated->Num() == 2)
+		{
+			TestTrue(TEXT("Parent updated before child"),
+				(*Updated)[0]->AsString().StartsWith(ParentPath) && (*Updated)[1]->AsString().StartsWith(ChildPath));
+		}
+	}
+
+	for (UMaterialInstanceConstant* Instance : { ParentInstance, ChildInstance })
+	{
+		TestTrue(TEXT("Scalar override applied"), Instance->ScalarParameterValues.ContainsByPredicate(
+			[](const FScalarParameterValue& Value)
+			{
+				return Value.ParameterInfo.Name == TEXT("Roughness") && FMath::IsNearlyEqual(Value.ParameterValue, 0.25f);
+			}));
+		TestTrue(TEXT("Vector override applied"), Instance->VectorParameterValues.ContainsByPredicate(
+			[](const FVectorParameterValue& Value)
+			{
+				return Value.ParameterInfo.Name == TEXT("Tint") && Value.ParameterValue.Equals(FLinearColor(1.0f, 0.5f, 0.0f, 1.0f));
+			}));
+	}
+
+	// Unknown and mistyped parameters are reported per instance; the valid edit still lands
+	TSharedPtr<FJsonObject> MissingEdit = MakeShared<FJsonObject>();
+	MissingEdit->SetStringField(TEXT("name"), TEXT("Metalness"));
+	MissingEdit->SetNumberField(TEXT("value"), 1.0);
+	TSharedPtr<FJsonObject> MistypedEdit = MakeShared<FJsonObject>();
+	MistypedEdit->SetStringField(TEXT("name"), TEXT("Tint"));
+	MistypedEdit->SetStringField(TEXT("parameter_type"), TEXT("scalar"));
+	MistypedEdit->SetNumberField(TEXT("value"), 0.5);
+	ScalarEdit->SetNumberField(TEXT("value"), 0.75);
+	TArray<TSharedPtr<FJsonValue>> MixedEdits;
+	MixedEdits.Add(MakeShared<FJsonValueObject>(ScalarEdit));
+	MixedEdits.Add(MakeShared<FJsonValueObject>(MissingEdit));
+	MixedEdits.Add(MakeShared<FJsonValueObject>(MistypedEdit));
+	BulkParams->SetArrayField(TEXT("parameters"), MixedEdits);
+
+	Result = Handler.Execute(TEXT("set_parameters_bulk"), BulkParams);
+	TestTrue(TEXT("Per-item errors do not fail the call"), Result.bSuccess);
+	if (Result.Data.IsValid())
+	{
+		int32 ParameterErrorCount = 0;
+		Result.Data->TryGetNumberField(TEXT("parameter_error_count"), ParameterErrorCount);
+		TestEqual(TEXT("Two bad edits on each of two instances"), ParameterErrorCount, 4);
+
+		const TArray<TSharedPtr<FJsonValue>>* Errors = nullptr;
+		if (TestTrue(TEXT("Errors listed"), Result.Data->TryGetArrayField(TEXT("errors"), Errors)))
+		{
+			for (const TSharedPtr<FJsonValue>& Error : *Errors)
+			{
+				const FString Name = Error->AsObject()->GetStringField(TEXT("parameter_name"));
+				TestTrue(TEXT("Error names the bad parameter"), Name == TEXT("Metalness") || Name == TEXT("Tint"));
+			}
+		}
+	}
+	for (UMaterialInstanceConstant* Instance : { ParentInstance, ChildInstance })
+	{
+		TestTrue(TEXT("Valid edit applied alongside the bad ones"), Instance->ScalarParameterValues.ContainsByPredicate(
+			[](const FScalarParameterValue& Value)
+			{
+				return Value.ParameterInfo.Name == TEXT("Roughness") && FMath::IsNearlyEqual(Value.ParameterValue, 0.75f);
+			}));
+		TestFalse(TEXT("Unknown parameter not written"), Instance->ScalarParameterValues.ContainsByPredicate(
+			[](const FScalarParameterValue& Value)
+			{
+				return Value.ParameterInfo.Name == TEXT("Metalness") || Value.ParameterInfo.Name == TEXT("Tint");
+			}));
+	}
+	BulkParams->SetArrayField(TEXT("parameters"), Edits);
+
+	// A bad value is rejected before any instance is touched
+	ScalarEdit->SetStringField(TEXT("parameter_type"), TEXT("scalar"));
+	ScalarEdit->SetStringField(TEXT("value"), TEXT("not a number"));
+	Result = Handler.Execute(TEXT("set_parameters_bulk"), BulkParams);
+	TestFalse(TEXT("Invalid edit should fail"), Result.bSuccess);
+
+	ChildInstance->MarkAsGarbage();
+	ParentInstance->MarkAsGarbage();
+	Material->MarkAsGarbage();
+
+	return true;
+}
@@ -0,0 +1,94 @@
+#include "Misc/AutomationTest.h"
+#include "CortexMaterialParameterCache.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialInstanceConstant.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexMaterialParameterCacheTest,
+	"Cortex.Material.ParameterCache.Invalidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexMaterialParameterCacheTest::RunTest(const FString& Parameters)
+{
+	UMaterial* Material = NewObject<UMaterial>(GetTransientPackage());
+	UMaterialExpressionScalarParameter* Gloss = NewObject<UMaterialExpressionScalarParameter>(Material);
+	Gloss->ParameterName = TEXT("Gloss");
+	Gloss->DefaultValue = 0.3f;
+	Gloss->Group = TEXT("Surface");
+	Material->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(Gloss);
+	Material->GetEditorOnlyData()->Roughness.Expression = Gloss;
+	Material->PostEditChange();
+
+	UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(GetTransientPackage());
+	Instance->SetParentEditorOnly(Material);
+	Instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Gloss")), 0.7f);
+	Instance->PostEditChange();
+
+	FCortexMaterialParameterCache Cache;
+
+	const TSharedRef<const FCortexMaterialParameterTable> MaterialTable = Cache.GetTable(Material);
+	const FCortexMaterialParameterEntry* MaterialEntry = MaterialTable->Find(TEXT("Gloss"));
+	if (TestNotNull(TEXT("Material parameter found"), MaterialEntry))
+	{
+		TestEqual(TEXT("Type"), MaterialEntry->Type, FString(TEXT("scalar")));
+		TestEqual(TEXT("Group"), MaterialEntry->Group, FName(TEXT("Surface")));
+		TestEqual(TEXT("Default"), MaterialEntry->DefaultValue.AsScalar(), 0.3f);
+		TestTrue(TEXT("Expression GUID recorded"), MaterialEntry->ExpressionGuid == Gloss->ExpressionGUID);
+		TestTrue(TEXT("No override on the base material"), MaterialEntry->OverrideSource.IsEmpty());
+	}
+
+	Cache.GetTable(Material);
+	TestEqual(TEXT("Second lookup is a hit"), Cache.GetBuildCount(), 1);
+
+	const TSharedRef<const FCortexMaterialParameterTable> InstanceTable = Cache.GetTable(Instance);
+	const FCortexMaterialParameterEntry* InstanceEntry = InstanceTable->Find(TEXT("Gloss"));
+	if (TestNotNull(TEXT("Instance parameter found"), InstanceEntry))
+	{
+		TestEqual(TEXT("Current value is the override"), InstanceEntry->CurrentValue.AsScalar(), 0.7f);
+		TestEqual(TEXT("Default comes from the parent"), InstanceEntry->DefaultValue.AsScalar(), 0.3f);
+		TestEqual(TEXT("Override source is the instance"), InstanceEntry->OverrideSource, Instance->GetPathName());
+	}
+	TestEqual(TEXT("Instance built its own table"), Cache.GetBuildCount(), 2);
+
+	// An edit to the parent drops the instance table too
+	Gloss->DefaultValue = 0.4f;
+	Material->PostEditChange();
+	Cache.GetTable(Instance);
+	TestEqual(TEXT("Parent edit invalidates the instance"), Cache.GetBuildCount(), 3);
+	const FCortexMaterialParameterEntry* RebuiltEntry = Cache.GetTable(Material)->Find(TEXT("Gloss"));
+	if (TestNotNull(TEXT("Rebuilt parameter found"), RebuiltEntry))
+	{
+		TestEqual(TEXT("Rebuilt default"), RebuiltEntry->DefaultValue.AsScalar(), 0.4f);
+	}
+
+	// An instance override set without a property-change event is still picked up
+	Instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Gloss")), 0.9f);
+	const FCortexMaterialParameterEntry* EditedEntry = Cache.GetTable(Instance)->Find(TEXT("Gloss"));
+	if (TestNotNull(TEXT("Edited parameter found"), EditedEntry))
+	{
+		TestEqual(TEXT("Unnotified override is current"), EditedEntry->CurrentValue.AsScalar(), 0.9f);
+	}
+	TestEqual(TEXT("Instance state change rebuilds"), Cache.GetBuildCount(), 5);
+
+	// Tables of collected instances are swept on the next rebuild
+	UMaterialInstanceConstant* Transient = NewObject<UMaterialInstanceConstant>(GetTransientPackage());
+	Transient->SetParentEditorOnly(Material);
+	Cache.GetTable(Transient);
+	const int32 TablesBeforeCollect = Cache.GetNumTables();
+	Transient->MarkAsGarbage();
+	Material->AddToRoot();
+	Instance->AddToRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	Material->RemoveFromRoot();
+	Instance->RemoveFromRoot();
+
+	Instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Gloss")), 0.5f);
+	Cache.GetTable(Instance);
+	TestEqual(TEXT("Collected instance table swept"), Cache.GetNumTables(), TablesBeforeCollect - 1);
+
+	Instance->MarkAsGarbage();
+	Material->MarkAsGarbage();
+	return true;
+}
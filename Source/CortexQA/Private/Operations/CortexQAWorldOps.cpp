@@ -1,8 +1,8 @@
 #include "Operations/CortexQAWorldOps.h"
 
+#include "CortexActorSpatialIndex.h"
 #include "CortexCommandRouter.h"
 #include "CortexQAUtils.h"
-#include "EngineUtils.h"
 #include "Components/ActorComponent.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
@@ -161,51 +161,25 @@ FCortexCommandResult FCortexQAWorldOps::ObserveState(const TSharedPtr<FJsonObjec
     // Build player state
     const FCortexCommandResult PlayerState = GetPlayerState(MakeShared<FJsonObject>());
 
-    // Collect nearby actors, filtering engine-internal actors
-    struct FActorDistance
+    // Nearest actors from the shared spatial index, filtering engine-internal actors
+    FCortexActorSpatialIndex& SpatialIndex = FCortexActorSpatialIndex::Get(PIEWorld);
+    auto IsObservable = [PlayerPawn](const AActor* Actor)
     {
-        AActor* Actor;
-        float Distance;
+        return Actor != PlayerPawn && Actor->GetRootComponent() && !FCortexQAUtils::IsEngineInternalActor(Actor);
     };
-    TArray<FActorDistance> NearbyActors;
-    int32 TotalActors = 0;
 
-    for (TActorIterator<AActor> It(PIEWorld); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (!IsValid(Actor) || Actor == PlayerPawn || !Actor->GetRootComponent())
-        {
-            continue;
-        }
-        if (FCortexQAUtils::IsEngineInternalActor(Actor))
-        {
-            continue;
-        }
-
-        TotalActors++;
-        const float Distance = FVector::Dist(PlayerLocation, Actor->GetActorLocation());
-        if (Distance <= Radius)
-        {
-            NearbyActors.Add({Actor, Distance});
-        }
-    }
+    TArray<TPair<AActor*, double>> NearbyActors;
+    SpatialIndex.QueryNearest(PlayerLocation, MaxActors, Radius, IsObservable, NearbyActors);
 
-    // Sort by distance, cap at MaxActors
-    NearbyActors.Sort([](const FActorDistance& A, const FActorDistance& B)
-    {
-        return A.Distance < B.Distance;
-    });
-    if (NearbyActors.Num() > MaxActors)
-    {
-        NearbyActors.SetNum(MaxActors);
-    }
+    // The observable total only changes when actors are added or removed; the index caches it
+    const int32 TotalActors = SpatialIndex.CountActors(PlayerPawn, IsObservable);
 
     // Serialize nearby actors
     TArray<TSharedPtr<FJsonValue>> ActorsJson;
-    for (const FActorDistance& Entry : NearbyActors)
+    for (const TPair<AActor*, double>& Entry : NearbyActors)
     {
         ActorsJson.Add(MakeShared<FJsonValueObject>(SerializeActorForObserve(
-            Entry.Actor, PlayerLocation, PlayerForward, Entry.Distance,
+            Entry.Key, PlayerLocation, PlayerForward, static_cast<float>(Entry.Value),
             PIEWorld, bIncludeLOS, static_cast<float>(InteractionRange))));
     }
 
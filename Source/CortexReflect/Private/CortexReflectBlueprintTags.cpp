@@ -0,0 +1,360 @@
+#include "CortexReflectBlueprintTags.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_SpawnActorFromClass.h"
+#include "K2Node_Variable.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+const FName FCortexReflectBlueprintTags::VersionTag(TEXT("CortexTagsVersion"));
+const FName FCortexReflectBlueprintTags::FunctionsTag(TEXT("CortexFunctions"));
+const FName FCortexReflectBlueprintTags::VariablesTag(TEXT("CortexVariables"));
+const FName FCortexReflectBlueprintTags::ReferencesTag(TEXT("CortexReferences"));
+
+FDelegateHandle FCortexReflectBlueprintTags::ExtraTagsHandle;
+
+namespace
+{
+// Names, graph names and object paths never contain tabs or newlines
+const TCHAR EntrySeparator = TEXT('\n');
+const TCHAR FieldSeparator = TEXT('\t');
+
+void SplitEntries(const FString& Value, TArray<FString>& OutEntries)
+{
+	const TCHAR Separator[] = { EntrySeparator, 0 };
+	Value.ParseIntoArray(OutEntries, Separator, true);
+}
+
+void SplitFields(const FString& Entry, TArray<FString>& OutFields)
+{
+	const TCHAR Separator[] = { FieldSeparator, 0 };
+	Entry.ParseIntoArray(OutFields, Separator, false);
+}
+
+void AddReference(
+	FCortexBlueprintSummary& Summary,
+	const TCHAR* Type,
+	const FString& Target,
+	const FString& Context,
+	const FString& Owner = FString())
+{
+	FCortexBlueprintReference& Reference = Summary.References.AddDefaulted_GetRef();
+	Reference.Type = Type;
+	Reference.Target = Target;
+	Reference.Context = Context;
+	Reference.Owner = Owner;
+}
+
+/** Path of the class declaring a member; skeleton classes stand in for their Blueprint's generated class */
+FString GetOwnerClassPath(const UClass* OwnerClass)
+{
+	if (!OwnerClass)
+	{
+		return FString();
+	}
+
+	if (const UBlueprint* OwnerBlueprint = Cast<UBlueprint>(OwnerClass->ClassGeneratedBy))
+	{
+		if (OwnerBlueprint->GeneratedClass)
+		{
+			OwnerClass = OwnerBlueprint->GeneratedClass;
+		}
+	}
+	return OwnerClass->GetPathName();
+}
+}
+
+void FCortexReflectBlueprintTags::Register()
+{
+	if (!ExtraTagsHandle.IsValid())
+	{
+		ExtraTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(
+			&FCortexReflectBlueprintTags::HandleGetExtraObjectTags);
+	}
+}
+
+void FCortexReflectBlueprintTags::Unregister()
+{
+	if (ExtraTagsHandle.IsValid())
+	{
+		UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraTagsHandle);
+		ExtraTagsHandle.Reset();
+	}
+}
+
+void FCortexReflectBlueprintTags::HandleGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	// Editor-only query data; cooked builds never read it
+	if (Context.IsCooking())
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Context.GetObject());
+	if (!Blueprint || !Blueprint->GeneratedClass)
+	{
+		return;
+	}
+
+	FCortexBlueprintSummary Summary;
+	Describe(Blueprint, Summary);
+
+	TArray<TPair<FName, FString>> Tags;
+	EncodeTags(Summary, Tags);
+	for (const TPair<FName, FString>& Tag : Tags)
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(Tag.Key, Tag.Value, UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+
+void FCortexReflectBlueprintTags::Describe(const UBlueprint* Blueprint, FCortexBlueprintSummary& OutSummary)
+{
+	OutSummary = FCortexBlueprintSummary();
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	if (const UClass* GeneratedClass = Blueprint->GeneratedClass)
+	{
+		for (TFieldIterator<UFunction> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			FCortexBlueprintFunctionInfo& Function = OutSummary.Functions.AddDefaulted_GetRef();
+			Function.Name = It->GetName();
+			Function.bEvent = It->HasAnyFunctionFlags(FUNC_BlueprintEvent);
+		}
+		for (TFieldIterator<FProperty> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			if (!It->HasAnyPropertyFlags(CPF_Parm))
+			{
+				OutSummary.Variables.Add(It->GetName());
+			}
+		}
+	}
+
+	UClass* SelfScope = Blueprint->GeneratedClass;
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+	for (const UEdGraph* Graph : AllGraphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		const FString GraphName = Graph->GetName();
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			if (const UK2Node_Variable* VarNode = Cast<UK2Node_Variable>(Node))
+			{
+				const FString MemberName = VarNode->VariableReference.GetMemberName().ToString();
+				const FProperty* Property = VarNode->GetPropertyForVariable();
+				const FString Owner = GetOwnerClassPath(
+					Property ? Property->GetOwnerClass() : VarNode->VariableReference.GetMemberParentClass(SelfScope));
+				if (VarNode->IsA<UK2Node_VariableGet>())
+				{
+					AddReference(OutSummary, TEXT("read"), MemberName, GraphName, Owner);
+				}
+				else if (VarNode->IsA<UK2Node_VariableSet>())
+				{
+					AddReference(OutSummary, TEXT("write"), MemberName, GraphName, Owner);
+				}
+			}
+			else if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+			{
+				const UFunction* Function = CallNode->GetTargetFunction();
+				AddReference(
+					OutSummary,
+					TEXT("call"),
+					CallNode->FunctionReference.GetMemberName().ToString(),
+					GraphName,
+					GetOwnerClassPath(Function ? Function->GetOwnerClass() : CallNode->FunctionReference.GetMemberParentClass(SelfScope)));
+			}
+			else if (const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+			{
+				if (CastNode->TargetType)
+				{
+					AddReference(OutSummary, TEXT("cast"), CastNode->TargetType->GetPathName(), GraphName);
+				}
+			}
+			else if (const UK2Node_SpawnActorFromClass* SpawnNode = Cast<UK2Node_SpawnActorFromClass>(Node))
+			{
+				const UEdGraphPin* ClassPin = SpawnNode->GetClassPin();
+				if (const UClass* SpawnClass = ClassPin ? Cast<UClass>(ClassPin->DefaultObject) : nullptr)
+				{
+					AddReference(OutSummary, TEXT("spawn"), SpawnClass->GetPathName(), GraphName);
+				}
+			}
+		}
+	}
+
+	if (const USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript)
+	{
+		for (const USCS_Node* SCSNode : SCS->GetAllNodes())
+		{
+			if (SCSNode && SCSNode->ComponentClass)
+			{
+				AddReference(OutSummary, TEXT("component"), SCSNode->ComponentClass->GetPathName(), TEXT("SimpleConstructionScript"));
+			}
+		}
+	}
+}
+
+void FCortexReflectBlueprintTags::EncodeTags(const FCortexBlueprintSummary& Summary, TArray<TPair<FName, FString>>& OutTags)
+{
+	FString Functions;
+	for (const FCortexBlueprintFunctionInfo& Function : Summary.Functions)
+	{
+		Functions += Function.Name;
+		Functions.AppendChar(FieldSeparator);
+		Functions += Function.bEvent ? TEXT("e") : TEXT("");
+		Functions.AppendChar(EntrySeparator);
+	}
+
+	FString Variables;
+	for (const FString& Variable : Summary.Variables)
+	{
+		Variables += Variable;
+		Variables.AppendChar(EntrySeparator);
+	}
+
+	FString References;
+	for (const FCortexBlueprintReference& Reference : Summary.References)
+	{
+		References += Reference.Type;
+		References.AppendChar(FieldSeparator);
+		References += Reference.Target;
+		References.AppendChar(FieldSeparator);
+		References += Reference.Context;
+		References.AppendChar(FieldSeparator);
+		References += Reference.Owner;
+		References.AppendChar(EntrySeparator);
+	}
+
+	OutTags.Emplace(VersionTag, FString::FromInt(TagsVersion));
+	OutTags.Emplace(FunctionsTag, MoveTemp(Functions));
+	OutTags.Emplace(VariablesTag, MoveTemp(Variables));
+	OutTags.Emplace(ReferencesTag, MoveTemp(References));
+}
+
+bool FCortexReflectBlueprintTags::ReadTags(const FAssetData& Asset, FCortexBlueprintSummary& OutSummary)
+{
+	OutSummary = FCortexBlueprintSummary();
+
+	FString Version;
+	if (!Asset.GetTagValue(VersionTag, Version) || FCString::Atoi(*Version) != TagsVersion)
+	{
+		return false;
+	}
+
+	TArray<FString> Entries;
+	TArray<FString> Fields;
+	FString Value;
+
+	if (Asset.GetTagValue(FunctionsTag, Value))
+	{
+		SplitEntries(Value, Entries);
+		for (const FString& Entry : Entries)
+		{
+			SplitFields(Entry, Fields);
+			FCortexBlueprintFunctionInfo& Function = OutSummary.Functions.AddDefaulted_GetRef();
+			Function.Name = Fields[0];
+			Function.bEvent = Fields.Num() > 1 && Fields[1] == TEXT("e");
+		}
+	}
+
+	if (Asset.GetTagValue(VariablesTag, Value))
+	{
+		SplitEntries(Value, OutSummary.Variables);
+	}
+
+	if (Asset.GetTagValue(ReferencesTag, Value))
+	{
+		SplitEntries(Value, Entries);
+		for (const FString& Entry : Entries)
+		{
+			SplitFields(Entry, Fields);
+			if (Fields.Num() == 4)
+			{
+				FCortexBlueprintReference& Reference = OutSummary.References.AddDefaulted_GetRef();
+				Reference.Type = Fields[0];
+				Reference.Target = Fields[1];
+				Reference.Context = Fields[2];
+				Reference.Owner = Fields[3];
+			}
+		}
+	}
+
+	return true;
+}
+
+const TCHAR* FCortexReflectBlueprintTags::GetNodeClassName(const FString& ReferenceType)
+{
+	if (ReferenceType == TEXT("read"))
+	{
+		return TEXT("UK2Node_VariableGet");
+	}
+	if (ReferenceType == TEXT("write"))
+	{
+		return TEXT("UK2Node_VariableSet");
+	}
+	if (ReferenceType == TEXT("call"))
+	{
+		return TEXT("UK2Node_CallFunction");
+	}
+	if (ReferenceType == TEXT("cast"))
+	{
+		return TEXT("UK2Node_DynamicCast");
+	}
+	if (ReferenceType == TEXT("spawn"))
+	{
+		return TEXT("UK2Node_SpawnActorFromClass");
+	}
+	return TEXT("USCS_Node");
+}
+
+int32 FCortexReflectBlueprintTags::GetInheritanceDepth(
+	const FString& ClassPath,
+	const UClass* Ancestor,
+	const TMap<FString, FString>& ParentByClassPath)
+{
+	// Bounded so a cyclic or corrupt tag chain cannot spin
+	constexpr int32 MaxUnloadedHops = 64;
+
+	FString Current = ClassPath;
+	int32 Depth = 0;
+	for (int32 Hop = 0; Hop < MaxUnloadedHops && !Current.IsEmpty(); ++Hop)
+	{
+		if (const UClass* Loaded = FindObject<UClass>(nullptr, *Current))
+		{
+			for (const UClass* Walker = Loaded; Walker; Walker = Walker->GetSuperClass())
+			{
+				if (Walker == Ancestor)
+				{
+					return Depth;
+				}
+				++Depth;
+			}
+			return INDEX_NONE;
+		}
+
+		const FString* Parent = ParentByClassPath.Find(Current);
+		if (!Parent)
+		{
+			return INDEX_NONE;
+		}
+		Current = *Parent;
+		++Depth;
+	}
+	return INDEX_NONE;
+}
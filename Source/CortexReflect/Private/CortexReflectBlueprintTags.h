@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UClass;
+struct FAssetData;
+class FAssetRegistryTagsContext;
+
+struct FCortexBlueprintFunctionInfo
+{
+	FString Name;
+	bool bEvent = false;
+};
+
+/** One graph or component reference that find_usages reports. */
+struct FCortexBlueprintReference
+{
+	/** read, write, call, cast, spawn or component */
+	FString Type;
+	/** Member name for read/write/call, class path for cast/spawn/component */
+	FString Target;
+	/** Class path declaring the member for read/write/call; empty when it did not resolve */
+	FString Owner;
+	/** Graph name, or SimpleConstructionScript */
+	FString Context;
+};
+
+/** What find_overrides and find_usages need from one Blueprint. */
+struct FCortexBlueprintSummary
+{
+	/** Functions declared on the generated class itself */
+	TArray<FCortexBlueprintFunctionInfo> Functions;
+	/** Properties declared on the generated class itself */
+	TArray<FString> Variables;
+	TArray<FCortexBlueprintReference> References;
+};
+
+/**
+ * Hidden asset-registry tags written whenever a Blueprint's tags are gathered (on save,
+ * and for loaded assets), so override and usage queries can answer for unloaded
+ * Blueprints from the registry instead of loading each one. The same Describe() feeds
+ * the tags and the live scan of loaded Blueprints, so both paths report identically.
+ */
+class FCortexReflectBlueprintTags
+{
+public:
+	static const FName VersionTag;
+	static const FName FunctionsTag;
+	static const FName VariablesTag;
+	static const FName ReferencesTag;
+
+	/** Bump when the encoding changes; older tags are then treated as missing. */
+	static constexpr int32 TagsVersion = 2;
+
+	static void Register();
+	static void Unregister();
+
+	/** Summarize a loaded Blueprint's generated class, graphs and construction script. */
+	static void Describe(const UBlueprint* Blueprint, FCortexBlueprintSummary& OutSummary);
+
+	/** Tag name/value pairs for a summary. */
+	static void EncodeTags(const FCortexBlueprintSummary& Summary, TArray<TPair<FName, FString>>& OutTags);
+
+	/** Summary from an asset's registry tags; false when the asset carries no current Cortex tags. */
+	static bool ReadTags(const FAssetData& Asset, FCortexBlueprintSummary& OutSummary);
+
+	/** K2 node class reported for a reference type. */
+	static const TCHAR* GetNodeClassName(const FString& ReferenceType);
+
+	/**
+	 * Steps from ClassPath up to Ancestor (0 when equal), following loaded classes and,
+	 * for unloaded Blueprint classes, ParentByClassPath (generated class path -> parent
+	 * class path, from registry tags). INDEX_NONE when Ancestor is not reached.
+	 */
+	static int32 GetInheritanceDepth(const FString& ClassPath, const UClass* Ancestor, const TMap<FString, FString>& ParentByClassPath);
+
+private:
+	static void HandleGetExtraObjectTags(FAssetRegistryTagsContext Context);
+
+	static FDelegateHandle ExtraTagsHandle;
+};
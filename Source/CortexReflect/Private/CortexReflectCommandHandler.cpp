@@ -71,14 +71,18 @@ TArray<FCortexCommandInfo> FCortexReflectCommandHandler::GetSupportedCommands()
 			.Required(TEXT("symbol"), TEXT("string"), TEXT("Symbol name to search for"))
 			.Optional(TEXT("class_name"), TEXT("string"), TEXT("Restrict search to a class context"))
 			.Optional(TEXT("scope"), TEXT("string"), TEXT("Search scope"))
-			.Optional(TEXT("deep_scan"), TEXT("boolean"), TEXT("Scan Blueprint bytecode for references"))
+			.Optional(TEXT("deep_scan"), TEXT("boolean"), TEXT("Load referencing Blueprints saved before Cortex tags existed"))
 			.Optional(TEXT("path_filter"), TEXT("string"), TEXT("Restrict matches to a path prefix"))
 			.Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum usage results to return"))
-			.Optional(TEXT("max_blueprints"), TEXT("number"), TEXT("Maximum Blueprints to inspect during deep scans")),
-		FCortexCommandInfo{ TEXT("search"), TEXT("Search classes by pattern") }
-			.Required(TEXT("pattern"), TEXT("string"), TEXT("Class-name pattern to search for"))
-			.Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum classes to return"))
-			.Optional(TEXT("include_engine"), TEXT("boolean"), TEXT("Include engine classes in search results")),
+			.Optional(TEXT("verify"), TEXT("boolean"), TEXT("Load Blueprints matched from registry tags and confirm against their graphs")),
+		FCortexCommandInfo{ TEXT("search"), TEXT("Fuzzy ranked search over classes, functions, properties, enums and structs") }
+			.Required(TEXT("pattern"), TEXT("string"), TEXT("Name or words to search for; tolerates typos and word order"))
+			.Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum results to return"))
+			.Optional(TEXT("include_engine"), TEXT("boolean"), TEXT("Include engine symbols in search results"))
+			.Optional(TEXT("kinds"), TEXT("array"), TEXT("Restrict to class, function, property, enum and/or struct"))
+			.Optional(TEXT("type_filter"), TEXT("string"), TEXT("Only classes deriving from this class, and their members"))
+			.Optional(TEXT("module_filter"), TEXT("string"), TEXT("Only symbols whose module contains this text"))
+			.Optional(TEXT("prefer_module"), TEXT("string"), TEXT("Rank symbols from this module higher")),
 		FCortexCommandInfo{ TEXT("get_dependencies"), TEXT("Get asset dependencies from Asset Registry") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path to inspect"))
 			.Optional(TEXT("category"), TEXT("string"), TEXT("Dependency category filter"))
@@ -0,0 +1,1069 @@
+#include "CortexReflectIndex.h"
+#include "CortexReflectModule.h"
+#include "Operations/CortexReflectOps.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+TUniquePtr<FCortexReflectIndex> FCortexReflectIndex::Instance;
+int32 FCortexReflectIndex::ReloadCount = 0;
+
+namespace
+{
+/** Upper bound on any serialized count; a corrupt file fails the load instead of allocating */
+constexpr int32 MaxSerializedCount = 1 << 24;
+
+/** Class and member names are case-sensitive in the string table even though FString == is not */
+struct FCaseSensitiveStringKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+{
+	static bool Matches(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static uint32 GetKeyHash(const FString& Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/** Every string is written once; entries refer to it by index. Types like "float" repeat thousands of times. */
+struct FStringTableWriter
+{
+	TArray<FString> Strings;
+	TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> Ids;
+
+	void Write(FArchive& Ar, const FString& Value)
+	{
+		int32 Id = INDEX_NONE;
+		if (const int32* Existing = Ids.Find(Value))
+		{
+			Id = *Existing;
+		}
+		else
+		{
+			Id = Strings.Add(Value);
+			Ids.Add(Value, Id);
+		}
+		Ar << Id;
+	}
+};
+
+bool ReadString(FArchive& Ar, const TArray<FString>& Strings, FString& OutValue)
+{
+	int32 Id = INDEX_NONE;
+	Ar << Id;
+	if (Ar.IsError() || !Strings.IsValidIndex(Id))
+	{
+		return false;
+	}
+	OutValue = Strings[Id];
+	return true;
+}
+
+bool ReadCount(FArchive& Ar, int32& OutCount)
+{
+	OutCount = 0;
+	Ar << OutCount;
+	return !Ar.IsError() && OutCount >= 0 && OutCount <= MaxSerializedCount;
+}
+
+void WriteEntry(FArchive& Ar, FStringTableWriter& Table, const FCortexReflectClassEntry& Entry)
+{
+	Table.Write(Ar, Entry.Name);
+	Table.Write(Ar, Entry.CppName);
+	Table.Write(Ar, Entry.Path);
+	Table.Write(Ar, Entry.SuperPath);
+	Table.Write(Ar, Entry.Module);
+	Table.Write(Ar, Entry.SourcePath);
+	uint32 ClassFlags = Entry.ClassFlags;
+	uint8 IndexFlags = Entry.IndexFlags;
+	Ar << ClassFlags << IndexFlags;
+
+	int32 NumFunctions = Entry.Functions.Num();
+	Ar << NumFunctions;
+	for (const FCortexReflectFunctionEntry& Function : Entry.Functions)
+	{
+		Table.Write(Ar, Function.Name);
+		Table.Write(Ar, Function.ReturnType);
+		uint32 FunctionFlags = Function.FunctionFlags;
+		int32 NumParams = Function.Params.Num();
+		Ar << FunctionFlags << NumParams;
+		for (const FCortexReflectParamEntry& Param : Function.Params)
+		{
+			Table.Write(Ar, Param.Name);
+			Table.Write(Ar, Param.Type);
+			uint8 bIsOut = Param.bIsOut ? 1 : 0;
+			Ar << bIsOut;
+		}
+	}
+
+	int32 NumProperties = Entry.Properties.Num();
+	Ar << NumProperties;
+	for (const FCortexReflectPropertyEntry& Property : Entry.Properties)
+	{
+		Table.Write(Ar, Property.Name);
+		Table.Write(Ar, Property.Type);
+		Table.Write(Ar, Property.Category);
+		uint64 PropertyFlags = Property.PropertyFlags;
+		Ar << PropertyFlags;
+	}
+}
+
+bool ReadEntry(FArchive& Ar, const TArray<FString>& Strings, FCortexReflectClassEntry& OutEntry)
+{
+	if (!ReadString(Ar, Strings, OutEntry.Name)
+		|| !ReadString(Ar, Strings, OutEntry.CppName)
+		|| !ReadString(Ar, Strings, OutEntry.Path)
+		|| !ReadString(Ar, Strings, OutEntry.SuperPath)
+		|| !ReadString(Ar, Strings, OutEntry.Module)
+		|| !ReadString(Ar, Strings, OutEntry.SourcePath))
+	{
+		return false;
+	}
+	Ar << OutEntry.ClassFlags << OutEntry.IndexFlags;
+
+	int32 NumFunctions = 0;
+	if (!ReadCount(Ar, NumFunctions))
+	{
+		return false;
+	}
+	OutEntry.Functions.SetNum(NumFunctions);
+	for (FCortexReflectFunctionEntry& Function : OutEntry.Functions)
+	{
+		int32 NumParams = 0;
+		if (!ReadString(Ar, Strings, Function.Name)
+			|| !ReadString(Ar, Strings, Function.ReturnType))
+		{
+			return false;
+		}
+		Ar << Function.FunctionFlags;
+		if (!ReadCount(Ar, NumParams))
+		{
+			return false;
+		}
+		Function.Params.SetNum(NumParams);
+		for (FCortexReflectParamEntry& Param : Function.Params)
+		{
+			uint8 bIsOut = 0;
+			if (!ReadString(Ar, Strings, Param.Name) || !ReadString(Ar, Strings, Param.Type))
+			{
+				return false;
+			}
+			Ar << bIsOut;
+			Param.bIsOut = bIsOut != 0;
+		}
+	}
+
+	int32 NumProperties = 0;
+	if (!ReadCount(Ar, NumProperties))
+	{
+		return false;
+	}
+	OutEntry.Properties.SetNum(NumProperties);
+	for (FCortexReflectPropertyEntry& Property : OutEntry.Properties)
+	{
+		if (!ReadString(Ar, Strings, Property.Name)
+			|| !ReadString(Ar, Strings, Property.Type)
+			|| !ReadString(Ar, Strings, Property.Category))
+		{
+			return false;
+		}
+		Ar << Property.PropertyFlags;
+	}
+
+	return !Ar.IsError();
+}
+
+/** Only compiled-in classes are stable across sessions; everything else is indexed live. */
+bool IsPersistentEntry(const FCortexReflectClassEntry& Entry)
+{
+	return !Entry.Path.IsEmpty() && !Entry.IsBlueprint() && Entry.Path.StartsWith(TEXT("/Script/"));
+}
+}
+
+FCortexReflectIndex::~FCortexReflectIndex()
+{
+	UnbindDelegates();
+}
+
+FCortexReflectIndex& FCortexReflectIndex::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FCortexReflectIndex>();
+		Instance->BindDelegates();
+	}
+	Instance->EnsureBuilt();
+	return *Instance;
+}
+
+void FCortexReflectIndex::Initialize()
+{
+	Get();
+}
+
+void FCortexReflectIndex::Reset()
+{
+	Instance.Reset();
+}
+
+uint32 FCortexReflectIndex::ComputeBuildHash()
+{
+	uint32 Hash = GetTypeHash(FEngineVersion::Current().ToString());
+	Hash = HashCombine(Hash, GetTypeHash(FString(FApp::GetBuildVersion())));
+	Hash = HashCombine(Hash, GetTypeHash(FileVersion));
+
+	TArray<FModuleStatus> Modules;
+	FModuleManager::Get().QueryModules(Modules);
+	Modules.Sort([](const FModuleStatus& A, const FModuleStatus& B)
+	{
+		return A.Name < B.Name;
+	});
+
+	for (const FModuleStatus& Module : Modules)
+	{
+		if (!Module.bIsLoaded)
+		{
+			continue;
+		}
+		Hash = HashCombine(Hash, GetTypeHash(Module.Name));
+		if (!Module.FilePath.IsEmpty())
+		{
+			Hash = HashCombine(Hash, GetTypeHash(IFileManager::Get().GetTimeStamp(*Module.FilePath).GetTicks()));
+		}
+	}
+	return Hash;
+}
+
+FString FCortexReflectIndex::GetCachePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Cortex") / TEXT("reflect-index.bin");
+}
+
+void FCortexReflectIndex::Build()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Clear();
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (ShouldIndex(*It))
+		{
+			AddEntry(DescribeClass(*It), *It);
+		}
+	}
+	RelinkAll();
+	ResetChangeLog();
+	bBuilt = true;
+
+	UE_LOG(LogCortexReflect, Log, TEXT("Reflection index built: %d classes in %.1f ms"),
+		Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool FCortexReflectIndex::SaveToFile(const FString& Path, uint32 BuildHash) const
+{
+	FStringTableWriter Table;
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body);
+
+	int32 EntryCount = 0;
+	for (const FCortexReflectClassEntry& Entry : Slots)
+	{
+		EntryCount += IsPersistentEntry(Entry) ? 1 : 0;
+	}
+	BodyWriter << EntryCount;
+	for (const FCortexReflectClassEntry& Entry : Slots)
+	{
+		if (IsPersistentEntry(Entry))
+		{
+			WriteEntry(BodyWriter, Table, Entry);
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	int32 StringCount = Table.Strings.Num();
+	Writer << Magic << Version << BuildHash << StringCount;
+	for (FString& String : Table.Strings)
+	{
+		Writer << String;
+	}
+	Writer.Serialize(Body.GetData(), Body.Num());
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		UE_LOG(LogCortexReflect, Warning, TEXT("Failed to write reflection index temp file: %s"), *TempPath);
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		UE_LOG(LogCortexReflect, Warning, TEXT("Failed to move reflection index temp file: %s"), *TempPath);
+		return false;
+	}
+
+	UE_LOG(LogCortexReflect, Log, TEXT("Wrote reflection index: %s (%d classes, %d bytes)"),
+		*Path, EntryCount, Bytes.Num());
+	return true;
+}
+
+bool FCortexReflectIndex::LoadFromFile(const FString& Path, uint32 ExpectedBuildHash)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	uint32 BuildHash = 0;
+	Reader << Magic << Version << BuildHash;
+	if (Reader.IsError() || Magic != FileMagic || Version != FileVersion || BuildHash != ExpectedBuildHash)
+	{
+		return false;
+	}
+
+	int32 StringCount = 0;
+	if (!ReadCount(Reader, StringCount))
+	{
+		return false;
+	}
+	TArray<FString> Strings;
+	Strings.SetNum(StringCount);
+	for (FString& String : Strings)
+	{
+		Reader << String;
+	}
+
+	int32 EntryCount = 0;
+	if (Reader.IsError() || !ReadCount(Reader, EntryCount))
+	{
+		return false;
+	}
+	TArray<FCortexReflectClassEntry> Loaded;
+	Loaded.SetNum(EntryCount);
+	for (FCortexReflectClassEntry& Entry : Loaded)
+	{
+		if (!ReadEntry(Reader, Strings, Entry))
+		{
+			UE_LOG(LogCortexReflect, Warning, TEXT("Reflection index file is corrupt, rebuilding: %s"), *Path);
+			return false;
+		}
+	}
+
+	// Same module binaries, so every class should resolve; anything that does not is dropped
+	Clear();
+	for (FCortexReflectClassEntry& Entry : Loaded)
+	{
+		UClass* Class = FindObject<UClass>(nullptr, *Entry.Path);
+		if (ShouldIndex(Class))
+		{
+			AddEntry(MoveTemp(Entry), Class);
+		}
+	}
+
+	ForEachObjectOfClass(UBlueprintGeneratedClass::StaticClass(), [this](UObject* Object)
+	{
+		UClass* Class = static_cast<UClass*>(Object);
+		if (ShouldIndex(Class) && !ByPath.Contains(Class->GetPathName()))
+		{
+			AddEntry(DescribeClass(Class), Class);
+		}
+	}, true);
+
+	RelinkAll();
+	ResetChangeLog();
+	bBuilt = true;
+	return true;
+}
+
+UClass* FCortexReflectIndex::FindClass(const FString& ShortName)
+{
+	if (ShortName.IsEmpty() || ShortName.Len() >= NAME_SIZE)
+	{
+		return nullptr;
+	}
+
+	// No FName means no object was ever given this name
+	const FName Key(*ShortName, FNAME_Find);
+	if (Key.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (const TArray<int32>* Bucket = ByName.Find(Key))
+	{
+		for (const int32 Slot : *Bucket)
+		{
+			if (UClass* Class = ResolveClass(Slots[Slot]))
+			{
+				return Class;
+			}
+		}
+	}
+
+	if (KnownMisses.Contains(Key))
+	{
+		return nullptr;
+	}
+
+	// The class may have appeared without an event we track: one scan, then it is indexed
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (ShouldIndex(*It) && It->GetName() == ShortName)
+		{
+			UE_LOG(LogCortexReflect, Verbose, TEXT("Reflection index missed %s; patched from scan"), *It->GetPathName());
+			PatchClass(*It);
+			return *It;
+		}
+	}
+
+	KnownMisses.Add(Key);
+	return nullptr;
+}
+
+const FCortexReflectClassEntry* FCortexReflectIndex::FindEntry(const UClass* Class)
+{
+	const int32 Slot = FindSlot(Class);
+	return Slot != INDEX_NONE ? &Slots[Slot] : nullptr;
+}
+
+const FCortexReflectClassEntry* FCortexReflectIndex::FindEntryByPath(const FString& Path) const
+{
+	const int32* Slot = ByPath.Find(Path);
+	return Slot ? &Slots[*Slot] : nullptr;
+}
+
+bool FCortexReflectIndex::GetChangesSince(uint32 SinceVersion, TArray<FString>& OutPaths) const
+{
+	if (SinceVersion < ChangeLogVersion || SinceVersion > Version)
+	{
+		return false;
+	}
+	for (int32 Index = static_cast<int32>(SinceVersion - ChangeLogVersion); Index < ChangeLog.Num(); ++Index)
+	{
+		OutPaths.AddUnique(ChangeLog[Index]);
+	}
+	return true;
+}
+
+bool FCortexReflectIndex::IsProjectClass(const UClass* Class)
+{
+	if (const FCortexReflectClassEntry* Entry = FindEntry(Class))
+	{
+		return Entry->IsProject();
+	}
+	return FCortexReflectOps::IsProjectClass(Class);
+}
+
+void FCortexReflectIndex::GetDerivedClasses(const UClass* Class, TArray<UClass*>& OutClasses, bool bRecursive)
+{
+	const int32 Root = FindSlot(Class);
+	if (Root == INDEX_NONE)
+	{
+		::GetDerivedClasses(Class, OutClasses, bRecursive);
+		return;
+	}
+
+	TArray<int32> Pending(Slots[Root].Children);
+	for (int32 Cursor = 0; Cursor < Pending.Num(); ++Cursor)
+	{
+		const FCortexReflectClassEntry& Entry = Slots[Pending[Cursor]];
+		if (UClass* Derived = ResolveClass(Entry))
+		{
+			OutClasses.Add(Derived);
+			if (bRecursive)
+			{
+				Pending.Append(Entry.Children);
+			}
+		}
+	}
+}
+
+int32 FCortexReflectIndex::CountBlueprintChildren(const UClass* Class)
+{
+	const int32 Slot = FindSlot(Class);
+	if (Slot == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	int32 Count = 0;
+	for (const int32 Child : Slots[Slot].Children)
+	{
+		if (Slots[Child].IsBlueprint() && ResolveClass(Slots[Child]))
+		{
+			++Count;
+		}
+	}
+	return Count;
+}
+
+void FCortexReflectIndex::ForEachClass(TFunctionRef<bool(const FCortexReflectClassEntry&)> Visit) const
+{
+	for (const FCortexReflectClassEntry& Entry : Slots)
+	{
+		if (!Entry.Path.IsEmpty() && !Visit(Entry))
+		{
+			return;
+		}
+	}
+}
+
+const FCortexReflectClassEntry* FCortexReflectIndex::GetSuper(const FCortexReflectClassEntry& Entry) const
+{
+	return Slots.IsValidIndex(Entry.SuperSlot) ? &Slots[Entry.SuperSlot] : nullptr;
+}
+
+UClass* FCortexReflectIndex::ResolveClass(const FCortexReflectClassEntry& Entry) const
+{
+	UClass* Class = Entry.Class.Get();
+	if (ShouldIndex(Class))
+	{
+		return Class;
+	}
+
+	// Reinstanced by a compile or reload: the current class lives at the same path
+	Class = FindObject<UClass>(nullptr, *Entry.Path);
+	if (!ShouldIndex(Class))
+	{
+		return nullptr;
+	}
+	Entry.Class = Class;
+	return Class;
+}
+
+int32 FCortexReflectIndex::PatchClass(UClass* Class)
+{
+	if (!ShouldIndex(Class))
+	{
+		return INDEX_NONE;
+	}
+
+	FCortexReflectClassEntry Entry = DescribeClass(Class);
+	KnownMisses.Remove(FName(*Entry.Name));
+
+	if (const int32* Existing = ByPath.Find(Entry.Path))
+	{
+		const int32 Slot = *Existing;
+		UnlinkSlot(Slot);
+		FCortexReflectClassEntry& Current = Slots[Slot];
+		if (TArray<int32>* Bucket = ByAsset.Find(Current.AssetPath))
+		{
+			Bucket->Remove(Slot);
+		}
+		Entry.Children = MoveTemp(Current.Children);
+		Current = MoveTemp(Entry);
+		NoteChange(Current.Path);
+		Current.Class = Class;
+		if (!Current.AssetPath.IsEmpty())
+		{
+			ByAsset.FindOrAdd(Current.AssetPath).Add(Slot);
+		}
+		LinkSlot(Slot);
+		return Slot;
+	}
+
+	const int32 Slot = AddEntry(MoveTemp(Entry), Class);
+	LinkSlot(Slot);
+
+	TArray<int32> Adopted;
+	if (Orphans.RemoveAndCopyValue(Slots[Slot].Path, Adopted))
+	{
+		for (const int32 Child : Adopted)
+		{
+			Slots[Child].SuperSlot = Slot;
+			NoteChange(Slots[Child].Path);
+		}
+		Slots[Slot].Children.Append(Adopted);
+	}
+	return Slot;
+}
+
+FCortexReflectClassEntry FCortexReflectIndex::DescribeClass(UClass* Class)
+{
+	FCortexReflectClassEntry Entry;
+	Entry.Name = Class->GetName();
+	Entry.CppName = FCortexReflectOps::GetCppClassName(Class);
+	Entry.Path = Class->GetPathName();
+	if (const UClass* Super = Class->GetSuperClass())
+	{
+		Entry.SuperPath = Super->GetPathName();
+	}
+	Entry.ClassFlags = static_cast<uint32>(Class->GetClassFlags());
+
+	if (const UBlueprintGeneratedClass* BPGC = Cast<UBlueprintGeneratedClass>(Class))
+	{
+		Entry.IndexFlags |= FCortexReflectClassEntry::Blueprint;
+		if (const UBlueprint* BP = Cast<UBlueprint>(BPGC->ClassGeneratedBy))
+		{
+			Entry.AssetPath = BP->GetPathName();
+		}
+	}
+	else
+	{
+		if (const FString* ModuleName = Class->FindMetaData(TEXT("ModuleName")))
+		{
+			Entry.Module = *ModuleName;
+		}
+		Entry.SourcePath = Class->GetMetaData(TEXT("ModuleRelativePath"));
+	}
+
+	if (FCortexReflectOps::IsProjectClass(Class))
+	{
+		Entry.IndexFlags |= FCortexReflectClassEntry::Project;
+	}
+
+	for (TFieldIterator<FProperty> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_Parm))
+		{
+			continue;
+		}
+		FCortexReflectPropertyEntry& Property = Entry.Properties.AddDefaulted_GetRef();
+		Property.Name = It->GetName();
+		Property.Type = FCortexReflectOps::GetPropertyTypeName(*It);
+		Property.PropertyFlags = static_cast<uint64>(It->GetPropertyFlags());
+		if (const FString* Category = It->FindMetaData(TEXT("Category")))
+		{
+			Property.Category = *Category;
+		}
+	}
+
+	for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		if (It->HasAnyFunctionFlags(FUNC_Delegate))
+		{
+			continue;
+		}
+		FCortexReflectFunctionEntry& Function = Entry.Functions.AddDefaulted_GetRef();
+		Function.Name = It->GetName();
+		Function.FunctionFlags = static_cast<uint32>(It->FunctionFlags);
+		const FProperty* ReturnProp = It->GetReturnProperty();
+		Function.ReturnType = ReturnProp ? FCortexReflectOps::GetPropertyTypeName(ReturnProp) : TEXT("void");
+		for (TFieldIterator<FProperty> ParamIt(*It); ParamIt; ++ParamIt)
+		{
+			if (ParamIt->HasAnyPropertyFlags(CPF_Parm) && !ParamIt->HasAnyPropertyFlags(CPF_ReturnParm))
+			{
+				FCortexReflectParamEntry& Param = Function.Params.AddDefaulted_GetRef();
+				Param.Name = ParamIt->GetName();
+				Param.Type = FCortexReflectOps::GetPropertyTypeName(*ParamIt);
+				Param.bIsOut = ParamIt->HasAnyPropertyFlags(CPF_OutParm);
+			}
+		}
+	}
+
+	return Entry;
+}
+
+bool FCortexReflectIndex::ShouldIndex(const UClass* Class)
+{
+	return IsValid(Class) && !Class->HasAnyClassFlags(CLASS_NewerVersionExists);
+}
+
+void FCortexReflectIndex::Clear()
+{
+	Slots.Reset();
+	FreeSlots.Reset();
+	ByName.Reset();
+	ByPath.Reset();
+	ByAsset.Reset();
+	Orphans.Reset();
+	KnownMisses.Reset();
+	bBuilt = false;
+	++Version;
+	ResetChangeLog();
+}
+
+void FCortexReflectIndex::NoteChange(const FString& Path)
+{
+	// Past this many changes a rescan is cheaper than replaying them
+	constexpr int32 MaxChangeLog = 4096;
+	if (ChangeLog.Num() >= MaxChangeLog)
+	{
+		ResetChangeLog();
+	}
+	++Version;
+	ChangeLog.Add(Path);
+}
+
+void FCortexReflectIndex::ResetChangeLog()
+{
+	ChangeLog.Reset();
+	ChangeLogVersion = Version;
+}
+
+int32 FCortexReflectIndex::AddEntry(FCortexReflectClassEntry&& Entry, UClass* Class)
+{
+	int32 Slot = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		Slots[Slot] = MoveTemp(Entry);
+	}
+	else
+	{
+		Slot = Slots.Add(MoveTemp(Entry));
+	}
+
+	FCortexReflectClassEntry& Added = Slots[Slot];
+	NoteChange(Added.Path);
+	Added.Class = Class;
+	Added.SuperSlot = INDEX_NONE;
+	Added.Children.Reset();
+	ByName.FindOrAdd(FName(*Added.Name)).Add(Slot);
+	ByPath.Add(Added.Path, Slot);
+	if (!Added.AssetPath.IsEmpty())
+	{
+		ByAsset.FindOrAdd(Added.AssetPath).Add(Slot);
+	}
+	return Slot;
+}
+
+void FCortexReflectIndex::RemoveSlot(int32 Slot)
+{
+	UnlinkSlot(Slot);
+
+	FCortexReflectClassEntry& Entry = Slots[Slot];
+	for (const int32 Child : Entry.Children)
+	{
+		Slots[Child].SuperSlot = INDEX_NONE;
+		NoteChange(Slots[Child].Path);
+	}
+	if (Entry.Children.Num() > 0)
+	{
+		Orphans.FindOrAdd(Entry.Path).Append(Entry.Children);
+	}
+
+	const FName Key(*Entry.Name);
+	if (TArray<int32>* Bucket = ByName.Find(Key))
+	{
+		Bucket->Remove(Slot);
+		if (Bucket->Num() == 0)
+		{
+			ByName.Remove(Key);
+		}
+	}
+	ByPath.Remove(Entry.Path);
+	if (TArray<int32>* Bucket = ByAsset.Find(Entry.AssetPath))
+	{
+		Bucket->Remove(Slot);
+		if (Bucket->Num() == 0)
+		{
+			ByAsset.Remove(Entry.AssetPath);
+		}
+	}
+
+	NoteChange(Entry.Path);
+	Entry = FCortexReflectClassEntry();
+	FreeSlots.Add(Slot);
+}
+
+void FCortexReflectIndex::RemoveAsset(const FString& AssetPath)
+{
+	TArray<int32> AssetSlots;
+	if (ByAsset.RemoveAndCopyValue(AssetPath, AssetSlots))
+	{
+		for (const int32 Slot : AssetSlots)
+		{
+			Slots[Slot].AssetPath.Reset();
+			RemoveSlot(Slot);
+		}
+	}
+}
+
+void FCortexReflectIndex::LinkSlot(int32 Slot)
+{
+	FCortexReflectClassEntry& Entry = Slots[Slot];
+	Entry.SuperSlot = INDEX_NONE;
+	if (Entry.SuperPath.IsEmpty())
+	{
+		return;
+	}
+
+	if (const int32* Super = ByPath.Find(Entry.SuperPath))
+	{
+		Entry.SuperSlot = *Super;
+		Slots[*Super].Children.Add(Slot);
+	}
+	else
+	{
+		Orphans.FindOrAdd(Entry.SuperPath).Add(Slot);
+	}
+}
+
+void FCortexReflectIndex::UnlinkSlot(int32 Slot)
+{
+	FCortexReflectClassEntry& Entry = Slots[Slot];
+	if (Slots.IsValidIndex(Entry.SuperSlot))
+	{
+		Slots[Entry.SuperSlot].Children.Remove(Slot);
+	}
+	else if (TArray<int32>* Waiting = Orphans.Find(Entry.SuperPath))
+	{
+		Waiting->Remove(Slot);
+		if (Waiting->Num() == 0)
+		{
+			Orphans.Remove(Entry.SuperPath);
+		}
+	}
+	Entry.SuperSlot = INDEX_NONE;
+}
+
+void FCortexReflectIndex::RelinkAll()
+{
+	Orphans.Reset();
+	for (FCortexReflectClassEntry& Entry : Slots)
+	{
+		Entry.SuperSlot = INDEX_NONE;
+		Entry.Children.Reset();
+	}
+	for (int32 Slot = 0; Slot < Slots.Num(); ++Slot)
+	{
+		if (!Slots[Slot].Path.IsEmpty())
+		{
+			LinkSlot(Slot);
+		}
+	}
+}
+
+void FCortexReflectIndex::PatchBlueprint(UBlueprint* Blueprint)
+{
+	if (!IsValid(Blueprint))
+	{
+		return;
+	}
+	PatchClass(Blueprint->GeneratedClass);
+	PatchClass(Blueprint->SkeletonGeneratedClass);
+}
+
+void FCortexReflectIndex::PatchChangedClasses()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 Patched = 0;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (!ShouldIndex(Class))
+		{
+			continue;
+		}
+		const int32* Slot = ByPath.Find(Class->GetPathName());
+		if (!Slot || Slots[*Slot].Class.Get() != Class)
+		{
+			PatchClass(Class);
+			++Patched;
+		}
+	}
+
+	UE_LOG(LogCortexReflect, Log, TEXT("Reflection index patched %d classes after reload in %.1f ms"),
+		Patched, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FCortexReflectIndex::EnsureBuilt()
+{
+	if (bBuilt)
+	{
+		return;
+	}
+
+	// After a reload the binaries on disk no longer describe the live classes, so the cache is neither trusted nor written
+	if (ReloadCount > 0)
+	{
+		Build();
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const uint32 BuildHash = ComputeBuildHash();
+	if (LoadFromFile(GetCachePath(), BuildHash))
+	{
+		UE_LOG(LogCortexReflect, Log, TEXT("Reflection index loaded from disk: %d classes in %.1f ms"),
+			Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return;
+	}
+
+	Build();
+	SaveToFile(GetCachePath(), BuildHash);
+}
+
+int32 FCortexReflectIndex::FindSlot(const UClass* Class)
+{
+	if (!ShouldIndex(Class))
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* Slot = ByPath.Find(Class->GetPathName()))
+	{
+		if (Slots[*Slot].Class.Get() == Class)
+		{
+			return *Slot;
+		}
+	}
+	return PatchClass(const_cast<UClass*>(Class));
+}
+
+void FCortexReflectIndex::BindDelegates()
+{
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(
+		this, &FCortexReflectIndex::HandleModulesChanged);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(
+		this, &FCortexReflectIndex::HandleReloadComplete);
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(
+		this, &FCortexReflectIndex::HandleAssetLoaded);
+
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(
+			this, &FCortexReflectIndex::HandleBlueprintPreCompile);
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(
+			this, &FCortexReflectIndex::HandleBlueprintCompiled);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+		TEXT("AssetRegistry")
+	).Get();
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(
+		this, &FCortexReflectIndex::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(
+		this, &FCortexReflectIndex::HandleAssetRenamed);
+}
+
+void FCortexReflectIndex::UnbindDelegates()
+{
+	if (ModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+	if (ReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+		ReloadCompleteHandle.Reset();
+	}
+	if (AssetLoadedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+		AssetLoadedHandle.Reset();
+	}
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	BlueprintPreCompileHandle.Reset();
+	BlueprintCompiledHandle.Reset();
+
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(
+			TEXT("AssetRegistry")
+		).Get();
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+}
+
+void FCortexReflectIndex::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (!bBuilt || Reason != EModuleChangeReason::ModuleLoaded)
+	{
+		return;
+	}
+
+	// A late-loaded module registers its classes under /Script/<Module> before this fires
+	const UPackage* Package = FindPackage(nullptr, *(TEXT("/Script/") + ModuleName.ToString()));
+	if (!Package)
+	{
+		return;
+	}
+
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		if (UClass* Class = Cast<UClass>(Object))
+		{
+			PatchClass(Class);
+		}
+		return true;
+	}, false);
+}
+
+void FCortexReflectIndex::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+	// Live Coding leaves module timestamps alone, so a save here would stamp patched layouts
+	// with the hash of the unpatched binaries the next session loads
+	++ReloadCount;
+	if (!bBuilt)
+	{
+		return;
+	}
+
+	// Reinstanced classes keep their path but are new objects; only those are re-described
+	PatchChangedClasses();
+}
+
+void FCortexReflectIndex::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	PendingCompiles.AddUnique(Blueprint);
+}
+
+void FCortexReflectIndex::HandleBlueprintCompiled()
+{
+	if (bBuilt)
+	{
+		for (const TWeakObjectPtr<UBlueprint>& Blueprint : PendingCompiles)
+		{
+			PatchBlueprint(Blueprint.Get());
+		}
+	}
+	PendingCompiles.Reset();
+}
+
+void FCortexReflectIndex::HandleAssetLoaded(UObject* Asset)
+{
+	if (bBuilt)
+	{
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+		{
+			PatchBlueprint(Blueprint);
+		}
+	}
+}
+
+void FCortexReflectIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	RemoveAsset(AssetData.GetObjectPathString());
+}
+
+void FCortexReflectIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemoveAsset(OldObjectPath);
+	if (bBuilt)
+	{
+		PatchBlueprint(FindObject<UBlueprint>(nullptr, *AssetData.GetObjectPathString()));
+	}
+}
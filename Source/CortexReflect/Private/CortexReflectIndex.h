@@ -0,0 +1,217 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+class UBlueprint;
+class UClass;
+struct FAssetData;
+
+struct FCortexReflectParamEntry
+{
+	FString Name;
+	FString Type;
+	bool bIsOut = false;
+};
+
+struct FCortexReflectFunctionEntry
+{
+	FString Name;
+	FString ReturnType;
+	uint32 FunctionFlags = 0;
+	TArray<FCortexReflectParamEntry> Params;
+};
+
+struct FCortexReflectPropertyEntry
+{
+	FString Name;
+	FString Type;
+	FString Category;
+	uint64 PropertyFlags = 0;
+};
+
+/** One indexed class: what the reflect queries read, captured once per class. */
+struct FCortexReflectClassEntry
+{
+	enum EIndexFlags : uint8
+	{
+		Blueprint = 1 << 0,
+		Project = 1 << 1,
+	};
+
+	/** UClass::GetName(), without the A/U prefix */
+	FString Name;
+	FString CppName;
+	FString Path;
+	FString SuperPath;
+	/** ModuleName metadata (native only) */
+	FString Module;
+	/** ModuleRelativePath metadata (native only) */
+	FString SourcePath;
+	/** Generating Blueprint object path (Blueprint only) */
+	FString AssetPath;
+	uint32 ClassFlags = 0;
+	uint8 IndexFlags = 0;
+	/** Functions and properties declared on this class itself, not inherited */
+	TArray<FCortexReflectFunctionEntry> Functions;
+	TArray<FCortexReflectPropertyEntry> Properties;
+
+	/** Runtime links, rebuilt after a load from disk */
+	int32 SuperSlot = INDEX_NONE;
+	TArray<int32> Children;
+	mutable TWeakObjectPtr<UClass> Class;
+
+	bool IsBlueprint() const { return (IndexFlags & Blueprint) != 0; }
+	bool IsProject() const { return (IndexFlags & Project) != 0; }
+};
+
+/**
+ * Class tree, function signatures, property tables and flags for every UClass, keyed
+ * by short-name FName and path so reflect lookups are map hits instead of a
+ * TObjectIterator<UClass> scan. Native classes are built once and persisted to
+ * Saved/Cortex/reflect-index.bin under a hash of the loaded module binaries; the next
+ * editor session loads that file instead of re-describing every class and only
+ * resolves each UClass by path. Blueprint classes are always indexed live.
+ *
+ * Kept current from module loads, hot reload / Live Coding, Blueprint compiles and
+ * asset load/remove/rename events. Hits are re-checked against the live class pointer
+ * and a miss falls back to one scan, but an entry whose class object survives a change
+ * keeps its old description until one of those events patches it. Live Coding patches
+ * classes in memory without touching module binaries, so after a reload the index is
+ * never written to (or read from) disk for the rest of the session. Game thread only.
+ */
+class FCortexReflectIndex
+{
+public:
+	static constexpr uint32 FileMagic = 0x58495243; // "CRIX"
+	static constexpr int32 FileVersion = 1;
+
+	FCortexReflectIndex() = default;
+	~FCortexReflectIndex();
+
+	/** Shared index, built (or loaded from disk) on first use. */
+	static FCortexReflectIndex& Get();
+
+	/** Build or load the shared index and start tracking class changes. */
+	static void Initialize();
+
+	/** Drop the shared index and unbind events. */
+	static void Reset();
+
+	/** Hash of engine version and every loaded module binary; the on-disk index is only reused on a match. */
+	static uint32 ComputeBuildHash();
+
+	static FString GetCachePath();
+
+	/** Index every live class. */
+	void Build();
+
+	/** Write native entries to Path, stamped with BuildHash. */
+	bool SaveToFile(const FString& Path, uint32 BuildHash) const;
+
+	/**
+	 * Replace the index with the native entries in Path plus live Blueprint classes.
+	 * Fails without side effects on a bad file or a hash mismatch.
+	 */
+	bool LoadFromFile(const FString& Path, uint32 ExpectedBuildHash);
+
+	/** Live class whose GetName() equals ShortName (case-insensitive), or null. */
+	UClass* FindClass(const FString& ShortName);
+
+	const FCortexReflectClassEntry* FindEntry(const UClass* Class);
+
+	/** Entry for a class path as currently indexed, without resolving or refreshing it. */
+	const FCortexReflectClassEntry* FindEntryByPath(const FString& Path) const;
+
+	/** Cached FCortexReflectOps::IsProjectClass. */
+	bool IsProjectClass(const UClass* Class);
+
+	/** Same contract as the engine's GetDerivedClasses, answered from the child lists. */
+	void GetDerivedClasses(const UClass* Class, TArray<UClass*>& OutClasses, bool bRecursive);
+
+	int32 CountBlueprintChildren(const UClass* Class);
+
+	/** Visit live entries in index order until Visit returns false. */
+	void ForEachClass(TFunctionRef<bool(const FCortexReflectClassEntry&)> Visit) const;
+
+	/** Parent entry, or null for UObject and unindexed parents. */
+	const FCortexReflectClassEntry* GetSuper(const FCortexReflectClassEntry& Entry) const;
+
+	/** Live UClass for an entry, re-resolved by path when the cached pointer went stale. */
+	UClass* ResolveClass(const FCortexReflectClassEntry& Entry) const;
+
+	int32 Num() const { return Slots.Num() - FreeSlots.Num(); }
+
+	/** Bumped on every add, refresh or removal; lets derived indexes detect staleness. */
+	uint32 GetVersion() const { return Version; }
+
+	/**
+	 * Class paths added, refreshed or removed since SinceVersion, each once. False when
+	 * that version predates the change log (a full build, a Clear, or too many changes
+	 * since), in which case the caller has to rescan.
+	 */
+	bool GetChangesSince(uint32 SinceVersion, TArray<FString>& OutPaths) const;
+
+	/** Add or refresh one class in place, keeping its child links. Returns its slot. */
+	int32 PatchClass(UClass* Class);
+
+private:
+	static FCortexReflectClassEntry DescribeClass(UClass* Class);
+	static bool ShouldIndex(const UClass* Class);
+
+	void Clear();
+	void NoteChange(const FString& Path);
+	void ResetChangeLog();
+	int32 AddEntry(FCortexReflectClassEntry&& Entry, UClass* Class);
+	void RemoveSlot(int32 Slot);
+	void RemoveAsset(const FString& AssetPath);
+	void LinkSlot(int32 Slot);
+	void UnlinkSlot(int32 Slot);
+	void RelinkAll();
+	void PatchBlueprint(UBlueprint* Blueprint);
+	void PatchChangedClasses();
+	void EnsureBuilt();
+
+	/** Slot for a live class; indexes or refreshes it when missing or stale. */
+	int32 FindSlot(const UClass* Class);
+
+	void BindDelegates();
+	void UnbindDelegates();
+	void HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleBlueprintCompiled();
+	void HandleAssetLoaded(UObject* Asset);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	TArray<FCortexReflectClassEntry> Slots;
+	TArray<int32> FreeSlots;
+	TMap<FName, TArray<int32>> ByName;
+	TMap<FString, int32> ByPath;
+	TMap<FString, TArray<int32>> ByAsset;
+	/** Slots whose parent is not indexed (yet), keyed by the parent's path */
+	TMap<FString, TArray<int32>> Orphans;
+	/** Short names a fallback scan already failed to find; cleared whenever classes change */
+	TSet<FName> KnownMisses;
+	TArray<TWeakObjectPtr<UBlueprint>> PendingCompiles;
+	uint32 Version = 0;
+	/** One class path per Version bump since ChangeLogVersion */
+	TArray<FString> ChangeLog;
+	uint32 ChangeLogVersion = 0;
+	bool bBuilt = false;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle AssetLoadedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+
+	static TUniquePtr<FCortexReflectIndex> Instance;
+
+	/** Hot reloads / Live Coding patches this session; the disk cache is bypassed once non-zero */
+	static int32 ReloadCount;
+};
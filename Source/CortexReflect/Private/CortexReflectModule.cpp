@@ -2,6 +2,9 @@
 #include "CortexCoreModule.h"
 #include "ICortexCommandRegistry.h"
 #include "CortexReflectCommandHandler.h"
+#include "CortexReflectBlueprintTags.h"
+#include "CortexReflectIndex.h"
+#include "CortexReflectSymbolIndex.h"
 #include "Engine/Engine.h"
 #include "Operations/CortexReflectOps.h"
 
@@ -22,6 +25,9 @@ void FCortexReflectModule::StartupModule()
 		MakeShared<FCortexReflectCommandHandler>()
 	);
 
+	// Tags are gathered at save time, so register before any Blueprint can be saved
+	FCortexReflectBlueprintTags::Register();
+
 	if (GEngine && GEngine->IsInitialized())
 	{
 		OnPostEngineInit();
@@ -45,11 +51,17 @@ void FCortexReflectModule::ShutdownModule()
 		PostEngineInitHandle.Reset();
 	}
 
+	FCortexReflectBlueprintTags::Unregister();
+	FCortexReflectSymbolIndex::Reset();
+	FCortexReflectIndex::Reset();
+
 	UE_LOG(LogCortexReflect, Log, TEXT("CortexReflect module shutting down"));
 }
 
 void FCortexReflectModule::OnPostEngineInit()
 {
+	FCortexReflectIndex::Initialize();
+	FCortexReflectSymbolIndex::Initialize();
 	RunAutoScan();
 }
 
@@ -0,0 +1,628 @@
+#include "CortexReflectSymbolIndex.h"
+#include "CortexReflectIndex.h"
+#include "CortexReflectModule.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectIterator.h"
+
+TUniquePtr<FCortexReflectSymbolIndex> FCortexReflectSymbolIndex::Instance;
+
+namespace
+{
+/** Typos and partial words: keep candidates sharing at least this fraction of the query's trigrams */
+constexpr float MinTrigramOverlap = 0.5f;
+
+/** Token matches are tracked as a bitmask per candidate */
+constexpr int32 MaxQueryTokens = 16;
+
+constexpr int32 MaxQueryLength = 256;
+
+uint32 PackTrigram(TCHAR A, TCHAR B, TCHAR C)
+{
+	return ((static_cast<uint32>(A) & 0x3FF) << 20)
+		| ((static_cast<uint32>(B) & 0x3FF) << 10)
+		| (static_cast<uint32>(C) & 0x3FF);
+}
+
+void AppendTrigrams(const FString& Lower, TArray<uint32>& OutTrigrams)
+{
+	for (int32 Index = 0; Index + 2 < Lower.Len(); ++Index)
+	{
+		OutTrigrams.AddUnique(PackTrigram(Lower[Index], Lower[Index + 1], Lower[Index + 2]));
+	}
+}
+
+bool AcceptsSymbol(const FCortexReflectSymbol& Symbol, const FCortexSymbolQuery& Query)
+{
+	if ((Query.KindMask & (1 << static_cast<uint8>(Symbol.Kind))) == 0)
+	{
+		return false;
+	}
+	if (!Query.bIncludeEngine && !Symbol.bProject)
+	{
+		return false;
+	}
+	return Query.ModuleFilter.IsEmpty() || Symbol.Module.Contains(Query.ModuleFilter, ESearchCase::IgnoreCase);
+}
+
+/**
+ * Full ranking for one finalist. Whole-name hits dominate, then how many query tokens
+ * the name's tokens cover (exact > prefix > within edit distance), then closeness of the
+ * whole name, then locality. Shorter names win ties.
+ */
+float ScoreSymbol(
+	const FCortexReflectSymbol& Symbol,
+	const FString& NameLower,
+	const TArray<FString>& QueryTokens,
+	const FString& QueryJoined,
+	float TrigramOverlap,
+	const FString& PreferModule)
+{
+	float Score = 0.0f;
+	if (NameLower == QueryJoined)
+	{
+		Score += 100.0f;
+	}
+	else if (NameLower.StartsWith(QueryJoined))
+	{
+		Score += 40.0f;
+	}
+	else if (NameLower.Contains(QueryJoined))
+	{
+		Score += 25.0f;
+	}
+
+	TArray<FString> NameTokens;
+	FCortexReflectSymbolTable::SplitTokens(Symbol.Name, NameTokens);
+	int32 MatchedTokens = 0;
+	for (const FString& QueryToken : QueryTokens)
+	{
+		const int32 MaxTypos = QueryToken.Len() >= 7 ? 2 : (QueryToken.Len() >= 4 ? 1 : 0);
+		float Best = 0.0f;
+		for (const FString& NameToken : NameTokens)
+		{
+			if (NameToken == QueryToken)
+			{
+				Best = 20.0f;
+				break;
+			}
+			if (QueryToken.Len() >= 2 && NameToken.StartsWith(QueryToken))
+			{
+				Best = FMath::Max(Best, 12.0f);
+			}
+			else if (MaxTypos > 0 && FCortexReflectSymbolTable::BoundedEditDistance(NameToken, QueryToken, MaxTypos) <= MaxTypos)
+			{
+				Best = FMath::Max(Best, 8.0f);
+			}
+		}
+		Score += Best;
+		MatchedTokens += Best > 0.0f ? 1 : 0;
+	}
+	if (MatchedTokens == QueryTokens.Num())
+	{
+		Score += 15.0f;
+	}
+
+	constexpr int32 MaxNameTypos = 3;
+	const int32 NameDistance = FCortexReflectSymbolTable::BoundedEditDistance(NameLower, QueryJoined, MaxNameTypos);
+	if (NameDistance <= MaxNameTypos)
+	{
+		Score += 10.0f - 3.0f * NameDistance;
+	}
+
+	Score += 10.0f * TrigramOverlap;
+
+	if (Symbol.bProject)
+	{
+		Score += 10.0f;
+	}
+	if (!PreferModule.IsEmpty() && Symbol.Module.Equals(PreferModule, ESearchCase::IgnoreCase))
+	{
+		Score += 6.0f;
+	}
+	if (Symbol.Kind == ECortexSymbolKind::Class || Symbol.Kind == ECortexSymbolKind::Struct || Symbol.Kind == ECortexSymbolKind::Enum)
+	{
+		Score += 2.0f;
+	}
+
+	return Score - 0.05f * FMath::Abs(NameLower.Len() - QueryJoined.Len());
+}
+
+/** Skeleton, reinstancing and trash classes mirror real ones and would only duplicate results */
+bool IsShadowClassName(const FString& Name)
+{
+	return Name.StartsWith(TEXT("SKEL_"), ESearchCase::CaseSensitive)
+		|| Name.StartsWith(TEXT("REINST_"), ESearchCase::CaseSensitive)
+		|| Name.StartsWith(TEXT("TRASH_"), ESearchCase::CaseSensitive);
+}
+
+FString GetScriptModuleName(const FString& ObjectPath)
+{
+	static const FString ScriptPrefix(TEXT("/Script/"));
+	if (!ObjectPath.StartsWith(ScriptPrefix))
+	{
+		return FString();
+	}
+	FString ModuleName = ObjectPath.Mid(ScriptPrefix.Len());
+	int32 DotIndex = INDEX_NONE;
+	if (ModuleName.FindChar(TEXT('.'), DotIndex))
+	{
+		ModuleName.LeftInline(DotIndex, EAllowShrinking::No);
+	}
+	return ModuleName;
+}
+
+FString FormatSignature(const FCortexReflectFunctionEntry& Function)
+{
+	FString Signature = Function.ReturnType + TEXT(" ") + Function.Name + TEXT("(");
+	for (int32 Index = 0; Index < Function.Params.Num(); ++Index)
+	{
+		const FCortexReflectParamEntry& Param = Function.Params[Index];
+		if (Index > 0)
+		{
+			Signature += TEXT(", ");
+		}
+		if (Param.bIsOut)
+		{
+			Signature += TEXT("out ");
+		}
+		Signature += Param.Type + TEXT(" ") + Param.Name;
+	}
+	return Signature + TEXT(")");
+}
+
+void AddTypeSymbol(const UObject* Type, ECortexSymbolKind Kind, const FString& DisplayName, const TSet<FString>& ProjectModules, TArray<FCortexReflectSymbol>& OutSymbols)
+{
+	FCortexReflectSymbol& Symbol = OutSymbols.AddDefaulted_GetRef();
+	Symbol.Kind = Kind;
+	Symbol.Name = Type->GetName();
+	Symbol.DisplayName = DisplayName;
+	Symbol.Path = Type->GetPathName();
+	Symbol.Module = GetScriptModuleName(Symbol.Path);
+	Symbol.bBlueprint = Symbol.Module.IsEmpty();
+	Symbol.bProject = Symbol.Path.StartsWith(TEXT("/Game/")) || ProjectModules.Contains(Symbol.Module);
+}
+}
+
+TSharedRef<FCortexReflectSymbolTable> FCortexReflectSymbolTable::Build(TArray<FCortexReflectSymbol>&& InSymbols)
+{
+	TSharedRef<FCortexReflectSymbolTable> Table = MakeShared<FCortexReflectSymbolTable>();
+	Table->Append(MoveTemp(InSymbols));
+	return Table;
+}
+
+void FCortexReflectSymbolTable::Append(TArray<FCortexReflectSymbol>&& InSymbols)
+{
+	const int32 First = Symbols.Num();
+	Symbols.Append(MoveTemp(InSymbols));
+
+	const int32 Count = Symbols.Num();
+	NamesLower.Reserve(Count);
+	TArray<FString> Tokens;
+	TArray<uint32> Trigrams;
+	for (int32 SymbolId = First; SymbolId < Count; ++SymbolId)
+	{
+		const FCortexReflectSymbol& Symbol = Symbols[SymbolId];
+		FString Lower = Symbol.Name.ToLower();
+
+		Tokens.Reset();
+		SplitTokens(Symbol.Name, Tokens);
+		for (const FString& Token : Tokens)
+		{
+			ByToken.FindOrAdd(Token).Add(SymbolId);
+		}
+
+		Trigrams.Reset();
+		AppendTrigrams(Lower, Trigrams);
+		for (const uint32 Trigram : Trigrams)
+		{
+			ByTrigram.FindOrAdd(Trigram).Add(SymbolId);
+		}
+
+		ByPath.FindOrAdd(Symbol.Path).Add(SymbolId);
+		NamesLower.Add(MoveTemp(Lower));
+	}
+
+	// Accumulators are all zero between queries, so growing them keeps that invariant
+	TrigramHits.SetNumZeroed(Count);
+	TokenMasks.SetNumZeroed(Count);
+	Removed.Add(false, Count - First);
+}
+
+void FCortexReflectSymbolTable::RemovePath(const FString& Path)
+{
+	TArray<int32> SymbolIds;
+	if (!ByPath.RemoveAndCopyValue(Path, SymbolIds))
+	{
+		return;
+	}
+	for (const int32 SymbolId : SymbolIds)
+	{
+		if (!Removed[SymbolId])
+		{
+			Removed[SymbolId] = true;
+			++RemovedCount;
+		}
+	}
+}
+
+void FCortexReflectSymbolTable::Query(const FCortexSymbolQuery& InQuery, TArray<FCortexSymbolMatch>& OutMatches) const
+{
+	OutMatches.Reset();
+
+	TArray<FString> QueryTokens;
+	SplitTokens(InQuery.Text.Left(MaxQueryLength), QueryTokens);
+	if (QueryTokens.Num() > MaxQueryTokens)
+	{
+		QueryTokens.SetNum(MaxQueryTokens);
+	}
+	const FString QueryJoined = FString::Join(QueryTokens, TEXT(""));
+	if (QueryJoined.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint32> QueryTrigrams;
+	AppendTrigrams(QueryJoined, QueryTrigrams);
+
+	// Accumulate over the postings of the query's own tokens and trigrams only
+	Touched.Reset();
+	for (int32 TokenIndex = 0; TokenIndex < QueryTokens.Num(); ++TokenIndex)
+	{
+		if (const TArray<int32>* Posting = ByToken.Find(QueryTokens[TokenIndex]))
+		{
+			for (const int32 SymbolId : *Posting)
+			{
+				if (TokenMasks[SymbolId] == 0 && TrigramHits[SymbolId] == 0)
+				{
+					Touched.Add(SymbolId);
+				}
+				TokenMasks[SymbolId] |= static_cast<uint16>(1 << TokenIndex);
+			}
+		}
+	}
+	for (const uint32 Trigram : QueryTrigrams)
+	{
+		if (const TArray<int32>* Posting = ByTrigram.Find(Trigram))
+		{
+			for (const int32 SymbolId : *Posting)
+			{
+				if (TokenMasks[SymbolId] == 0 && TrigramHits[SymbolId] == 0)
+				{
+					Touched.Add(SymbolId);
+				}
+				++TrigramHits[SymbolId];
+			}
+		}
+	}
+
+	// Cheap score into a bounded min-heap; the accumulators are cleared on the way
+	struct FCandidate
+	{
+		float Score;
+		int32 SymbolId;
+		float TrigramOverlap;
+	};
+	auto ByScore = [](const FCandidate& A, const FCandidate& B) { return A.Score < B.Score; };
+
+	const int32 MaxCandidates = FMath::Max(1, InQuery.MaxCandidates);
+	const int32 MinTrigramHits = QueryTrigrams.Num() > 0
+		? FMath::Max(1, FMath::CeilToInt(QueryTrigrams.Num() * MinTrigramOverlap))
+		: MAX_int32;
+	TArray<FCandidate> Heap;
+	Heap.Reserve(MaxCandidates + 1);
+	for (const int32 SymbolId : Touched)
+	{
+		const int32 Hits = TrigramHits[SymbolId];
+		const int32 MatchedTokens = FMath::CountBits(TokenMasks[SymbolId]);
+		TrigramHits[SymbolId] = 0;
+		TokenMasks[SymbolId] = 0;
+
+		if (Removed[SymbolId] || (MatchedTokens == 0 && Hits < MinTrigramHits) || !AcceptsSymbol(Symbols[SymbolId], InQuery))
+		{
+			continue;
+		}
+
+		const float Overlap = QueryTrigrams.Num() > 0 ? static_cast<float>(Hits) / QueryTrigrams.Num() : 0.0f;
+		const FCandidate Candidate{ MatchedTokens * 10.0f + Overlap * 10.0f - 0.01f * NamesLower[SymbolId].Len(), SymbolId, Overlap };
+		if (Heap.Num() < MaxCandidates)
+		{
+			Heap.HeapPush(Candidate, ByScore);
+		}
+		else if (Candidate.Score > Heap.HeapTop().Score)
+		{
+			Heap.HeapPopDiscard(ByScore);
+			Heap.HeapPush(Candidate, ByScore);
+		}
+	}
+	Touched.Reset();
+
+	OutMatches.Reserve(Heap.Num());
+	for (const FCandidate& Candidate : Heap)
+	{
+		FCortexSymbolMatch& Match = OutMatches.AddDefaulted_GetRef();
+		Match.SymbolId = Candidate.SymbolId;
+		Match.Score = ScoreSymbol(
+			Symbols[Candidate.SymbolId],
+			NamesLower[Candidate.SymbolId],
+			QueryTokens,
+			QueryJoined,
+			Candidate.TrigramOverlap,
+			InQuery.PreferModule);
+	}
+
+	OutMatches.Sort([this](const FCortexSymbolMatch& A, const FCortexSymbolMatch& B)
+	{
+		if (A.Score != B.Score)
+		{
+			return A.Score > B.Score;
+		}
+		return NamesLower[A.SymbolId] < NamesLower[B.SymbolId];
+	});
+}
+
+void FCortexReflectSymbolTable::SplitTokens(const FString& Text, TArray<FString>& OutTokens)
+{
+	FString Current;
+	auto Flush = [&Current, &OutTokens]()
+	{
+		if (!Current.IsEmpty())
+		{
+			OutTokens.AddUnique(Current);
+			Current.Reset();
+		}
+	};
+
+	const int32 Len = Text.Len();
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const TCHAR Char = Text[Index];
+		if (!FChar::IsAlnum(Char))
+		{
+			Flush();
+			continue;
+		}
+
+		// "ApplyDamage" -> Apply|Damage, "HTTPRequest" -> HTTP|Request, "Vector2D" -> Vector2|D
+		if (!Current.IsEmpty() && FChar::IsUpper(Char))
+		{
+			const TCHAR Prev = Text[Index - 1];
+			const bool bNextLower = Index + 1 < Len && FChar::IsLower(Text[Index + 1]);
+			if (FChar::IsLower(Prev) || FChar::IsDigit(Prev) || (FChar::IsUpper(Prev) && bNextLower))
+			{
+				Flush();
+			}
+		}
+		Current.AppendChar(FChar::ToLower(Char));
+	}
+	Flush();
+}
+
+int32 FCortexReflectSymbolTable::BoundedEditDistance(const FString& A, const FString& B, int32 MaxDistance)
+{
+	const int32 LenA = A.Len();
+	const int32 LenB = B.Len();
+	if (FMath::Abs(LenA - LenB) > MaxDistance)
+	{
+		return MaxDistance + 1;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Previous;
+	TArray<int32, TInlineAllocator<64>> Current;
+	Previous.SetNumUninitialized(LenB + 1);
+	Current.SetNumUninitialized(LenB + 1);
+	for (int32 Column = 0; Column <= LenB; ++Column)
+	{
+		Previous[Column] = Column;
+	}
+
+	for (int32 Row = 1; Row <= LenA; ++Row)
+	{
+		Current[0] = Row;
+		int32 RowMin = Row;
+		for (int32 Column = 1; Column <= LenB; ++Column)
+		{
+			const int32 Cost = A[Row - 1] == B[Column - 1] ? 0 : 1;
+			Current[Column] = FMath::Min3(Previous[Column] + 1, Current[Column - 1] + 1, Previous[Column - 1] + Cost);
+			RowMin = FMath::Min(RowMin, Current[Column]);
+		}
+		if (RowMin > MaxDistance)
+		{
+			return MaxDistance + 1;
+		}
+		Swap(Previous, Current);
+	}
+
+	return Previous[LenB] <= MaxDistance ? Previous[LenB] : MaxDistance + 1;
+}
+
+FCortexReflectSymbolIndex& FCortexReflectSymbolIndex::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FCortexReflectSymbolIndex>();
+	}
+	return *Instance;
+}
+
+void FCortexReflectSymbolIndex::Initialize()
+{
+	FCortexReflectSymbolIndex& Index = Get();
+	if (!Index.Table.IsValid() && !Index.PendingBuild.IsValid())
+	{
+		Index.StartBuild();
+	}
+}
+
+void FCortexReflectSymbolIndex::Reset()
+{
+	if (Instance.IsValid() && Instance->PendingBuild.IsValid())
+	{
+		// The build task runs this module's code
+		Instance->PendingBuild.Wait();
+	}
+	Instance.Reset();
+}
+
+TSharedPtr<const FCortexReflectSymbolTable> FCortexReflectSymbolIndex::GetTable(bool& bOutStale)
+{
+	// Only wait when there is nothing to answer from
+	TakeFinishedBuild(!Table.IsValid());
+	if (!Table.IsValid())
+	{
+		StartBuild();
+		TakeFinishedBuild(true);
+	}
+
+	FCortexReflectIndex& Reflect = FCortexReflectIndex::Get();
+	if (TableVersion != Reflect.GetVersion() && !PendingBuild.IsValid())
+	{
+		// Patch just the classes that changed; regather only when the log cannot say which,
+		// or when tombstones would make up a quarter of the table
+		TArray<FString> ChangedPaths;
+		if (Reflect.GetChangesSince(TableVersion, ChangedPaths)
+			&& (Table->NumRemoved() + ChangedPaths.Num()) * 4 <= Table->Num())
+		{
+			PatchTable(ChangedPaths);
+			TableVersion = Reflect.GetVersion();
+		}
+		else
+		{
+			StartBuild();
+		}
+	}
+
+	bOutStale = TableVersion != Reflect.GetVersion();
+	return Table;
+}
+
+void FCortexReflectSymbolIndex::CollectSymbols(TArray<FCortexReflectSymbol>& OutSymbols)
+{
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
+	TSet<FString> ProjectModules;
+
+	Index.ForEachClass([&](const FCortexReflectClassEntry& Entry)
+	{
+		if (Entry.IsProject() && !Entry.IsBlueprint())
+		{
+			ProjectModules.Add(GetScriptModuleName(Entry.Path));
+		}
+		CollectClassSymbols(Entry, OutSymbols);
+		return true;
+	});
+
+	for (TObjectIterator<UEnum> It; It; ++It)
+	{
+		if (IsValid(*It))
+		{
+			AddTypeSymbol(*It, ECortexSymbolKind::Enum, It->GetName(), ProjectModules, OutSymbols);
+		}
+	}
+
+	for (TObjectIterator<UScriptStruct> It; It; ++It)
+	{
+		if (IsValid(*It))
+		{
+			AddTypeSymbol(*It, ECortexSymbolKind::Struct, It->GetStructCPPName(), ProjectModules, OutSymbols);
+		}
+	}
+}
+
+void FCortexReflectSymbolIndex::CollectClassSymbols(const FCortexReflectClassEntry& Entry, TArray<FCortexReflectSymbol>& OutSymbols)
+{
+	if (IsShadowClassName(Entry.Name))
+	{
+		return;
+	}
+
+	FCortexReflectSymbol& ClassSymbol = OutSymbols.AddDefaulted_GetRef();
+	ClassSymbol.Kind = ECortexSymbolKind::Class;
+	ClassSymbol.Name = Entry.Name;
+	ClassSymbol.DisplayName = Entry.CppName;
+	ClassSymbol.Path = Entry.Path;
+	ClassSymbol.Module = Entry.Module;
+	ClassSymbol.Detail = Entry.AssetPath;
+	ClassSymbol.bProject = Entry.IsProject();
+	ClassSymbol.bBlueprint = Entry.IsBlueprint();
+	if (const FCortexReflectClassEntry* Super = FCortexReflectIndex::Get().GetSuper(Entry))
+	{
+		ClassSymbol.Parent = Super->CppName;
+	}
+
+	for (const FCortexReflectFunctionEntry& Function : Entry.Functions)
+	{
+		FCortexReflectSymbol& Symbol = OutSymbols.AddDefaulted_GetRef();
+		Symbol.Kind = ECortexSymbolKind::Function;
+		Symbol.Name = Function.Name;
+		Symbol.DisplayName = Function.Name;
+		Symbol.Owner = Entry.CppName;
+		Symbol.Path = Entry.Path;
+		Symbol.Module = Entry.Module;
+		Symbol.Detail = FormatSignature(Function);
+		Symbol.bProject = Entry.IsProject();
+		Symbol.bBlueprint = Entry.IsBlueprint();
+	}
+
+	for (const FCortexReflectPropertyEntry& Property : Entry.Properties)
+	{
+		FCortexReflectSymbol& Symbol = OutSymbols.AddDefaulted_GetRef();
+		Symbol.Kind = ECortexSymbolKind::Property;
+		Symbol.Name = Property.Name;
+		Symbol.DisplayName = Property.Name;
+		Symbol.Owner = Entry.CppName;
+		Symbol.Path = Entry.Path;
+		Symbol.Module = Entry.Module;
+		Symbol.Detail = Property.Type;
+		Symbol.bProject = Entry.IsProject();
+		Symbol.bBlueprint = Entry.IsBlueprint();
+	}
+}
+
+void FCortexReflectSymbolIndex::StartBuild()
+{
+	++FullBuildCount;
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FCortexReflectSymbol> Symbols;
+	CollectSymbols(Symbols);
+	PendingVersion = FCortexReflectIndex::Get().GetVersion();
+	const double GatherMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	PendingBuild = Async(EAsyncExecution::ThreadPool,
+		[Symbols = MoveTemp(Symbols), GatherMs]() mutable -> TSharedPtr<FCortexReflectSymbolTable>
+		{
+			const double BuildStart = FPlatformTime::Seconds();
+			TSharedRef<FCortexReflectSymbolTable> Built = FCortexReflectSymbolTable::Build(MoveTemp(Symbols));
+			UE_LOG(LogCortexReflect, Log,
+				TEXT("Symbol index built: %d symbols (gathered in %.1f ms, indexed in %.1f ms off the game thread)"),
+				Built->Num(), GatherMs, (FPlatformTime::Seconds() - BuildStart) * 1000.0);
+			return Built;
+		});
+}
+
+void FCortexReflectSymbolIndex::TakeFinishedBuild(bool bWait)
+{
+	if (!PendingBuild.IsValid() || (!bWait && !PendingBuild.IsReady()))
+	{
+		return;
+	}
+
+	Table = PendingBuild.Get();
+	TableVersion = PendingVersion;
+	PendingBuild.Reset();
+}
+
+void FCortexReflectSymbolIndex::PatchTable(const TArray<FString>& ChangedPaths)
+{
+	const FCortexReflectIndex& Reflect = FCortexReflectIndex::Get();
+	TArray<FCortexReflectSymbol> Symbols;
+	for (const FString& Path : ChangedPaths)
+	{
+		Table->RemovePath(Path);
+		if (const FCortexReflectClassEntry* Entry = Reflect.FindEntryByPath(Path))
+		{
+			CollectClassSymbols(*Entry, Symbols);
+		}
+	}
+	Table->Append(MoveTemp(Symbols));
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+struct FCortexReflectClassEntry;
+
+enum class ECortexSymbolKind : uint8
+{
+	Class,
+	Function,
+	Property,
+	Enum,
+	Struct,
+};
+
+/** One searchable name: a type, or a member of a class. */
+struct FCortexReflectSymbol
+{
+	/** Name matched against queries (UClass/UStruct names without the C++ prefix) */
+	FString Name;
+	/** Name as reported: the C++ name for types, the member name otherwise */
+	FString DisplayName;
+	/** Owning class C++ name (members only) */
+	FString Owner;
+	/** Class path for classes and members, type path for enums and structs */
+	FString Path;
+	/** Parent class C++ name (classes only) */
+	FString Parent;
+	FString Module;
+	/** Signature for functions, value type for properties, asset path for Blueprint classes */
+	FString Detail;
+	ECortexSymbolKind Kind = ECortexSymbolKind::Class;
+	bool bProject = false;
+	bool bBlueprint = false;
+};
+
+struct FCortexSymbolQuery
+{
+	FString Text;
+	/** Bit per ECortexSymbolKind */
+	uint8 KindMask = 0xFF;
+	bool bIncludeEngine = true;
+	/** Substring filter on the symbol's module */
+	FString ModuleFilter;
+	/** Symbols in this module rank higher (not a filter) */
+	FString PreferModule;
+	/** Finalists kept for full scoring; callers that filter further should raise it */
+	int32 MaxCandidates = 256;
+};
+
+struct FCortexSymbolMatch
+{
+	int32 SymbolId = INDEX_NONE;
+	float Score = 0.0f;
+};
+
+/**
+ * Fuzzy index over symbol names: camel-case/underscore token postings plus trigram
+ * postings over the lowercased name. A query touches only the postings of its own tokens
+ * and trigrams, keeps a bounded heap of the best cheap scores, and runs the full ranking
+ * (exact/prefix/substring, per-token exact/prefix/edit distance, whole-name edit distance,
+ * project and module locality) on those finalists alone.
+ * Symbol ids are stable: removed symbols are tombstoned and new ones appended.
+ * Built off the game thread; queried and patched on the game thread only.
+ */
+class FCortexReflectSymbolTable
+{
+public:
+	static TSharedRef<FCortexReflectSymbolTable> Build(TArray<FCortexReflectSymbol>&& InSymbols);
+
+	/** Best matches first. */
+	void Query(const FCortexSymbolQuery& InQuery, TArray<FCortexSymbolMatch>& OutMatches) const;
+
+	const FCortexReflectSymbol& GetSymbol(int32 SymbolId) const { return Symbols[SymbolId]; }
+	int32 Num() const { return Symbols.Num(); }
+	int32 NumRemoved() const { return RemovedCount; }
+
+	/** Index more symbols after the existing ones. */
+	void Append(TArray<FCortexReflectSymbol>&& InSymbols);
+
+	/** Tombstone every symbol whose Path is Path: a class and its members, or one type. */
+	void RemovePath(const FString& Path);
+
+	/** Lowercased camel-case / underscore / whitespace tokens, e.g. "K2_ApplyRadialDamage" -> k2, apply, radial, damage. */
+	static void SplitTokens(const FString& Text, TArray<FString>& OutTokens);
+
+	/** Levenshtein distance, or MaxDistance + 1 once it is exceeded. */
+	static int32 BoundedEditDistance(const FString& A, const FString& B, int32 MaxDistance);
+
+private:
+	TArray<FCortexReflectSymbol> Symbols;
+	TArray<FString> NamesLower;
+	TMap<FString, TArray<int32>> ByToken;
+	TMap<uint32, TArray<int32>> ByTrigram;
+	TMap<FString, TArray<int32>> ByPath;
+	TBitArray<> Removed;
+	int32 RemovedCount = 0;
+
+	/** Per-query accumulators, sized to Symbols and cleared through the touched list */
+	mutable TArray<uint16> TrigramHits;
+	mutable TArray<uint16> TokenMasks;
+	mutable TArray<int32> Touched;
+};
+
+/**
+ * Shared symbol table over every class, function and property in FCortexReflectIndex
+ * plus every enum and struct. The first build gathers on the game thread and tokenizes on
+ * the thread pool; only the very first query waits for it. After that, classes the
+ * reflection index reports as changed are patched into the table in place. A full rebuild
+ * runs only when the change log cannot answer or too much of the table is tombstoned, and
+ * a query arriving meanwhile is answered from the previous table and reports it as stale.
+ */
+class FCortexReflectSymbolIndex
+{
+public:
+	static FCortexReflectSymbolIndex& Get();
+
+	/** Start the first background build. */
+	static void Initialize();
+
+	/** Wait for any in-flight build and drop the table. */
+	static void Reset();
+
+	/** Current table, patched up to the reflection index's version when it moved on. */
+	TSharedPtr<const FCortexReflectSymbolTable> GetTable(bool& bOutStale);
+
+	/** Full gathers started so far; patches do not count. */
+	int32 GetFullBuildCount() const { return FullBuildCount; }
+
+	/** Game-thread snapshot of every searchable symbol. */
+	static void CollectSymbols(TArray<FCortexReflectSymbol>& OutSymbols);
+
+	/** Symbols for one class and its own functions and properties. */
+	static void CollectClassSymbols(const FCortexReflectClassEntry& Entry, TArray<FCortexReflectSymbol>& OutSymbols);
+
+private:
+	void StartBuild();
+	void TakeFinishedBuild(bool bWait);
+	void PatchTable(const TArray<FString>& ChangedPaths);
+
+	TSharedPtr<FCortexReflectSymbolTable> Table;
+	uint32 TableVersion = 0;
+	TFuture<TSharedPtr<FCortexReflectSymbolTable>> PendingBuild;
+	uint32 PendingVersion = 0;
+	int32 FullBuildCount = 0;
+
+	static TUniquePtr<FCortexReflectSymbolIndex> Instance;
+};
@@ -1,6 +1,8 @@
 #include "Operations/CortexReflectOps.h"
 #include "CortexReflectModule.h"
-#include "UObject/UObjectIterator.h"
+#include "CortexReflectIndex.h"
+#include "CortexReflectBlueprintTags.h"
+#include "CortexReflectSymbolIndex.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/SimpleConstructionScript.h"
@@ -8,12 +10,6 @@
 #include "GameFramework/Actor.h"
 #include "Components/ActorComponent.h"
 #include "Misc/PackageName.h"
-#include "K2Node_Variable.h"
-#include "K2Node_VariableGet.h"
-#include "K2Node_VariableSet.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_DynamicCast.h"
-#include "K2Node_SpawnActorFromClass.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "Modules/ModuleManager.h"
@@ -65,6 +61,74 @@ const TMap<FString, ECortexModuleOrigin>& GetPluginModuleOrigins()
 	static const TMap<FString, ECortexModuleOrigin> ModuleOrigins = BuildPluginModuleOrigins();
 	return ModuleOrigins;
 }
+
+/** Blueprint assets of every Blueprint type, sorted by package, with each generated class path mapped to its parent's. */
+void GatherBlueprintAssets(IAssetRegistry& AssetRegistry, TArray<FAssetData>& OutAssets, TMap<FString, FString>& OutParentByClassPath)
+{
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	AssetRegistry.GetAssets(Filter, OutAssets);
+	OutAssets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	for (const FAssetData& Asset : OutAssets)
+	{
+		FString ClassPath;
+		FString ParentPath;
+		if (Asset.GetTagValue(FBlueprintTags::GeneratedClassPath, ClassPath)
+			&& Asset.GetTagValue(FBlueprintTags::ParentClassPath, ParentPath))
+		{
+			OutParentByClassPath.Add(
+				FPackageName::ExportTextPathToObjectPath(ClassPath),
+				FPackageName::ExportTextPathToObjectPath(ParentPath));
+		}
+	}
+}
+
+FString GetGeneratedClassPath(const FAssetData& Asset)
+{
+	FString ClassPath;
+	Asset.GetTagValue(FBlueprintTags::GeneratedClassPath, ClassPath);
+	return FPackageName::ExportTextPathToObjectPath(ClassPath);
+}
+
+const UClass* GetNativeAncestor(const UClass* Class)
+{
+	while (Class && !Class->HasAnyClassFlags(CLASS_Native))
+	{
+		Class = Class->GetSuperClass();
+	}
+	return Class;
+}
+
+/** Cheap reject before walking parent tags: the asset's native parent must derive from NativeAncestor. */
+bool MayDeriveFrom(const FAssetData& Asset, const UClass* NativeAncestor)
+{
+	FString NativeParentPath;
+	if (!NativeAncestor || !Asset.GetTagValue(FBlueprintTags::NativeParentClassPath, NativeParentPath))
+	{
+		return true;
+	}
+	const UClass* NativeParent = FindObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(NativeParentPath));
+	return !NativeParent || NativeParent->IsChildOf(NativeAncestor);
+}
+
+TSharedPtr<FJsonObject> MakeNotScannedObject(const TArray<FString>& Paths)
+{
+	TArray<TSharedPtr<FJsonValue>> PathValues;
+	for (const FString& Path : Paths)
+	{
+		PathValues.Add(MakeShared<FJsonValueString>(Path));
+	}
+
+	TSharedPtr<FJsonObject> NotScannedObj = MakeShared<FJsonObject>();
+	NotScannedObj->SetNumberField(TEXT("count"), PathValues.Num());
+	NotScannedObj->SetArrayField(TEXT("paths"), PathValues);
+	return NotScannedObj;
+}
 }
 
 // Returns the full C++ name of a class (e.g. "AActor" not "Actor").
@@ -123,7 +187,7 @@ UClass* FCortexReflectOps::FindClassByName(const FString& ClassName, FCortexComm
 		return nullptr;
 	}
 
-	// 2. Resolve by name using TObjectIterator<UClass>.
+	// 2. Resolve by name through the reflection index (short-name map lookup).
 	//
 	//    UClass::GetName() returns the stripped name (e.g. "Actor" for AActor,
 	//    "Character" for ACharacter, "Object" for UObject).
@@ -150,33 +214,13 @@ UClass* FCortexReflectOps::FindClassByName(const FString& ClassName, FCortexComm
 	// The bare name is always a candidate (either the already-stripped form or the original)
 	StrippedCandidates.Add(ClassName);
 
-	// Single pass through all registered UClasses
-	TMap<FString, UClass*> Found;
-	for (TObjectIterator<UClass> It; It; ++It)
-	{
-		UClass* Candidate = *It;
-		if (!IsValid(Candidate))
-		{
-			continue;
-		}
-
-		const FString& ShortName = Candidate->GetName();
-		if (StrippedCandidates.Contains(ShortName) && !Found.Contains(ShortName))
-		{
-			Found.Add(ShortName, Candidate);
-			if (Found.Num() == StrippedCandidates.Num())
-			{
-				break;
-			}
-		}
-	}
-
 	// Return first match in priority order
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
 	for (const FString& Name : StrippedCandidates)
 	{
-		if (UClass** Result = Found.Find(Name))
+		if (UClass* Result = Index.FindClass(Name))
 		{
-			return *Result;
+			return Result;
 		}
 	}
 
@@ -473,41 +517,47 @@ void FCortexReflectOps::BuildHierarchyTree(
 	int32& OutProjectBPCount,
 	const TSet<UClass*>& EngineAncestorsOfProject)
 {
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
+	const FCortexReflectClassEntry* Entry = Index.FindEntry(Root);
 	OutNode = MakeShared<FJsonObject>();
-	OutNode->SetStringField(TEXT("name"), GetCppClassName(Root));
+	if (!Entry)
+	{
+		OutNode->SetStringField(TEXT("name"), GetCppClassName(Root));
+		OutNode->SetArrayField(TEXT("children"), TArray<TSharedPtr<FJsonValue>>());
+		return;
+	}
 
-	UBlueprintGeneratedClass* BPGC = Cast<UBlueprintGeneratedClass>(Root);
-	if (BPGC)
+	// Entry points into the index; everything needed from it is read before recursing
+	OutNode->SetStringField(TEXT("name"), Entry->CppName);
+
+	if (Entry->IsBlueprint())
 	{
 		OutNode->SetStringField(TEXT("type"), TEXT("blueprint"));
 		OutBPCount++;
-		if (IsProjectClass(Root))
+		if (Entry->IsProject())
 		{
 			OutProjectBPCount++;
 		}
-		UBlueprint* BP = Cast<UBlueprint>(BPGC->ClassGeneratedBy);
-		if (BP)
+		if (!Entry->AssetPath.IsEmpty())
 		{
-			OutNode->SetStringField(TEXT("asset_path"), BP->GetPathName());
+			OutNode->SetStringField(TEXT("asset_path"), Entry->AssetPath);
 		}
 	}
 	else
 	{
 		OutNode->SetStringField(TEXT("type"), TEXT("cpp"));
 		OutCppCount++;
-		if (IsProjectClass(Root))
+		if (Entry->IsProject())
 		{
 			OutProjectCppCount++;
 		}
-		const FString* ModName = Root->FindMetaData(TEXT("ModuleName"));
-		if (ModName)
+		if (!Entry->Module.IsEmpty())
 		{
-			OutNode->SetStringField(TEXT("module"), *ModName);
+			OutNode->SetStringField(TEXT("module"), Entry->Module);
 		}
-		FString SourcePath = Root->GetMetaData(TEXT("ModuleRelativePath"));
-		if (!SourcePath.IsEmpty())
+		if (!Entry->SourcePath.IsEmpty())
 		{
-			OutNode->SetStringField(TEXT("source_path"), SourcePath);
+			OutNode->SetStringField(TEXT("source_path"), Entry->SourcePath);
 		}
 	}
 	OutTotalCount++;
@@ -517,7 +567,7 @@ void FCortexReflectOps::BuildHierarchyTree(
 	if (CurrentDepth < MaxDepth && OutTotalCount < MaxResults)
 	{
 		TArray<UClass*> DirectChildren;
-		GetDerivedClasses(Root, DirectChildren, false);
+		Index.GetDerivedClasses(Root, DirectChildren, false);
 
 		for (UClass* Child : DirectChildren)
 		{
@@ -531,7 +581,7 @@ void FCortexReflectOps::BuildHierarchyTree(
 				continue;
 			}
 
-			if (!bIncludeEngine && !IsProjectClass(Child))
+			if (!bIncludeEngine && !Index.IsProjectClass(Child))
 			{
 				// Skip engine classes with no project descendants (O(1) lookup)
 				if (!EngineAncestorsOfProject.Contains(Child))
@@ -623,14 +673,15 @@ FCortexCommandResult FCortexReflectOps::ClassHierarchy(const TSharedPtr<FJsonObj
 	// Precompute which engine classes are ancestors of project classes.
 	// This allows BuildHierarchyTree to skip dead-end engine subtrees in O(1)
 	// instead of recursively visiting thousands of engine classes.
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
 	TSet<UClass*> EngineAncestorsOfProject;
 	if (!bIncludeEngine)
 	{
 		TArray<UClass*> AllDescendants;
-		GetDerivedClasses(RootClass, AllDescendants, true);
+		Index.GetDerivedClasses(RootClass, AllDescendants, true);
 		for (UClass* Desc : AllDescendants)
 		{
-			if (!IsProjectClass(Desc))
+			if (!Index.IsProjectClass(Desc))
 			{
 				continue;
 			}
@@ -641,7 +692,7 @@ FCortexCommandResult FCortexReflectOps::ClassHierarchy(const TSharedPtr<FJsonObj
 			// Walk parent chain, marking engine intermediaries
 			for (UClass* Anc = Desc->GetSuperClass(); Anc && Anc != RootClass; Anc = Anc->GetSuperClass())
 			{
-				if (!IsProjectClass(Anc))
+				if (!Index.IsProjectClass(Anc))
 				{
 					bool bAlreadyInSet = false;
 					EngineAncestorsOfProject.Add(Anc, &bAlreadyInSet);
@@ -672,7 +723,7 @@ FCortexCommandResult FCortexReflectOps::ClassHierarchy(const TSharedPtr<FJsonObj
 
 	// Keep the root node in the hierarchy for context, but in project-only mode
 	// exclude an engine root class from aggregate counts.
-	if (!bIncludeEngine && !IsProjectClass(RootClass))
+	if (!bIncludeEngine && !Index.IsProjectClass(RootClass))
 	{
 		TotalCount = FMath::Max(0, TotalCount - 1);
 		if (Cast<UBlueprintGeneratedClass>(RootClass))
@@ -936,17 +987,10 @@ FCortexCommandResult FCortexReflectOps::ClassDetail(const TSharedPtr<FJsonObject
 	}
 
 	// Blueprint children count
-	TArray<UClass*> DerivedClasses;
-	GetDerivedClasses(Class, DerivedClasses, false);
-	int32 BPChildCount = 0;
-	for (UClass* Derived : DerivedClasses)
-	{
-		if (Cast<UBlueprintGeneratedClass>(Derived))
-		{
-			BPChildCount++;
-		}
-	}
-	Result->SetNumberField(TEXT("blueprint_children_count"), BPChildCount);
+	Result->SetNumberField(
+		TEXT("blueprint_children_count"),
+		FCortexReflectIndex::Get().CountBlueprintChildren(Class)
+	);
 
 	return FCortexCommandRouter::Success(Result);
 }
@@ -984,12 +1028,82 @@ FCortexCommandResult FCortexReflectOps::FindOverrides(const TSharedPtr<FJsonObje
 		ParentFunctions.Add(It->GetFName());
 	}
 
-	TArray<UClass*> AllDerived;
-	GetDerivedClasses(ParentClass, AllDerived, true);
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> BlueprintAssets;
+	TMap<FString, FString> ParentByClassPath;
+	GatherBlueprintAssets(AssetRegistry, BlueprintAssets, ParentByClassPath);
 
 	TArray<TSharedPtr<FJsonValue>> ChildrenArray;
 	int32 TotalOverrides = 0;
+	int32 BlueprintsFromTags = 0;
 	TMap<FString, int32> OverrideCount;
+	TSet<FString> VisitedAssets;
+	TArray<FString> NotScannedPaths;
+
+	auto AddChild = [&](const FString& Name, const FString& AssetPath, const FCortexBlueprintSummary& Summary, const TCHAR* Source)
+	{
+		TSharedPtr<FJsonObject> ChildObj = MakeShared<FJsonObject>();
+		ChildObj->SetStringField(TEXT("name"), Name);
+		ChildObj->SetStringField(TEXT("type"), TEXT("blueprint"));
+		ChildObj->SetStringField(TEXT("asset_path"), AssetPath);
+		ChildObj->SetStringField(TEXT("source"), Source);
+
+		TArray<TSharedPtr<FJsonValue>> OverriddenFuncs;
+		TArray<TSharedPtr<FJsonValue>> OverriddenEvents;
+		TArray<TSharedPtr<FJsonValue>> CustomFuncs;
+		TArray<TSharedPtr<FJsonValue>> CustomVars;
+
+		for (const FCortexBlueprintFunctionInfo& Func : Summary.Functions)
+		{
+			const FName FuncName(*Func.Name);
+			if (ParentFunctions.Contains(FuncName))
+			{
+				// Find which ancestor declares this function via GetOwnerClass()
+				UFunction* DeclaredFunc = ParentClass->FindFunctionByName(FuncName);
+				FString DefinedIn = DeclaredFunc
+					? DeclaredFunc->GetOwnerClass()->GetName()
+					: ParentClass->GetName();
+
+				TSharedPtr<FJsonObject> OverrideEntry = MakeShared<FJsonObject>();
+				OverrideEntry->SetStringField(TEXT("name"), Func.Name);
+				OverrideEntry->SetStringField(TEXT("defined_in"), DefinedIn);
+
+				if (Func.bEvent)
+				{
+					OverriddenEvents.Add(MakeShared<FJsonValueObject>(OverrideEntry));
+				}
+				else
+				{
+					OverriddenFuncs.Add(MakeShared<FJsonValueObject>(OverrideEntry));
+				}
+				TotalOverrides++;
+
+				int32& Count = OverrideCount.FindOrAdd(Func.Name);
+				Count++;
+			}
+			else
+			{
+				CustomFuncs.Add(MakeShared<FJsonValueString>(Func.Name));
+			}
+		}
+
+		for (const FString& Variable : Summary.Variables)
+		{
+			CustomVars.Add(MakeShared<FJsonValueString>(Variable));
+		}
+
+		ChildObj->SetArrayField(TEXT("overridden_functions"), OverriddenFuncs);
+		ChildObj->SetArrayField(TEXT("overridden_events"), OverriddenEvents);
+		ChildObj->SetArrayField(TEXT("custom_functions"), CustomFuncs);
+		ChildObj->SetArrayField(TEXT("custom_variables"), CustomVars);
+
+		ChildrenArray.Add(MakeShared<FJsonValueObject>(ChildObj));
+	};
+
+	// Loaded Blueprints first: they answer live, including unsaved edits and unsaved assets
+	TArray<UClass*> AllDerived;
+	FCortexReflectIndex::Get().GetDerivedClasses(ParentClass, AllDerived, true);
 
 	for (UClass* DerivedClass : AllDerived)
 	{
@@ -1024,75 +1138,48 @@ FCortexCommandResult FCortexReflectOps::FindOverrides(const TSharedPtr<FJsonObje
 		}
 
 		UBlueprint* BP = Cast<UBlueprint>(BPGC->ClassGeneratedBy);
-		if (!BP)
+		if (!BP || BP->GeneratedClass != DerivedClass)
 		{
 			continue;
 		}
 
-		TSharedPtr<FJsonObject> ChildObj = MakeShared<FJsonObject>();
-		ChildObj->SetStringField(TEXT("name"), BP->GetName());
-		ChildObj->SetStringField(TEXT("type"), TEXT("blueprint"));
-
-		TArray<TSharedPtr<FJsonValue>> OverriddenFuncs;
-		TArray<TSharedPtr<FJsonValue>> OverriddenEvents;
-		TArray<TSharedPtr<FJsonValue>> CustomFuncs;
-		TArray<TSharedPtr<FJsonValue>> CustomVars;
+		VisitedAssets.Add(BP->GetPathName());
+		FCortexBlueprintSummary Summary;
+		FCortexReflectBlueprintTags::Describe(BP, Summary);
+		AddChild(BP->GetName(), BP->GetPathName(), Summary, TEXT("loaded"));
+	}
 
-		// Use GetOwnerClass() filter for own-class functions
-		for (TFieldIterator<UFunction> It(DerivedClass); It; ++It)
+	// Unloaded Blueprints answer from the tags written when they were saved
+	const UClass* NativeAncestor = GetNativeAncestor(ParentClass);
+	for (const FAssetData& Asset : BlueprintAssets)
+	{
+		if (ChildrenArray.Num() >= Limit)
 		{
-			const UFunction* Func = *It;
-			if (Func->GetOwnerClass() != DerivedClass)
-			{
-				continue;
-			}
-
-			if (ParentFunctions.Contains(Func->GetFName()))
-			{
-				// Find which ancestor declares this function via GetOwnerClass()
-				UFunction* DeclaredFunc = ParentClass->FindFunctionByName(Func->GetFName());
-				FString DefinedIn = DeclaredFunc
-					? DeclaredFunc->GetOwnerClass()->GetName()
-					: ParentClass->GetName();
-
-				TSharedPtr<FJsonObject> OverrideEntry = MakeShared<FJsonObject>();
-				OverrideEntry->SetStringField(TEXT("name"), Func->GetName());
-				OverrideEntry->SetStringField(TEXT("defined_in"), DefinedIn);
-
-				if (Func->HasAnyFunctionFlags(FUNC_BlueprintEvent))
-				{
-					OverriddenEvents.Add(MakeShared<FJsonValueObject>(OverrideEntry));
-				}
-				else
-				{
-					OverriddenFuncs.Add(MakeShared<FJsonValueObject>(OverrideEntry));
-				}
-				TotalOverrides++;
+			break;
+		}
 
-				int32& Count = OverrideCount.FindOrAdd(Func->GetName());
-				Count++;
-			}
-			else
-			{
-				CustomFuncs.Add(MakeShared<FJsonValueString>(Func->GetName()));
-			}
+		const FString AssetPath = Asset.GetObjectPathString();
+		if (VisitedAssets.Contains(AssetPath) || Asset.FastGetAsset(false) || !MayDeriveFrom(Asset, NativeAncestor))
+		{
+			continue;
 		}
 
-		// Custom variables (own class only)
-		for (TFieldIterator<FProperty> It(DerivedClass); It; ++It)
+		const int32 ClassDepth = FCortexReflectBlueprintTags::GetInheritanceDepth(
+			GetGeneratedClassPath(Asset), ParentClass, ParentByClassPath);
+		if (ClassDepth <= 0 || ClassDepth > Depth)
 		{
-			if (It->GetOwnerClass() == DerivedClass && !It->HasAnyPropertyFlags(CPF_Parm))
-			{
-				CustomVars.Add(MakeShared<FJsonValueString>(It->GetName()));
-			}
+			continue;
 		}
 
-		ChildObj->SetArrayField(TEXT("overridden_functions"), OverriddenFuncs);
-		ChildObj->SetArrayField(TEXT("overridden_events"), OverriddenEvents);
-		ChildObj->SetArrayField(TEXT("custom_functions"), CustomFuncs);
-		ChildObj->SetArrayField(TEXT("custom_variables"), CustomVars);
+		FCortexBlueprintSummary Summary;
+		if (!FCortexReflectBlueprintTags::ReadTags(Asset, Summary))
+		{
+			NotScannedPaths.Add(AssetPath);
+			continue;
+		}
 
-		ChildrenArray.Add(MakeShared<FJsonValueObject>(ChildObj));
+		BlueprintsFromTags++;
+		AddChild(Asset.AssetName.ToString(), AssetPath, Summary, TEXT("tags"));
 	}
 
 	// Find most overridden function
@@ -1111,6 +1198,8 @@ FCortexCommandResult FCortexReflectOps::FindOverrides(const TSharedPtr<FJsonObje
 	Result->SetStringField(TEXT("class_name"), GetCppClassName(ParentClass));
 	Result->SetArrayField(TEXT("children"), ChildrenArray);
 	Result->SetNumberField(TEXT("total_overrides"), TotalOverrides);
+	Result->SetNumberField(TEXT("blueprints_from_tags"), BlueprintsFromTags);
+	Result->SetObjectField(TEXT("not_scanned"), MakeNotScannedObject(NotScannedPaths));
 	if (!MostOverridden.IsEmpty())
 	{
 		Result->SetStringField(TEXT("most_overridden"), MostOverridden);
@@ -1170,389 +1259,205 @@ FCortexCommandResult FCortexReflectOps::FindUsages(const TSharedPtr<FJsonObject>
 	bool bDeepScan = false;
 	Params->TryGetBoolField(TEXT("deep_scan"), bDeepScan);
 
+	bool bVerify = false;
+	Params->TryGetBoolField(TEXT("verify"), bVerify);
+
 	FString PathFilter;
 	Params->TryGetStringField(TEXT("path_filter"), PathFilter);
 
 	int32 Limit = 20;
 	Params->TryGetNumberField(TEXT("limit"), Limit);
 
-	int32 MaxBlueprints = 50;
-	Params->TryGetNumberField(TEXT("max_blueprints"), MaxBlueprints);
-	if (MaxBlueprints <= 0)
-	{
-		MaxBlueprints = 50;
-	}
-
 	IAssetRegistry& AssetRegistry =
 		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> BlueprintAssets;
+	TMap<FString, FString> ParentByClassPath;
+	GatherBlueprintAssets(AssetRegistry, BlueprintAssets, ParentByClassPath);
 
-	TMap<FString, UBlueprint*> LoadedBlueprintsByPath;
-	TMap<FString, FString> UnloadedBlueprintObjectPaths;
-
-	auto AddLoadedBlueprint = [&LoadedBlueprintsByPath, &PathFilter](UBlueprint* Blueprint)
+	// Untagged assets can only be found through the package referencers, as before tags existed
+	TSet<FName> ReferencerPackages;
+	if (Scope == TEXT("all"))
 	{
-		if (!Blueprint)
-		{
-			return;
-		}
-
-		const FString AssetPath = Blueprint->GetPathName();
-		if (!PathFilter.IsEmpty() && !AssetPath.StartsWith(PathFilter))
+		TArray<FAssetDependency> Referencers;
+		AssetRegistry.GetReferencers(
+			FAssetIdentifier(OwnerClass->GetOutermost()->GetFName()),
+			Referencers,
+			UE::AssetRegistry::EDependencyCategory::Package
+		);
+		for (const FAssetDependency& Referencer : Referencers)
 		{
-			return;
+			ReferencerPackages.Add(Referencer.AssetId.PackageName);
 		}
+	}
 
-		LoadedBlueprintsByPath.FindOrAdd(AssetPath, Blueprint);
-	};
-
-	auto AddBlueprintAsset = [
-		&LoadedBlueprintsByPath,
-		&UnloadedBlueprintObjectPaths,
-		&PathFilter
-	](const FAssetData& Asset)
+	TMap<FString, bool> DerivesFromOwner;
+	auto IsOwnerOrDerived = [&DerivesFromOwner, &ParentByClassPath, OwnerClass](const FString& ClassPath)
 	{
-		if (!Asset.IsValid())
+		if (const bool* Cached = DerivesFromOwner.Find(ClassPath))
 		{
-			return;
+			return *Cached;
 		}
-
-		if (Asset.AssetClassPath != UBlueprint::StaticClass()->GetClassPathName())
-		{
-			return;
-		}
-
-		const FString PackagePath = Asset.PackageName.ToString();
-		if (!PathFilter.IsEmpty() && !PackagePath.StartsWith(PathFilter))
-		{
-			return;
-		}
-
-		const FString ObjectPath = Asset.GetSoftObjectPath().ToString();
-		UBlueprint* LoadedBlueprint = FindObject<UBlueprint>(nullptr, *ObjectPath);
-		if (LoadedBlueprint)
-		{
-			LoadedBlueprintsByPath.FindOrAdd(LoadedBlueprint->GetPathName(), LoadedBlueprint);
-			return;
-		}
-
-		UnloadedBlueprintObjectPaths.FindOrAdd(PackagePath, ObjectPath);
+		const bool bDerives = FCortexReflectBlueprintTags::GetInheritanceDepth(ClassPath, OwnerClass, ParentByClassPath) != INDEX_NONE;
+		DerivesFromOwner.Add(ClassPath, bDerives);
+		return bDerives;
 	};
 
-	if (Scope == TEXT("derived"))
+	auto CollectReferences = [&](const FCortexBlueprintSummary& Summary)
 	{
-		// Existing behavior: derive from owner class then enrich with Asset Registry candidates.
-		TArray<UClass*> DerivedClasses;
-		GetDerivedClasses(OwnerClass, DerivedClasses, true);
-		for (UClass* DerivedClass : DerivedClasses)
-		{
-			if (UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(DerivedClass))
-			{
-				AddLoadedBlueprint(Cast<UBlueprint>(BlueprintClass->ClassGeneratedBy));
-			}
-		}
-
-		FARFilter Filter;
-		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-		Filter.bRecursiveClasses = true;
-		if (!PathFilter.IsEmpty())
-		{
-			Filter.PackagePaths.Add(FName(*PathFilter));
-			Filter.bRecursivePaths = true;
-		}
-
-		TArray<FAssetData> Assets;
-		AssetRegistry.GetAssets(Filter, Assets);
-		for (const FAssetData& Asset : Assets)
+		TArray<TSharedPtr<FJsonValue>> ReferenceResults;
+		for (const FCortexBlueprintReference& Reference : Summary.References)
 		{
-			const FAssetTagValueRef ParentTag = Asset.TagsAndValues.FindTag("NativeParentClass");
-			if (!ParentTag.IsSet())
+			// Member names are only unique per class, so the declaring class must be the owner or derive from it
+			bool bMatches = false;
+			if (Reference.Type == TEXT("read") || Reference.Type == TEXT("write"))
 			{
-				continue;
-			}
-
-			const FString NativeParentPath = ParentTag.AsString();
-			UClass* NativeParent = FindObject<UClass>(nullptr, *NativeParentPath);
-			if (NativeParent && NativeParent->IsChildOf(OwnerClass))
-			{
-				AddBlueprintAsset(Asset);
+				bMatches = bIsProperty
+					&& Reference.Target.Equals(SymbolName, ESearchCase::IgnoreCase)
+					&& !Reference.Owner.IsEmpty()
+					&& IsOwnerOrDerived(Reference.Owner);
 			}
-		}
-	}
-	else
-	{
-		// Expanded behavior: scan all Blueprint packages that reference the owner class package.
-		const FString OwnerPackagePath = OwnerClass->GetOutermost()->GetName();
-		TArray<FAssetDependency> Referencers;
-		AssetRegistry.GetReferencers(
-			FAssetIdentifier(FName(*OwnerPackagePath)),
-			Referencers,
-			UE::AssetRegistry::EDependencyCategory::Package
-		);
-
-		for (const FAssetDependency& Referencer : Referencers)
-		{
-			const FString ReferencerPackagePath = Referencer.AssetId.PackageName.ToString();
-			if (ReferencerPackagePath.IsEmpty())
+			else if (Reference.Type == TEXT("call"))
 			{
-				continue;
+				bMatches = bIsFunction
+					&& Reference.Target.Equals(SymbolName, ESearchCase::IgnoreCase)
+					&& !Reference.Owner.IsEmpty()
+					&& IsOwnerOrDerived(Reference.Owner);
 			}
-
-			TArray<FAssetData> AssetsInPackage;
-			AssetRegistry.GetAssetsByPackageName(FName(*ReferencerPackagePath), AssetsInPackage, true);
-			for (const FAssetData& PackageAsset : AssetsInPackage)
+			else
 			{
-				AddBlueprintAsset(PackageAsset);
+				bMatches = IsOwnerOrDerived(Reference.Target);
 			}
-		}
 
-		// Keep loaded child blueprints in candidate set even if referencer tags are incomplete.
-		TArray<UClass*> DerivedClasses;
-		GetDerivedClasses(OwnerClass, DerivedClasses, true);
-		for (UClass* DerivedClass : DerivedClasses)
-		{
-			if (UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(DerivedClass))
+			if (bMatches)
 			{
-				AddLoadedBlueprint(Cast<UBlueprint>(BlueprintClass->ClassGeneratedBy));
+				TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
+				RefObj->SetStringField(TEXT("context"), Reference.Context);
+				RefObj->SetStringField(TEXT("type"), Reference.Type);
+				RefObj->SetStringField(TEXT("node_class"), FCortexReflectBlueprintTags::GetNodeClassName(Reference.Type));
+				ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
 			}
 		}
-	}
+		return ReferenceResults;
+	};
 
 	TArray<TSharedPtr<FJsonValue>> UsagesArray;
 	int32 TotalUsages = 0;
 	int32 BlueprintsScanned = 0;
-	TSet<FString> NotScannedPathSet;
+	int32 BlueprintsFromTags = 0;
+	TSet<FString> VisitedAssets;
+	TArray<FString> NotScannedPaths;
 
-	auto AddNotScannedPath = [&NotScannedPathSet](const FString& AssetPath)
+	auto AddUsage = [&](const FString& Name, const FString& AssetPath, const TArray<TSharedPtr<FJsonValue>>& ReferencesArray, const TCHAR* Source)
 	{
-		if (!AssetPath.IsEmpty())
+		if (ReferencesArray.Num() > 0 && UsagesArray.Num() < Limit)
 		{
-			NotScannedPathSet.Add(AssetPath);
+			TSharedPtr<FJsonObject> UsageObj = MakeShared<FJsonObject>();
+			UsageObj->SetStringField(TEXT("class_name"), Name);
+			UsageObj->SetStringField(TEXT("asset_path"), AssetPath);
+			UsageObj->SetStringField(TEXT("source"), Source);
+			UsageObj->SetArrayField(TEXT("references"), ReferencesArray);
+			UsageObj->SetNumberField(TEXT("total_count"), ReferencesArray.Num());
+			UsagesArray.Add(MakeShared<FJsonValueObject>(UsageObj));
+			TotalUsages += ReferencesArray.Num();
 		}
 	};
 
-	auto ScanBlueprintForUsages = [
-		OwnerClass,
-		bIsProperty,
-		bIsFunction,
-		SymbolFName
-	](UBlueprint* Blueprint)
+	auto ScanLoaded = [&](UBlueprint* Blueprint, const TCHAR* Source)
 	{
-		TArray<TSharedPtr<FJsonValue>> ReferenceResults;
-		if (!Blueprint)
-		{
-			return ReferenceResults;
-		}
-
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
-
-		for (UEdGraph* Graph : AllGraphs)
-		{
-			if (!Graph)
-			{
-				continue;
-			}
-
-			for (UEdGraphNode* Node : Graph->Nodes)
-			{
-				if (!Node)
-				{
-					continue;
-				}
-
-				if (bIsProperty)
-				{
-					UK2Node_Variable* VarNode = Cast<UK2Node_Variable>(Node);
-					if (VarNode && VarNode->VariableReference.GetMemberName() == SymbolFName)
-					{
-						TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
-						RefObj->SetStringField(TEXT("context"), Graph->GetName());
-
-						if (VarNode->IsA<UK2Node_VariableGet>())
-						{
-							RefObj->SetStringField(TEXT("type"), TEXT("read"));
-							RefObj->SetStringField(TEXT("node_class"), TEXT("UK2Node_VariableGet"));
-							ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-						}
-						else if (VarNode->IsA<UK2Node_VariableSet>())
-						{
-							RefObj->SetStringField(TEXT("type"), TEXT("write"));
-							RefObj->SetStringField(TEXT("node_class"), TEXT("UK2Node_VariableSet"));
-							ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-						}
-					}
-				}
-
-				if (bIsFunction)
-				{
-					UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
-					if (CallNode && CallNode->FunctionReference.GetMemberName() == SymbolFName)
-					{
-						TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
-						RefObj->SetStringField(TEXT("context"), Graph->GetName());
-						RefObj->SetStringField(TEXT("type"), TEXT("call"));
-						RefObj->SetStringField(TEXT("node_class"), TEXT("UK2Node_CallFunction"));
-						ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-					}
-				}
-
-				UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node);
-				if (CastNode && CastNode->TargetType && CastNode->TargetType->IsChildOf(OwnerClass))
-				{
-					TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
-					RefObj->SetStringField(TEXT("context"), Graph->GetName());
-					RefObj->SetStringField(TEXT("type"), TEXT("cast"));
-					RefObj->SetStringField(TEXT("node_class"), TEXT("UK2Node_DynamicCast"));
-					ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-				}
-
-				UK2Node_SpawnActorFromClass* SpawnNode = Cast<UK2Node_SpawnActorFromClass>(Node);
-				if (SpawnNode)
-				{
-					UEdGraphPin* ClassPin = SpawnNode->GetClassPin();
-					if (ClassPin && ClassPin->DefaultObject)
-					{
-						UClass* SpawnClass = Cast<UClass>(ClassPin->DefaultObject);
-						if (SpawnClass && SpawnClass->IsChildOf(OwnerClass))
-						{
-							TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
-							RefObj->SetStringField(TEXT("context"), Graph->GetName());
-							RefObj->SetStringField(TEXT("type"), TEXT("spawn"));
-							RefObj->SetStringField(TEXT("node_class"), TEXT("UK2Node_SpawnActorFromClass"));
-							ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-						}
-					}
-				}
-			}
-		}
-
-		if (USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript)
-		{
-			for (USCS_Node* SCSNode : SCS->GetAllNodes())
-			{
-				if (!SCSNode || !SCSNode->ComponentClass)
-				{
-					continue;
-				}
-
-				if (SCSNode->ComponentClass->IsChildOf(OwnerClass))
-				{
-					TSharedPtr<FJsonObject> RefObj = MakeShared<FJsonObject>();
-					RefObj->SetStringField(TEXT("context"), TEXT("SimpleConstructionScript"));
-					RefObj->SetStringField(TEXT("type"), TEXT("component"));
-					RefObj->SetStringField(TEXT("node_class"), TEXT("USCS_Node"));
-					ReferenceResults.Add(MakeShared<FJsonValueObject>(RefObj));
-				}
-			}
-		}
-
-		return ReferenceResults;
+		FCortexBlueprintSummary Summary;
+		FCortexReflectBlueprintTags::Describe(Blueprint, Summary);
+		BlueprintsScanned++;
+		AddUsage(Blueprint->GetName(), Blueprint->GetPathName(), CollectReferences(Summary), Source);
 	};
 
-	TArray<FString> LoadedPaths;
-	LoadedBlueprintsByPath.GetKeys(LoadedPaths);
-	LoadedPaths.Sort();
-
-	for (const FString& LoadedPath : LoadedPaths)
+	// Loaded Blueprints not in the registry yet (never saved) are only reachable through the class tree
+	TArray<UClass*> DerivedClasses;
+	FCortexReflectIndex::Get().GetDerivedClasses(OwnerClass, DerivedClasses, true);
+	for (UClass* DerivedClass : DerivedClasses)
 	{
-		if (BlueprintsScanned >= MaxBlueprints)
+		UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(DerivedClass);
+		UBlueprint* Blueprint = BlueprintClass ? Cast<UBlueprint>(BlueprintClass->ClassGeneratedBy) : nullptr;
+		if (!Blueprint || Blueprint->GeneratedClass != DerivedClass)
 		{
-			AddNotScannedPath(LoadedPath);
 			continue;
 		}
 
-		UBlueprint* Blueprint = nullptr;
-		if (UBlueprint** FoundBlueprint = LoadedBlueprintsByPath.Find(LoadedPath))
+		const FString AssetPath = Blueprint->GetPathName();
+		if ((!PathFilter.IsEmpty() && !AssetPath.StartsWith(PathFilter)) || VisitedAssets.Contains(AssetPath))
 		{
-			Blueprint = *FoundBlueprint;
+			continue;
 		}
+		VisitedAssets.Add(AssetPath);
+		ScanLoaded(Blueprint, TEXT("loaded"));
+	}
 
-		if (!Blueprint)
+	const UClass* NativeAncestor = GetNativeAncestor(OwnerClass);
+	for (const FAssetData& Asset : BlueprintAssets)
+	{
+		const FString AssetPath = Asset.GetObjectPathString();
+		if ((!PathFilter.IsEmpty() && !Asset.PackageName.ToString().StartsWith(PathFilter)) || VisitedAssets.Contains(AssetPath))
 		{
-			AddNotScannedPath(LoadedPath);
 			continue;
 		}
 
-		TArray<TSharedPtr<FJsonValue>> ReferencesArray = ScanBlueprintForUsages(Blueprint);
-		BlueprintsScanned++;
-
-		if (ReferencesArray.Num() > 0 && UsagesArray.Num() < Limit)
+		if (Scope == TEXT("derived")
+			&& (!MayDeriveFrom(Asset, NativeAncestor)
+				|| FCortexReflectBlueprintTags::GetInheritanceDepth(GetGeneratedClassPath(Asset), OwnerClass, ParentByClassPath) == INDEX_NONE))
 		{
-			TSharedPtr<FJsonObject> UsageObj = MakeShared<FJsonObject>();
-			UsageObj->SetStringField(TEXT("class_name"), Blueprint->GetName());
-			UsageObj->SetStringField(TEXT("asset_path"), Blueprint->GetPathName());
-			UsageObj->SetArrayField(TEXT("references"), ReferencesArray);
-			UsageObj->SetNumberField(TEXT("total_count"), ReferencesArray.Num());
-			UsagesArray.Add(MakeShared<FJsonValueObject>(UsageObj));
-			TotalUsages += ReferencesArray.Num();
+			continue;
 		}
-	}
 
-	TArray<FString> UnloadedPackagePaths;
-	UnloadedBlueprintObjectPaths.GetKeys(UnloadedPackagePaths);
-	UnloadedPackagePaths.Sort();
+		FCortexBlueprintSummary Summary;
+		const bool bTagged = FCortexReflectBlueprintTags::ReadTags(Asset, Summary);
 
-	for (const FString& PackagePath : UnloadedPackagePaths)
-	{
-		if (BlueprintsScanned >= MaxBlueprints)
+		// Loaded Blueprints with unsaved edits, or saved before tags existed, answer live
+		UBlueprint* LoadedBlueprint = Cast<UBlueprint>(Asset.FastGetAsset(false));
+		if (LoadedBlueprint && (!bTagged || LoadedBlueprint->GetPackage()->IsDirty()))
 		{
-			AddNotScannedPath(PackagePath);
+			ScanLoaded(LoadedBlueprint, TEXT("loaded"));
 			continue;
 		}
 
-		const FString* ObjectPath = UnloadedBlueprintObjectPaths.Find(PackagePath);
-		if (!ObjectPath)
+		if (bTagged)
 		{
-			AddNotScannedPath(PackagePath);
+			BlueprintsScanned++;
+			BlueprintsFromTags++;
+			TArray<TSharedPtr<FJsonValue>> ReferencesArray = CollectReferences(Summary);
+			if (ReferencesArray.Num() > 0 && bVerify && UsagesArray.Num() < Limit)
+			{
+				// Confirm a tag hit against the asset itself
+				if (UBlueprint* VerifiedBlueprint = Cast<UBlueprint>(Asset.GetAsset()))
+				{
+					BlueprintsFromTags--;
+					BlueprintsScanned--;
+					ScanLoaded(VerifiedBlueprint, TEXT("verified"));
+					continue;
+				}
+			}
+			AddUsage(Asset.AssetName.ToString(), AssetPath, ReferencesArray, TEXT("tags"));
 			continue;
 		}
 
-		if (!bDeepScan)
+		// Untagged (saved before tags existed): only referencers are candidates, and only deep_scan loads them
+		if (Scope == TEXT("all") && !ReferencerPackages.Contains(Asset.PackageName))
 		{
-			AddNotScannedPath(PackagePath);
 			continue;
 		}
-
-		const FString LoadPackagePath = FPackageName::ObjectPathToPackageName(*ObjectPath);
-		if (!FindPackage(nullptr, *LoadPackagePath) && !FPackageName::DoesPackageExist(LoadPackagePath))
+		if (!bDeepScan)
 		{
-			AddNotScannedPath(PackagePath);
+			NotScannedPaths.Add(Asset.PackageName.ToString());
 			continue;
 		}
 
-		UBlueprint* LoadedBlueprint = LoadObject<UBlueprint>(nullptr, *(*ObjectPath));
-		if (!LoadedBlueprint)
+		UBlueprint* DeepScanBlueprint = Cast<UBlueprint>(Asset.GetAsset());
+		if (!DeepScanBlueprint)
 		{
-			AddNotScannedPath(PackagePath);
+			NotScannedPaths.Add(Asset.PackageName.ToString());
 			continue;
 		}
-
-		TArray<TSharedPtr<FJsonValue>> ReferencesArray = ScanBlueprintForUsages(LoadedBlueprint);
-		BlueprintsScanned++;
-
-		if (ReferencesArray.Num() > 0 && UsagesArray.Num() < Limit)
-		{
-			TSharedPtr<FJsonObject> UsageObj = MakeShared<FJsonObject>();
-			UsageObj->SetStringField(TEXT("class_name"), LoadedBlueprint->GetName());
-			UsageObj->SetStringField(TEXT("asset_path"), LoadedBlueprint->GetPathName());
-			UsageObj->SetArrayField(TEXT("references"), ReferencesArray);
-			UsageObj->SetNumberField(TEXT("total_count"), ReferencesArray.Num());
-
-			UsagesArray.Add(MakeShared<FJsonValueObject>(UsageObj));
-			TotalUsages += ReferencesArray.Num();
-		}
-	}
-
-	TArray<TSharedPtr<FJsonValue>> NotScannedPaths;
-	for (const FString& NotScannedPath : NotScannedPathSet)
-	{
-		NotScannedPaths.Add(MakeShared<FJsonValueString>(NotScannedPath));
+		ScanLoaded(DeepScanBlueprint, TEXT("loaded"));
 	}
 
-	TSharedPtr<FJsonObject> NotScannedObj = MakeShared<FJsonObject>();
-	NotScannedObj->SetNumberField(TEXT("count"), NotScannedPaths.Num());
-	NotScannedObj->SetArrayField(TEXT("paths"), NotScannedPaths);
-
 	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetStringField(TEXT("symbol"), SymbolName);
 	Result->SetStringField(TEXT("defined_in"), OwnerClass->GetName());
@@ -1561,7 +1466,8 @@ FCortexCommandResult FCortexReflectOps::FindUsages(const TSharedPtr<FJsonObject>
 	Result->SetStringField(TEXT("symbol_type"), SymbolType);
 	Result->SetStringField(TEXT("scope"), Scope);
 	Result->SetNumberField(TEXT("blueprints_scanned"), BlueprintsScanned);
-	Result->SetObjectField(TEXT("not_scanned"), NotScannedObj);
+	Result->SetNumberField(TEXT("blueprints_from_tags"), BlueprintsFromTags);
+	Result->SetObjectField(TEXT("not_scanned"), MakeNotScannedObject(NotScannedPaths));
 	Result->SetArrayField(TEXT("usages"), UsagesArray);
 	Result->SetNumberField(TEXT("total_usages"), TotalUsages);
 	Result->SetNumberField(TEXT("total_classes"), UsagesArray.Num());
@@ -1767,113 +1673,167 @@ FCortexCommandResult FCortexReflectOps::Search(const TSharedPtr<FJsonObject>& Pa
 	FString TypeFilter;
 	Params->TryGetStringField(TEXT("type_filter"), TypeFilter);
 
-	FString ModuleFilter;
-	Params->TryGetStringField(TEXT("module_filter"), ModuleFilter);
+	FCortexSymbolQuery Query;
+	Query.Text = Pattern;
+	Params->TryGetStringField(TEXT("module_filter"), Query.ModuleFilter);
+	Params->TryGetStringField(TEXT("prefer_module"), Query.PreferModule);
 
 	bool bIncludeEngine = false;
 	Params->TryGetBoolField(TEXT("include_engine"), bIncludeEngine);
+	Query.bIncludeEngine = bIncludeEngine;
 
 	int32 Limit = 50;
 	Params->TryGetNumberField(TEXT("limit"), Limit);
+	Limit = FMath::Max(1, Limit);
 
-	UClass* TypeFilterClass = nullptr;
-	if (!TypeFilter.IsEmpty())
+	// kinds: array or comma-separated string of class/function/property/enum/struct
+	TArray<FString> KindNames;
+	const TArray<TSharedPtr<FJsonValue>>* KindsArray = nullptr;
+	FString KindsString;
+	if (Params->TryGetArrayField(TEXT("kinds"), KindsArray))
 	{
-		FCortexCommandResult FindError;
-		TypeFilterClass = FindClassByName(TypeFilter, FindError);
-		if (!TypeFilterClass)
+		for (const TSharedPtr<FJsonValue>& Value : *KindsArray)
 		{
-			return FindError;
+			KindNames.Add(Value.IsValid() ? Value->AsString() : FString());
 		}
 	}
+	else if (Params->TryGetStringField(TEXT("kinds"), KindsString))
+	{
+		KindsString.ParseIntoArray(KindNames, TEXT(","), true);
+	}
 
-	TArray<TSharedPtr<FJsonValue>> ResultsArray;
-
-	for (TObjectIterator<UClass> It; It; ++It)
+	static const TCHAR* KindLabels[] = { TEXT("class"), TEXT("function"), TEXT("property"), TEXT("enum"), TEXT("struct") };
+	if (KindNames.Num() > 0)
 	{
-		UClass* Class = *It;
-		if (!Class)
+		Query.KindMask = 0;
+		for (const FString& KindName : KindNames)
 		{
-			continue;
+			const FString Trimmed = KindName.TrimStartAndEnd();
+			int32 KindIndex = INDEX_NONE;
+			for (int32 LabelIndex = 0; LabelIndex < UE_ARRAY_COUNT(KindLabels); ++LabelIndex)
+			{
+				if (Trimmed.Equals(KindLabels[LabelIndex], ESearchCase::IgnoreCase))
+				{
+					KindIndex = LabelIndex;
+					break;
+				}
+			}
+			if (KindIndex == INDEX_NONE)
+			{
+				return FCortexCommandRouter::Error(
+					CortexErrorCodes::InvalidValue,
+					FString::Printf(TEXT("Unknown kind '%s' (expected class, function, property, enum or struct)"), *Trimmed)
+				);
+			}
+			Query.KindMask |= static_cast<uint8>(1 << KindIndex);
 		}
+	}
 
-		// Case-insensitive pattern match against stripped name (without A/U prefix)
-		if (!Class->GetName().Contains(Pattern, ESearchCase::IgnoreCase))
+	// type_filter narrows to classes (and their members) deriving from it
+	UClass* TypeFilterClass = nullptr;
+	if (!TypeFilter.IsEmpty())
+	{
+		FCortexCommandResult FindError;
+		TypeFilterClass = FindClassByName(TypeFilter, FindError);
+		if (!TypeFilterClass)
 		{
-			continue;
+			return FindError;
 		}
+		Query.KindMask &= static_cast<uint8>((1 << static_cast<uint8>(ECortexSymbolKind::Class))
+			| (1 << static_cast<uint8>(ECortexSymbolKind::Function))
+			| (1 << static_cast<uint8>(ECortexSymbolKind::Property)));
+	}
+	Query.MaxCandidates = FMath::Max(256, Limit * (TypeFilterClass ? 8 : 2));
 
-		if (!bIncludeEngine && !IsProjectClass(Class))
-		{
-			continue;
-		}
+	bool bStale = false;
+	TSharedPtr<const FCortexReflectSymbolTable> Table = FCortexReflectSymbolIndex::Get().GetTable(bStale);
+	TArray<FCortexSymbolMatch> Matches;
+	Table->Query(Query, Matches);
 
-		if (TypeFilterClass && !Class->IsChildOf(TypeFilterClass))
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
+	TArray<TSharedPtr<FJsonValue>> ResultsArray;
+	TArray<TPair<int32, UClass*>> ClassResults;
+	for (const FCortexSymbolMatch& Match : Matches)
+	{
+		if (ResultsArray.Num() >= Limit)
 		{
-			continue;
+			break;
 		}
 
-		if (!ModuleFilter.IsEmpty())
+		const FCortexReflectSymbol& Symbol = Table->GetSymbol(Match.SymbolId);
+		const bool bClassScoped = Symbol.Kind == ECortexSymbolKind::Class
+			|| Symbol.Kind == ECortexSymbolKind::Function
+			|| Symbol.Kind == ECortexSymbolKind::Property;
+		UClass* OwnerClass = nullptr;
+		if (bClassScoped && (TypeFilterClass || Symbol.Kind == ECortexSymbolKind::Class))
 		{
-			const FString* ModName = Class->FindMetaData(TEXT("ModuleName"));
-			if (!ModName || !ModName->Contains(ModuleFilter, ESearchCase::IgnoreCase))
+			// The table may predate a recompile or unload; only report live classes
+			OwnerClass = FindObject<UClass>(nullptr, *Symbol.Path);
+			if (!OwnerClass || (TypeFilterClass && !OwnerClass->IsChildOf(TypeFilterClass)))
 			{
 				continue;
 			}
 		}
 
-		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
-		Entry->SetStringField(TEXT("name"), GetCppClassName(Class));
+		TSharedPtr<FJsonObject> ResultEntry = MakeShared<FJsonObject>();
+		ResultEntry->SetStringField(TEXT("name"), Symbol.DisplayName);
+		ResultEntry->SetStringField(TEXT("kind"), KindLabels[static_cast<uint8>(Symbol.Kind)]);
+		ResultEntry->SetNumberField(TEXT("score"), FMath::RoundToDouble(Match.Score * 10.0) / 10.0);
+		ResultEntry->SetStringField(TEXT("type"), Symbol.bBlueprint ? TEXT("blueprint") : TEXT("cpp"));
 
-		if (Cast<UBlueprintGeneratedClass>(Class))
+		switch (Symbol.Kind)
 		{
-			Entry->SetStringField(TEXT("type"), TEXT("blueprint"));
-			UBlueprint* BP = Cast<UBlueprint>(
-				Cast<UBlueprintGeneratedClass>(Class)->ClassGeneratedBy);
-			if (BP)
+		case ECortexSymbolKind::Class:
+			if (Symbol.bBlueprint)
+			{
+				if (!Symbol.Detail.IsEmpty())
+				{
+					ResultEntry->SetStringField(TEXT("asset_path"), Symbol.Detail);
+				}
+			}
+			else if (!Symbol.Module.IsEmpty())
 			{
-				Entry->SetStringField(TEXT("asset_path"), BP->GetPathName());
+				ResultEntry->SetStringField(TEXT("module"), Symbol.Module);
 			}
-		}
-		else
-		{
-			Entry->SetStringField(TEXT("type"), TEXT("cpp"));
-			const FString* ModName = Class->FindMetaData(TEXT("ModuleName"));
-			if (ModName)
+			if (!Symbol.Parent.IsEmpty())
 			{
-				Entry->SetStringField(TEXT("module"), *ModName);
+				ResultEntry->SetStringField(TEXT("parent"), Symbol.Parent);
 			}
+			ClassResults.Emplace(ResultsArray.Num(), OwnerClass);
+			break;
+		case ECortexSymbolKind::Function:
+			ResultEntry->SetStringField(TEXT("owner"), Symbol.Owner);
+			ResultEntry->SetStringField(TEXT("signature"), Symbol.Detail);
+			break;
+		case ECortexSymbolKind::Property:
+			ResultEntry->SetStringField(TEXT("owner"), Symbol.Owner);
+			ResultEntry->SetStringField(TEXT("property_type"), Symbol.Detail);
+			break;
+		default:
+			ResultEntry->SetStringField(TEXT("path"), Symbol.Path);
+			break;
 		}
-
-		if (Class->GetSuperClass())
-		{
-			Entry->SetStringField(TEXT("parent"), GetCppClassName(Class->GetSuperClass()));
-		}
-
-		// BP children count (GetDerivedClasses per result — acceptable at limit=50)
-		TArray<UClass*> Derived;
-		GetDerivedClasses(Class, Derived, false);
-		int32 BPChildCount = 0;
-		for (UClass* D : Derived)
+		if (Symbol.Kind != ECortexSymbolKind::Class && !Symbol.Module.IsEmpty())
 		{
-			if (Cast<UBlueprintGeneratedClass>(D))
-			{
-				BPChildCount++;
-			}
+			ResultEntry->SetStringField(TEXT("module"), Symbol.Module);
 		}
-		Entry->SetNumberField(TEXT("blueprint_children_count"), BPChildCount);
 
-		ResultsArray.Add(MakeShared<FJsonValueObject>(Entry));
+		ResultsArray.Add(MakeShared<FJsonValueObject>(ResultEntry));
+	}
 
-		if (ResultsArray.Num() >= Limit)
-		{
-			break;
-		}
+	for (const TPair<int32, UClass*>& ClassResult : ClassResults)
+	{
+		ResultsArray[ClassResult.Key]->AsObject()->SetNumberField(
+			TEXT("blueprint_children_count"),
+			Index.CountBlueprintChildren(ClassResult.Value)
+		);
 	}
 
 	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetArrayField(TEXT("results"), ResultsArray);
 	Result->SetNumberField(TEXT("total_results"), ResultsArray.Num());
+	Result->SetNumberField(TEXT("symbol_count"), Table->Num());
+	Result->SetBoolField(TEXT("index_stale"), bStale);
 
 	return FCortexCommandRouter::Success(Result);
 }
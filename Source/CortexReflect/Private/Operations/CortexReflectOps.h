@@ -31,6 +31,8 @@ public:
 	);
 
 private:
+	friend class FCortexReflectIndex;
+
 	static UClass* FindClassByName(const FString& ClassName, FCortexCommandResult& OutError);
 	static bool IsProjectClass(const UClass* Class);
 	static FString GetCppClassName(const UClass* Class);
@@ -0,0 +1,187 @@
+#include "Misc/AutomationTest.h"
+#include "CortexReflectBlueprintTags.h"
+#include "CortexReflectCommandHandler.h"
+#include "CortexTypes.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Character.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/Guid.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectBlueprintTagsRoundTripTest,
+	"Cortex.Reflect.BlueprintTags.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectBlueprintTagsRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FString PackagePath = FString::Printf(
+		TEXT("/Game/Temp/BP_CortexTagsTest_%s"),
+		*FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8));
+	UBlueprint* TestBP = FKismetEditorUtilities::CreateBlueprint(
+		ACharacter::StaticClass(),
+		CreatePackage(*PackagePath),
+		FName(TEXT("BP_CortexTagsTest")),
+		BPTYPE_Normal,
+		UBlueprint::StaticClass(),
+		UBlueprintGeneratedClass::StaticClass());
+	if (!TestNotNull(TEXT("Test Blueprint created"), TestBP))
+	{
+		return false;
+	}
+
+	FEdGraphPinType PinType;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Float;
+	FBlueprintEditorUtils::AddMemberVariable(TestBP, TEXT("TaggedHealth"), PinType);
+
+	UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(TestBP);
+	if (TestNotNull(TEXT("Event graph"), EventGraph))
+	{
+		UK2Node_VariableGet* GetNode = NewObject<UK2Node_VariableGet>(EventGraph);
+		GetNode->VariableReference.SetExternalMember(TEXT("JumpMaxHoldTime"), ACharacter::StaticClass());
+		EventGraph->AddNode(GetNode, false, false);
+	}
+	FKismetEditorUtilities::CompileBlueprint(TestBP);
+
+	FCortexBlueprintSummary Live;
+	FCortexReflectBlueprintTags::Describe(TestBP, Live);
+	TestTrue(TEXT("Own variable described"), Live.Variables.Contains(TEXT("TaggedHealth")));
+	TestTrue(TEXT("Variable read described"), Live.References.ContainsByPredicate([](const FCortexBlueprintReference& Reference)
+	{
+		return Reference.Type == TEXT("read")
+			&& Reference.Target == TEXT("JumpMaxHoldTime")
+			&& Reference.Owner == ACharacter::StaticClass()->GetPathName();
+	}));
+
+	// FAssetData gathers tags through the same hook a save uses
+	const FAssetData Asset(TestBP);
+	FCortexBlueprintSummary Tagged;
+	if (TestTrue(TEXT("Asset data carries Cortex tags"), FCortexReflectBlueprintTags::ReadTags(Asset, Tagged)))
+	{
+		TestEqual(TEXT("Function count round-trips"), Tagged.Functions.Num(), Live.Functions.Num());
+		TestTrue(TEXT("Variables round-trip"), Tagged.Variables == Live.Variables);
+		TestEqual(TEXT("Reference count round-trips"), Tagged.References.Num(), Live.References.Num());
+		for (int32 Index = 0; Index < FMath::Min(Tagged.References.Num(), Live.References.Num()); ++Index)
+		{
+			TestEqual(TEXT("Reference type"), Tagged.References[Index].Type, Live.References[Index].Type);
+			TestEqual(TEXT("Reference target"), Tagged.References[Index].Target, Live.References[Index].Target);
+			TestEqual(TEXT("Reference context"), Tagged.References[Index].Context, Live.References[Index].Context);
+			TestEqual(TEXT("Reference owner"), Tagged.References[Index].Owner, Live.References[Index].Owner);
+		}
+	}
+
+	// The loaded Blueprint is found without a max_blueprints cap
+	FCortexReflectCommandHandler Handler;
+	TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("symbol"), TEXT("JumpMaxHoldTime"));
+	Params->SetStringField(TEXT("class_name"), TEXT("ACharacter"));
+	Params->SetStringField(TEXT("path_filter"), PackagePath);
+	FCortexCommandResult Result = Handler.Execute(TEXT("find_usages"), Params);
+	TestTrue(TEXT("find_usages should succeed"), Result.bSuccess);
+	if (Result.Data.IsValid())
+	{
+		int32 TotalClasses = 0;
+		Result.Data->TryGetNumberField(TEXT("total_classes"), TotalClasses);
+		TestEqual(TEXT("Test Blueprint reported as a usage"), TotalClasses, 1);
+		TestTrue(TEXT("Should report blueprints_from_tags"), Result.Data->HasField(TEXT("blueprints_from_tags")));
+	}
+
+	TestBP->MarkAsGarbage();
+	return true;
+}
+
+namespace
+{
+/** Actor Blueprint declaring SharedHealth and reading it in its event graph, registered but not dirty so queries answer from its tags */
+UBlueprint* CreateSharedMemberBlueprint(const FString& FolderPath, const TCHAR* Name)
+{
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(),
+		CreatePackage(*FString::Printf(TEXT("%s/%s"), *FolderPath, Name)),
+		FName(Name),
+		BPTYPE_Normal,
+		UBlueprint::StaticClass(),
+		UBlueprintGeneratedClass::StaticClass());
+	if (!Blueprint)
+	{
+		return nullptr;
+	}
+
+	FEdGraphPinType PinType;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Float;
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, TEXT("SharedHealth"), PinType);
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+
+	if (UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(Blueprint))
+	{
+		UK2Node_VariableGet* GetNode = NewObject<UK2Node_VariableGet>(EventGraph);
+		GetNode->VariableReference.SetSelfMember(TEXT("SharedHealth"));
+		EventGraph->AddNode(GetNode, false, false);
+	}
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+
+	FAssetRegistryModule::AssetCreated(Blueprint);
+	Blueprint->GetPackage()->SetDirtyFlag(false);
+	return Blueprint;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectBlueprintTagsSharedMemberNameTest,
+	"Cortex.Reflect.BlueprintTags.SharedMemberName",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectBlueprintTagsSharedMemberNameTest::RunTest(const FString& Parameters)
+{
+	const FString FolderPath = FString::Printf(
+		TEXT("/Game/Temp/CortexSharedMember_%s"),
+		*FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(8));
+	UBlueprint* OwnerBP = CreateSharedMemberBlueprint(FolderPath, TEXT("BP_SharedMemberOwner"));
+	UBlueprint* UnrelatedBP = CreateSharedMemberBlueprint(FolderPath, TEXT("BP_SharedMemberUnrelated"));
+	if (!TestNotNull(TEXT("Owner Blueprint created"), OwnerBP) || !TestNotNull(TEXT("Unrelated Blueprint created"), UnrelatedBP))
+	{
+		return false;
+	}
+
+	FCortexBlueprintSummary Tagged;
+	if (TestTrue(TEXT("Unrelated Blueprint carries Cortex tags"), FCortexReflectBlueprintTags::ReadTags(FAssetData(UnrelatedBP), Tagged)))
+	{
+		TestTrue(TEXT("Read is tagged with its declaring class"), Tagged.References.ContainsByPredicate([UnrelatedBP](const FCortexBlueprintReference& Reference)
+		{
+			return Reference.Type == TEXT("read")
+				&& Reference.Target == TEXT("SharedHealth")
+				&& Reference.Owner == UnrelatedBP->GeneratedClass->GetPathName();
+		}));
+	}
+
+	FCortexReflectCommandHandler Handler;
+	TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("symbol"), TEXT("SharedHealth"));
+	Params->SetStringField(TEXT("class_name"), OwnerBP->GetPathName());
+	Params->SetStringField(TEXT("path_filter"), FolderPath);
+	const FCortexCommandResult Result = Handler.Execute(TEXT("find_usages"), Params);
+	TestTrue(TEXT("find_usages should succeed"), Result.bSuccess);
+
+	const TArray<TSharedPtr<FJsonValue>>* Usages = nullptr;
+	if (Result.Data.IsValid() && TestTrue(TEXT("Usages reported"), Result.Data->TryGetArrayField(TEXT("usages"), Usages)))
+	{
+		TestEqual(TEXT("Only the owning Blueprint uses its SharedHealth"), Usages->Num(), 1);
+		if (Usages->Num() == 1)
+		{
+			TestEqual(TEXT("Usage is the owner"),
+				(*Usages)[0]->AsObject()->GetStringField(TEXT("asset_path")),
+				OwnerBP->GetPathName());
+		}
+	}
+
+	OwnerBP->MarkAsGarbage();
+	UnrelatedBP->MarkAsGarbage();
+	return true;
+}
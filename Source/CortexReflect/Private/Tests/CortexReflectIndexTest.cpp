@@ -0,0 +1,152 @@
+#include "Misc/AutomationTest.h"
+#include "CortexReflectIndex.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectIndexLookupParityTest,
+	"Cortex.Reflect.Index.LookupParity",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectIndexLookupParityTest::RunTest(const FString& Parameters)
+{
+	FCortexReflectIndex& Index = FCortexReflectIndex::Get();
+	TestTrue(TEXT("Index should not be empty"), Index.Num() > 0);
+
+	// Every Nth live class resolves by short name to a class of that name
+	TArray<UClass*> Sample;
+	int32 Counter = 0;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (IsValid(*It) && !It->HasAnyClassFlags(CLASS_NewerVersionExists) && (Counter++ % 25) == 0)
+		{
+			Sample.Add(*It);
+		}
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	int32 Mismatches = 0;
+	for (UClass* Expected : Sample)
+	{
+		UClass* Found = Index.FindClass(Expected->GetName());
+		if (!Found || Found->GetName() != Expected->GetName())
+		{
+			++Mismatches;
+		}
+	}
+	const double IndexMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	TestEqual(TEXT("Every sampled class should resolve by name"), Mismatches, 0);
+
+	StartTime = FPlatformTime::Seconds();
+	const FString ScanName = Sample.Num() > 0 ? Sample.Last()->GetName() : FString();
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->GetName() == ScanName)
+		{
+			break;
+		}
+	}
+	const double ScanMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(
+		TEXT("ReflectIndex: %d classes; %d lookups %.2f ms; one TObjectIterator scan %.2f ms"),
+		Index.Num(), Sample.Num(), IndexMs, ScanMs));
+
+	TestNull(TEXT("Unknown name should miss"), Index.FindClass(TEXT("CortexNoSuchClass_7f3a")));
+
+	// Child lists match the engine's class tree
+	TArray<UClass*> EngineChildren;
+	::GetDerivedClasses(AActor::StaticClass(), EngineChildren, false);
+	TArray<UClass*> IndexChildren;
+	Index.GetDerivedClasses(AActor::StaticClass(), IndexChildren, false);
+	for (UClass* Child : EngineChildren)
+	{
+		if (IsValid(Child) && !Child->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			TestTrue(FString::Printf(TEXT("AActor child %s indexed"), *Child->GetName()), IndexChildren.Contains(Child));
+		}
+	}
+
+	TArray<UClass*> Descendants;
+	Index.GetDerivedClasses(AActor::StaticClass(), Descendants, true);
+	TestTrue(TEXT("APawn is a recursive descendant of AActor"), Descendants.Contains(APawn::StaticClass()));
+
+	const FCortexReflectClassEntry* ActorEntry = Index.FindEntry(AActor::StaticClass());
+	if (TestNotNull(TEXT("AActor entry"), ActorEntry))
+	{
+		TestEqual(TEXT("Cpp name"), ActorEntry->CppName, FString(TEXT("AActor")));
+		TestFalse(TEXT("AActor is an engine class"), ActorEntry->IsProject());
+		TestTrue(TEXT("AActor functions captured"), ActorEntry->Functions.Num() > 0);
+		TestTrue(TEXT("AActor properties captured"), ActorEntry->Properties.Num() > 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectIndexDiskRoundTripTest,
+	"Cortex.Reflect.Index.DiskRoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectIndexDiskRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Cortex") / TEXT("reflect-index-test.bin");
+	const uint32 BuildHash = FCortexReflectIndex::ComputeBuildHash();
+	TestTrue(TEXT("Build hash is stable"), FCortexReflectIndex::ComputeBuildHash() == BuildHash);
+
+	FCortexReflectIndex& Live = FCortexReflectIndex::Get();
+	TestTrue(TEXT("Save should succeed"), Live.SaveToFile(Path, BuildHash));
+
+	double StartTime = FPlatformTime::Seconds();
+	FCortexReflectIndex Loaded;
+	TestTrue(TEXT("Load with matching hash should succeed"), Loaded.LoadFromFile(Path, BuildHash));
+	const double LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const FCortexReflectClassEntry* LiveEntry = Live.FindEntry(AActor::StaticClass());
+	const FCortexReflectClassEntry* LoadedEntry = Loaded.FindEntry(AActor::StaticClass());
+	if (TestNotNull(TEXT("Live AActor entry"), LiveEntry) && TestNotNull(TEXT("Loaded AActor entry"), LoadedEntry))
+	{
+		TestEqual(TEXT("Cpp name round-trips"), LoadedEntry->CppName, LiveEntry->CppName);
+		TestEqual(TEXT("Module round-trips"), LoadedEntry->Module, LiveEntry->Module);
+		TestTrue(TEXT("Class flags round-trip"), LoadedEntry->ClassFlags == LiveEntry->ClassFlags);
+		TestEqual(TEXT("Function count round-trips"), LoadedEntry->Functions.Num(), LiveEntry->Functions.Num());
+		TestEqual(TEXT("Property count round-trips"), LoadedEntry->Properties.Num(), LiveEntry->Properties.Num());
+		if (LoadedEntry->Functions.Num() > 0 && LiveEntry->Functions.Num() > 0)
+		{
+			TestEqual(TEXT("Function name"), LoadedEntry->Functions[0].Name, LiveEntry->Functions[0].Name);
+			TestEqual(TEXT("Param count"), LoadedEntry->Functions[0].Params.Num(), LiveEntry->Functions[0].Params.Num());
+		}
+	}
+	TestTrue(TEXT("Loaded index resolves classes by name"), Loaded.FindClass(TEXT("Pawn")) == APawn::StaticClass());
+
+	TArray<UClass*> Children;
+	Loaded.GetDerivedClasses(AActor::StaticClass(), Children, false);
+	TestTrue(TEXT("Loaded index rebuilds child links"), Children.Contains(APawn::StaticClass()));
+
+	AddInfo(FString::Printf(TEXT("ReflectIndex: %d classes loaded from %lld bytes in %.1f ms"),
+		Loaded.Num(), IFileManager::Get().FileSize(*Path), LoadMs));
+
+	FCortexReflectIndex Mismatched;
+	TestFalse(TEXT("Load with a different build hash should fail"), Mismatched.LoadFromFile(Path, BuildHash + 1));
+	TestEqual(TEXT("Failed load leaves the index empty"), Mismatched.Num(), 0);
+
+	TArray<uint8> Bytes;
+	FFileHelper::LoadFileToArray(Bytes, *Path);
+	if (Bytes.Num() > 0)
+	{
+		Bytes[0] ^= 0xFF;
+		FFileHelper::SaveArrayToFile(Bytes, *Path);
+	}
+	FCortexReflectIndex Corrupt;
+	TestFalse(TEXT("Load of a file with a bad header should fail"), Corrupt.LoadFromFile(Path, BuildHash));
+
+	IFileManager::Get().Delete(*Path);
+	return true;
+}
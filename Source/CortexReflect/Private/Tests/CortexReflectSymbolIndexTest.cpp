@@ -0,0 +1,211 @@
+#include "Misc/AutomationTest.h"
+#include "CortexReflectSymbolIndex.h"
+#include "CortexReflectIndex.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectSymbolIndexTokensTest,
+	"Cortex.Reflect.SymbolIndex.Tokens",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectSymbolIndexTokensTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Tokens;
+	FCortexReflectSymbolTable::SplitTokens(TEXT("K2_ApplyRadialDamage"), Tokens);
+	TestEqual(TEXT("Underscore and camel case split"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("k2 apply radial damage")));
+
+	Tokens.Reset();
+	FCortexReflectSymbolTable::SplitTokens(TEXT("HTTPRequest"), Tokens);
+	TestEqual(TEXT("Acronym split before the next word"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("http request")));
+
+	Tokens.Reset();
+	FCortexReflectSymbolTable::SplitTokens(TEXT("apply  damage radial"), Tokens);
+	TestEqual(TEXT("Whitespace split"), Tokens.Num(), 3);
+
+	TestEqual(TEXT("One substitution"), FCortexReflectSymbolTable::BoundedEditDistance(TEXT("damage"), TEXT("damoge"), 2), 1);
+	TestEqual(TEXT("Exceeding the bound stops early"), FCortexReflectSymbolTable::BoundedEditDistance(TEXT("actor"), TEXT("pawn"), 1), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectSymbolIndexRankingTest,
+	"Cortex.Reflect.SymbolIndex.Ranking",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectSymbolIndexRankingTest::RunTest(const FString& Parameters)
+{
+	bool bStale = false;
+	TSharedPtr<const FCortexReflectSymbolTable> Table = FCortexReflectSymbolIndex::Get().GetTable(bStale);
+	if (!TestTrue(TEXT("Table should be built"), Table.IsValid() && Table->Num() > 0))
+	{
+		return false;
+	}
+
+	auto TopNames = [&Table](const FCortexSymbolQuery& Query, int32 Count)
+	{
+		TArray<FCortexSymbolMatch> Matches;
+		Table->Query(Query, Matches);
+		TArray<FString> Names;
+		for (int32 Index = 0; Index < FMath::Min(Count, Matches.Num()); ++Index)
+		{
+			Names.Add(Table->GetSymbol(Matches[Index].SymbolId).Name);
+		}
+		return Names;
+	};
+
+	FCortexSymbolQuery WordOrder;
+	WordOrder.Text = TEXT("apply damage radial");
+	WordOrder.KindMask = 1 << static_cast<uint8>(ECortexSymbolKind::Function);
+	TestTrue(TEXT("Words in any order find ApplyRadialDamage"), TopNames(WordOrder, 5).Contains(TEXT("ApplyRadialDamage")));
+
+	FCortexSymbolQuery Typo;
+	Typo.Text = TEXT("Charactr");
+	Typo.KindMask = 1 << static_cast<uint8>(ECortexSymbolKind::Class);
+	TestTrue(TEXT("A typo still finds Character"), TopNames(Typo, 5).Contains(TEXT("Character")));
+
+	FCortexSymbolQuery Exact;
+	Exact.Text = TEXT("Actor");
+	Exact.KindMask = 1 << static_cast<uint8>(ECortexSymbolKind::Class);
+	const TArray<FString> ExactTop = TopNames(Exact, 1);
+	TestTrue(TEXT("Exact name ranks first"), ExactTop.Num() == 1 && ExactTop[0] == TEXT("Actor"));
+
+	FCortexSymbolQuery Enums;
+	Enums.Text = TEXT("collision channel");
+	Enums.KindMask = 1 << static_cast<uint8>(ECortexSymbolKind::Enum);
+	TestTrue(TEXT("Enums are indexed"), TopNames(Enums, 5).Contains(TEXT("ECollisionChannel")));
+
+	AddInfo(FString::Printf(TEXT("SymbolIndex: %d symbols (stale=%d)"), Table->Num(), bStale ? 1 : 0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectSymbolIndexBenchmarkTest,
+	"Cortex.Reflect.SymbolIndex.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectSymbolIndexBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// 200k synthetic camel-case names drawn from a small vocabulary, so postings are long
+	static const TCHAR* Words[] = {
+		TEXT("Apply"), TEXT("Radial"), TEXT("Damage"), TEXT("Actor"), TEXT("Component"), TEXT("Spawn"),
+		TEXT("Get"), TEXT("Set"), TEXT("Character"), TEXT("Movement"), TEXT("Velocity"), TEXT("Health"),
+		TEXT("Widget"), TEXT("Material"), TEXT("Instance"), TEXT("Parameter"), TEXT("Anim"), TEXT("Montage"),
+		TEXT("Trace"), TEXT("Channel"), TEXT("Socket"), TEXT("Transform"), TEXT("World"), TEXT("Level"),
+	};
+	constexpr int32 WordCount = UE_ARRAY_COUNT(Words);
+	constexpr int32 SymbolCount = 200000;
+
+	TArray<FCortexReflectSymbol> Symbols;
+	Symbols.Reserve(SymbolCount);
+	FRandomStream Random(1234);
+	for (int32 Index = 0; Index < SymbolCount; ++Index)
+	{
+		FCortexReflectSymbol& Symbol = Symbols.AddDefaulted_GetRef();
+		const int32 Parts = 2 + Random.RandHelper(3);
+		for (int32 Part = 0; Part < Parts; ++Part)
+		{
+			Symbol.Name += Words[Random.RandHelper(WordCount)];
+		}
+		Symbol.Name += FString::FromInt(Index % 97);
+		Symbol.DisplayName = Symbol.Name;
+		Symbol.Kind = static_cast<ECortexSymbolKind>(Index % 5);
+		Symbol.Module = FString::Printf(TEXT("Module%d"), Index % 40);
+	}
+	Symbols[SymbolCount / 2].Name = TEXT("ApplyRadialDamageWithFalloff");
+	const FString NeedleName = Symbols[SymbolCount / 2].Name;
+
+	double StartTime = FPlatformTime::Seconds();
+	TSharedRef<FCortexReflectSymbolTable> Table = FCortexReflectSymbolTable::Build(MoveTemp(Symbols));
+	const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	static const TCHAR* Queries[] = {
+		TEXT("apply damage falloff"), TEXT("charactr movment"), TEXT("SpawnActor"),
+		TEXT("widget material param"), TEXT("trace channel"), TEXT("healthcomp"),
+	};
+	constexpr int32 Rounds = 20;
+	TArray<FCortexSymbolMatch> Matches;
+	FCortexSymbolQuery Query;
+	Query.MaxCandidates = 64;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Round = 0; Round < Rounds; ++Round)
+	{
+		for (const TCHAR* Text : Queries)
+		{
+			Query.Text = Text;
+			Table->Query(Query, Matches);
+		}
+	}
+	const double QueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / (Rounds * UE_ARRAY_COUNT(Queries));
+
+	Query.Text = TEXT("apply damage falloff");
+	Table->Query(Query, Matches);
+	TestTrue(TEXT("Needle ranks first"), Matches.Num() > 0 && Table->GetSymbol(Matches[0].SymbolId).Name == NeedleName);
+
+	// Reference: substring scan over every name, the shape of the previous search
+	StartTime = FPlatformTime::Seconds();
+	int32 ScanHits = 0;
+	for (int32 Index = 0; Index < Table->Num(); ++Index)
+	{
+		ScanHits += Table->GetSymbol(Index).Name.Contains(TEXT("RadialDamage"), ESearchCase::IgnoreCase) ? 1 : 0;
+	}
+	const double ScanMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(
+		TEXT("SymbolIndex: %d symbols built in %.1f ms; ranked top-k query avg %.3f ms; linear substring scan %.2f ms (%d hits)"),
+		Table->Num(), BuildMs, QueryMs, ScanMs, ScanHits));
+
+	// The target is well under 1 ms; the bound only catches a regression to scanning every symbol,
+	// so shared CI machines and debug builds do not flake on it
+	TestTrue(TEXT("Average ranked query over 200k symbols stays under 20 ms"), QueryMs < 20.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexReflectSymbolIndexPatchTest,
+	"Cortex.Reflect.SymbolIndex.PatchWithoutRegather",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexReflectSymbolIndexPatchTest::RunTest(const FString& Parameters)
+{
+	// Start from a table that is current, so the only change below is the patch
+	FCortexReflectSymbolIndex::Reset();
+	FCortexReflectSymbolIndex& SymbolIndex = FCortexReflectSymbolIndex::Get();
+	bool bStale = true;
+	TSharedPtr<const FCortexReflectSymbolTable> Table = SymbolIndex.GetTable(bStale);
+	if (!TestTrue(TEXT("Table is built"), Table.IsValid()))
+	{
+		return false;
+	}
+	const int32 BuildsBefore = SymbolIndex.GetFullBuildCount();
+	const int32 SymbolsBefore = Table->Num() - Table->NumRemoved();
+
+	const uint32 VersionBefore = FCortexReflectIndex::Get().GetVersion();
+	TestTrue(TEXT("Refreshing a class bumps the reflection index"),
+		FCortexReflectIndex::Get().PatchClass(AActor::StaticClass()) != INDEX_NONE
+		&& FCortexReflectIndex::Get().GetVersion() != VersionBefore);
+
+	Table = SymbolIndex.GetTable(bStale);
+	TestFalse(TEXT("Patched table is current"), bStale);
+	TestEqual(TEXT("One class change does not regather every symbol"), SymbolIndex.GetFullBuildCount(), BuildsBefore);
+	TestEqual(TEXT("Live symbol count is unchanged"), Table->Num() - Table->NumRemoved(), SymbolsBefore);
+	TestTrue(TEXT("The refreshed class replaced its old symbols"), Table->NumRemoved() > 0);
+
+	FCortexSymbolQuery Query;
+	Query.Text = TEXT("Actor");
+	Query.KindMask = 1 << static_cast<uint8>(ECortexSymbolKind::Class);
+	TArray<FCortexSymbolMatch> Matches;
+	Table->Query(Query, Matches);
+	int32 ActorHits = 0;
+	for (const FCortexSymbolMatch& Match : Matches)
+	{
+		ActorHits += Table->GetSymbol(Match.SymbolId).Path == AActor::StaticClass()->GetPathName() ? 1 : 0;
+	}
+	TestEqual(TEXT("Patched class is found exactly once"), ActorHits, 1);
+	return true;
+}
@@ -0,0 +1,117 @@
+#include "CortexSTEditSession.h"
+
+#include "CortexBatchScope.h"
+#include "CortexCommandRouter.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeModule.h"
+#include "Dom/JsonObject.h"
+#include "Operations/CortexSTAssetOps.h"
+#include "Operations/CortexSTValidationOps.h"
+#include "StateTree.h"
+#include "StateTreeCompilerLog.h"
+
+TMap<FString, FCortexSTEditSession::FPendingFinalize> FCortexSTEditSession::Pending;
+int32 FCortexSTEditSession::FlushCount = 0;
+
+bool FCortexSTEditSession::IsDeferring()
+{
+	return FCortexCommandRouter::IsInBatch();
+}
+
+void FCortexSTEditSession::DeferFinalize(UStateTree* StateTree, const FString& AssetPath, const bool bCompile, const bool bSave)
+{
+	if (StateTree == nullptr)
+	{
+		return;
+	}
+
+	FPendingFinalize& Entry = Pending.FindOrAdd(AssetPath);
+	Entry.StateTree = StateTree;
+	Entry.bCompile |= bCompile;
+	Entry.bSave |= bSave;
+
+	// Only the first callback per key is kept; it reads the flags merged above when it runs
+	FCortexBatchScope::AddFinalizeAction(
+		FString::Printf(TEXT("statetree.finalize.%s"), *AssetPath),
+		[AssetPath]()
+		{
+			return Flush(AssetPath);
+		});
+}
+
+void FCortexSTEditSession::Reset()
+{
+	Pending.Reset();
+}
+
+TSharedPtr<FJsonObject> FCortexSTEditSession::Flush(const FString& AssetPath)
+{
+	FPendingFinalize Entry;
+	if (!Pending.RemoveAndCopyValue(AssetPath, Entry))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("asset_path"), AssetPath);
+	Report->SetBoolField(TEXT("compiled"), false);
+	Report->SetBoolField(TEXT("saved"), false);
+
+	const auto Fail = [&Report, &AssetPath](const FString& ErrorMessage)
+	{
+		UE_LOG(LogCortexStateTree, Warning, TEXT("Deferred finalize failed for %s: %s"), *AssetPath, *ErrorMessage);
+		Report->SetBoolField(TEXT("success"), false);
+		Report->SetStringField(TEXT("error"), ErrorMessage);
+		return Report;
+	};
+
+	UStateTree* StateTree = Entry.StateTree.Get();
+	if (StateTree == nullptr)
+	{
+		return Fail(TEXT("StateTree was unloaded before its batched edits could be finalized"));
+	}
+
+	++FlushCount;
+
+	const FCortexCommandResult FixupResult = FCortexSTValidationOps::RunPostMutationFixups(StateTree);
+	if (!FixupResult.bSuccess)
+	{
+		return Fail(FixupResult.ErrorMessage);
+	}
+	Report->SetObjectField(TEXT("validation"), FixupResult.Data->GetObjectField(TEXT("validation")));
+
+	StateTree->MarkPackageDirty();
+
+	if (Entry.bCompile)
+	{
+		FStateTreeCompilerLog CompileLog;
+		const bool bCompiled = FCortexSTValidationOps::CompileTree(StateTree, CompileLog);
+		Report->SetObjectField(
+			TEXT("compile"),
+			FCortexSTValidationOps::BuildCompilePayload(AssetPath, StateTree, CompileLog, bCompiled));
+		Report->SetBoolField(TEXT("compiled"), bCompiled);
+		Report->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
+
+		// Same as a direct mutation: a failed compile skips the save
+		if (!bCompiled)
+		{
+			return Fail(FString::Printf(TEXT("StateTree compilation failed for %s"), *AssetPath));
+		}
+	}
+
+	if (Entry.bSave)
+	{
+		const FCortexCommandResult SaveResult = FCortexSTAssetOps::SaveAsset(AssetPath);
+		if (!SaveResult.bSuccess)
+		{
+			Report->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
+			return Fail(SaveResult.ErrorMessage);
+		}
+		Report->SetBoolField(TEXT("saved"), true);
+	}
+
+	Report->SetBoolField(TEXT("success"), true);
+	Report->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
+	UE_LOG(LogCortexStateTree, Log, TEXT("Finalized batched edits for StateTree: %s"), *AssetPath);
+	return Report;
+}
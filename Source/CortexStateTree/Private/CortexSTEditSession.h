@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FJsonObject;
+class UStateTree;
+
+/**
+ * Deferred finalize for StateTree mutations inside a batch. Each mutation still resolves
+ * its IDs, but post-mutation fixups, compile and save are recorded here per asset instead
+ * of running per step. After the last batch step, before the batch response is built, they
+ * run once per touched asset, compiling or saving if any step asked to, and each asset's
+ * report (validation, compile diagnostics, saved, final fingerprint) is listed under the
+ * batch's "finalize" field. Outside a batch mutations finalize immediately as before.
+ * Game thread only.
+ */
+class FCortexSTEditSession
+{
+public:
+	/** True when mutations should defer their finalize to the enclosing batch. */
+	static bool IsDeferring();
+
+	/** Record a mutated asset; compile and save requests accumulate across steps. */
+	static void DeferFinalize(UStateTree* StateTree, const FString& AssetPath, bool bCompile, bool bSave);
+
+	/** Drop pending finalizes without running them (module shutdown). */
+	static void Reset();
+
+	static int32 NumPending() { return Pending.Num(); }
+
+	/** Deferred finalizes run since startup, so tests can tell one flush per asset from one per step. */
+	static int32 GetFlushCount() { return FlushCount; }
+
+private:
+	struct FPendingFinalize
+	{
+		TWeakObjectPtr<UStateTree> StateTree;
+		bool bCompile = false;
+		bool bSave = false;
+	};
+
+	/** Run one asset's deferred finalize; success is false when fixups, compile or save failed. */
+	static TSharedPtr<FJsonObject> Flush(const FString& AssetPath);
+
+	static TMap<FString, FPendingFinalize> Pending;
+	static int32 FlushCount;
+};
@@ -0,0 +1,454 @@
+#include "CortexSTStateIndex.h"
+
+#include "CortexSTCompat.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "StateTreeEditorData.h"
+#include "StateTreeState.h"
+#include "UObject/UObjectGlobals.h"
+
+TUniquePtr<FCortexSTStateIndex> FCortexSTStateIndex::Instance;
+
+FCortexSTStateIndex& FCortexSTStateIndex::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FCortexSTStateIndex>();
+	}
+	return *Instance;
+}
+
+void FCortexSTStateIndex::Reset()
+{
+	Instance.Reset();
+}
+
+FCortexSTStateIndex::FCortexSTStateIndex()
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FCortexSTStateIndex::HandleObjectModified);
+	ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FCortexSTStateIndex::HandleObjectTransacted);
+}
+
+FCortexSTStateIndex::~FCortexSTStateIndex()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+}
+
+bool FCortexSTStateIndex::FindRoot(UStateTreeEditorData* EditorData, FCortexSTStateRef& OutState)
+{
+	if (EditorData == nullptr)
+	{
+		return false;
+	}
+
+	bool bRebuilt = false;
+	FTreeEntry& Entry = GetCurrent(EditorData, bRebuilt);
+	for (;;)
+	{
+		const FStateEntry* StateEntry = Entry.Root.IsValid() ? Entry.States.Find(FObjectKey(Entry.Root.Get())) : nullptr;
+		if (StateEntry != nullptr && IsStillIndexed(EditorData, *StateEntry))
+		{
+			OutState = MakeStateRef(*StateEntry);
+			return true;
+		}
+		if (bRebuilt)
+		{
+			return false;
+		}
+		Rebuild(Entry, EditorData);
+		bRebuilt = true;
+	}
+}
+
+bool FCortexSTStateIndex::FindById(UStateTreeEditorData* EditorData, const FString& StateId, FCortexSTStateRef& OutState)
+{
+	if (EditorData == nullptr || StateId.IsEmpty())
+	{
+		return false;
+	}
+
+	bool bRebuilt = false;
+	FTreeEntry& Entry = GetCurrent(EditorData, bRebuilt);
+	for (;;)
+	{
+		const FObjectKey* StateKey = Entry.ById.Find(StateId);
+		const FStateEntry* StateEntry = StateKey != nullptr ? Entry.States.Find(*StateKey) : nullptr;
+		if (StateEntry != nullptr && IsStillIndexed(EditorData, *StateEntry))
+		{
+			OutState = MakeStateRef(*StateEntry);
+			return true;
+		}
+		if (bRebuilt)
+		{
+			return false;
+		}
+
+		// Unknown ID or a stale hit: the tree changed without a Modify() the index saw
+		Rebuild(Entry, EditorData);
+		bRebuilt = true;
+	}
+}
+
+void FCortexSTStateIndex::FindByPath(UStateTreeEditorData* EditorData, const FString& StatePath, TArray<FCortexSTStateRef>& OutMatches)
+{
+	OutMatches.Reset();
+	if (EditorData == nullptr || StatePath.IsEmpty())
+	{
+		return;
+	}
+
+	bool bRebuilt = false;
+	FTreeEntry& Entry = GetCurrent(EditorData, bRebuilt);
+	for (;;)
+	{
+		bool bAllValid = true;
+		for (auto It = Entry.ByPath.CreateConstKeyIterator(StatePath); It; ++It)
+		{
+			const FStateEntry* StateEntry = Entry.States.Find(It.Value());
+			if (StateEntry == nullptr || !IsStillIndexed(EditorData, *StateEntry))
+			{
+				bAllValid = false;
+				break;
+			}
+			OutMatches.Add(MakeStateRef(*StateEntry));
+		}
+
+		if (bRebuilt || (bAllValid && OutMatches.Num() > 0))
+		{
+			if (!bAllValid)
+			{
+				OutMatches.Reset();
+			}
+			return;
+		}
+
+		OutMatches.Reset();
+		Rebuild(Entry, EditorData);
+		bRebuilt = true;
+	}
+}
+
+bool FCortexSTStateIndex::FindTransitionOwner(UStateTreeEditorData* EditorData, const FGuid& TransitionId, FCortexSTStateRef& OutOwner)
+{
+	if (EditorData == nullptr || !TransitionId.IsValid())
+	{
+		return false;
+	}
+
+	bool bRebuilt = false;
+	FTreeEntry& Entry = GetCurrent(EditorData, bRebuilt);
+	for (;;)
+	{
+		const FObjectKey* StateKey = Entry.TransitionOwners.Find(TransitionId);
+		const FStateEntry* StateEntry = StateKey != nullptr ? Entry.States.Find(*StateKey) : nullptr;
+		if (StateEntry != nullptr
+			&& IsStillIndexed(EditorData, *StateEntry)
+			&& StateEntry->State->Transitions.ContainsByPredicate(
+				[&TransitionId](const FStateTreeTransition& Transition) { return Transition.ID == TransitionId; }))
+		{
+			OutOwner = MakeStateRef(*StateEntry);
+			return true;
+		}
+		if (bRebuilt)
+		{
+			return false;
+		}
+		Rebuild(Entry, EditorData);
+		bRebuilt = true;
+	}
+}
+
+FCortexSTStateIndex::FEdit FCortexSTStateIndex::BeginEdit(const UStateTreeEditorData* EditorData) const
+{
+	FEdit Edit;
+	Edit.EditorData = FObjectKey(EditorData);
+	if (const FTreeEntry* Entry = Trees.Find(Edit.EditorData))
+	{
+		Edit.ChangeCount = Entry->ChangeCount;
+	}
+	return Edit;
+}
+
+void FCortexSTStateIndex::CommitSubtree(const FEdit& Edit, UStateTreeState* State)
+{
+	FTreeEntry* Entry = GetPatchable(Edit);
+	if (Entry == nullptr || State == nullptr)
+	{
+		return;
+	}
+
+	IndexSubtree(*Entry, State, State->Parent, CortexSTCompat::GetStatePath(State));
+	Entry->BuiltChangeCount = Entry->ChangeCount;
+}
+
+void FCortexSTStateIndex::CommitRemoval(const FEdit& Edit, UStateTreeState* State)
+{
+	FTreeEntry* Entry = GetPatchable(Edit);
+	if (Entry == nullptr || State == nullptr)
+	{
+		return;
+	}
+
+	TArray<UStateTreeState*> Stack;
+	Stack.Add(State);
+	while (Stack.Num() > 0)
+	{
+		UStateTreeState* Current = Stack.Pop(EAllowShrinking::No);
+		if (Current == nullptr)
+		{
+			continue;
+		}
+		UnindexState(*Entry, FObjectKey(Current));
+		for (UStateTreeState* ChildState : Current->Children)
+		{
+			Stack.Add(ChildState);
+		}
+	}
+	Entry->BuiltChangeCount = Entry->ChangeCount;
+}
+
+void FCortexSTStateIndex::CommitTransitions(const FEdit& Edit, UStateTreeState* State)
+{
+	FTreeEntry* Entry = GetPatchable(Edit);
+	const FObjectKey StateKey(State);
+	FStateEntry* StateEntry = Entry != nullptr ? Entry->States.Find(StateKey) : nullptr;
+	if (StateEntry == nullptr)
+	{
+		return;
+	}
+
+	IndexTransitions(*Entry, *StateEntry, StateKey);
+	Entry->BuiltChangeCount = Entry->ChangeCount;
+}
+
+void FCortexSTStateIndex::CommitUnchanged(const FEdit& Edit)
+{
+	if (FTreeEntry* Entry = GetPatchable(Edit))
+	{
+		Entry->BuiltChangeCount = Entry->ChangeCount;
+	}
+}
+
+FCortexSTStateIndex::FTreeEntry& FCortexSTStateIndex::GetCurrent(UStateTreeEditorData* EditorData, bool& bOutRebuilt)
+{
+	const FObjectKey Key(EditorData);
+	FTreeEntry* Entry = Trees.Find(Key);
+	if (Entry == nullptr)
+	{
+		for (auto It = Trees.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().EditorData.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		Entry = &Trees.Add(Key);
+	}
+
+	const UStateTreeState* RootState = EditorData->SubTrees.Num() > 0 ? EditorData->SubTrees[0] : nullptr;
+	if (!Entry->bBuilt
+		|| Entry->BuiltChangeCount != Entry->ChangeCount
+		|| Entry->EditorData.Get() != EditorData
+		|| Entry->Root.Get() != RootState)
+	{
+		Rebuild(*Entry, EditorData);
+		bOutRebuilt = true;
+	}
+	return *Entry;
+}
+
+FCortexSTStateIndex::FTreeEntry* FCortexSTStateIndex::GetPatchable(const FEdit& Edit)
+{
+	// Patchable only if the entry was current when the edit began, or was rebuilt during it
+	FTreeEntry* Entry = Trees.Find(Edit.EditorData);
+	if (Entry == nullptr || !Entry->bBuilt || Entry->BuiltChangeCount < Edit.ChangeCount)
+	{
+		return nullptr;
+	}
+	return Entry;
+}
+
+void FCortexSTStateIndex::Rebuild(FTreeEntry& Entry, UStateTreeEditorData* EditorData)
+{
+	Entry.States.Reset();
+	Entry.ById.Reset();
+	Entry.ByPath.Reset();
+	Entry.TransitionOwners.Reset();
+
+	UStateTreeState* RootState = EditorData->SubTrees.Num() > 0 ? EditorData->SubTrees[0] : nullptr;
+	Entry.EditorData = EditorData;
+	Entry.Root = RootState;
+	if (RootState != nullptr)
+	{
+		IndexSubtree(Entry, RootState, nullptr, RootState->Name.ToString());
+	}
+
+	Entry.bBuilt = true;
+	Entry.BuiltChangeCount = Entry.ChangeCount;
+	++BuildCount;
+}
+
+void FCortexSTStateIndex::IndexSubtree(FTreeEntry& Entry, UStateTreeState* State, UStateTreeState* Parent, const FString& Path)
+{
+	struct FPending
+	{
+		UStateTreeState* State;
+		UStateTreeState* Parent;
+		FString Path;
+	};
+
+	// Pre-order with children in order, so the first state a CollectStates walk meets wins an ID
+	TArray<FPending> Stack;
+	Stack.Add({ State, Parent, Path });
+	while (Stack.Num() > 0)
+	{
+		FPending Pending = Stack.Pop(EAllowShrinking::No);
+		if (Pending.State == nullptr)
+		{
+			continue;
+		}
+
+		const FObjectKey StateKey(Pending.State);
+		UnindexState(Entry, StateKey);
+
+		FStateEntry& StateEntry = Entry.States.Add(StateKey);
+		StateEntry.State = Pending.State;
+		StateEntry.Parent = Pending.Parent;
+		StateEntry.Guid = Pending.State->ID;
+		StateEntry.Name = Pending.State->Name;
+		StateEntry.Id = Pending.State->ID.ToString(EGuidFormats::DigitsWithHyphens);
+		StateEntry.Path = Pending.Path;
+
+		if (!Entry.ById.Contains(StateEntry.Id))
+		{
+			Entry.ById.Add(StateEntry.Id, StateKey);
+		}
+		Entry.ByPath.Add(StateEntry.Path, StateKey);
+		IndexTransitions(Entry, StateEntry, StateKey);
+
+		for (int32 ChildIndex = Pending.State->Children.Num() - 1; ChildIndex >= 0; --ChildIndex)
+		{
+			UStateTreeState* ChildState = Pending.State->Children[ChildIndex];
+			if (ChildState != nullptr)
+			{
+				Stack.Add({ ChildState, Pending.State, Pending.Path + TEXT("/") + ChildState->Name.ToString() });
+			}
+		}
+	}
+}
+
+void FCortexSTStateIndex::UnindexState(FTreeEntry& Entry, const FObjectKey& StateKey)
+{
+	const FStateEntry* StateEntry = Entry.States.Find(StateKey);
+	if (StateEntry == nullptr)
+	{
+		return;
+	}
+
+	if (const FObjectKey* IdOwner = Entry.ById.Find(StateEntry->Id))
+	{
+		if (*IdOwner == StateKey)
+		{
+			Entry.ById.Remove(StateEntry->Id);
+		}
+	}
+	Entry.ByPath.RemoveSingle(StateEntry->Path, StateKey);
+	for (const FGuid& TransitionId : StateEntry->TransitionIds)
+	{
+		if (const FObjectKey* TransitionOwner = Entry.TransitionOwners.Find(TransitionId))
+		{
+			if (*TransitionOwner == StateKey)
+			{
+				Entry.TransitionOwners.Remove(TransitionId);
+			}
+		}
+	}
+	Entry.States.Remove(StateKey);
+}
+
+void FCortexSTStateIndex::IndexTransitions(FTreeEntry& Entry, FStateEntry& StateEntry, const FObjectKey& StateKey)
+{
+	for (const FGuid& TransitionId : StateEntry.TransitionIds)
+	{
+		if (const FObjectKey* TransitionOwner = Entry.TransitionOwners.Find(TransitionId))
+		{
+			if (*TransitionOwner == StateKey)
+			{
+				Entry.TransitionOwners.Remove(TransitionId);
+			}
+		}
+	}
+	StateEntry.TransitionIds.Reset();
+
+	const UStateTreeState* State = StateEntry.State.Get();
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	for (const FStateTreeTransition& Transition : State->Transitions)
+	{
+		if (Transition.ID.IsValid())
+		{
+			StateEntry.TransitionIds.Add(Transition.ID);
+			if (!Entry.TransitionOwners.Contains(Transition.ID))
+			{
+				Entry.TransitionOwners.Add(Transition.ID, StateKey);
+			}
+		}
+	}
+}
+
+bool FCortexSTStateIndex::IsStillIndexed(const UStateTreeEditorData* EditorData, const FStateEntry& StateEntry)
+{
+	// Removed states keep their ID but are re-outered to the transient package
+	const UStateTreeState* State = StateEntry.State.Get();
+	return IsValid(State)
+		&& State->ID == StateEntry.Guid
+		&& State->Name == StateEntry.Name
+		&& State->Parent == StateEntry.Parent.Get()
+		&& State->GetTypedOuter<UStateTreeEditorData>() == EditorData;
+}
+
+FCortexSTStateRef FCortexSTStateIndex::MakeStateRef(const FStateEntry& StateEntry)
+{
+	FCortexSTStateRef StateRef;
+	StateRef.State = StateEntry.State.Get();
+	StateRef.Parent = StateEntry.Parent.Get();
+	StateRef.Id = StateEntry.Id;
+	StateRef.Path = StateEntry.Path;
+	StateRef.Index = StateRef.Parent != nullptr ? StateRef.Parent->Children.IndexOfByKey(StateRef.State) : 0;
+	return StateRef;
+}
+
+void FCortexSTStateIndex::HandleObjectModified(UObject* Object)
+{
+	// State edits Modify() the state; swapping the subtree root Modify()s the editor data
+	if (Trees.Num() == 0 || Object == nullptr)
+	{
+		return;
+	}
+
+	const UStateTreeEditorData* EditorData = Cast<UStateTreeEditorData>(Object);
+	if (EditorData == nullptr && Object->IsA<UStateTreeState>())
+	{
+		EditorData = Object->GetTypedOuter<UStateTreeEditorData>();
+	}
+
+	if (EditorData != nullptr)
+	{
+		if (FTreeEntry* Entry = Trees.Find(FObjectKey(EditorData)))
+		{
+			++Entry->ChangeCount;
+		}
+	}
+}
+
+void FCortexSTStateIndex::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	// Finalize events repeat Modify() calls already counted, including a Cortex edit's own
+	if (Event.GetEventType() == ETransactionObjectEventType::UndoRedo)
+	{
+		HandleObjectModified(Object);
+	}
+}
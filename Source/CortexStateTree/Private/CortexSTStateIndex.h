@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CortexSTTypes.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UStateTreeEditorData;
+class UStateTreeState;
+class FTransactionObjectEvent;
+
+/**
+ * Per-asset state lookup for StateTree editor data: state ID and path to state, parent links
+ * and the transition IDs each state owns, covering the same states CortexST::CollectStates
+ * walks. An entry is built with one walk and reused until a state or the editor data is
+ * modified or undone/redone outside a Cortex edit. Cortex mutations bracket their changes
+ * with BeginEdit and one of the Commit calls, which patch the entry in place. A hit is only
+ * returned while the state still carries its indexed ID, name, parent and editor data, so edits
+ * that skip Modify() on the looked-up state still fall back to a rebuild. Game thread only.
+ */
+class FCortexSTStateIndex
+{
+public:
+	/** Taken before a mutation calls Modify(), so the mutation can patch the entry it invalidates. */
+	struct FEdit
+	{
+		FObjectKey EditorData;
+		uint32 ChangeCount = 0;
+	};
+
+	static FCortexSTStateIndex& Get();
+	static void Reset();
+
+	FCortexSTStateIndex();
+	~FCortexSTStateIndex();
+
+	bool FindRoot(UStateTreeEditorData* EditorData, FCortexSTStateRef& OutState);
+	bool FindById(UStateTreeEditorData* EditorData, const FString& StateId, FCortexSTStateRef& OutState);
+	void FindByPath(UStateTreeEditorData* EditorData, const FString& StatePath, TArray<FCortexSTStateRef>& OutMatches);
+	bool FindTransitionOwner(UStateTreeEditorData* EditorData, const FGuid& TransitionId, FCortexSTStateRef& OutOwner);
+
+	FEdit BeginEdit(const UStateTreeEditorData* EditorData) const;
+
+	/** Re-index a state and its descendants after it was added, renamed or moved. */
+	void CommitSubtree(const FEdit& Edit, UStateTreeState* State);
+
+	/** Drop a detached state and its descendants. */
+	void CommitRemoval(const FEdit& Edit, UStateTreeState* State);
+
+	/** Re-index the transitions owned by one state. */
+	void CommitTransitions(const FEdit& Edit, UStateTreeState* State);
+
+	/** For engine validate/compile passes, which Modify() the editor data but keep IDs, names and hierarchy. */
+	void CommitUnchanged(const FEdit& Edit);
+
+	/** Entries built since startup, so tests can tell a hit from a rebuild. */
+	int32 GetBuildCount() const { return BuildCount; }
+
+private:
+	struct FStateEntry
+	{
+		TWeakObjectPtr<UStateTreeState> State;
+		TWeakObjectPtr<UStateTreeState> Parent;
+		FGuid Guid;
+		FName Name;
+		FString Id;
+		FString Path;
+		TArray<FGuid> TransitionIds;
+	};
+
+	struct FTreeEntry
+	{
+		TWeakObjectPtr<UStateTreeEditorData> EditorData;
+		TWeakObjectPtr<UStateTreeState> Root;
+		uint32 ChangeCount = 0;
+		uint32 BuiltChangeCount = 0;
+		bool bBuilt = false;
+		TMap<FObjectKey, FStateEntry> States;
+		TMap<FString, FObjectKey> ById;
+		TMultiMap<FString, FObjectKey> ByPath;
+		TMap<FGuid, FObjectKey> TransitionOwners;
+	};
+
+	FTreeEntry& GetCurrent(UStateTreeEditorData* EditorData, bool& bOutRebuilt);
+	FTreeEntry* GetPatchable(const FEdit& Edit);
+	void Rebuild(FTreeEntry& Entry, UStateTreeEditorData* EditorData);
+	void IndexSubtree(FTreeEntry& Entry, UStateTreeState* State, UStateTreeState* Parent, const FString& Path);
+	static void UnindexState(FTreeEntry& Entry, const FObjectKey& StateKey);
+	static void IndexTransitions(FTreeEntry& Entry, FStateEntry& StateEntry, const FObjectKey& StateKey);
+
+	static bool IsStillIndexed(const UStateTreeEditorData* EditorData, const FStateEntry& StateEntry);
+	static FCortexSTStateRef MakeStateRef(const FStateEntry& StateEntry);
+
+	void HandleObjectModified(UObject* Object);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+
+	TMap<FObjectKey, FTreeEntry> Trees;
+	int32 BuildCount = 0;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectTransactedHandle;
+
+	static TUniquePtr<FCortexSTStateIndex> Instance;
+};
@@ -5,6 +5,7 @@
 #include "CortexCommandRouter.h"
 #include "CortexEditorUtils.h"
 #include "CortexSTCompat.h"
+#include "CortexSTStateIndex.h"
 #include "GameplayTagsManager.h"
 #include "Misc/PackageName.h"
 #include "StateTreeEditorNode.h"
@@ -423,17 +424,31 @@ void CollectStates(UStateTreeState* Root, TArray<FCortexSTStateRef>& OutStates)
 	Visit(Root, nullptr);
 }
 
-bool ResolveState(
+void ReouterStateSubtree(UStateTreeState* State, UObject* NewOuter)
+{
+	if (State == nullptr || NewOuter == nullptr)
+	{
+		return;
+	}
+
+	if (State->GetOuter() != NewOuter)
+	{
+		State->Rename(nullptr, NewOuter, REN_DontCreateRedirectors | REN_DoNotDirty);
+	}
+}
+
+bool ResolveStateBySelector(
 	const FCortexSTAssetContext& Context,
 	const TSharedPtr<FJsonObject>& Params,
+	const TCHAR* IdField,
+	const TCHAR* PathField,
+	const bool bDefaultToRoot,
 	FCortexSTStateRef& OutState,
 	FCortexCommandResult& OutError)
 {
-	UStateTreeState* RootState =
-		Context.EditorData != nullptr && Context.EditorData->SubTrees.Num() > 0
-			? Context.EditorData->SubTrees[0]
-			: nullptr;
-	if (RootState == nullptr)
+	FCortexSTStateIndex& Index = FCortexSTStateIndex::Get();
+	FCortexSTStateRef RootStateRef;
+	if (!Index.FindRoot(Context.EditorData, RootStateRef))
 	{
 		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::StateTreeStateNotFound,
@@ -443,49 +458,43 @@ bool ResolveState(
 
 	FString StateId;
 	FString StatePath;
-	const bool bHasStateId = Params.IsValid() && Params->TryGetStringField(TEXT("state_id"), StateId) && !StateId.IsEmpty();
-	const bool bHasStatePath = Params.IsValid() && Params->TryGetStringField(TEXT("state_path"), StatePath) && !StatePath.IsEmpty();
+	const bool bHasStateId = Params.IsValid() && Params->TryGetStringField(IdField, StateId) && !StateId.IsEmpty();
+	const bool bHasStatePath = Params.IsValid() && Params->TryGetStringField(PathField, StatePath) && !StatePath.IsEmpty();
 
 	if (bHasStateId && bHasStatePath)
 	{
 		TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
 		TArray<TSharedPtr<FJsonValue>> AllowedFields;
-		AllowedFields.Add(MakeShared<FJsonValueString>(TEXT("state_id")));
-		AllowedFields.Add(MakeShared<FJsonValueString>(TEXT("state_path")));
+		AllowedFields.Add(MakeShared<FJsonValueString>(IdField));
+		AllowedFields.Add(MakeShared<FJsonValueString>(PathField));
 		Details->SetArrayField(TEXT("allowed_fields"), AllowedFields);
 
 		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::InvalidField,
-			TEXT("Specify exactly one of state_id or state_path"),
+			FString::Printf(TEXT("Specify exactly one of %s or %s"), IdField, PathField),
 			Details);
 		return false;
 	}
 
-	TArray<FCortexSTStateRef> States;
-	CollectStates(RootState, States);
 	if (!bHasStateId && !bHasStatePath)
 	{
-		if (States.Num() > 0)
+		if (bDefaultToRoot)
 		{
-			OutState = States[0];
+			OutState = RootStateRef;
 			return true;
 		}
 
 		OutError = FCortexCommandRouter::Error(
 			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree has no states: %s"), *Context.AssetPath));
+			FString::Printf(TEXT("StateTree state not found in asset: %s"), *Context.AssetPath));
 		return false;
 	}
 
 	if (bHasStateId)
 	{
-		for (const FCortexSTStateRef& StateRef : States)
+		if (Index.FindById(Context.EditorData, StateId, OutState))
 		{
-			if (StateRef.Id == StateId)
-			{
-				OutState = StateRef;
-				return true;
-			}
+			return true;
 		}
 
 		OutError = FCortexCommandRouter::Error(
@@ -495,13 +504,7 @@ bool ResolveState(
 	}
 
 	TArray<FCortexSTStateRef> Matches;
-	for (const FCortexSTStateRef& StateRef : States)
-	{
-		if (StateRef.Path == StatePath)
-		{
-			Matches.Add(StateRef);
-		}
-	}
+	Index.FindByPath(Context.EditorData, StatePath, Matches);
 
 	if (Matches.Num() == 1)
 	{
@@ -533,6 +536,15 @@ bool ResolveState(
 	return false;
 }
 
+bool ResolveState(
+	const FCortexSTAssetContext& Context,
+	const TSharedPtr<FJsonObject>& Params,
+	FCortexSTStateRef& OutState,
+	FCortexCommandResult& OutError)
+{
+	return ResolveStateBySelector(Context, Params, TEXT("state_id"), TEXT("state_path"), true, OutState, OutError);
+}
+
 TSharedPtr<FJsonObject> SerializeState(const FCortexSTStateRef& StateRef, const bool bIncludeTransitions, const bool bIncludeNodes)
 {
 	TSharedPtr<FJsonObject> StateObject = MakeShared<FJsonObject>();
@@ -39,6 +39,9 @@ bool CheckExpectedFingerprint(UObject* Asset, const TSharedPtr<FJsonObject>& Par
 TSharedPtr<FJsonObject> MakeValidationPayload(bool bValid, const TArray<FString>& Errors, const TArray<FString>& Warnings);
 TSharedPtr<FJsonObject> BuildValidationPayload(UStateTree* StateTree);
 void CollectStates(UStateTreeState* Root, TArray<FCortexSTStateRef>& OutStates);
+/** Move a detached or reparented state (and with it its subtree) under NewOuter. */
+void ReouterStateSubtree(UStateTreeState* State, UObject* NewOuter);
+bool ResolveStateBySelector(const FCortexSTAssetContext& Context, const TSharedPtr<FJsonObject>& Params, const TCHAR* IdField, const TCHAR* PathField, bool bDefaultToRoot, FCortexSTStateRef& OutState, FCortexCommandResult& OutError);
 bool ResolveState(const FCortexSTAssetContext& Context, const TSharedPtr<FJsonObject>& Params, FCortexSTStateRef& OutState, FCortexCommandResult& OutError);
 TSharedPtr<FJsonObject> SerializeState(const FCortexSTStateRef& StateRef, bool bIncludeTransitions, bool bIncludeNodes);
 }
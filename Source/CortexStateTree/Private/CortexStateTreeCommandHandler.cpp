@@ -6,6 +6,7 @@
 #include "Operations/CortexSTInspectOps.h"
 #include "Operations/CortexSTStateOps.h"
 #include "Operations/CortexSTTransitionOps.h"
+#include "Operations/CortexSTTreeOps.h"
 #include "Operations/CortexSTValidationOps.h"
 
 FCortexCommandResult FCortexStateTreeCommandHandler::Execute(
@@ -39,6 +40,14 @@ FCortexCommandResult FCortexStateTreeCommandHandler::Execute(
 	{
 		return FCortexSTInspectOps::GetState(Params);
 	}
+	if (Command == TEXT("export_tree"))
+	{
+		return FCortexSTTreeOps::ExportTree(Params);
+	}
+	if (Command == TEXT("apply_tree"))
+	{
+		return FCortexSTTreeOps::ApplyTree(Params);
+	}
 	if (Command == TEXT("check_structure"))
 	{
 		return FCortexSTValidationOps::CheckStructure(Params);
@@ -51,6 +60,14 @@ FCortexCommandResult FCortexStateTreeCommandHandler::Execute(
 	{
 		return FCortexSTValidationOps::Compile(Params);
 	}
+	if (Command == TEXT("validate_all"))
+	{
+		return FCortexSTValidationOps::ValidateAll(Params);
+	}
+	if (Command == TEXT("compile_all"))
+	{
+		return FCortexSTValidationOps::CompileAll(Params);
+	}
 	if (Command == TEXT("add_state"))
 	{
 		return FCortexSTStateOps::AddState(Params);
@@ -117,6 +134,14 @@ TArray<FCortexCommandInfo> FCortexStateTreeCommandHandler::GetSupportedCommands(
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path"))
 			.Optional(TEXT("state_id"), TEXT("string"), TEXT("State GUID"))
 			.Optional(TEXT("state_path"), TEXT("string"), TEXT("State path")),
+		FCortexCommandInfo{ TEXT("export_tree"), TEXT("Export a StateTree as a declarative document for apply_tree") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path")),
+		FCortexCommandInfo{ TEXT("apply_tree"), TEXT("Reconcile a StateTree with a declarative document in one transaction") }
+			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path"))
+			.Required(TEXT("tree"), TEXT("object"), TEXT("Root state: name, type, selection_behavior, enabled, tag, linked_subtree (state path) or linked_asset (asset path), tasks, enter_conditions, transitions (by target path) and children; omitted lists are empty"))
+			.Optional(TEXT("compile"), TEXT("boolean"), TEXT("Compile once after applying (default true)"))
+			.Optional(TEXT("save"), TEXT("boolean"), TEXT("Persist package after applying"))
+			.OptionalExpectedFingerprint(),
 		FCortexCommandInfo{ TEXT("check_structure"), TEXT("Run read-only StateTree structure checks") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path")),
 		FCortexCommandInfo{ TEXT("validate_asset"), TEXT("Run mutating StateTree validation fixups") }
@@ -127,6 +152,16 @@ TArray<FCortexCommandInfo> FCortexStateTreeCommandHandler::GetSupportedCommands(
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path"))
 			.Optional(TEXT("save"), TEXT("boolean"), TEXT("Persist package after compile"))
 			.OptionalExpectedFingerprint(),
+		FCortexCommandInfo{ TEXT("validate_all"), TEXT("Run read-only structure checks across many StateTrees in parallel") }
+			.Optional(TEXT("path_filter"), TEXT("string"), TEXT("Content path to search recursively (default /Game)"))
+			.Optional(TEXT("asset_paths"), TEXT("array"), TEXT("Explicit asset paths; overrides path_filter"))
+			.Optional(TEXT("force"), TEXT("boolean"), TEXT("Recheck assets unchanged since their last passing run"))
+			.Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum assets to check")),
+		FCortexCommandInfo{ TEXT("compile_all"), TEXT("Check many StateTrees in parallel, then compile the ones that pass") }
+			.Optional(TEXT("path_filter"), TEXT("string"), TEXT("Content path to search recursively (default /Game)"))
+			.Optional(TEXT("asset_paths"), TEXT("array"), TEXT("Explicit asset paths; overrides path_filter"))
+			.Optional(TEXT("force"), TEXT("boolean"), TEXT("Recompile assets unchanged since their last successful compile"))
+			.Optional(TEXT("limit"), TEXT("number"), TEXT("Maximum assets to compile")),
 		FCortexCommandInfo{ TEXT("add_state"), TEXT("Add a StateTree state") }
 			.Required(TEXT("asset_path"), TEXT("string"), TEXT("Asset path"))
 			.Required(TEXT("name"), TEXT("string"), TEXT("New state display name"))
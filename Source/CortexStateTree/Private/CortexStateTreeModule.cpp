@@ -1,9 +1,12 @@
 #include "CortexStateTreeModule.h"
 
 #include "CortexCoreModule.h"
+#include "CortexSTEditSession.h"
+#include "CortexSTStateIndex.h"
 #include "CortexStateTreeCommandHandler.h"
 #include "ICortexCommandRegistry.h"
 #include "Modules/ModuleManager.h"
+#include "Operations/CortexSTValidationOps.h"
 
 DEFINE_LOG_CATEGORY(LogCortexStateTree);
 
@@ -27,6 +30,9 @@ void FCortexStateTreeModule::StartupModule()
 void FCortexStateTreeModule::ShutdownModule()
 {
 	UE_LOG(LogCortexStateTree, Log, TEXT("CortexStateTree module shutting down"));
+	FCortexSTEditSession::Reset();
+	FCortexSTValidationOps::ResetBulkCache();
+	FCortexSTStateIndex::Reset();
 }
 
 IMPLEMENT_MODULE(FCortexStateTreeModule, CortexStateTree)
@@ -2,9 +2,10 @@
 
 #include "CortexCommandRouter.h"
 #include "CortexSTCompat.h"
+#include "CortexSTEditSession.h"
+#include "CortexSTStateIndex.h"
 #include "CortexSTTypes.h"
 #include "CortexStateTreeModule.h"
-#include "Logging/TokenizedMessage.h"
 #include "Misc/PackageName.h"
 #include "Operations/CortexSTAssetOps.h"
 #include "Operations/CortexSTValidationOps.h"
@@ -119,123 +120,6 @@ bool TryParseEnumValue(
 	return true;
 }
 
-void CollectAllStates(const FCortexSTAssetContext& Context, TArray<FCortexSTStateRef>& OutStates)
-{
-	if (Context.EditorData == nullptr || Context.EditorData->SubTrees.Num() == 0 || Context.EditorData->SubTrees[0] == nullptr)
-	{
-		return;
-	}
-
-	CortexST::CollectStates(Context.EditorData->SubTrees[0], OutStates);
-}
-
-bool ResolveStateBySelector(
-	const FCortexSTAssetContext& Context,
-	const TSharedPtr<FJsonObject>& Params,
-	const TCHAR* IdField,
-	const TCHAR* PathField,
-	const bool bDefaultToRoot,
-	FCortexSTStateRef& OutState,
-	FCortexCommandResult& OutError)
-{
-	const UStateTreeState* RootState =
-		Context.EditorData != nullptr && Context.EditorData->SubTrees.Num() > 0
-			? Context.EditorData->SubTrees[0]
-			: nullptr;
-	if (RootState == nullptr)
-	{
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree has no root state: %s"), *Context.AssetPath));
-		return false;
-	}
-
-	FString StateId;
-	FString StatePath;
-	const bool bHasStateId = Params.IsValid() && Params->TryGetStringField(IdField, StateId) && !StateId.IsEmpty();
-	const bool bHasStatePath = Params.IsValid() && Params->TryGetStringField(PathField, StatePath) && !StatePath.IsEmpty();
-
-	if (bHasStateId && bHasStatePath)
-	{
-		OutError = MakeInvalidFieldError(
-			FString::Printf(TEXT("Specify exactly one of %s or %s"), IdField, PathField),
-			{ FString(IdField), FString(PathField) });
-		return false;
-	}
-
-	TArray<FCortexSTStateRef> States;
-	CollectAllStates(Context, States);
-
-	if (!bHasStateId && !bHasStatePath)
-	{
-		if (bDefaultToRoot && States.Num() > 0)
-		{
-			OutState = States[0];
-			return true;
-		}
-
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree state not found in asset: %s"), *Context.AssetPath));
-		return false;
-	}
-
-	if (bHasStateId)
-	{
-		for (const FCortexSTStateRef& StateRef : States)
-		{
-			if (StateRef.Id == StateId)
-			{
-				OutState = StateRef;
-				return true;
-			}
-		}
-
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree state not found: %s"), *StateId));
-		return false;
-	}
-
-	TArray<FCortexSTStateRef> Matches;
-	for (const FCortexSTStateRef& StateRef : States)
-	{
-		if (StateRef.Path == StatePath)
-		{
-			Matches.Add(StateRef);
-		}
-	}
-
-	if (Matches.Num() == 1)
-	{
-		OutState = Matches[0];
-		return true;
-	}
-
-	if (Matches.Num() > 1)
-	{
-		TArray<TSharedPtr<FJsonValue>> MatchingIds;
-		MatchingIds.Reserve(Matches.Num());
-		for (const FCortexSTStateRef& Match : Matches)
-		{
-			MatchingIds.Add(MakeShared<FJsonValueString>(Match.Id));
-		}
-
-		TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-		Details->SetArrayField(TEXT("matching_state_ids"), MatchingIds);
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::AmbiguousStatePath,
-			FString::Printf(TEXT("State path resolves to multiple states: %s"), *StatePath),
-			Details);
-		return false;
-	}
-
-	OutError = FCortexCommandRouter::Error(
-		CortexErrorCodes::StateTreeStateNotFound,
-		FString::Printf(TEXT("StateTree state path not found: %s"), *StatePath));
-	return false;
-}
-
 bool IsDescendantOf(const UStateTreeState* CandidateParent, const UStateTreeState* Ancestor)
 {
 	for (const UStateTreeState* Cursor = CandidateParent; Cursor != nullptr; Cursor = Cursor->Parent)
@@ -249,19 +133,6 @@ bool IsDescendantOf(const UStateTreeState* CandidateParent, const UStateTreeStat
 	return false;
 }
 
-void ReouterStateSubtree(UStateTreeState* State, UObject* NewOuter)
-{
-	if (State == nullptr || NewOuter == nullptr)
-	{
-		return;
-	}
-
-	if (State->GetOuter() != NewOuter)
-	{
-		State->Rename(nullptr, NewOuter, REN_DontCreateRedirectors | REN_DoNotDirty);
-	}
-}
-
 FCortexSTStateRef MakeStateRef(UStateTreeState* State)
 {
 	FCortexSTStateRef StateRef;
@@ -298,31 +169,7 @@ TSharedPtr<FJsonObject> BuildMutationSuccessData(
 	return Data;
 }
 
-FString LexToStringStateOpsSeverity(const EMessageSeverity::Type Severity)
-{
-	switch (Severity)
-	{
-	case EMessageSeverity::Error:
-		return TEXT("error");
-	case EMessageSeverity::PerformanceWarning:
-	case EMessageSeverity::Warning:
-		return TEXT("warning");
-	case EMessageSeverity::Info:
-	default:
-		return TEXT("info");
-	}
-}
-
-bool IsStateOpsErrorSeverity(const EMessageSeverity::Type Severity)
-{
-	return Severity == EMessageSeverity::Error || static_cast<int32>(Severity) < static_cast<int32>(EMessageSeverity::Error);
-}
-
-bool IsStateOpsWarningSeverity(const EMessageSeverity::Type Severity)
-{
-	return Severity == EMessageSeverity::PerformanceWarning || Severity == EMessageSeverity::Warning;
-}
-
+/** The shared compile payload, tagged with the state the mutation targeted. */
 TSharedPtr<FJsonObject> BuildCompileDiagnostics(
 	const FString& AssetPath,
 	const FString& StateId,
@@ -331,52 +178,10 @@ TSharedPtr<FJsonObject> BuildCompileDiagnostics(
 	const FStateTreeCompilerLog& CompileLog,
 	const bool bCompiled)
 {
-	TArray<TSharedRef<FTokenizedMessage>> TokenizedMessages = CortexSTCompat::GetCompilerLogTokenizedMessages(CompileLog);
-	TArray<TSharedPtr<FJsonValue>> Diagnostics;
-	Diagnostics.Reserve(TokenizedMessages.Num());
-
-	int32 ErrorCount = 0;
-	int32 WarningCount = 0;
-	for (const TSharedRef<FTokenizedMessage>& TokenizedMessage : TokenizedMessages)
-	{
-		const EMessageSeverity::Type Severity = TokenizedMessage->GetSeverity();
-		if (IsStateOpsErrorSeverity(Severity))
-		{
-			++ErrorCount;
-		}
-		else if (IsStateOpsWarningSeverity(Severity))
-		{
-			++WarningCount;
-		}
-
-		TSharedPtr<FJsonObject> Diagnostic = MakeShared<FJsonObject>();
-		Diagnostic->SetStringField(TEXT("severity"), LexToStringStateOpsSeverity(Severity));
-		Diagnostic->SetStringField(TEXT("message"), TokenizedMessage->ToText().ToString());
-		Diagnostics.Add(MakeShared<FJsonValueObject>(Diagnostic));
-	}
-
-	if (!bCompiled && ErrorCount == 0)
-	{
-		++ErrorCount;
-		TSharedPtr<FJsonObject> Diagnostic = MakeShared<FJsonObject>();
-		Diagnostic->SetStringField(TEXT("severity"), TEXT("error"));
-		Diagnostic->SetStringField(TEXT("message"), TEXT("StateTree compilation failed"));
-		Diagnostics.Add(MakeShared<FJsonValueObject>(Diagnostic));
-	}
-
-	const FString Status = ErrorCount > 0 ? TEXT("error") : (WarningCount > 0 ? TEXT("warning") : TEXT("success"));
-
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	TSharedPtr<FJsonObject> Data = FCortexSTValidationOps::BuildCompilePayload(AssetPath, StateTree, CompileLog, bCompiled);
 	Data->SetStringField(TEXT("state_id"), StateId);
 	Data->SetStringField(TEXT("state_path"), StatePath);
 	Data->SetBoolField(TEXT("updated"), true);
-	Data->SetStringField(TEXT("status"), Status);
-	Data->SetStringField(TEXT("compile_status"), Status);
-	Data->SetNumberField(TEXT("error_count"), ErrorCount);
-	Data->SetNumberField(TEXT("warning_count"), WarningCount);
-	Data->SetArrayField(TEXT("diagnostics"), Diagnostics);
-	Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
 	return Data;
 }
 
@@ -610,6 +415,23 @@ FCortexCommandResult FinalizeMutation(
 	const FString& StateId,
 	const FString& StatePath)
 {
+	if (FCortexSTEditSession::IsDeferring())
+	{
+		// Fixups, compile and save run once per asset before the batch responds; their outcome
+		// and the final fingerprint are reported under the batch's "finalize" entry for this asset
+		Context.StateTree->MarkPackageDirty();
+		FCortexSTEditSession::DeferFinalize(
+			Context.StateTree,
+			Context.AssetPath,
+			CortexST::GetOptionalBool(Params, TEXT("compile"), false),
+			CortexST::GetOptionalBool(Params, TEXT("save"), false));
+
+		TSharedPtr<FJsonObject> Data = BuildMutationSuccessData(
+			Context.AssetPath, StateId, StatePath, nullptr, CortexST::MakeFingerprint(Context.StateTree));
+		Data->SetBoolField(TEXT("finalize_deferred"), true);
+		return FCortexCommandRouter::Success(Data);
+	}
+
 	const FCortexCommandResult FixupResult = FCortexSTValidationOps::RunPostMutationFixups(Context.StateTree);
 	if (!FixupResult.bSuccess)
 	{
@@ -636,18 +458,8 @@ FCortexCommandResult FinalizeMutation(
 
 	if (CortexST::GetOptionalBool(Params, TEXT("compile"), false))
 	{
-		const bool bWasReady = Context.StateTree->IsReadyToRun();
-		const uint32 PreviousCompiledHash = Context.StateTree->LastCompiledEditorDataHash;
-
 		FStateTreeCompilerLog CompileLog;
-		const bool bCompiled = CortexSTCompat::CompileStateTree(Context.StateTree, CompileLog);
-
-		const bool bIsReady = Context.StateTree->IsReadyToRun();
-		const uint32 CurrentCompiledHash = Context.StateTree->LastCompiledEditorDataHash;
-		if (bWasReady != bIsReady || PreviousCompiledHash != CurrentCompiledHash)
-		{
-			Context.StateTree->MarkPackageDirty();
-		}
+		const bool bCompiled = FCortexSTValidationOps::CompileTree(Context.StateTree, CompileLog);
 
 		TSharedPtr<FJsonObject> CompileData = BuildCompileDiagnostics(
 			Context.AssetPath,
@@ -717,7 +529,7 @@ FCortexCommandResult FCortexSTStateOps::AddState(const TSharedPtr<FJsonObject>&
 	}
 
 	FCortexSTStateRef ParentStateRef;
-	if (!ResolveStateBySelector(Context, Params, TEXT("parent_state_id"), TEXT("parent_state_path"), true, ParentStateRef, Error))
+	if (!CortexST::ResolveStateBySelector(Context, Params, TEXT("parent_state_id"), TEXT("parent_state_path"), true, ParentStateRef, Error))
 	{
 		return Error;
 	}
@@ -732,6 +544,7 @@ FCortexCommandResult FCortexSTStateOps::AddState(const TSharedPtr<FJsonObject>&
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Add StateTree state %s"), *Name)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	ParentStateRef.State->Modify();
@@ -814,6 +627,8 @@ FCortexCommandResult FCortexSTStateOps::AddState(const TSharedPtr<FJsonObject>&
 		NewState->SelectionBehavior = SelectionBehavior;
 	}
 
+	FCortexSTStateIndex::Get().CommitSubtree(IndexEdit, NewState);
+
 	const FString StateId = NewState->ID.ToString(EGuidFormats::DigitsWithHyphens);
 	const FString StatePath = CortexSTCompat::GetStatePath(NewState);
 	UE_LOG(LogCortexStateTree, Log, TEXT("Added StateTree state %s to %s"), *StatePath, *Context.AssetPath);
@@ -867,6 +682,7 @@ FCortexCommandResult FCortexSTStateOps::RemoveState(const TSharedPtr<FJsonObject
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Remove StateTree state %s"), *RemovedStatePath)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	StateRef.Parent->Modify();
@@ -882,7 +698,8 @@ FCortexCommandResult FCortexSTStateOps::RemoveState(const TSharedPtr<FJsonObject
 
 	StateRef.Parent->Children.RemoveAt(RemovedIndex);
 	StateRef.State->Parent = nullptr;
-	ReouterStateSubtree(StateRef.State, GetTransientPackage());
+	CortexST::ReouterStateSubtree(StateRef.State, GetTransientPackage());
+	FCortexSTStateIndex::Get().CommitRemoval(IndexEdit, StateRef.State);
 
 	UE_LOG(LogCortexStateTree, Log, TEXT("Removed StateTree state %s from %s"), *RemovedStatePath, *Context.AssetPath);
 	return FinalizeMutation(Context, Params, RemovedStateId, RemovedStatePath);
@@ -923,10 +740,12 @@ FCortexCommandResult FCortexSTStateOps::RenameState(const TSharedPtr<FJsonObject
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Rename StateTree state %s"), *StateRef.Path)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	StateRef.State->Modify();
 	StateRef.State->Name = FName(*Name);
+	FCortexSTStateIndex::Get().CommitSubtree(IndexEdit, StateRef.State);
 
 	const FString StatePath = CortexSTCompat::GetStatePath(StateRef.State);
 	UE_LOG(LogCortexStateTree, Log, TEXT("Renamed StateTree state %s to %s"), *StateRef.Id, *StatePath);
@@ -971,7 +790,7 @@ FCortexCommandResult FCortexSTStateOps::MoveState(const TSharedPtr<FJsonObject>&
 	const bool bHasNewParentPath = Params.IsValid() && Params->HasField(TEXT("new_parent_state_path"));
 	if (bHasNewParentId || bHasNewParentPath)
 	{
-		if (!ResolveStateBySelector(Context, Params, TEXT("new_parent_state_id"), TEXT("new_parent_state_path"), false, TargetParentStateRef, Error))
+		if (!CortexST::ResolveStateBySelector(Context, Params, TEXT("new_parent_state_id"), TEXT("new_parent_state_path"), false, TargetParentStateRef, Error))
 		{
 			return Error;
 		}
@@ -1005,6 +824,7 @@ FCortexCommandResult FCortexSTStateOps::MoveState(const TSharedPtr<FJsonObject>&
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Move StateTree state %s"), *SourceStateRef.Path)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	SourceStateRef.State->Modify();
@@ -1032,7 +852,8 @@ FCortexCommandResult FCortexSTStateOps::MoveState(const TSharedPtr<FJsonObject>&
 
 	TargetArray.Insert(SourceStateRef.State, InsertIndex);
 	SourceStateRef.State->Parent = TargetParentStateRef.State;
-	ReouterStateSubtree(SourceStateRef.State, TargetParentStateRef.State);
+	CortexST::ReouterStateSubtree(SourceStateRef.State, TargetParentStateRef.State);
+	FCortexSTStateIndex::Get().CommitSubtree(IndexEdit, SourceStateRef.State);
 
 	const FString StatePath = CortexSTCompat::GetStatePath(SourceStateRef.State);
 	UE_LOG(LogCortexStateTree, Log, TEXT("Moved StateTree state %s to %s"), *SourceStateRef.Id, *StatePath);
@@ -1075,6 +896,7 @@ FCortexCommandResult FCortexSTStateOps::SetStateProperties(const TSharedPtr<FJso
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Set StateTree properties %s"), *StateRef.Path)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	StateRef.State->Modify();
@@ -1083,6 +905,7 @@ FCortexCommandResult FCortexSTStateOps::SetStateProperties(const TSharedPtr<FJso
 	{
 		return Error;
 	}
+	FCortexSTStateIndex::Get().CommitSubtree(IndexEdit, StateRef.State);
 
 	const FString StatePath = CortexSTCompat::GetStatePath(StateRef.State);
 	UE_LOG(LogCortexStateTree, Log, TEXT("Updated StateTree state properties %s"), *StatePath);
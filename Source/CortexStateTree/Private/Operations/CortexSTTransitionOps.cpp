@@ -2,9 +2,10 @@
 
 #include "CortexCommandRouter.h"
 #include "CortexSTCompat.h"
+#include "CortexSTEditSession.h"
+#include "CortexSTStateIndex.h"
 #include "CortexSTTypes.h"
 #include "CortexStateTreeModule.h"
-#include "Logging/TokenizedMessage.h"
 #include "Misc/PackageName.h"
 #include "Operations/CortexSTAssetOps.h"
 #include "Operations/CortexSTValidationOps.h"
@@ -76,123 +77,6 @@ FCortexCommandResult MakeTransitionInvalidFieldError(const FString& Message, con
 	return FCortexCommandRouter::Error(CortexErrorCodes::InvalidField, Message, Details);
 }
 
-TArray<FCortexSTStateRef> CollectAllTransitionStates(const FCortexSTAssetContext& Context)
-{
-	TArray<FCortexSTStateRef> States;
-	if (Context.EditorData == nullptr || Context.EditorData->SubTrees.Num() == 0 || Context.EditorData->SubTrees[0] == nullptr)
-	{
-		return States;
-	}
-
-	CortexST::CollectStates(Context.EditorData->SubTrees[0], States);
-	return States;
-}
-
-bool ResolveTransitionStateBySelector(
-	const FCortexSTAssetContext& Context,
-	const TSharedPtr<FJsonObject>& Params,
-	const TCHAR* IdField,
-	const TCHAR* PathField,
-	const bool bDefaultToRoot,
-	FCortexSTStateRef& OutState,
-	FCortexCommandResult& OutError)
-{
-	const UStateTreeState* RootState =
-		Context.EditorData != nullptr && Context.EditorData->SubTrees.Num() > 0
-			? Context.EditorData->SubTrees[0]
-			: nullptr;
-	if (RootState == nullptr)
-	{
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree has no root state: %s"), *Context.AssetPath));
-		return false;
-	}
-
-	FString StateId;
-	FString StatePath;
-	const bool bHasStateId = Params.IsValid() && Params->TryGetStringField(IdField, StateId) && !StateId.IsEmpty();
-	const bool bHasStatePath = Params.IsValid() && Params->TryGetStringField(PathField, StatePath) && !StatePath.IsEmpty();
-
-	if (bHasStateId && bHasStatePath)
-	{
-		OutError = MakeTransitionInvalidFieldError(
-			FString::Printf(TEXT("Specify exactly one of %s or %s"), IdField, PathField),
-			{ FString(IdField), FString(PathField) });
-		return false;
-	}
-
-	const TArray<FCortexSTStateRef> States = CollectAllTransitionStates(Context);
-	if (!bHasStateId && !bHasStatePath)
-	{
-		if (bDefaultToRoot && States.Num() > 0)
-		{
-			OutState = States[0];
-			return true;
-		}
-
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree state not found in asset: %s"), *Context.AssetPath));
-		return false;
-	}
-
-	if (bHasStateId)
-	{
-		for (const FCortexSTStateRef& StateRef : States)
-		{
-			if (StateRef.Id == StateId)
-			{
-				OutState = StateRef;
-				return true;
-			}
-		}
-
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::StateTreeStateNotFound,
-			FString::Printf(TEXT("StateTree state not found: %s"), *StateId));
-		return false;
-	}
-
-	TArray<FCortexSTStateRef> Matches;
-	for (const FCortexSTStateRef& StateRef : States)
-	{
-		if (StateRef.Path == StatePath)
-		{
-			Matches.Add(StateRef);
-		}
-	}
-
-	if (Matches.Num() == 1)
-	{
-		OutState = Matches[0];
-		return true;
-	}
-
-	if (Matches.Num() > 1)
-	{
-		TArray<TSharedPtr<FJsonValue>> MatchingIds;
-		MatchingIds.Reserve(Matches.Num());
-		for (const FCortexSTStateRef& Match : Matches)
-		{
-			MatchingIds.Add(MakeShared<FJsonValueString>(Match.Id));
-		}
-
-		TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-		Details->SetArrayField(TEXT("matching_state_ids"), MatchingIds);
-		OutError = FCortexCommandRouter::Error(
-			CortexErrorCodes::AmbiguousStatePath,
-			FString::Printf(TEXT("State path resolves to multiple states: %s"), *StatePath),
-			Details);
-		return false;
-	}
-
-	OutError = FCortexCommandRouter::Error(
-		CortexErrorCodes::StateTreeStateNotFound,
-		FString::Printf(TEXT("StateTree state path not found: %s"), *StatePath));
-	return false;
-}
-
 FString MakeTransitionLocalToken(const FString& OwnerStateId, const int32 TransitionIndex)
 {
 	return FString::Printf(TEXT("transition:%s:%d"), *OwnerStateId, TransitionIndex);
@@ -349,7 +233,7 @@ bool ResolveTargetStateFromParams(
 		return true;
 	}
 
-	if (!ResolveTransitionStateBySelector(Context, Params, IdField, PathField, false, OutTargetStateRef, OutError))
+	if (!CortexST::ResolveStateBySelector(Context, Params, IdField, PathField, false, OutTargetStateRef, OutError))
 	{
 		return false;
 	}
@@ -380,7 +264,7 @@ bool ResolveTransition(
 
 	if (bHasOwnerSelector)
 	{
-		if (!ResolveTransitionStateBySelector(Context, Params, TEXT("state_id"), TEXT("state_path"), false, SourceStateRef, OutError))
+		if (!CortexST::ResolveStateBySelector(Context, Params, TEXT("state_id"), TEXT("state_path"), false, SourceStateRef, OutError))
 		{
 			return false;
 		}
@@ -462,13 +346,13 @@ bool ResolveTransition(
 	}
 	else
 	{
-		const TArray<FCortexSTStateRef> States = CollectAllTransitionStates(Context);
-		for (const FCortexSTStateRef& CandidateStateRef : States)
+		FGuid TransitionGuid;
+		FCortexSTStateRef OwnerStateRef;
+		if (FGuid::ParseExact(TransitionId, EGuidFormats::DigitsWithHyphens, TransitionGuid)
+			&& FCortexSTStateIndex::Get().FindTransitionOwner(Context.EditorData, TransitionGuid, OwnerStateRef)
+			&& TryFindInState(OwnerStateRef))
 		{
-			if (TryFindInState(CandidateStateRef))
-			{
-				return true;
-			}
+			return true;
 		}
 	}
 
@@ -502,31 +386,7 @@ TSharedPtr<FJsonObject> BuildTransitionMutationSuccessData(
 	return Data;
 }
 
-FString LexToStringTransitionOpsSeverity(const EMessageSeverity::Type Severity)
-{
-	switch (Severity)
-	{
-	case EMessageSeverity::Error:
-		return TEXT("error");
-	case EMessageSeverity::PerformanceWarning:
-	case EMessageSeverity::Warning:
-		return TEXT("warning");
-	case EMessageSeverity::Info:
-	default:
-		return TEXT("info");
-	}
-}
-
-bool IsTransitionOpsErrorSeverity(const EMessageSeverity::Type Severity)
-{
-	return Severity == EMessageSeverity::Error || static_cast<int32>(Severity) < static_cast<int32>(EMessageSeverity::Error);
-}
-
-bool IsTransitionOpsWarningSeverity(const EMessageSeverity::Type Severity)
-{
-	return Severity == EMessageSeverity::PerformanceWarning || Severity == EMessageSeverity::Warning;
-}
-
+/** The shared compile payload, tagged with the transition the mutation targeted. */
 TSharedPtr<FJsonObject> BuildTransitionCompileDiagnostics(
 	const FString& AssetPath,
 	const FCortexSTTransitionRef& TransitionRef,
@@ -534,53 +394,11 @@ TSharedPtr<FJsonObject> BuildTransitionCompileDiagnostics(
 	const FStateTreeCompilerLog& CompileLog,
 	const bool bCompiled)
 {
-	TArray<TSharedRef<FTokenizedMessage>> TokenizedMessages = CortexSTCompat::GetCompilerLogTokenizedMessages(CompileLog);
-	TArray<TSharedPtr<FJsonValue>> Diagnostics;
-	Diagnostics.Reserve(TokenizedMessages.Num());
-
-	int32 ErrorCount = 0;
-	int32 WarningCount = 0;
-	for (const TSharedRef<FTokenizedMessage>& TokenizedMessage : TokenizedMessages)
-	{
-		const EMessageSeverity::Type Severity = TokenizedMessage->GetSeverity();
-		if (IsTransitionOpsErrorSeverity(Severity))
-		{
-			++ErrorCount;
-		}
-		else if (IsTransitionOpsWarningSeverity(Severity))
-		{
-			++WarningCount;
-		}
-
-		TSharedPtr<FJsonObject> Diagnostic = MakeShared<FJsonObject>();
-		Diagnostic->SetStringField(TEXT("severity"), LexToStringTransitionOpsSeverity(Severity));
-		Diagnostic->SetStringField(TEXT("message"), TokenizedMessage->ToText().ToString());
-		Diagnostics.Add(MakeShared<FJsonValueObject>(Diagnostic));
-	}
-
-	if (!bCompiled && ErrorCount == 0)
-	{
-		++ErrorCount;
-		TSharedPtr<FJsonObject> Diagnostic = MakeShared<FJsonObject>();
-		Diagnostic->SetStringField(TEXT("severity"), TEXT("error"));
-		Diagnostic->SetStringField(TEXT("message"), TEXT("StateTree compilation failed"));
-		Diagnostics.Add(MakeShared<FJsonValueObject>(Diagnostic));
-	}
-
-	const FString Status = ErrorCount > 0 ? TEXT("error") : (WarningCount > 0 ? TEXT("warning") : TEXT("success"));
-
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetStringField(TEXT("asset_path"), AssetPath);
+	TSharedPtr<FJsonObject> Data = FCortexSTValidationOps::BuildCompilePayload(AssetPath, StateTree, CompileLog, bCompiled);
 	Data->SetStringField(TEXT("transition_id"), TransitionRef.Id);
 	Data->SetStringField(TEXT("source_state_id"), TransitionRef.SourceStateRef.Id);
 	Data->SetStringField(TEXT("source_state_path"), TransitionRef.SourceStateRef.Path);
 	Data->SetBoolField(TEXT("updated"), true);
-	Data->SetStringField(TEXT("status"), Status);
-	Data->SetStringField(TEXT("compile_status"), Status);
-	Data->SetNumberField(TEXT("error_count"), ErrorCount);
-	Data->SetNumberField(TEXT("warning_count"), WarningCount);
-	Data->SetArrayField(TEXT("diagnostics"), Diagnostics);
-	Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
 	return Data;
 }
 
@@ -589,6 +407,27 @@ FCortexCommandResult FinalizeTransitionMutation(
 	const TSharedPtr<FJsonObject>& Params,
 	const FCortexSTTransitionRef& TransitionRef)
 {
+	if (FCortexSTEditSession::IsDeferring())
+	{
+		// Fixups, compile and save run once per asset before the batch responds; their outcome
+		// and the final fingerprint are reported under the batch's "finalize" entry for this asset
+		Context.StateTree->MarkPackageDirty();
+		FCortexSTEditSession::DeferFinalize(
+			Context.StateTree,
+			Context.AssetPath,
+			CortexST::GetOptionalBool(Params, TEXT("compile"), false),
+			CortexST::GetOptionalBool(Params, TEXT("save"), false));
+
+		TSharedPtr<FJsonObject> Data = BuildTransitionMutationSuccessData(
+			Context.AssetPath,
+			TransitionRef.Id,
+			TransitionRef.SourceStateRef,
+			nullptr,
+			CortexST::MakeFingerprint(Context.StateTree));
+		Data->SetBoolField(TEXT("finalize_deferred"), true);
+		return FCortexCommandRouter::Success(Data);
+	}
+
 	const FCortexCommandResult FixupResult = FCortexSTValidationOps::RunPostMutationFixups(Context.StateTree);
 	if (!FixupResult.bSuccess)
 	{
@@ -620,18 +459,8 @@ FCortexCommandResult FinalizeTransitionMutation(
 
 	if (CortexST::GetOptionalBool(Params, TEXT("compile"), false))
 	{
-		const bool bWasReady = Context.StateTree->IsReadyToRun();
-		const uint32 PreviousCompiledHash = Context.StateTree->LastCompiledEditorDataHash;
-
 		FStateTreeCompilerLog CompileLog;
-		const bool bCompiled = CortexSTCompat::CompileStateTree(Context.StateTree, CompileLog);
-
-		const bool bIsReady = Context.StateTree->IsReadyToRun();
-		const uint32 CurrentCompiledHash = Context.StateTree->LastCompiledEditorDataHash;
-		if (bWasReady != bIsReady || PreviousCompiledHash != CurrentCompiledHash)
-		{
-			Context.StateTree->MarkPackageDirty();
-		}
+		const bool bCompiled = FCortexSTValidationOps::CompileTree(Context.StateTree, CompileLog);
 
 		TSharedPtr<FJsonObject> CompileData = BuildTransitionCompileDiagnostics(
 			Context.AssetPath,
@@ -808,7 +637,7 @@ FCortexCommandResult FCortexSTTransitionOps::AddTransition(const TSharedPtr<FJso
 	}
 
 	FCortexSTStateRef SourceStateRef;
-	if (!ResolveTransitionStateBySelector(Context, Params, TEXT("source_state_id"), TEXT("source_state_path"), true, SourceStateRef, Error))
+	if (!CortexST::ResolveStateBySelector(Context, Params, TEXT("source_state_id"), TEXT("source_state_path"), true, SourceStateRef, Error))
 	{
 		return Error;
 	}
@@ -874,6 +703,7 @@ FCortexCommandResult FCortexSTTransitionOps::AddTransition(const TSharedPtr<FJso
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Add StateTree transition %s -> %s"), *SourceStateRef.Path, *TargetStateRef.Path)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	SourceStateRef.State->Modify();
@@ -888,6 +718,7 @@ FCortexCommandResult FCortexSTTransitionOps::AddTransition(const TSharedPtr<FJso
 	Transition.bTransitionEnabled = true;
 	Transition.State = TargetStateRef.State->GetLinkToState();
 	Transition.State.LinkType = EStateTreeTransitionType::GotoState;
+	FCortexSTStateIndex::Get().CommitTransitions(IndexEdit, SourceStateRef.State);
 
 	FCortexSTTransitionRef TransitionRef;
 	TransitionRef.Id = GetTransitionIdentifier(SourceStateRef, Transition, SourceStateRef.State->Transitions.Num() - 1);
@@ -934,6 +765,7 @@ FCortexCommandResult FCortexSTTransitionOps::RemoveTransition(const TSharedPtr<F
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Remove StateTree transition %s"), *TransitionRef.Id)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	TransitionRef.SourceStateRef.State->Modify();
@@ -946,6 +778,7 @@ FCortexCommandResult FCortexSTTransitionOps::RemoveTransition(const TSharedPtr<F
 	}
 
 	TransitionRef.SourceStateRef.State->Transitions.RemoveAt(TransitionRef.Index);
+	FCortexSTStateIndex::Get().CommitTransitions(IndexEdit, TransitionRef.SourceStateRef.State);
 
 	UE_LOG(
 		LogCortexStateTree,
@@ -991,6 +824,7 @@ FCortexCommandResult FCortexSTTransitionOps::SetTransitionProperties(const TShar
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Set StateTree transition properties %s"), *TransitionRef.Id)));
 
+	const FCortexSTStateIndex::FEdit IndexEdit = FCortexSTStateIndex::Get().BeginEdit(Context.EditorData);
 	Context.StateTree->Modify();
 	Context.EditorData->Modify();
 	TransitionRef.SourceStateRef.State->Modify();
@@ -999,6 +833,7 @@ FCortexCommandResult FCortexSTTransitionOps::SetTransitionProperties(const TShar
 	{
 		return Error;
 	}
+	FCortexSTStateIndex::Get().CommitUnchanged(IndexEdit);
 
 	UE_LOG(
 		LogCortexStateTree,
@@ -0,0 +1,1092 @@
+#include "Operations/CortexSTTreeOps.h"
+
+#include "CortexCommandRouter.h"
+#include "CortexSTCompat.h"
+#include "CortexSTEditSession.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeModule.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/PackageName.h"
+#include "Operations/CortexSTAssetOps.h"
+#include "Operations/CortexSTValidationOps.h"
+#include "ScopedTransaction.h"
+#include "StateTree.h"
+#include "StateTreeCompilerLog.h"
+#include "StateTreeConditionBase.h"
+#include "StateTreeEditorData.h"
+#include "StateTreeEditorNode.h"
+#include "StateTreeNodeBase.h"
+#include "StateTreeState.h"
+#include "StateTreeTaskBase.h"
+#include "StateTreeTypes.h"
+
+namespace
+{
+struct FCortexSTDesiredTransition
+{
+	EStateTreeTransitionTrigger Trigger = EStateTreeTransitionTrigger::OnStateCompleted;
+	EStateTreeTransitionPriority Priority = EStateTreeTransitionPriority::Normal;
+	EStateTreeTransitionType Type = EStateTreeTransitionType::GotoState;
+	FString TargetPath;
+	FGameplayTag EventTag;
+	bool bEnabled = true;
+};
+
+/** One state of an apply_tree document, fully parsed and checked before anything is mutated. */
+struct FCortexSTDesiredState
+{
+	FName Name;
+	FString Path;
+	TOptional<EStateTreeStateType> Type;
+	TOptional<EStateTreeStateSelectionBehavior> SelectionBehavior;
+	TOptional<bool> bEnabled;
+	TOptional<FGameplayTag> Tag;
+	/** Document path of the subtree a Linked state runs; empty clears the link */
+	TOptional<FString> LinkedSubtreePath;
+	/** StateTree a LinkedAsset state runs; null clears the link */
+	TOptional<UStateTree*> LinkedAsset;
+	TArray<const UScriptStruct*> Tasks;
+	TArray<const UScriptStruct*> EnterConditions;
+	TArray<FCortexSTDesiredTransition> Transitions;
+	TArray<FCortexSTDesiredState> Children;
+};
+
+struct FCortexSTApplyStats
+{
+	int32 StatesAdded = 0;
+	int32 StatesRemoved = 0;
+	int32 StatesUpdated = 0;
+	int32 TransitionsAdded = 0;
+	int32 TransitionsRemoved = 0;
+	int32 NodesAdded = 0;
+	int32 NodesRemoved = 0;
+
+	int32 GetChangeCount() const
+	{
+		return StatesAdded + StatesRemoved + StatesUpdated;
+	}
+
+	TSharedPtr<FJsonObject> ToJson() const
+	{
+		TSharedPtr<FJsonObject> Changes = MakeShared<FJsonObject>();
+		Changes->SetNumberField(TEXT("states_added"), StatesAdded);
+		Changes->SetNumberField(TEXT("states_removed"), StatesRemoved);
+		Changes->SetNumberField(TEXT("states_updated"), StatesUpdated);
+		Changes->SetNumberField(TEXT("transitions_added"), TransitionsAdded);
+		Changes->SetNumberField(TEXT("transitions_removed"), TransitionsRemoved);
+		Changes->SetNumberField(TEXT("nodes_added"), NodesAdded);
+		Changes->SetNumberField(TEXT("nodes_removed"), NodesRemoved);
+		return Changes;
+	}
+};
+
+/** Objects are only Modify()'d when something on them actually changes, so a no-op apply leaves the asset clean. */
+struct FCortexSTApplyContext
+{
+	FCortexSTAssetContext Asset;
+	TSet<UObject*> Touched;
+	TMap<FString, UStateTreeState*> StatesByPath;
+	TSet<UStateTreeState*> NewStates;
+	FCortexSTApplyStats Stats;
+
+	void Touch(UObject* Object)
+	{
+		if (Touched.Num() == 0)
+		{
+			Asset.StateTree->Modify();
+			Asset.EditorData->Modify();
+			Touched.Add(Asset.StateTree);
+			Touched.Add(Asset.EditorData);
+		}
+
+		bool bAlreadyTouched = false;
+		Touched.Add(Object, &bAlreadyTouched);
+		if (!bAlreadyTouched)
+		{
+			Object->Modify();
+		}
+	}
+};
+
+const TArray<FString>& GetAllowedDocumentStateFields()
+{
+	static const TArray<FString> Fields = {
+		TEXT("name"),
+		TEXT("type"),
+		TEXT("selection_behavior"),
+		TEXT("enabled"),
+		TEXT("tag"),
+		TEXT("linked_subtree"),
+		TEXT("linked_asset"),
+		TEXT("tasks"),
+		TEXT("enter_conditions"),
+		TEXT("transitions"),
+		TEXT("children"),
+	};
+	return Fields;
+}
+
+const TArray<FString>& GetAllowedDocumentTransitionFields()
+{
+	static const TArray<FString> Fields = {
+		TEXT("trigger"),
+		TEXT("priority"),
+		TEXT("type"),
+		TEXT("target"),
+		TEXT("event_tag"),
+		TEXT("enabled"),
+	};
+	return Fields;
+}
+
+FCortexCommandResult MakeDocumentError(const FString& Location, const FString& Message)
+{
+	return FCortexCommandRouter::Error(
+		CortexErrorCodes::InvalidField,
+		FString::Printf(TEXT("%s: %s"), *Location, *Message));
+}
+
+bool CheckAllowedFields(
+	const TSharedPtr<FJsonObject>& Object,
+	const TArray<FString>& AllowedFields,
+	const FString& Location,
+	FCortexCommandResult& OutError)
+{
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Object->Values)
+	{
+		if (!AllowedFields.Contains(Entry.Key))
+		{
+			TArray<TSharedPtr<FJsonValue>> AllowedValues;
+			for (const FString& AllowedField : AllowedFields)
+			{
+				AllowedValues.Add(MakeShared<FJsonValueString>(AllowedField));
+			}
+			TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+			Details->SetArrayField(TEXT("allowed_fields"), AllowedValues);
+
+			OutError = FCortexCommandRouter::Error(
+				CortexErrorCodes::InvalidField,
+				FString::Printf(TEXT("%s: unsupported field %s"), *Location, *Entry.Key),
+				Details);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename TEnum>
+bool TryParseDocumentEnum(
+	const TSharedPtr<FJsonObject>& Object,
+	const TCHAR* FieldName,
+	const FString& Location,
+	TEnum& OutValue,
+	FCortexCommandResult& OutError)
+{
+	FString RawValue;
+	if (!Object->TryGetStringField(FieldName, RawValue))
+	{
+		OutError = MakeDocumentError(Location, FString::Printf(TEXT("%s must be a string"), FieldName));
+		return false;
+	}
+
+	const UEnum* Enum = StaticEnum<TEnum>();
+	int64 ResolvedValue = Enum != nullptr ? Enum->GetValueByNameString(RawValue) : INDEX_NONE;
+	if (ResolvedValue == INDEX_NONE && Enum != nullptr && !RawValue.Contains(TEXT("::")))
+	{
+		ResolvedValue = Enum->GetValueByNameString(FString::Printf(TEXT("%s::%s"), *Enum->GetName(), *RawValue));
+	}
+
+	if (ResolvedValue == INDEX_NONE)
+	{
+		OutError = MakeDocumentError(Location, FString::Printf(TEXT("invalid %s value: %s"), FieldName, *RawValue));
+		return false;
+	}
+
+	OutValue = static_cast<TEnum>(ResolvedValue);
+	return true;
+}
+
+template<typename TEnum>
+FString LexToStringDocumentEnum(const TEnum Value)
+{
+	const UEnum* Enum = StaticEnum<TEnum>();
+	return Enum != nullptr
+		? Enum->GetNameStringByValue(static_cast<int64>(Value)).Replace(*FString::Printf(TEXT("%s::"), *Enum->GetName()), TEXT(""))
+		: FString();
+}
+
+bool TryParseDocumentTag(
+	const TSharedPtr<FJsonObject>& Object,
+	const TCHAR* FieldName,
+	const FString& Location,
+	FGameplayTag& OutTag,
+	FCortexCommandResult& OutError)
+{
+	FString TagString;
+	if (!Object->TryGetStringField(FieldName, TagString))
+	{
+		OutError = MakeDocumentError(Location, FString::Printf(TEXT("%s must be a string"), FieldName));
+		return false;
+	}
+
+	return CortexST::ValidateGameplayTagString(TagString, OutTag, OutError);
+}
+
+FString TagToDocumentString(const FGameplayTag& Tag)
+{
+	return Tag.IsValid() ? Tag.ToString() : FString();
+}
+
+bool ParseNodeStructs(
+	const TSharedPtr<FJsonObject>& Object,
+	const TCHAR* FieldName,
+	const UScriptStruct* BaseStruct,
+	const FString& Location,
+	TArray<const UScriptStruct*>& OutStructs,
+	FCortexCommandResult& OutError)
+{
+	if (!Object->HasField(FieldName))
+	{
+		return true;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+	if (!Object->TryGetArrayField(FieldName, Values))
+	{
+		OutError = MakeDocumentError(Location, FString::Printf(TEXT("%s must be an array of struct paths"), FieldName));
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *Values)
+	{
+		FString StructName;
+		if (!Value.IsValid() || !Value->TryGetString(StructName) || StructName.IsEmpty())
+		{
+			OutError = MakeDocumentError(Location, FString::Printf(TEXT("%s entries must be struct paths"), FieldName));
+			return false;
+		}
+
+		const UScriptStruct* NodeStruct = StructName.Contains(TEXT("."))
+			? FindObject<UScriptStruct>(nullptr, *StructName)
+			: FindFirstObject<UScriptStruct>(*StructName, EFindFirstObjectOptions::NativeFirst);
+		if (NodeStruct == nullptr || !NodeStruct->IsChildOf(BaseStruct))
+		{
+			OutError = MakeDocumentError(
+				Location,
+				FString::Printf(TEXT("%s is not a %s struct"), *StructName, *BaseStruct->GetName()));
+			return false;
+		}
+
+		OutStructs.Add(NodeStruct);
+	}
+
+	return true;
+}
+
+bool ParseDesiredTransition(
+	const TSharedPtr<FJsonObject>& Object,
+	const FString& Location,
+	FCortexSTDesiredTransition& OutTransition,
+	FCortexCommandResult& OutError)
+{
+	if (!CheckAllowedFields(Object, GetAllowedDocumentTransitionFields(), Location, OutError))
+	{
+		return false;
+	}
+
+	if (Object->HasField(TEXT("trigger"))
+		&& !TryParseDocumentEnum(Object, TEXT("trigger"), Location, OutTransition.Trigger, OutError))
+	{
+		return false;
+	}
+	if (Object->HasField(TEXT("priority"))
+		&& !TryParseDocumentEnum(Object, TEXT("priority"), Location, OutTransition.Priority, OutError))
+	{
+		return false;
+	}
+	if (Object->HasField(TEXT("type"))
+		&& !TryParseDocumentEnum(Object, TEXT("type"), Location, OutTransition.Type, OutError))
+	{
+		return false;
+	}
+	if (Object->HasField(TEXT("event_tag"))
+		&& !TryParseDocumentTag(Object, TEXT("event_tag"), Location, OutTransition.EventTag, OutError))
+	{
+		return false;
+	}
+	if (Object->HasField(TEXT("enabled")) && !Object->TryGetBoolField(TEXT("enabled"), OutTransition.bEnabled))
+	{
+		OutError = MakeDocumentError(Location, TEXT("enabled must be a boolean"));
+		return false;
+	}
+
+	if (OutTransition.Type == EStateTreeTransitionType::GotoState
+		&& (!Object->TryGetStringField(TEXT("target"), OutTransition.TargetPath) || OutTransition.TargetPath.IsEmpty()))
+	{
+		OutError = MakeDocumentError(Location, TEXT("GotoState transitions need a target state path"));
+		return false;
+	}
+
+	return true;
+}
+
+bool ParseDesiredState(
+	const TSharedPtr<FJsonObject>& Object,
+	const FString& ParentPath,
+	TSet<FString>& InOutPaths,
+	FCortexSTDesiredState& OutState,
+	FCortexCommandResult& OutError)
+{
+	const FString ParentLocation = ParentPath.IsEmpty() ? FString(TEXT("tree")) : ParentPath;
+
+	FString Name;
+	if (!Object->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+	{
+		OutError = MakeDocumentError(ParentLocation, TEXT("every state needs a non-empty name"));
+		return false;
+	}
+
+	OutState.Name = FName(*Name);
+	OutState.Path = ParentPath.IsEmpty() ? Name : FString::Printf(TEXT("%s/%s"), *ParentPath, *Name);
+	const FString& Location = OutState.Path;
+
+	if (!CheckAllowedFields(Object, GetAllowedDocumentStateFields(), Location, OutError))
+	{
+		return false;
+	}
+
+	// Sibling names are the document's identity for states, so they must be unique
+	bool bDuplicatePath = false;
+	InOutPaths.Add(OutState.Path, &bDuplicatePath);
+	if (bDuplicatePath)
+	{
+		OutError = MakeDocumentError(ParentLocation, FString::Printf(TEXT("duplicate child state name %s"), *Name));
+		return false;
+	}
+
+	if (Object->HasField(TEXT("type")))
+	{
+		EStateTreeStateType StateType = EStateTreeStateType::State;
+		if (!TryParseDocumentEnum(Object, TEXT("type"), Location, StateType, OutError))
+		{
+			return false;
+		}
+		OutState.Type = StateType;
+	}
+
+	// Link targets only mean something for the matching type, so they must be stated alongside it
+	if (Object->HasField(TEXT("linked_subtree")))
+	{
+		FString LinkedPath;
+		if (OutState.Type.Get(EStateTreeStateType::State) != EStateTreeStateType::Linked)
+		{
+			OutError = MakeDocumentError(Location, TEXT("linked_subtree requires type Linked"));
+			return false;
+		}
+		if (!Object->TryGetStringField(TEXT("linked_subtree"), LinkedPath))
+		{
+			OutError = MakeDocumentError(Location, TEXT("linked_subtree must be a state path"));
+			return false;
+		}
+		OutState.LinkedSubtreePath = LinkedPath;
+	}
+
+	if (Object->HasField(TEXT("linked_asset")))
+	{
+		FString LinkedAssetPath;
+		if (OutState.Type.Get(EStateTreeStateType::State) != EStateTreeStateType::LinkedAsset)
+		{
+			OutError = MakeDocumentError(Location, TEXT("linked_asset requires type LinkedAsset"));
+			return false;
+		}
+		if (!Object->TryGetStringField(TEXT("linked_asset"), LinkedAssetPath))
+		{
+			OutError = MakeDocumentError(Location, TEXT("linked_asset must be a StateTree asset path"));
+			return false;
+		}
+
+		UStateTree* LinkedTree = nullptr;
+		if (!LinkedAssetPath.IsEmpty())
+		{
+			LinkedTree = LoadObject<UStateTree>(nullptr, *LinkedAssetPath);
+			if (LinkedTree == nullptr)
+			{
+				OutError = MakeDocumentError(Location, FString::Printf(TEXT("linked_asset %s is not a StateTree"), *LinkedAssetPath));
+				return false;
+			}
+		}
+		OutState.LinkedAsset = LinkedTree;
+	}
+
+	if (Object->HasField(TEXT("selection_behavior")))
+	{
+		EStateTreeStateSelectionBehavior SelectionBehavior = EStateTreeStateSelectionBehavior::TrySelectChildrenInOrder;
+		if (!TryParseDocumentEnum(Object, TEXT("selection_behavior"), Location, SelectionBehavior, OutError))
+		{
+			return false;
+		}
+		OutState.SelectionBehavior = SelectionBehavior;
+	}
+
+	if (Object->HasField(TEXT("enabled")))
+	{
+		bool bEnabled = true;
+		if (!Object->TryGetBoolField(TEXT("enabled"), bEnabled))
+		{
+			OutError = MakeDocumentError(Location, TEXT("enabled must be a boolean"));
+			return false;
+		}
+		OutState.bEnabled = bEnabled;
+	}
+
+	if (Object->HasField(TEXT("tag")))
+	{
+		FGameplayTag Tag;
+		if (!TryParseDocumentTag(Object, TEXT("tag"), Location, Tag, OutError))
+		{
+			return false;
+		}
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+		if (Tag.IsValid())
+		{
+			OutError = MakeDocumentError(Location, TEXT("tag requires UE 5.5+ (UStateTreeState has no gameplay tag on this engine version)"));
+			return false;
+		}
+#else
+		OutState.Tag = Tag;
+#endif
+	}
+
+	if (!ParseNodeStructs(Object, TEXT("tasks"), FStateTreeTaskBase::StaticStruct(), Location, OutState.Tasks, OutError)
+		|| !ParseNodeStructs(Object, TEXT("enter_conditions"), FStateTreeConditionBase::StaticStruct(), Location, OutState.EnterConditions, OutError))
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* TransitionValues = nullptr;
+	if (Object->HasField(TEXT("transitions")) && !Object->TryGetArrayField(TEXT("transitions"), TransitionValues))
+	{
+		OutError = MakeDocumentError(Location, TEXT("transitions must be an array"));
+		return false;
+	}
+	if (TransitionValues != nullptr)
+	{
+		for (int32 TransitionIndex = 0; TransitionIndex < TransitionValues->Num(); ++TransitionIndex)
+		{
+			const FString TransitionLocation = FString::Printf(TEXT("%s transition %d"), *Location, TransitionIndex);
+			const TSharedPtr<FJsonObject>* TransitionObject = nullptr;
+			if (!(*TransitionValues)[TransitionIndex]->TryGetObject(TransitionObject))
+			{
+				OutError = MakeDocumentError(TransitionLocation, TEXT("transition must be an object"));
+				return false;
+			}
+
+			if (!ParseDesiredTransition(*TransitionObject, TransitionLocation, OutState.Transitions.AddDefaulted_GetRef(), OutError))
+			{
+				return false;
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ChildValues = nullptr;
+	if (Object->HasField(TEXT("children")) && !Object->TryGetArrayField(TEXT("children"), ChildValues))
+	{
+		OutError = MakeDocumentError(Location, TEXT("children must be an array"));
+		return false;
+	}
+	if (ChildValues != nullptr)
+	{
+		for (const TSharedPtr<FJsonValue>& ChildValue : *ChildValues)
+		{
+			const TSharedPtr<FJsonObject>* ChildObject = nullptr;
+			if (!ChildValue->TryGetObject(ChildObject))
+			{
+				OutError = MakeDocumentError(Location, TEXT("children entries must be objects"));
+				return false;
+			}
+
+			if (!ParseDesiredState(*ChildObject, OutState.Path, InOutPaths, OutState.Children.AddDefaulted_GetRef(), OutError))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CheckDocumentTargets(const FCortexSTDesiredState& State, const TSet<FString>& Paths, FCortexCommandResult& OutError)
+{
+	if (State.LinkedSubtreePath.IsSet() && !State.LinkedSubtreePath->IsEmpty() && !Paths.Contains(State.LinkedSubtreePath.GetValue()))
+	{
+		OutError = MakeDocumentError(
+			State.Path,
+			FString::Printf(TEXT("linked_subtree %s is not a state in the document"), *State.LinkedSubtreePath.GetValue()));
+		return false;
+	}
+
+	for (int32 TransitionIndex = 0; TransitionIndex < State.Transitions.Num(); ++TransitionIndex)
+	{
+		const FCortexSTDesiredTransition& Transition = State.Transitions[TransitionIndex];
+		if (Transition.Type == EStateTreeTransitionType::GotoState && !Paths.Contains(Transition.TargetPath))
+		{
+			OutError = MakeDocumentError(
+				FString::Printf(TEXT("%s transition %d"), *State.Path, TransitionIndex),
+				FString::Printf(TEXT("target %s is not a state in the document"), *Transition.TargetPath));
+			return false;
+		}
+	}
+
+	for (const FCortexSTDesiredState& Child : State.Children)
+	{
+		if (!CheckDocumentTargets(Child, Paths, OutError))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FStateTreeEditorNode MakeEditorNode(UStateTreeState* State, const UScriptStruct* NodeStruct)
+{
+	FStateTreeEditorNode EditorNode;
+	EditorNode.ID = FGuid::NewGuid();
+	EditorNode.Node.InitializeAs(NodeStruct);
+
+	// Same instance data setup the editor does when a node is picked in the details panel
+	if (const FStateTreeNodeBase* NodeBase = EditorNode.Node.GetPtr<FStateTreeNodeBase>())
+	{
+		if (const UScriptStruct* InstanceStruct = Cast<const UScriptStruct>(NodeBase->GetInstanceDataType()))
+		{
+			EditorNode.Instance.InitializeAs(InstanceStruct);
+		}
+		else if (const UClass* InstanceClass = Cast<const UClass>(NodeBase->GetInstanceDataType()))
+		{
+			EditorNode.InstanceObject = NewObject<UObject>(State, InstanceClass, NAME_None, RF_Transactional);
+		}
+	}
+
+	return EditorNode;
+}
+
+/** Keeps existing nodes (and their instance data) whose struct is still wanted, in document order. */
+bool ApplyNodes(
+	FCortexSTApplyContext& Context,
+	UStateTreeState* State,
+	TArray<FStateTreeEditorNode>& Nodes,
+	const TArray<const UScriptStruct*>& DesiredStructs)
+{
+	bool bSame = Nodes.Num() == DesiredStructs.Num();
+	for (int32 NodeIndex = 0; bSame && NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		bSame = Nodes[NodeIndex].Node.GetScriptStruct() == DesiredStructs[NodeIndex];
+	}
+	if (bSame)
+	{
+		return false;
+	}
+
+	Context.Touch(State);
+
+	TArray<FStateTreeEditorNode> ExistingNodes = MoveTemp(Nodes);
+	TBitArray<> Used(false, ExistingNodes.Num());
+	Nodes.Reset(DesiredStructs.Num());
+
+	for (const UScriptStruct* NodeStruct : DesiredStructs)
+	{
+		int32 MatchIndex = INDEX_NONE;
+		for (int32 ExistingIndex = 0; ExistingIndex < ExistingNodes.Num(); ++ExistingIndex)
+		{
+			if (!Used[ExistingIndex] && ExistingNodes[ExistingIndex].Node.GetScriptStruct() == NodeStruct)
+			{
+				MatchIndex = ExistingIndex;
+				break;
+			}
+		}
+
+		if (MatchIndex != INDEX_NONE)
+		{
+			Used[MatchIndex] = true;
+			Nodes.Add(MoveTemp(ExistingNodes[MatchIndex]));
+		}
+		else
+		{
+			Nodes.Add(MakeEditorNode(State, NodeStruct));
+			++Context.Stats.NodesAdded;
+		}
+	}
+
+	Context.Stats.NodesRemoved += ExistingNodes.Num() - Used.CountSetBits();
+	return true;
+}
+
+bool ApplyStateProperties(FCortexSTApplyContext& Context, UStateTreeState* State, const FCortexSTDesiredState& Desired)
+{
+	bool bChanged = false;
+
+	if (State->Name != Desired.Name)
+	{
+		Context.Touch(State);
+		State->Name = Desired.Name;
+		bChanged = true;
+	}
+	if (Desired.Type.IsSet() && State->Type != Desired.Type.GetValue())
+	{
+		Context.Touch(State);
+		State->Type = Desired.Type.GetValue();
+		bChanged = true;
+	}
+	if (Desired.SelectionBehavior.IsSet() && State->SelectionBehavior != Desired.SelectionBehavior.GetValue())
+	{
+		Context.Touch(State);
+		State->SelectionBehavior = Desired.SelectionBehavior.GetValue();
+		bChanged = true;
+	}
+	if (Desired.bEnabled.IsSet() && State->bEnabled != Desired.bEnabled.GetValue())
+	{
+		Context.Touch(State);
+		State->bEnabled = Desired.bEnabled.GetValue();
+		bChanged = true;
+	}
+	if (Desired.Tag.IsSet() && CortexSTCompat::GetStateTag(State) != Desired.Tag.GetValue())
+	{
+		Context.Touch(State);
+		CortexSTCompat::SetStateTag(*State, Desired.Tag.GetValue());
+		bChanged = true;
+	}
+	if (Desired.LinkedAsset.IsSet() && State->LinkedAsset != Desired.LinkedAsset.GetValue())
+	{
+		Context.Touch(State);
+		State->SetLinkedStateAsset(Desired.LinkedAsset.GetValue());
+		bChanged = true;
+	}
+
+	bChanged |= ApplyNodes(Context, State, State->Tasks, Desired.Tasks);
+	bChanged |= ApplyNodes(Context, State, State->EnterConditions, Desired.EnterConditions);
+	return bChanged;
+}
+
+int32 DetachStateSubtree(FCortexSTApplyContext& Context, UStateTreeState* State)
+{
+	int32 RemovedCount = 0;
+	TArray<UStateTreeState*> Stack;
+	Stack.Add(State);
+	while (Stack.Num() > 0)
+	{
+		UStateTreeState* Current = Stack.Pop(EAllowShrinking::No);
+		if (Current == nullptr)
+		{
+			continue;
+		}
+		++RemovedCount;
+		for (UStateTreeState* ChildState : Current->Children)
+		{
+			Stack.Add(ChildState);
+		}
+	}
+
+	Context.Touch(State);
+	State->Parent = nullptr;
+	CortexST::ReouterStateSubtree(State, GetTransientPackage());
+	return RemovedCount;
+}
+
+void ApplyStateSubtree(FCortexSTApplyContext& Context, UStateTreeState* State, const FCortexSTDesiredState& Desired)
+{
+	Context.StatesByPath.Add(Desired.Path, State);
+	bool bChanged = ApplyStateProperties(Context, State, Desired);
+
+	// Children are matched by name under their parent; unmatched names are added or removed
+	TArray<TObjectPtr<UStateTreeState>> NewChildren;
+	NewChildren.Reserve(Desired.Children.Num());
+	TSet<UStateTreeState*> Kept;
+
+	for (const FCortexSTDesiredState& DesiredChild : Desired.Children)
+	{
+		UStateTreeState* Child = nullptr;
+		for (UStateTreeState* Candidate : State->Children)
+		{
+			if (Candidate != nullptr && !Kept.Contains(Candidate) && Candidate->Name == DesiredChild.Name)
+			{
+				Child = Candidate;
+				break;
+			}
+		}
+
+		if (Child == nullptr)
+		{
+			Context.Touch(State);
+			Child = NewObject<UStateTreeState>(State, FName(), RF_Transactional);
+			Context.Touch(Child);
+			Child->Name = DesiredChild.Name;
+			Child->Parent = State;
+			Context.NewStates.Add(Child);
+			++Context.Stats.StatesAdded;
+		}
+
+		Kept.Add(Child);
+		NewChildren.Add(Child);
+	}
+
+	if (NewChildren != State->Children)
+	{
+		Context.Touch(State);
+		for (UStateTreeState* OldChild : State->Children)
+		{
+			if (OldChild != nullptr && !Kept.Contains(OldChild))
+			{
+				Context.Stats.StatesRemoved += DetachStateSubtree(Context, OldChild);
+			}
+		}
+		State->Children = NewChildren;
+		bChanged = true;
+	}
+
+	if (bChanged && !Context.NewStates.Contains(State))
+	{
+		++Context.Stats.StatesUpdated;
+	}
+
+	for (int32 ChildIndex = 0; ChildIndex < NewChildren.Num(); ++ChildIndex)
+	{
+		ApplyStateSubtree(Context, NewChildren[ChildIndex], Desired.Children[ChildIndex]);
+	}
+}
+
+bool TransitionMatches(const FStateTreeTransition& Transition, const FCortexSTDesiredTransition& Desired, const UStateTreeState* Target)
+{
+	return Transition.Trigger == Desired.Trigger
+		&& Transition.Priority == Desired.Priority
+		&& Transition.bTransitionEnabled == Desired.bEnabled
+		&& CortexSTCompat::GetTransitionEventTag(Transition) == Desired.EventTag
+		&& Transition.State.LinkType == Desired.Type
+		&& (Desired.Type != EStateTreeTransitionType::GotoState || (Target != nullptr && Transition.State.ID == Target->ID));
+}
+
+/** Runs after every state exists, so transition and linked subtree targets resolve against the applied hierarchy. */
+void ApplyLinksSubtree(FCortexSTApplyContext& Context, const FCortexSTDesiredState& Desired)
+{
+	UStateTreeState* State = Context.StatesByPath.FindRef(Desired.Path);
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	// A state whose only change is its links still counts once as updated
+	const bool bWasTouched = Context.Touched.Contains(State);
+
+	if (Desired.LinkedSubtreePath.IsSet())
+	{
+		const UStateTreeState* LinkedState = Context.StatesByPath.FindRef(Desired.LinkedSubtreePath.GetValue());
+		if (State->LinkedSubtree.ID != (LinkedState != nullptr ? LinkedState->ID : FGuid()))
+		{
+			Context.Touch(State);
+			State->SetLinkedState(LinkedState != nullptr ? LinkedState->GetLinkToState() : FStateTreeStateLink());
+		}
+	}
+
+	TArray<UStateTreeState*> Targets;
+	Targets.Reserve(Desired.Transitions.Num());
+	for (const FCortexSTDesiredTransition& Transition : Desired.Transitions)
+	{
+		Targets.Add(Transition.Type == EStateTreeTransitionType::GotoState ? Context.StatesByPath.FindRef(Transition.TargetPath) : nullptr);
+	}
+
+	bool bSame = State->Transitions.Num() == Desired.Transitions.Num();
+	for (int32 TransitionIndex = 0; bSame && TransitionIndex < State->Transitions.Num(); ++TransitionIndex)
+	{
+		bSame = TransitionMatches(State->Transitions[TransitionIndex], Desired.Transitions[TransitionIndex], Targets[TransitionIndex]);
+	}
+
+	if (!bSame)
+	{
+		Context.Touch(State);
+
+		// Matching transitions keep their IDs and conditions; the rest are re-created
+		TArray<FStateTreeTransition> ExistingTransitions = MoveTemp(State->Transitions);
+		TBitArray<> Used(false, ExistingTransitions.Num());
+		State->Transitions.Reset(Desired.Transitions.Num());
+
+		for (int32 DesiredIndex = 0; DesiredIndex < Desired.Transitions.Num(); ++DesiredIndex)
+		{
+			const FCortexSTDesiredTransition& DesiredTransition = Desired.Transitions[DesiredIndex];
+			int32 MatchIndex = INDEX_NONE;
+			for (int32 ExistingIndex = 0; ExistingIndex < ExistingTransitions.Num(); ++ExistingIndex)
+			{
+				if (!Used[ExistingIndex] && TransitionMatches(ExistingTransitions[ExistingIndex], DesiredTransition, Targets[DesiredIndex]))
+				{
+					MatchIndex = ExistingIndex;
+					break;
+				}
+			}
+
+			if (MatchIndex != INDEX_NONE)
+			{
+				Used[MatchIndex] = true;
+				State->Transitions.Add(MoveTemp(ExistingTransitions[MatchIndex]));
+				continue;
+			}
+
+			FStateTreeTransition& Transition = CortexSTCompat::AddTransition(
+				*State,
+				DesiredTransition.Trigger,
+				DesiredTransition.Type,
+				Targets[DesiredIndex],
+				DesiredTransition.EventTag);
+			Transition.Priority = DesiredTransition.Priority;
+			Transition.bTransitionEnabled = DesiredTransition.bEnabled;
+			if (Targets[DesiredIndex] != nullptr)
+			{
+				Transition.State = Targets[DesiredIndex]->GetLinkToState();
+			}
+			Transition.State.LinkType = DesiredTransition.Type;
+			++Context.Stats.TransitionsAdded;
+		}
+
+		Context.Stats.TransitionsRemoved += ExistingTransitions.Num() - Used.CountSetBits();
+	}
+
+	if (!bWasTouched && Context.Touched.Contains(State) && !Context.NewStates.Contains(State))
+	{
+		++Context.Stats.StatesUpdated;
+	}
+
+	for (const FCortexSTDesiredState& Child : Desired.Children)
+	{
+		ApplyLinksSubtree(Context, Child);
+	}
+}
+
+TSharedPtr<FJsonObject> ExportState(const UStateTreeState* State, const UStateTreeEditorData* EditorData)
+{
+	TSharedPtr<FJsonObject> StateObject = MakeShared<FJsonObject>();
+	StateObject->SetStringField(TEXT("name"), State->Name.ToString());
+	StateObject->SetStringField(TEXT("type"), LexToStringDocumentEnum(State->Type));
+	StateObject->SetStringField(TEXT("selection_behavior"), LexToStringDocumentEnum(State->SelectionBehavior));
+	StateObject->SetBoolField(TEXT("enabled"), State->bEnabled);
+	StateObject->SetStringField(TEXT("tag"), TagToDocumentString(CortexSTCompat::GetStateTag(State)));
+	if (State->Type == EStateTreeStateType::Linked)
+	{
+		const UStateTreeState* LinkedState = EditorData->GetStateByID(State->LinkedSubtree.ID);
+		StateObject->SetStringField(TEXT("linked_subtree"), LinkedState != nullptr ? CortexSTCompat::GetStatePath(LinkedState) : FString());
+	}
+	else if (State->Type == EStateTreeStateType::LinkedAsset)
+	{
+		StateObject->SetStringField(TEXT("linked_asset"), State->LinkedAsset != nullptr ? State->LinkedAsset->GetPathName() : FString());
+	}
+
+	auto ExportNodes = [](const TArray<FStateTreeEditorNode>& Nodes)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (const FStateTreeEditorNode& Node : Nodes)
+		{
+			if (const UScriptStruct* NodeStruct = Node.Node.GetScriptStruct())
+			{
+				Values.Add(MakeShared<FJsonValueString>(NodeStruct->GetPathName()));
+			}
+		}
+		return Values;
+	};
+	StateObject->SetArrayField(TEXT("tasks"), ExportNodes(State->Tasks));
+	StateObject->SetArrayField(TEXT("enter_conditions"), ExportNodes(State->EnterConditions));
+
+	TArray<TSharedPtr<FJsonValue>> TransitionValues;
+	for (const FStateTreeTransition& Transition : State->Transitions)
+	{
+		TSharedPtr<FJsonObject> TransitionObject = MakeShared<FJsonObject>();
+		TransitionObject->SetStringField(TEXT("trigger"), LexToStringDocumentEnum(Transition.Trigger));
+		TransitionObject->SetStringField(TEXT("priority"), LexToStringDocumentEnum(Transition.Priority));
+		if (Transition.State.LinkType == EStateTreeTransitionType::GotoState)
+		{
+			const UStateTreeState* TargetState = EditorData->GetStateByID(Transition.State.ID);
+			TransitionObject->SetStringField(TEXT("target"), TargetState != nullptr ? CortexSTCompat::GetStatePath(TargetState) : FString());
+		}
+		else
+		{
+			TransitionObject->SetStringField(TEXT("type"), LexToStringDocumentEnum(Transition.State.LinkType));
+		}
+		TransitionObject->SetStringField(TEXT("event_tag"), TagToDocumentString(CortexSTCompat::GetTransitionEventTag(Transition)));
+		TransitionObject->SetBoolField(TEXT("enabled"), Transition.bTransitionEnabled);
+		TransitionValues.Add(MakeShared<FJsonValueObject>(TransitionObject));
+	}
+	StateObject->SetArrayField(TEXT("transitions"), TransitionValues);
+
+	TArray<TSharedPtr<FJsonValue>> ChildValues;
+	for (const UStateTreeState* ChildState : State->Children)
+	{
+		if (ChildState != nullptr)
+		{
+			ChildValues.Add(MakeShared<FJsonValueObject>(ExportState(ChildState, EditorData)));
+		}
+	}
+	StateObject->SetArrayField(TEXT("children"), ChildValues);
+	return StateObject;
+}
+}
+
+FCortexCommandResult FCortexSTTreeOps::ExportTree(const TSharedPtr<FJsonObject>& Params)
+{
+	FString AssetPath;
+	FCortexCommandResult Error;
+	if (!CortexST::GetRequiredString(Params, TEXT("asset_path"), AssetPath, Error))
+	{
+		return Error;
+	}
+
+	FCortexSTAssetContext Context;
+	if (!CortexST::LoadAssetContext(AssetPath, Context, Error))
+	{
+		return Error;
+	}
+
+	const UStateTreeState* RootState = Context.EditorData->SubTrees.Num() > 0 ? Context.EditorData->SubTrees[0] : nullptr;
+	if (RootState == nullptr)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidOperation,
+			FString::Printf(TEXT("StateTree has no root state: %s"), *Context.AssetPath));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("asset_path"), Context.AssetPath);
+	Data->SetObjectField(TEXT("tree"), ExportState(RootState, Context.EditorData));
+	Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(Context.StateTree));
+	return FCortexCommandRouter::Success(Data);
+}
+
+FCortexCommandResult FCortexSTTreeOps::ApplyTree(const TSharedPtr<FJsonObject>& Params)
+{
+	FString AssetPath;
+	FCortexCommandResult Error;
+	if (!CortexST::GetRequiredString(Params, TEXT("asset_path"), AssetPath, Error))
+	{
+		return Error;
+	}
+
+	const TSharedPtr<FJsonObject>* TreeObject = nullptr;
+	if (!Params->TryGetObjectField(TEXT("tree"), TreeObject) || TreeObject == nullptr || !(*TreeObject).IsValid())
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidField,
+			TEXT("Missing required param: tree (object)"));
+	}
+
+	FCortexSTApplyContext ApplyContext;
+	if (!CortexST::LoadAssetContext(AssetPath, ApplyContext.Asset, Error))
+	{
+		return Error;
+	}
+	const FCortexSTAssetContext& Context = ApplyContext.Asset;
+
+	if (!CortexST::CheckExpectedFingerprint(Context.StateTree, Params, Error))
+	{
+		return Error;
+	}
+
+	UStateTreeState* RootState = Context.EditorData->SubTrees.Num() > 0 ? Context.EditorData->SubTrees[0] : nullptr;
+	if (RootState == nullptr)
+	{
+		return FCortexCommandRouter::Error(
+			CortexErrorCodes::InvalidOperation,
+			FString::Printf(TEXT("StateTree has no root state: %s"), *Context.AssetPath));
+	}
+
+	// The whole document is checked before the first edit, so a bad entry leaves the asset untouched
+	FCortexSTDesiredState DesiredRoot;
+	TSet<FString> DesiredPaths;
+	if (!ParseDesiredState(*TreeObject, FString(), DesiredPaths, DesiredRoot, Error)
+		|| !CheckDocumentTargets(DesiredRoot, DesiredPaths, Error))
+	{
+		return Error;
+	}
+
+	// One transaction spans the edits, the engine fixups and the compile, so a single undo reverts all of it
+	FScopedTransaction Transaction(FText::FromString(
+		FString::Printf(TEXT("Cortex: Apply StateTree document to %s"), *FPackageName::GetShortName(Context.AssetPath))));
+
+	ApplyStateSubtree(ApplyContext, RootState, DesiredRoot);
+	ApplyLinksSubtree(ApplyContext, DesiredRoot);
+
+	const FCortexSTApplyStats& Stats = ApplyContext.Stats;
+	const bool bChanged = ApplyContext.Touched.Num() > 0;
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("asset_path"), Context.AssetPath);
+	Data->SetBoolField(TEXT("changed"), bChanged);
+	Data->SetNumberField(TEXT("change_count"), Stats.GetChangeCount());
+	Data->SetObjectField(TEXT("changes"), Stats.ToJson());
+	Data->SetNumberField(TEXT("state_count"), DesiredPaths.Num());
+
+	// An unchanged, already compiled asset has nothing to fix up, compile or save
+	const bool bCompile = CortexST::GetOptionalBool(Params, TEXT("compile"), true)
+		&& (bChanged || !Context.StateTree->IsReadyToRun());
+	const bool bSave = CortexST::GetOptionalBool(Params, TEXT("save"), false) && bChanged;
+
+	if (bChanged && FCortexSTEditSession::IsDeferring())
+	{
+		Context.StateTree->MarkPackageDirty();
+		FCortexSTEditSession::DeferFinalize(Context.StateTree, Context.AssetPath, bCompile, bSave);
+		Data->SetBoolField(TEXT("finalize_deferred"), true);
+		Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(Context.StateTree));
+		return FCortexCommandRouter::Success(Data);
+	}
+
+	if (bChanged)
+	{
+		const FCortexCommandResult FixupResult = FCortexSTValidationOps::RunPostMutationFixups(Context.StateTree);
+		if (!FixupResult.bSuccess)
+		{
+			return FixupResult;
+		}
+		Context.StateTree->MarkPackageDirty();
+
+		if (FixupResult.Data.IsValid() && FixupResult.Data->HasTypedField<EJson::Object>(TEXT("validation")))
+		{
+			Data->SetObjectField(TEXT("validation"), FixupResult.Data->GetObjectField(TEXT("validation")));
+		}
+	}
+
+	Data->SetBoolField(TEXT("compiled"), bCompile);
+	if (bCompile)
+	{
+		FStateTreeCompilerLog CompileLog;
+		const bool bCompiled = FCortexSTValidationOps::CompileTree(Context.StateTree, CompileLog);
+		Data->SetObjectField(TEXT("compile"),
+			FCortexSTValidationOps::BuildCompilePayload(Context.AssetPath, Context.StateTree, CompileLog, bCompiled));
+		if (!bCompiled)
+		{
+			Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(Context.StateTree));
+			return FCortexCommandRouter::Error(
+				CortexErrorCodes::CompileFailed,
+				FString::Printf(TEXT("StateTree compilation failed for %s"), *Context.AssetPath),
+				Data);
+		}
+	}
+
+	Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(Context.StateTree));
+
+	if (bSave)
+	{
+		const FCortexCommandResult SaveResult = FCortexSTAssetOps::SaveAsset(Context.AssetPath);
+		if (!SaveResult.bSuccess)
+		{
+			return SaveResult;
+		}
+
+		if (SaveResult.Data.IsValid() && SaveResult.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+		{
+			Data->SetObjectField(TEXT("fingerprint"), SaveResult.Data->GetObjectField(TEXT("fingerprint")));
+		}
+	}
+
+	UE_LOG(
+		LogCortexStateTree,
+		Log,
+		TEXT("Applied StateTree document to %s: %d changes"),
+		*Context.AssetPath,
+		Stats.GetChangeCount());
+
+	return FCortexCommandRouter::Success(Data);
+}
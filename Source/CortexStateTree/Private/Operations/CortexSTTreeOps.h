@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CortexTypes.h"
+
+/**
+ * Declarative StateTree documents: export_tree writes the editor data as a nested document
+ * (states by name, tasks and enter conditions by struct, transitions by target path), and
+ * apply_tree reconciles an asset against one in a single transaction.
+ */
+class FCortexSTTreeOps
+{
+public:
+	static FCortexCommandResult ExportTree(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult ApplyTree(const TSharedPtr<FJsonObject>& Params);
+};
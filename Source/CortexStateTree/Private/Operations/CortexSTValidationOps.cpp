@@ -1,11 +1,18 @@
 ﻿#include "Operations/CortexSTValidationOps.h"
 
+#include "CortexBatchMutation.h"
 #include "CortexCommandRouter.h"
+#include "CortexEditorUtils.h"
 #include "CortexSTCompat.h"
+#include "CortexSTStateIndex.h"
 #include "CortexSTTypes.h"
 #include "CortexStateTreeModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
 #include "Logging/TokenizedMessage.h"
 #include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
 #include "Operations/CortexSTAssetOps.h"
 #include "ScopedTransaction.h"
 #include "StateTree.h"
@@ -130,6 +137,23 @@ TSharedPtr<FJsonObject> BuildCompilePayload(
 	return Payload;
 }
 
+bool CompileWithStateIndex(UStateTree* StateTree, FStateTreeCompilerLog& CompileLog)
+{
+	const bool bWasReady = StateTree->IsReadyToRun();
+	const uint32 PreviousCompiledHash = StateTree->LastCompiledEditorDataHash;
+
+	const FCortexSTStateIndex::FEdit IndexEdit =
+		FCortexSTStateIndex::Get().BeginEdit(Cast<UStateTreeEditorData>(StateTree->EditorData));
+	const bool bCompiled = CortexSTCompat::CompileStateTree(StateTree, CompileLog);
+	FCortexSTStateIndex::Get().CommitUnchanged(IndexEdit);
+
+	if (bWasReady != StateTree->IsReadyToRun() || PreviousCompiledHash != StateTree->LastCompiledEditorDataHash)
+	{
+		StateTree->MarkPackageDirty();
+	}
+	return bCompiled;
+}
+
 bool SaveIfRequested(
 	const TSharedPtr<FJsonObject>& Params,
 	const FString& AssetPath,
@@ -155,6 +179,372 @@ bool SaveIfRequested(
 
 	return true;
 }
+
+/** Fingerprint each asset last passed with, per bulk command; a match means nothing changed since */
+TMap<FString, TSharedPtr<FJsonObject>> LastValidatedFingerprints;
+TMap<FString, TSharedPtr<FJsonObject>> LastCompiledFingerprints;
+
+struct FCortexSTBulkEntry
+{
+	FString AssetPath;
+	UStateTree* StateTree = nullptr;
+	FString LoadError;
+	TSharedPtr<FJsonObject> Fingerprint;
+	TSharedPtr<FJsonObject> Validation;
+	TSharedPtr<FJsonObject> CompilePayload;
+	bool bSkipped = false;
+	bool bPassed = false;
+	double FingerprintMs = 0.0;
+	double CheckMs = 0.0;
+	double CompileMs = 0.0;
+};
+
+double MillisecondsSince(const double StartSeconds)
+{
+	return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+}
+
+bool CollectBulkAssetPaths(
+	const TSharedPtr<FJsonObject>& Params,
+	TArray<FString>& OutAssetPaths,
+	FString& OutPathFilter,
+	FCortexCommandResult& OutError)
+{
+	OutPathFilter = TEXT("/Game");
+	int32 Limit = 0;
+	const TArray<TSharedPtr<FJsonValue>>* AssetPathValues = nullptr;
+	if (Params.IsValid())
+	{
+		Params->TryGetStringField(TEXT("path_filter"), OutPathFilter);
+		Params->TryGetNumberField(TEXT("limit"), Limit);
+		Params->TryGetArrayField(TEXT("asset_paths"), AssetPathValues);
+	}
+
+	if (AssetPathValues != nullptr)
+	{
+		OutPathFilter.Reset();
+		TSet<FString> SeenPaths;
+		for (const TSharedPtr<FJsonValue>& Value : *AssetPathValues)
+		{
+			FString AssetPath;
+			if (!Value.IsValid() || !Value->TryGetString(AssetPath) || AssetPath.IsEmpty())
+			{
+				OutError = FCortexCommandRouter::Error(
+					CortexErrorCodes::InvalidField,
+					TEXT("asset_paths must contain only non-empty strings"));
+				return false;
+			}
+
+			const FString ObjectPath = CortexST::NormalizeAssetPath(AssetPath);
+			bool bAlreadySeen = false;
+			SeenPaths.Add(ObjectPath, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				OutAssetPaths.Add(ObjectPath);
+			}
+		}
+	}
+	else
+	{
+		OutPathFilter = FCortexEditorUtils::NormalizeMountedContentPath(OutPathFilter);
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UStateTree::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		if (!OutPathFilter.IsEmpty())
+		{
+			Filter.PackagePaths.Add(FName(*OutPathFilter));
+			Filter.bRecursivePaths = true;
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(Filter, Assets);
+		OutAssetPaths.Reserve(Assets.Num());
+		for (const FAssetData& Asset : Assets)
+		{
+			OutAssetPaths.Add(Asset.GetObjectPathString());
+		}
+		OutAssetPaths.Sort();
+	}
+
+	if (Limit > 0 && OutAssetPaths.Num() > Limit)
+	{
+		OutAssetPaths.SetNum(Limit);
+	}
+	return true;
+}
+
+void LoadBulkEntries(TArray<FCortexSTBulkEntry>& Entries)
+{
+	// Queue every unloaded package so the loader can overlap their IO and serialization
+	bool bQueued = false;
+	for (const FCortexSTBulkEntry& Entry : Entries)
+	{
+		const FString PackageName = FPackageName::ObjectPathToPackageName(Entry.AssetPath);
+		if (!PackageName.IsEmpty() && !FindPackage(nullptr, *PackageName) && FPackageName::DoesPackageExist(PackageName))
+		{
+			LoadPackageAsync(PackageName);
+			bQueued = true;
+		}
+	}
+	if (bQueued)
+	{
+		FlushAsyncLoading();
+	}
+
+	for (FCortexSTBulkEntry& Entry : Entries)
+	{
+		FString PackageName;
+		FCortexCommandResult Error;
+		if (!CortexST::ValidateReadablePackage(Entry.AssetPath, PackageName, Error))
+		{
+			Entry.LoadError = Error.ErrorMessage;
+			continue;
+		}
+
+		Entry.StateTree = LoadObject<UStateTree>(nullptr, *Entry.AssetPath);
+		if (Entry.StateTree == nullptr)
+		{
+			Entry.LoadError = FString::Printf(TEXT("Asset is not a StateTree: %s"), *Entry.AssetPath);
+		}
+	}
+}
+
+/** Fingerprints on the game thread, then the read-only structure walk for every asset that changed */
+void RunBulkChecks(
+	TArray<FCortexSTBulkEntry>& Entries,
+	const TMap<FString, TSharedPtr<FJsonObject>>& LastPassed,
+	const bool bForce,
+	double& OutCheckMs)
+{
+	TArray<int32> ToCheck;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FCortexSTBulkEntry& Entry = Entries[Index];
+		if (Entry.StateTree == nullptr)
+		{
+			continue;
+		}
+
+		// Hashes the saved package and walks properties, so it stays on the game thread
+		const double FingerprintStart = FPlatformTime::Seconds();
+		Entry.Fingerprint = CortexST::MakeFingerprint(Entry.StateTree);
+		Entry.FingerprintMs = MillisecondsSince(FingerprintStart);
+
+		const TSharedPtr<FJsonObject>* PassedFingerprint = LastPassed.Find(Entry.AssetPath);
+		if (!bForce && PassedFingerprint != nullptr && FCortexBatchMutation::FingerprintsMatch(Entry.Fingerprint, *PassedFingerprint))
+		{
+			Entry.bSkipped = true;
+			Entry.bPassed = true;
+			continue;
+		}
+		ToCheck.Add(Index);
+	}
+
+	// The walk only reads editor data and nothing can collect garbage while the game thread waits here
+	const double CheckStart = FPlatformTime::Seconds();
+	ParallelFor(ToCheck.Num(), [&Entries, &ToCheck](const int32 CheckIndex)
+	{
+		FCortexSTBulkEntry& Entry = Entries[ToCheck[CheckIndex]];
+		const double EntryStart = FPlatformTime::Seconds();
+		Entry.Validation = CortexST::BuildValidationPayload(Entry.StateTree);
+		Entry.CheckMs = MillisecondsSince(EntryStart);
+	});
+	OutCheckMs = MillisecondsSince(CheckStart);
+
+	for (const int32 Index : ToCheck)
+	{
+		FCortexSTBulkEntry& Entry = Entries[Index];
+		Entry.bPassed = Entry.Validation.IsValid() && Entry.Validation->GetBoolField(TEXT("valid"));
+	}
+}
+
+/** Engine compilation mutates the asset, so it runs one tree at a time on the game thread */
+void CompileBulkEntries(TArray<FCortexSTBulkEntry>& Entries, double& OutCompileMs)
+{
+	TArray<int32> ToCompile;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FCortexSTBulkEntry& Entry = Entries[Index];
+		if (Entry.StateTree != nullptr && !Entry.bSkipped && Entry.bPassed)
+		{
+			ToCompile.Add(Index);
+		}
+	}
+
+	const double CompileStart = FPlatformTime::Seconds();
+	TUniquePtr<FScopedTransaction> Transaction;
+	if (ToCompile.Num() > 0)
+	{
+		Transaction = MakeUnique<FScopedTransaction>(FText::FromString(
+			FString::Printf(TEXT("Cortex: Compile %d StateTrees"), ToCompile.Num())));
+	}
+
+	for (const int32 Index : ToCompile)
+	{
+		FCortexSTBulkEntry& Entry = Entries[Index];
+		UStateTree* StateTree = Entry.StateTree;
+		const double EntryStart = FPlatformTime::Seconds();
+
+		StateTree->Modify();
+
+		FStateTreeCompilerLog CompileLog;
+		const bool bCompiled = CompileWithStateIndex(StateTree, CompileLog);
+
+		Entry.CompilePayload = BuildCompilePayload(Entry.AssetPath, StateTree, CompileLog, bCompiled);
+		Entry.Fingerprint = Entry.CompilePayload->GetObjectField(TEXT("fingerprint"));
+		Entry.bPassed = bCompiled;
+		Entry.CompileMs = MillisecondsSince(EntryStart);
+	}
+	OutCompileMs = MillisecondsSince(CompileStart);
+}
+
+TSharedPtr<FJsonObject> MakeBulkEntryJson(const FCortexSTBulkEntry& Entry)
+{
+	FString Status = TEXT("failed");
+	if (!Entry.LoadError.IsEmpty())
+	{
+		Status = TEXT("not_found");
+	}
+	else if (Entry.bSkipped)
+	{
+		Status = TEXT("skipped");
+	}
+	else if (Entry.bPassed)
+	{
+		Status = TEXT("passed");
+	}
+
+	TSharedPtr<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+	EntryObject->SetStringField(TEXT("asset_path"), Entry.AssetPath);
+	EntryObject->SetStringField(TEXT("status"), Status);
+	EntryObject->SetBoolField(TEXT("skipped"), Entry.bSkipped);
+	if (!Entry.LoadError.IsEmpty())
+	{
+		EntryObject->SetStringField(TEXT("error"), Entry.LoadError);
+	}
+	if (Entry.Validation.IsValid())
+	{
+		EntryObject->SetObjectField(TEXT("validation"), Entry.Validation);
+	}
+	if (Entry.CompilePayload.IsValid())
+	{
+		EntryObject->SetStringField(TEXT("compile_status"), Entry.CompilePayload->GetStringField(TEXT("compile_status")));
+		EntryObject->SetNumberField(TEXT("error_count"), Entry.CompilePayload->GetNumberField(TEXT("error_count")));
+		EntryObject->SetNumberField(TEXT("warning_count"), Entry.CompilePayload->GetNumberField(TEXT("warning_count")));
+		EntryObject->SetArrayField(TEXT("diagnostics"), Entry.CompilePayload->GetArrayField(TEXT("diagnostics")));
+	}
+	if (Entry.Fingerprint.IsValid())
+	{
+		EntryObject->SetObjectField(TEXT("fingerprint"), Entry.Fingerprint);
+	}
+
+	TSharedPtr<FJsonObject> Timing = MakeShared<FJsonObject>();
+	Timing->SetNumberField(TEXT("fingerprint"), Entry.FingerprintMs);
+	Timing->SetNumberField(TEXT("check"), Entry.CheckMs);
+	Timing->SetNumberField(TEXT("compile"), Entry.CompileMs);
+	Timing->SetNumberField(TEXT("total"), Entry.FingerprintMs + Entry.CheckMs + Entry.CompileMs);
+	EntryObject->SetObjectField(TEXT("timing_ms"), Timing);
+	return EntryObject;
+}
+
+FCortexCommandResult RunBulkValidation(const TSharedPtr<FJsonObject>& Params, const bool bCompile)
+{
+	const double TotalStart = FPlatformTime::Seconds();
+
+	TArray<FString> AssetPaths;
+	FString PathFilter;
+	FCortexCommandResult Error;
+	if (!CollectBulkAssetPaths(Params, AssetPaths, PathFilter, Error))
+	{
+		return Error;
+	}
+	const double EnumerateMs = MillisecondsSince(TotalStart);
+
+	TArray<FCortexSTBulkEntry> Entries;
+	Entries.SetNum(AssetPaths.Num());
+	for (int32 Index = 0; Index < AssetPaths.Num(); ++Index)
+	{
+		Entries[Index].AssetPath = AssetPaths[Index];
+	}
+
+	const double LoadStart = FPlatformTime::Seconds();
+	LoadBulkEntries(Entries);
+	const double LoadMs = MillisecondsSince(LoadStart);
+
+	TMap<FString, TSharedPtr<FJsonObject>>& LastPassed = bCompile ? LastCompiledFingerprints : LastValidatedFingerprints;
+	double CheckMs = 0.0;
+	RunBulkChecks(Entries, LastPassed, CortexST::GetOptionalBool(Params, TEXT("force"), false), CheckMs);
+
+	double CompileMs = 0.0;
+	if (bCompile)
+	{
+		CompileBulkEntries(Entries, CompileMs);
+	}
+
+	int32 CheckedCount = 0;
+	int32 SkippedCount = 0;
+	int32 FailedCount = 0;
+	double FingerprintMs = 0.0;
+	TArray<TSharedPtr<FJsonValue>> Results;
+	Results.Reserve(Entries.Num());
+	for (const FCortexSTBulkEntry& Entry : Entries)
+	{
+		FingerprintMs += Entry.FingerprintMs;
+		if (Entry.bSkipped)
+		{
+			++SkippedCount;
+		}
+		else if (Entry.StateTree != nullptr)
+		{
+			++CheckedCount;
+		}
+
+		if (!Entry.bPassed)
+		{
+			++FailedCount;
+			LastPassed.Remove(Entry.AssetPath);
+		}
+		else if (!Entry.bSkipped)
+		{
+			LastPassed.Add(Entry.AssetPath, Entry.Fingerprint);
+		}
+
+		Results.Add(MakeShared<FJsonValueObject>(MakeBulkEntryJson(Entry)));
+	}
+
+	TSharedPtr<FJsonObject> Timing = MakeShared<FJsonObject>();
+	Timing->SetNumberField(TEXT("enumerate"), EnumerateMs);
+	Timing->SetNumberField(TEXT("load"), LoadMs);
+	Timing->SetNumberField(TEXT("fingerprint"), FingerprintMs);
+	Timing->SetNumberField(TEXT("check"), CheckMs);
+	Timing->SetNumberField(TEXT("compile"), CompileMs);
+	Timing->SetNumberField(TEXT("total"), MillisecondsSince(TotalStart));
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	if (!PathFilter.IsEmpty())
+	{
+		Data->SetStringField(TEXT("path_filter"), PathFilter);
+	}
+	Data->SetArrayField(TEXT("assets"), Results);
+	Data->SetNumberField(TEXT("total"), Entries.Num());
+	Data->SetNumberField(TEXT("checked"), CheckedCount);
+	Data->SetNumberField(TEXT("skipped"), SkippedCount);
+	Data->SetNumberField(TEXT("failed"), FailedCount);
+	Data->SetBoolField(TEXT("all_passed"), FailedCount == 0);
+	Data->SetObjectField(TEXT("timing_ms"), Timing);
+
+	UE_LOG(LogCortexStateTree, Log, TEXT("%s %d StateTrees: %d checked, %d skipped, %d failed"),
+		bCompile ? TEXT("Compiled") : TEXT("Validated"),
+		Entries.Num(),
+		CheckedCount,
+		SkippedCount,
+		FailedCount);
+
+	return FCortexCommandRouter::Success(Data);
+}
 }
 
 FCortexCommandResult FCortexSTValidationOps::CheckStructure(const TSharedPtr<FJsonObject>& Params)
@@ -236,23 +626,13 @@ FCortexCommandResult FCortexSTValidationOps::Compile(const TSharedPtr<FJsonObjec
 		return Error;
 	}
 
-	const bool bWasReady = Asset.StateTree->IsReadyToRun();
-	const uint32 PreviousCompiledHash = Asset.StateTree->LastCompiledEditorDataHash;
 	FScopedTransaction Transaction(FText::FromString(
 		FString::Printf(TEXT("Cortex: Compile StateTree %s"), *FPackageName::GetShortName(Asset.AssetPath))));
 
 	Asset.StateTree->Modify();
 
 	FStateTreeCompilerLog CompileLog;
-	const bool bCompiled = CortexSTCompat::CompileStateTree(Asset.StateTree, CompileLog);
-
-	const bool bIsReady = Asset.StateTree->IsReadyToRun();
-	const uint32 CurrentCompiledHash = Asset.StateTree->LastCompiledEditorDataHash;
-	const bool bCompiledDataChanged = bWasReady != bIsReady || PreviousCompiledHash != CurrentCompiledHash;
-	if (bCompiledDataChanged)
-	{
-		Asset.StateTree->MarkPackageDirty();
-	}
+	const bool bCompiled = CompileWithStateIndex(Asset.StateTree, CompileLog);
 
 	TSharedPtr<FJsonObject> Data = BuildCompilePayload(Asset.AssetPath, Asset.StateTree, CompileLog, bCompiled);
 	if (!bCompiled)
@@ -273,6 +653,22 @@ FCortexCommandResult FCortexSTValidationOps::Compile(const TSharedPtr<FJsonObjec
 	return FCortexCommandRouter::Success(Data);
 }
 
+FCortexCommandResult FCortexSTValidationOps::ValidateAll(const TSharedPtr<FJsonObject>& Params)
+{
+	return RunBulkValidation(Params, false);
+}
+
+FCortexCommandResult FCortexSTValidationOps::CompileAll(const TSharedPtr<FJsonObject>& Params)
+{
+	return RunBulkValidation(Params, true);
+}
+
+void FCortexSTValidationOps::ResetBulkCache()
+{
+	LastValidatedFingerprints.Reset();
+	LastCompiledFingerprints.Reset();
+}
+
 FCortexCommandResult FCortexSTValidationOps::RunPostMutationFixups(UStateTree* StateTree)
 {
 	if (StateTree == nullptr)
@@ -282,10 +678,28 @@ FCortexCommandResult FCortexSTValidationOps::RunPostMutationFixups(UStateTree* S
 			TEXT("RunPostMutationFixups requires a valid StateTree"));
 	}
 
+	// Engine fixups Modify() the editor data without touching state IDs, names or hierarchy
+	const FCortexSTStateIndex::FEdit IndexEdit =
+		FCortexSTStateIndex::Get().BeginEdit(Cast<UStateTreeEditorData>(StateTree->EditorData));
 	CortexSTCompat::ValidateStateTree(StateTree);
+	FCortexSTStateIndex::Get().CommitUnchanged(IndexEdit);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetObjectField(TEXT("validation"), CortexST::BuildValidationPayload(StateTree));
 	Data->SetObjectField(TEXT("fingerprint"), CortexST::MakeFingerprint(StateTree));
 	return FCortexCommandRouter::Success(Data);
 }
+
+bool FCortexSTValidationOps::CompileTree(UStateTree* StateTree, FStateTreeCompilerLog& CompileLog)
+{
+	return StateTree != nullptr && CompileWithStateIndex(StateTree, CompileLog);
+}
+
+TSharedPtr<FJsonObject> FCortexSTValidationOps::BuildCompilePayload(
+	const FString& AssetPath,
+	UStateTree* StateTree,
+	const FStateTreeCompilerLog& CompileLog,
+	const bool bCompiled)
+{
+	return ::BuildCompilePayload(AssetPath, StateTree, CompileLog, bCompiled);
+}
@@ -5,6 +5,7 @@
 
 class FJsonObject;
 class UStateTree;
+struct FStateTreeCompilerLog;
 
 class FCortexSTValidationOps
 {
@@ -12,5 +13,24 @@ public:
 	static FCortexCommandResult CheckStructure(const TSharedPtr<FJsonObject>& Params);
 	static FCortexCommandResult ValidateAsset(const TSharedPtr<FJsonObject>& Params);
 	static FCortexCommandResult Compile(const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Bulk variants over every StateTree under path_filter (or an explicit asset_paths list).
+	 * Assets whose fingerprint matches their last passing run are skipped unless force is set.
+	 */
+	static FCortexCommandResult ValidateAll(const TSharedPtr<FJsonObject>& Params);
+	static FCortexCommandResult CompileAll(const TSharedPtr<FJsonObject>& Params);
+	static void ResetBulkCache();
+
 	static FCortexCommandResult RunPostMutationFixups(UStateTree* StateTree);
+
+	/** Compile with the state index bracketed, dirtying the package only when compiled data changed. */
+	static bool CompileTree(UStateTree* StateTree, FStateTreeCompilerLog& CompileLog);
+
+	/** Compile result as returned by compile: status, error/warning counts, diagnostics, fingerprint. */
+	static TSharedPtr<FJsonObject> BuildCompilePayload(
+		const FString& AssetPath,
+		UStateTree* StateTree,
+		const FStateTreeCompilerLog& CompileLog,
+		bool bCompiled);
 };
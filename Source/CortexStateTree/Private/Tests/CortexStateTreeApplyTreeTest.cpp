@@ -0,0 +1,364 @@
+#include "Misc/AutomationTest.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeCommandHandler.h"
+#include "CortexStateTreeTestUtils.h"
+#include "CortexTypes.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "StateTree.h"
+#include "StateTreeEditorData.h"
+#include "StateTreeState.h"
+
+namespace
+{
+const TCHAR* ApplyTreeDocument = TEXT(R"({
+	"name": "Root",
+	"children": [
+		{ "name": "Idle",
+		  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ],
+		  "transitions": [ { "trigger": "OnStateCompleted", "target": "Root/Combat" } ] },
+		{ "name": "Combat", "selection_behavior": "TrySelectChildrenInOrder",
+		  "children": [
+			{ "name": "Attack",
+			  "enter_conditions": [ "/Script/StateTreeModule.StateTreeCompareBoolCondition" ],
+			  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ],
+			  "transitions": [ { "trigger": "OnStateFailed", "priority": "High", "target": "Root/Idle" } ] },
+			{ "name": "Flee",
+			  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ],
+			  "transitions": [ { "trigger": "OnStateCompleted", "type": "Succeeded" } ] }
+		  ] }
+	] })");
+
+TSharedPtr<FJsonObject> ParseDocument(const FString& Json)
+{
+	TSharedPtr<FJsonObject> Document;
+	FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Document);
+	return Document;
+}
+
+FString WriteDocument(const TSharedPtr<FJsonObject>& Document)
+{
+	FString Json;
+	if (Document.IsValid())
+	{
+		FJsonSerializer::Serialize(Document.ToSharedRef(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json));
+	}
+	return Json;
+}
+
+bool CreateApplyTestStateTree(
+	FAutomationTestBase& Test,
+	FCortexStateTreeCommandHandler& Handler,
+	const FString& AssetPath,
+	TSharedPtr<FJsonObject>& OutFingerprint)
+{
+	TSharedPtr<FJsonObject> CreateParams = CortexStateTreeTest::Params();
+	CreateParams->SetStringField(TEXT("asset_path"), AssetPath);
+	CreateParams->SetStringField(TEXT("schema_class"), CortexStateTreeTest::GetTestSchemaClassPath());
+	CreateParams->SetStringField(TEXT("root_name"), TEXT("Root"));
+	CreateParams->SetBoolField(TEXT("save"), false);
+
+	const FCortexCommandResult CreateResult = Handler.Execute(TEXT("create_asset"), CreateParams);
+	Test.TestTrue(TEXT("create succeeds"), CreateResult.bSuccess);
+	if (!CreateResult.bSuccess || !CreateResult.Data.IsValid() || !CreateResult.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+	{
+		return false;
+	}
+
+	OutFingerprint = CreateResult.Data->GetObjectField(TEXT("fingerprint"));
+	return true;
+}
+
+FCortexCommandResult ApplyTree(
+	FCortexStateTreeCommandHandler& Handler,
+	const FString& AssetPath,
+	const TSharedPtr<FJsonObject>& Tree,
+	TSharedPtr<FJsonObject>& InOutFingerprint)
+{
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+	Params->SetObjectField(TEXT("tree"), Tree);
+	Params->SetObjectField(TEXT("expected_fingerprint"), InOutFingerprint);
+
+	const FCortexCommandResult Result = Handler.Execute(TEXT("apply_tree"), Params);
+	if (Result.Data.IsValid() && Result.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+	{
+		InOutFingerprint = Result.Data->GetObjectField(TEXT("fingerprint"));
+	}
+	return Result;
+}
+
+TSharedPtr<FJsonObject> ExportTree(FCortexStateTreeCommandHandler& Handler, const FString& AssetPath)
+{
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+
+	const FCortexCommandResult Result = Handler.Execute(TEXT("export_tree"), Params);
+	return Result.bSuccess && Result.Data.IsValid() && Result.Data->HasTypedField<EJson::Object>(TEXT("tree"))
+		? Result.Data->GetObjectField(TEXT("tree"))
+		: nullptr;
+}
+
+int32 GetChange(const FCortexCommandResult& Result, const TCHAR* FieldName)
+{
+	const TSharedPtr<FJsonObject>* Changes = nullptr;
+	return Result.Data.IsValid() && Result.Data->TryGetObjectField(TEXT("changes"), Changes)
+		? static_cast<int32>((*Changes)->GetNumberField(FieldName))
+		: INDEX_NONE;
+}
+
+int32 GetChangeCount(const FCortexCommandResult& Result)
+{
+	return Result.Data.IsValid() ? static_cast<int32>(Result.Data->GetNumberField(TEXT("change_count"))) : INDEX_NONE;
+}
+
+UStateTreeState* FindChildState(UStateTreeState* Parent, const TCHAR* Name)
+{
+	if (Parent != nullptr)
+	{
+		for (UStateTreeState* Child : Parent->Children)
+		{
+			if (Child != nullptr && Child->Name == FName(Name))
+			{
+				return Child;
+			}
+		}
+	}
+	return nullptr;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeApplyTreeRoundTripTest,
+	"Cortex.StateTree.ApplyTree.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeApplyTreeRoundTripTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString AssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_ApplyTreeSource"));
+	const FString CopyAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_ApplyTreeCopy"));
+
+	TSharedPtr<FJsonObject> Fingerprint;
+	TSharedPtr<FJsonObject> CopyFingerprint;
+	if (!CreateApplyTestStateTree(*this, Handler, AssetPath, Fingerprint)
+		|| !CreateApplyTestStateTree(*this, Handler, CopyAssetPath, CopyFingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		CortexStateTreeTest::DeleteIfLoaded(CopyAssetPath);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> Document = ParseDocument(ApplyTreeDocument);
+	const FCortexCommandResult FirstApply = ApplyTree(Handler, AssetPath, Document, Fingerprint);
+	TestTrue(TEXT("first apply succeeds"), FirstApply.bSuccess);
+	TestEqual(TEXT("four states added"), GetChange(FirstApply, TEXT("states_added")), 4);
+	TestEqual(TEXT("three transitions added"), GetChange(FirstApply, TEXT("transitions_added")), 3);
+	TestEqual(TEXT("four nodes added"), GetChange(FirstApply, TEXT("nodes_added")), 4);
+	TestTrue(TEXT("first apply compiles the tree"),
+		FirstApply.Data.IsValid() && FirstApply.Data->GetBoolField(TEXT("compiled")));
+	const TSharedPtr<FJsonObject>* CompilePayload = nullptr;
+	if (TestTrue(TEXT("first apply reports the compile payload"),
+		FirstApply.Data.IsValid() && FirstApply.Data->TryGetObjectField(TEXT("compile"), CompilePayload)))
+	{
+		TestEqual(TEXT("compile payload has no errors"), static_cast<int32>((*CompilePayload)->GetNumberField(TEXT("error_count"))), 0);
+	}
+
+	// Applying the same document again is a no-op
+	const FCortexCommandResult SecondApply = ApplyTree(Handler, AssetPath, Document, Fingerprint);
+	TestTrue(TEXT("second apply succeeds"), SecondApply.bSuccess);
+	TestEqual(TEXT("second apply makes zero changes"), GetChangeCount(SecondApply), 0);
+	TestFalse(TEXT("second apply reports unchanged"), SecondApply.Data.IsValid() && SecondApply.Data->GetBoolField(TEXT("changed")));
+
+	// Export, re-import into the same asset and into an empty one
+	const TSharedPtr<FJsonObject> Exported = ExportTree(Handler, AssetPath);
+	if (!TestNotNull(TEXT("export succeeds"), Exported.Get()))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		CortexStateTreeTest::DeleteIfLoaded(CopyAssetPath);
+		return false;
+	}
+
+	const FCortexCommandResult ReimportApply = ApplyTree(Handler, AssetPath, Exported, Fingerprint);
+	TestTrue(TEXT("re-import succeeds"), ReimportApply.bSuccess);
+	TestEqual(TEXT("re-importing the export makes zero changes"), GetChangeCount(ReimportApply), 0);
+
+	const FCortexCommandResult CopyApply = ApplyTree(Handler, CopyAssetPath, Exported, CopyFingerprint);
+	TestTrue(TEXT("import into a second asset succeeds"), CopyApply.bSuccess);
+	TestEqual(TEXT("second asset exports the same document"),
+		WriteDocument(ExportTree(Handler, CopyAssetPath)),
+		WriteDocument(Exported));
+
+	const FCortexCommandResult CopyReapply = ApplyTree(Handler, CopyAssetPath, Exported, CopyFingerprint);
+	TestEqual(TEXT("second apply on the copy makes zero changes"), GetChangeCount(CopyReapply), 0);
+
+	CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	CortexStateTreeTest::DeleteIfLoaded(CopyAssetPath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeApplyTreeDiffTest,
+	"Cortex.StateTree.ApplyTree.Diff",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeApplyTreeDiffTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString AssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_ApplyTreeDiff"));
+
+	TSharedPtr<FJsonObject> Fingerprint;
+	if (!CreateApplyTestStateTree(*this, Handler, AssetPath, Fingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		return false;
+	}
+
+	TestTrue(TEXT("initial apply succeeds"), ApplyTree(Handler, AssetPath, ParseDocument(ApplyTreeDocument), Fingerprint).bSuccess);
+
+	FCortexSTAssetContext Context;
+	FCortexCommandResult Error;
+	if (!TestTrue(TEXT("asset loads"), CortexST::LoadAssetContext(AssetPath, Context, Error)))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		return false;
+	}
+
+	UStateTreeState* Root = Context.EditorData->SubTrees[0];
+	UStateTreeState* Idle = FindChildState(Root, TEXT("Idle"));
+	UStateTreeState* Attack = FindChildState(FindChildState(Root, TEXT("Combat")), TEXT("Attack"));
+	const FGuid IdleId = Idle != nullptr ? Idle->ID : FGuid();
+	const FGuid AttackTransitionId = Attack != nullptr && Attack->Transitions.Num() == 1 ? Attack->Transitions[0].ID : FGuid();
+
+	// Disable Idle, drop Flee, add Patrol; everything else stays as it is
+	const FCortexCommandResult EditApply = ApplyTree(Handler, AssetPath, ParseDocument(TEXT(R"({
+		"name": "Root",
+		"children": [
+			{ "name": "Idle", "enabled": false,
+			  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ],
+			  "transitions": [ { "trigger": "OnStateCompleted", "target": "Root/Combat" } ] },
+			{ "name": "Combat", "selection_behavior": "TrySelectChildrenInOrder",
+			  "children": [
+				{ "name": "Attack",
+				  "enter_conditions": [ "/Script/StateTreeModule.StateTreeCompareBoolCondition" ],
+				  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ],
+				  "transitions": [ { "trigger": "OnStateFailed", "priority": "High", "target": "Root/Idle" } ] },
+				{ "name": "Patrol" }
+			  ] }
+		] })")), Fingerprint);
+
+	TestTrue(TEXT("edit apply succeeds"), EditApply.bSuccess);
+	TestEqual(TEXT("one state added"), GetChange(EditApply, TEXT("states_added")), 1);
+	TestEqual(TEXT("one state removed"), GetChange(EditApply, TEXT("states_removed")), 1);
+	TestEqual(TEXT("Idle and Combat updated"), GetChange(EditApply, TEXT("states_updated")), 2);
+	TestEqual(TEXT("no transition re-created"), GetChange(EditApply, TEXT("transitions_added")), 0);
+
+	TestTrue(TEXT("Idle kept its object and ID"), FindChildState(Root, TEXT("Idle")) == Idle && Idle != nullptr && Idle->ID == IdleId);
+	TestFalse(TEXT("Idle disabled"), Idle != nullptr && Idle->bEnabled);
+	TestTrue(TEXT("Attack kept its transition"),
+		Attack != nullptr && Attack->Transitions.Num() == 1 && Attack->Transitions[0].ID == AttackTransitionId);
+
+	// A transition to a state outside the document is rejected before anything changes
+	const FCortexCommandResult BadApply = ApplyTree(Handler, AssetPath, ParseDocument(TEXT(R"({
+		"name": "Root",
+		"children": [ { "name": "Idle", "transitions": [ { "target": "Root/Missing" } ] } ] })")), Fingerprint);
+	TestFalse(TEXT("unknown target fails"), BadApply.bSuccess);
+	TestEqual(TEXT("error code is INVALID_FIELD"), BadApply.ErrorCode, CortexErrorCodes::InvalidField);
+	TestNotNull(TEXT("Combat untouched"), FindChildState(Root, TEXT("Combat")));
+
+	CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeApplyTreeLinkedStatesTest,
+	"Cortex.StateTree.ApplyTree.LinkedStates",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeApplyTreeLinkedStatesTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString AssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_ApplyTreeLinked"));
+	const FString LinkedAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_ApplyTreeLinkedTarget"));
+
+	TSharedPtr<FJsonObject> Fingerprint;
+	TSharedPtr<FJsonObject> LinkedFingerprint;
+	if (!CreateApplyTestStateTree(*this, Handler, AssetPath, Fingerprint)
+		|| !CreateApplyTestStateTree(*this, Handler, LinkedAssetPath, LinkedFingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		CortexStateTreeTest::DeleteIfLoaded(LinkedAssetPath);
+		return false;
+	}
+
+	UStateTree* LinkedTree = LoadObject<UStateTree>(nullptr, *LinkedAssetPath);
+	const TSharedPtr<FJsonObject> Document = ParseDocument(FString::Printf(TEXT(R"({
+		"name": "Root",
+		"children": [
+			{ "name": "Attack", "type": "Subtree",
+			  "tasks": [ "/Script/StateTreeModule.StateTreeDelayTask" ] },
+			{ "name": "UseAttack", "type": "Linked", "linked_subtree": "Root/Attack" },
+			{ "name": "UseAsset", "type": "LinkedAsset", "linked_asset": "%s" }
+		] })"), *(LinkedTree != nullptr ? LinkedTree->GetPathName() : LinkedAssetPath)));
+
+	// Links are what is under test here, so the compile is left to the tree's author
+	auto ApplyWithoutCompile = [&](const TSharedPtr<FJsonObject>& Tree)
+	{
+		TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+		Params->SetStringField(TEXT("asset_path"), AssetPath);
+		Params->SetObjectField(TEXT("tree"), Tree);
+		Params->SetObjectField(TEXT("expected_fingerprint"), Fingerprint);
+		Params->SetBoolField(TEXT("compile"), false);
+		const FCortexCommandResult Result = Handler.Execute(TEXT("apply_tree"), Params);
+		if (Result.Data.IsValid() && Result.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+		{
+			Fingerprint = Result.Data->GetObjectField(TEXT("fingerprint"));
+		}
+		return Result;
+	};
+
+	TestTrue(TEXT("linked apply succeeds"), ApplyWithoutCompile(Document).bSuccess);
+
+	FCortexSTAssetContext Context;
+	FCortexCommandResult Error;
+	if (TestTrue(TEXT("asset loads"), CortexST::LoadAssetContext(AssetPath, Context, Error)))
+	{
+		UStateTreeState* Root = Context.EditorData->SubTrees[0];
+		UStateTreeState* Attack = FindChildState(Root, TEXT("Attack"));
+		UStateTreeState* UseAttack = FindChildState(Root, TEXT("UseAttack"));
+		UStateTreeState* UseAsset = FindChildState(Root, TEXT("UseAsset"));
+		TestTrue(TEXT("Linked state points at the subtree"),
+			Attack != nullptr && UseAttack != nullptr && UseAttack->LinkedSubtree.ID == Attack->ID);
+		TestTrue(TEXT("LinkedAsset state points at the asset"),
+			UseAsset != nullptr && LinkedTree != nullptr && UseAsset->LinkedAsset == LinkedTree);
+	}
+
+	// The export carries the links, so re-importing it changes nothing
+	const TSharedPtr<FJsonObject> Exported = ExportTree(Handler, AssetPath);
+	if (TestNotNull(TEXT("export succeeds"), Exported.Get()))
+	{
+		TestEqual(TEXT("re-importing the export makes zero changes"), GetChangeCount(ApplyWithoutCompile(Exported)), 0);
+	}
+
+	// A link target outside the document, or on the wrong state type, is rejected up front
+	const FCortexCommandResult MissingTarget = ApplyWithoutCompile(ParseDocument(TEXT(R"({
+		"name": "Root",
+		"children": [ { "name": "UseAttack", "type": "Linked", "linked_subtree": "Root/Missing" } ] })")));
+	TestFalse(TEXT("unknown linked subtree fails"), MissingTarget.bSuccess);
+	TestEqual(TEXT("error code is INVALID_FIELD"), MissingTarget.ErrorCode, CortexErrorCodes::InvalidField);
+
+	const FCortexCommandResult WrongType = ApplyWithoutCompile(ParseDocument(TEXT(R"({
+		"name": "Root",
+		"children": [ { "name": "Attack", "linked_subtree": "Root" } ] })")));
+	TestFalse(TEXT("linked_subtree without type Linked fails"), WrongType.bSuccess);
+
+	CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	CortexStateTreeTest::DeleteIfLoaded(LinkedAssetPath);
+	return true;
+}
@@ -0,0 +1,333 @@
+#include "Misc/AutomationTest.h"
+#include "CortexBatchMutation.h"
+#include "CortexCommandRouter.h"
+#include "CortexSTEditSession.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeCommandHandler.h"
+#include "CortexStateTreeTestUtils.h"
+#include "CortexTypes.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "StateTree.h"
+
+namespace
+{
+constexpr int32 ScriptStepCount = 200;
+
+bool CreateBatchTestStateTree(
+	FAutomationTestBase& Test,
+	FCortexStateTreeCommandHandler& Handler,
+	const FString& AssetPath,
+	TSharedPtr<FJsonObject>& OutFingerprint)
+{
+	TSharedPtr<FJsonObject> CreateParams = CortexStateTreeTest::Params();
+	CreateParams->SetStringField(TEXT("asset_path"), AssetPath);
+	CreateParams->SetStringField(TEXT("schema_class"), CortexStateTreeTest::GetTestSchemaClassPath());
+	CreateParams->SetStringField(TEXT("root_name"), TEXT("Root"));
+	CreateParams->SetBoolField(TEXT("save"), false);
+
+	const FCortexCommandResult CreateResult = Handler.Execute(TEXT("create_asset"), CreateParams);
+	Test.TestTrue(TEXT("create succeeds"), CreateResult.bSuccess);
+	if (!CreateResult.bSuccess || !CreateResult.Data.IsValid() || !CreateResult.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+	{
+		return false;
+	}
+
+	OutFingerprint = CreateResult.Data->GetObjectField(TEXT("fingerprint"));
+	return true;
+}
+
+/** Even steps add a state under Root, odd steps give it a transition back to Root; the last step compiles. */
+TSharedPtr<FJsonObject> MakeScriptStepParams(const FString& AssetPath, const int32 StepIndex, const FString& PreviousStateId, FString& OutCommand)
+{
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+	if (StepIndex % 2 == 0)
+	{
+		OutCommand = TEXT("add_state");
+		Params->SetStringField(TEXT("name"), FString::Printf(TEXT("Step%d"), StepIndex / 2));
+	}
+	else
+	{
+		OutCommand = TEXT("add_transition");
+		Params->SetStringField(TEXT("source_state_id"), PreviousStateId);
+		Params->SetStringField(TEXT("target_state_path"), TEXT("Root"));
+		Params->SetStringField(TEXT("trigger"), TEXT("OnStateCompleted"));
+	}
+	Params->SetBoolField(TEXT("compile"), StepIndex == ScriptStepCount - 1);
+	return Params;
+}
+
+TSharedPtr<FJsonValue> MakeAddStateStep(
+	const FString& AssetPath,
+	const TSharedPtr<FJsonObject>& Fingerprint,
+	const FString& Name,
+	const FString& StateType)
+{
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+	Params->SetStringField(TEXT("name"), Name);
+	Params->SetStringField(TEXT("type"), StateType);
+	Params->SetObjectField(TEXT("expected_fingerprint"), Fingerprint);
+	Params->SetBoolField(TEXT("compile"), true);
+	Params->SetBoolField(TEXT("save"), true);
+
+	TSharedPtr<FJsonObject> Step = MakeShared<FJsonObject>();
+	Step->SetStringField(TEXT("command"), TEXT("statetree.add_state"));
+	Step->SetObjectField(TEXT("params"), Params);
+	return MakeShared<FJsonValueObject>(Step);
+}
+
+TSharedPtr<FJsonObject> FindFinalizeReport(const FCortexCommandResult& BatchResult, const FString& AssetPath)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Reports = nullptr;
+	if (!BatchResult.Data.IsValid() || !BatchResult.Data->TryGetArrayField(TEXT("finalize"), Reports))
+	{
+		return nullptr;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Report : *Reports)
+	{
+		FString ReportPath;
+		if (Report->AsObject()->TryGetStringField(TEXT("asset_path"), ReportPath) && ReportPath == AssetPath)
+		{
+			return Report->AsObject();
+		}
+	}
+	return nullptr;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeBatchFinalizeTest,
+	"Cortex.StateTree.Batch.DeferredFinalize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeBatchFinalizeTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString DirectAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_BatchFinalizeDirect"));
+	const FString BatchAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_BatchFinalizeBatched"));
+
+	TSharedPtr<FJsonObject> DirectFingerprint;
+	TSharedPtr<FJsonObject> BatchFingerprint;
+	if (!CreateBatchTestStateTree(*this, Handler, DirectAssetPath, DirectFingerprint)
+		|| !CreateBatchTestStateTree(*this, Handler, BatchAssetPath, BatchFingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(DirectAssetPath);
+		CortexStateTreeTest::DeleteIfLoaded(BatchAssetPath);
+		return false;
+	}
+
+	// Baseline: the script as individual commands, each one running fixups itself
+	const double DirectStart = FPlatformTime::Seconds();
+	FString PreviousStateId;
+	int32 DirectFailures = 0;
+	for (int32 StepIndex = 0; StepIndex < ScriptStepCount; ++StepIndex)
+	{
+		FString Command;
+		const TSharedPtr<FJsonObject> Params = MakeScriptStepParams(DirectAssetPath, StepIndex, PreviousStateId, Command);
+		Params->SetObjectField(TEXT("expected_fingerprint"), DirectFingerprint);
+
+		const FCortexCommandResult Result = Handler.Execute(Command, Params);
+		if (!Result.bSuccess || !Result.Data.IsValid())
+		{
+			++DirectFailures;
+			break;
+		}
+		DirectFingerprint = Result.Data->GetObjectField(TEXT("fingerprint"));
+		Result.Data->TryGetStringField(TEXT("state_id"), PreviousStateId);
+	}
+	const double DirectMs = (FPlatformTime::Seconds() - DirectStart) * 1000.0;
+	TestEqual(TEXT("direct script succeeds"), DirectFailures, 0);
+
+	// The same script as one batch, chaining fingerprints and state IDs through $refs
+	TArray<TSharedPtr<FJsonValue>> Steps;
+	for (int32 StepIndex = 0; StepIndex < ScriptStepCount; ++StepIndex)
+	{
+		FString Command;
+		const TSharedPtr<FJsonObject> Params = MakeScriptStepParams(
+			BatchAssetPath,
+			StepIndex,
+			FString::Printf(TEXT("$steps[%d].data.state_id"), StepIndex - 1),
+			Command);
+		if (StepIndex == 0)
+		{
+			Params->SetObjectField(TEXT("expected_fingerprint"), BatchFingerprint);
+		}
+		else
+		{
+			Params->SetStringField(TEXT("expected_fingerprint"), FString::Printf(TEXT("$steps[%d].data.fingerprint"), StepIndex - 1));
+		}
+
+		TSharedPtr<FJsonObject> Step = MakeShared<FJsonObject>();
+		Step->SetStringField(TEXT("command"), FString::Printf(TEXT("statetree.%s"), *Command));
+		Step->SetObjectField(TEXT("params"), Params);
+		Steps.Add(MakeShared<FJsonValueObject>(Step));
+	}
+
+	TSharedPtr<FJsonObject> BatchParams = MakeShared<FJsonObject>();
+	BatchParams->SetArrayField(TEXT("commands"), Steps);
+	BatchParams->SetBoolField(TEXT("stop_on_error"), true);
+
+	FCortexCommandRouter Router;
+	Router.RegisterDomain(TEXT("statetree"), TEXT("Cortex StateTree"), TEXT("1.0.1"),
+		MakeShared<FCortexStateTreeCommandHandler>());
+
+	const int32 FlushesBefore = FCortexSTEditSession::GetFlushCount();
+	const double BatchStart = FPlatformTime::Seconds();
+	const FCortexCommandResult BatchResult = Router.Execute(TEXT("batch"), BatchParams);
+	const double BatchMs = (FPlatformTime::Seconds() - BatchStart) * 1000.0;
+
+	TestTrue(TEXT("batch succeeds"), BatchResult.bSuccess);
+	const TArray<TSharedPtr<FJsonValue>>* Results = nullptr;
+	if (BatchResult.Data.IsValid() && BatchResult.Data->TryGetArrayField(TEXT("results"), Results))
+	{
+		TestEqual(TEXT("every step ran"), Results->Num(), ScriptStepCount);
+
+		int32 FailedSteps = 0;
+		int32 StepsWithoutIds = 0;
+		for (const TSharedPtr<FJsonValue>& Entry : *Results)
+		{
+			const TSharedPtr<FJsonObject> EntryObject = Entry->AsObject();
+			bool bStepSuccess = false;
+			EntryObject->TryGetBoolField(TEXT("success"), bStepSuccess);
+			const TSharedPtr<FJsonObject>* StepData = nullptr;
+			if (!bStepSuccess || !EntryObject->TryGetObjectField(TEXT("data"), StepData))
+			{
+				++FailedSteps;
+				continue;
+			}
+
+			// Deferred steps still report what they resolved
+			FString StateId;
+			FString TransitionId;
+			if (!(*StepData)->TryGetStringField(TEXT("state_id"), StateId)
+				&& !(*StepData)->TryGetStringField(TEXT("transition_id"), TransitionId))
+			{
+				++StepsWithoutIds;
+			}
+		}
+		TestEqual(TEXT("no step failed"), FailedSteps, 0);
+		TestEqual(TEXT("every step reports its resolved ID"), StepsWithoutIds, 0);
+	}
+
+	TestEqual(TEXT("fixups and compile ran once for the batched asset"), FCortexSTEditSession::GetFlushCount() - FlushesBefore, 1);
+	TestEqual(TEXT("nothing left pending after the batch"), FCortexSTEditSession::NumPending(), 0);
+
+	FCortexSTAssetContext Context;
+	FCortexCommandResult Error;
+	if (TestTrue(TEXT("batched asset loads"), CortexST::LoadAssetContext(BatchAssetPath, Context, Error)))
+	{
+		TestTrue(TEXT("compile requested by the last step ran at batch end"), Context.StateTree->IsReadyToRun());
+	}
+
+	AddInfo(FString::Printf(
+		TEXT("%d-step authoring script: direct %.2f ms, batched %.2f ms (%.1fx)"),
+		ScriptStepCount,
+		DirectMs,
+		BatchMs,
+		BatchMs > 0.0 ? DirectMs / BatchMs : 0.0));
+
+	CortexStateTreeTest::DeleteIfLoaded(DirectAssetPath);
+	CortexStateTreeTest::DeleteIfLoaded(BatchAssetPath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeBatchFinalizeReportTest,
+	"Cortex.StateTree.Batch.FinalizeReport",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeBatchFinalizeReportTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString SavedAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_BatchFinalizeSaved"));
+	const FString BrokenAssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_BatchFinalizeBroken"));
+
+	TSharedPtr<FJsonObject> SavedFingerprint;
+	TSharedPtr<FJsonObject> BrokenFingerprint;
+	if (!CreateBatchTestStateTree(*this, Handler, SavedAssetPath, SavedFingerprint)
+		|| !CreateBatchTestStateTree(*this, Handler, BrokenAssetPath, BrokenFingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(SavedAssetPath);
+		CortexStateTreeTest::DeleteIfLoaded(BrokenAssetPath);
+		return false;
+	}
+
+	// A linked state without a linked subtree passes the mutation but fails to compile
+	TArray<TSharedPtr<FJsonValue>> Steps;
+	Steps.Add(MakeAddStateStep(SavedAssetPath, SavedFingerprint, TEXT("Idle"), TEXT("State")));
+	Steps.Add(MakeAddStateStep(BrokenAssetPath, BrokenFingerprint, TEXT("Dangling"), TEXT("Linked")));
+
+	TSharedPtr<FJsonObject> BatchParams = MakeShared<FJsonObject>();
+	BatchParams->SetArrayField(TEXT("commands"), Steps);
+	BatchParams->SetBoolField(TEXT("stop_on_error"), true);
+
+	FCortexCommandRouter Router;
+	Router.RegisterDomain(TEXT("statetree"), TEXT("Cortex StateTree"), TEXT("1.0.1"),
+		MakeShared<FCortexStateTreeCommandHandler>());
+
+	const FCortexCommandResult BatchResult = Router.Execute(TEXT("batch"), BatchParams);
+	TestTrue(TEXT("batch succeeds"), BatchResult.bSuccess);
+
+	double FinalizeFailed = -1.0;
+	if (BatchResult.Data.IsValid())
+	{
+		BatchResult.Data->TryGetNumberField(TEXT("finalize_failed"), FinalizeFailed);
+	}
+	TestEqual(TEXT("only the broken asset fails to finalize"), static_cast<int32>(FinalizeFailed), 1);
+
+	FCortexSTAssetContext Context;
+	FCortexCommandResult Error;
+
+	const TSharedPtr<FJsonObject> SavedReport = FindFinalizeReport(BatchResult, SavedAssetPath);
+	if (TestTrue(TEXT("saved asset has a finalize report"), SavedReport.IsValid()))
+	{
+		TestTrue(TEXT("saved asset finalizes"), SavedReport->GetBoolField(TEXT("success")));
+		TestTrue(TEXT("saved asset compiled"), SavedReport->GetBoolField(TEXT("compiled")));
+		TestTrue(TEXT("deferred save ran"), SavedReport->GetBoolField(TEXT("saved")));
+		TestTrue(TEXT("report carries validation"), SavedReport->HasTypedField<EJson::Object>(TEXT("validation")));
+		if (TestTrue(TEXT("saved asset loads"), CortexST::LoadAssetContext(SavedAssetPath, Context, Error)))
+		{
+			TestFalse(TEXT("package is clean after the deferred save"), Context.StateTree->GetOutermost()->IsDirty());
+			TestTrue(
+				TEXT("report fingerprint is the post-save fingerprint"),
+				FCortexBatchMutation::FingerprintsMatch(
+					SavedReport->GetObjectField(TEXT("fingerprint")),
+					CortexST::MakeFingerprint(Context.StateTree)));
+		}
+	}
+
+	const TSharedPtr<FJsonObject> BrokenReport = FindFinalizeReport(BatchResult, BrokenAssetPath);
+	if (TestTrue(TEXT("broken asset has a finalize report"), BrokenReport.IsValid()))
+	{
+		TestFalse(TEXT("compile failure is reported"), BrokenReport->GetBoolField(TEXT("success")));
+		TestFalse(TEXT("failed compile skips the save"), BrokenReport->GetBoolField(TEXT("saved")));
+		TestTrue(TEXT("failure carries an error"), BrokenReport->HasTypedField<EJson::String>(TEXT("error")));
+
+		const TSharedPtr<FJsonObject>* Compile = nullptr;
+		if (TestTrue(TEXT("compile diagnostics are reported"), BrokenReport->TryGetObjectField(TEXT("compile"), Compile)))
+		{
+			TestEqual(TEXT("compile status is error"), (*Compile)->GetStringField(TEXT("status")), FString(TEXT("error")));
+			TestTrue(TEXT("at least one compile error"), (*Compile)->GetNumberField(TEXT("error_count")) > 0);
+		}
+		if (TestTrue(TEXT("broken asset loads"), CortexST::LoadAssetContext(BrokenAssetPath, Context, Error)))
+		{
+			TestTrue(
+				TEXT("report fingerprint matches the unsaved asset"),
+				FCortexBatchMutation::FingerprintsMatch(
+					BrokenReport->GetObjectField(TEXT("fingerprint")),
+					CortexST::MakeFingerprint(Context.StateTree)));
+		}
+	}
+
+	TestEqual(TEXT("nothing left pending after the batch"), FCortexSTEditSession::NumPending(), 0);
+
+	CortexStateTreeTest::DeleteIfLoaded(SavedAssetPath);
+	CortexStateTreeTest::DeleteIfLoaded(BrokenAssetPath);
+	return true;
+}
@@ -144,9 +144,13 @@ bool FCortexStateTreeModuleRegistrationTest::RunTest(const FString& Parameters)
 		TEXT("delete_asset"),
 		TEXT("dump_tree"),
 		TEXT("get_state"),
+		TEXT("export_tree"),
+		TEXT("apply_tree"),
 		TEXT("check_structure"),
 		TEXT("validate_asset"),
 		TEXT("compile"),
+		TEXT("validate_all"),
+		TEXT("compile_all"),
 		TEXT("add_state"),
 		TEXT("remove_state"),
 		TEXT("rename_state"),
@@ -0,0 +1,266 @@
+#include "Misc/AutomationTest.h"
+#include "CortexSTStateIndex.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeCommandHandler.h"
+#include "CortexStateTreeTestUtils.h"
+#include "CortexTypes.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "StateTree.h"
+#include "StateTreeEditorData.h"
+#include "StateTreeState.h"
+
+namespace
+{
+bool CreateIndexTestStateTree(
+	FAutomationTestBase& Test,
+	FCortexStateTreeCommandHandler& Handler,
+	const FString& AssetPath,
+	FCortexSTAssetContext& OutContext,
+	TSharedPtr<FJsonObject>& OutFingerprint)
+{
+	TSharedPtr<FJsonObject> CreateParams = CortexStateTreeTest::Params();
+	CreateParams->SetStringField(TEXT("asset_path"), AssetPath);
+	CreateParams->SetStringField(TEXT("schema_class"), CortexStateTreeTest::GetTestSchemaClassPath());
+	CreateParams->SetStringField(TEXT("root_name"), TEXT("Root"));
+	CreateParams->SetBoolField(TEXT("save"), false);
+
+	const FCortexCommandResult CreateResult = Handler.Execute(TEXT("create_asset"), CreateParams);
+	Test.TestTrue(TEXT("create succeeds"), CreateResult.bSuccess);
+	if (!CreateResult.bSuccess || !CreateResult.Data.IsValid() || !CreateResult.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+	{
+		return false;
+	}
+
+	OutFingerprint = CreateResult.Data->GetObjectField(TEXT("fingerprint"));
+	FCortexCommandResult Error;
+	return CortexST::LoadAssetContext(AssetPath, OutContext, Error)
+		&& OutContext.EditorData != nullptr
+		&& OutContext.EditorData->SubTrees.Num() > 0;
+}
+
+TSharedPtr<FJsonObject> MakeSelectorParams(const FString& AssetPath, const TCHAR* Field, const FString& Value)
+{
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetStringField(TEXT("asset_path"), AssetPath);
+	Params->SetStringField(Field, Value);
+	return Params;
+}
+
+FCortexCommandResult ExecuteMutation(
+	FCortexStateTreeCommandHandler& Handler,
+	const FString& Command,
+	const TSharedPtr<FJsonObject>& Params,
+	TSharedPtr<FJsonObject>& InOutFingerprint)
+{
+	Params->SetObjectField(TEXT("expected_fingerprint"), InOutFingerprint);
+	const FCortexCommandResult Result = Handler.Execute(Command, Params);
+	if (Result.Data.IsValid() && Result.Data->HasTypedField<EJson::Object>(TEXT("fingerprint")))
+	{
+		InOutFingerprint = Result.Data->GetObjectField(TEXT("fingerprint"));
+	}
+	return Result;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeStateIndexBenchmarkTest,
+	"Cortex.StateTree.StateIndex.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeStateIndexBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString AssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_StateIndexBenchmark"));
+
+	FCortexSTAssetContext Context;
+	TSharedPtr<FJsonObject> Fingerprint;
+	if (!CreateIndexTestStateTree(*this, Handler, AssetPath, Context, Fingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		return false;
+	}
+
+	// 2,000 states, eight children per state, five levels deep
+	constexpr int32 StateCount = 2000;
+	constexpr int32 Fanout = 8;
+	UStateTreeState* RootState = Context.EditorData->SubTrees[0];
+	TArray<UStateTreeState*> Generated;
+	Generated.Reserve(StateCount);
+	for (int32 StateIndex = 0; StateIndex < StateCount; ++StateIndex)
+	{
+		UStateTreeState* Parent = StateIndex < Fanout ? RootState : Generated[StateIndex / Fanout - 1];
+		Generated.Add(&Parent->AddChildState(FName(*FString::Printf(TEXT("S%d"), StateIndex))));
+	}
+	Context.EditorData->Modify();
+
+	TArray<UStateTreeState*> Samples;
+	for (int32 StateIndex = 0; StateIndex < StateCount; StateIndex += 10)
+	{
+		Samples.Add(Generated[StateIndex]);
+	}
+
+	// Baseline: what every ResolveState call cost before the index, one full walk per lookup
+	int32 WalkHits = 0;
+	const double WalkStart = FPlatformTime::Seconds();
+	for (const UStateTreeState* Sample : Samples)
+	{
+		const FString SampleId = Sample->ID.ToString(EGuidFormats::DigitsWithHyphens);
+		TArray<FCortexSTStateRef> States;
+		CortexST::CollectStates(RootState, States);
+		WalkHits += States.ContainsByPredicate([&SampleId](const FCortexSTStateRef& StateRef) { return StateRef.Id == SampleId; }) ? 1 : 0;
+	}
+	const double WalkMs = (FPlatformTime::Seconds() - WalkStart) * 1000.0;
+
+	const int32 BuildsBefore = FCortexSTStateIndex::Get().GetBuildCount();
+	int32 IdHits = 0;
+	int32 PathHits = 0;
+	const double IndexStart = FPlatformTime::Seconds();
+	for (UStateTreeState* Sample : Samples)
+	{
+		FCortexSTStateRef ById;
+		FCortexSTStateRef ByPath;
+		FCortexCommandResult Error;
+		const FString SampleId = Sample->ID.ToString(EGuidFormats::DigitsWithHyphens);
+		if (CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_id"), SampleId), ById, Error) && ById.State == Sample)
+		{
+			++IdHits;
+			if (CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_path"), ById.Path), ByPath, Error) && ByPath.State == Sample)
+			{
+				++PathHits;
+			}
+		}
+	}
+	const double IndexMs = (FPlatformTime::Seconds() - IndexStart) * 1000.0;
+
+	TestEqual(TEXT("full walk finds every sample"), WalkHits, Samples.Num());
+	TestEqual(TEXT("index resolves every sample by id"), IdHits, Samples.Num());
+	TestEqual(TEXT("index resolves every sample by path"), PathHits, Samples.Num());
+	TestEqual(TEXT("one walk serves every lookup"), FCortexSTStateIndex::Get().GetBuildCount() - BuildsBefore, 1);
+
+	AddInfo(FString::Printf(
+		TEXT("%d-state tree, %d lookups: full walk per lookup %.2f ms, index %.2f ms for twice the lookups"),
+		StateCount + 1,
+		Samples.Num(),
+		WalkMs,
+		IndexMs));
+
+	// A Cortex mutation patches the entry instead of forcing another walk
+	TSharedPtr<FJsonObject> RenameParams = MakeSelectorParams(
+		AssetPath, TEXT("state_id"), Generated[0]->ID.ToString(EGuidFormats::DigitsWithHyphens));
+	RenameParams->SetStringField(TEXT("name"), TEXT("Renamed"));
+	const FCortexCommandResult Rename = ExecuteMutation(Handler, TEXT("rename_state"), RenameParams, Fingerprint);
+	TestTrue(TEXT("rename_state succeeds"), Rename.bSuccess);
+
+	const int32 BuildsAfterRename = FCortexSTStateIndex::Get().GetBuildCount();
+	FCortexSTStateRef Descendant;
+	FCortexCommandResult Error;
+	TestTrue(TEXT("descendant resolves under the renamed path"),
+		CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_path"), TEXT("Root/Renamed/S8/S72")), Descendant, Error)
+		&& Descendant.State == Generated[72]);
+	TestEqual(TEXT("rename is patched in place"), FCortexSTStateIndex::Get().GetBuildCount(), BuildsAfterRename);
+
+	CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeStateIndexUpdatesTest,
+	"Cortex.StateTree.StateIndex.Updates",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeStateIndexUpdatesTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	const FString AssetPath = CortexStateTreeTest::MakeAssetPath(TEXT("ST_StateIndexUpdates"));
+
+	FCortexSTAssetContext Context;
+	TSharedPtr<FJsonObject> Fingerprint;
+	if (!CreateIndexTestStateTree(*this, Handler, AssetPath, Context, Fingerprint))
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+		return false;
+	}
+
+	FCortexSTStateIndex& Index = FCortexSTStateIndex::Get();
+
+	TSharedPtr<FJsonObject> AddGroupParams = CortexStateTreeTest::Params();
+	AddGroupParams->SetStringField(TEXT("asset_path"), AssetPath);
+	AddGroupParams->SetStringField(TEXT("name"), TEXT("Group"));
+	TestTrue(TEXT("add group succeeds"), ExecuteMutation(Handler, TEXT("add_state"), AddGroupParams, Fingerprint).bSuccess);
+
+	const int32 BuildsAfterFirstAdd = Index.GetBuildCount();
+
+	TSharedPtr<FJsonObject> AddLeafParams = MakeSelectorParams(AssetPath, TEXT("parent_state_path"), TEXT("Root/Group"));
+	AddLeafParams->SetStringField(TEXT("name"), TEXT("Leaf"));
+	const FCortexCommandResult AddLeaf = ExecuteMutation(Handler, TEXT("add_state"), AddLeafParams, Fingerprint);
+	TestTrue(TEXT("add leaf succeeds"), AddLeaf.bSuccess);
+
+	FString LeafId;
+	TestTrue(TEXT("add leaf returns state_id"),
+		AddLeaf.Data.IsValid() && AddLeaf.Data->TryGetStringField(TEXT("state_id"), LeafId));
+
+	TSharedPtr<FJsonObject> MoveParams = MakeSelectorParams(AssetPath, TEXT("state_id"), LeafId);
+	MoveParams->SetStringField(TEXT("new_parent_state_path"), TEXT("Root"));
+	TestTrue(TEXT("move leaf succeeds"), ExecuteMutation(Handler, TEXT("move_state"), MoveParams, Fingerprint).bSuccess);
+
+	TSharedPtr<FJsonObject> TransitionParams = MakeSelectorParams(AssetPath, TEXT("source_state_path"), TEXT("Root/Leaf"));
+	TransitionParams->SetStringField(TEXT("target_state_path"), TEXT("Root/Group"));
+	const FCortexCommandResult AddTransition = ExecuteMutation(Handler, TEXT("add_transition"), TransitionParams, Fingerprint);
+	TestTrue(TEXT("add transition succeeds"), AddTransition.bSuccess);
+
+	FCortexSTStateRef LeafRef;
+	FCortexCommandResult Error;
+	TestTrue(TEXT("moved leaf resolves by its new path"),
+		CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_path"), TEXT("Root/Leaf")), LeafRef, Error)
+		&& LeafRef.Id == LeafId);
+
+	FString TransitionId;
+	FGuid TransitionGuid;
+	FCortexSTStateRef OwnerRef;
+	TestTrue(TEXT("add transition returns transition_id"),
+		AddTransition.Data.IsValid() && AddTransition.Data->TryGetStringField(TEXT("transition_id"), TransitionId));
+
+	// Engines that leave the transition ID unset hand out owner-scoped tokens instead
+	const bool bHasTransitionGuid = FGuid::Parse(TransitionId, TransitionGuid);
+	if (bHasTransitionGuid)
+	{
+		TestTrue(TEXT("transition owner is indexed"),
+			Index.FindTransitionOwner(Context.EditorData, TransitionGuid, OwnerRef) && OwnerRef.State == LeafRef.State);
+	}
+
+	TestEqual(TEXT("adds, move and transition are patched in place"), Index.GetBuildCount(), BuildsAfterFirstAdd);
+
+	// The old path is gone; the miss walks once to be sure and still finds nothing
+	FCortexSTStateRef Missing;
+	TestFalse(TEXT("old leaf path no longer resolves"),
+		CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_path"), TEXT("Root/Group/Leaf")), Missing, Error));
+	TestEqual(TEXT("missing path reports not found"), Error.ErrorCode, CortexErrorCodes::StateTreeStateNotFound);
+
+	// Edits made outside Cortex are picked up through Modify()
+	const int32 BuildsBeforeExternalEdit = Index.GetBuildCount();
+	UStateTreeState* Leaf = LeafRef.State;
+	Leaf->Modify();
+	Leaf->Name = TEXT("External");
+
+	FCortexSTStateRef ExternalRef;
+	TestTrue(TEXT("externally renamed state resolves"),
+		CortexST::ResolveState(Context, MakeSelectorParams(AssetPath, TEXT("state_path"), TEXT("Root/External")), ExternalRef, Error)
+		&& ExternalRef.State == Leaf);
+	TestEqual(TEXT("external edit rebuilds once"), Index.GetBuildCount(), BuildsBeforeExternalEdit + 1);
+
+	TSharedPtr<FJsonObject> RemoveParams = MakeSelectorParams(AssetPath, TEXT("state_id"), LeafId);
+	TestTrue(TEXT("remove leaf succeeds"), ExecuteMutation(Handler, TEXT("remove_state"), RemoveParams, Fingerprint).bSuccess);
+	TestFalse(TEXT("removed state no longer resolves by id"),
+		Index.FindById(Context.EditorData, LeafId, Missing));
+	if (bHasTransitionGuid)
+	{
+		TestFalse(TEXT("removed state's transition is dropped"),
+			Index.FindTransitionOwner(Context.EditorData, TransitionGuid, OwnerRef));
+	}
+
+	CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	return true;
+}
@@ -0,0 +1,146 @@
+#include "Misc/AutomationTest.h"
+#include "CortexSTTypes.h"
+#include "CortexStateTreeCommandHandler.h"
+#include "CortexStateTreeTestUtils.h"
+#include "CortexTypes.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Operations/CortexSTValidationOps.h"
+#include "StateTree.h"
+
+namespace
+{
+constexpr int32 BulkAssetCount = 3;
+
+TSharedPtr<FJsonObject> MakeBulkParams(const TArray<FString>& AssetPaths, const bool bForce)
+{
+	TArray<TSharedPtr<FJsonValue>> PathValues;
+	for (const FString& AssetPath : AssetPaths)
+	{
+		PathValues.Add(MakeShared<FJsonValueString>(AssetPath));
+	}
+
+	TSharedPtr<FJsonObject> Params = CortexStateTreeTest::Params();
+	Params->SetArrayField(TEXT("asset_paths"), PathValues);
+	Params->SetBoolField(TEXT("force"), bForce);
+	return Params;
+}
+
+int32 GetCount(const FCortexCommandResult& Result, const TCHAR* FieldName)
+{
+	double Value = -1.0;
+	if (Result.Data.IsValid())
+	{
+		Result.Data->TryGetNumberField(FieldName, Value);
+	}
+	return static_cast<int32>(Value);
+}
+
+double GetTotalMs(const FCortexCommandResult& Result)
+{
+	const TSharedPtr<FJsonObject>* Timing = nullptr;
+	double TotalMs = 0.0;
+	if (Result.Data.IsValid() && Result.Data->TryGetObjectField(TEXT("timing_ms"), Timing))
+	{
+		(*Timing)->TryGetNumberField(TEXT("total"), TotalMs);
+	}
+	return TotalMs;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCortexStateTreeValidateAllTest,
+	"Cortex.StateTree.ValidateAll.SkipsUnchanged",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexStateTreeValidateAllTest::RunTest(const FString& Parameters)
+{
+	FCortexStateTreeCommandHandler Handler;
+	FCortexSTValidationOps::ResetBulkCache();
+
+	TArray<FString> AssetPaths;
+	for (int32 Index = 0; Index < BulkAssetCount; ++Index)
+	{
+		const FString AssetPath = CortexStateTreeTest::MakeAssetPath(FString::Printf(TEXT("ST_ValidateAll%d"), Index));
+		TSharedPtr<FJsonObject> CreateParams = CortexStateTreeTest::Params();
+		CreateParams->SetStringField(TEXT("asset_path"), AssetPath);
+		CreateParams->SetStringField(TEXT("schema_class"), CortexStateTreeTest::GetTestSchemaClassPath());
+		CreateParams->SetStringField(TEXT("root_name"), TEXT("Root"));
+		CreateParams->SetBoolField(TEXT("save"), false);
+		TestTrue(TEXT("create succeeds"), Handler.Execute(TEXT("create_asset"), CreateParams).bSuccess);
+		AssetPaths.Add(AssetPath);
+	}
+
+	const FCortexCommandResult FirstRun = Handler.Execute(TEXT("validate_all"), MakeBulkParams(AssetPaths, false));
+	TestTrue(TEXT("validate_all succeeds"), FirstRun.bSuccess);
+	TestEqual(TEXT("first run checks every asset"), GetCount(FirstRun, TEXT("checked")), BulkAssetCount);
+	TestEqual(TEXT("first run skips nothing"), GetCount(FirstRun, TEXT("skipped")), 0);
+	TestEqual(TEXT("fresh assets pass"), GetCount(FirstRun, TEXT("failed")), 0);
+
+	const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+	if (FirstRun.Data.IsValid() && FirstRun.Data->TryGetArrayField(TEXT("assets"), Assets))
+	{
+		TestEqual(TEXT("one report entry per asset"), Assets->Num(), BulkAssetCount);
+		for (const TSharedPtr<FJsonValue>& Entry : *Assets)
+		{
+			TestTrue(TEXT("entry reports its timing"), Entry->AsObject()->HasTypedField<EJson::Object>(TEXT("timing_ms")));
+		}
+	}
+
+	const FCortexCommandResult SecondRun = Handler.Execute(TEXT("validate_all"), MakeBulkParams(AssetPaths, false));
+	TestEqual(TEXT("unchanged assets are skipped"), GetCount(SecondRun, TEXT("skipped")), BulkAssetCount);
+	TestEqual(TEXT("nothing rechecked"), GetCount(SecondRun, TEXT("checked")), 0);
+
+	// An edit changes the fingerprint, so only that asset is checked again
+	TSharedPtr<FJsonObject> AddParams = CortexStateTreeTest::Params();
+	AddParams->SetStringField(TEXT("asset_path"), AssetPaths[0]);
+	AddParams->SetStringField(TEXT("name"), TEXT("Edited"));
+	FCortexSTAssetContext Context;
+	FCortexCommandResult Error;
+	if (TestTrue(TEXT("first asset loads"), CortexST::LoadAssetContext(AssetPaths[0], Context, Error)))
+	{
+		AddParams->SetObjectField(TEXT("expected_fingerprint"), CortexST::MakeFingerprint(Context.StateTree));
+	}
+	TestTrue(TEXT("add_state succeeds"), Handler.Execute(TEXT("add_state"), AddParams).bSuccess);
+
+	const FCortexCommandResult EditedRun = Handler.Execute(TEXT("validate_all"), MakeBulkParams(AssetPaths, false));
+	TestEqual(TEXT("only the edited asset is rechecked"), GetCount(EditedRun, TEXT("checked")), 1);
+
+	const FCortexCommandResult ForcedRun = Handler.Execute(TEXT("validate_all"), MakeBulkParams(AssetPaths, true));
+	TestEqual(TEXT("force rechecks everything"), GetCount(ForcedRun, TEXT("checked")), BulkAssetCount);
+
+	const FCortexCommandResult CompileRun = Handler.Execute(TEXT("compile_all"), MakeBulkParams(AssetPaths, false));
+	TestTrue(TEXT("compile_all succeeds"), CompileRun.bSuccess);
+	TestEqual(TEXT("every asset compiles"), GetCount(CompileRun, TEXT("failed")), 0);
+	for (const FString& AssetPath : AssetPaths)
+	{
+		if (CortexST::LoadAssetContext(AssetPath, Context, Error))
+		{
+			TestTrue(TEXT("compiled asset is ready to run"), Context.StateTree->IsReadyToRun());
+		}
+	}
+
+	const FCortexCommandResult CompileAgain = Handler.Execute(TEXT("compile_all"), MakeBulkParams(AssetPaths, false));
+	TestEqual(TEXT("compiled assets are skipped"), GetCount(CompileAgain, TEXT("skipped")), BulkAssetCount);
+
+	TArray<FString> MissingPath = { CortexStateTreeTest::MakeAssetPath(TEXT("ST_ValidateAllMissing")) };
+	const FCortexCommandResult MissingRun = Handler.Execute(TEXT("validate_all"), MakeBulkParams(MissingPath, false));
+	TestTrue(TEXT("missing asset is reported, not fatal"), MissingRun.bSuccess);
+	TestEqual(TEXT("missing asset counts as failed"), GetCount(MissingRun, TEXT("failed")), 1);
+
+	AddInfo(FString::Printf(
+		TEXT("%d assets: first validate %.2f ms, cached %.2f ms, forced %.2f ms, compile %.2f ms"),
+		BulkAssetCount,
+		GetTotalMs(FirstRun),
+		GetTotalMs(SecondRun),
+		GetTotalMs(ForcedRun),
+		GetTotalMs(CompileRun)));
+
+	for (const FString& AssetPath : AssetPaths)
+	{
+		CortexStateTreeTest::DeleteIfLoaded(AssetPath);
+	}
+	FCortexSTValidationOps::ResetBulkCache();
+	return true;
+}
@@ -39,6 +39,10 @@ FCortexCommandResult FCortexUMGCommandHandler::Execute(
     {
         return FCortexUMGWidgetTreeOps::DuplicateWidget(Params);
     }
+    if (Command == TEXT("build_tree"))
+    {
+        return FCortexUMGWidgetTreeOps::BuildTree(Params);
+    }
 
     if (Command == TEXT("set_color"))
     {
@@ -80,6 +84,10 @@ FCortexCommandResult FCortexUMGCommandHandler::Execute(
     {
         return FCortexUMGWidgetPropertyOps::SetProperty(Params);
     }
+    if (Command == TEXT("set_properties_bulk"))
+    {
+        return FCortexUMGWidgetPropertyOps::SetPropertiesBulk(Params);
+    }
     if (Command == TEXT("get_property"))
     {
         return FCortexUMGWidgetPropertyOps::GetProperty(Params);
@@ -136,6 +144,11 @@ TArray<FCortexCommandInfo> FCortexUMGCommandHandler::GetSupportedCommands() cons
             .Required(TEXT("widget_name"), TEXT("string"), TEXT("Widget to duplicate"))
             .Optional(TEXT("new_name"), TEXT("string"), TEXT("Explicit new widget name"))
             .Optional(TEXT("name_prefix"), TEXT("string"), TEXT("Prefix for generated duplicate names")),
+        FCortexCommandInfo{ TEXT("build_tree"), TEXT("Build a widget subtree from a nested JSON spec in one pass") }
+            .Required(TEXT("asset_path"), TEXT("string"), TEXT("Widget Blueprint asset path"))
+            .Required(TEXT("tree"), TEXT("object"), TEXT("Spec node: class, name, slot, properties, children"))
+            .Optional(TEXT("parent_name"), TEXT("string"), TEXT("Attach under this panel instead of at the root"))
+            .Optional(TEXT("mode"), TEXT("string"), TEXT("replace (default) clears the attach point first; merge updates widgets matched by name")),
         FCortexCommandInfo{ TEXT("set_color"), TEXT("Set foreground or background color") }
             .Required(TEXT("asset_path"), TEXT("string"), TEXT("Widget Blueprint asset path"))
             .Required(TEXT("widget_name"), TEXT("string"), TEXT("Widget to modify"))
@@ -189,6 +202,9 @@ TArray<FCortexCommandInfo> FCortexUMGCommandHandler::GetSupportedCommands() cons
             .Required(TEXT("widget_name"), TEXT("string"), TEXT("Widget to modify"))
             .Required(TEXT("property_path"), TEXT("string"), TEXT("Property path"))
             .Required(TEXT("value"), TEXT("object"), TEXT("Property value")),
+        FCortexCommandInfo{ TEXT("set_properties_bulk"), TEXT("Set many widget properties in one transaction with one Blueprint update") }
+            .Required(TEXT("asset_path"), TEXT("string"), TEXT("Widget Blueprint asset path"))
+            .Required(TEXT("properties"), TEXT("array"), TEXT("Entries of {widget_name, property_path, value}")),
         FCortexCommandInfo{ TEXT("get_property"), TEXT("Read any property value") }
             .Required(TEXT("asset_path"), TEXT("string"), TEXT("Widget Blueprint asset path"))
             .Required(TEXT("widget_name"), TEXT("string"), TEXT("Widget to inspect"))
@@ -2,6 +2,7 @@
 #include "CortexCoreModule.h"
 #include "ICortexCommandRegistry.h"
 #include "CortexUMGCommandHandler.h"
+#include "CortexUMGWidgetIndex.h"
 
 DEFINE_LOG_CATEGORY(LogCortexUMG);
 
@@ -26,6 +27,7 @@ void FCortexUMGModule::StartupModule()
 void FCortexUMGModule::ShutdownModule()
 {
     UE_LOG(LogCortexUMG, Log, TEXT("CortexUMG module shutting down"));
+    FCortexUMGWidgetIndex::Reset();
 }
 
 IMPLEMENT_MODULE(FCortexUMGModule, CortexUMG)
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "CortexCommandRouter.h"
 #include "CortexPropertyUtils.h"
+#include "CortexUMGWidgetIndex.h"
 #include "WidgetBlueprint.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/PanelWidget.h"
@@ -44,36 +45,11 @@ namespace CortexUMGUtils
 
     inline UWidget* FindWidgetByName(UWidgetTree* WidgetTree, const FString& Name)
     {
-        if (!WidgetTree || !WidgetTree->RootWidget)
+        if (Name.IsEmpty())
         {
             return nullptr;
         }
-
-        TFunction<UWidget*(UWidget*)> Search = [&](UWidget* Widget) -> UWidget*
-        {
-            if (!Widget)
-            {
-                return nullptr;
-            }
-            if (Widget->GetName() == Name)
-            {
-                return Widget;
-            }
-
-            if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
-            {
-                for (int32 i = 0; i < Panel->GetChildrenCount(); ++i)
-                {
-                    if (UWidget* Found = Search(Panel->GetChildAt(i)))
-                    {
-                        return Found;
-                    }
-                }
-            }
-            return nullptr;
-        };
-
-        return Search(WidgetTree->RootWidget);
+        return FCortexUMGWidgetIndex::Get().Find(WidgetTree, FName(*Name));
     }
 
     inline bool WidgetNameExists(UWidgetTree* WidgetTree, const FString& Name)
@@ -0,0 +1,98 @@
+#include "CortexUMGWidgetIndex.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/PanelWidget.h"
+#include "Components/Widget.h"
+
+TUniquePtr<FCortexUMGWidgetIndex> FCortexUMGWidgetIndex::Instance;
+
+FCortexUMGWidgetIndex& FCortexUMGWidgetIndex::Get()
+{
+    if (!Instance.IsValid())
+    {
+        Instance = MakeUnique<FCortexUMGWidgetIndex>();
+    }
+    return *Instance;
+}
+
+void FCortexUMGWidgetIndex::Reset()
+{
+    Instance.Reset();
+}
+
+UWidget* FCortexUMGWidgetIndex::Find(UWidgetTree* WidgetTree, FName Name)
+{
+    if (!WidgetTree || !WidgetTree->RootWidget || Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    if (const FNameMap* Names = Trees.Find(FObjectKey(WidgetTree)))
+    {
+        if (const TWeakObjectPtr<UWidget>* Cached = Names->Find(Name))
+        {
+            UWidget* Widget = Cached->Get();
+            if (IsStillIndexed(WidgetTree, Widget, Name))
+            {
+                return Widget;
+            }
+        }
+    }
+
+    // Unknown name or a stale entry: the tree changed since the last walk
+    const TWeakObjectPtr<UWidget>* Found = Rebuild(WidgetTree).Find(Name);
+    return Found ? Found->Get() : nullptr;
+}
+
+bool FCortexUMGWidgetIndex::IsStillIndexed(const UWidgetTree* WidgetTree, const UWidget* Widget, FName Name)
+{
+    if (!IsValid(Widget) || Widget->GetFName() != Name)
+    {
+        return false;
+    }
+
+    // Removed widgets keep their name and outer, so follow the slots back up to the root
+    const UWidget* Current = Widget;
+    while (const UPanelWidget* Parent = Current->GetParent())
+    {
+        Current = Parent;
+    }
+    return Current == WidgetTree->RootWidget;
+}
+
+FCortexUMGWidgetIndex::FNameMap& FCortexUMGWidgetIndex::Rebuild(UWidgetTree* WidgetTree)
+{
+    for (auto It = Trees.CreateIterator(); It; ++It)
+    {
+        if (It.Key().ResolveObjectPtr() == nullptr)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FNameMap& Names = Trees.FindOrAdd(FObjectKey(WidgetTree));
+    Names.Reset();
+
+    // Pre-order, children in slot order, so the first widget a walk would meet wins a name
+    TArray<UWidget*> Stack;
+    Stack.Add(WidgetTree->RootWidget);
+    while (Stack.Num() > 0)
+    {
+        UWidget* Widget = Stack.Pop(EAllowShrinking::No);
+        if (!Widget)
+        {
+            continue;
+        }
+        Names.FindOrAdd(Widget->GetFName(), Widget);
+
+        if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
+        {
+            for (int32 i = Panel->GetChildrenCount() - 1; i >= 0; --i)
+            {
+                Stack.Add(Panel->GetChildAt(i));
+            }
+        }
+    }
+
+    ++BuildCount;
+    return Names;
+}
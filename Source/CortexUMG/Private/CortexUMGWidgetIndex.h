@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UWidget;
+class UWidgetTree;
+
+/**
+ * Widget name lookup cached per UWidgetTree. A hit is trusted only while the widget still
+ * carries that name and still hangs under the tree's root; anything else rebuilds the
+ * tree's map with one walk. Game thread only.
+ */
+class FCortexUMGWidgetIndex
+{
+public:
+    static FCortexUMGWidgetIndex& Get();
+    static void Reset();
+
+    /** Same result as a depth-first walk from the root widget, without walking on a hit. */
+    UWidget* Find(UWidgetTree* WidgetTree, FName Name);
+
+    /** Maps built since startup, so tests can tell a hit from a rebuild. */
+    int32 GetBuildCount() const { return BuildCount; }
+
+private:
+    using FNameMap = TMap<FName, TWeakObjectPtr<UWidget>>;
+
+    static bool IsStillIndexed(const UWidgetTree* WidgetTree, const UWidget* Widget, FName Name);
+
+    FNameMap& Rebuild(UWidgetTree* WidgetTree);
+
+    TMap<FObjectKey, FNameMap> Trees;
+    int32 BuildCount = 0;
+
+    static TUniquePtr<FCortexUMGWidgetIndex> Instance;
+};
@@ -1087,6 +1087,115 @@ FCortexCommandResult FCortexUMGWidgetPropertyOps::SetProperty(const TSharedPtr<F
     return FCortexCommandRouter::Success(Data);
 }
 
+FCortexCommandResult FCortexUMGWidgetPropertyOps::SetPropertiesBulk(const TSharedPtr<FJsonObject>& Params)
+{
+    const FString AssetPath = Params->GetStringField(TEXT("asset_path"));
+    const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+    if (!Params->TryGetArrayField(TEXT("properties"), Entries) || Entries->Num() == 0)
+    {
+        return FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidField,
+            TEXT("Missing required param: properties (non-empty array of {widget_name, property_path, value})"));
+    }
+
+    FCortexCommandResult LoadError;
+    UWidgetBlueprint* WBP = CortexUMGUtils::LoadWidgetBlueprint(AssetPath, LoadError);
+    if (!WBP)
+    {
+        return LoadError;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ErrorsArray;
+    auto AddError = [&ErrorsArray](int32 Index, const FString& WidgetName, const FString& PropertyPath, const FString& Message)
+    {
+        TSharedRef<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+        ErrorObj->SetNumberField(TEXT("index"), Index);
+        ErrorObj->SetStringField(TEXT("widget_name"), WidgetName);
+        ErrorObj->SetStringField(TEXT("property_path"), PropertyPath);
+        ErrorObj->SetStringField(TEXT("error"), Message);
+        ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+    };
+
+    // One undo step and one Blueprint invalidation for the whole list
+    FScopedTransaction Transaction(FText::FromString(
+        FString::Printf(TEXT("Cortex: Set %d Properties on %s"), Entries->Num(), *WBP->GetName())));
+    WBP->Modify();
+
+    const double ApplyStart = FPlatformTime::Seconds();
+    TSet<UObject*> ModifiedObjects;
+    TSet<UWidget*> UpdatedWidgets;
+    int32 UpdatedCount = 0;
+    for (int32 Index = 0; Index < Entries->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        FString WidgetName;
+        FString PropertyPath;
+        if (!(*Entries)[Index].IsValid()
+            || !(*Entries)[Index]->TryGetObject(Entry)
+            || !(*Entry)->TryGetStringField(TEXT("widget_name"), WidgetName)
+            || !(*Entry)->TryGetStringField(TEXT("property_path"), PropertyPath)
+            || !(*Entry)->HasField(TEXT("value")))
+        {
+            AddError(Index, WidgetName, PropertyPath, TEXT("Entry must be an object with widget_name, property_path and value"));
+            continue;
+        }
+
+        UWidget* Widget = CortexUMGUtils::FindWidgetByName(WBP->WidgetTree, WidgetName);
+        if (!Widget)
+        {
+            AddError(Index, WidgetName, PropertyPath, FString::Printf(TEXT("Widget not found: %s"), *WidgetName));
+            continue;
+        }
+
+        FProperty* Property = nullptr;
+        void* ValuePtr = nullptr;
+        if (!CortexUMGUtils::ResolvePropertyPath(Widget, PropertyPath, Property, ValuePtr))
+        {
+            AddError(Index, WidgetName, PropertyPath, FString::Printf(TEXT("Property path not found: %s on %s"),
+                *PropertyPath, *Widget->GetClass()->GetName()));
+            continue;
+        }
+
+        UObject* Owner = PropertyPath.StartsWith(TEXT("slot.")) ? static_cast<UObject*>(Widget->Slot) : Widget;
+        if (!ModifiedObjects.Contains(Owner))
+        {
+            Owner->Modify();
+            ModifiedObjects.Add(Owner);
+        }
+
+        TArray<FString> Warnings;
+        if (!FCortexSerializer::JsonToProperty((*Entry)->TryGetField(TEXT("value")), Property, ValuePtr, Widget, Warnings))
+        {
+            AddError(Index, WidgetName, PropertyPath, FString::Printf(TEXT("Failed to set value for property: %s"), *PropertyPath));
+            continue;
+        }
+
+        ++UpdatedCount;
+        UpdatedWidgets.Add(Widget);
+    }
+    const double ApplyMs = (FPlatformTime::Seconds() - ApplyStart) * 1000.0;
+
+    if (UpdatedCount > 0)
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsModified(WBP);
+    }
+    else
+    {
+        Transaction.Cancel();
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetNumberField(TEXT("updated_count"), UpdatedCount);
+    Data->SetNumberField(TEXT("total_count"), Entries->Num());
+    Data->SetNumberField(TEXT("widget_count"), UpdatedWidgets.Num());
+    Data->SetNumberField(TEXT("apply_ms"), ApplyMs);
+    if (ErrorsArray.Num() > 0)
+    {
+        Data->SetArrayField(TEXT("errors"), ErrorsArray);
+    }
+    return FCortexCommandRouter::Success(Data);
+}
+
 FCortexCommandResult FCortexUMGWidgetPropertyOps::GetProperty(const TSharedPtr<FJsonObject>& Params)
 {
     const FString AssetPath = Params->GetStringField(TEXT("asset_path"));
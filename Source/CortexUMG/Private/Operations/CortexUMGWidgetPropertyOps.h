@@ -17,6 +17,7 @@ public:
     static FCortexCommandResult SetVisibility(const TSharedPtr<FJsonObject>& Params);
 
     static FCortexCommandResult SetProperty(const TSharedPtr<FJsonObject>& Params);
+    static FCortexCommandResult SetPropertiesBulk(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult GetProperty(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult GetSchema(const TSharedPtr<FJsonObject>& Params);
 
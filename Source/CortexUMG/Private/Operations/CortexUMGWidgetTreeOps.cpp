@@ -31,10 +31,12 @@
 #include "Components/WrapBox.h"
 #include "Components/WidgetSwitcher.h"
 #include "Components/ComboBoxString.h"
+#include "Components/ContentWidget.h"
 #include "ScopedTransaction.h"
 #include "Engine/Engine.h"
 #include "Engine/Blueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "CortexSerializer.h"
 #include "Misc/PackageName.h"
 #include "UObject/UObjectGlobals.h"
 #include "Dom/JsonObject.h"
@@ -78,7 +80,7 @@ static const TArray<FCuratedWidgetEntry>& GetCuratedWidgetEntries()
     return Entries;
 }
 
-UClass* FCortexUMGWidgetTreeOps::ResolveWidgetClass(const FString& ClassName)
+static UClass* ResolveWidgetClassUncached(const FString& ClassName)
 {
     // Tier 1: Curated array (case-insensitive, hot-reload safe)
     for (const FCuratedWidgetEntry& Entry : GetCuratedWidgetEntries())
@@ -134,6 +136,32 @@ UClass* FCortexUMGWidgetTreeOps::ResolveWidgetClass(const FString& ClassName)
     return nullptr;
 }
 
+UClass* FCortexUMGWidgetTreeOps::ResolveWidgetClass(const FString& ClassName)
+{
+    // Tiers 2 and 3 search every loaded class or load a package, so remember what they found.
+    // Case-insensitive keys, like the curated lookup; recompiled or reloaded classes miss and resolve again.
+    static TMap<FString, TWeakObjectPtr<UClass>> ResolvedClasses;
+    if (const TWeakObjectPtr<UClass>* Cached = ResolvedClasses.Find(ClassName))
+    {
+        UClass* CachedClass = Cached->Get();
+        if (CachedClass && !CachedClass->HasAnyClassFlags(CLASS_NewerVersionExists))
+        {
+            return CachedClass;
+        }
+    }
+
+    UClass* WidgetClass = ResolveWidgetClassUncached(ClassName);
+    if (WidgetClass)
+    {
+        ResolvedClasses.Add(ClassName, WidgetClass);
+    }
+    else
+    {
+        ResolvedClasses.Remove(ClassName);
+    }
+    return WidgetClass;
+}
+
 TSharedPtr<FJsonObject> FCortexUMGWidgetTreeOps::BuildWidgetTreeJson(UWidget* Widget)
 {
     if (!Widget)
@@ -739,3 +767,474 @@ FCortexCommandResult FCortexUMGWidgetTreeOps::DuplicateWidget(const TSharedPtr<F
     Data->SetObjectField(TEXT("name_mapping"), NameMapping);
     return FCortexCommandRouter::Success(Data);
 }
+
+struct FBuildTreeContext
+{
+    UWidgetTree* WidgetTree = nullptr;
+    bool bMerge = false;
+    /** Widgets in the tree before the build, by name; one walk instead of a lookup per spec node */
+    TMap<FName, UWidget*> ExistingByName;
+    /** Widgets a replace build removes; their names are free for the new subtree */
+    TSet<UWidget*> Replaced;
+    /** The attach parent and its ancestors, which a merge must not move beneath themselves */
+    TSet<UWidget*> AttachChain;
+    TSet<FName> SpecNames;
+    int32 CreatedCount = 0;
+    int32 UpdatedCount = 0;
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    /** Set when a widget could not be attached; the build stops and reports it */
+    FString AttachError;
+};
+
+/** A merge cannot drop a widget into a content slot that something else already fills. */
+static bool ValidateContentSlot(
+    UPanelWidget* Panel,
+    const FString& IncomingName,
+    FCortexCommandResult& OutError)
+{
+    if (!Panel->IsA<UContentWidget>() || Panel->GetChildrenCount() == 0)
+    {
+        return true;
+    }
+
+    const UWidget* Occupant = Panel->GetChildAt(0);
+    if (Occupant && Occupant->GetName() != IncomingName)
+    {
+        OutError = FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidParent,
+            FString::Printf(TEXT("'%s' (%s) already holds '%s'. Name it in the spec or remove it first."),
+                *Panel->GetName(), *Panel->GetClass()->GetName(), *Occupant->GetName()));
+        return false;
+    }
+    return true;
+}
+
+static void CollectWidgets(UWidget* Widget, TArray<UWidget*>& OutWidgets)
+{
+    if (!Widget)
+    {
+        return;
+    }
+
+    OutWidgets.Add(Widget);
+    if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
+    {
+        for (int32 i = 0; i < Panel->GetChildrenCount(); ++i)
+        {
+            CollectWidgets(Panel->GetChildAt(i), OutWidgets);
+        }
+    }
+}
+
+/** Checks the whole spec before anything is touched, so a bad node leaves the Blueprint unchanged. */
+static bool ValidateBuildSpec(
+    const TSharedPtr<FJsonObject>& Spec,
+    bool bIsRoot,
+    FBuildTreeContext& Context,
+    FCortexCommandResult& OutError)
+{
+    FString ClassName;
+    FString Name;
+    Spec->TryGetStringField(TEXT("class"), ClassName);
+    Spec->TryGetStringField(TEXT("name"), Name);
+
+    UClass* WidgetClass = nullptr;
+    if (!ClassName.IsEmpty())
+    {
+        WidgetClass = FCortexUMGWidgetTreeOps::ResolveWidgetClass(ClassName);
+        if (!WidgetClass)
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidWidgetClass,
+                FString::Printf(TEXT("Unknown widget class: %s"), *ClassName));
+            return false;
+        }
+    }
+
+    UWidget* Existing = nullptr;
+    if (!Name.IsEmpty())
+    {
+        const FName WidgetName(*Name);
+        if (Context.SpecNames.Contains(WidgetName))
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::WidgetNameExists,
+                FString::Printf(TEXT("Widget name used twice in the spec: %s"), *Name));
+            return false;
+        }
+        Context.SpecNames.Add(WidgetName);
+
+        if (UWidget* const* Found = Context.ExistingByName.Find(WidgetName))
+        {
+            if (!Context.bMerge && !Context.Replaced.Contains(*Found))
+            {
+                OutError = FCortexCommandRouter::Error(
+                    CortexErrorCodes::WidgetNameExists,
+                    FString::Printf(TEXT("Widget name already exists outside the replaced subtree: %s"), *Name));
+                return false;
+            }
+            if (Context.bMerge)
+            {
+                Existing = *Found;
+            }
+        }
+    }
+
+    if (Existing)
+    {
+        if (WidgetClass && Existing->GetClass() != WidgetClass)
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidWidgetClass,
+                FString::Printf(TEXT("Widget '%s' already exists as %s, not %s"),
+                    *Name, *Existing->GetClass()->GetName(), *ClassName));
+            return false;
+        }
+        if (Context.AttachChain.Contains(Existing))
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidParent,
+                FString::Printf(TEXT("Widget '%s' cannot be moved beneath itself"), *Name));
+            return false;
+        }
+        if (!bIsRoot && Existing == Context.WidgetTree->RootWidget)
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidParent,
+                FString::Printf(TEXT("Root widget '%s' cannot be moved into the tree"), *Name));
+            return false;
+        }
+        WidgetClass = Existing->GetClass();
+    }
+    else if (!WidgetClass)
+    {
+        OutError = FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidField,
+            FString::Printf(TEXT("Spec node '%s' needs a class"), *Name));
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+    if (!Spec->TryGetArrayField(TEXT("children"), Children) || Children->Num() == 0)
+    {
+        return true;
+    }
+
+    if (!WidgetClass->IsChildOf(UPanelWidget::StaticClass()))
+    {
+        OutError = FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidParent,
+            FString::Printf(TEXT("'%s' (%s) is not a panel widget (cannot have children)"),
+                *Name, *WidgetClass->GetName()));
+        return false;
+    }
+    if (WidgetClass->IsChildOf(UContentWidget::StaticClass()) && Children->Num() > 1)
+    {
+        OutError = FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidParent,
+            FString::Printf(TEXT("'%s' (%s) holds a single child"), *Name, *WidgetClass->GetName()));
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonValue>& ChildValue : *Children)
+    {
+        const TSharedPtr<FJsonObject>* Child = nullptr;
+        if (!ChildValue.IsValid() || !ChildValue->TryGetObject(Child))
+        {
+            OutError = FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidField,
+                FString::Printf(TEXT("Children of '%s' must be objects"), *Name));
+            return false;
+        }
+        if (Existing)
+        {
+            FString ChildName;
+            (*Child)->TryGetStringField(TEXT("name"), ChildName);
+            if (!ValidateContentSlot(CastChecked<UPanelWidget>(Existing), ChildName, OutError))
+            {
+                return false;
+            }
+        }
+        if (!ValidateBuildSpec(*Child, false, Context, OutError))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Property and slot values are applied per field; a bad field is reported and the build goes on. */
+static void ApplyBuildProperties(UWidget* Widget, const TSharedPtr<FJsonObject>& Spec, FBuildTreeContext& Context)
+{
+    static const TPair<const TCHAR*, const TCHAR*> Sections[] = {
+        { TEXT("properties"), TEXT("") },
+        { TEXT("slot"), TEXT("slot.") },
+    };
+
+    for (const TPair<const TCHAR*, const TCHAR*>& Section : Sections)
+    {
+        const TSharedPtr<FJsonObject>* Values = nullptr;
+        if (!Spec->TryGetObjectField(Section.Key, Values))
+        {
+            continue;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Value : (*Values)->Values)
+        {
+            const FString PropertyPath = Section.Value + Value.Key;
+            FProperty* Property = nullptr;
+            void* ValuePtr = nullptr;
+            FString Error;
+            TArray<FString> Warnings;
+            if (!CortexUMGUtils::ResolvePropertyPath(Widget, PropertyPath, Property, ValuePtr))
+            {
+                Error = FString::Printf(TEXT("Property path not found: %s on %s"),
+                    *PropertyPath, *Widget->GetClass()->GetName());
+            }
+            else if (!FCortexSerializer::JsonToProperty(Value.Value, Property, ValuePtr, Widget, Warnings))
+            {
+                Error = FString::Printf(TEXT("Failed to set value for property: %s"), *PropertyPath);
+            }
+
+            if (!Error.IsEmpty())
+            {
+                TSharedRef<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+                ErrorObj->SetStringField(TEXT("widget_name"), Widget->GetName());
+                ErrorObj->SetStringField(TEXT("property_path"), PropertyPath);
+                ErrorObj->SetStringField(TEXT("error"), Error);
+                Context.Errors.Add(MakeShared<FJsonValueObject>(ErrorObj));
+            }
+        }
+    }
+}
+
+static UWidget* BuildSpecNode(const TSharedPtr<FJsonObject>& Spec, UPanelWidget* Parent, FBuildTreeContext& Context)
+{
+    FString Name;
+    Spec->TryGetStringField(TEXT("name"), Name);
+
+    UWidget* Widget = nullptr;
+    if (Context.bMerge && !Name.IsEmpty())
+    {
+        Widget = Context.ExistingByName.FindRef(FName(*Name));
+    }
+
+    const bool bAttach = Parent && (!Widget || Widget->GetParent() != Parent);
+    if (bAttach && !Parent->CanAddMoreChildren())
+    {
+        Context.AttachError = FString::Printf(TEXT("'%s' (%s) cannot take another child"),
+            *Parent->GetName(), *Parent->GetClass()->GetName());
+        return nullptr;
+    }
+
+    const bool bExisting = Widget != nullptr;
+    if (bExisting)
+    {
+        if (UPanelWidget* OldParent = bAttach ? Widget->GetParent() : nullptr)
+        {
+            OldParent->RemoveChild(Widget);
+        }
+    }
+    else
+    {
+        UClass* WidgetClass = FCortexUMGWidgetTreeOps::ResolveWidgetClass(Spec->GetStringField(TEXT("class")));
+        Widget = Context.WidgetTree->ConstructWidget<UWidget>(WidgetClass, Name.IsEmpty() ? NAME_None : FName(*Name));
+    }
+
+    if (bAttach && !Parent->AddChild(Widget))
+    {
+        Context.AttachError = FString::Printf(TEXT("Failed to add '%s' to '%s'"), *Widget->GetName(), *Parent->GetName());
+        return nullptr;
+    }
+    if (bExisting)
+    {
+        ++Context.UpdatedCount;
+    }
+    else
+    {
+        ++Context.CreatedCount;
+    }
+
+    ApplyBuildProperties(Widget, Spec, Context);
+
+    const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+    if (Spec->TryGetArrayField(TEXT("children"), Children))
+    {
+        UPanelWidget* Panel = Cast<UPanelWidget>(Widget);
+        for (const TSharedPtr<FJsonValue>& ChildValue : *Children)
+        {
+            if (!BuildSpecNode(ChildValue->AsObject(), Panel, Context))
+            {
+                return nullptr;
+            }
+        }
+    }
+    return Widget;
+}
+
+FCortexCommandResult FCortexUMGWidgetTreeOps::BuildTree(const TSharedPtr<FJsonObject>& Params)
+{
+    const FString AssetPath = Params->GetStringField(TEXT("asset_path"));
+    const TSharedPtr<FJsonObject>* Spec = nullptr;
+    if (!Params->TryGetObjectField(TEXT("tree"), Spec))
+    {
+        return FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidField,
+            TEXT("Missing required param: tree (object with class, name, slot, properties, children)"));
+    }
+
+    FString ParentName;
+    Params->TryGetStringField(TEXT("parent_name"), ParentName);
+    FString Mode = TEXT("replace");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    if (Mode != TEXT("replace") && Mode != TEXT("merge"))
+    {
+        return FCortexCommandRouter::Error(
+            CortexErrorCodes::InvalidValue,
+            FString::Printf(TEXT("Invalid mode '%s'. Expected replace or merge"), *Mode));
+    }
+
+    FCortexCommandResult LoadError;
+    UWidgetBlueprint* WBP = CortexUMGUtils::LoadWidgetBlueprint(AssetPath, LoadError);
+    if (!WBP)
+    {
+        return LoadError;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    FBuildTreeContext Context;
+    Context.WidgetTree = WBP->WidgetTree;
+    Context.bMerge = Mode == TEXT("merge");
+
+    TArray<UWidget*> ExistingWidgets;
+    CollectWidgets(WBP->WidgetTree->RootWidget, ExistingWidgets);
+    for (UWidget* Widget : ExistingWidgets)
+    {
+        Context.ExistingByName.FindOrAdd(Widget->GetFName(), Widget);
+    }
+
+    UPanelWidget* ParentPanel = nullptr;
+    if (!ParentName.IsEmpty())
+    {
+        UWidget* ParentWidget = Context.ExistingByName.FindRef(FName(*ParentName));
+        if (!ParentWidget)
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::WidgetNotFound,
+                FString::Printf(TEXT("Parent widget not found: %s"), *ParentName));
+        }
+        ParentPanel = Cast<UPanelWidget>(ParentWidget);
+        if (!ParentPanel)
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidParent,
+                FString::Printf(TEXT("Parent '%s' is not a panel widget (cannot have children)"), *ParentName));
+        }
+        for (UWidget* Ancestor = ParentPanel; Ancestor; Ancestor = Ancestor->GetParent())
+        {
+            Context.AttachChain.Add(Ancestor);
+        }
+    }
+
+    // What a replace build removes: the whole tree, or every child of the attach parent
+    TArray<UWidget*> ReplacedRoots;
+    if (!Context.bMerge)
+    {
+        if (ParentPanel)
+        {
+            ReplacedRoots = ParentPanel->GetAllChildren();
+        }
+        else if (WBP->WidgetTree->RootWidget)
+        {
+            ReplacedRoots.Add(WBP->WidgetTree->RootWidget);
+        }
+        TArray<UWidget*> ReplacedWidgets;
+        for (UWidget* ReplacedRoot : ReplacedRoots)
+        {
+            CollectWidgets(ReplacedRoot, ReplacedWidgets);
+        }
+        Context.Replaced.Append(ReplacedWidgets);
+    }
+    else if (!ParentPanel && WBP->WidgetTree->RootWidget)
+    {
+        FString RootName;
+        (*Spec)->TryGetStringField(TEXT("name"), RootName);
+        if (RootName != WBP->WidgetTree->RootWidget->GetName())
+        {
+            return FCortexCommandRouter::Error(
+                CortexErrorCodes::InvalidParent,
+                FString::Printf(TEXT("Root widget already exists (%s). Name it as the spec root or pass parent_name."),
+                    *WBP->WidgetTree->RootWidget->GetName()));
+        }
+    }
+    else if (ParentPanel)
+    {
+        FString RootName;
+        (*Spec)->TryGetStringField(TEXT("name"), RootName);
+        FCortexCommandResult SlotError;
+        if (!ValidateContentSlot(ParentPanel, RootName, SlotError))
+        {
+            return SlotError;
+        }
+    }
+
+    FCortexCommandResult SpecError;
+    if (!ValidateBuildSpec(*Spec, ParentPanel == nullptr, Context, SpecError))
+    {
+        return SpecError;
+    }
+
+    FScopedTransaction Transaction(FText::FromString(
+        FString::Printf(TEXT("Cortex: Build Widget Tree in %s"), *WBP->GetName())));
+    WBP->Modify();
+    WBP->WidgetTree->Modify();
+
+    for (UWidget* ReplacedRoot : ReplacedRoots)
+    {
+        if (ParentPanel)
+        {
+            ParentPanel->RemoveChild(ReplacedRoot);
+        }
+        else
+        {
+            WBP->WidgetTree->RootWidget = nullptr;
+        }
+    }
+    // Removed widgets stay in the tree's outer; move them out so the spec can reuse their names
+    for (UWidget* Removed : Context.Replaced)
+    {
+        Removed->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors);
+    }
+
+    // Widgets are built detached from the designer; it hears about the result once, below
+    UWidget* BuiltRoot = BuildSpecNode(*Spec, ParentPanel, Context);
+    if (!BuiltRoot)
+    {
+        Transaction.Cancel();
+        return FCortexCommandRouter::Error(CortexErrorCodes::InvalidParent, Context.AttachError);
+    }
+    if (!ParentPanel)
+    {
+        WBP->WidgetTree->RootWidget = BuiltRoot;
+    }
+
+    FBlueprintEditorUtils::MarkBlueprintAsModified(WBP);
+    const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("built"), true);
+    Data->SetStringField(TEXT("mode"), Mode);
+    Data->SetStringField(TEXT("root"), BuiltRoot->GetName());
+    Data->SetStringField(TEXT("parent"), ParentName);
+    Data->SetNumberField(TEXT("created_count"), Context.CreatedCount);
+    Data->SetNumberField(TEXT("updated_count"), Context.UpdatedCount);
+    Data->SetNumberField(TEXT("removed_count"), Context.Replaced.Num());
+    Data->SetNumberField(TEXT("total_widgets"), CortexUMGUtils::CountWidgets(WBP->WidgetTree->RootWidget));
+    Data->SetNumberField(TEXT("build_ms"), BuildMs);
+    if (Context.Errors.Num() > 0)
+    {
+        Data->SetArrayField(TEXT("errors"), Context.Errors);
+    }
+    return FCortexCommandRouter::Success(Data);
+}
@@ -15,8 +15,11 @@ public:
     static FCortexCommandResult GetWidget(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult ListWidgetClasses(const TSharedPtr<FJsonObject>& Params);
     static FCortexCommandResult DuplicateWidget(const TSharedPtr<FJsonObject>& Params);
+    static FCortexCommandResult BuildTree(const TSharedPtr<FJsonObject>& Params);
 
-private:
+    /** Curated name, native class name or Widget Blueprint path; successful lookups are cached. */
     static UClass* ResolveWidgetClass(const FString& ClassName);
+
+private:
     static TSharedPtr<FJsonObject> BuildWidgetTreeJson(UWidget* Widget);
 };
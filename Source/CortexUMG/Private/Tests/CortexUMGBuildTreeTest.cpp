@@ -0,0 +1,132 @@
+#include "Misc/AutomationTest.h"
+#include "CortexCommandRouter.h"
+#include "CortexUMGCommandHandler.h"
+#include "WidgetBlueprint.h"
+#include "Blueprint/WidgetTree.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/TextBlock.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexUMGBuildTreeTest,
+    "Cortex.UMG.BuildTree",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexUMGBuildTreeTest::RunTest(const FString& Parameters)
+{
+    UPackage* TestPackage = CreatePackage(TEXT("/Temp/CortexUMGBuildTreeTest"));
+    UWidgetBlueprint* WBP = NewObject<UWidgetBlueprint>(
+        TestPackage, TEXT("WBP_BuildTreeTest"), RF_Public | RF_Standalone | RF_Transactional);
+    WBP->ParentClass = UUserWidget::StaticClass();
+    WBP->WidgetTree = NewObject<UWidgetTree>(WBP, TEXT("WidgetTree"));
+
+    const FString AssetPath = WBP->GetPathName();
+
+    FCortexCommandRouter Router;
+    Router.RegisterDomain(TEXT("umg"), TEXT("Cortex UMG"), TEXT("1.0.1"),
+        MakeShared<FCortexUMGCommandHandler>());
+
+    auto BuildTree = [&](const FString& SpecJson, const FString& Mode, const FString& ParentName) -> FCortexCommandResult
+    {
+        TSharedPtr<FJsonObject> Spec;
+        FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(SpecJson), Spec);
+
+        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("asset_path"), AssetPath);
+        Params->SetObjectField(TEXT("tree"), Spec);
+        Params->SetStringField(TEXT("mode"), Mode);
+        if (!ParentName.IsEmpty())
+        {
+            Params->SetStringField(TEXT("parent_name"), ParentName);
+        }
+        return Router.Execute(TEXT("umg.build_tree"), Params);
+    };
+
+    FCortexCommandResult Result = BuildTree(TEXT(R"({
+        "class": "CanvasPanel", "name": "Root",
+        "children": [
+            { "class": "VerticalBox", "name": "Content", "slot": { "ZOrder": 3 },
+              "children": [
+                { "class": "TextBlock", "name": "Title", "properties": { "RenderOpacity": 0.5 } },
+                { "class": "Button", "name": "Confirm", "children": [ { "class": "TextBlock", "name": "ConfirmLabel" } ] }
+              ] }
+        ] })"), TEXT("replace"), TEXT(""));
+    TestTrue(TEXT("Initial build should succeed"), Result.bSuccess);
+    if (Result.Data.IsValid())
+    {
+        TestEqual(TEXT("Five widgets created"), static_cast<int32>(Result.Data->GetNumberField(TEXT("created_count"))), 5);
+        TestEqual(TEXT("Tree holds five widgets"), static_cast<int32>(Result.Data->GetNumberField(TEXT("total_widgets"))), 5);
+        TestFalse(TEXT("No property errors"), Result.Data->HasField(TEXT("errors")));
+    }
+
+    UWidget* Content = WBP->WidgetTree->FindWidget(TEXT("Content"));
+    UTextBlock* Title = Cast<UTextBlock>(WBP->WidgetTree->FindWidget(TEXT("Title")));
+    if (TestNotNull(TEXT("Content built"), Content))
+    {
+        const UCanvasPanelSlot* ContentSlot = Cast<UCanvasPanelSlot>(Content->Slot);
+        TestTrue(TEXT("Slot value applied"), ContentSlot && ContentSlot->GetZOrder() == 3);
+    }
+    if (TestNotNull(TEXT("Title built"), Title))
+    {
+        TestEqual(TEXT("Property applied"), Title->GetRenderOpacity(), 0.5f);
+    }
+
+    // Merge keeps matched widgets and only adds what is new
+    Result = BuildTree(TEXT(R"({
+        "name": "Content",
+        "children": [
+            { "name": "Title", "properties": { "RenderOpacity": 0.25 } },
+            { "class": "TextBlock", "name": "Footer" }
+        ] })"), TEXT("merge"), TEXT("Root"));
+    TestTrue(TEXT("Merge should succeed"), Result.bSuccess);
+    if (Result.Data.IsValid())
+    {
+        TestEqual(TEXT("One widget created"), static_cast<int32>(Result.Data->GetNumberField(TEXT("created_count"))), 1);
+        TestEqual(TEXT("Two widgets updated"), static_cast<int32>(Result.Data->GetNumberField(TEXT("updated_count"))), 2);
+        TestEqual(TEXT("Nothing removed"), static_cast<int32>(Result.Data->GetNumberField(TEXT("total_widgets"))), 6);
+    }
+    TestTrue(TEXT("Title kept its identity"), WBP->WidgetTree->FindWidget(TEXT("Title")) == Title);
+    if (Title)
+    {
+        TestEqual(TEXT("Merged property applied"), Title->GetRenderOpacity(), 0.25f);
+    }
+
+    // A merge cannot push a second widget into an occupied content slot
+    UWidget* ConfirmLabel = WBP->WidgetTree->FindWidget(TEXT("ConfirmLabel"));
+    Result = BuildTree(TEXT(R"({
+        "name": "Confirm",
+        "children": [ { "class": "TextBlock", "name": "ConfirmIcon" } ] })"), TEXT("merge"), TEXT("Content"));
+    TestFalse(TEXT("Occupied content slot fails the merge"), Result.bSuccess);
+    TestEqual(TEXT("Error code should be INVALID_PARENT"), Result.ErrorCode, CortexErrorCodes::InvalidParent);
+    Result = BuildTree(TEXT(R"({ "class": "TextBlock", "name": "ConfirmIcon" })"), TEXT("merge"), TEXT("Confirm"));
+    TestFalse(TEXT("Occupied content parent fails the merge"), Result.bSuccess);
+    TestNull(TEXT("Nothing built"), WBP->WidgetTree->FindWidget(TEXT("ConfirmIcon")));
+    TestTrue(TEXT("Occupant kept"), ConfirmLabel && ConfirmLabel->GetParent() == WBP->WidgetTree->FindWidget(TEXT("Confirm")));
+
+    // A bad node anywhere in the spec leaves the tree untouched
+    Result = BuildTree(TEXT(R"({
+        "class": "VerticalBox", "name": "Replacement",
+        "children": [ { "class": "NoSuchWidgetClass", "name": "Broken" } ] })"), TEXT("replace"), TEXT("Root"));
+    TestFalse(TEXT("Unknown class fails the build"), Result.bSuccess);
+    TestEqual(TEXT("Error code should be INVALID_WIDGET_CLASS"), Result.ErrorCode, CortexErrorCodes::InvalidWidgetClass);
+    TestTrue(TEXT("Existing subtree kept"), WBP->WidgetTree->FindWidget(TEXT("Content")) == Content);
+
+    // Replace under a parent clears its children; their names are free to reuse
+    Result = BuildTree(TEXT(R"({ "class": "Overlay", "name": "Content" })"), TEXT("replace"), TEXT("Root"));
+    TestTrue(TEXT("Replace should succeed"), Result.bSuccess);
+    if (Result.Data.IsValid())
+    {
+        TestEqual(TEXT("Old subtree removed"), static_cast<int32>(Result.Data->GetNumberField(TEXT("removed_count"))), 5);
+        TestEqual(TEXT("Root and new child remain"), static_cast<int32>(Result.Data->GetNumberField(TEXT("total_widgets"))), 2);
+    }
+    UWidget* NewContent = WBP->WidgetTree->FindWidget(TEXT("Content"));
+    TestTrue(TEXT("Name reused by a new widget"), NewContent && NewContent != Content);
+
+    WBP->MarkAsGarbage();
+    return true;
+}
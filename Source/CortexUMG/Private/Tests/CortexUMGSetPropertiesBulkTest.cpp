@@ -0,0 +1,115 @@
+#include "Misc/AutomationTest.h"
+#include "CortexCommandRouter.h"
+#include "CortexUMGCommandHandler.h"
+#include "CortexUMGWidgetIndex.h"
+#include "WidgetBlueprint.h"
+#include "Blueprint/WidgetTree.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/TextBlock.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCortexUMGSetPropertiesBulkTest,
+    "Cortex.UMG.SetPropertiesBulk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCortexUMGSetPropertiesBulkTest::RunTest(const FString& Parameters)
+{
+    UPackage* TestPackage = CreatePackage(TEXT("/Temp/CortexUMGSetPropertiesBulkTest"));
+    UWidgetBlueprint* WBP = NewObject<UWidgetBlueprint>(
+        TestPackage, TEXT("WBP_BulkPropTest"), RF_Public | RF_Standalone | RF_Transactional);
+    WBP->ParentClass = UUserWidget::StaticClass();
+    WBP->WidgetTree = NewObject<UWidgetTree>(WBP, TEXT("WidgetTree"));
+
+    const FString AssetPath = WBP->GetPathName();
+
+    FCortexCommandRouter Router;
+    Router.RegisterDomain(TEXT("umg"), TEXT("Cortex UMG"), TEXT("1.0.1"),
+        MakeShared<FCortexUMGCommandHandler>());
+
+    TSharedPtr<FJsonObject> RootParams = MakeShared<FJsonObject>();
+    RootParams->SetStringField(TEXT("asset_path"), AssetPath);
+    RootParams->SetStringField(TEXT("widget_class"), TEXT("CanvasPanel"));
+    RootParams->SetStringField(TEXT("name"), TEXT("Root"));
+    Router.Execute(TEXT("umg.add_widget"), RootParams);
+
+    for (const TCHAR* LabelName : { TEXT("LabelA"), TEXT("LabelB") })
+    {
+        TSharedPtr<FJsonObject> AddParams = MakeShared<FJsonObject>();
+        AddParams->SetStringField(TEXT("asset_path"), AssetPath);
+        AddParams->SetStringField(TEXT("widget_class"), TEXT("TextBlock"));
+        AddParams->SetStringField(TEXT("name"), LabelName);
+        AddParams->SetStringField(TEXT("parent_name"), TEXT("Root"));
+        Router.Execute(TEXT("umg.add_widget"), AddParams);
+    }
+
+    auto MakeEntry = [](const FString& WidgetName, const FString& PropertyPath, const TSharedPtr<FJsonValue>& Value)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("widget_name"), WidgetName);
+        Entry->SetStringField(TEXT("property_path"), PropertyPath);
+        Entry->SetField(TEXT("value"), Value);
+        return MakeShared<FJsonValueObject>(Entry);
+    };
+
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    Entries.Add(MakeEntry(TEXT("LabelA"), TEXT("bIsEnabled"), MakeShared<FJsonValueBoolean>(false)));
+    Entries.Add(MakeEntry(TEXT("LabelB"), TEXT("bIsEnabled"), MakeShared<FJsonValueBoolean>(false)));
+    Entries.Add(MakeEntry(TEXT("LabelA"), TEXT("RenderOpacity"), MakeShared<FJsonValueNumber>(0.5)));
+    Entries.Add(MakeEntry(TEXT("Missing"), TEXT("bIsEnabled"), MakeShared<FJsonValueBoolean>(false)));
+
+    TSharedPtr<FJsonObject> BulkParams = MakeShared<FJsonObject>();
+    BulkParams->SetStringField(TEXT("asset_path"), AssetPath);
+    BulkParams->SetArrayField(TEXT("properties"), Entries);
+
+    const int32 BuildsBefore = FCortexUMGWidgetIndex::Get().GetBuildCount();
+    FCortexCommandResult Result = Router.Execute(TEXT("umg.set_properties_bulk"), BulkParams);
+    TestTrue(TEXT("set_properties_bulk should succeed"), Result.bSuccess);
+    TestTrue(TEXT("Known names resolve without rewalking the tree"),
+        FCortexUMGWidgetIndex::Get().GetBuildCount() - BuildsBefore <= 1);
+
+    if (Result.Data.IsValid())
+    {
+        TestEqual(TEXT("Three entries applied"), static_cast<int32>(Result.Data->GetNumberField(TEXT("updated_count"))), 3);
+        TestEqual(TEXT("Two widgets touched"), static_cast<int32>(Result.Data->GetNumberField(TEXT("widget_count"))), 2);
+
+        const TArray<TSharedPtr<FJsonValue>>* Errors = nullptr;
+        TestTrue(TEXT("Missing widget reported"), Result.Data->TryGetArrayField(TEXT("errors"), Errors) && Errors->Num() == 1);
+        if (Errors && Errors->Num() == 1)
+        {
+            TestEqual(TEXT("Error points at the failing entry"),
+                static_cast<int32>((*Errors)[0]->AsObject()->GetNumberField(TEXT("index"))), 3);
+        }
+    }
+
+    UTextBlock* LabelA = Cast<UTextBlock>(WBP->WidgetTree->FindWidget(TEXT("LabelA")));
+    UTextBlock* LabelB = Cast<UTextBlock>(WBP->WidgetTree->FindWidget(TEXT("LabelB")));
+    if (TestNotNull(TEXT("LabelA exists"), LabelA) && TestNotNull(TEXT("LabelB exists"), LabelB))
+    {
+        TestFalse(TEXT("LabelA disabled"), LabelA->GetIsEnabled());
+        TestFalse(TEXT("LabelB disabled"), LabelB->GetIsEnabled());
+        TestEqual(TEXT("LabelA opacity"), LabelA->GetRenderOpacity(), 0.5f);
+    }
+
+    // A removed widget keeps its name, but the index must stop returning it
+    TSharedPtr<FJsonObject> RemoveParams = MakeShared<FJsonObject>();
+    RemoveParams->SetStringField(TEXT("asset_path"), AssetPath);
+    RemoveParams->SetStringField(TEXT("widget_name"), TEXT("LabelB"));
+    Router.Execute(TEXT("umg.remove_widget"), RemoveParams);
+    TestNull(TEXT("Removed widget is no longer found"),
+        FCortexUMGWidgetIndex::Get().Find(WBP->WidgetTree, TEXT("LabelB")));
+    TestTrue(TEXT("Remaining widget still found"),
+        FCortexUMGWidgetIndex::Get().Find(WBP->WidgetTree, TEXT("LabelA")) == LabelA);
+
+    TSharedPtr<FJsonObject> EmptyParams = MakeShared<FJsonObject>();
+    EmptyParams->SetStringField(TEXT("asset_path"), AssetPath);
+    EmptyParams->SetArrayField(TEXT("properties"), TArray<TSharedPtr<FJsonValue>>());
+    Result = Router.Execute(TEXT("umg.set_properties_bulk"), EmptyParams);
+    TestFalse(TEXT("Empty list is rejected"), Result.bSuccess);
+    TestEqual(TEXT("Error code should be INVALID_FIELD"), Result.ErrorCode, CortexErrorCodes::InvalidField);
+
+    WBP->MarkAsGarbage();
+    return true;
+}